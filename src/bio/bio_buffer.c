@@ -17,6 +17,10 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 	D_ASSERT(chunk->bdc_ref == 0);
 	D_ASSERT(d_list_empty(&chunk->bdc_link));
 
+	/* Release bulk handles registered on this chunk */
+	if (chunk->bdc_bulks != NULL)
+		bulk_chunk_fini(chunk);
+
 	if (bio_spdk_inited)
 		spdk_dma_free(chunk->bdc_ptr);
 	else
@@ -26,7 +30,7 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 }
 
 static struct bio_dma_chunk *
-dma_alloc_chunk(unsigned int cnt)
+dma_alloc_chunk(unsigned int cnt, int numa_id)
 {
 	struct bio_dma_chunk *chunk;
 	ssize_t bytes = (ssize_t)cnt << BIO_DMA_PAGE_SHIFT;
@@ -40,7 +44,12 @@ dma_alloc_chunk(unsigned int cnt)
 	}
 
 	if (bio_spdk_inited) {
-		chunk->bdc_ptr = spdk_dma_malloc(bytes, BIO_DMA_PAGE_SZ, NULL);
+		chunk->bdc_ptr = spdk_dma_malloc_socket(bytes, BIO_DMA_PAGE_SZ,
+							NULL, numa_id);
+		/* Fallback to any NUMA node when local hugepages exhausted */
+		if (chunk->bdc_ptr == NULL && numa_id != SPDK_ENV_SOCKET_ID_ANY)
+			chunk->bdc_ptr = spdk_dma_malloc(bytes, BIO_DMA_PAGE_SZ,
+							 NULL);
 	} else {
 		rc = posix_memalign(&chunk->bdc_ptr, BIO_DMA_PAGE_SZ, bytes);
 		if (rc)
@@ -53,6 +62,8 @@ dma_alloc_chunk(unsigned int cnt)
 		return NULL;
 	}
 	D_INIT_LIST_HEAD(&chunk->bdc_link);
+	chunk->bdc_pg_cnt = cnt;
+	chunk->bdc_huge_cls = BIO_DMA_HUGE_CLS_MAX;
 
 	return chunk;
 }
@@ -73,6 +84,7 @@ dma_buffer_shrink(struct bio_dma_buffer *buf, unsigned int cnt)
 		buf->bdb_tot_cnt--;
 		cnt--;
 	}
+	d_tm_set_gauge(buf->bdb_stats.bds_chks_tot, buf->bdb_tot_cnt);
 }
 
 int
@@ -84,7 +96,7 @@ dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 	D_ASSERT((buf->bdb_tot_cnt + cnt) <= bio_chk_cnt_max);
 
 	for (i = 0; i < cnt; i++) {
-		chunk = dma_alloc_chunk(bio_chk_sz);
+		chunk = dma_alloc_chunk(bio_chk_sz, buf->bdb_numa_id);
 		if (chunk == NULL) {
 			rc = -DER_NOMEM;
 			break;
@@ -94,9 +106,207 @@ dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 		buf->bdb_tot_cnt++;
 	}
 
+	d_tm_inc_counter(buf->bdb_stats.bds_grows, i);
+	d_tm_set_gauge(buf->bdb_stats.bds_chks_tot, buf->bdb_tot_cnt);
+
 	return rc;
 }
 
+/* Bucket of IOD size histogram, log2 of DMA pages */
+static inline unsigned int
+dma_hist_bucket(uint64_t pg_cnt)
+{
+	unsigned int	bkt;
+
+	D_ASSERT(pg_cnt > 0);
+	bkt = 63 - __builtin_clzll(pg_cnt);
+
+	return min(bkt, BIO_DMA_HIST_MAX - 1);
+}
+
+/*
+ * Pick the number of chunks to grow by the histogram of recently observed IOD
+ * sizes, so that a workload dominated by large IODs doesn't have to grow the
+ * buffer one chunk per retry.
+ */
+static unsigned int
+dma_grow_step(struct bio_dma_buffer *bdb)
+{
+	uint64_t	tot = 0, acc = 0;
+	unsigned int	i, step;
+
+	for (i = 0; i < BIO_DMA_HIST_MAX; i++)
+		tot += bdb->bdb_iod_hist[i];
+
+	if (tot == 0)
+		return 1;
+
+	/* Locate the 90th percentile IOD size */
+	for (i = 0; i < BIO_DMA_HIST_MAX; i++) {
+		acc += bdb->bdb_iod_hist[i];
+		if (acc * 10 >= tot * 9)
+			break;
+	}
+	D_ASSERT(i < BIO_DMA_HIST_MAX);
+
+	step = ((2ULL << i) + bio_chk_sz - 1) / bio_chk_sz;
+	step = min(step, BIO_DMA_GROW_MAX);
+	step = min(step, bio_chk_cnt_max - bdb->bdb_tot_cnt);
+
+	return max(step, 1);
+}
+
+/* How many recent IODs fall into the size range of huge class @cls */
+static inline uint64_t
+dma_huge_hist(struct bio_dma_buffer *bdb, unsigned int cls)
+{
+	unsigned int	bkt = dma_hist_bucket((uint64_t)bio_chk_sz << cls);
+
+	if (bkt + 1 < BIO_DMA_HIST_MAX)
+		return bdb->bdb_iod_hist[bkt] + bdb->bdb_iod_hist[bkt + 1];
+	return bdb->bdb_iod_hist[bkt];
+}
+
+struct bio_dma_chunk *
+dma_get_huge(struct bio_dma_buffer *bdb, unsigned int pg_cnt)
+{
+	struct bio_dma_chunk	*chunk;
+	unsigned int		 cls = dma_huge_cls(pg_cnt);
+
+	if (cls < BIO_DMA_HUGE_CLS_MAX &&
+	    !d_list_empty(&bdb->bdb_huge_list[cls])) {
+		chunk = d_list_entry(bdb->bdb_huge_list[cls].next,
+				     struct bio_dma_chunk, bdc_link);
+		d_list_del_init(&chunk->bdc_link);
+
+		D_ASSERT(chunk->bdc_huge_cls == cls);
+		D_ASSERT(bdb->bdb_huge_cnt >= (1U << (cls + 1)));
+		bdb->bdb_huge_cnt -= (1U << (cls + 1));
+		d_tm_inc_counter(bdb->bdb_stats.bds_huge_hits, 1);
+		return chunk;
+	}
+
+	/* Round up to the class size, so the chunk can be reused in class */
+	if (cls < BIO_DMA_HUGE_CLS_MAX)
+		chunk = dma_alloc_chunk(bio_chk_sz << (cls + 1),
+					bdb->bdb_numa_id);
+	else
+		chunk = dma_alloc_chunk(pg_cnt, bdb->bdb_numa_id);
+
+	if (chunk == NULL)
+		return NULL;
+
+	chunk->bdc_huge_cls = cls;
+	d_tm_inc_counter(bdb->bdb_stats.bds_huge_allocs, 1);
+	return chunk;
+}
+
+/*
+ * Cache the released huge chunk when IODs of this size are recurring (seen
+ * in histogram) and the cached huge chunks don't exceed 1/4 of the DMA buffer
+ * upper bound, otherwise, free it immediately.
+ */
+void
+dma_put_huge(struct bio_dma_buffer *bdb, struct bio_dma_chunk *chunk)
+{
+	unsigned int	cls = chunk->bdc_huge_cls;
+	unsigned int	units;
+
+	D_ASSERT(chunk->bdc_ref == 0);
+	if (cls >= BIO_DMA_HUGE_CLS_MAX)
+		goto free;
+
+	units = 1U << (cls + 1);
+	if (dma_huge_hist(bdb, cls) < 2 ||
+	    (bdb->bdb_huge_cnt + units) > bio_chk_cnt_max / 4)
+		goto free;
+
+	d_list_add(&chunk->bdc_link, &bdb->bdb_huge_list[cls]);
+	bdb->bdb_huge_cnt += units;
+	return;
+free:
+	dma_free_chunk(chunk);
+}
+
+static void
+dma_huge_shrink(struct bio_dma_buffer *bdb, bool all)
+{
+	struct bio_dma_chunk	*chunk, *tmp;
+	unsigned int		 cls;
+
+	for (cls = 0; cls < BIO_DMA_HUGE_CLS_MAX; cls++) {
+		if (!all && dma_huge_hist(bdb, cls) != 0)
+			continue;
+
+		d_list_for_each_entry_safe(chunk, tmp, &bdb->bdb_huge_list[cls],
+					   bdc_link) {
+			d_list_del_init(&chunk->bdc_link);
+			D_ASSERT(bdb->bdb_huge_cnt >= (1U << (cls + 1)));
+			bdb->bdb_huge_cnt -= (1U << (cls + 1));
+			dma_free_chunk(chunk);
+			d_tm_inc_counter(bdb->bdb_stats.bds_shrinks, 1);
+		}
+	}
+}
+
+static void
+dma_iod_hist_add(struct bio_dma_buffer *bdb, struct bio_desc *biod)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	uint64_t		 bytes = 0;
+	int			 i;
+
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++)
+		bytes += rsrvd_dma->brd_regions[i].brr_end -
+			 rsrvd_dma->brd_regions[i].brr_off;
+
+	if (bytes == 0)
+		return;
+
+	bdb->bdb_iod_hist[dma_hist_bucket((bytes + BIO_DMA_PAGE_SZ - 1) >>
+					  BIO_DMA_PAGE_SHIFT)]++;
+}
+
+/*
+ * Periodically called by each xstream: decay the IOD size histogram, release
+ * cached huge chunks not being used recently, and return half of the idle
+ * chunks beyond initial count when nobody waited for DMA buffer in the last
+ * period, so the hugepages can be consumed by other xstreams.
+ */
+void
+dma_buffer_reclaim(struct bio_dma_buffer *bdb, uint64_t now)
+{
+	struct bio_dma_chunk	*chunk;
+	unsigned int		 idle = 0, cnt;
+	int			 i;
+
+	if (bdb->bdb_reclaim_ts + DMA_RECLAIM_PERIOD > now)
+		return;
+	bdb->bdb_reclaim_ts = now;
+
+	for (i = 0; i < BIO_DMA_HIST_MAX; i++)
+		bdb->bdb_iod_hist[i] >>= 1;
+
+	dma_huge_shrink(bdb, false);
+
+	if (bdb->bdb_retries != 0 || bdb->bdb_tot_cnt <= bdb->bdb_init_cnt) {
+		bdb->bdb_retries = 0;
+		return;
+	}
+
+	d_list_for_each_entry(chunk, &bdb->bdb_idle_list, bdc_link)
+		idle++;
+
+	cnt = min(idle, (bdb->bdb_tot_cnt - bdb->bdb_init_cnt + 1) / 2);
+	if (cnt == 0)
+		return;
+
+	D_DEBUG(DB_IO, "Reclaim %u idle DMA chunks, tot:%u, idle:%u\n",
+		cnt, bdb->bdb_tot_cnt, idle);
+	dma_buffer_shrink(bdb, cnt);
+	d_tm_inc_counter(bdb->bdb_stats.bds_shrinks, cnt);
+}
+
 void
 dma_buffer_destroy(struct bio_dma_buffer *buf)
 {
@@ -104,20 +314,42 @@ dma_buffer_destroy(struct bio_dma_buffer *buf)
 	D_ASSERT(buf->bdb_active_iods == 0);
 
 	bulk_cache_destroy(buf);
+	dma_huge_shrink(buf, true);
 	dma_buffer_shrink(buf, buf->bdb_tot_cnt);
 
 	D_ASSERT(buf->bdb_tot_cnt == 0);
+	D_ASSERT(buf->bdb_huge_cnt == 0);
 	ABT_mutex_free(&buf->bdb_mutex);
 	ABT_cond_free(&buf->bdb_wait_iods);
 
 	D_FREE(buf);
 }
 
+static void
+dma_metrics_init(struct bio_dma_buffer *buf, int tgt_id)
+{
+	int	rc;
+
+	/* Skip sensor setup on standalone vos & sys xstream */
+	if (tgt_id < 0)
+		return;
+
+#define X(field, fname, desc, unit, type)				\
+	rc = d_tm_add_metric(&buf->bdb_stats.field, type, desc, unit,	\
+			     "dmabuff/%s/tgt_%d", fname, tgt_id);	\
+	if (rc)								\
+		D_WARN("Failed to create %s sensor for tgt %d: "DF_RC"\n",\
+		       fname, tgt_id, DP_RC(rc));
+
+	BIO_PROTO_DMA_STATS_LIST
+#undef X
+}
+
 struct bio_dma_buffer *
-dma_buffer_create(unsigned int init_cnt)
+dma_buffer_create(unsigned int init_cnt, int tgt_id, int numa_id)
 {
 	struct bio_dma_buffer *buf;
-	int rc;
+	int rc, i;
 
 	D_ALLOC_PTR(buf);
 	if (buf == NULL)
@@ -125,8 +357,12 @@ dma_buffer_create(unsigned int init_cnt)
 
 	D_INIT_LIST_HEAD(&buf->bdb_idle_list);
 	D_INIT_LIST_HEAD(&buf->bdb_used_list);
+	for (i = 0; i < BIO_DMA_HUGE_CLS_MAX; i++)
+		D_INIT_LIST_HEAD(&buf->bdb_huge_list[i]);
 	buf->bdb_tot_cnt = 0;
+	buf->bdb_init_cnt = init_cnt;
 	buf->bdb_active_iods = 0;
+	buf->bdb_numa_id = numa_id;
 
 	rc = ABT_mutex_create(&buf->bdb_mutex);
 	if (rc != ABT_SUCCESS) {
@@ -149,6 +385,8 @@ dma_buffer_create(unsigned int init_cnt)
 		return NULL;
 	}
 
+	dma_metrics_init(buf, tgt_id);
+
 	rc = dma_buffer_grow(buf, init_cnt);
 	if (rc != 0) {
 		dma_buffer_destroy(buf);
@@ -213,12 +451,6 @@ bio_iod_free(struct bio_desc *biod)
 	D_FREE(biod);
 }
 
-static inline bool
-dma_chunk_is_huge(struct bio_dma_chunk *chunk)
-{
-	return d_list_empty(&chunk->bdc_link);
-}
-
 /*
  * Release all the DMA chunks held by @biod, once the use count of any
  * chunk drops to zero, put it back to free list.
@@ -272,7 +504,7 @@ iod_release_buffer(struct bio_desc *biod)
 			chunk->bdc_type);
 
 		if (dma_chunk_is_huge(chunk)) {
-			dma_free_chunk(chunk);
+			dma_put_huge(bdb, chunk);
 		} else if (chunk->bdc_ref == 0) {
 			chunk->bdc_pg_idx = 0;
 			D_ASSERT(bdb->bdb_used_cnt[chunk->bdc_type] > 0);
@@ -489,8 +721,9 @@ chunk_get_idle(struct bio_dma_buffer *bdb, struct bio_dma_chunk **chk_ptr)
 	if (d_list_empty(&bdb->bdb_idle_list)) {
 		/* Try grow buffer first */
 		if (bdb->bdb_tot_cnt < bio_chk_cnt_max) {
-			rc = dma_buffer_grow(bdb, 1);
-			if (rc == 0)
+			rc = dma_buffer_grow(bdb, dma_grow_step(bdb));
+			/* Partial grow is fine as long as there is idle chunk */
+			if (rc == 0 || !d_list_empty(&bdb->bdb_idle_list))
 				goto done;
 		}
 
@@ -509,7 +742,7 @@ done:
 	return 0;
 }
 
-static int
+int
 iod_add_chunk(struct bio_desc *biod, struct bio_dma_chunk *chk)
 {
 	struct bio_rsrvd_dma *rsrvd_dma = &biod->bd_rsrvd;
@@ -722,20 +955,19 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	/*
 	 * For huge IOV, we'll bypass our per-xstream DMA buffer cache and
 	 * allocate chunk from the SPDK reserved huge pages directly, this
-	 * kind of huge chunk will be freed immediately on I/O completion.
-	 *
-	 * We assume the contiguous huge IOV is quite rare, so there won't
-	 * be high contention over the SPDK huge page cache.
+	 * kind of huge chunk is rounded up to size class, and it'll be cached
+	 * on I/O completion only when huge IODs of the same class are seen
+	 * recurring, otherwise, it'll be freed immediately.
 	 */
 	if (pg_cnt > bio_chk_sz) {
-		chk = dma_alloc_chunk(pg_cnt);
+		chk = dma_get_huge(bdb, pg_cnt);
 		if (chk == NULL)
 			return -DER_NOMEM;
 
 		chk->bdc_type = biod->bd_chk_type;
 		rc = iod_add_chunk(biod, chk);
 		if (rc) {
-			dma_free_chunk(chk);
+			dma_put_huge(bdb, chk);
 			return rc;
 		}
 		bio_iov_set_raw_buf(biov, chk->bdc_ptr + pg_off);
@@ -978,10 +1210,26 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 	D_ASSERT(pg_cnt > pg_idx);
 	pg_cnt -= pg_idx;
 
+	if (biod->bd_type == BIO_IOD_TYPE_UPDATE)
+		bio_rcache_write(biod->bd_ctxt, pg_idx, pg_cnt);
+	else if (bio_rcache_read(biod->bd_ctxt, pg_idx, pg_cnt, payload))
+		return;
+
 	/* NVMe poll needs be scheduled */
 	if (bio_need_nvme_poll(xs_ctxt))
 		bio_yield();
 
+	/* Throttle submission until inflight blob IOs drop below the limit */
+	if (xs_ctxt->bxc_blob_rw >= bio_spdk_max_qd) {
+		d_tm_inc_counter(xs_ctxt->bxc_stats.bxs_throttles, 1);
+		while (xs_ctxt->bxc_blob_rw >= bio_spdk_max_qd) {
+			if (xs_ctxt->bxc_tgt_id == -1)
+				spdk_thread_poll(xs_ctxt->bxc_thread, 0, 0);
+			else
+				bio_yield();
+		}
+	}
+
 	biod->bd_inflights++;
 	xs_ctxt->bxc_blob_rw++;
 
@@ -1003,16 +1251,42 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 				  rw_completion, biod);
 }
 
+static void
+iod_rcache_fill(struct bio_desc *biod)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_rsrvd_region	*rg;
+	uint64_t		 pg_idx, pg_cnt;
+	int			 i;
+
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
+		rg = &rsrvd_dma->brd_regions[i];
+		if (rg->brr_media != DAOS_MEDIA_NVME)
+			continue;
+
+		pg_idx = rg->brr_off >> BIO_DMA_PAGE_SHIFT;
+		pg_cnt = ((rg->brr_end + BIO_DMA_PAGE_SZ - 1) >>
+			  BIO_DMA_PAGE_SHIFT) - pg_idx;
+		bio_rcache_fill(biod->bd_ctxt, pg_idx, pg_cnt,
+				rg->brr_chk->bdc_ptr +
+				(rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT));
+	}
+}
+
 static void
 dma_rw(struct bio_desc *biod)
 {
 	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
 	struct bio_rsrvd_region	*rg;
 	struct bio_xs_context	*xs_ctxt;
+	uint64_t		 start, rc_gen;
+	bool			 nvme = false;
 	int			 i;
 
 	D_ASSERT(biod->bd_ctxt->bic_xs_ctxt);
 	xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	start = daos_get_ntime();
+	rc_gen = bio_rcache_gen(biod->bd_ctxt);
 
 	biod->bd_inflights = 0;
 	biod->bd_dma_issued = 0;
@@ -1028,12 +1302,17 @@ dma_rw(struct bio_desc *biod)
 		D_ASSERT(rg->brr_chk != NULL);
 		D_ASSERT(rg->brr_end > rg->brr_off);
 
-		if (rg->brr_media == DAOS_MEDIA_SCM)
+		if (rg->brr_media == DAOS_MEDIA_SCM) {
 			scm_rw(biod, rg);
-		else
+		} else {
 			nvme_rw(biod, rg);
+			nvme = true;
+		}
 	}
 
+	if (nvme)
+		d_tm_set_gauge(xs_ctxt->bxc_stats.bxs_qd, xs_ctxt->bxc_blob_rw);
+
 	if (xs_ctxt->bxc_tgt_id == -1) {
 		D_DEBUG(DB_IO, "Self poll completion\n");
 		xs_poll_completion(xs_ctxt, &biod->bd_inflights, 0);
@@ -1043,6 +1322,18 @@ dma_rw(struct bio_desc *biod)
 			ABT_eventual_wait(biod->bd_dma_done, NULL);
 	}
 
+	if (nvme && biod->bd_result == 0)
+		d_tm_set_gauge(biod->bd_type == BIO_IOD_TYPE_UPDATE ?
+			       xs_ctxt->bxc_stats.bxs_write_lat :
+			       xs_ctxt->bxc_stats.bxs_read_lat,
+			       (daos_get_ntime() - start) / NSEC_PER_USEC);
+
+	/* Skip cache fill if any extent was freed while reading */
+	if (nvme && biod->bd_result == 0 && xs_ctxt->bxc_rcache != NULL &&
+	    biod->bd_type == BIO_IOD_TYPE_FETCH &&
+	    rc_gen == bio_rcache_gen(biod->bd_ctxt))
+		iod_rcache_fill(biod);
+
 	biod->bd_ctxt->bic_inflight_dmas--;
 	D_DEBUG(DB_IO, "DMA done, type:%d\n", biod->bd_type);
 }
@@ -1110,6 +1401,8 @@ retry:
 
 		biod->bd_retry = 0;
 		bdb = iod_dma_buf(biod);
+		bdb->bdb_retries++;
+		d_tm_inc_counter(bdb->bdb_stats.bds_retries, 1);
 		if (!iod_should_retry(biod, bdb)) {
 			D_ERROR("Per-xstream DMA buffer isn't large enough "
 				"to satisfy large IOD %p\n", biod);
@@ -1136,6 +1429,7 @@ retry:
 
 	bdb = iod_dma_buf(biod);
 	bdb->bdb_active_iods++;
+	dma_iod_hist_add(bdb, biod);
 
 	if (biod->bd_type < BIO_IOD_TYPE_GETBUF) {
 		rc = ABT_eventual_create(0, &biod->bd_dma_done);
@@ -415,6 +415,10 @@ bulk_hdl_unhold(struct bio_bulk_hdl *hdl)
 		D_ASSERT(chk->bdc_bulk_idle < chk->bdc_bulk_cnt);
 		chk->bdc_bulk_idle++;
 
+		/* Bulk handle of huge chunk is cached along with the chunk */
+		if (dma_chunk_is_huge(chk))
+			return;
+
 		bbg = chk->bdc_bulk_grp;
 		D_ASSERT(bbg != NULL);
 		d_list_add_tail(&hdl->bbh_link, &bbg->bbg_idle_bulks);
@@ -456,6 +460,9 @@ bulk_hdl2len(struct bio_bulk_hdl *hdl)
 	struct bio_bulk_group	*bbg;
 
 	D_ASSERT(chk != NULL);
+	if (dma_chunk_is_huge(chk))
+		return chk->bdc_pg_cnt << BIO_DMA_PAGE_SHIFT;
+
 	bbg = chk->bdc_bulk_grp;
 	D_ASSERT(bbg != NULL);
 
@@ -545,8 +552,11 @@ bypass_bulk_cache(struct bio_desc *biod, struct bio_iov *biov,
 	/* Hole, no RDMA */
 	if (bio_addr_is_hole(&biov->bi_addr))
 		return true;
-	/* Huge IOV, allocate DMA buffer & create bulk handle on-the-fly */
-	if (pg_cnt > bio_chk_sz)
+	/*
+	 * Huge IOV beyond the largest huge chunk class, allocate DMA buffer &
+	 * create bulk handle on-the-fly.
+	 */
+	if (pg_cnt > bio_chk_sz && dma_huge_cls(pg_cnt) >= BIO_DMA_HUGE_CLS_MAX)
 		return true;
 	/* Get buffer operation */
 	if (biod->bd_type == BIO_IOD_TYPE_GETBUF)
@@ -614,6 +624,113 @@ roundup_pgs(unsigned int pgs)
 	return bio_chk_sz / (bio_chk_sz / pgs);
 }
 
+/*
+ * Huge IOV is mapped to a dedicated huge chunk, the bulk handle registered
+ * over the whole chunk is kept along with the chunk when it's cached in size
+ * class, then RDMA lands data straight into the DMA buffer being submitted
+ * to SPDK blob, without registering memory for each huge I/O.
+ */
+static struct bio_bulk_hdl *
+bulk_get_huge_hdl(struct bio_desc *biod, struct bio_iov *biov,
+		  unsigned int pg_cnt, unsigned int pg_off,
+		  struct bio_bulk_args *arg)
+{
+	struct bio_dma_buffer	*bdb = iod_dma_buf(biod);
+	struct bio_dma_chunk	*chk;
+	struct bio_bulk_hdl	*hdl;
+	d_sg_list_t		 sgl;
+	int			 rc;
+
+	chk = dma_get_huge(bdb, pg_cnt);
+	if (chk == NULL)
+		return NULL;
+
+	D_ASSERT(chk->bdc_pg_cnt >= pg_cnt);
+	D_ASSERT(chk->bdc_bulk_grp == NULL);
+	if (chk->bdc_bulks != NULL) {
+		D_ASSERT(chk->bdc_bulk_cnt == 1 && chk->bdc_bulk_idle == 1);
+		hdl = &chk->bdc_bulks[0];
+		D_ASSERT(hdl->bbh_bulk != NULL);
+		goto hold;
+	}
+
+	D_ALLOC_PTR(chk->bdc_bulks);
+	if (chk->bdc_bulks == NULL)
+		goto error;
+
+	hdl = &chk->bdc_bulks[0];
+	D_INIT_LIST_HEAD(&hdl->bbh_link);
+	hdl->bbh_chunk = chk;
+	hdl->bbh_pg_idx = 0;
+
+	rc = d_sgl_init(&sgl, 1);
+	if (rc)
+		goto error;
+
+	sgl.sg_nr_out = sgl.sg_nr;
+	sgl.sg_iovs[0].iov_buf = chk->bdc_ptr;
+	sgl.sg_iovs[0].iov_buf_len = (size_t)chk->bdc_pg_cnt << BIO_DMA_PAGE_SHIFT;
+	sgl.sg_iovs[0].iov_len = sgl.sg_iovs[0].iov_buf_len;
+
+	rc = bulk_create_fn(arg->ba_bulk_ctxt, &sgl, arg->ba_bulk_perm,
+			    &hdl->bbh_bulk);
+	d_sgl_fini(&sgl, false);
+	if (rc) {
+		D_ERROR("Create huge bulk handle failed. "DF_RC"\n", DP_RC(rc));
+		D_FREE(chk->bdc_bulks);
+		chk->bdc_bulks = NULL;
+		goto error;
+	}
+	chk->bdc_bulk_cnt = chk->bdc_bulk_idle = 1;
+hold:
+	chk->bdc_type = biod->bd_chk_type;
+	rc = iod_add_chunk(biod, chk);
+	if (rc)
+		goto error;
+
+	/* Huge chunk link is always empty when it's inuse */
+	D_ASSERT(d_list_empty(&hdl->bbh_link));
+	hdl->bbh_inuse = 1;
+	hdl->bbh_bulk_off = pg_off + biov->bi_prefix_len;
+	hdl->bbh_remote_idx = arg->ba_sgl_idx;
+	hdl->bbh_shareable = 0;
+	chk->bdc_bulk_idle--;
+
+	D_DEBUG(DB_IO, "Huge bulk chunk:%p[%p], cnt:%u/%u, off:%u\n",
+		chk, chk->bdc_ptr, pg_cnt, chk->bdc_pg_cnt, pg_off);
+	return hdl;
+error:
+	dma_put_huge(bdb, chk);
+	return NULL;
+}
+
+void
+bulk_chunk_fini(struct bio_dma_chunk *chk)
+{
+	struct bio_bulk_hdl	*hdl;
+	int			 rc;
+
+	D_ASSERT(chk->bdc_bulks != NULL);
+	D_ASSERT(chk->bdc_bulk_grp == NULL);
+
+	/* Only huge chunk keeps registered bulk handle after eviction */
+	if (chk->bdc_bulk_cnt != 0) {
+		D_ASSERT(chk->bdc_bulk_cnt == 1 && chk->bdc_bulk_idle == 1);
+		hdl = &chk->bdc_bulks[0];
+		D_ASSERT(hdl->bbh_inuse == 0 && hdl->bbh_bulk != NULL);
+
+		rc = bulk_free_fn(hdl->bbh_bulk);
+		if (rc)
+			D_ERROR("Failed to free bulk hdl %p "DF_RC"\n",
+				hdl->bbh_bulk, DP_RC(rc));
+		hdl->bbh_bulk = NULL;
+		chk->bdc_bulk_cnt = chk->bdc_bulk_idle = 0;
+	}
+
+	D_FREE(chk->bdc_bulks);
+	chk->bdc_bulks = NULL;
+}
+
 int
 bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 {
@@ -651,6 +768,13 @@ bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 	}
 	D_ASSERT(!BIO_ADDR_IS_DEDUP(&biov->bi_addr));
 
+	if (pg_cnt > bio_chk_sz) {
+		hdl = bulk_get_huge_hdl(biod, biov, pg_cnt, pg_off, arg);
+		if (hdl == NULL)
+			return -DER_NOMEM;
+		goto add_region;
+	}
+
 	hdl = bulk_get_hdl(biod, biov, roundup_pgs(pg_cnt), pg_off, arg);
 	if (hdl == NULL) {
 		if (biod->bd_retry)
@@ -660,6 +784,7 @@ bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 		return -DER_NOMEM;
 	}
 
+add_region:
 	bio_iov_set_raw_buf(biov, bulk_hdl2addr(hdl, pg_off));
 	rc = iod_add_region(biod, hdl->bbh_chunk, hdl->bbh_pg_idx, hdl->bbh_used_bytes,
 			    off, end, bio_iov2media(biov));
@@ -606,6 +606,8 @@ bio_ioctxt_close(struct bio_io_context *ctxt, bool skip_blob)
 	int			 rc;
 
 	xs_ctxt = ctxt->bic_xs_ctxt;
+	bio_rcache_purge(ctxt);
+
 	/* NVMe isn't configured or pool doesn't have NVMe partition */
 	if (!bio_nvme_configured() || skip_blob) {
 		d_list_del_init(&ctxt->bic_link);
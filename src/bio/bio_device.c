@@ -525,6 +525,43 @@ fill_in_traddr(struct bio_dev_info *b_info, char *dev_name)
 	return rc;
 }
 
+/*
+ * Get the NUMA node of the NVMe controller backing @dev_name, return
+ * SPDK_ENV_SOCKET_ID_ANY when it can't be determined (non-NVMe bdev, etc.).
+ */
+int
+bio_dev_numa_id(char *dev_name)
+{
+	struct bio_dev_info		 binfo = { 0 };
+	struct spdk_pci_addr		 pci_addr;
+	struct spdk_pci_device		*pci_device;
+	int				 numa_id = SPDK_ENV_SOCKET_ID_ANY;
+	int				 rc;
+
+	rc = fill_in_traddr(&binfo, dev_name);
+	if (rc || binfo.bdi_traddr == NULL)
+		return numa_id;
+
+	if (spdk_pci_addr_parse(&pci_addr, binfo.bdi_traddr)) {
+		D_ERROR("Unable to parse PCI address: %s\n", binfo.bdi_traddr);
+		goto out;
+	}
+
+	for (pci_device = spdk_pci_get_first_device(); pci_device != NULL;
+	     pci_device = spdk_pci_get_next_device(pci_device)) {
+		if (spdk_pci_addr_compare(&pci_addr, &pci_device->addr) == 0) {
+			numa_id = spdk_pci_device_get_socket_id(pci_device);
+			break;
+		}
+	}
+
+	D_DEBUG(DB_MGMT, "Device %s (%s) is on NUMA node %d\n", dev_name,
+		binfo.bdi_traddr, numa_id);
+out:
+	D_FREE(binfo.bdi_traddr);
+	return numa_id;
+}
+
 static struct bio_dev_info *
 alloc_dev_info(uuid_t dev_id, char *dev_name, struct smd_dev_info *s_info)
 {
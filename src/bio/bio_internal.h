@@ -25,6 +25,17 @@
  */
 #define NVME_MONITOR_PERIOD	    (60ULL * (NSEC_PER_SEC / NSEC_PER_USEC))
 #define NVME_MONITOR_SHORT_PERIOD   (3ULL * (NSEC_PER_SEC / NSEC_PER_USEC))
+/*
+ * Period to decay the IOD size histogram and reclaim idle DMA chunks, 10
+ * seconds by default.
+ */
+#define DMA_RECLAIM_PERIOD	    (10ULL * (NSEC_PER_SEC / NSEC_PER_USEC))
+/* Size classes (power of 2 multiples of chunk size) for cached huge chunks */
+#define BIO_DMA_HUGE_CLS_MAX	8
+/* Buckets (log2 of DMA pages) of the per-xstream IOD size histogram */
+#define BIO_DMA_HIST_MAX	20
+/* Max chunks to grow at once when large IODs are dominant */
+#define BIO_DMA_GROW_MAX	4
 
 struct bio_bulk_args {
 	void		*ba_bulk_ctxt;
@@ -80,6 +91,10 @@ struct bio_dma_chunk {
 	unsigned int	 bdc_ref;
 	/* Chunk type */
 	unsigned int	 bdc_type;
+	/* Chunk size in pages (4K page) */
+	unsigned int	 bdc_pg_cnt;
+	/* Size class of huge chunk, BIO_DMA_HUGE_CLS_MAX for non-cacheable */
+	unsigned int	 bdc_huge_cls;
 	/* == Bulk handle caching related fields == */
 	struct bio_bulk_group	*bdc_bulk_grp;
 	struct bio_bulk_hdl	*bdc_bulks;
@@ -98,6 +113,29 @@ struct bio_bulk_cache {
 	d_list_t		  bbc_grp_lru;
 };
 
+#define BIO_PROTO_DMA_STATS_LIST					\
+	X(bds_chks_tot, "total_chunks",					\
+	  "Total number of allocated DMA chunks", "chunks", D_TM_GAUGE)	\
+	X(bds_grows, "grows",						\
+	  "Number of DMA chunks allocated on buffer grow", "chunks",	\
+	  D_TM_COUNTER)							\
+	X(bds_shrinks, "shrinks",					\
+	  "Number of idle DMA chunks reclaimed", "chunks", D_TM_COUNTER)\
+	X(bds_retries, "retries",					\
+	  "Number of IODs waiting for DMA buffer", "iods", D_TM_COUNTER)\
+	X(bds_huge_allocs, "huge_allocs",				\
+	  "Number of huge DMA chunks allocated", "chunks", D_TM_COUNTER)\
+	X(bds_huge_hits, "huge_cache_hits",				\
+	  "Number of huge DMA chunks reused from cache", "chunks",	\
+	  D_TM_COUNTER)
+
+/* DMA buffer statistics exported via telemetry framework */
+struct bio_dma_stats {
+#define	X(field, fname, desc, unit, type) struct d_tm_node_t *field;
+	BIO_PROTO_DMA_STATS_LIST
+#undef X
+};
+
 /*
  * Per-xstream DMA buffer, used as SPDK dma I/O buffer or as temporary
  * RDMA buffer for ZC fetch/update over NVMe devices.
@@ -108,10 +146,24 @@ struct bio_dma_buffer {
 	struct bio_dma_chunk	*bdb_cur_chk[BIO_CHK_TYPE_MAX];
 	unsigned int		 bdb_used_cnt[BIO_CHK_TYPE_MAX];
 	unsigned int		 bdb_tot_cnt;
+	unsigned int		 bdb_init_cnt;
 	unsigned int		 bdb_active_iods;
 	ABT_cond		 bdb_wait_iods;
 	ABT_mutex		 bdb_mutex;
 	struct bio_bulk_cache	 bdb_bulk_cache;
+	/* Idle huge chunks cached by size class */
+	d_list_t		 bdb_huge_list[BIO_DMA_HUGE_CLS_MAX];
+	/* Cached huge chunks size (in bio_chk_sz units) */
+	unsigned int		 bdb_huge_cnt;
+	/* IODs waited for DMA buffer in current reclaim period */
+	unsigned int		 bdb_retries;
+	/* NUMA node where the DMA chunks are allocated from */
+	int			 bdb_numa_id;
+	/* Last reclaim timestamp */
+	uint64_t		 bdb_reclaim_ts;
+	/* Decayed histogram of IOD sizes, indexed by log2 of DMA pages */
+	uint64_t		 bdb_iod_hist[BIO_DMA_HIST_MAX];
+	struct bio_dma_stats	 bdb_stats;
 };
 
 #define BIO_PROTO_NVME_STATS_LIST					\
@@ -258,6 +310,8 @@ struct bio_dev_health {
 	void		       *bdh_error_buf; /* device error logs */
 	void		       *bdh_intel_smart_buf; /*Intel SMART attributes*/
 	uint64_t		bdh_stat_age;
+	/* Error counters seen on last monitor cycle, for adaptive cadence */
+	uint64_t		bdh_err_snap;
 	unsigned int		bdh_inflights;
 	uint16_t		bdh_vendor_id; /* PCI vendor ID */
 
@@ -343,6 +397,53 @@ struct bio_blobstore {
 				 bb_unloading:1;
 };
 
+#define BIO_PROTO_XS_STATS_LIST						\
+	X(bxs_qd, "depth",						\
+	  "Number of inflight blob I/Os", "ios", D_TM_STATS_GAUGE)	\
+	X(bxs_throttles, "throttles",					\
+	  "Number of blob I/O submissions throttled by queue depth",	\
+	  "ios", D_TM_COUNTER)						\
+	X(bxs_read_lat, "read_latency",					\
+	  "Latency of NVMe DMA read", "us", D_TM_STATS_GAUGE)		\
+	X(bxs_write_lat, "write_latency",				\
+	  "Latency of NVMe DMA write", "us", D_TM_STATS_GAUGE)
+
+/* Latency histogram: 12 buckets, starting from 8us, doubling width */
+#define BIO_LAT_HIST_BUCKETS	12
+#define BIO_LAT_HIST_WIDTH	8
+
+/* Per-xstream NVMe queue statistics exported via telemetry framework */
+struct bio_xs_stats {
+#define	X(field, fname, desc, unit, type) struct d_tm_node_t *field;
+	BIO_PROTO_XS_STATS_LIST
+#undef X
+};
+
+#define BIO_PROTO_RCACHE_STATS_LIST					\
+	X(brs_hits, "hits",						\
+	  "Number of NVMe reads served by the DRAM read cache",		\
+	  "reads", D_TM_COUNTER)					\
+	X(brs_misses, "misses",						\
+	  "Number of NVMe reads missed in the DRAM read cache",		\
+	  "reads", D_TM_COUNTER)					\
+	X(brs_evictions, "evictions",					\
+	  "Number of extents evicted from the DRAM read cache",		\
+	  "extents", D_TM_COUNTER)					\
+	X(brs_invalidations, "invalidations",				\
+	  "Number of extents invalidated by write or free",		\
+	  "extents", D_TM_COUNTER)					\
+	X(brs_size, "size",						\
+	  "Size of the DRAM read cache", "bytes", D_TM_GAUGE)
+
+/* Per-xstream DRAM read cache statistics exported via telemetry framework */
+struct bio_rcache_stats {
+#define	X(field, fname, desc, unit, type) struct d_tm_node_t *field;
+	BIO_PROTO_RCACHE_STATS_LIST
+#undef X
+};
+
+struct bio_rcache;
+
 /* Per-xstream NVMe context */
 struct bio_xs_context {
 	int			 bxc_tgt_id;
@@ -351,7 +452,10 @@ struct bio_xs_context {
 	struct bio_blobstore	*bxc_blobstore;
 	struct spdk_io_channel	*bxc_io_channel;
 	struct bio_dma_buffer	*bxc_dma_buf;
+	/* DRAM read cache, NULL if disabled */
+	struct bio_rcache	*bxc_rcache;
 	d_list_t		 bxc_io_ctxts;
+	struct bio_xs_stats	 bxc_stats;
 	unsigned int		 bxc_ready:1;	/* xstream setup finished */
 };
 
@@ -491,6 +595,7 @@ extern bool		bio_scm_rdma;
 extern bool		bio_spdk_inited;
 extern unsigned int	bio_chk_sz;
 extern unsigned int	bio_chk_cnt_max;
+extern unsigned int	bio_spdk_max_qd;
 int xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights,
 		       uint64_t timeout);
 void bio_bdev_event_cb(enum spdk_bdev_event_type type, struct spdk_bdev *bdev,
@@ -515,7 +620,9 @@ bool bypass_health_collect(void);
 
 /* bio_buffer.c */
 void dma_buffer_destroy(struct bio_dma_buffer *buf);
-struct bio_dma_buffer *dma_buffer_create(unsigned int init_cnt);
+struct bio_dma_buffer *dma_buffer_create(unsigned int init_cnt, int tgt_id,
+					 int numa_id);
+void dma_buffer_reclaim(struct bio_dma_buffer *buf, uint64_t now);
 void bio_memcpy(struct bio_desc *biod, uint16_t media, void *media_addr,
 		void *addr, ssize_t n);
 int dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg);
@@ -523,6 +630,44 @@ int iod_add_region(struct bio_desc *biod, struct bio_dma_chunk *chk,
 		   unsigned int chk_pg_idx, unsigned int chk_off, uint64_t off,
 		   uint64_t end, uint8_t media);
 int dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt);
+struct bio_dma_chunk *dma_get_huge(struct bio_dma_buffer *bdb,
+				   unsigned int pg_cnt);
+void dma_put_huge(struct bio_dma_buffer *bdb, struct bio_dma_chunk *chunk);
+int iod_add_chunk(struct bio_desc *biod, struct bio_dma_chunk *chk);
+
+/* bio_rcache.c */
+extern uint64_t		bio_rcache_sz;
+int bio_rcache_create(struct bio_xs_context *xs_ctxt);
+void bio_rcache_destroy(struct bio_xs_context *xs_ctxt);
+bool bio_rcache_read(struct bio_io_context *ctxt, uint64_t pg_idx,
+		     uint64_t pg_cnt, void *buf);
+void bio_rcache_fill(struct bio_io_context *ctxt, uint64_t pg_idx,
+		     uint64_t pg_cnt, void *buf);
+void bio_rcache_write(struct bio_io_context *ctxt, uint64_t pg_idx,
+		      uint64_t pg_cnt);
+uint64_t bio_rcache_gen(struct bio_io_context *ctxt);
+void bio_rcache_purge(struct bio_io_context *ctxt);
+
+/* Huge chunk is dedicated for single huge IOV */
+static inline bool
+dma_chunk_is_huge(struct bio_dma_chunk *chunk)
+{
+	return chunk->bdc_pg_cnt > bio_chk_sz;
+}
+
+/* Size class of huge chunk, the class covers (bio_chk_sz << (cls + 1)) pages */
+static inline unsigned int
+dma_huge_cls(unsigned int pg_cnt)
+{
+	unsigned int	cls = 0;
+
+	D_ASSERT(pg_cnt > bio_chk_sz);
+	while (cls < BIO_DMA_HUGE_CLS_MAX &&
+	       ((uint64_t)bio_chk_sz << (cls + 1)) < pg_cnt)
+		cls++;
+
+	return cls;
+}
 
 static inline struct bio_dma_buffer *
 iod_dma_buf(struct bio_desc *biod)
@@ -555,6 +700,7 @@ dma_biov2pg(struct bio_iov *biov, uint64_t *off, uint64_t *end,
 /* bio_bulk.c */
 int bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data);
 void bulk_iod_release(struct bio_desc *biod);
+void bulk_chunk_fini(struct bio_dma_chunk *chk);
 int bulk_cache_create(struct bio_dma_buffer *bdb);
 void bulk_cache_destroy(struct bio_dma_buffer *bdb);
 int bulk_reclaim_chunk(struct bio_dma_buffer *bdb,
@@ -566,11 +712,13 @@ dump_dma_info(struct bio_dma_buffer *bdb)
 	struct bio_bulk_group	*bbg;
 	int			 i, bulk_grps = 0, bulk_chunks = 0;
 
-	D_EMIT("chk_size:%u, tot_chk:%u/%u, active_iods:%u, used:%u,%u,%u\n",
+	D_EMIT("chk_size:%u, tot_chk:%u/%u, active_iods:%u, used:%u,%u,%u, "
+	       "huge_cached:%u, numa:%d\n",
 		bio_chk_sz, bdb->bdb_tot_cnt, bio_chk_cnt_max,
 		bdb->bdb_active_iods, bdb->bdb_used_cnt[BIO_CHK_TYPE_IO],
 		bdb->bdb_used_cnt[BIO_CHK_TYPE_LOCAL],
-		bdb->bdb_used_cnt[BIO_CHK_TYPE_REBUILD]);
+		bdb->bdb_used_cnt[BIO_CHK_TYPE_REBUILD],
+		bdb->bdb_huge_cnt, bdb->bdb_numa_id);
 
 	/* cached bulk info */
 	for (i = 0; i < bbc->bbc_grp_cnt; i++) {
@@ -608,6 +756,7 @@ int bio_bs_state_set(struct bio_blobstore *bbs, enum bio_bs_state new_state);
 /* bio_device.c */
 void bio_led_event_monitor(struct bio_xs_context *ctxt, uint64_t now);
 int fill_in_traddr(struct bio_dev_info *b_info, char *dev_name);
+int bio_dev_numa_id(char *dev_name);
 
 /* bio_config.c */
 int bio_add_allowed_alloc(const char *nvme_conf, struct spdk_env_opts *opts);
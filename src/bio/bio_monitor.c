@@ -723,13 +723,21 @@ collect_raw_health_data(struct bio_xs_context *ctxt)
 	}
 }
 
+static inline uint64_t
+dev_health_err_cnt(struct nvme_stats *stats)
+{
+	return stats->media_errs + stats->err_log_entries +
+	       stats->bio_read_errs + stats->bio_write_errs +
+	       stats->bio_unmap_errs + stats->checksum_errs;
+}
+
 void
 bio_bs_monitor(struct bio_xs_context *ctxt, uint64_t now)
 {
 	struct bio_dev_health	*dev_health;
 	struct bio_blobstore	*bbs;
 	int			 rc;
-	uint64_t		 monitor_period;
+	uint64_t		 monitor_period, err_cnt;
 
 	D_ASSERT(ctxt != NULL);
 	bbs = ctxt->bxc_blobstore;
@@ -737,8 +745,14 @@ bio_bs_monitor(struct bio_xs_context *ctxt, uint64_t now)
 	D_ASSERT(bbs != NULL);
 	dev_health = &bbs->bb_dev_health;
 
-	if (bbs->bb_state == BIO_BS_STATE_NORMAL ||
-	    bbs->bb_state == BIO_BS_STATE_OUT)
+	/*
+	 * Sample more often while the device is not healthy, or when new
+	 * errors showed up since the last sample.
+	 */
+	err_cnt = dev_health_err_cnt(&dev_health->bdh_health_state);
+	if ((bbs->bb_state == BIO_BS_STATE_NORMAL ||
+	     bbs->bb_state == BIO_BS_STATE_OUT) &&
+	    err_cnt == dev_health->bdh_err_snap)
 		monitor_period = NVME_MONITOR_PERIOD;
 	else
 		monitor_period = NVME_MONITOR_SHORT_PERIOD;
@@ -746,6 +760,7 @@ bio_bs_monitor(struct bio_xs_context *ctxt, uint64_t now)
 	if (dev_health->bdh_stat_age + monitor_period >= now)
 		return;
 	dev_health->bdh_stat_age = now;
+	dev_health->bdh_err_snap = err_cnt;
 
 	rc = auto_detect_faulty(bbs);
 	if (rc)
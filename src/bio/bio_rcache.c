@@ -0,0 +1,398 @@
+/**
+ * (C) Copyright 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+#define D_LOGFAC	DD_FAC(bio)
+
+#include <gurt/hash.h>
+#include "bio_internal.h"
+
+/*
+ * Per-xstream DRAM cache of the NVMe pages read by fetch.
+ *
+ * Each cached extent is the page range of one NVMe read region, it's indexed
+ * by the segment (RC_SEG_PAGES pages) of its first page, and extents larger
+ * than a segment aren't cached, so that an invalidation only needs to look at
+ * the segments covering the invalidated range plus the preceding one.
+ *
+ * NVMe extents are never overwritten in place by VOS: an extent is written
+ * once when it's reserved, and it can only be written again after being freed
+ * by aggregation or GC then reallocated, so keying the cache on the blob
+ * offset is enough as long as both writes and frees invalidate the range.
+ */
+#define RC_SEG_SHIFT	8	/* 256 pages (1MB) per segment */
+#define RC_SEG_PAGES	(1ULL << RC_SEG_SHIFT)
+#define RC_HASH_BITS	12
+
+struct rc_seg_key {
+	struct bio_io_context	*sk_ctxt;
+	uint64_t		 sk_seg;
+};
+
+struct rc_seg {
+	/* Link to rc_segs hash table */
+	d_list_t		 rs_link;
+	struct rc_seg_key	 rs_key;
+	/* Cached extents starting in this segment */
+	d_list_t		 rs_ents;
+};
+
+struct rc_ent {
+	/* Link to rc_seg::rs_ents */
+	d_list_t		 re_seg_link;
+	/* Link to bio_rcache::rc_lru */
+	d_list_t		 re_lru_link;
+	struct rc_seg		*re_seg;
+	uint64_t		 re_pg_idx;
+	uint64_t		 re_pg_cnt;
+	void			*re_buf;
+};
+
+struct bio_rcache {
+	struct d_hash_table	*rc_segs;
+	/* All cached extents, most recently used first */
+	d_list_t		 rc_lru;
+	/* Cached bytes */
+	uint64_t		 rc_size;
+	/* Cache budget in bytes */
+	uint64_t		 rc_max;
+	/* Bumped on each extent free, see bio_rcache_gen() */
+	uint64_t		 rc_gen;
+	struct bio_rcache_stats	 rc_stats;
+};
+
+/* Per-xstream cache budget in bytes, 0 means cache disabled */
+uint64_t	bio_rcache_sz;
+
+static inline struct rc_seg *
+seg_obj(d_list_t *rlink)
+{
+	return container_of(rlink, struct rc_seg, rs_link);
+}
+
+static bool
+seg_key_cmp(struct d_hash_table *htable, d_list_t *rlink, const void *key,
+	    unsigned int ksize)
+{
+	struct rc_seg	*seg = seg_obj(rlink);
+
+	D_ASSERT(ksize == sizeof(struct rc_seg_key));
+	return memcmp(&seg->rs_key, key, ksize) == 0;
+}
+
+static d_hash_table_ops_t rc_seg_ops = {
+	.hop_key_cmp	= seg_key_cmp,
+};
+
+static void
+rcache_metrics_init(struct bio_rcache *brc, int tgt_id)
+{
+	int	rc = 0;
+
+	/* Skip sensor setup on standalone vos & sys xstream */
+	if (tgt_id < 0)
+		return;
+
+#define X(field, fname, desc, unit, type)				\
+	rc = d_tm_add_metric(&brc->rc_stats.field, type, desc, unit,	\
+			     "rcache/%s/tgt_%d", fname, tgt_id);	\
+	if (rc)								\
+		D_WARN("Failed to create %s sensor for tgt %d: "DF_RC"\n",\
+		       fname, tgt_id, DP_RC(rc));
+
+	BIO_PROTO_RCACHE_STATS_LIST
+#undef X
+}
+
+int
+bio_rcache_create(struct bio_xs_context *xs_ctxt)
+{
+	struct bio_rcache	*brc;
+	int			 rc;
+
+	D_ASSERT(xs_ctxt->bxc_rcache == NULL);
+	if (bio_rcache_sz == 0)
+		return 0;
+
+	D_ALLOC_PTR(brc);
+	if (brc == NULL)
+		return -DER_NOMEM;
+
+	rc = d_hash_table_create(D_HASH_FT_NOLOCK, RC_HASH_BITS, NULL,
+				 &rc_seg_ops, &brc->rc_segs);
+	if (rc) {
+		D_ERROR("Failed to create rcache hash table. "DF_RC"\n",
+			DP_RC(rc));
+		D_FREE(brc);
+		return rc;
+	}
+
+	D_INIT_LIST_HEAD(&brc->rc_lru);
+	brc->rc_max = bio_rcache_sz;
+	rcache_metrics_init(brc, xs_ctxt->bxc_tgt_id);
+
+	xs_ctxt->bxc_rcache = brc;
+	return 0;
+}
+
+static void
+rcache_ent_free(struct bio_rcache *brc, struct rc_ent *ent)
+{
+	struct rc_seg	*seg = ent->re_seg;
+
+	d_list_del(&ent->re_seg_link);
+	d_list_del(&ent->re_lru_link);
+	D_ASSERT(brc->rc_size >= (ent->re_pg_cnt << BIO_DMA_PAGE_SHIFT));
+	brc->rc_size -= ent->re_pg_cnt << BIO_DMA_PAGE_SHIFT;
+	D_FREE(ent->re_buf);
+	D_FREE(ent);
+
+	if (d_list_empty(&seg->rs_ents)) {
+		d_hash_rec_delete_at(brc->rc_segs, &seg->rs_link);
+		D_FREE(seg);
+	}
+}
+
+void
+bio_rcache_destroy(struct bio_xs_context *xs_ctxt)
+{
+	struct bio_rcache	*brc = xs_ctxt->bxc_rcache;
+	struct rc_ent		*ent, *tmp;
+
+	if (brc == NULL)
+		return;
+
+	d_list_for_each_entry_safe(ent, tmp, &brc->rc_lru, re_lru_link)
+		rcache_ent_free(brc, ent);
+	D_ASSERT(brc->rc_size == 0);
+
+	d_hash_table_destroy(brc->rc_segs, true);
+	D_FREE(brc);
+	xs_ctxt->bxc_rcache = NULL;
+}
+
+static inline struct bio_rcache *
+ctxt2rcache(struct bio_io_context *ctxt)
+{
+	if (ctxt == NULL || ctxt->bic_xs_ctxt == NULL)
+		return NULL;
+	return ctxt->bic_xs_ctxt->bxc_rcache;
+}
+
+static struct rc_seg *
+rcache_seg_find(struct bio_rcache *brc, struct bio_io_context *ctxt,
+		uint64_t seg_idx)
+{
+	struct rc_seg_key	 key = { 0 };
+	d_list_t		*rlink;
+
+	key.sk_ctxt = ctxt;
+	key.sk_seg = seg_idx;
+	rlink = d_hash_rec_find(brc->rc_segs, &key, sizeof(key));
+
+	return rlink != NULL ? seg_obj(rlink) : NULL;
+}
+
+static struct rc_ent *
+rcache_ent_find(struct bio_rcache *brc, struct bio_io_context *ctxt,
+		uint64_t pg_idx, uint64_t pg_cnt)
+{
+	struct rc_seg	*seg;
+	struct rc_ent	*ent;
+
+	seg = rcache_seg_find(brc, ctxt, pg_idx >> RC_SEG_SHIFT);
+	if (seg == NULL)
+		return NULL;
+
+	d_list_for_each_entry(ent, &seg->rs_ents, re_seg_link) {
+		if (ent->re_pg_idx == pg_idx && ent->re_pg_cnt == pg_cnt)
+			return ent;
+	}
+	return NULL;
+}
+
+bool
+bio_rcache_read(struct bio_io_context *ctxt, uint64_t pg_idx,
+		uint64_t pg_cnt, void *buf)
+{
+	struct bio_rcache	*brc = ctxt2rcache(ctxt);
+	struct rc_ent		*ent;
+
+	if (brc == NULL || pg_cnt > RC_SEG_PAGES)
+		return false;
+
+	ent = rcache_ent_find(brc, ctxt, pg_idx, pg_cnt);
+	if (ent == NULL) {
+		d_tm_inc_counter(brc->rc_stats.brs_misses, 1);
+		return false;
+	}
+
+	memcpy(buf, ent->re_buf, pg_cnt << BIO_DMA_PAGE_SHIFT);
+	d_list_move(&ent->re_lru_link, &brc->rc_lru);
+	d_tm_inc_counter(brc->rc_stats.brs_hits, 1);
+
+	return true;
+}
+
+void
+bio_rcache_fill(struct bio_io_context *ctxt, uint64_t pg_idx,
+		uint64_t pg_cnt, void *buf)
+{
+	struct bio_rcache	*brc = ctxt2rcache(ctxt);
+	struct rc_seg		*seg;
+	struct rc_ent		*ent;
+	uint64_t		 size = pg_cnt << BIO_DMA_PAGE_SHIFT;
+	int			 rc;
+
+	if (brc == NULL || pg_cnt > RC_SEG_PAGES || size > brc->rc_max)
+		return;
+
+	/* Region was served by the cache */
+	if (rcache_ent_find(brc, ctxt, pg_idx, pg_cnt) != NULL)
+		return;
+
+	while (brc->rc_size + size > brc->rc_max) {
+		D_ASSERT(!d_list_empty(&brc->rc_lru));
+		ent = d_list_entry(brc->rc_lru.prev, struct rc_ent,
+				   re_lru_link);
+		rcache_ent_free(brc, ent);
+		d_tm_inc_counter(brc->rc_stats.brs_evictions, 1);
+	}
+
+	D_ALLOC_PTR(ent);
+	if (ent == NULL)
+		return;
+	D_ALLOC_NZ(ent->re_buf, size);
+	if (ent->re_buf == NULL)
+		goto free_ent;
+
+	seg = rcache_seg_find(brc, ctxt, pg_idx >> RC_SEG_SHIFT);
+	if (seg == NULL) {
+		D_ALLOC_PTR(seg);
+		if (seg == NULL)
+			goto free_buf;
+
+		seg->rs_key.sk_ctxt = ctxt;
+		seg->rs_key.sk_seg = pg_idx >> RC_SEG_SHIFT;
+		D_INIT_LIST_HEAD(&seg->rs_ents);
+		rc = d_hash_rec_insert(brc->rc_segs, &seg->rs_key,
+				       sizeof(seg->rs_key), &seg->rs_link,
+				       true);
+		if (rc) {
+			D_FREE(seg);
+			goto free_buf;
+		}
+	}
+
+	memcpy(ent->re_buf, buf, size);
+	ent->re_seg = seg;
+	ent->re_pg_idx = pg_idx;
+	ent->re_pg_cnt = pg_cnt;
+	d_list_add(&ent->re_seg_link, &seg->rs_ents);
+	d_list_add(&ent->re_lru_link, &brc->rc_lru);
+	brc->rc_size += size;
+	d_tm_set_gauge(brc->rc_stats.brs_size, brc->rc_size);
+	return;
+
+free_buf:
+	D_FREE(ent->re_buf);
+free_ent:
+	D_FREE(ent);
+}
+
+static void
+rcache_inval_pages(struct bio_rcache *brc, struct bio_io_context *ctxt,
+		   uint64_t pg_idx, uint64_t pg_cnt)
+{
+	struct rc_seg	*seg;
+	struct rc_ent	*ent, *tmp;
+	uint64_t	 seg_idx, seg_end, pg_end = pg_idx + pg_cnt;
+	bool		 last;
+
+	/* Extents starting in the preceding segment may overlap the range */
+	seg_idx = pg_idx >> RC_SEG_SHIFT;
+	if (seg_idx > 0)
+		seg_idx--;
+	seg_end = (pg_end - 1) >> RC_SEG_SHIFT;
+
+	for (; seg_idx <= seg_end; seg_idx++) {
+		seg = rcache_seg_find(brc, ctxt, seg_idx);
+		if (seg == NULL)
+			continue;
+
+		last = false;
+		d_list_for_each_entry_safe(ent, tmp, &seg->rs_ents,
+					   re_seg_link) {
+			if (ent->re_pg_idx >= pg_end ||
+			    ent->re_pg_idx + ent->re_pg_cnt <= pg_idx)
+				continue;
+
+			/* Segment is freed along with its last extent */
+			last = d_list_is_singular(&seg->rs_ents);
+			rcache_ent_free(brc, ent);
+			d_tm_inc_counter(brc->rc_stats.brs_invalidations, 1);
+			if (last)
+				break;
+		}
+	}
+	d_tm_set_gauge(brc->rc_stats.brs_size, brc->rc_size);
+}
+
+void
+bio_rcache_write(struct bio_io_context *ctxt, uint64_t pg_idx,
+		 uint64_t pg_cnt)
+{
+	struct bio_rcache	*brc = ctxt2rcache(ctxt);
+
+	if (brc == NULL || brc->rc_size == 0)
+		return;
+
+	rcache_inval_pages(brc, ctxt, pg_idx, pg_cnt);
+}
+
+void
+bio_rcache_invalidate(struct bio_io_context *ctxt, uint64_t off, uint64_t len)
+{
+	struct bio_rcache	*brc = ctxt2rcache(ctxt);
+	uint64_t		 pg_idx, pg_end;
+
+	if (brc == NULL || len == 0)
+		return;
+
+	/*
+	 * A fetch reading the freed extent could be inflight, it must not
+	 * populate the cache once it's done.
+	 */
+	brc->rc_gen++;
+	if (brc->rc_size == 0)
+		return;
+
+	pg_idx = off >> BIO_DMA_PAGE_SHIFT;
+	pg_end = (off + len + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT;
+	rcache_inval_pages(brc, ctxt, pg_idx, pg_end - pg_idx);
+}
+
+uint64_t
+bio_rcache_gen(struct bio_io_context *ctxt)
+{
+	struct bio_rcache	*brc = ctxt2rcache(ctxt);
+
+	return brc != NULL ? brc->rc_gen : 0;
+}
+
+void
+bio_rcache_purge(struct bio_io_context *ctxt)
+{
+	struct bio_rcache	*brc = ctxt2rcache(ctxt);
+	struct rc_ent		*ent, *tmp;
+
+	if (brc == NULL)
+		return;
+
+	d_list_for_each_entry_safe(ent, tmp, &brc->rc_lru, re_lru_link) {
+		if (ent->re_seg->rs_key.sk_ctxt == ctxt)
+			rcache_ent_free(brc, ent);
+	}
+	d_tm_set_gauge(brc->rc_stats.brs_size, brc->rc_size);
+}
@@ -35,8 +35,6 @@
 
 /* Max inflight blob IOs per io channel */
 #define BIO_BS_MAX_CHANNEL_OPS	(4096)
-/* Schedule a NVMe poll when so many blob IOs queued for an io channel */
-#define BIO_BS_POLL_WATERMARK	(2048)
 
 /* Chunk size of DMA buffer in pages */
 unsigned int bio_chk_sz;
@@ -44,6 +42,11 @@ unsigned int bio_chk_sz;
 unsigned int bio_chk_cnt_max;
 /* Per-xstream initial DMA buffer size (in chunk count) */
 static unsigned int bio_chk_cnt_init;
+/*
+ * Per-xstream inflight blob IO limit, submission is throttled when it's
+ * reached, and a NVMe poll is scheduled when half of it is reached.
+ */
+unsigned int bio_spdk_max_qd = BIO_BS_MAX_CHANNEL_OPS;
 /* Diret RDMA over SCM */
 bool bio_scm_rdma;
 /* Whether SPDK inited */
@@ -157,6 +160,7 @@ bio_nvme_init(const char *nvme_conf, int shm_id, unsigned int mem_size,
 	char		*env;
 	int		 rc, fd;
 	unsigned int	 size_mb = DAOS_DMA_CHUNK_MB;
+	unsigned int	 rcache_mb = 0;
 
 	if (tgt_nr <= 0) {
 		D_ERROR("tgt_nr: %u should be > 0\n", tgt_nr);
@@ -192,6 +196,17 @@ bio_nvme_init(const char *nvme_conf, int shm_id, unsigned int mem_size,
 	d_getenv_bool("DAOS_SCM_RDMA_ENABLED", &bio_scm_rdma);
 	D_INFO("RDMA to SCM is %s\n", bio_scm_rdma ? "enabled" : "disabled");
 
+	d_getenv_int("DAOS_NVME_QD_MAX", &bio_spdk_max_qd);
+	if (bio_spdk_max_qd < 2 || bio_spdk_max_qd > BIO_BS_MAX_CHANNEL_OPS)
+		bio_spdk_max_qd = BIO_BS_MAX_CHANNEL_OPS;
+	D_INFO("Set per-xstream NVMe queue depth limit to %u\n", bio_spdk_max_qd);
+
+	d_getenv_int("DAOS_NVME_RCACHE_MB", &rcache_mb);
+	bio_rcache_sz = ((uint64_t)rcache_mb << 20) / tgt_nr;
+	if (bio_rcache_sz != 0)
+		D_INFO("Set per-xstream NVMe read cache to "DF_U64" bytes\n",
+		       bio_rcache_sz);
+
 	/* Hugepages disabled */
 	if (mem_size == 0) {
 		D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks\n",
@@ -328,7 +343,7 @@ bio_need_nvme_poll(struct bio_xs_context *ctxt)
 {
 	if (ctxt == NULL)
 		return false;
-	return ctxt->bxc_blob_rw > BIO_BS_POLL_WATERMARK;
+	return ctxt->bxc_blob_rw > bio_spdk_max_qd / 2;
 }
 
 struct common_cp_arg {
@@ -690,7 +705,7 @@ replace_bio_bdev(struct bio_bdev *old_dev, struct bio_bdev *new_dev)
  */
 static int
 create_bio_bdev(struct bio_xs_context *ctxt, const char *bdev_name,
-		struct bio_bdev **dev_out)
+		uuid_t *bs_probed, struct bio_bdev **dev_out)
 {
 	struct bio_bdev			*d_bdev, *old_dev;
 	struct spdk_blob_store		*bs = NULL;
@@ -738,6 +753,12 @@ create_bio_bdev(struct bio_xs_context *ctxt, const char *bdev_name,
 	}
 
 	D_ASSERT(d_bdev->bb_desc != NULL);
+	/* Device ID was already read by the parallel probe on server start */
+	if (bs_probed != NULL) {
+		uuid_copy(bs_uuid, *bs_probed);
+		goto verify;
+	}
+
 	/* Try to load blobstore without specifying 'bstype' first */
 	bs = load_blobstore(ctxt, d_bdev->bb_name, NULL, false, false,
 			    NULL, NULL);
@@ -769,7 +790,7 @@ create_bio_bdev(struct bio_xs_context *ctxt, const char *bdev_name,
 		D_ERROR("Unable to unload blobstore\n");
 		goto error;
 	}
-
+verify:
 	/* Verify if the blobstore was created by DAOS */
 	if (uuid_is_null(bs_uuid)) {
 		D_ERROR("The bdev has old blobstore not created by DAOS!\n");
@@ -843,11 +864,104 @@ error:
 	return rc;
 }
 
+/* Per-bdev state for probing existing blobstores on server start */
+struct bdev_probe {
+	struct spdk_bdev	*bp_bdev;
+	/* Loaded blobstore, stays non-NULL after unload as 'existing' flag */
+	struct spdk_blob_store	*bp_bs;
+	unsigned int		*bp_inflights;
+	uuid_t			 bp_uuid;
+	int			 bp_rc;
+};
+
+static void
+probe_load_cb(void *arg, struct spdk_blob_store *bs, int rc)
+{
+	struct bdev_probe	*probe = arg;
+
+	D_ASSERT(*probe->bp_inflights > 0);
+	(*probe->bp_inflights)--;
+	probe->bp_rc = daos_errno2der(-rc);
+	probe->bp_bs = bs;
+}
+
+static void
+probe_unload_cb(void *arg, int rc)
+{
+	struct bdev_probe	*probe = arg;
+
+	D_ASSERT(*probe->bp_inflights > 0);
+	(*probe->bp_inflights)--;
+	probe->bp_rc = daos_errno2der(-rc);
+}
+
+/*
+ * Load the blobstores of all bdevs concurrently to read their device IDs,
+ * instead of loading and unloading them one after another. A bdev without
+ * blobstore is left to create_bio_bdev(), which creates a new one.
+ */
+static int
+probe_bio_bdevs(struct bio_xs_context *ctxt, struct bdev_probe *probes,
+		int probe_cnt)
+{
+	struct spdk_bs_dev	*bs_dev;
+	struct spdk_bs_opts	 bs_opts;
+	struct spdk_bs_type	 bstype;
+	const char		*bdev_name;
+	unsigned int		 inflights = 0;
+	int			 i, rc;
+
+	bs_opts = nvme_glb.bd_bs_opts;
+	strncpy(bs_opts.bstype.bstype, "", SPDK_BLOBSTORE_TYPE_LENGTH);
+
+	for (i = 0; i < probe_cnt; i++) {
+		probes[i].bp_inflights = &inflights;
+		bdev_name = spdk_bdev_get_name(probes[i].bp_bdev);
+		rc = spdk_bdev_create_bs_dev_ext(bdev_name, bio_bdev_event_cb,
+						 NULL, &bs_dev);
+		if (rc != 0) {
+			probes[i].bp_rc = daos_errno2der(-rc);
+			continue;
+		}
+		inflights++;
+		spdk_bs_load(bs_dev, &bs_opts, probe_load_cb, &probes[i]);
+	}
+	rc = xs_poll_completion(ctxt, &inflights, 0);
+	D_ASSERT(rc == 0);
+
+	for (i = 0; i < probe_cnt; i++) {
+		if (probes[i].bp_bs == NULL)
+			continue;
+
+		bstype = spdk_bs_get_bstype(probes[i].bp_bs);
+		memcpy(probes[i].bp_uuid, bstype.bstype, sizeof(uuid_t));
+		inflights++;
+		spdk_bs_unload(probes[i].bp_bs, probe_unload_cb, &probes[i]);
+	}
+	rc = xs_poll_completion(ctxt, &inflights, 0);
+	D_ASSERT(rc == 0);
+
+	for (i = 0; i < probe_cnt; i++) {
+		if (probes[i].bp_bs != NULL && probes[i].bp_rc != 0) {
+			D_ERROR("Unable to unload blobstore on %s. "DF_RC"\n",
+				spdk_bdev_get_name(probes[i].bp_bdev),
+				DP_RC(probes[i].bp_rc));
+			return probes[i].bp_rc;
+		}
+	}
+
+	return 0;
+}
+
 static int
 init_bio_bdevs(struct bio_xs_context *ctxt)
 {
-	struct spdk_bdev *bdev;
-	int rc = 0;
+	struct spdk_bdev	*bdev;
+	struct bdev_probe	*probes;
+	uuid_t			*bs_uuid;
+	uint64_t		 start = daos_getmtime_coarse();
+	int			 i, probe_cnt = 0;
+	int			 rc = 0;
 
 	D_ASSERT(!is_server_started());
 	if (spdk_bdev_first() == NULL) {
@@ -857,13 +971,40 @@ init_bio_bdevs(struct bio_xs_context *ctxt)
 
 	for (bdev = spdk_bdev_first(); bdev != NULL;
 	     bdev = spdk_bdev_next(bdev)) {
-		if (nvme_glb.bd_bdev_class != get_bdev_type(bdev))
-			continue;
+		if (nvme_glb.bd_bdev_class == get_bdev_type(bdev))
+			probe_cnt++;
+	}
 
-		rc = create_bio_bdev(ctxt, spdk_bdev_get_name(bdev), NULL);
+	if (probe_cnt == 0)
+		return rc;
+
+	D_ALLOC_ARRAY(probes, probe_cnt);
+	if (probes == NULL)
+		return -DER_NOMEM;
+
+	i = 0;
+	for (bdev = spdk_bdev_first(); bdev != NULL;
+	     bdev = spdk_bdev_next(bdev)) {
+		if (nvme_glb.bd_bdev_class == get_bdev_type(bdev))
+			probes[i++].bp_bdev = bdev;
+	}
+
+	rc = probe_bio_bdevs(ctxt, probes, probe_cnt);
+	if (rc)
+		goto out;
+
+	for (i = 0; i < probe_cnt; i++) {
+		bs_uuid = probes[i].bp_bs != NULL ? &probes[i].bp_uuid : NULL;
+		rc = create_bio_bdev(ctxt, spdk_bdev_get_name(probes[i].bp_bdev),
+				     bs_uuid, NULL);
 		if (rc)
 			break;
 	}
+
+	D_INFO("Initialized %d bdevs in "DF_U64" ms\n", probe_cnt,
+	       daos_getmtime_coarse() - start);
+out:
+	D_FREE(probes);
 	return rc;
 }
 
@@ -1268,15 +1409,56 @@ bio_xsctxt_free(struct bio_xs_context *ctxt)
 		ctxt->bxc_dma_buf = NULL;
 	}
 
+	bio_rcache_destroy(ctxt);
 	D_FREE(ctxt);
 }
 
+static void
+xs_lat_hist_init(struct d_tm_node_t *node, const char *name, int tgt_id)
+{
+	char	path[64];
+	int	rc;
+
+	if (node == NULL)
+		return;
+
+	snprintf(path, sizeof(path), "nvme_queue/%s/tgt_%d", name, tgt_id);
+	rc = d_tm_init_histogram(node, path, BIO_LAT_HIST_BUCKETS,
+				 BIO_LAT_HIST_WIDTH, 2);
+	if (rc)
+		D_WARN("Failed to create %s histogram for tgt %d: "DF_RC"\n",
+		       name, tgt_id, DP_RC(rc));
+}
+
+static void
+xs_metrics_init(struct bio_xs_context *ctxt, int tgt_id)
+{
+	int	rc;
+
+	/* Skip sensor setup on standalone vos & sys xstream */
+	if (tgt_id < 0)
+		return;
+
+#define X(field, fname, desc, unit, type)				\
+	rc = d_tm_add_metric(&ctxt->bxc_stats.field, type, desc, unit,	\
+			     "nvme_queue/%s/tgt_%d", fname, tgt_id);	\
+	if (rc)								\
+		D_WARN("Failed to create %s sensor for tgt %d: "DF_RC"\n",\
+		       fname, tgt_id, DP_RC(rc));
+
+	BIO_PROTO_XS_STATS_LIST
+#undef X
+
+	xs_lat_hist_init(ctxt->bxc_stats.bxs_read_lat, "read_latency", tgt_id);
+	xs_lat_hist_init(ctxt->bxc_stats.bxs_write_lat, "write_latency", tgt_id);
+}
+
 int
 bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id)
 {
 	struct bio_xs_context	*ctxt;
 	char			 th_name[32];
-	int			 rc;
+	int			 numa_id, rc;
 
 	D_ALLOC_PTR(ctxt);
 	if (ctxt == NULL)
@@ -1287,7 +1469,8 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id)
 
 	/* Skip NVMe context setup if the daos_nvme.conf isn't present */
 	if (!bio_nvme_configured()) {
-		ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init);
+		ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id,
+						      SPDK_ENV_SOCKET_ID_ANY);
 		if (ctxt->bxc_dma_buf == NULL) {
 			D_FREE(ctxt);
 			*pctxt = NULL;
@@ -1297,6 +1480,8 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id)
 		return 0;
 	}
 
+	xs_metrics_init(ctxt, tgt_id);
+
 	ABT_mutex_lock(nvme_glb.bd_mutex);
 
 	nvme_glb.bd_xstream_cnt++;
@@ -1363,12 +1548,21 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id)
 	if (rc)
 		goto out;
 
-	ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init);
+	/* Allocate DMA buffer from the NUMA node of the NVMe controller */
+	D_ASSERT(ctxt->bxc_blobstore != NULL);
+	numa_id = bio_dev_numa_id(ctxt->bxc_blobstore->bb_dev->bb_name);
+	ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id,
+					      numa_id);
 	if (ctxt->bxc_dma_buf == NULL) {
 		D_ERROR("failed to initialize dma buffer\n");
 		rc = -DER_NOMEM;
 		goto out;
 	}
+
+	rc = bio_rcache_create(ctxt);
+	if (rc)
+		D_ERROR("failed to initialize read cache, "DF_RC"\n",
+			DP_RC(rc));
 out:
 	ABT_mutex_unlock(nvme_glb.bd_mutex);
 	if (rc != 0)
@@ -1470,7 +1664,8 @@ scan_bio_bdevs(struct bio_xs_context *ctxt, uint64_t now)
 
 		scan_period = 0;
 
-		rc = create_bio_bdev(ctxt, spdk_bdev_get_name(bdev), &d_bdev);
+		rc = create_bio_bdev(ctxt, spdk_bdev_get_name(bdev), NULL,
+				     &d_bdev);
 		if (rc) {
 			D_ERROR("Failed to init hot plugged device %s\n",
 				spdk_bdev_get_name(bdev));
@@ -1577,6 +1772,9 @@ bio_nvme_poll(struct bio_xs_context *ctxt)
 	D_ASSERT(ctxt != NULL && ctxt->bxc_thread != NULL);
 	rc = spdk_thread_poll(ctxt->bxc_thread, 0, 0);
 
+	if (ctxt->bxc_dma_buf != NULL)
+		dma_buffer_reclaim(ctxt->bxc_dma_buf, now);
+
 	/*
 	 * To avoid complicated race handling (init xstream and starting
 	 * VOS xstream concurrently access global device list & xstream
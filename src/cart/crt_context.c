@@ -25,8 +25,7 @@ epi_op_key_hash(struct d_hash_table *hhtab, const void *key,
 {
 	D_ASSERT(ksize == sizeof(d_rank_t));
 
-	return (uint32_t)(*(const uint32_t *)key
-			 & ((1U << CRT_EPI_TABLE_BITS) - 1));
+	return *(const uint32_t *)key;
 }
 
 static bool
@@ -46,8 +45,7 @@ epi_op_rec_hash(struct d_hash_table *htable, d_list_t *link)
 {
 	struct crt_ep_inflight *epi = epi_link2ptr(link);
 
-	return (uint32_t)epi->epi_ep.ep_rank
-			& ((1U << CRT_EPI_TABLE_BITS) - 1);
+	return (uint32_t)epi->epi_ep.ep_rank;
 }
 
 static void
@@ -154,8 +152,9 @@ crt_context_init(crt_context_t crt_ctx)
 	}
 
 	/* create epi table, use external lock */
-	rc = d_hash_table_create_inplace(D_HASH_FT_NOLOCK, CRT_EPI_TABLE_BITS,
-					 NULL, &epi_table_ops,
+	rc = d_hash_table_create_inplace(D_HASH_FT_NOLOCK | D_HASH_FT_RESIZE,
+					 CRT_EPI_TABLE_BITS, NULL,
+					 &epi_table_ops,
 					 &ctx->cc_epi_table);
 	if (rc != 0) {
 		D_ERROR("d_hash_table_create() failed, " DF_RC "\n", DP_RC(rc));
@@ -231,6 +230,7 @@ crt_context_provider_create(crt_context_t *crt_ctx, int provider)
 	}
 
 	ctx->cc_idx = cur_ctx_num;
+	ctx->cc_spin_us = crt_gdata.cg_progress_spin_us;
 
 	ctx_list = crt_provider_get_ctx_list(provider);
 
@@ -387,6 +387,17 @@ crt_rpc_complete(struct crt_rpc_priv *rpc_priv, int rc)
 		rpc_priv->crp_complete_cb(&cbinfo);
 	}
 
+	if (unlikely(rpc_priv->crp_flags & CRT_RPC_FLAG_TRACE) &&
+	    rpc_priv->crp_trace_ts != 0)
+		D_INFO("trace %#lx: opc %#x (%s) to %d:%d completed in %lu us, "
+		       DF_RC"\n", rpc_priv->crp_req_hdr.cch_rpcid,
+		       rpc_priv->crp_pub.cr_opc,
+		       crt_opc_to_str(rpc_priv->crp_pub.cr_opc),
+		       rpc_priv->crp_pub.cr_ep.ep_rank,
+		       rpc_priv->crp_pub.cr_ep.ep_tag,
+		       d_timeus_secdiff(0) - rpc_priv->crp_trace_ts,
+		       DP_RC(rc != 0 ? rc : rpc_priv->crp_reply_hdr.cch_rc));
+
 	RPC_DECREF(rpc_priv);
 }
 
@@ -1424,6 +1435,47 @@ crt_progress_cond(crt_context_t crt_ctx, int64_t timeout,
 	return rc;
 }
 
+/**
+ * Busy-poll the network w/o blocking for up to the spin budget of the context
+ * (bounded by \a timeout if positive). Spinning is only worth it when a reply
+ * or a new request is likely to show up soon, i.e. there are in-flight RPCs or
+ * the context made progress recently; otherwise fall through to the blocking
+ * call and leave the core to others.
+ *
+ * \return	0 if some progress was made, -DER_TIMEDOUT if the budget was
+ *		exhausted, negative value on other failures.
+ */
+static int
+crt_progress_spin(struct crt_context *ctx, int64_t *timeout)
+{
+	uint64_t	now;
+	uint64_t	start;
+	uint64_t	budget;
+	int		rc;
+
+	budget = ctx->cc_spin_us;
+	if (*timeout > 0 && *timeout < budget)
+		budget = *timeout;
+
+	start = d_timeus_secdiff(0);
+	if (ctx->cc_bh_timeout.d_bh_nodes_cnt == 0 &&
+	    start - ctx->cc_active_us > ctx->cc_spin_us)
+		return -DER_TIMEDOUT;
+
+	do {
+		rc = crt_hg_progress(&ctx->cc_hg_ctx, 0);
+		now = d_timeus_secdiff(0);
+		if (rc != -DER_TIMEDOUT)
+			break;
+	} while (now - start < budget);
+
+	if (*timeout > 0)
+		*timeout = (now - start >= *timeout) ? 0 :
+			   *timeout - (now - start);
+
+	return rc;
+}
+
 int
 crt_progress(crt_context_t crt_ctx, int64_t timeout)
 {
@@ -1453,6 +1505,16 @@ crt_progress(crt_context_t crt_ctx, int64_t timeout)
 	crt_context_timeout_check(ctx);
 	timeout = crt_exec_progress_cb(ctx, timeout);
 
+	if (rc == -DER_TIMEDOUT && timeout != 0 && ctx->cc_spin_us != 0) {
+		/** hybrid mode, spin for a while before blocking */
+		rc = crt_progress_spin(ctx, &timeout);
+		if (unlikely(rc && rc != -DER_TIMEDOUT))
+			D_ERROR("crt_hg_progress failed, rc: %d.\n", rc);
+		/** got something while spinning, don't block */
+		if (rc == 0)
+			timeout = 0;
+	}
+
 	if (timeout != 0 && (rc == 0 || rc == -DER_TIMEDOUT)) {
 		/** call progress once again with the real timeout */
 		rc = crt_hg_progress(&ctx->cc_hg_ctx, timeout);
@@ -1460,6 +1522,9 @@ crt_progress(crt_context_t crt_ctx, int64_t timeout)
 			D_ERROR("crt_hg_progress failed, rc: %d.\n", rc);
 	}
 
+	if (rc == 0 && ctx->cc_spin_us != 0)
+		ctx->cc_active_us = d_timeus_secdiff(0);
+
 	return rc;
 }
 
@@ -1584,6 +1649,30 @@ exit:
 	return rc;
 }
 
+int
+crt_context_set_spin(crt_context_t crt_ctx, uint32_t spin_us)
+{
+	struct crt_context	*ctx;
+	int			rc = 0;
+
+	if (crt_ctx == CRT_CONTEXT_NULL) {
+		D_ERROR("NULL context passed\n");
+		D_GOTO(exit, rc = -DER_INVAL);
+	}
+
+	if (spin_us > CRT_PROGRESS_SPIN_MAX_US) {
+		D_ERROR("Invalid spin budget %u, max %u\n", spin_us,
+			CRT_PROGRESS_SPIN_MAX_US);
+		D_GOTO(exit, rc = -DER_INVAL);
+	}
+
+	ctx = crt_ctx;
+	ctx->cc_spin_us = spin_us;
+
+exit:
+	return rc;
+}
+
 /* Execute handling for unreachable rpcs */
 void
 crt_req_force_timeout(struct crt_rpc_priv *rpc_priv)
@@ -1173,6 +1173,7 @@ crt_grp_priv_destroy(struct crt_grp_priv *grp_priv)
 		d_hash_table_destroy_inplace(&grp_priv->gp_s2p_table, true);
 	}
 
+	d_rank_list_free(grp_priv->gp_tree_order);
 	D_FREE(grp_priv->gp_psr_phy_addr);
 	D_FREE(grp_priv->gp_pub.cg_grpid);
 
@@ -1453,6 +1454,41 @@ out:
 	return rc;
 }
 
+int
+crt_group_tree_order_set(crt_group_t *grp, d_rank_list_t *ranks)
+{
+	struct crt_grp_priv	*grp_priv;
+	d_rank_list_t		*order = NULL;
+	int			 rc = 0;
+
+	if (!crt_initialized()) {
+		D_ERROR("CRT not initialized.\n");
+		D_GOTO(out, rc = -DER_UNINIT);
+	}
+
+	grp_priv = crt_grp_pub2priv(grp);
+	if (!grp_priv) {
+		D_ERROR("Invalid group\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	if (ranks != NULL && ranks->rl_nr > 0) {
+		rc = d_rank_list_dup(&order, ranks);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	D_RWLOCK_WRLOCK(&grp_priv->gp_rwlock);
+	d_rank_list_free(grp_priv->gp_tree_order);
+	grp_priv->gp_tree_order = order;
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+
+	D_DEBUG(DB_TRACE, "group %s tree order set with %u ranks.\n",
+		grp_priv->gp_pub.cg_grpid, order == NULL ? 0 : order->rl_nr);
+out:
+	return rc;
+}
+
 static int
 crt_primary_grp_init(crt_group_id_t grpid)
 {
@@ -86,6 +86,8 @@ struct crt_grp_priv {
 	d_rank_t		 gp_self;
 	/* List of PSR ranks */
 	d_rank_list_t		 *gp_psr_ranks;
+	/* locality order of members for CRT_TREE_DOMAIN trees */
+	d_rank_list_t		 *gp_tree_order;
 	/* PSR rank in attached group */
 	d_rank_t		 gp_psr_rank;
 	/* PSR phy addr address in attached group */
@@ -871,7 +871,7 @@ crt_rpc_handler_common(hg_handle_t hg_hdl)
 	}
 	D_ASSERT(opc_info->coi_opc == opc);
 
-	D_ALLOC(rpc_priv, opc_info->coi_rpc_size);
+	rpc_priv = crt_rpc_priv_mem_alloc(opc_info, false);
 	if (unlikely(rpc_priv == NULL)) {
 		crt_hg_reply_error_send(&rpc_tmp, -DER_DOS);
 		crt_hg_unpack_cleanup(proc);
@@ -891,6 +891,8 @@ crt_rpc_handler_common(hg_handle_t hg_hdl)
 	rpc_pub->cr_opc = rpc_tmp.crp_pub.cr_opc;
 	rpc_pub->cr_ep.ep_rank = rpc_priv->crp_req_hdr.cch_dst_rank;
 	rpc_pub->cr_ep.ep_tag = rpc_priv->crp_req_hdr.cch_dst_tag;
+	if (unlikely(rpc_priv->crp_flags & CRT_RPC_FLAG_TRACE))
+		rpc_priv->crp_trace_ts = d_timeus_secdiff(0);
 
 	RPC_TRACE(DB_ALL, rpc_priv,
 		  "(opc: %#x rpc_pub: %p) allocated per RPC request received.\n",
@@ -903,7 +905,7 @@ crt_rpc_handler_common(hg_handle_t hg_hdl)
 		crt_hg_reply_error_send(&rpc_tmp, -DER_MISC);
 		crt_hg_unpack_cleanup(proc);
 		HG_Destroy(rpc_tmp.crp_hg_hdl);
-		D_FREE(rpc_priv);
+		crt_rpc_priv_mem_free(rpc_priv);
 		D_GOTO(out, hg_ret = HG_SUCCESS);
 	}
 
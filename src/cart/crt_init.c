@@ -29,7 +29,8 @@ dump_envariables(void)
 		"OFI_PORT", "OFI_INTERFACE", "OFI_DOMAIN", "CRT_CREDIT_EP_CTX",
 		"CRT_CTX_SHARE_ADDR", "CRT_CTX_NUM", "D_FI_CONFIG",
 		"FI_UNIVERSE_SIZE", "CRT_ENABLE_MEM_PIN",
-		"FI_OFI_RXM_USE_SRX", "D_LOG_FLUSH", "CRT_MRC_ENABLE" };
+		"FI_OFI_RXM_USE_SRX", "D_LOG_FLUSH", "CRT_MRC_ENABLE",
+		"CRT_RPC_POOL", "CRT_PROGRESS_SPIN_US", "CRT_TRACE_SAMPLE" };
 
 	D_INFO("-- ENVARS: --\n");
 	for (i = 0; i < ARRAY_SIZE(envars); i++) {
@@ -110,7 +111,10 @@ static int data_init(int server, crt_init_options_t *opt)
 	uint32_t	credits;
 	uint32_t	fi_univ_size = 0;
 	uint32_t	mem_pin_enable = 0;
-	uint32_t	mrc_enable = 0;
+	uint32_t	mrc_enable;
+	uint32_t	spin_us = 0;
+	uint32_t	trace_sample = 0;
+	bool		rpc_pool;
 	uint64_t	start_rpcid;
 	int		rc = 0;
 
@@ -182,10 +186,44 @@ static int data_init(int server, crt_init_options_t *opt)
 		setenv("FI_UNIVERSE_SIZE", "2048", 1);
 	}
 
+	rpc_pool = true;
+	d_getenv_bool("CRT_RPC_POOL", &rpc_pool);
+	crt_gdata.cg_rpc_pool = rpc_pool ? 1 : 0;
+	D_DEBUG(DB_ALL, "RPC descriptor pool is %s.\n",
+		rpc_pool ? "enabled" : "disabled");
+
+	d_getenv_int("CRT_PROGRESS_SPIN_US", &spin_us);
+	if (spin_us > CRT_PROGRESS_SPIN_MAX_US) {
+		D_WARN("CRT_PROGRESS_SPIN_US %u exceeds max, use %u.\n",
+		       spin_us, CRT_PROGRESS_SPIN_MAX_US);
+		spin_us = CRT_PROGRESS_SPIN_MAX_US;
+	}
+	crt_gdata.cg_progress_spin_us = spin_us;
+	D_DEBUG(DB_ALL, "progress busy-poll budget set as %u us.\n", spin_us);
+
+	/** Trace one out of every CRT_TRACE_SAMPLE RPCs sent, 0 disables */
+	d_getenv_int("CRT_TRACE_SAMPLE", &trace_sample);
+	crt_gdata.cg_trace_sample = trace_sample;
+	if (trace_sample != 0)
+		D_INFO("tracing one out of %u RPCs.\n", trace_sample);
+
+	/**
+	 * Memory registration cache of the provider. Clients register the
+	 * application buffers of every bulk I/O, so let them reuse the NIC
+	 * registrations of recently used buffers. The provider cache relies on
+	 * its memory monitor (userfaultfd/memhooks) to invalidate entries when
+	 * the application unmaps or frees the buffers, which a cache at the
+	 * crt_bulk level could not do safely. Servers keep it disabled by
+	 * default. An explicit FI_MR_CACHE_MAX_COUNT is left untouched.
+	 */
+	mrc_enable = server ? 0 : 1;
 	d_getenv_int("CRT_MRC_ENABLE", &mrc_enable);
 	if (mrc_enable == 0) {
 		D_INFO("Disabling MR CACHE (FI_MR_CACHE_MAX_COUNT=0)\n");
-		setenv("FI_MR_CACHE_MAX_COUNT", "0", 1);
+		setenv("FI_MR_CACHE_MAX_COUNT", "0", 0);
+	} else {
+		D_DEBUG(DB_ALL, "MR CACHE enabled, FI_MR_CACHE_MAX_COUNT=%s\n",
+			getenv("FI_MR_CACHE_MAX_COUNT"));
 	}
 
 	if (credits == 0) {
@@ -20,6 +20,7 @@
 #include <gurt/hash.h>
 #include <gurt/heap.h>
 #include <gurt/atomic.h>
+#include <gurt/slab.h>
 #include <gurt/telemetry_common.h>
 #include <gurt/telemetry_producer.h>
 
@@ -77,6 +78,12 @@ struct crt_gdata {
 	/** credits limitation for #inflight RPCs per target EP CTX */
 	uint32_t		cg_credit_ep_ctx;
 
+	/** default busy-poll budget (micro-second) of crt_progress() */
+	uint32_t		cg_progress_spin_us;
+
+	/** trace one out of cg_trace_sample originated RPCs, 0 disables */
+	uint32_t		cg_trace_sample;
+
 	/** the global opcode map */
 	struct crt_opc_map	*cg_opc_map;
 	/** HG level global data */
@@ -95,7 +102,9 @@ struct crt_gdata {
 				/** whether it is a client or server */
 				cg_server		: 1,
 				/** whether scalable endpoint is enabled */
-				cg_use_sensors		: 1;
+				cg_use_sensors		: 1,
+				/** whether RPC descriptors are pooled */
+				cg_rpc_pool		: 1;
 
 	ATOMIC uint64_t		cg_rpcid; /* rpc id */
 
@@ -157,6 +166,9 @@ struct crt_plugin_gdata {
 
 extern struct crt_plugin_gdata		crt_plugin_gdata;
 
+/* upper bound of the busy-poll budget of crt_progress() (micro-second) */
+#define CRT_PROGRESS_SPIN_MAX_US	(10000)
+
 /* (1 << CRT_EPI_TABLE_BITS) is the number of buckets of epi hash table */
 #define CRT_EPI_TABLE_BITS		(3)
 #define CRT_DEFAULT_CREDITS_PER_EP_CTX	(32)
@@ -186,6 +198,16 @@ struct crt_context {
 	/** HLC time of last received RPC */
 	uint64_t		 cc_last_unpack_hlc;
 
+	/**
+	 * Hybrid progress: crt_progress() busy-polls the network for up to
+	 * cc_spin_us micro-seconds before blocking, as long as there are
+	 * in-flight RPCs or the context saw some activity within the last
+	 * spin budget. Zero disables busy-polling.
+	 */
+	uint32_t		 cc_spin_us;
+	/** monotonic time (micro-second) of the last progress activity */
+	uint64_t		 cc_active_us;
+
 	/** Per-context statistics (server-side only) */
 	/** Total number of timed out requests, of type counter */
 	struct d_tm_node_t	*cc_timedout;
@@ -254,6 +276,10 @@ struct crt_opc_info {
 	off_t			 coi_input_offset;
 	off_t			 coi_output_offset;
 	struct crt_req_format	*coi_crf;
+
+	/* Pool of RPC descriptors (with in/out buffers) of this opcode */
+	struct d_slab		 coi_slab;
+	struct d_slab_type	*coi_slab_type;
 };
 
 /* opcode map (three-level array) */
@@ -92,13 +92,20 @@ struct ivf_key_in_progress {
 
 	bool		kip_rpc_in_progress;
 	uint32_t	kip_refcnt;
-	/* Link to crt_ivns_internal::cii_keys_in_progress_list */
+	/* Link to crt_ivns_internal::cii_kip_buckets */
 	d_list_t	kip_link;
 
 	/* Payload for kip_key->iov_buf */
 	uintptr_t	payload[0];
 };
 
+/*
+ * Number of buckets of the keys in progress table, a power of 2. Thousands of
+ * distinct keys (e.g. container handles) may be fetched at the same time, and
+ * the table is looked up under cii_lock for every fetch and fetch reply.
+ */
+#define CRT_IV_KIP_BUCKETS	(64)
+
 /* Internal ivns structure */
 struct crt_ivns_internal {
 	/* IV Classes registered with this iv namespace */
@@ -113,8 +120,8 @@ struct crt_ivns_internal {
 	/* Global namespace identifier */
 	struct crt_global_ns		 cii_gns;
 
-	/* Link list of all keys in progress */
-	d_list_t			 cii_keys_in_progress_list;
+	/* Keys in progress, hashed by key content */
+	d_list_t			 cii_kip_buckets[CRT_IV_KIP_BUCKETS];
 
 	/* Lock for modification of pending list */
 	pthread_mutex_t			 cii_lock;
@@ -241,36 +248,47 @@ crt_iv_keys_match(crt_iv_key_t *key1, crt_iv_key_t *key2)
 	return false;
 }
 
+static inline d_list_t *
+crt_ivf_kip_bucket(struct crt_ivns_internal *ivns, crt_iv_key_t *key)
+{
+	uint64_t	hash;
+
+	hash = d_hash_murmur64(key->iov_buf, key->iov_len, 0);
+	return &ivns->cii_kip_buckets[hash & (CRT_IV_KIP_BUCKETS - 1)];
+}
+
 /* Check if key is in progress; if so return locked KIP entry */
 static struct ivf_key_in_progress *
 crt_ivf_key_in_progress_find(struct crt_ivns_internal *ivns,
 			     struct crt_iv_ops *ops, crt_iv_key_t *key)
 {
 	struct ivf_key_in_progress *entry;
-	bool found = false;
-
-	d_list_for_each_entry(entry, &ivns->cii_keys_in_progress_list,
-			      kip_link) {
-		/* Use keys_match callback if client provided one */
-		if (ops->ivo_keys_match) {
-			if (ops->ivo_keys_match(ivns, &entry->kip_key, key)) {
-				found = true;
-				break;
-			}
-		} else {
-			if (crt_iv_keys_match(&entry->kip_key, key)) {
-				found = true;
-				break;
+	int i;
+
+	/* Use keys_match callback if client provided one */
+	if (ops->ivo_keys_match) {
+		/* matching keys may hash differently, check all buckets */
+		for (i = 0; i < CRT_IV_KIP_BUCKETS; i++) {
+			d_list_for_each_entry(entry,
+					      &ivns->cii_kip_buckets[i],
+					      kip_link) {
+				if (ops->ivo_keys_match(ivns, &entry->kip_key,
+							key))
+					goto found;
 			}
 		}
+		return NULL;
 	}
 
-	if (found) {
-		D_MUTEX_LOCK(&entry->kip_lock);
-		return entry;
+	d_list_for_each_entry(entry, crt_ivf_kip_bucket(ivns, key), kip_link) {
+		if (crt_iv_keys_match(&entry->kip_key, key))
+			goto found;
 	}
 
 	return NULL;
+found:
+	D_MUTEX_LOCK(&entry->kip_lock);
+	return entry;
 }
 
 /* Mark key as being in progress */
@@ -301,8 +319,7 @@ crt_ivf_key_in_progress_set(struct crt_ivns_internal *ivns,
 	memcpy(entry->kip_key.iov_buf, key->iov_buf, key->iov_buf_len);
 	D_INIT_LIST_HEAD(&entry->kip_pending_fetch_list);
 
-	/* TODO: Change to hash table */
-	d_list_add_tail(&entry->kip_link, &ivns->cii_keys_in_progress_list);
+	d_list_add_tail(&entry->kip_link, crt_ivf_kip_bucket(ivns, key));
 
 	D_MUTEX_LOCK(&entry->kip_lock);
 
@@ -654,6 +671,7 @@ crt_ivns_internal_create(crt_context_t crt_ctx, struct crt_grp_priv *grp_priv,
 {
 	struct crt_ivns_internal	*ivns_internal;
 	struct crt_ivns_id		*internal_ivns_id;
+	int				i;
 	int				rc;
 
 	D_ALLOC_PTR(ivns_internal);
@@ -683,7 +701,8 @@ crt_ivns_internal_create(crt_context_t crt_ctx, struct crt_grp_priv *grp_priv,
 		D_GOTO(exit, ivns_internal = NULL);
 	}
 
-	D_INIT_LIST_HEAD(&ivns_internal->cii_keys_in_progress_list);
+	for (i = 0; i < CRT_IV_KIP_BUCKETS; i++)
+		D_INIT_LIST_HEAD(&ivns_internal->cii_kip_buckets[i]);
 
 	internal_ivns_id = &ivns_internal->cii_gns.gn_ivns_id;
 
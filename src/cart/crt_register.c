@@ -75,9 +75,15 @@ out:
 static void
 crt_opc_map_L3_destroy(struct crt_opc_map_L3 *L3_entry)
 {
+	int	i;
+
 	if (L3_entry == NULL)
 		return;
 
+	for (i = 0; L3_entry->L3_map != NULL &&
+		    i < L3_entry->L3_num_slots_total; i++)
+		crt_opc_slab_fini(&L3_entry->L3_map[i]);
+
 	L3_entry->L3_num_slots_total = 0;
 	L3_entry->L3_num_slots_used = 0;
 	if (L3_entry->L3_map)
@@ -254,6 +260,7 @@ crt_opc_reg(struct crt_opc_info *opc_info, crt_opcode_t opc, uint32_t flags,
 						size_out, 64);
 	opc_info->coi_rpc_size = sizeof(struct crt_rpc_priv) +
 				 opc_info->coi_input_offset + size_in;
+	crt_opc_slab_init(opc_info);
 
 	/* set RPC features */
 	opc_info->coi_no_reply = D_BIT_IS_SET(flags, CRT_RPC_FEAT_NO_REPLY);
@@ -434,10 +434,7 @@ crt_rpc_priv_alloc(crt_opcode_t opc, struct crt_rpc_priv **priv_allocated,
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
-	if (forward)
-		D_ALLOC(rpc_priv, opc_info->coi_input_offset);
-	else
-		D_ALLOC(rpc_priv, opc_info->coi_rpc_size);
+	rpc_priv = crt_rpc_priv_mem_alloc(opc_info, forward);
 	if (rpc_priv == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
@@ -468,7 +465,114 @@ crt_rpc_priv_free(struct crt_rpc_priv *rpc_priv)
 
 	D_SPIN_DESTROY(&rpc_priv->crp_lock);
 
-	D_FREE(rpc_priv);
+	crt_rpc_priv_mem_free(rpc_priv);
+}
+
+/* Max free RPC descriptors cached for each opcode */
+#define CRT_RPC_POOL_MAX_FREE	(512)
+/* RPC descriptors cached by each thread for each opcode */
+#define CRT_RPC_POOL_MAG_SIZE	(32)
+
+static void
+crt_rpc_slab_init(void *ptr, void *arg)
+{
+	struct crt_rpc_priv	*rpc_priv = ptr;
+
+	rpc_priv->crp_opc_info = arg;
+}
+
+/* Reset the descriptor as it was just allocated by D_ALLOC */
+static bool
+crt_rpc_slab_reset(void *ptr)
+{
+	struct crt_rpc_priv	*rpc_priv = ptr;
+	struct crt_opc_info	*opc_info = rpc_priv->crp_opc_info;
+
+	memset(rpc_priv, 0, opc_info->coi_rpc_size);
+	rpc_priv->crp_opc_info = opc_info;
+
+	return true;
+}
+
+void
+crt_opc_slab_init(struct crt_opc_info *opc_info)
+{
+	struct d_slab_reg	reg = {
+		.sr_init		= crt_rpc_slab_init,
+		.sr_reset		= crt_rpc_slab_reset,
+		.sr_name		= "crt_rpc_priv",
+		.sr_size		= opc_info->coi_rpc_size,
+		.sr_offset		= offsetof(struct crt_rpc_priv,
+						   crp_slab_link),
+		.sr_max_free_desc	= CRT_RPC_POOL_MAX_FREE,
+		.sr_mag_size		= CRT_RPC_POOL_MAG_SIZE,
+	};
+	int			rc;
+
+	if (!crt_gdata.cg_rpc_pool)
+		return;
+
+	rc = d_slab_init(&opc_info->coi_slab, opc_info);
+	if (rc != 0) {
+		D_WARN("opc: %#x, failed to init RPC pool, " DF_RC "\n",
+		       opc_info->coi_opc, DP_RC(rc));
+		return;
+	}
+
+	/* Fall back to D_ALLOC if the type can't be registered */
+	opc_info->coi_slab_type = d_slab_register(&opc_info->coi_slab, &reg);
+	if (opc_info->coi_slab_type == NULL) {
+		D_WARN("opc: %#x, failed to register RPC pool.\n",
+		       opc_info->coi_opc);
+		d_slab_destroy(&opc_info->coi_slab);
+		opc_info->coi_slab.slab_init = false;
+	}
+}
+
+void
+crt_opc_slab_fini(struct crt_opc_info *opc_info)
+{
+	d_slab_destroy(&opc_info->coi_slab);
+	opc_info->coi_slab.slab_init = false;
+	opc_info->coi_slab_type = NULL;
+}
+
+/*
+ * Allocate the RPC descriptor along with its input/output buffers. The
+ * non-forward ones are taken from the per-opcode pool if it is enabled,
+ * which avoids malloc/free for each RPC on the hot path.
+ */
+struct crt_rpc_priv *
+crt_rpc_priv_mem_alloc(struct crt_opc_info *opc_info, bool forward)
+{
+	struct crt_rpc_priv	*rpc_priv;
+
+	if (forward) {
+		D_ALLOC(rpc_priv, opc_info->coi_input_offset);
+		return rpc_priv;
+	}
+
+	if (opc_info->coi_slab_type != NULL) {
+		rpc_priv = d_slab_acquire(opc_info->coi_slab_type);
+		if (rpc_priv != NULL) {
+			D_ASSERT(rpc_priv->crp_opc_info == opc_info);
+			rpc_priv->crp_pooled = 1;
+			return rpc_priv;
+		}
+	}
+
+	D_ALLOC(rpc_priv, opc_info->coi_rpc_size);
+	return rpc_priv;
+}
+
+void
+crt_rpc_priv_mem_free(struct crt_rpc_priv *rpc_priv)
+{
+	if (rpc_priv->crp_pooled)
+		d_slab_release(rpc_priv->crp_opc_info->coi_slab_type,
+			       rpc_priv);
+	else
+		D_FREE(rpc_priv);
 }
 
 static inline void
@@ -1381,6 +1485,8 @@ crt_req_send(crt_rpc_t *req, crt_cb_t complete_cb, void *arg)
 	}
 
 	RPC_TRACE(DB_TRACE, rpc_priv, "submitted.\n");
+	if (unlikely(rpc_priv->crp_flags & CRT_RPC_FLAG_TRACE))
+		rpc_priv->crp_trace_ts = d_timeus_secdiff(0);
 
 	rc = crt_context_req_track(rpc_priv);
 	if (rc == CRT_REQ_TRACK_IN_INFLIGHQ) {
@@ -1561,6 +1667,11 @@ crt_common_hdr_init(struct crt_rpc_priv *rpc_priv, crt_opcode_t opc)
 
 	rpc_priv->crp_reply_hdr.cch_opc = opc;
 	rpc_priv->crp_reply_hdr.cch_rpcid = rpcid;
+
+	/* sample on the RPC id so that its origin picks the traced RPCs */
+	if (crt_gdata.cg_trace_sample != 0 &&
+	    rpcid % crt_gdata.cg_trace_sample == 0)
+		rpc_priv->crp_flags |= CRT_RPC_FLAG_TRACE;
 }
 
 int
@@ -1838,6 +1949,33 @@ out:
 	return rc;
 }
 
+int
+crt_req_trace_get(crt_rpc_t *rpc, uint64_t *trace_id, uint64_t *start_us)
+{
+	struct crt_rpc_priv	*rpc_priv = NULL;
+	int			rc = 0;
+
+	if (rpc == NULL) {
+		D_ERROR("NULL rpc passed\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	if (trace_id == NULL) {
+		D_ERROR("NULL trace_id passed\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	rpc_priv = container_of(rpc, struct crt_rpc_priv, crp_pub);
+	if (rpc_priv->crp_flags & CRT_RPC_FLAG_TRACE)
+		*trace_id = rpc_priv->crp_req_hdr.cch_rpcid;
+	else
+		*trace_id = 0;
+	if (start_us != NULL)
+		*start_us = rpc_priv->crp_trace_ts;
+out:
+	return rc;
+}
+
 int
 crt_register_hlc_error_cb(crt_hlc_error_cb event_handler, void *arg)
 {
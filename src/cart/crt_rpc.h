@@ -33,6 +33,8 @@ enum crt_rpc_flags_internal {
 	CRT_RPC_FLAG_COLL		= (1U << 16),
 	/* flag of targeting primary group */
 	CRT_RPC_FLAG_PRIMARY_GRP	= (1U << 17),
+	/* flag of sampled RPC, stages are traced under its RPC id */
+	CRT_RPC_FLAG_TRACE		= (1U << 18),
 };
 
 struct crt_corpc_hdr {
@@ -133,6 +135,8 @@ struct crt_rpc_priv {
 	uint32_t		crp_timeout_sec;
 	/* time stamp to be timeout, the key of timeout binheap */
 	uint64_t		crp_timeout_ts;
+	/* send (origin) or arrival (target) time in us of a traced RPC */
+	uint64_t		crp_trace_ts;
 	crt_cb_t		crp_complete_cb;
 	void			*crp_arg; /* argument for crp_complete_cb */
 	struct crt_ep_inflight	*crp_epi; /* point back to inflight ep */
@@ -176,13 +180,17 @@ struct crt_rpc_priv {
 				/* 1 if RPC fails HLC epsilon check */
 				crp_fail_hlc:1,
 				/* RPC completed flag */
-				crp_completed:1;
+				crp_completed:1,
+				/* RPC descriptor is from coi_slab_type */
+				crp_pooled:1;
 	uint32_t		crp_refcount;
 	struct crt_opc_info	*crp_opc_info;
 	/* corpc info, only valid when (crp_coll == 1) */
 	struct crt_corpc_info	*crp_corpc_info;
 	pthread_spinlock_t	crp_lock;
 	struct crt_common_hdr	crp_reply_hdr; /* common header for reply */
+	/* link to crt_opc_info::coi_slab_type when it is free */
+	d_list_t		crp_slab_link;
 	struct crt_common_hdr	crp_req_hdr; /* common header for request */
 	struct crt_corpc_hdr	crp_coreq_hdr; /* collective request header */
 };
@@ -626,6 +634,11 @@ crt_rpc_cb_customized(struct crt_context *crt_ctx,
 int crt_rpc_priv_alloc(crt_opcode_t opc, struct crt_rpc_priv **priv_allocated,
 		       bool forward);
 void crt_rpc_priv_free(struct crt_rpc_priv *rpc_priv);
+struct crt_rpc_priv *crt_rpc_priv_mem_alloc(struct crt_opc_info *opc_info,
+					    bool forward);
+void crt_rpc_priv_mem_free(struct crt_rpc_priv *rpc_priv);
+void crt_opc_slab_init(struct crt_opc_info *opc_info);
+void crt_opc_slab_fini(struct crt_opc_info *opc_info);
 int crt_rpc_priv_init(struct crt_rpc_priv *rpc_priv, crt_context_t crt_ctx,
 		      bool srv_flag);
 void crt_rpc_priv_fini(struct crt_rpc_priv *rpc_priv);
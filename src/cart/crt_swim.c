@@ -1076,33 +1076,88 @@ void crt_swim_suspend_all(void)
 	crt_swim_csm_unlock(csm);
 }
 
+/**
+ * Halve a SWIM timeout which was increased due to network glitches, but no
+ * less than \a min.
+ */
+static uint64_t
+crt_swim_timeout_relax(uint64_t val, uint64_t min)
+{
+	if (val <= min)
+		return val;
+
+	return max(val / 2, min);
+}
+
 /**
  * Calculate average of network delay and set it as expected PING timeout.
  * But limiting this timeout in range from specified by user or default to
  * suspicion timeout divided by 3. It will be automatically increased if
  * network glitches accrues and decreased when network communication is
  * normalized.
+ *
+ * The protocol period and the suspicion timeout, which are doubled on too
+ * many network glitches, are brought back towards their defaults here too.
+ * The number of times an update is piggybacked follows the SWIM dissemination
+ * bound of O(log(N)) protocol periods rather than a fixed count, so small and
+ * medium systems don't keep sending stale updates around.
  */
 void crt_swim_accommodate(void)
 {
 	struct crt_grp_priv	*grp_priv = crt_gdata.cg_grp->gg_primary_grp;
 	struct crt_swim_membs	*csm = &grp_priv->gp_membs_swim;
+	struct swim_context	*ctx;
 	struct crt_swim_target	*cst;
 	uint64_t		 average = 0;
 	uint64_t		 count = 0;
+	uint64_t		 members = 0;
+	uint64_t		 tx_max;
+	uint64_t		 val, min;
 
 	if (!crt_gdata.cg_swim_inited)
 		return;
 
 	crt_swim_csm_lock(csm);
+	ctx = csm->csm_ctx;
 	D_CIRCLEQ_FOREACH(cst, &csm->csm_head, cst_link) {
 		if (cst->cst_state.sms_delay > 0) {
 			average += cst->cst_state.sms_delay;
 			count++;
 		}
+		members++;
 	}
 	crt_swim_csm_unlock(csm);
 
+	tx_max = SWIM_PIGGYBACK_TX_FACTOR * (64 - __builtin_clzll(members | 1));
+	tx_max = min(max(tx_max, SWIM_PIGGYBACK_TX_MIN),
+		     SWIM_PIGGYBACK_TX_COUNT);
+	swim_ctx_lock(ctx);
+	if (ctx->sc_piggyback_tx_max != tx_max) {
+		D_DEBUG(DB_TRACE, "piggyback updates %lu times for %lu "
+			"members\n", tx_max, members);
+		ctx->sc_piggyback_tx_max = tx_max;
+	}
+	swim_ctx_unlock(ctx);
+
+	val = swim_period_get();
+	min = max(ctx->sc_default_period, ctx->sc_default_ping_timeout);
+	if (val > min) {
+		val = crt_swim_timeout_relax(val, min);
+		D_INFO("change SWIM period from %lu ms to %lu ms\n",
+		       swim_period_get(), val);
+		swim_period_set(val);
+	}
+
+	val = swim_suspect_timeout_get();
+	min = max(ctx->sc_default_suspect_timeout,
+		  3 * ctx->sc_default_ping_timeout);
+	if (val > min) {
+		val = crt_swim_timeout_relax(val, min);
+		D_INFO("change SWIM suspicion timeout from %lu ms to %lu ms\n",
+		       swim_suspect_timeout_get(), val);
+		swim_suspect_timeout_set(val);
+	}
+
 	if (count > 0) {
 		uint64_t ping_timeout = swim_ping_timeout_get();
 		uint64_t max_timeout = swim_suspect_timeout_get() / 3;
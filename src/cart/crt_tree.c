@@ -11,9 +11,67 @@
 
 #include "crt_internal.h"
 
+static int
+crt_rank_cmp(const void *a, const void *b)
+{
+	d_rank_t	ra = *(const d_rank_t *)a;
+	d_rank_t	rb = *(const d_rank_t *)b;
+
+	return (ra > rb) - (ra < rb);
+}
+
+/*
+ * Reorder the sorted \a rank_list per the group tree order, ranks not in the
+ * tree order keep their relative (sorted) order at the end of the list.
+ */
+static int
+crt_tree_domain_order(struct crt_grp_priv *grp_priv, d_rank_list_t *rank_list)
+{
+	d_rank_list_t	*order = grp_priv->gp_tree_order;
+	d_rank_t	*ranks;
+	d_rank_t	*found;
+	bool		*placed;
+	uint32_t	 nr = 0;
+	uint32_t	 i;
+	int		 rc = 0;
+
+	if (order == NULL || rank_list->rl_nr <= 1)
+		return 0;
+
+	D_ALLOC_ARRAY(ranks, rank_list->rl_nr);
+	if (ranks == NULL)
+		return -DER_NOMEM;
+	D_ALLOC_ARRAY(placed, rank_list->rl_nr);
+	if (placed == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (i = 0; i < order->rl_nr; i++) {
+		found = bsearch(&order->rl_ranks[i], rank_list->rl_ranks,
+				rank_list->rl_nr, sizeof(d_rank_t),
+				crt_rank_cmp);
+		if (found == NULL || placed[found - rank_list->rl_ranks])
+			continue;
+		placed[found - rank_list->rl_ranks] = true;
+		ranks[nr++] = *found;
+	}
+
+	for (i = 0; i < rank_list->rl_nr; i++) {
+		if (!placed[i])
+			ranks[nr++] = rank_list->rl_ranks[i];
+	}
+	D_ASSERT(nr == rank_list->rl_nr);
+	memcpy(rank_list->rl_ranks, ranks, nr * sizeof(d_rank_t));
+
+	D_FREE(placed);
+out:
+	D_FREE(ranks);
+	return rc;
+}
+
 static int
 crt_get_filtered_grp_rank_list(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 			       bool filter_invert, d_rank_list_t *filter_ranks,
+			       uint32_t tree_type,
 			       d_rank_t root, d_rank_t self, d_rank_t *grp_size,
 			       uint32_t *grp_root, d_rank_t *grp_self,
 			       d_rank_list_t **result_grp_rank_list,
@@ -55,6 +113,13 @@ crt_get_filtered_grp_rank_list(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 			D_GOTO(out, rc = 0);
 		}
 	}
+	if (tree_type == CRT_TREE_DOMAIN) {
+		rc = crt_tree_domain_order(grp_priv, grp_rank_list);
+		if (rc != 0) {
+			d_rank_list_free(grp_rank_list);
+			D_GOTO(out, rc);
+		}
+	}
 	*grp_size = grp_rank_list->rl_nr;
 
 	rc = d_idx_in_rank_list(grp_rank_list, root, grp_root);
@@ -131,7 +196,7 @@ crt_tree_get_nchildren(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 	 */
 	rc = crt_get_filtered_grp_rank_list(grp_priv, grp_ver,
 					    false /* filter_invert */,
-					    exclude_ranks, root, self,
+					    exclude_ranks, tree_type, root, self,
 					    &grp_size, &grp_root, &grp_self,
 					    &grp_rank_list, &allocated);
 	if (rc != 0) {
@@ -208,8 +273,8 @@ crt_tree_get_children(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 	 * for building the tree, rank number in it is for primary group.
 	 */
 	rc = crt_get_filtered_grp_rank_list(grp_priv, grp_ver, filter_invert,
-					    filter_ranks, root, self, &grp_size,
-					    &grp_root, &grp_self,
+					    filter_ranks, tree_type, root, self,
+					    &grp_size, &grp_root, &grp_self,
 					    &grp_rank_list, &allocated);
 	if (rc != 0) {
 		D_ERROR("crt_get_filtered_grp_rank_list(group %s, root %d, "
@@ -300,7 +365,7 @@ crt_tree_get_parent(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 	 */
 	rc = crt_get_filtered_grp_rank_list(grp_priv, grp_ver,
 					    false /* filter_invert */,
-					    exclude_ranks, root, self,
+					    exclude_ranks, tree_type, root, self,
 					    &grp_size, &grp_root, &grp_self,
 					    &grp_rank_list, &allocated);
 	if (rc != 0) {
@@ -337,4 +402,5 @@ struct crt_topo_ops *crt_tops[] = {
 	&crt_flat_ops,		/* CRT_TREE_FLAT */
 	&crt_kary_ops,		/* CRT_TREE_KARY */
 	&crt_knomial_ops,	/* CRT_TREE_KNOMIAL */
+	&crt_knomial_ops,	/* CRT_TREE_DOMAIN */
 };
@@ -747,6 +747,8 @@ swim_init(swim_id_t self_id, struct swim_ops *swim_ops, void *data)
 	swim_ping_timeout    = swim_ping_timeout_default();
 
 	ctx->sc_default_ping_timeout = swim_ping_timeout;
+	ctx->sc_default_period = swim_prot_period_len;
+	ctx->sc_default_suspect_timeout = swim_suspect_timeout;
 
 	/* delay the first ping until all things will be initialized */
 	ctx->sc_next_tick_time = swim_now_ms() + 3 * swim_prot_period_len;
@@ -57,6 +57,8 @@ extern "C" {
 					 * until it be removed from the list of
 					 * updates.
 					 */
+#define SWIM_PIGGYBACK_TX_MIN	8	/**< minimal count of transfers */
+#define SWIM_PIGGYBACK_TX_FACTOR 4	/**< transfers per log2 of members */
 
 enum swim_context_state {
 	SCS_BEGIN = 0,		/**< initial state when next target was already
@@ -99,6 +101,8 @@ struct swim_context {
 	swim_id_t		 sc_self;
 
 	uint64_t		 sc_default_ping_timeout;
+	uint64_t		 sc_default_period;
+	uint64_t		 sc_default_suspect_timeout;
 	uint64_t		 sc_expect_progress_time;
 	uint64_t		 sc_next_tick_time;
 	uint64_t		 sc_next_event;
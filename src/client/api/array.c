@@ -150,6 +150,12 @@ daos_array_get_attr(daos_handle_t oh, daos_size_t *chunk_size,
 	return dc_array_get_attr(oh, chunk_size, cell_size);
 }
 
+int
+daos_array_track_size(daos_handle_t oh)
+{
+	return dc_array_track_size(oh);
+}
+
 int
 daos_array_read(daos_handle_t oh, daos_handle_t th, daos_array_iod_t *iod,
 		d_sg_list_t *sgl, daos_event_t *ev)
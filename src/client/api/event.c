@@ -59,6 +59,120 @@ static unsigned int eq_ref;
  */
 static tse_sched_t daos_sched_g;
 
+/*
+ * Transport context and scheduler of the thread-private event, used instead of
+ * the global ones when DAOS_THREAD_CTX is set so that the blocking calls of
+ * different threads do not share, and progress, a single context.
+ */
+struct ev_thpriv_ctx {
+	/** link on ev_thpriv_ctx_list, empty once the context is destroyed */
+	d_list_t	tc_link;
+	crt_context_t	tc_ctx;
+	tse_sched_t	tc_sched;
+	/** context creation failed, stay on the global context */
+	bool		tc_failed;
+};
+
+static __thread struct ev_thpriv_ctx	*ev_thpriv_ctx;
+/** all thread-private contexts, protected by daos_eq_lock */
+static D_LIST_HEAD(ev_thpriv_ctx_list);
+static pthread_key_t			 ev_thpriv_ctx_key;
+static pthread_once_t			 ev_thpriv_ctx_once = PTHREAD_ONCE_INIT;
+static bool				 ev_thpriv_ctx_enabled;
+
+/** Destroy the context and scheduler, must be called with daos_eq_lock held */
+static void
+ev_thpriv_ctx_destroy(struct ev_thpriv_ctx *tc)
+{
+	int rc;
+
+	d_list_del_init(&tc->tc_link);
+	tse_sched_complete(&tc->tc_sched, 0, true);
+	rc = crt_context_destroy(tc->tc_ctx, 1 /* force */);
+	if (rc != 0)
+		D_ERROR("failed to destroy thread context: "DF_RC"\n", DP_RC(rc));
+	tc->tc_ctx = NULL;
+}
+
+/** Thread exit destructor */
+static void
+ev_thpriv_ctx_free(void *arg)
+{
+	struct ev_thpriv_ctx *tc = arg;
+
+	D_MUTEX_LOCK(&daos_eq_lock);
+	if (!d_list_empty(&tc->tc_link))
+		ev_thpriv_ctx_destroy(tc);
+	D_MUTEX_UNLOCK(&daos_eq_lock);
+	D_FREE(tc);
+}
+
+static void
+ev_thpriv_ctx_key_create(void)
+{
+	int rc;
+
+	rc = pthread_key_create(&ev_thpriv_ctx_key, ev_thpriv_ctx_free);
+	if (rc != 0) {
+		D_WARN("failed to create thread context key: %d\n", rc);
+		ev_thpriv_ctx_enabled = false;
+	}
+}
+
+/**
+ * Move the thread-private event on the thread context, creating it on first
+ * use. Any failure, e.g. when the provider cannot create more contexts, leaves
+ * the event on the global context.
+ */
+static void
+ev_thpriv_ctx_attach(struct daos_event_private *evx)
+{
+	struct ev_thpriv_ctx	*tc = ev_thpriv_ctx;
+	int			 rc;
+
+	if (tc == NULL) {
+		D_ALLOC_PTR(tc);
+		if (tc == NULL)
+			return;
+		D_INIT_LIST_HEAD(&tc->tc_link);
+		rc = pthread_setspecific(ev_thpriv_ctx_key, tc);
+		if (rc != 0) {
+			D_FREE(tc);
+			return;
+		}
+		ev_thpriv_ctx = tc;
+	}
+
+	if (tc->tc_failed)
+		return;
+
+	if (tc->tc_ctx == NULL) {
+		rc = crt_context_create(&tc->tc_ctx);
+		if (rc != 0) {
+			D_DEBUG(DB_TRACE, "no thread context, using the global one: "DF_RC"\n",
+				DP_RC(rc));
+			tc->tc_ctx = NULL;
+			tc->tc_failed = true;
+			return;
+		}
+
+		rc = tse_sched_init(&tc->tc_sched, NULL, tc->tc_ctx);
+		if (rc != 0) {
+			crt_context_destroy(tc->tc_ctx, 1 /* force */);
+			tc->tc_ctx = NULL;
+			tc->tc_failed = true;
+			return;
+		}
+
+		D_MUTEX_LOCK(&daos_eq_lock);
+		d_list_add(&tc->tc_link, &ev_thpriv_ctx_list);
+		D_MUTEX_UNLOCK(&daos_eq_lock);
+	}
+
+	evx->evx_ctx = tc->tc_ctx;
+	evx->evx_sched = &tc->tc_sched;
+}
+
 int
 daos_eq_lib_init()
 {
@@ -89,6 +203,10 @@ daos_eq_lib_init()
 	if (rc != 0)
 		D_GOTO(crt, rc);
 
+	d_getenv_bool("DAOS_THREAD_CTX", &ev_thpriv_ctx_enabled);
+	if (ev_thpriv_ctx_enabled)
+		pthread_once(&ev_thpriv_ctx_once, ev_thpriv_ctx_key_create);
+
 	eq_ref = 1;
 
 unlock:
@@ -123,6 +241,10 @@ daos_eq_lib_fini()
 	}
 	ev_thpriv_is_init = false;
 
+	while (!d_list_empty(&ev_thpriv_ctx_list))
+		ev_thpriv_ctx_destroy(d_list_entry(ev_thpriv_ctx_list.next,
+						   struct ev_thpriv_ctx, tc_link));
+
 	tse_sched_complete(&daos_sched_g, 0, true);
 
 	rc = crt_finalize();
@@ -1211,7 +1333,13 @@ daos_event_abort(struct daos_event *ev)
 int
 daos_event_priv_reset(void)
 {
-	return daos_event_init(&ev_thpriv, DAOS_HDL_INVAL, NULL);
+	int rc;
+
+	rc = daos_event_init(&ev_thpriv, DAOS_HDL_INVAL, NULL);
+	if (rc == 0 && ev_thpriv_ctx_enabled)
+		ev_thpriv_ctx_attach(daos_ev2evx(&ev_thpriv));
+
+	return rc;
 }
 
 int
@@ -19,10 +19,13 @@
 #include <daos/task.h>
 #include <daos/array.h>
 #include <daos/kv.h>
+#include <daos/pipeline.h>
 #include <daos/btree.h>
 #include <daos/btree_class.h>
 #include <daos/placement.h>
 #include <daos/job.h>
+#include <gurt/telemetry_common.h>
+#include <gurt/telemetry_producer.h>
 #include "task_internal.h"
 #include <pthread.h>
 
@@ -32,6 +35,9 @@ static pthread_mutex_t	module_lock = PTHREAD_MUTEX_INITIALIZER;
 /** refcount on how many times daos_init has been called */
 static int		module_initialized;
 
+/** the client set up its own telemetry segment, see dc_tm_init() */
+static bool		module_tm_owned;
+
 const struct daos_task_api dc_funcs[] = {
 	/** Management */
 	{dc_deprecated, 0},
@@ -122,8 +128,57 @@ const struct daos_task_api dc_funcs[] = {
 	{dc_kv_put, sizeof(daos_kv_put_t)},
 	{dc_kv_remove, sizeof(daos_kv_remove_t)},
 	{dc_kv_list, sizeof(daos_kv_list_t)},
+	{dc_kv_put_multi, sizeof(daos_kv_multi_t)},
+	{dc_kv_get_multi, sizeof(daos_kv_multi_t)},
+	{dc_kv_scan, sizeof(daos_kv_scan_t)},
+	{dc_pipeline_run, sizeof(daos_pipeline_run_t)},
 };
 
+/**
+ * Set up the client telemetry if DAOS_CLIENT_METRICS is set. The metrics live
+ * in a shared memory segment keyed by the process ID, it can be read with
+ * "daos_metrics -S <pid>" while the process runs. In the engine, which loads
+ * the client stack with its own telemetry already set up, the client metrics
+ * go to the engine segment instead.
+ */
+static int
+dc_tm_init(void)
+{
+	struct d_tm_node_t	*started = NULL;
+	bool			 enabled = false;
+	int			 rc;
+
+	d_getenv_bool("DAOS_CLIENT_METRICS", &enabled);
+	if (!enabled)
+		return 0;
+
+	rc = d_tm_add_metric(&started, D_TM_TIMESTAMP, "client start time", "",
+			     "client/started");
+	if (rc == -DER_UNINIT) {
+		rc = d_tm_init(getpid(), D_TM_SHARED_MEMORY_SIZE, D_TM_SERIALIZATION);
+		if (rc != 0)
+			return rc;
+		module_tm_owned = true;
+
+		rc = d_tm_add_metric(&started, D_TM_TIMESTAMP, "client start time",
+				     "", "client/started");
+	}
+	if (rc != 0)
+		D_WARN("Failed to create client start time sensor: "DF_RC"\n", DP_RC(rc));
+
+	d_tm_record_timestamp(started);
+	return 0;
+}
+
+static void
+dc_tm_fini(void)
+{
+	if (module_tm_owned) {
+		d_tm_fini();
+		module_tm_owned = false;
+	}
+}
+
 /**
  * Initialize DAOS client library.
  */
@@ -163,10 +218,15 @@ daos_init(void)
 		}
 	}
 
+	/** set up client telemetry, before the modules register their metrics */
+	rc = dc_tm_init();
+	if (rc != 0)
+		D_GOTO(out_debug, rc);
+
 	/** set up handle hash-table */
 	rc = daos_hhash_init();
 	if (rc != 0)
-		D_GOTO(out_debug, rc);
+		D_GOTO(out_tm, rc);
 
 	/** set up agent */
 	rc = dc_agent_init();
@@ -237,6 +297,8 @@ out_agent:
 	dc_agent_fini();
 out_hhash:
 	daos_hhash_fini();
+out_tm:
+	dc_tm_fini();
 out_debug:
 	daos_debug_fini();
 unlock:
@@ -290,6 +352,7 @@ daos_fini(void)
 
 	pl_fini();
 	daos_hhash_fini();
+	dc_tm_fini();
 	daos_debug_fini();
 	module_initialized = 0;
 unlock:
@@ -161,3 +161,65 @@ daos_kv_list(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 
 	return dc_task_schedule(task, true);
 }
+
+static int
+kv_multi(tse_task_func_t func, daos_handle_t oh, daos_handle_t th,
+	 uint64_t flags, unsigned int nr, daos_kv_ent_t *ents,
+	 daos_event_t *ev)
+{
+	daos_kv_multi_t	*args;
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_task_create(func, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->flags	= flags;
+	args->nr	= nr;
+	args->ents	= ents;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags,
+		  unsigned int nr, daos_kv_ent_t *ents, daos_event_t *ev)
+{
+	return kv_multi(dc_kv_put_multi, oh, th, flags, nr, ents, ev);
+}
+
+int
+daos_kv_get_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags,
+		  unsigned int nr, daos_kv_ent_t *ents, daos_event_t *ev)
+{
+	return kv_multi(dc_kv_get_multi, oh, th, flags, nr, ents, ev);
+}
+
+int
+daos_kv_scan(daos_handle_t oh, daos_handle_t th, const daos_kv_filter_t *filter,
+	     uint32_t *nr, daos_key_desc_t *kds, d_sg_list_t *sgl,
+	     daos_anchor_t *anchor, daos_event_t *ev)
+{
+	daos_kv_scan_t	*args;
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_task_create(dc_kv_scan, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->filter	= filter;
+	args->nr	= nr;
+	args->kds	= kds;
+	args->sgl	= sgl;
+	args->anchor	= anchor;
+
+	return dc_task_schedule(task, true);
+}
@@ -6,6 +6,7 @@
 #define D_LOGFAC	DD_FAC(client)
 
 #include <daos/object.h>
+#include <daos/event.h>
 #include <daos/task.h>
 #include <daos/container.h>
 #include "client_internal.h"
@@ -328,6 +329,167 @@ daos_obj_anchor_set(daos_handle_t oh, uint32_t index, daos_anchor_t *anchor)
 	return 0;
 }
 
+/** Key descriptors and initial key buffer size listed per group and round */
+#define LIST_GRP_KDS_NR		64
+#define LIST_GRP_BUF_SIZE	(LIST_GRP_KDS_NR * 256)
+
+/** Per redundancy group state of daos_obj_list_dkey_all() */
+struct list_grp {
+	daos_event_t	lg_ev;
+	daos_anchor_t	lg_anchor;
+	daos_key_desc_t	lg_kds[LIST_GRP_KDS_NR];
+	char		*lg_buf;
+	daos_size_t	lg_buf_size;
+	d_sg_list_t	lg_sgl;
+	d_iov_t		lg_iov;
+	uint32_t	lg_nr;
+	bool		lg_launched;
+};
+
+/* Launch the next listing of \a lg as a child of \a pev. */
+static int
+list_grp_launch(daos_handle_t oh, daos_handle_t th, struct list_grp *lg,
+		daos_event_t *pev)
+{
+	int rc;
+
+	rc = daos_event_init(&lg->lg_ev, DAOS_HDL_INVAL, pev);
+	if (rc)
+		return rc;
+	lg->lg_launched = true;
+
+	lg->lg_nr = LIST_GRP_KDS_NR;
+	d_iov_set(&lg->lg_iov, lg->lg_buf, lg->lg_buf_size);
+	lg->lg_sgl.sg_nr = 1;
+	lg->lg_sgl.sg_nr_out = 0;
+	lg->lg_sgl.sg_iovs = &lg->lg_iov;
+
+	rc = daos_obj_list_dkey(oh, th, &lg->lg_nr, lg->lg_kds, &lg->lg_sgl,
+				&lg->lg_anchor, &lg->lg_ev);
+	if (rc) {
+		/** complete it here so that the parent barrier still fires */
+		if (daos_event_launch(&lg->lg_ev) == 0)
+			daos_event_complete(&lg->lg_ev, rc);
+	}
+	return 0;
+}
+
+/*
+ * Handle the result of one listing.  A key larger than the buffer only grows
+ * the buffer, the anchor has not moved so the next round retries it.
+ */
+static int
+list_grp_process(struct list_grp *lg, daos_obj_list_cb_t cb, void *arg)
+{
+	char		*ptr = lg->lg_buf;
+	uint32_t	i;
+	int		rc;
+
+	rc = lg->lg_ev.ev_error;
+	if (rc == -DER_KEY2BIG) {
+		daos_size_t	size;
+		char		*buf;
+
+		size = max(lg->lg_buf_size * 2, lg->lg_kds[0].kd_key_len);
+		D_REALLOC(buf, lg->lg_buf, lg->lg_buf_size, size);
+		if (buf == NULL)
+			return -DER_NOMEM;
+		lg->lg_buf = buf;
+		lg->lg_buf_size = size;
+		return 0;
+	}
+	if (rc)
+		return rc;
+
+	for (i = 0; i < lg->lg_nr; i++) {
+		rc = cb(&lg->lg_kds[i], ptr, arg);
+		if (rc)
+			return rc;
+		ptr += lg->lg_kds[i].kd_key_len;
+	}
+	return 0;
+}
+
+int
+daos_obj_list_dkey_all(daos_handle_t oh, daos_handle_t th,
+		       daos_obj_list_cb_t cb, void *arg)
+{
+	struct list_grp	*lgs;
+	daos_event_t	pev;
+	uint32_t	nr = 0;
+	uint32_t	active;
+	uint32_t	i;
+	bool		flag;
+	int		rc;
+	int		rc2;
+
+	if (cb == NULL)
+		return -DER_INVAL;
+
+	rc = daos_obj_anchor_split(oh, &nr, NULL);
+	if (rc)
+		return rc;
+
+	D_ALLOC_ARRAY(lgs, nr);
+	if (lgs == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < nr; i++) {
+		rc = daos_obj_anchor_set(oh, i, &lgs[i].lg_anchor);
+		if (rc)
+			D_GOTO(out, rc);
+
+		D_ALLOC(lgs[i].lg_buf, LIST_GRP_BUF_SIZE);
+		if (lgs[i].lg_buf == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		lgs[i].lg_buf_size = LIST_GRP_BUF_SIZE;
+	}
+
+	/** every round lists the next batch of all groups not at EOF yet */
+	do {
+		rc = daos_event_init(&pev, DAOS_HDL_INVAL, NULL);
+		if (rc)
+			D_GOTO(out, rc);
+
+		active = 0;
+		for (i = 0; i < nr; i++) {
+			lgs[i].lg_launched = false;
+			if (daos_anchor_is_eof(&lgs[i].lg_anchor))
+				continue;
+
+			rc = list_grp_launch(oh, th, &lgs[i], &pev);
+			if (rc)
+				break;
+			active++;
+		}
+
+		if (active > 0) {
+			rc2 = daos_event_parent_barrier(&pev);
+			if (rc2 == 0)
+				rc2 = daos_event_test(&pev, DAOS_EQ_WAIT, &flag);
+			if (rc == 0)
+				rc = rc2;
+		}
+
+		/** merge: the callback is issued serially, in group order */
+		for (i = 0; i < nr && rc == 0; i++) {
+			if (lgs[i].lg_launched)
+				rc = list_grp_process(&lgs[i], cb, arg);
+		}
+
+		rc2 = daos_event_fini(&pev);
+		if (rc2)
+			D_ERROR("Failed to finalize event: "DF_RC"\n",
+				DP_RC(rc2));
+	} while (rc == 0 && active > 0);
+
+out:
+	for (i = 0; i < nr; i++)
+		D_FREE(lgs[i].lg_buf);
+	D_FREE(lgs);
+	return rc;
+}
+
 int
 daos_oit_open(daos_handle_t coh, daos_epoch_t epoch,
 	      daos_handle_t *oh, daos_event_t *ev)
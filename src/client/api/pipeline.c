@@ -0,0 +1,43 @@
+/**
+ * (C) Copyright 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of daos
+ *
+ * src/client/api/pipeline.c
+ */
+#define D_LOGFAC	DD_FAC(client)
+
+#include <daos/common.h>
+#include <daos/event.h>
+#include <daos/pipeline.h>
+#include <daos_pipeline.h>
+
+int
+daos_pipeline_run(daos_handle_t oh, daos_handle_t th,
+		  const daos_pipeline_t *pipeline, daos_anchor_t *anchor,
+		  uint32_t *nr, daos_key_desc_t *kds, d_sg_list_t *sgl,
+		  daos_pipeline_stats_t *stats, daos_event_t *ev)
+{
+	daos_pipeline_run_t	*args;
+	tse_task_t		*task;
+	int			 rc;
+
+	rc = dc_task_create(dc_pipeline_run, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->pipeline	= pipeline;
+	args->anchor	= anchor;
+	args->nr	= nr;
+	args->kds	= kds;
+	args->sgl	= sgl;
+	args->stats	= stats;
+
+	return dc_task_schedule(task, true);
+}
@@ -40,6 +40,12 @@ struct dc_array {
 	unsigned int		mode;
 	/** Is this a byte array (set short fetch & memset holes to 0 */
 	bool			byte_array;
+	/** number of redundancy groups of the object, 0 until looked up */
+	uint32_t		grp_nr;
+	/** maintain the size record on writes and use it for get_size */
+	bool			track_size;
+	/** highest size record written or read through this handle, a hint */
+	daos_size_t		size_hwm;
 };
 
 struct md_params {
@@ -62,6 +68,9 @@ struct io_params {
 	daos_size_t		chunk_size;
 	daos_size_t		num_records;
 	daos_size_t		array_size;
+	/** allocated entries of iod.iod_recxs and sgl.sg_iovs */
+	daos_size_t		recx_cap;
+	daos_size_t		iov_cap;
 	tse_task_t		*task;
 	struct io_params	*next;
 	bool			user_sgl_used;
@@ -254,6 +263,8 @@ free_handle_cb(tse_task_t *task, void *data)
 }
 
 #define DC_ARRAY_GLOB_MAGIC	(0xdaca0387)
+/** set in the global handle mode when the array size is tracked */
+#define DC_ARRAY_GLOB_TRACK_SIZE	(1U << 31)
 
 /* Structure of global buffer for dc_array */
 struct dc_array_glob {
@@ -329,6 +340,8 @@ dc_array_l2g(daos_handle_t oh, d_iov_t *glob)
 	array_glob->cell_size	= array->cell_size;
 	array_glob->chunk_size	= array->chunk_size;
 	array_glob->mode	= array->mode;
+	if (array->track_size)
+		array_glob->mode |= DC_ARRAY_GLOB_TRACK_SIZE;
 	array_glob->oid.hi	= array->oid.hi;
 	array_glob->oid.lo	= array->oid.lo;
 	uuid_copy(array_glob->coh_uuid, coh_uuid);
@@ -395,7 +408,7 @@ dc_array_g2l(daos_handle_t coh, struct dc_array_glob *array_glob,
 	if (array == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
-	array_mode = (mode == 0) ? array_glob->mode : mode;
+	array_mode = (mode == 0) ? array_glob->mode & ~DC_ARRAY_GLOB_TRACK_SIZE : mode;
 	rc = daos_obj_open(coh, array_glob->oid, array_mode, &array->daos_oh,
 			   NULL);
 	if (rc) {
@@ -409,6 +422,7 @@ dc_array_g2l(daos_handle_t coh, struct dc_array_glob *array_glob,
 	array->oid.hi = array_glob->oid.hi;
 	array->oid.lo = array_glob->oid.lo;
 	array->mode = array_mode;
+	array->track_size = array_glob->mode & DC_ARRAY_GLOB_TRACK_SIZE;
 
 	if (daos_obj_id2type(array->oid) == DAOS_OT_ARRAY_BYTE)
 		array->byte_array = true;
@@ -961,6 +975,222 @@ dc_array_get_attr(daos_handle_t oh, daos_size_t *chunk_size,
 	return 0;
 }
 
+int
+dc_array_track_size(daos_handle_t oh)
+{
+	struct dc_array		*array;
+
+	array = array_hdl2ptr(oh);
+	if (array == NULL)
+		return -DER_NO_HDL;
+
+	array->track_size = true;
+	array_decref(array);
+
+	return 0;
+}
+
+/*
+ * An array tracking its size keeps, under SIZE_AKEY of the metadata dkey, a
+ * 1-byte record at the index of the last record of every write. Extents only
+ * grow, so concurrent writers need no coordination, and the array size is the
+ * end of the highest extent, queried from the single shard holding dkey 0
+ * instead of every shard of the array.
+ *
+ * To keep writers off that shard, each handle caches the highest size record
+ * it has written or read and only updates the record when a write ends past
+ * it. The mark is reset by set_size and refreshed by get_size on the handle, so
+ * a truncation through another handle is only seen here after a get_size.
+ */
+#define SIZE_AKEY	'1'
+
+struct size_params {
+	daos_key_t		dkey;
+	uint64_t		dkey_val;
+	daos_key_t		akey;
+	char			akey_val;
+	daos_iod_t		iod;
+	daos_recx_t		recx;
+	d_sg_list_t		sgl;
+	d_iov_t			sg_iov;
+	char			val;
+	/** when set, raise the size mark of the array on success */
+	struct dc_array		*array;
+};
+
+static int
+free_size_params_cb(tse_task_t *task, void *data)
+{
+	struct size_params *params = *((struct size_params **)data);
+
+	if (params->array) {
+		daos_size_t end = params->recx.rx_idx + 1;
+
+		if (task->dt_result == 0 && end > params->array->size_hwm)
+			params->array->size_hwm = end;
+		array_decref(params->array);
+	}
+	D_FREE(params);
+	return task->dt_result;
+}
+
+static struct size_params *
+size_params_alloc(daos_size_t size)
+{
+	struct size_params	*params;
+
+	D_ALLOC_PTR(params);
+	if (params == NULL)
+		return NULL;
+
+	params->dkey_val = 0;
+	d_iov_set(&params->dkey, &params->dkey_val, sizeof(uint64_t));
+	params->akey_val = SIZE_AKEY;
+	d_iov_set(&params->akey, &params->akey_val, 1);
+
+	params->recx.rx_idx	= size - 1;
+	params->recx.rx_nr	= 1;
+	params->iod.iod_name	= params->akey;
+	params->iod.iod_nr	= 1;
+	params->iod.iod_size	= 1;
+	params->iod.iod_recxs	= &params->recx;
+	params->iod.iod_type	= DAOS_IOD_ARRAY;
+
+	d_iov_set(&params->sg_iov, &params->val, 1);
+	params->sgl.sg_nr	= 1;
+	params->sgl.sg_nr_out	= 0;
+	params->sgl.sg_iovs	= &params->sg_iov;
+
+	return params;
+}
+
+/*
+ * Create the update task raising the size record of the array to \a size
+ * records, registered as a dependency of \a ptask but not scheduled.
+ */
+static int
+size_record_update(struct dc_array *array, daos_handle_t th, daos_size_t size,
+		   tse_task_t *ptask, tse_task_t **taskp)
+{
+	daos_obj_update_t	*update_args;
+	struct size_params	*params;
+	tse_task_t		*task;
+	int			rc;
+
+	D_ASSERT(size > 0);
+	params = size_params_alloc(size);
+	if (params == NULL)
+		return -DER_NOMEM;
+
+	rc = daos_task_create(DAOS_OPC_OBJ_UPDATE, tse_task2sched(ptask), 0, NULL, &task);
+	if (rc) {
+		D_FREE(params);
+		return rc;
+	}
+
+	update_args		= daos_task_get_args(task);
+	update_args->oh		= array->daos_oh;
+	update_args->th		= th;
+	update_args->dkey	= &params->dkey;
+	update_args->nr		= 1;
+	update_args->iods	= &params->iod;
+	update_args->sgls	= &params->sgl;
+
+	/** a mark raised by a transaction could outlive its abort */
+	if (daos_handle_is_inval(th)) {
+		daos_hhash_link_getref(&array->hlink);
+		params->array = array;
+	}
+
+	rc = tse_task_register_comp_cb(task, free_size_params_cb, &params, sizeof(params));
+	if (rc) {
+		if (params->array)
+			array_decref(params->array);
+		D_FREE(params);
+		D_GOTO(err, rc);
+	}
+
+	rc = tse_task_register_deps(ptask, 1, &task);
+	if (rc)
+		D_GOTO(err, rc);
+
+	*taskp = task;
+	return 0;
+err:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+/*
+ * Reset the size record of the array to \a size records: punch it, then write
+ * the new last record. Both are dependencies of \a ptask and get scheduled.
+ */
+static int
+size_record_reset(struct dc_array *array, daos_handle_t th, daos_size_t size,
+		  tse_task_t *ptask)
+{
+	daos_obj_punch_t	*punch_args;
+	struct size_params	*params;
+	tse_task_t		*punch_task;
+	tse_task_t		*update_task = NULL;
+	int			rc;
+
+	/** the update below raises the mark back to the new size */
+	array->size_hwm = 0;
+
+	params = size_params_alloc(1);
+	if (params == NULL)
+		return -DER_NOMEM;
+
+	rc = daos_task_create(DAOS_OPC_OBJ_PUNCH_AKEYS, tse_task2sched(ptask), 0, NULL,
+			      &punch_task);
+	if (rc) {
+		D_FREE(params);
+		return rc;
+	}
+
+	punch_args		= daos_task_get_args(punch_task);
+	punch_args->oh		= array->daos_oh;
+	punch_args->th		= th;
+	punch_args->dkey	= &params->dkey;
+	punch_args->akeys	= &params->akey;
+	punch_args->akey_nr	= 1;
+
+	rc = tse_task_register_comp_cb(punch_task, free_size_params_cb, &params,
+				       sizeof(params));
+	if (rc) {
+		D_FREE(params);
+		D_GOTO(err, rc);
+	}
+
+	rc = tse_task_register_deps(ptask, 1, &punch_task);
+	if (rc)
+		D_GOTO(err, rc);
+
+	if (size > 0) {
+		rc = size_record_update(array, th, size, ptask, &update_task);
+		if (rc)
+			D_GOTO(err, rc);
+
+		/** the new record must land after the punch */
+		rc = tse_task_register_deps(update_task, 1, &punch_task);
+		if (rc)
+			D_GOTO(err, rc);
+	}
+
+	rc = tse_task_schedule(punch_task, false);
+	if (rc)
+		D_GOTO(err, rc);
+	if (update_task)
+		tse_task_schedule(update_task, false);
+	return 0;
+err:
+	if (update_task)
+		tse_task_complete(update_task, rc);
+	tse_task_complete(punch_task, rc);
+	return rc;
+}
+
 static bool
 io_extent_same(daos_array_iod_t *iod, d_sg_list_t *sgl, daos_size_t cell_size,
 	       daos_size_t *num_records)
@@ -1014,7 +1244,7 @@ compute_dkey(struct dc_array *array, daos_off_t array_idx,
 static int
 create_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size,
 	   daos_size_t num_records, daos_off_t *sgl_off, daos_size_t *sgl_i,
-	   d_sg_list_t *sgl)
+	   d_sg_list_t *sgl, daos_size_t *iov_cap)
 {
 	daos_size_t	k;
 	daos_size_t	rem_records;
@@ -1023,8 +1253,8 @@ create_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size,
 
 	cur_i = *sgl_i;
 	cur_off = *sgl_off;
+	/** sg_iovs of recycled io params is reused, up to iov_cap entries */
 	sgl->sg_nr = k = 0;
-	sgl->sg_iovs = NULL;
 	rem_records = num_records;
 
 	/*
@@ -1036,12 +1266,15 @@ create_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size,
 
 		D_ASSERT(user_sgl->sg_nr > cur_i);
 
-		D_REALLOC_ARRAY(new_sg_iovs, sgl->sg_iovs, sgl->sg_nr,
-				sgl->sg_nr + 1);
-		if (new_sg_iovs == NULL)
-			return -DER_NOMEM;
+		if (sgl->sg_nr == *iov_cap) {
+			D_REALLOC_ARRAY(new_sg_iovs, sgl->sg_iovs, *iov_cap,
+					*iov_cap + 1);
+			if (new_sg_iovs == NULL)
+				return -DER_NOMEM;
+			sgl->sg_iovs = new_sg_iovs;
+			(*iov_cap)++;
+		}
 		sgl->sg_nr++;
-		sgl->sg_iovs = new_sg_iovs;
 
 		sgl->sg_iovs[k].iov_buf = user_sgl->sg_iovs[cur_i].iov_buf +
 			cur_off;
@@ -1071,8 +1304,61 @@ create_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size,
 	return 0;
 }
 
+/** Streamed array I/Os keep this many dkey I/Os in flight per group */
+#define IO_STREAM_PER_GRP	8
+
+/**
+ * State of one array I/O, walking the ranges of the array iod and the user sgl
+ * to generate the dkey I/Os. Large reads and writes are streamed: only a window
+ * of dkey I/Os is in flight, and each completion issues the next one, reusing
+ * the params of the completed dkey I/O when possible.
+ */
+struct io_stream {
+	struct dc_array		*array;
+	daos_handle_t		th;
+	daos_array_iod_t	*rg_iod;
+	d_sg_list_t		*user_sgl;
+	daos_opc_t		op_type;
+	/** array task */
+	tse_task_t		*task;
+	/** get_size task of byte array reads, dkey I/Os complete before it */
+	tse_task_t		*stask;
+	/** offset into user buf to track current pos */
+	daos_off_t		cur_off;
+	/** index into user sgl to track current pos */
+	daos_size_t		cur_i;
+	/** index in the array range rg_iod->arr_nr */
+	daos_size_t		u;
+	/** Number of records to access in cur range */
+	daos_size_t		records;
+	/** object array index of current range */
+	daos_off_t		array_idx;
+	/** io params of the issued dkey I/Os, in decreasing dkey order */
+	struct io_params	*head;
+	/** io params of completed dkey I/Os that can be reused */
+	struct io_params	*pool;
+	/** max number of dkey I/Os in flight, 0 if not streaming */
+	uint32_t		window;
+	/** first error hit by a streamed dkey I/O, stops issuing new ones */
+	int			error;
+	pthread_mutex_t		lock;
+};
+
+static void
+io_stream_free(struct io_stream *ios)
+{
+	free_io_params(ios->head);
+	free_io_params(ios->pool);
+	if (ios->window)
+		D_MUTEX_DESTROY(&ios->lock);
+	array_decref(ios->array);
+	D_FREE(ios);
+}
+
 struct hole_params {
 	struct io_params	*io_list;
+	/** io stream whose dkey I/O list is processed, set once they completed */
+	struct io_stream	*ios;
 	tse_task_t		*ptask;
 	daos_size_t		records_req;
 	daos_size_t		array_size;
@@ -1284,6 +1570,7 @@ check_short_read_cb(tse_task_t *task, void *data)
 	}
 
 	D_ASSERT(params);
+	params->io_list = params->ios->head;
 	io_list = params->io_list;
 	total_recs = params->records_req;
 	args = daos_task_get_args(params->ptask);
@@ -1388,27 +1675,425 @@ out:
 	return rc;
 }
 
+/** Number of dkey I/Os a streamed array I/O keeps in flight */
+static uint32_t
+io_stream_window(struct dc_array *array)
+{
+	struct daos_obj_layout	*layout;
+	int			rc;
+
+	if (array->grp_nr == 0) {
+		rc = dc_obj_layout_get(array->daos_oh, &layout);
+		if (rc) {
+			D_DEBUG(DB_IO, "Failed to get layout "DF_RC"\n",
+				DP_RC(rc));
+			return IO_STREAM_PER_GRP;
+		}
+		array->grp_nr = layout->ol_nr;
+		daos_obj_layout_free(layout);
+	}
+
+	return IO_STREAM_PER_GRP * max(array->grp_nr, 1U);
+}
+
+/** Get io params for the next dkey I/O, recycled from the pool if possible */
+static struct io_params *
+io_params_get(struct io_stream *ios)
+{
+	struct io_params *params = ios->pool;
+
+	if (params == NULL) {
+		D_ALLOC_PTR(params);
+		return params;
+	}
+
+	ios->pool = params->next;
+	params->next = NULL;
+	params->iod.iod_nr = 0;
+	params->sgl.sg_nr = 0;
+	return params;
+}
+
+/*
+ * since we probably have multiple dkey ios, put them in linked list to free
+ * later. Insert in decreasing order for easier short fetch detection.
+ */
+static void
+io_params_insert(struct io_stream *ios, struct io_params *params)
+{
+	struct io_params *prev, *current;
+
+	current = ios->head;
+	prev = NULL;
+	while (current) {
+		if (current->dkey_val <= params->dkey_val)
+			break;
+		prev = current;
+		current = current->next;
+	}
+
+	params->next = current;
+	if (prev)
+		prev->next = params;
+	else
+		ios->head = params;
+}
+
+/** Move the io params of a completed dkey I/O from the list to the pool */
+static void
+io_params_recycle(struct io_stream *ios, struct io_params *params)
+{
+	struct io_params **prev = &ios->head;
+
+	while (*prev != params) {
+		D_ASSERT(*prev != NULL);
+		prev = &(*prev)->next;
+	}
+	*prev = params->next;
+
+	params->next = ios->pool;
+	ios->pool = params;
+}
+
+struct io_stream_cb_args {
+	struct io_stream	*ios;
+	struct io_params	*params;
+};
+
+static int
+io_stream_comp_cb(tse_task_t *io_task, void *data);
+
+/*
+ * Create the fetch or update task of the next dkey, combining consecutive
+ * ranges that belong to the same dkey. If the user gives ranges that are not
+ * increasing in offset, they probably won't be combined unless the separating
+ * ranges also belong to the same dkey. Returns a NULL task once all ranges are
+ * consumed.
+ */
+static int
+io_stream_next(struct io_stream *ios, tse_task_t **taskp)
+{
+	struct dc_array		*array = ios->array;
+	daos_array_iod_t	*rg_iod = ios->rg_iod;
+	d_sg_list_t		*user_sgl = ios->user_sgl;
+	daos_opc_t		op_type = ios->op_type;
+	daos_iod_t		*iod;
+	daos_iom_t		*iom;
+	d_sg_list_t		*sgl;
+	daos_key_t		*dkey;
+	uint64_t		dkey_val;
+	daos_size_t		num_records;
+	daos_off_t		record_i;
+	daos_size_t		dkey_records;
+	tse_task_t		*io_task = NULL;
+	tse_task_t		*ptask;
+	struct io_params	*params;
+	daos_size_t		i; /* index for iod recx */
+	int			rc;
+
+	*taskp = NULL;
+
+	/** In some cases, users can pass an empty range, so skip it. */
+	while (ios->u < rg_iod->arr_nr && rg_iod->arr_rgs[ios->u].rg_len == 0) {
+		ios->u++;
+		if (ios->u < rg_iod->arr_nr) {
+			ios->records = rg_iod->arr_rgs[ios->u].rg_len;
+			ios->array_idx = rg_iod->arr_rgs[ios->u].rg_idx;
+		}
+	}
+	if (ios->u >= rg_iod->arr_nr)
+		return 0;
+
+	rc = compute_dkey(array, ios->array_idx, &num_records, &record_i,
+			  &dkey_val);
+	if (rc != 0) {
+		D_ERROR("Failed to compute dkey\n");
+		return rc;
+	}
+
+	D_DEBUG(DB_IO, "DKEY IOD "DF_U64": idx = "DF_U64"\t num_records = %zu"
+		"\t record_i = "DF_U64"\n", dkey_val, ios->array_idx,
+		num_records, record_i);
+
+	/** allocate params for this dkey io */
+	params = io_params_get(ios);
+	if (params == NULL)
+		return -DER_NOMEM;
+	params->dkey_val = dkey_val;
+	io_params_insert(ios, params);
+
+	/** Object IO params for the fetch/update */
+	iod	= &params->iod;
+	iom	= &params->iom;
+	sgl	= &params->sgl;
+	dkey	= &params->dkey;
+
+	params->akey_val	= '0';
+	params->user_sgl_used	= false;
+	params->cell_size	= array->cell_size;
+	params->chunk_size	= array->chunk_size;
+
+	/** Set integer dkey descriptor */
+	d_iov_set(dkey, &params->dkey_val, sizeof(uint64_t));
+	/** Set character akey descriptor - TODO: should be NULL*/
+	d_iov_set(&iod->iod_name, &params->akey_val, 1);
+	/** Initialize the rest of the IOD fields */
+	iod->iod_nr	= 0;
+	iod->iod_type	= DAOS_IOD_ARRAY;
+	if (op_type == DAOS_OPC_ARRAY_PUNCH)
+		iod->iod_size = 0;
+	else
+		iod->iod_size = array->cell_size;
+
+	/* Initialize the IOM - used for fetch */
+	iom->iom_type	= DAOS_IOD_ARRAY;
+	iom->iom_nr	= 0;
+
+	i = 0;
+	dkey_records = 0;
+
+	/*
+	 * Create the IO descriptor for this dkey. If the entire range fits in
+	 * the dkey, continue to the next range to see if we can combine it
+	 * fully or partially in the current dkey IOD.
+	 */
+	do {
+		daos_off_t	old_array_idx;
+		daos_recx_t	*new_recxs;
+
+		/** add another element to recxs */
+		if (iod->iod_nr == params->recx_cap) {
+			D_REALLOC_ARRAY(new_recxs, iod->iod_recxs,
+					params->recx_cap, params->recx_cap + 1);
+			if (new_recxs == NULL)
+				return -DER_NOMEM;
+			iod->iod_recxs = new_recxs;
+			params->recx_cap++;
+		}
+		iod->iod_nr++;
+
+		/** set the record access for this range */
+		iod->iod_recxs[i].rx_idx = record_i;
+		iod->iod_recxs[i].rx_nr = (num_records > ios->records) ?
+			ios->records : num_records;
+
+		D_DEBUG(DB_IO, "%zu: index = "DF_U64", size = %zu\n",
+			ios->u, iod->iod_recxs[i].rx_idx,
+			iod->iod_recxs[i].rx_nr);
+
+		/*
+		 * if the current range is bigger than what the dkey can hold,
+		 * update the array index and number of records in the current
+		 * range and break to issue the I/O on the current dkey.
+		 */
+		if (ios->records > num_records) {
+			ios->array_idx += num_records;
+			ios->records -= num_records;
+			dkey_records += num_records;
+			break;
+		}
+
+		/** bump the index for the iods */
+		ios->u++;
+		i++;
+		dkey_records += ios->records;
+
+		/** if there are no more ranges to write, then break */
+		if (rg_iod->arr_nr <= ios->u)
+			break;
+
+		old_array_idx = ios->array_idx;
+		ios->records = rg_iod->arr_rgs[ios->u].rg_len;
+		ios->array_idx = rg_iod->arr_rgs[ios->u].rg_idx;
+
+		/*
+		 * Boundary case where number of records align with the end
+		 * boundary of the dkey. break after we have advanced to the
+		 * next range in the array iod.
+		 */
+		if (ios->records == num_records)
+			break;
+
+		/** process the next range in the cur dkey */
+		if (ios->array_idx < old_array_idx + num_records &&
+		    ios->array_idx >= ((old_array_idx + num_records) -
+				       array->chunk_size)) {
+			/*
+			 * verify that the dkey is the same as the one we are
+			 * working on given the array index, and also compute
+			 * the number of records left in the dkey and the record
+			 * indexin the dkey.
+			 */
+			rc = compute_dkey(array, ios->array_idx, &num_records,
+					  &record_i, &dkey_val);
+			if (rc != 0) {
+				D_ERROR("Failed to compute dkey\n");
+				return rc;
+			}
+
+			D_ASSERT(dkey_val == params->dkey_val);
+		} else {
+			break;
+		}
+	} while (1);
+
+	D_DEBUG(DB_IO, "DKEY IOD "DF_U64" ---------------\n", dkey_val);
+
+	/*
+	 * if the user sgl maps directly to the array range, no need to
+	 * partition it.
+	 */
+	if ((op_type == DAOS_OPC_ARRAY_PUNCH) ||
+	    (1 == rg_iod->arr_nr && 1 == user_sgl->sg_nr &&
+	     dkey_records == rg_iod->arr_rgs[0].rg_len)) {
+		sgl = user_sgl;
+		params->user_sgl_used = true;
+	}
+	/** create an sgl from the user sgl for the current IOD */
+	else {
+		/* set sgl for current dkey */
+		rc = create_sgl(user_sgl, array->cell_size, dkey_records,
+				&ios->cur_off, &ios->cur_i, sgl,
+				&params->iov_cap);
+		if (rc != 0) {
+			D_ERROR("Failed to create sgl "DF_RC"\n", DP_RC(rc));
+			return rc;
+		}
+	}
+
+	params->num_records = dkey_records;
+
+	/** byte array reads complete the dkey I/Os before the get_size task */
+	ptask = ios->stask ? ios->stask : ios->task;
+
+	/* Create the Fetch or Update task */
+	if (op_type == DAOS_OPC_ARRAY_READ) {
+		daos_obj_fetch_t *io_arg;
+
+		rc = daos_task_create(DAOS_OPC_OBJ_FETCH,
+				      tse_task2sched(ios->task), 0, NULL,
+				      &io_task);
+		if (rc != 0) {
+			D_ERROR("Fetch dkey "DF_U64" failed "DF_RC"\n",
+				params->dkey_val, DP_RC(rc));
+			return rc;
+		}
+		io_arg = daos_task_get_args(io_task);
+		io_arg->oh	= array->daos_oh;
+		io_arg->th	= ios->th;
+		io_arg->dkey	= dkey;
+		io_arg->nr	= 1;
+		io_arg->iods	= iod;
+		io_arg->sgls	= sgl;
+
+		/** if this is a byte array, add ioms for hole mgmt */
+		if (array->byte_array) {
+			iom->iom_nr = 0;
+			iom->iom_recxs = NULL;
+			iom->iom_flags = DAOS_IOMF_DETAIL;
+			io_arg->ioms = iom;
+		} else {
+			io_arg->ioms = NULL;
+		}
+	} else if (op_type == DAOS_OPC_ARRAY_WRITE ||
+		   op_type == DAOS_OPC_ARRAY_PUNCH) {
+		daos_obj_update_t *io_arg;
+
+		rc = daos_task_create(DAOS_OPC_OBJ_UPDATE,
+				      tse_task2sched(ios->task), 0, NULL,
+				      &io_task);
+		if (rc != 0) {
+			D_ERROR("Update dkey "DF_U64" failed "DF_RC"\n",
+				params->dkey_val, DP_RC(rc));
+			return rc;
+		}
+		io_arg = daos_task_get_args(io_task);
+		io_arg->oh	= array->daos_oh;
+		io_arg->th	= ios->th;
+		io_arg->dkey	= dkey;
+		io_arg->nr	= 1;
+		io_arg->iods	= iod;
+		io_arg->sgls	= sgl;
+	} else {
+		D_ASSERTF(0, "Invalid array operation.\n");
+	}
+
+	rc = tse_task_register_deps(ptask, 1, &io_task);
+	if (rc) {
+		tse_task_complete(io_task, rc);
+		return rc;
+	}
+
+	if (ios->window) {
+		struct io_stream_cb_args cb_args = {ios, params};
+
+		rc = tse_task_register_comp_cb(io_task, io_stream_comp_cb,
+					       &cb_args, sizeof(cb_args));
+		if (rc) {
+			tse_task_complete(io_task, rc);
+			return rc;
+		}
+	}
+
+	params->task = io_task;
+	*taskp = io_task;
+	return 0;
+}
+
+/*
+ * Completion of a streamed dkey I/O: issue the next dkey I/O to keep the window
+ * full. It is registered as a dependency of the array (or get_size) task before
+ * this dkey I/O is accounted as done, so that task can't complete in between.
+ * The io params are reused unless a byte array read still needs them for short
+ * read and hole handling. A failure to issue the next dkey I/O fails this one.
+ */
+static int
+io_stream_comp_cb(tse_task_t *io_task, void *data)
+{
+	struct io_stream_cb_args	*args = data;
+	struct io_stream		*ios = args->ios;
+	tse_task_t			*next = NULL;
+	int				rc = io_task->dt_result;
+
+	D_MUTEX_LOCK(&ios->lock);
+	if (ios->stask == NULL)
+		io_params_recycle(ios, args->params);
+	if (rc == 0 && ios->error == 0) {
+		rc = io_stream_next(ios, &next);
+		if (rc)
+			D_ERROR("Failed to issue array dkey I/O "DF_RC"\n",
+				DP_RC(rc));
+	}
+	if (rc && ios->error == 0)
+		ios->error = rc;
+	D_MUTEX_UNLOCK(&ios->lock);
+
+	if (next)
+		tse_task_schedule(next, false);
+	return rc;
+}
+
+static int
+free_io_stream_cb(tse_task_t *task, void *data)
+{
+	io_stream_free(*((struct io_stream **)data));
+	return task->dt_result;
+}
+
 static int
 dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	    daos_array_iod_t *rg_iod, d_sg_list_t *user_sgl,
 	    daos_opc_t op_type, tse_task_t *task)
 {
-	struct dc_array *array = NULL;
-	daos_handle_t	oh;
-	daos_off_t	cur_off; /* offset into user buf to track current pos */
-	daos_size_t	cur_i; /* index into user sgl to track current pos */
-	daos_size_t	records; /* Number of records to access in cur range */
-	daos_off_t	array_idx; /* object array index of current range */
-	daos_size_t	u; /* index in the array range rg_iod->arr_nr*/
-	daos_size_t	num_records;
-	daos_off_t	record_i;
-	struct io_params *head = NULL;
-	bool		head_cb_registered = false;
-	daos_size_t	num_ios;
-	d_list_t	io_task_list;
-	daos_size_t	tot_num_records = 0;
-	tse_task_t	*stask; /* task for short read and hole mgmt */
-	int		rc;
+	struct dc_array		*array = NULL;
+	struct io_stream	*ios = NULL;
+	bool			ios_cb_registered = false;
+	d_list_t		io_task_list;
+	daos_size_t		tot_num_records = 0;
+	uint32_t		window;
+	uint32_t		nr = 0;
+	tse_task_t		*stask = NULL; /* task for short read and hole mgmt */
+	int			rc;
 
 	if (rg_iod == NULL) {
 		D_ERROR("NULL iod passed\n");
@@ -1430,16 +2115,35 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 		D_GOTO(err_task, rc = -DER_INVAL);
 	}
 
-	oh = array->daos_oh;
+	D_ALLOC_PTR(ios);
+	if (ios == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
 
-	cur_off = 0;
-	cur_i = 0;
-	u = 0;
-	num_ios = 0;
-	records = rg_iod->arr_rgs[0].rg_len;
-	array_idx = rg_iod->arr_rgs[0].rg_idx;
+	/** the array ref is now held by the io stream */
+	ios->array	= array;
+	ios->th		= th;
+	ios->rg_iod	= rg_iod;
+	ios->user_sgl	= user_sgl;
+	ios->op_type	= op_type;
+	ios->task	= task;
+	ios->records	= rg_iod->arr_rgs[0].rg_len;
+	ios->array_idx	= rg_iod->arr_rgs[0].rg_idx;
+
+	/*
+	 * Stream reads and writes spanning more dkeys than the window instead
+	 * of creating all the dkey I/Os upfront.
+	 */
+	if (op_type != DAOS_OPC_ARRAY_PUNCH &&
+	    tot_num_records / array->chunk_size > IO_STREAM_PER_GRP) {
+		window = io_stream_window(array);
+		if (tot_num_records / array->chunk_size > window) {
+			rc = D_MUTEX_INIT(&ios->lock, NULL);
+			if (rc)
+				D_GOTO(err_ios, rc);
+			ios->window = window;
+		}
+	}
 
-	head = NULL;
 	D_INIT_LIST_HEAD(&io_task_list);
 
 	/*
@@ -1453,309 +2157,56 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 		rc = daos_task_create(DAOS_OPC_ARRAY_GET_SIZE, tse_task2sched(task), 0, NULL,
 				      &stask);
 		if (rc)
-			D_GOTO(err_task, rc);
+			D_GOTO(err_ios, rc);
+		ios->stask = stask;
 	}
 
-	/*
-	 * Loop over every range, but at the same time combine consecutive
-	 * ranges that belong to the same dkey. If the user gives ranges that
-	 * are not increasing in offset, they probably won't be combined unless
-	 * the separating ranges also belong to the same dkey.
-	 */
-	while (u < rg_iod->arr_nr) {
-		daos_iod_t	*iod;
-		daos_iom_t	*iom;
-		d_sg_list_t	*sgl;
-		daos_key_t	*dkey;
-		uint64_t	dkey_val;
-		daos_size_t	dkey_records;
-		tse_task_t	*io_task = NULL;
-		struct io_params *params;
-		daos_size_t	i; /* index for iod recx */
-
-		/** In some cases, users can pass an empty range, so skip it. */
-		if (rg_iod->arr_rgs[u].rg_len == 0) {
-			u++;
-			if (u < rg_iod->arr_nr) {
-				records = rg_iod->arr_rgs[u].rg_len;
-				array_idx = rg_iod->arr_rgs[u].rg_idx;
-			}
-			continue;
-		}
+	/** create all the dkey I/Os, or the first window of a streamed one */
+	do {
+		tse_task_t *io_task;
 
-		rc = compute_dkey(array, array_idx, &num_records, &record_i,
-				  &dkey_val);
-		if (rc != 0) {
-			D_ERROR("Failed to compute dkey\n");
+		rc = io_stream_next(ios, &io_task);
+		if (rc)
 			D_GOTO(err_iotask, rc);
-		}
-
-		D_DEBUG(DB_IO, "DKEY IOD "DF_U64": idx = "DF_U64"\t num_records = %zu"
-			"\t record_i = "DF_U64"\n", dkey_val, array_idx, num_records,
-			record_i);
-
-		/** allocate params for this dkey io */
-		D_ALLOC_PTR(params);
-		if (params == NULL)
-			D_GOTO(err_iotask, rc = -DER_NOMEM);
-		params->dkey_val = dkey_val;
-
-		/*
-		 * since we probably have multiple dkey ios, put them in linked
-		 * list to free later. Insert in decreasing order for easier
-		 * short fetch detection.
-		 */
-		if (num_ios == 0) {
-			head = params;
-		} else {
-			struct io_params *prev, *current;
-
-			current = head;
-			prev = NULL;
-			while (1) {
-				D_ASSERT(current);
-				if (current->dkey_val <= params->dkey_val) {
-					params->next = current;
-					if (prev)
-						prev->next = params;
-					else
-						head = params;
-					break;
-				}
-				if (current->next == NULL) {
-					current->next = params;
-					break;
-				}
-
-				prev = current;
-				current = current->next;
-			}
-		}
-
-		/** Object IO params for the fetch/update */
-		iod	= &params->iod;
-		iom	= &params->iom;
-		sgl	= &params->sgl;
-		dkey	= &params->dkey;
-
-		params->akey_val	= '0';
-		params->user_sgl_used	= false;
-		params->cell_size	= array->cell_size;
-		params->chunk_size	= array->chunk_size;
-		num_ios++;
-
-		/** Set integer dkey descriptor */
-		d_iov_set(dkey, &params->dkey_val, sizeof(uint64_t));
-		/** Set character akey descriptor - TODO: should be NULL*/
-		d_iov_set(&iod->iod_name, &params->akey_val, 1);
-		/** Initialize the rest of the IOD fields */
-		iod->iod_nr	= 0;
-		iod->iod_recxs	= NULL;
-		iod->iod_type	= DAOS_IOD_ARRAY;
-		if (op_type == DAOS_OPC_ARRAY_PUNCH)
-			iod->iod_size = 0;
-		else
-			iod->iod_size = array->cell_size;
-
-		/* Initialize the IOM - used for fetch */
-		iom->iom_type	= DAOS_IOD_ARRAY;
-		iom->iom_nr	= 0;
-
-		i = 0;
-		dkey_records = 0;
-
-		/*
-		 * Create the IO descriptor for this dkey. If the entire range
-		 * fits in the dkey, continue to the next range to see if we can
-		 * combine it fully or partially in the current dkey IOD.
-		 */
-		do {
-			daos_off_t	old_array_idx;
-			daos_recx_t	*new_recxs;
-
-			/** add another element to recxs */
-			D_REALLOC_ARRAY(new_recxs, iod->iod_recxs,
-					iod->iod_nr, iod->iod_nr + 1);
-			if (new_recxs == NULL)
-				D_GOTO(err_iotask, rc = -DER_NOMEM);
-
-			iod->iod_nr++;
-			iod->iod_recxs = new_recxs;
-
-			/** set the record access for this range */
-			iod->iod_recxs[i].rx_idx = record_i;
-			iod->iod_recxs[i].rx_nr = (num_records > records) ?
-				records : num_records;
-
-			D_DEBUG(DB_IO, "%zu: index = "DF_U64", size = %zu\n",
-				u, iod->iod_recxs[i].rx_idx,
-				iod->iod_recxs[i].rx_nr);
-
-			/*
-			 * if the current range is bigger than what the dkey can
-			 * hold, update the array index and number of records in
-			 * the current range and break to issue the I/O on the
-			 * current dkey.
-			 */
-			if (records > num_records) {
-				array_idx += num_records;
-				records -= num_records;
-				dkey_records += num_records;
-				break;
-			}
-
-			/** bump the index for the iods */
-			u++;
-			i++;
-			dkey_records += records;
-
-			/** if there are no more ranges to write, then break */
-			if (rg_iod->arr_nr <= u)
-				break;
+		if (io_task == NULL)
+			break;
+		tse_task_list_add(io_task, &io_task_list);
+		nr++;
+	} while (ios->window == 0 || nr < ios->window);
 
-			old_array_idx = array_idx;
-			records = rg_iod->arr_rgs[u].rg_len;
-			array_idx = rg_iod->arr_rgs[u].rg_idx;
+	rc = tse_task_register_comp_cb(task, free_io_stream_cb, &ios, sizeof(ios));
+	if (rc)
+		D_GOTO(err_iotask, rc);
+	ios_cb_registered = true;
 
-			/*
-			 * Boundary case where number of records align with the
-			 * end boundary of the dkey. break after we have
-			 * advanced to the next range in the array iod.
-			 */
-			if (records == num_records)
-				break;
-
-			/** process the next range in the cur dkey */
-			if (array_idx < old_array_idx + num_records &&
-			    array_idx >= ((old_array_idx + num_records) -
-					  array->chunk_size)) {
-				/*
-				 * verify that the dkey is the same as the one
-				 * we are working on given the array index, and
-				 * also compute the number of records left in
-				 * the dkey and the record indexin the dkey.
-				 */
-				rc = compute_dkey(array, array_idx,
-						  &num_records, &record_i,
-						  &dkey_val);
-				if (rc != 0) {
-					D_ERROR("Failed to compute dkey\n");
-					D_GOTO(err_iotask, rc);
-				}
-
-				D_ASSERT(dkey_val == params->dkey_val);
-			} else {
-				break;
-			}
-		} while (1);
+	/** raise the size record to the end of the highest range written */
+	if (op_type == DAOS_OPC_ARRAY_WRITE && array->track_size && tot_num_records) {
+		tse_task_t	*size_task;
+		daos_size_t	end = 0;
+		daos_size_t	u;
 
-		D_DEBUG(DB_IO, "DKEY IOD "DF_U64" ---------------\n", dkey_val);
+		for (u = 0; u < rg_iod->arr_nr; u++) {
+			daos_range_t *rg = &rg_iod->arr_rgs[u];
 
-		/*
-		 * if the user sgl maps directly to the array range, no need to
-		 * partition it.
-		 */
-		if ((op_type == DAOS_OPC_ARRAY_PUNCH) ||
-		    (1 == rg_iod->arr_nr && 1 == user_sgl->sg_nr &&
-		     dkey_records == rg_iod->arr_rgs[0].rg_len)) {
-			sgl = user_sgl;
-			params->user_sgl_used = true;
-		}
-		/** create an sgl from the user sgl for the current IOD */
-		else {
-			/* set sgl for current dkey */
-			rc = create_sgl(user_sgl, array->cell_size,
-					dkey_records, &cur_off, &cur_i, sgl);
-			if (rc != 0) {
-				D_ERROR("Failed to create sgl "DF_RC"\n",
-					DP_RC(rc));
-				D_GOTO(err_iotask, rc);
-			}
+			if (rg->rg_len && rg->rg_idx + rg->rg_len > end)
+				end = rg->rg_idx + rg->rg_len;
 		}
 
-		params->num_records = dkey_records;
-
-		/* Create the Fetch or Update task */
-		if (op_type == DAOS_OPC_ARRAY_READ) {
-			daos_obj_fetch_t *io_arg;
-
-			rc = daos_task_create(DAOS_OPC_OBJ_FETCH,
-					      tse_task2sched(task),
-					      0, NULL, &io_task);
-			if (rc != 0) {
-				D_ERROR("Fetch dkey "DF_U64" failed "DF_RC"\n",
-					params->dkey_val, DP_RC(rc));
-				D_GOTO(err_iotask, rc);
-			}
-			io_arg = daos_task_get_args(io_task);
-			io_arg->oh	= oh;
-			io_arg->th	= th;
-			io_arg->dkey	= dkey;
-			io_arg->nr	= 1;
-			io_arg->iods	= iod;
-			io_arg->sgls	= sgl;
-
-			/** if this is a byte array, add ioms for hole mgmt */
-			if (array->byte_array) {
-				iom->iom_nr = 0;
-				iom->iom_recxs = NULL;
-				iom->iom_flags = DAOS_IOMF_DETAIL;
-				io_arg->ioms = iom;
-				rc = tse_task_register_deps(stask, 1, &io_task);
-				if (rc) {
-					tse_task_complete(io_task, rc);
-					D_GOTO(err_iotask, rc);
-				}
-			} else {
-				io_arg->ioms = NULL;
-				rc = tse_task_register_deps(task, 1, &io_task);
-				if (rc) {
-					tse_task_complete(io_task, rc);
-					D_GOTO(err_iotask, rc);
-				}
-			}
-		} else if (op_type == DAOS_OPC_ARRAY_WRITE ||
-			   op_type == DAOS_OPC_ARRAY_PUNCH) {
-			daos_obj_update_t *io_arg;
-
-			rc = daos_task_create(DAOS_OPC_OBJ_UPDATE,
-					      tse_task2sched(task),
-					      0, NULL, &io_task);
-			if (rc != 0) {
-				D_ERROR("Update dkey "DF_U64" failed "DF_RC"\n",
-					params->dkey_val, DP_RC(rc));
-				D_GOTO(err_iotask, rc);
-			}
-			io_arg = daos_task_get_args(io_task);
-			io_arg->oh	= oh;
-			io_arg->th	= th;
-			io_arg->dkey	= dkey;
-			io_arg->nr	= 1;
-			io_arg->iods	= iod;
-			io_arg->sgls	= sgl;
-			rc = tse_task_register_deps(task, 1, &io_task);
-			if (rc) {
-				tse_task_complete(io_task, rc);
+		if (end > array->size_hwm || !daos_handle_is_inval(th)) {
+			rc = size_record_update(array, th, end, task, &size_task);
+			if (rc)
 				D_GOTO(err_iotask, rc);
-			}
-		} else {
-			D_ASSERTF(0, "Invalid array operation.\n");
+			tse_task_list_add(size_task, &io_task_list);
 		}
-		tse_task_list_add(io_task, &io_task_list);
-	} /* end while */
-
-	rc = tse_task_register_comp_cb(task, free_io_params_cb, &head, sizeof(head));
-	if (rc)
-		D_GOTO(err_iotask, rc);
-	head_cb_registered = true;
+	}
 
 	/*
 	 * If this is a byte array, schedule the get_size task with a prep
 	 * callback that decides if the get size is necessary for short read
 	 * handling. The prep callback also handles the hole management.
 	 */
-	if (op_type == DAOS_OPC_ARRAY_READ && array->byte_array) {
-		if (head == NULL) {
+	if (stask) {
+		if (ios->head == NULL) {
 			tse_task_complete(stask, 0);
 		} else {
 			struct hole_params	*sparams;
@@ -1764,10 +2215,10 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 			if (sparams == NULL)
 				D_GOTO(err_iotask, rc = -DER_NOMEM);
 
-			sparams->io_list	= head;
+			sparams->ios		= ios;
 			sparams->records_req    = tot_num_records;
 			sparams->ptask		= task;
-			sparams->oh		= oh;
+			sparams->oh		= array->daos_oh;
 
 			rc = tse_task_register_deps(task, 1, &stask);
 			if (rc != 0) {
@@ -1788,16 +2239,18 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	}
 
 	tse_task_list_sched(&io_task_list, false);
-	array_decref(array);
 	tse_sched_progress(tse_task2sched(task));
 	return 0;
 
 err_iotask:
-	if (head && !head_cb_registered)
-		free_io_params(head);
 	tse_task_list_abort(&io_task_list, rc);
-	if (op_type == DAOS_OPC_ARRAY_READ && array->byte_array)
+	if (stask)
 		tse_task_complete(stask, rc);
+err_ios:
+	if (!ios_cb_registered)
+		io_stream_free(ios);
+	tse_task_complete(task, rc);
+	return rc;
 err_task:
 	if (array)
 		array_decref(array);
@@ -1883,6 +2336,23 @@ get_array_size_cb(tse_task_t *task, void *data)
 	return rc;
 }
 
+static int
+get_tracked_size_cb(tse_task_t *task, void *data)
+{
+	struct key_query_props	*props = *((struct key_query_props **)data);
+	int			rc = task->dt_result;
+
+	if (rc != 0) {
+		D_ERROR("Array size record query Failed "DF_RC"\n", DP_RC(rc));
+		return rc;
+	}
+
+	/** no size record yet, the recx is left zeroed */
+	*props->size = props->recx.rx_idx + props->recx.rx_nr;
+	props->array->size_hwm = *props->size;
+	return rc;
+}
+
 int
 dc_array_get_size(tse_task_t *task)
 {
@@ -1906,7 +2376,7 @@ dc_array_get_size(tse_task_t *task)
 
 	*args->size = 0;
 
-	kqp->akey_val	= '0';
+	kqp->akey_val	= array->track_size ? SIZE_AKEY : '0';
 	d_iov_set(&kqp->akey, &kqp->akey_val, 1);
 	kqp->dkey_val	= 0;
 	d_iov_set(&kqp->dkey, &kqp->dkey_val, sizeof(uint64_t));
@@ -1926,8 +2396,12 @@ dc_array_get_size(tse_task_t *task)
 	query_args->dkey	= &kqp->dkey;
 	query_args->akey	= &kqp->akey;
 	query_args->recx	= &kqp->recx;
+	/** just the size record of dkey 0 instead of every shard */
+	if (array->track_size)
+		query_args->flags = DAOS_GET_RECX | DAOS_GET_MAX;
 
-	rc = tse_task_register_comp_cb(query_task, get_array_size_cb, &kqp,
+	rc = tse_task_register_comp_cb(query_task, array->track_size ?
+				       get_tracked_size_cb : get_array_size_cb, &kqp,
 				       sizeof(kqp));
 	if (rc != 0)
 		D_GOTO(err_query_task, rc);
@@ -2522,6 +2996,12 @@ dc_array_set_size(tse_task_t *task)
 	if (rc)
 		D_GOTO(err_enum_task, rc);
 
+	if (array->track_size) {
+		rc = size_record_reset(array, args->th, args->size, task);
+		if (rc)
+			D_GOTO(err_enum_task, rc);
+	}
+
 	rc = tse_task_register_deps(task, 1, &enum_task);
 	if (rc)
 		D_GOTO(err_enum_task, rc);
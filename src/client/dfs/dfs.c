@@ -19,6 +19,7 @@
 #include <daos/array.h>
 #include <daos/object.h>
 #include <daos/placement.h>
+#include <gurt/atomic.h>
 
 #include "daos.h"
 #include "daos_fs.h"
@@ -101,6 +102,8 @@ struct dfs_obj {
 	daos_obj_id_t		parent_oid;
 	/** entry name of the object in the parent */
 	char			name[DFS_MAX_NAME + 1];
+	/** access pattern hint, files only */
+	dfs_hint_t		hint;
 	union {
 		/** Symlink value if object is a symbolic link */
 		char	*value;
@@ -144,6 +147,14 @@ struct dfs {
 	/** Optional prefix to account for when resolving an absolute path */
 	char			*prefix;
 	daos_size_t		prefix_len;
+	/** Optional dentry cache, see dfs_set_dcache() */
+	struct d_hash_table	*dcache;
+	/** Seconds a cached name to object mapping stays valid */
+	unsigned int		dentry_timeout;
+	/** Seconds cached attributes stay valid for stat */
+	unsigned int		attr_timeout;
+	/** Sharding hint for directories created without an object class */
+	daos_oclass_hints_t	dir_hints;
 };
 
 struct dfs_entry {
@@ -273,6 +284,37 @@ check_tx(daos_handle_t th, int rc)
 
 #define MAX_OID_HI ((1UL << 32) - 1)
 
+/*
+ * Round the default chunk size up to a multiple of the full stripe of an EC
+ * file object, so that chunk aligned writes update full stripes and don't
+ * leave partial stripes for the server to aggregate. A chunk size set by the
+ * user is kept as is.
+ */
+static daos_size_t
+ec_stripe_chunk_size(dfs_t *dfs, daos_obj_id_t oid, daos_size_t chunk_size)
+{
+	struct daos_oclass_attr	*oca;
+	struct cont_props	props;
+	daos_size_t		stripe;
+
+	oca = daos_oclass_attr_find(oid, NULL);
+	if (oca == NULL || !daos_oclass_is_ec(oca))
+		return chunk_size;
+
+	props = dc_cont_hdl2props(dfs->coh);
+	stripe = (daos_size_t)oca->u.ec.e_k * props.dcp_ec_cell_sz;
+	if (stripe == 0 || chunk_size % stripe == 0)
+		return chunk_size;
+
+	if (chunk_size != DFS_DEFAULT_CHUNK_SIZE) {
+		D_DEBUG(DB_TRACE, "chunk size "DF_U64" is not a multiple of the EC stripe "
+			DF_U64"\n", chunk_size, stripe);
+		return chunk_size;
+	}
+
+	return roundup(chunk_size, stripe);
+}
+
 /*
  * OID generation for the dfs objects.
  *
@@ -286,6 +328,7 @@ static int
 oid_gen(dfs_t *dfs, daos_oclass_id_t oclass, bool file, daos_obj_id_t *oid)
 {
 	enum daos_otype_t type = DAOS_OT_MULTI_HASHED;
+	daos_oclass_hints_t hints = 0;
 	int rc;
 
 	D_MUTEX_LOCK(&dfs->lock);
@@ -309,9 +352,11 @@ oid_gen(dfs_t *dfs, daos_oclass_id_t oclass, bool file, daos_obj_id_t *oid)
 	/** if a regular file, use UINT64 typed dkeys for the array object */
 	if (file)
 		type = DAOS_OT_ARRAY_BYTE;
+	else if (oclass == 0)
+		hints = dfs->dir_hints;
 
 	/** generate the daos object ID (set the DAOS owned bits) */
-	rc = daos_obj_generate_oid(dfs->coh, oid, type, oclass, 0, 0);
+	rc = daos_obj_generate_oid(dfs->coh, oid, type, oclass, hints, 0);
 	if (rc) {
 		D_ERROR("daos_obj_generate_oid() failed "DF_RC"\n", DP_RC(rc));
 		return daos_der2errno(rc);
@@ -320,6 +365,41 @@ oid_gen(dfs_t *dfs, daos_oclass_id_t oclass, bool file, daos_obj_id_t *oid)
 	return 0;
 }
 
+/**
+ * Directories without an object class live in a single redundancy group by
+ * default, which caps the create/lookup rate of very large directories.
+ * DFS_DIR_SHARDING=tiny|reg|hi|ext|max spreads their entries (dkeys) over
+ * more groups, as the DAOS_OCH_SHD_* hints do.
+ */
+static daos_oclass_hints_t
+dir_hints_from_env(void)
+{
+	static const struct {
+		const char		*name;
+		daos_oclass_hints_t	hint;
+	} shd_hints[] = {
+		{ "tiny",	DAOS_OCH_SHD_TINY },
+		{ "reg",	DAOS_OCH_SHD_REG },
+		{ "hi",		DAOS_OCH_SHD_HI },
+		{ "ext",	DAOS_OCH_SHD_EXT },
+		{ "max",	DAOS_OCH_SHD_MAX },
+	};
+	char	*val;
+	int	i;
+
+	val = getenv("DFS_DIR_SHARDING");
+	if (val == NULL)
+		return 0;
+
+	for (i = 0; i < ARRAY_SIZE(shd_hints); i++) {
+		if (strcmp(val, shd_hints[i].name) == 0)
+			return shd_hints[i].hint;
+	}
+
+	D_WARN("Ignoring invalid DFS_DIR_SHARDING value '%s'\n", val);
+	return 0;
+}
+
 static char *
 concat(const char *s1, const char *s2)
 {
@@ -487,6 +567,259 @@ out:
 	return rc;
 }
 
+/** Size of the dentry cache hash table */
+#define DFS_DCACHE_HASH_BITS	12
+
+/** Dentry cache key: the parent directory oid followed by the entry name */
+#define DCACHE_KEY_MAX		(sizeof(daos_obj_id_t) + DFS_MAX_NAME)
+
+/**
+ * Cached directory entry.  Symlinks are never cached since their value would
+ * have to be kept around as well.
+ */
+struct dcache_rec {
+	d_list_t		dr_link;
+	ATOMIC uint		dr_ref;
+	/** time (coarse seconds) after which the name mapping is stale */
+	uint64_t		dr_expire;
+	/** time (coarse seconds) after which the cached attributes are stale */
+	uint64_t		dr_attr_expire;
+	struct dfs_entry	dr_entry;
+	unsigned int		dr_key_len;
+	char			dr_key[DCACHE_KEY_MAX];
+};
+
+static inline struct dcache_rec *
+dcache_rec_obj(d_list_t *rlink)
+{
+	return container_of(rlink, struct dcache_rec, dr_link);
+}
+
+static bool
+dcache_key_cmp(struct d_hash_table *htable, d_list_t *rlink, const void *key,
+	       unsigned int ksize)
+{
+	struct dcache_rec *rec = dcache_rec_obj(rlink);
+
+	if (rec->dr_key_len != ksize)
+		return false;
+
+	return memcmp(rec->dr_key, key, ksize) == 0;
+}
+
+static uint32_t
+dcache_rec_hash(struct d_hash_table *htable, d_list_t *rlink)
+{
+	struct dcache_rec *rec = dcache_rec_obj(rlink);
+
+	return d_hash_string_u32(rec->dr_key, rec->dr_key_len);
+}
+
+static void
+dcache_rec_addref(struct d_hash_table *htable, d_list_t *rlink)
+{
+	atomic_fetch_add_relaxed(&dcache_rec_obj(rlink)->dr_ref, 1);
+}
+
+static bool
+dcache_rec_decref(struct d_hash_table *htable, d_list_t *rlink)
+{
+	uint oldref;
+
+	oldref = atomic_fetch_sub_relaxed(&dcache_rec_obj(rlink)->dr_ref, 1);
+	D_ASSERT(oldref > 0);
+
+	return oldref == 1;
+}
+
+static void
+dcache_rec_free(struct d_hash_table *htable, d_list_t *rlink)
+{
+	struct dcache_rec *rec = dcache_rec_obj(rlink);
+
+	D_FREE(rec);
+}
+
+static d_hash_table_ops_t dcache_hash_ops = {
+	.hop_key_cmp	= dcache_key_cmp,
+	.hop_rec_hash	= dcache_rec_hash,
+	.hop_rec_addref	= dcache_rec_addref,
+	.hop_rec_decref	= dcache_rec_decref,
+	.hop_rec_free	= dcache_rec_free,
+};
+
+static unsigned int
+dcache_key(daos_obj_id_t parent_oid, const char *name, size_t len, char *key)
+{
+	memcpy(key, &parent_oid, sizeof(parent_oid));
+	memcpy(key + sizeof(parent_oid), name, len);
+
+	return sizeof(parent_oid) + len;
+}
+
+/**
+ * Look up \a name under \a parent_oid in the dentry cache.  If \a need_attr
+ * is set, a record whose attributes have timed out is treated as a miss.
+ * Records whose name mapping has timed out are evicted.
+ */
+static bool
+dcache_get(dfs_t *dfs, daos_obj_id_t parent_oid, const char *name, size_t len,
+	   bool need_attr, struct dfs_entry *entry)
+{
+	struct dcache_rec	*rec;
+	d_list_t		*rlink;
+	char			key[DCACHE_KEY_MAX];
+	unsigned int		ksize;
+	uint64_t		now;
+	bool			hit = false;
+
+	if (dfs->dcache == NULL)
+		return false;
+
+	ksize = dcache_key(parent_oid, name, len, key);
+	rlink = d_hash_rec_find(dfs->dcache, key, ksize);
+	if (rlink == NULL)
+		return false;
+
+	rec = dcache_rec_obj(rlink);
+	now = daos_gettime_coarse();
+	if (now >= rec->dr_expire) {
+		d_hash_rec_delete_at(dfs->dcache, rlink);
+	} else if (!need_attr || now < rec->dr_attr_expire) {
+		*entry = rec->dr_entry;
+		hit = true;
+	}
+
+	d_hash_rec_decref(dfs->dcache, rlink);
+	return hit;
+}
+
+/** Insert (or replace) the cached copy of \a entry. */
+static void
+dcache_add(dfs_t *dfs, daos_obj_id_t parent_oid, const char *name, size_t len,
+	   struct dfs_entry *entry)
+{
+	struct dcache_rec	*rec;
+	uint64_t		now;
+	int			rc;
+
+	if (dfs->dcache == NULL || S_ISLNK(entry->mode))
+		return;
+
+	D_ALLOC_PTR(rec);
+	if (rec == NULL)
+		return;
+
+	rec->dr_key_len = dcache_key(parent_oid, name, len, rec->dr_key);
+	rec->dr_entry = *entry;
+	rec->dr_entry.value = NULL;
+	now = daos_gettime_coarse();
+	rec->dr_expire = now + dfs->dentry_timeout;
+	rec->dr_attr_expire = now + dfs->attr_timeout;
+	atomic_store_relaxed(&rec->dr_ref, 0);
+
+	d_hash_rec_delete(dfs->dcache, rec->dr_key, rec->dr_key_len);
+	rc = d_hash_rec_insert(dfs->dcache, rec->dr_key, rec->dr_key_len,
+			       &rec->dr_link, true);
+	if (rc)
+		D_FREE(rec);
+}
+
+/** Drop any cached copy of \a name under \a parent_oid. */
+static void
+dcache_evict(dfs_t *dfs, daos_obj_id_t parent_oid, const char *name,
+	     size_t len)
+{
+	char		key[DCACHE_KEY_MAX];
+	unsigned int	ksize;
+
+	if (dfs->dcache == NULL)
+		return;
+
+	ksize = dcache_key(parent_oid, name, len, key);
+	d_hash_rec_delete(dfs->dcache, key, ksize);
+}
+
+/**
+ * fetch_entry() of a single entry going through the dentry cache.  Symlink
+ * values are always fetched.
+ */
+static int
+fetch_entry_cached(dfs_t *dfs, daos_obj_id_t parent_oid, daos_handle_t oh,
+		   const char *name, size_t len, bool need_attr, bool *exists,
+		   struct dfs_entry *entry)
+{
+	int rc;
+
+	if (dcache_get(dfs, parent_oid, name, len, need_attr, entry)) {
+		*exists = true;
+		return 0;
+	}
+
+	rc = fetch_entry(oh, DAOS_TX_NONE, name, len, true, exists, entry, 0,
+			 NULL, NULL, NULL);
+	if (rc == 0 && *exists)
+		dcache_add(dfs, parent_oid, name, len, entry);
+
+	return rc;
+}
+
+static void
+dcache_destroy(dfs_t *dfs)
+{
+	if (dfs->dcache == NULL)
+		return;
+
+	d_hash_table_destroy(dfs->dcache, true);
+	dfs->dcache = NULL;
+}
+
+static int
+dcache_set(dfs_t *dfs, unsigned int dentry_timeout, unsigned int attr_timeout)
+{
+	int rc;
+
+	if (dentry_timeout == 0) {
+		dcache_destroy(dfs);
+		dfs->dentry_timeout = 0;
+		dfs->attr_timeout = 0;
+		return 0;
+	}
+
+	if (dfs->dcache == NULL) {
+		rc = d_hash_table_create(D_HASH_FT_RWLOCK, DFS_DCACHE_HASH_BITS,
+					 NULL, &dcache_hash_ops, &dfs->dcache);
+		if (rc) {
+			D_ERROR("Failed to create dentry cache "DF_RC"\n",
+				DP_RC(rc));
+			return daos_der2errno(rc);
+		}
+	}
+
+	dfs->dentry_timeout = dentry_timeout;
+	dfs->attr_timeout = min(attr_timeout, dentry_timeout);
+	return 0;
+}
+
+/**
+ * Enable the dentry cache at mount time if DFS_DENTRY_TIMEOUT is set.
+ * DFS_ATTR_TIMEOUT defaults to the dentry timeout.  Failing to create the
+ * cache is not fatal.
+ */
+static void
+dcache_init_env(dfs_t *dfs)
+{
+	unsigned int	dentry_timeout = 0;
+	unsigned int	attr_timeout;
+
+	d_getenv_int("DFS_DENTRY_TIMEOUT", &dentry_timeout);
+	attr_timeout = dentry_timeout;
+	d_getenv_int("DFS_ATTR_TIMEOUT", &attr_timeout);
+
+	if (dentry_timeout)
+		dcache_set(dfs, dentry_timeout, attr_timeout);
+}
+
 static int
 remove_entry(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh,
 	     const char *name, size_t len, struct dfs_entry entry)
@@ -521,27 +854,26 @@ punch_entry:
 	return daos_der2errno(rc);
 }
 
-static int
-insert_entry(daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
-	     uint64_t flags, struct dfs_entry *entry)
+/*
+ * Set up the dkey, iod and sgl describing the inode entry of name.  The caller
+ * provides sg_iovs with room for INODE_AKEYS iovs.  Symlink values are only
+ * included if with_value is set.
+ */
+static void
+entry_io_set(const char *name, size_t len, struct dfs_entry *entry,
+	     bool with_value, daos_key_t *dkey, daos_iod_t *iod,
+	     daos_recx_t *recx, d_sg_list_t *sgl, d_iov_t *sg_iovs)
 {
-	d_sg_list_t	sgl;
-	d_iov_t		sg_iovs[INODE_AKEYS];
-	daos_iod_t	iod;
-	daos_recx_t	recx;
-	daos_key_t	dkey;
-	unsigned int	i;
-	int		rc;
+	unsigned int i = 0;
 
-	d_iov_set(&dkey, (void *)name, len);
-	d_iov_set(&iod.iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
-	iod.iod_nr	= 1;
-	recx.rx_idx	= 0;
-	recx.rx_nr	= SYML_IDX;
-	iod.iod_recxs	= &recx;
-	iod.iod_type	= DAOS_IOD_ARRAY;
-	iod.iod_size	= 1;
-	i = 0;
+	d_iov_set(dkey, (void *)name, len);
+	d_iov_set(&iod->iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
+	iod->iod_nr	= 1;
+	recx->rx_idx	= 0;
+	recx->rx_nr	= SYML_IDX;
+	iod->iod_recxs	= recx;
+	iod->iod_type	= DAOS_IOD_ARRAY;
+	iod->iod_size	= 1;
 
 	d_iov_set(&sg_iovs[i++], &entry->mode, sizeof(mode_t));
 	d_iov_set(&sg_iovs[i++], &entry->oid, sizeof(daos_obj_id_t));
@@ -551,15 +883,30 @@ insert_entry(daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
 	d_iov_set(&sg_iovs[i++], &entry->chunk_size, sizeof(daos_size_t));
 	d_iov_set(&sg_iovs[i++], &entry->oclass, sizeof(daos_oclass_id_t));
 
-	/** Add symlink value if Symlink */
-	if (S_ISLNK(entry->mode)) {
+	if (with_value && S_ISLNK(entry->mode)) {
 		d_iov_set(&sg_iovs[i++], entry->value, entry->value_len);
-		recx.rx_nr += entry->value_len;
+		recx->rx_nr += entry->value_len;
 	}
 
-	sgl.sg_nr	= i;
-	sgl.sg_nr_out	= 0;
-	sgl.sg_iovs	= sg_iovs;
+	sgl->sg_nr	= i;
+	sgl->sg_nr_out	= 0;
+	sgl->sg_iovs	= sg_iovs;
+}
+
+static int
+insert_entry(daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
+	     uint64_t flags, struct dfs_entry *entry)
+{
+	d_sg_list_t	sgl;
+	d_iov_t		sg_iovs[INODE_AKEYS];
+	daos_iod_t	iod;
+	daos_recx_t	recx;
+	daos_key_t	dkey;
+	int		rc;
+
+	/** Add symlink value if Symlink */
+	entry_io_set(name, len, entry, true, &dkey, &iod, &recx, &sgl,
+		     sg_iovs);
 
 	rc = daos_obj_update(oh, th, flags, &dkey, 1, &iod, &sgl, NULL);
 	if (rc) {
@@ -612,9 +959,39 @@ get_num_entries(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 	return 0;
 }
 
+/* Fill in a stat buffer from a fetched entry and the size of the object. */
+static void
+entry2stat(dfs_t *dfs, struct dfs_entry *entry, daos_size_t size,
+	   struct stat *stbuf)
+{
+	if (S_ISREG(entry->mode)) {
+		/*
+		 * TODO - this is not accurate since it does not account for
+		 * sparse files or file metadata or xattributes.
+		 */
+		stbuf->st_blocks = (size + (1 << 9) - 1) >> 9;
+		stbuf->st_blksize = entry->chunk_size ? entry->chunk_size :
+			dfs->attr.da_chunk_size;
+	}
+
+	stbuf->st_nlink = 1;
+	stbuf->st_size = size;
+	stbuf->st_mode = entry->mode;
+	stbuf->st_uid = dfs->uid;
+	stbuf->st_gid = dfs->gid;
+	stbuf->st_atim.tv_sec = entry->atime;
+	stbuf->st_mtim.tv_sec = entry->mtime;
+	stbuf->st_ctim.tv_sec = entry->ctime;
+}
+
+/**
+ * Stat entry \a name of the directory open as \a oh.  If \a parent_oid is
+ * given, the entry is looked up through the dentry cache.
+ */
 static int
-entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
-	   size_t len, struct dfs_obj *obj, struct stat *stbuf)
+entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh,
+	   const daos_obj_id_t *parent_oid, const char *name, size_t len,
+	   struct dfs_obj *obj, struct stat *stbuf)
 {
 	struct dfs_entry	entry = {0};
 	bool			exists;
@@ -624,8 +1001,12 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
 	memset(stbuf, 0, sizeof(struct stat));
 
 	/* Check if parent has the entry */
-	rc = fetch_entry(oh, th, name, len, true, &exists, &entry,
-			 0, NULL, NULL, NULL);
+	if (parent_oid)
+		rc = fetch_entry_cached(dfs, *parent_oid, oh, name, len, true,
+					&exists, &entry);
+	else
+		rc = fetch_entry(oh, th, name, len, true, &exists, &entry,
+				 0, NULL, NULL, NULL);
 	if (rc)
 		return rc;
 
@@ -666,13 +1047,6 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
 			if (rc)
 				return daos_der2errno(rc);
 		}
-		/*
-		 * TODO - this is not accurate since it does not account for
-		 * sparse files or file metadata or xattributes.
-		 */
-		stbuf->st_blocks = (size + (1 << 9) - 1) >> 9;
-		stbuf->st_blksize = entry.chunk_size ? entry.chunk_size :
-			dfs->attr.da_chunk_size;
 		break;
 	}
 	case S_IFLNK:
@@ -684,15 +1058,7 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name,
 		return EINVAL;
 	}
 
-	stbuf->st_nlink = 1;
-	stbuf->st_size = size;
-	stbuf->st_mode = entry.mode;
-	stbuf->st_uid = dfs->uid;
-	stbuf->st_gid = dfs->gid;
-	stbuf->st_atim.tv_sec = entry.atime;
-	stbuf->st_mtim.tv_sec = entry.mtime;
-	stbuf->st_ctim.tv_sec = entry.ctime;
-
+	entry2stat(dfs, &entry, size, stbuf);
 	return 0;
 }
 
@@ -757,17 +1123,45 @@ check_access(dfs_t *dfs, uid_t uid, gid_t gid, mode_t mode, int mask)
 	return 0;
 }
 
+/* Wait for a standalone event and return its errno status. */
+static int
+wait_event(daos_event_t *ev)
+{
+	bool	flag;
+	int	rc;
+	int	rc2;
+
+	rc = daos_event_test(ev, DAOS_EQ_WAIT, &flag);
+	if (rc == 0)
+		rc = ev->ev_error;
+	rc2 = daos_event_fini(ev);
+	if (rc2)
+		D_ERROR("Failed to finalize event: "DF_RC"\n", DP_RC(rc2));
+	return daos_der2errno(rc);
+}
+
+/*
+ * When \a sgl is set (O_CREAT | O_EXCL only), \a wr_size bytes of it are
+ * written at offset 0 of the new file while the entry is being inserted, so
+ * the create and the first write cost a single round trip.
+ */
 static int
 open_file(dfs_t *dfs, dfs_obj_t *parent, int flags, daos_oclass_id_t cid,
 	  daos_size_t chunk_size, struct dfs_entry *entry, daos_size_t *size,
-	  size_t len, dfs_obj_t *file)
+	  size_t len, d_sg_list_t *sgl, daos_size_t wr_size, dfs_obj_t *file)
 {
 	bool			exists;
 	int			daos_mode;
 	daos_handle_t		th = DAOS_TX_NONE;
 	bool			oexcl = flags & O_EXCL;
 	bool			ocreat = flags & O_CREAT;
+	daos_event_t		wr_ev;
+	daos_array_iod_t	wr_iod;
+	daos_range_t		wr_rg;
 	int			rc;
+	int			rc2;
+
+	D_ASSERT(sgl == NULL || (ocreat && oexcl));
 
 	/*
 	 * we only need a DTX in the case of O_CREAT without O_EXCL since we
@@ -809,12 +1203,8 @@ restart:
 		}
 
 		/** same logic for chunk size */
-		if (chunk_size == 0) {
-			if (parent->d.chunk_size == 0)
-				chunk_size = dfs->attr.da_chunk_size;
-			else
-				chunk_size = parent->d.chunk_size;
-		}
+		if (chunk_size == 0 && parent->d.chunk_size != 0)
+			chunk_size = parent->d.chunk_size;
 
 		/** Get new OID for the file */
 		rc = oid_gen(dfs, cid, true, &file->oid);
@@ -822,6 +1212,11 @@ restart:
 			D_GOTO(out, rc);
 		oid_cp(&entry->oid, file->oid);
 
+		/** the built-in default is stripe aligned for EC classes */
+		if (chunk_size == 0)
+			chunk_size = ec_stripe_chunk_size(dfs, file->oid,
+							  dfs->attr.da_chunk_size);
+
 		/** Open the array object for the file */
 		rc = daos_array_open_with_attr(dfs->coh, file->oid, th,
 					       DAOS_OO_RW, 1, chunk_size,
@@ -837,9 +1232,51 @@ restart:
 		entry->atime = entry->mtime = entry->ctime = time(NULL);
 		entry->chunk_size = chunk_size;
 
+		if (sgl) {
+			rc = daos_event_init(&wr_ev, DAOS_HDL_INVAL, NULL);
+			if (rc) {
+				daos_array_close(file->oh, NULL);
+				D_GOTO(out, rc = daos_der2errno(rc));
+			}
+
+			wr_rg.rg_idx	= 0;
+			wr_rg.rg_len	= wr_size;
+			wr_iod.arr_nr	= 1;
+			wr_iod.arr_rgs	= &wr_rg;
+
+			/** the object is not reachable until the entry exists */
+			rc = daos_array_write(file->oh, th, &wr_iod, sgl, &wr_ev);
+			if (rc) {
+				D_ERROR("daos_array_write() failed, "DF_RC"\n", DP_RC(rc));
+				daos_event_fini(&wr_ev);
+				daos_array_close(file->oh, NULL);
+				D_GOTO(out, rc = daos_der2errno(rc));
+			}
+		}
+
 		rc = insert_entry(parent->oh, th, file->name, len,
 				  (!dfs->use_dtx || oexcl) ?
 				  DAOS_COND_DKEY_INSERT : 0, entry);
+
+		if (sgl) {
+			rc2 = wait_event(&wr_ev);
+			if (rc2)
+				D_ERROR("First write to %s failed (%d)\n", file->name, rc2);
+			if (rc) {
+				/** drop the data of the orphan object */
+				rc2 = daos_array_destroy(file->oh, th, NULL);
+				if (rc2)
+					D_ERROR("Failed to punch orphan object "DF_RC"\n",
+						DP_RC(rc2));
+			} else if (rc2) {
+				/** the entry is there, leave an empty or partial file */
+				daos_array_close(file->oh, NULL);
+				D_GOTO(out, rc = rc2);
+			} else if (size) {
+				*size = wr_size;
+			}
+		}
+
 		if (rc == EEXIST && !oexcl) {
 			/** just try refetching entry to open the file */
 			daos_array_close(file->oh, NULL);
@@ -1631,6 +2068,8 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 	if ((dfs->attr.da_mode & MODE_MASK) == DFS_RELAXED)
 		d_getenv_bool("DFS_USE_DTX", &dfs->use_dtx);
 
+	dfs->dir_hints = dir_hints_from_env();
+
 	/** Check if super object has the root entry */
 	strcpy(dfs->root.name, "/");
 	rc = open_dir(dfs, NULL, amode | S_IFDIR, 0, &root_dir, 1, &dfs->root);
@@ -1658,6 +2097,7 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 			dfs->oid.hi = 0;
 	}
 
+	dcache_init_env(dfs);
 	dfs->mounted = true;
 	*_dfs = dfs;
 	daos_prop_free(prop);
@@ -1683,6 +2123,7 @@ dfs_umount(dfs_t *dfs)
 	daos_obj_close(dfs->root.oh, NULL);
 	daos_obj_close(dfs->super_oh, NULL);
 
+	dcache_destroy(dfs);
 	D_FREE(dfs->prefix);
 
 	D_MUTEX_DESTROY(&dfs->lock);
@@ -1904,6 +2345,8 @@ dfs_global2local(daos_handle_t poh, daos_handle_t coh, int flags, d_iov_t glob,
 		D_GOTO(err_dfs, rc = daos_der2errno(rc));
 	}
 
+	dfs->dir_hints = dir_hints_from_env();
+	dcache_init_env(dfs);
 	dfs->mounted = true;
 	*_dfs = dfs;
 
@@ -1940,6 +2383,16 @@ dfs_set_prefix(dfs_t *dfs, const char *prefix)
 	return 0;
 }
 
+int
+dfs_set_dcache(dfs_t *dfs, unsigned int dentry_timeout,
+	       unsigned int attr_timeout)
+{
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+
+	return dcache_set(dfs, dentry_timeout, attr_timeout);
+}
+
 int
 dfs_get_file_oh(dfs_obj_t *obj, daos_handle_t *oh)
 {
@@ -2031,28 +2484,61 @@ dfs_obj_get_info(dfs_t *dfs, dfs_obj_t *obj, dfs_obj_info_t *info)
 }
 
 int
-dfs_obj_set_oclass(dfs_t *dfs, dfs_obj_t *obj, int flags, daos_oclass_id_t cid)
+dfs_obj_set_hint(dfs_obj_t *obj, dfs_hint_t hint)
 {
-	daos_handle_t		oh;
-	d_sg_list_t		sgl;
-	d_iov_t			sg_iov;
-	daos_iod_t		iod;
-	daos_recx_t		recx;
-	daos_key_t		dkey;
-	int			rc;
-
 	if (obj == NULL)
 		return EINVAL;
-	if (!S_ISDIR(obj->mode))
+	if (!S_ISREG(obj->mode))
 		return ENOTSUP;
-	if (cid == 0)
-		cid = dfs->attr.da_oclass_id;
-	/** 0 is default, allow setting it */
-	if (cid != 0 && !daos_oclass_is_valid(cid))
+
+	switch (hint) {
+	case DFS_HINT_NORMAL:
+	case DFS_HINT_SEQUENTIAL:
+	case DFS_HINT_RANDOM:
+		break;
+	default:
 		return EINVAL;
+	}
 
-	/** Open parent object and fetch entry of obj from it */
-	rc = daos_obj_open(dfs->coh, obj->parent_oid, DAOS_OO_RO, &oh, NULL);
+	obj->hint = hint;
+	return 0;
+}
+
+int
+dfs_obj_get_hint(dfs_obj_t *obj, dfs_hint_t *hint)
+{
+	if (obj == NULL || hint == NULL)
+		return EINVAL;
+	if (!S_ISREG(obj->mode))
+		return ENOTSUP;
+
+	*hint = obj->hint;
+	return 0;
+}
+
+int
+dfs_obj_set_oclass(dfs_t *dfs, dfs_obj_t *obj, int flags, daos_oclass_id_t cid)
+{
+	daos_handle_t		oh;
+	d_sg_list_t		sgl;
+	d_iov_t			sg_iov;
+	daos_iod_t		iod;
+	daos_recx_t		recx;
+	daos_key_t		dkey;
+	int			rc;
+
+	if (obj == NULL)
+		return EINVAL;
+	if (!S_ISDIR(obj->mode))
+		return ENOTSUP;
+	if (cid == 0)
+		cid = dfs->attr.da_oclass_id;
+	/** 0 is default, allow setting it */
+	if (cid != 0 && !daos_oclass_is_valid(cid))
+		return EINVAL;
+
+	/** Open parent object and fetch entry of obj from it */
+	rc = daos_obj_open(dfs->coh, obj->parent_oid, DAOS_OO_RO, &oh, NULL);
 	if (rc)
 		return daos_der2errno(rc);
 
@@ -2085,6 +2571,7 @@ dfs_obj_set_oclass(dfs_t *dfs, dfs_obj_t *obj, int flags, daos_oclass_id_t cid)
 	if (daos_oid_cmp(obj->oid, dfs->root.oid) == 0)
 		dfs->root.d.oclass = cid;
 
+	dcache_evict(dfs, obj->parent_oid, obj->name, strlen(obj->name));
 out:
 	daos_obj_close(oh, NULL);
 	return rc;
@@ -2147,6 +2634,136 @@ out:
 	return rc;
 }
 
+/** number of files sampled and entries stat'ed at once by the oclass advice */
+#define ADVICE_SAMPLE_MAX	4096
+#define ADVICE_BATCH		64
+
+int
+dfs_obj_suggest_oclass(dfs_t *dfs, dfs_obj_t *obj, int flags,
+		       dfs_oclass_advice_t *advice)
+{
+	dfs_obj_info_t		info;
+	daos_pool_info_t	pinfo = {0};
+	daos_anchor_t		anchor = {0};
+	struct dirent		*dirs = NULL;
+	const char		**names = NULL;
+	struct stat		*stbufs = NULL;
+	int			*rcs = NULL;
+	daos_size_t		total = 0;
+	daos_oclass_id_t	cur;
+	uint64_t		grp_nr;
+	uint32_t		redun;
+	int			rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (obj == NULL || !S_ISDIR(obj->mode))
+		return ENOTDIR;
+	if (advice == NULL)
+		return EINVAL;
+
+	rc = dfs_obj_get_info(dfs, obj, &info);
+	if (rc)
+		return rc;
+
+	/** files fall back to the array default, not the directory one */
+	cur = obj->d.oclass ? obj->d.oclass : dfs->attr.da_oclass_id;
+	if (cur == 0)
+		cur = daos_obj_get_oclass(dfs->coh, DAOS_OF_DKEY_UINT64 |
+					  DAOS_OF_KV_FLAT | DAOS_OF_ARRAY_BYTE,
+					  0, 0);
+
+	advice->doa_nr_files	= 0;
+	advice->doa_avg_size	= 0;
+	advice->doa_max_size	= 0;
+	advice->doa_cur_oclass	= cur;
+	advice->doa_oclass	= cur;
+
+	D_ALLOC_ARRAY(dirs, ADVICE_BATCH);
+	D_ALLOC_ARRAY(names, ADVICE_BATCH);
+	D_ALLOC_ARRAY(stbufs, ADVICE_BATCH);
+	D_ALLOC_ARRAY(rcs, ADVICE_BATCH);
+	if (dirs == NULL || names == NULL || stbufs == NULL || rcs == NULL)
+		D_GOTO(out, rc = ENOMEM);
+
+	while (!daos_anchor_is_eof(&anchor) &&
+	       advice->doa_nr_files < ADVICE_SAMPLE_MAX) {
+		uint32_t nr = ADVICE_BATCH;
+		uint32_t i;
+
+		rc = dfs_readdir(dfs, obj, &anchor, &nr, dirs);
+		if (rc)
+			D_GOTO(out, rc);
+		if (nr == 0)
+			continue;
+
+		for (i = 0; i < nr; i++)
+			names[i] = dirs[i].d_name;
+
+		/** entries removed since the listing are just skipped */
+		rc = dfs_stat_many(dfs, obj, nr, names, stbufs, rcs);
+		if (rc && rc != ENOENT)
+			D_GOTO(out, rc);
+		rc = 0;
+
+		for (i = 0; i < nr; i++) {
+			if (rcs[i] != 0 || !S_ISREG(stbufs[i].st_mode))
+				continue;
+			advice->doa_nr_files++;
+			total += stbufs[i].st_size;
+			if (stbufs[i].st_size > advice->doa_max_size)
+				advice->doa_max_size = stbufs[i].st_size;
+		}
+	}
+
+	if (advice->doa_nr_files == 0 && advice->doa_sharers == 0)
+		D_GOTO(out, rc = 0);
+
+	if (advice->doa_nr_files != 0)
+		advice->doa_avg_size = total / advice->doa_nr_files;
+
+	rc = daos_pool_query(dfs->poh, NULL, &pinfo, NULL, NULL);
+	if (rc) {
+		D_ERROR("daos_pool_query() failed, "DF_RC"\n", DP_RC(rc));
+		D_GOTO(out, rc = daos_der2errno(rc));
+	}
+
+	/** one group per chunk of an average file or per client */
+	grp_nr = (advice->doa_avg_size + info.doi_chunk_size - 1) /
+		 info.doi_chunk_size;
+	grp_nr = max(grp_nr, advice->doa_sharers);
+	grp_nr = max(grp_nr, 1);
+	if (grp_nr >= pinfo.pi_ntargets || grp_nr >= MAX_NUM_GROUPS)
+		grp_nr = MAX_NUM_GROUPS;
+
+	/** keep the redundancy of the current class */
+	redun = cur >> OC_REDUN_SHIFT;
+	if (redun == 0)
+		redun = OR_RP_1;
+
+	if (daos_oclass_is_valid(OBJ_CLASS_DEF(redun, grp_nr)))
+		advice->doa_oclass = OBJ_CLASS_DEF(redun, grp_nr);
+
+	D_DEBUG(DB_TRACE, "%s: %"PRIu64" files, avg "DF_U64", max "DF_U64
+		", oclass %u -> %u\n", obj->name, advice->doa_nr_files,
+		advice->doa_avg_size, advice->doa_max_size, cur,
+		advice->doa_oclass);
+
+	if ((flags & DFS_OCLASS_APPLY) && advice->doa_oclass != cur) {
+		rc = dfs_obj_set_oclass(dfs, obj, 0, advice->doa_oclass);
+		/** files created through this handle get it too */
+		if (rc == 0)
+			obj->d.oclass = advice->doa_oclass;
+	}
+
+out:
+	D_FREE(dirs);
+	D_FREE(names);
+	D_FREE(stbufs);
+	D_FREE(rcs);
+	return rc;
+}
+
 int
 dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	  daos_oclass_id_t cid)
@@ -2188,6 +2805,7 @@ dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 		daos_obj_close(new_dir.oh, NULL);
 		return rc;
 	}
+	dcache_evict(dfs, parent->oid, name, len);
 
 	rc = daos_obj_close(new_dir.oh, NULL);
 	if (rc != 0)
@@ -2196,6 +2814,92 @@ dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	return rc;
 }
 
+/*
+ * Remove the \a nr entries of one enumeration batch of a directory without a
+ * transaction: the objects of all of them are punched concurrently, then their
+ * directory entries are, so a batch costs two round trips instead of two per
+ * entry.
+ */
+static int
+remove_entries(dfs_t *dfs, daos_handle_t parent_oh, char **names, size_t *lens,
+	       struct dfs_entry *entries, int nr)
+{
+	daos_event_t	evs[ENUM_DESC_NR];
+	daos_handle_t	ohs[ENUM_DESC_NR];
+	daos_key_t	dkeys[ENUM_DESC_NR];
+	bool		launched[ENUM_DESC_NR] = {0};
+	int		i;
+	int		rc = 0;
+	int		rc2;
+
+	D_ASSERT(nr <= ENUM_DESC_NR);
+
+	for (i = 0; i < nr; i++) {
+		ohs[i] = DAOS_HDL_INVAL;
+		if (rc || S_ISLNK(entries[i].mode))
+			continue;
+
+		rc2 = daos_obj_open(dfs->coh, entries[i].oid, DAOS_OO_RW, &ohs[i], NULL);
+		if (rc2 == 0)
+			rc2 = daos_event_init(&evs[i], DAOS_HDL_INVAL, NULL);
+		if (rc2) {
+			rc = daos_der2errno(rc2);
+			continue;
+		}
+
+		rc2 = daos_obj_punch(ohs[i], DAOS_TX_NONE, 0, &evs[i]);
+		if (rc2) {
+			daos_event_fini(&evs[i]);
+			rc = daos_der2errno(rc2);
+			continue;
+		}
+		launched[i] = true;
+	}
+
+	for (i = 0; i < nr; i++) {
+		if (launched[i]) {
+			rc2 = wait_event(&evs[i]);
+			if (rc == 0)
+				rc = rc2;
+			launched[i] = false;
+		}
+		if (daos_handle_is_valid(ohs[i]))
+			daos_obj_close(ohs[i], NULL);
+	}
+	if (rc)
+		return rc;
+
+	/** we only need a conditional dkey punch if we are not using a DTX */
+	for (i = 0; i < nr; i++) {
+		rc2 = daos_event_init(&evs[i], DAOS_HDL_INVAL, NULL);
+		if (rc2) {
+			rc = daos_der2errno(rc2);
+			break;
+		}
+
+		d_iov_set(&dkeys[i], names[i], lens[i]);
+		rc2 = daos_obj_punch_dkeys(parent_oh, DAOS_TX_NONE,
+					   dfs->use_dtx ? 0 : DAOS_COND_PUNCH,
+					   1, &dkeys[i], &evs[i]);
+		if (rc2) {
+			daos_event_fini(&evs[i]);
+			rc = daos_der2errno(rc2);
+			break;
+		}
+		launched[i] = true;
+	}
+
+	for (i = 0; i < nr; i++) {
+		if (!launched[i])
+			continue;
+		rc2 = wait_event(&evs[i]);
+		if (rc == 0)
+			rc = rc2;
+	}
+
+	return rc;
+}
+
 static int
 remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
 {
@@ -2205,6 +2909,10 @@ remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
 	d_iov_t		iov;
 	char		enum_buf[ENUM_DESC_BUF] = {0};
 	d_sg_list_t	sgl;
+	char		*names[ENUM_DESC_NR];
+	size_t		lens[ENUM_DESC_NR];
+	struct dfs_entry entries[ENUM_DESC_NR];
+	int		nr = 0;
 	int		rc;
 
 	D_ASSERT(S_ISDIR(entry.mode));
@@ -2252,11 +2960,25 @@ remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
 					D_GOTO(out, rc);
 			}
 
-			rc = remove_entry(dfs, th, oh, ptr, kds[i].kd_key_len,
-					  child_entry);
-			if (rc)
-				D_GOTO(out, rc);
+			/** a transaction serializes its operations anyway */
+			if (daos_handle_is_valid(th)) {
+				rc = remove_entry(dfs, th, oh, ptr, kds[i].kd_key_len,
+						  child_entry);
+				if (rc)
+					D_GOTO(out, rc);
+				continue;
+			}
+
+			names[nr] = ptr;
+			lens[nr] = kds[i].kd_key_len;
+			entries[nr] = child_entry;
+			nr++;
 		}
+
+		rc = remove_entries(dfs, oh, names, lens, entries, nr);
+		if (rc)
+			D_GOTO(out, rc);
+		nr = 0;
 	}
 
 out:
@@ -2356,6 +3078,7 @@ out:
 	rc = check_tx(th, rc);
 	if (rc == ERESTART)
 		goto restart;
+	dcache_evict(dfs, parent->oid, name, len);
 	return rc;
 }
 
@@ -2466,8 +3189,8 @@ lookup_rel_path_loop:
 		len = strlen(token);
 
 		entry.chunk_size = 0;
-		rc = fetch_entry(parent.oh, DAOS_TX_NONE, token, len, true,
-				 &exists, &entry, 0, NULL, NULL, NULL);
+		rc = fetch_entry_cached(dfs, parent.oid, parent.oh, token, len,
+					stbuf != NULL, &exists, &entry);
 		if (rc)
 			D_GOTO(err_obj, rc);
 
@@ -2857,8 +3580,12 @@ dfs_lookup_rel_int(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 	if (daos_mode == -1)
 		return EINVAL;
 
-	rc = fetch_entry(parent->oh, DAOS_TX_NONE, name, len, true, &exists,
-			 &entry, xnr, xnames, xvals, xsizes);
+	if (xnr == 0)
+		rc = fetch_entry_cached(dfs, parent->oid, parent->oh, name, len,
+					stbuf != NULL, &exists, &entry);
+	else
+		rc = fetch_entry(parent->oh, DAOS_TX_NONE, name, len, true,
+				 &exists, &entry, xnr, xnames, xvals, xsizes);
 	if (rc)
 		return rc;
 
@@ -2993,6 +3720,454 @@ dfs_lookupx(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 				  xnr, xnames, xvals, xsizes);
 }
 
+/*
+ * Batches of independent operations are issued as child events of a private
+ * parent event, then waited on together.  If an operation fails before its
+ * event was launched, complete the child here so the parent barrier can still
+ * fire.
+ */
+static void
+batch_launch_failed(daos_event_t *ev, int rc)
+{
+	if (daos_event_launch(ev) == 0)
+		daos_event_complete(ev, rc);
+}
+
+/* Wait for every child of pev, including ones that failed to launch. */
+static int
+batch_wait(daos_event_t *pev)
+{
+	bool	flag;
+	int	rc;
+
+	rc = daos_event_parent_barrier(pev);
+	if (rc == 0)
+		rc = daos_event_test(pev, DAOS_EQ_WAIT, &flag);
+	if (rc)
+		D_ERROR("Failed to wait on batch: "DF_RC"\n", DP_RC(rc));
+	return rc;
+}
+
+struct lookup_entry {
+	daos_event_t	le_ev;
+	daos_key_t	le_dkey;
+	daos_iod_t	le_iod;
+	daos_recx_t	le_recx;
+	d_sg_list_t	le_sgl;
+	d_iov_t		le_iovs[2];
+};
+
+int
+dfs_lookup_entries(dfs_t *dfs, dfs_obj_t *parent, uint32_t nr,
+		   const char *names[], mode_t *modes, daos_obj_id_t *oids)
+{
+	struct lookup_entry	*les;
+	daos_event_t		pev;
+	uint32_t		i;
+	int			rc, rc2;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+	if (nr == 0)
+		return 0;
+	if (names == NULL || modes == NULL || oids == NULL)
+		return EINVAL;
+
+	D_ALLOC_ARRAY(les, nr);
+	if (les == NULL)
+		return ENOMEM;
+
+	rc = daos_event_init(&pev, DAOS_HDL_INVAL, NULL);
+	if (rc) {
+		D_FREE(les);
+		return daos_der2errno(rc);
+	}
+
+	for (i = 0; i < nr; i++) {
+		struct lookup_entry *le = &les[i];
+
+		modes[i] = 0;
+
+		rc = daos_event_init(&le->le_ev, DAOS_HDL_INVAL, &pev);
+		if (rc)
+			break;
+
+		d_iov_set(&le->le_dkey, (void *)names[i], strlen(names[i]));
+		d_iov_set(&le->le_iod.iod_name, INODE_AKEY_NAME,
+			  sizeof(INODE_AKEY_NAME) - 1);
+		le->le_recx.rx_idx	= MODE_IDX;
+		le->le_recx.rx_nr	= ATIME_IDX;
+		le->le_iod.iod_nr	= 1;
+		le->le_iod.iod_recxs	= &le->le_recx;
+		le->le_iod.iod_type	= DAOS_IOD_ARRAY;
+		le->le_iod.iod_size	= 1;
+
+		d_iov_set(&le->le_iovs[0], &modes[i], sizeof(mode_t));
+		d_iov_set(&le->le_iovs[1], &oids[i], sizeof(daos_obj_id_t));
+		le->le_sgl.sg_nr	= 2;
+		le->le_sgl.sg_nr_out	= 0;
+		le->le_sgl.sg_iovs	= le->le_iovs;
+
+		rc2 = daos_obj_fetch(parent->oh, DAOS_TX_NONE, 0, &le->le_dkey,
+				     1, &le->le_iod, &le->le_sgl, NULL,
+				     &le->le_ev);
+		if (rc2)
+			batch_launch_failed(&le->le_ev, rc2);
+	}
+
+	/** wait for everything that was launched, even after a failure */
+	if (i > 0) {
+		rc2 = batch_wait(&pev);
+		if (rc == 0)
+			rc = rc2;
+	}
+
+	for (i = 0; rc == 0 && i < nr; i++) {
+		rc2 = les[i].le_ev.ev_error;
+		if (rc2 == -DER_NONEXIST) {
+			modes[i] = 0;
+		} else if (rc2) {
+			D_ERROR("Failed to fetch entry %s "DF_RC"\n", names[i],
+				DP_RC(rc2));
+			rc = rc2;
+		} else if (les[i].le_sgl.sg_nr_out == 0) {
+			modes[i] = 0;
+		}
+	}
+
+	rc2 = daos_event_fini(&pev);
+	if (rc2)
+		D_ERROR("Failed to finalize event: "DF_RC"\n", DP_RC(rc2));
+	D_FREE(les);
+	return daos_der2errno(rc);
+}
+
+struct batch_entry {
+	daos_event_t		be_ev;
+	bool			be_launched;
+	struct dfs_entry	be_entry;
+	daos_key_t		be_dkey;
+	daos_iod_t		be_iod;
+	daos_recx_t		be_recx;
+	d_sg_list_t		be_sgl;
+	d_iov_t			be_iovs[INODE_AKEYS];
+	daos_handle_t		be_oh;
+	daos_size_t		be_size;
+};
+
+int
+dfs_create_many(dfs_t *dfs, dfs_obj_t *parent, uint32_t nr, const char *names[],
+		mode_t mode, daos_oclass_id_t cid, daos_size_t chunk_size,
+		int rcs[])
+{
+	struct batch_entry	*bes;
+	daos_event_t		pev;
+	time_t			now;
+	size_t			len;
+	uint32_t		launched = 0;
+	uint32_t		i;
+	int			rc = 0;
+	int			rc2;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (dfs->amode != O_RDWR)
+		return EPERM;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+	if (nr == 0)
+		return 0;
+	if (names == NULL || rcs == NULL)
+		return EINVAL;
+
+	/** same oclass and chunk size inheritance as dfs_open() */
+	if (cid == 0)
+		cid = parent->d.oclass ? parent->d.oclass :
+			dfs->attr.da_oclass_id;
+	if (chunk_size == 0)
+		chunk_size = parent->d.chunk_size ? parent->d.chunk_size :
+			dfs->attr.da_chunk_size;
+
+	D_ALLOC_ARRAY(bes, nr);
+	if (bes == NULL)
+		return ENOMEM;
+
+	rc = daos_event_init(&pev, DAOS_HDL_INVAL, NULL);
+	if (rc) {
+		D_FREE(bes);
+		return daos_der2errno(rc);
+	}
+
+	now = time(NULL);
+	for (i = 0; i < nr; i++) {
+		struct batch_entry *be = &bes[i];
+
+		rcs[i] = check_name(names[i], &len);
+		if (rcs[i])
+			continue;
+
+		rcs[i] = oid_gen(dfs, cid, true, &be->be_entry.oid);
+		if (rcs[i])
+			continue;
+
+		be->be_entry.mode = S_IFREG | (mode & ~S_IFMT);
+		be->be_entry.atime = be->be_entry.mtime = now;
+		be->be_entry.ctime = now;
+		be->be_entry.chunk_size = chunk_size;
+
+		rc2 = daos_event_init(&be->be_ev, DAOS_HDL_INVAL, &pev);
+		if (rc2) {
+			rcs[i] = daos_der2errno(rc2);
+			continue;
+		}
+		be->be_launched = true;
+		launched++;
+
+		entry_io_set(names[i], len, &be->be_entry, false, &be->be_dkey,
+			     &be->be_iod, &be->be_recx, &be->be_sgl,
+			     be->be_iovs);
+
+		/** all inserts are conditional, so no DTX is needed */
+		rc2 = daos_obj_update(parent->oh, DAOS_TX_NONE,
+				      DAOS_COND_DKEY_INSERT, &be->be_dkey, 1,
+				      &be->be_iod, &be->be_sgl, &be->be_ev);
+		if (rc2)
+			batch_launch_failed(&be->be_ev, rc2);
+	}
+
+	if (launched > 0)
+		rc = daos_der2errno(batch_wait(&pev));
+
+	for (i = 0; i < nr; i++) {
+		if (bes[i].be_launched) {
+			rc2 = bes[i].be_ev.ev_error;
+			if (rc2 && rc2 != -DER_EXIST)
+				D_ERROR("Failed to insert entry '%s', "DF_RC"\n",
+					names[i], DP_RC(rc2));
+			rcs[i] = daos_der2errno(rc2);
+			if (rcs[i] == 0)
+				dcache_evict(dfs, parent->oid, names[i],
+					     strlen(names[i]));
+		}
+		if (rc == 0)
+			rc = rcs[i];
+	}
+
+	rc2 = daos_event_fini(&pev);
+	if (rc2)
+		D_ERROR("Failed to finalize event: "DF_RC"\n", DP_RC(rc2));
+	D_FREE(bes);
+	return rc;
+}
+
+int
+dfs_stat_many(dfs_t *dfs, dfs_obj_t *parent, uint32_t nr, const char *names[],
+	      struct stat stbufs[], int rcs[])
+{
+	struct batch_entry	*bes;
+	daos_event_t		pev;
+	size_t			len;
+	uint32_t		launched;
+	uint32_t		i;
+	int			rc = 0;
+	int			rc2;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+	if (nr == 0)
+		return 0;
+	if (names == NULL || stbufs == NULL || rcs == NULL)
+		return EINVAL;
+
+	D_ALLOC_ARRAY(bes, nr);
+	if (bes == NULL)
+		return ENOMEM;
+
+	/** Pass 1: fetch all the entries concurrently */
+	rc = daos_event_init(&pev, DAOS_HDL_INVAL, NULL);
+	if (rc)
+		D_GOTO(out, rc = daos_der2errno(rc));
+
+	launched = 0;
+	for (i = 0; i < nr; i++) {
+		struct batch_entry *be = &bes[i];
+
+		memset(&stbufs[i], 0, sizeof(struct stat));
+		rcs[i] = check_name(names[i], &len);
+		if (rcs[i])
+			continue;
+
+		rc2 = daos_event_init(&be->be_ev, DAOS_HDL_INVAL, &pev);
+		if (rc2) {
+			rcs[i] = daos_der2errno(rc2);
+			continue;
+		}
+		be->be_launched = true;
+		launched++;
+
+		entry_io_set(names[i], len, &be->be_entry, false, &be->be_dkey,
+			     &be->be_iod, &be->be_recx, &be->be_sgl,
+			     be->be_iovs);
+
+		rc2 = daos_obj_fetch(parent->oh, DAOS_TX_NONE, 0, &be->be_dkey,
+				     1, &be->be_iod, &be->be_sgl, NULL,
+				     &be->be_ev);
+		if (rc2)
+			batch_launch_failed(&be->be_ev, rc2);
+	}
+
+	if (launched > 0)
+		rc = daos_der2errno(batch_wait(&pev));
+	daos_event_fini(&pev);
+	if (rc)
+		D_GOTO(out, rc);
+
+	/** Pass 2: query the size of all the files concurrently */
+	rc = daos_event_init(&pev, DAOS_HDL_INVAL, NULL);
+	if (rc)
+		D_GOTO(out, rc = daos_der2errno(rc));
+
+	launched = 0;
+	for (i = 0; i < nr; i++) {
+		struct batch_entry	*be = &bes[i];
+		struct dfs_entry	*entry = &be->be_entry;
+
+		if (!be->be_launched)
+			continue;
+		be->be_launched = false;
+
+		rc2 = be->be_ev.ev_error;
+		if (rc2 == 0 && be->be_sgl.sg_nr_out == 0)
+			rc2 = -DER_NONEXIST;
+		if (rc2) {
+			rcs[i] = daos_der2errno(rc2);
+			continue;
+		}
+
+		if (S_ISDIR(entry->mode)) {
+			entry2stat(dfs, entry, sizeof(*entry), &stbufs[i]);
+			continue;
+		}
+
+		/** symlink values are not fetched above, take the slow path */
+		if (!S_ISREG(entry->mode)) {
+			rcs[i] = entry_stat(dfs, DAOS_TX_NONE, parent->oh, NULL,
+					    names[i], strlen(names[i]), NULL,
+					    &stbufs[i]);
+			continue;
+		}
+
+		rc2 = daos_array_open_with_attr(dfs->coh, entry->oid,
+						DAOS_TX_NONE, DAOS_OO_RO, 1,
+						entry->chunk_size ?
+						entry->chunk_size :
+						dfs->attr.da_chunk_size,
+						&be->be_oh, NULL);
+		if (rc2) {
+			rcs[i] = daos_der2errno(rc2);
+			continue;
+		}
+
+		rc2 = daos_event_init(&be->be_ev, DAOS_HDL_INVAL, &pev);
+		if (rc2) {
+			daos_array_close(be->be_oh, NULL);
+			rcs[i] = daos_der2errno(rc2);
+			continue;
+		}
+		be->be_launched = true;
+		launched++;
+
+		rc2 = daos_array_get_size(be->be_oh, DAOS_TX_NONE, &be->be_size,
+					  &be->be_ev);
+		if (rc2)
+			batch_launch_failed(&be->be_ev, rc2);
+	}
+
+	if (launched > 0)
+		rc = daos_der2errno(batch_wait(&pev));
+
+	for (i = 0; i < nr; i++) {
+		struct batch_entry *be = &bes[i];
+
+		if (!be->be_launched)
+			continue;
+
+		daos_array_close(be->be_oh, NULL);
+		rc2 = be->be_ev.ev_error;
+		if (rc2 == 0 && rc == 0)
+			entry2stat(dfs, &be->be_entry, be->be_size, &stbufs[i]);
+		rcs[i] = daos_der2errno(rc2);
+	}
+	daos_event_fini(&pev);
+
+	for (i = 0; rc == 0 && i < nr; i++)
+		rc = rcs[i];
+out:
+	D_FREE(bes);
+	return rc;
+}
+
+struct iterate_shards_arg {
+	dfs_t		*dfs;
+	dfs_obj_t	*obj;
+	dfs_filler_cb_t	op;
+	void		*arg;
+	/** errno returned by op, if any */
+	int		rc;
+};
+
+static int
+iterate_shards_cb(daos_key_desc_t *kd, void *key, void *arg)
+{
+	struct iterate_shards_arg	*isa = arg;
+	char				name[DFS_MAX_NAME + 1];
+
+	if (kd->kd_key_len > DFS_MAX_NAME)
+		return -DER_INVAL;
+
+	memcpy(name, key, kd->kd_key_len);
+	name[kd->kd_key_len] = '\0';
+
+	/** stop the listing, the errno is returned from isa->rc */
+	isa->rc = isa->op(isa->dfs, isa->obj, name, isa->arg);
+	return isa->rc ? 1 : 0;
+}
+
+int
+dfs_iterate_shards(dfs_t *dfs, dfs_obj_t *obj, dfs_filler_cb_t op, void *arg)
+{
+	struct iterate_shards_arg	isa;
+	int				rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (obj == NULL || !S_ISDIR(obj->mode))
+		return ENOTDIR;
+	if (op == NULL)
+		return EINVAL;
+
+	isa.dfs = dfs;
+	isa.obj = obj;
+	isa.op = op;
+	isa.arg = arg;
+	isa.rc = 0;
+	rc = daos_obj_list_dkey_all(obj->oh, DAOS_TX_NONE, iterate_shards_cb,
+				    &isa);
+	if (isa.rc)
+		return isa.rc;
+	return daos_der2errno(rc);
+}
+
 int
 dfs_open(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	 int flags, daos_oclass_id_t cid, daos_size_t chunk_size,
@@ -3042,10 +4217,13 @@ dfs_open_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	obj->flags = flags;
 	oid_cp(&obj->parent_oid, parent->oid);
 
+	if (flags & O_CREAT)
+		dcache_evict(dfs, parent->oid, name, len);
+
 	switch (mode & S_IFMT) {
 	case S_IFREG:
 		rc = open_file(dfs, parent, flags, cid, chunk_size, &entry,
-			       stbuf ? &file_size : NULL, len, obj);
+			       stbuf ? &file_size : NULL, len, NULL, 0, obj);
 		if (rc) {
 			D_DEBUG(DB_TRACE, "Failed to open file (%d)\n", rc);
 			D_GOTO(out, rc);
@@ -3091,6 +4269,63 @@ out:
 	return rc;
 }
 
+int
+dfs_create_write(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
+		 int flags, daos_oclass_id_t cid, daos_size_t chunk_size,
+		 d_sg_list_t *sgl, dfs_obj_t **_obj)
+{
+	struct dfs_entry	entry = {0};
+	dfs_obj_t		*obj;
+	size_t			len;
+	daos_size_t		buf_size = 0;
+	int			i;
+	int			rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (dfs->amode != O_RDWR)
+		return EPERM;
+	if (_obj == NULL || !S_ISREG(mode))
+		return EINVAL;
+	if ((flags & O_ACCMODE) == O_RDONLY)
+		return EPERM;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+
+	rc = check_name(name, &len);
+	if (rc)
+		return rc;
+
+	if (sgl)
+		for (i = 0; i < sgl->sg_nr; i++)
+			buf_size += sgl->sg_iovs[i].iov_len;
+
+	D_ALLOC_PTR(obj);
+	if (obj == NULL)
+		return ENOMEM;
+
+	flags |= O_CREAT | O_EXCL;
+	strncpy(obj->name, name, len + 1);
+	obj->mode = mode;
+	obj->flags = flags;
+	oid_cp(&obj->parent_oid, parent->oid);
+
+	dcache_evict(dfs, parent->oid, name, len);
+
+	rc = open_file(dfs, parent, flags, cid, chunk_size, &entry, NULL, len,
+		       buf_size ? sgl : NULL, buf_size, obj);
+	if (rc) {
+		D_DEBUG(DB_TRACE, "Failed to create file (%d)\n", rc);
+		D_FREE(obj);
+		return rc;
+	}
+
+	*_obj = obj;
+	return 0;
+}
+
 int
 dfs_dup(dfs_t *dfs, dfs_obj_t *obj, int flags, dfs_obj_t **_new_obj)
 {
@@ -3325,6 +4560,128 @@ out:
 	return rc;
 }
 
+/**
+ * Broadcast the global handle of the root process, or its error, on the
+ * non-root processes the handle is allocated and must be freed by the caller.
+ */
+static int
+dfs_coll_bcast(bool root, int root_rc, d_iov_t *glob, dfs_bcast_cb_t bcast,
+	       void *arg)
+{
+	struct {
+		int64_t		rc;
+		uint64_t	len;
+	} hdr = {0};
+	int rc;
+
+	if (root) {
+		hdr.rc = root_rc;
+		hdr.len = glob->iov_len;
+	}
+
+	rc = bcast(&hdr, sizeof(hdr), arg);
+	if (rc != 0) {
+		D_ERROR("Failed to broadcast global handle size (%d)\n", rc);
+		return rc;
+	}
+	if (hdr.rc != 0)
+		return hdr.rc;
+
+	if (!root) {
+		D_ALLOC(glob->iov_buf, hdr.len);
+		if (glob->iov_buf == NULL)
+			return ENOMEM;
+		glob->iov_buf_len = hdr.len;
+		glob->iov_len = hdr.len;
+	}
+
+	rc = bcast(glob->iov_buf, hdr.len, arg);
+	if (rc != 0)
+		D_ERROR("Failed to broadcast global handle (%d)\n", rc);
+	return rc;
+}
+
+int
+dfs_mount_coll(daos_handle_t poh, daos_handle_t coh, int flags, bool root,
+	       dfs_bcast_cb_t bcast, void *arg, dfs_t **_dfs)
+{
+	dfs_t	*dfs = NULL;
+	d_iov_t	glob = { NULL, 0, 0 };
+	int	rc = 0;
+
+	if (bcast == NULL || _dfs == NULL)
+		return EINVAL;
+
+	if (root) {
+		rc = dfs_mount(poh, coh, flags, &dfs);
+		if (rc == 0)
+			rc = dfs_local2global(dfs, &glob);
+		if (rc == 0) {
+			D_ALLOC(glob.iov_buf, glob.iov_buf_len);
+			if (glob.iov_buf == NULL)
+				rc = ENOMEM;
+		}
+		if (rc == 0)
+			rc = dfs_local2global(dfs, &glob);
+	}
+
+	rc = dfs_coll_bcast(root, rc, &glob, bcast, arg);
+	if (rc == 0 && !root)
+		rc = dfs_global2local(poh, coh, flags, glob, &dfs);
+
+	D_FREE(glob.iov_buf);
+	if (rc != 0) {
+		if (dfs != NULL)
+			dfs_umount(dfs);
+		return rc;
+	}
+
+	*_dfs = dfs;
+	return 0;
+}
+
+int
+dfs_lookup_coll(dfs_t *dfs, const char *path, int flags, bool root,
+		dfs_bcast_cb_t bcast, void *arg, dfs_obj_t **_obj)
+{
+	dfs_obj_t	*obj = NULL;
+	d_iov_t		glob = { NULL, 0, 0 };
+	mode_t		mode;
+	int		rc = 0;
+
+	if (dfs == NULL || !dfs->mounted || bcast == NULL || _obj == NULL)
+		return EINVAL;
+
+	if (root) {
+		rc = dfs_lookup(dfs, path, flags, &obj, &mode, NULL);
+		if (rc == 0 && !S_ISREG(mode))
+			rc = EINVAL;
+		if (rc == 0)
+			rc = dfs_obj_local2global(dfs, obj, &glob);
+		if (rc == 0) {
+			D_ALLOC(glob.iov_buf, glob.iov_buf_len);
+			if (glob.iov_buf == NULL)
+				rc = ENOMEM;
+		}
+		if (rc == 0)
+			rc = dfs_obj_local2global(dfs, obj, &glob);
+	}
+
+	rc = dfs_coll_bcast(root, rc, &glob, bcast, arg);
+	if (rc == 0 && !root)
+		rc = dfs_obj_global2local(dfs, flags, glob, &obj);
+
+	D_FREE(glob.iov_buf);
+	if (rc != 0) {
+		if (obj != NULL)
+			dfs_release(obj);
+		return rc;
+	}
+
+	*_obj = obj;
+	return 0;
+}
+
 int
 dfs_release(dfs_obj_t *obj)
 {
@@ -3650,9 +5007,10 @@ dfs_update_parentfd(dfs_obj_t *obj, dfs_obj_t *new_parent, const char *name)
 int
 dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name, struct stat *stbuf)
 {
-	daos_handle_t	oh;
-	size_t		len;
-	int		rc;
+	const daos_obj_id_t	*parent_oid = NULL;
+	daos_handle_t		oh;
+	size_t			len;
+	int			rc;
 
 	if (dfs == NULL || !dfs->mounted)
 		return EINVAL;
@@ -3675,9 +5033,11 @@ dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name, struct stat *stbuf)
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		parent_oid = &parent->oid;
 	}
 
-	return entry_stat(dfs, DAOS_TX_NONE, oh, name, len, NULL, stbuf);
+	return entry_stat(dfs, DAOS_TX_NONE, oh, parent_oid, name, len, NULL,
+			  stbuf);
 }
 
 int
@@ -3696,8 +5056,8 @@ dfs_ostat(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf)
 	if (rc)
 		return daos_der2errno(rc);
 
-	rc = entry_stat(dfs, DAOS_TX_NONE, oh, obj->name, strlen(obj->name),
-			obj, stbuf);
+	rc = entry_stat(dfs, DAOS_TX_NONE, oh, NULL, obj->name,
+			strlen(obj->name), obj, stbuf);
 	if (rc)
 		D_GOTO(out, rc);
 
@@ -3706,6 +5066,191 @@ out:
 	return rc;
 }
 
+struct dfs_statx_args {
+	dfs_t			*dfs;
+	dfs_obj_t		*obj;
+	struct stat		*stbuf;
+	daos_handle_t		parent_oh;
+	struct dfs_entry	entry;
+	daos_key_t		dkey;
+	daos_iod_t		iod;
+	daos_recx_t		recx;
+	d_sg_list_t		sgl;
+	d_iov_t			sg_iovs[INODE_AKEYS];
+	daos_size_t		size;
+};
+
+/*
+ * Body of the statx task, run once the entry fetch, the parent close and (for
+ * files) the array size query it depends on have all completed.
+ */
+static int
+statx_task(tse_task_t *task)
+{
+	struct dfs_statx_args	*args = daos_task_get_priv(task);
+	struct dfs_obj		*obj = args->obj;
+	struct dfs_entry	*entry = &args->entry;
+	struct stat		*stbuf = args->stbuf;
+	daos_size_t		size;
+	int			rc = task->dt_result;
+
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	if (args->sgl.sg_nr_out == 0)
+		D_GOTO(out, rc = -DER_NONEXIST);
+
+	if (obj->oid.hi != entry->oid.hi || obj->oid.lo != entry->oid.lo)
+		D_GOTO(out, rc = -DER_NONEXIST);
+
+	memset(stbuf, 0, sizeof(struct stat));
+
+	switch (entry->mode & S_IFMT) {
+	case S_IFDIR:
+		size = sizeof(*entry);
+		break;
+	case S_IFREG:
+		size = args->size;
+		break;
+	case S_IFLNK:
+		size = obj->value ? strlen(obj->value) : 0;
+		break;
+	default:
+		D_ERROR("Invalid entry type (not a dir, file, symlink).\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	entry2stat(args->dfs, entry, size, stbuf);
+
+out:
+	D_FREE(args);
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+int
+dfs_ostatx(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, daos_event_t *ev)
+{
+	struct dfs_statx_args	*args;
+	tse_task_t		*task;
+	tse_task_t		*deps[3];
+	tse_sched_t		*sched;
+	daos_obj_close_t	*close_args;
+	daos_array_get_size_t	*size_args;
+	int			ndeps = 0;
+	int			i;
+	int			rc;
+
+	if (ev == NULL)
+		return dfs_ostat(dfs, obj, stbuf);
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (obj == NULL || stbuf == NULL)
+		return EINVAL;
+
+	D_ALLOC_PTR(args);
+	if (args == NULL)
+		return ENOMEM;
+
+	args->dfs = dfs;
+	args->obj = obj;
+	args->stbuf = stbuf;
+
+	/** Opening the parent is local, only the fetch goes to the server */
+	rc = daos_obj_open(dfs->coh, obj->parent_oid, DAOS_OO_RO,
+			   &args->parent_oh, NULL);
+	if (rc) {
+		D_FREE(args);
+		return daos_der2errno(rc);
+	}
+
+	daos_event_errno_rc(ev);
+
+	rc = dc_task_create(statx_task, NULL, ev, &task);
+	if (rc) {
+		daos_obj_close(args->parent_oh, NULL);
+		D_FREE(args);
+		return daos_der2errno(rc);
+	}
+	daos_task_set_priv(task, args);
+	sched = tse_task2sched(task);
+
+	d_iov_set(&args->dkey, obj->name, strlen(obj->name));
+	d_iov_set(&args->iod.iod_name, INODE_AKEY_NAME,
+		  sizeof(INODE_AKEY_NAME) - 1);
+	args->iod.iod_nr	= 1;
+	args->recx.rx_idx	= 0;
+	args->recx.rx_nr	= SYML_IDX;
+	args->iod.iod_recxs	= &args->recx;
+	args->iod.iod_type	= DAOS_IOD_ARRAY;
+	args->iod.iod_size	= 1;
+
+	i = 0;
+	d_iov_set(&args->sg_iovs[i++], &args->entry.mode, sizeof(mode_t));
+	d_iov_set(&args->sg_iovs[i++], &args->entry.oid, sizeof(daos_obj_id_t));
+	d_iov_set(&args->sg_iovs[i++], &args->entry.atime, sizeof(time_t));
+	d_iov_set(&args->sg_iovs[i++], &args->entry.mtime, sizeof(time_t));
+	d_iov_set(&args->sg_iovs[i++], &args->entry.ctime, sizeof(time_t));
+	d_iov_set(&args->sg_iovs[i++], &args->entry.chunk_size,
+		  sizeof(daos_size_t));
+	d_iov_set(&args->sg_iovs[i++], &args->entry.oclass,
+		  sizeof(daos_oclass_id_t));
+	args->sgl.sg_nr		= i;
+	args->sgl.sg_nr_out	= 0;
+	args->sgl.sg_iovs	= args->sg_iovs;
+
+	rc = dc_obj_fetch_task_create(args->parent_oh, DAOS_TX_NONE, 0,
+				      &args->dkey, 1, 0, &args->iod,
+				      &args->sgl, NULL, NULL, NULL, NULL, sched,
+				      &deps[ndeps]);
+	if (rc)
+		D_GOTO(err_deps, rc);
+	ndeps++;
+
+	/** Close the parent once the entry has been fetched */
+	rc = daos_task_create(DAOS_OPC_OBJ_CLOSE, sched, 1, &deps[0],
+			      &deps[ndeps]);
+	if (rc)
+		D_GOTO(err_deps, rc);
+	close_args = daos_task_get_args(deps[ndeps]);
+	close_args->oh = args->parent_oh;
+	ndeps++;
+
+	/** Query the file size concurrently with the entry fetch */
+	if (S_ISREG(obj->mode)) {
+		rc = daos_task_create(DAOS_OPC_ARRAY_GET_SIZE, sched, 0, NULL,
+				      &deps[ndeps]);
+		if (rc)
+			D_GOTO(err_deps, rc);
+		size_args = daos_task_get_args(deps[ndeps]);
+		size_args->oh = obj->oh;
+		size_args->th = DAOS_TX_NONE;
+		size_args->size = &args->size;
+		ndeps++;
+	}
+
+	/** The statx task waits on the close and size tasks */
+	rc = tse_task_register_deps(task, ndeps - 1, &deps[1]);
+	if (rc)
+		D_GOTO(err_deps, rc);
+
+	tse_task_schedule(deps[0], true);
+	for (i = 1; i < ndeps; i++)
+		tse_task_schedule(deps[i], false);
+
+	return dc_task_schedule(task, false);
+
+err_deps:
+	/** none of the tasks have run, so undo what they would have done */
+	for (i = ndeps - 1; i >= 0; i--)
+		tse_task_complete(deps[i], rc);
+	daos_obj_close(args->parent_oh, NULL);
+	D_FREE(args);
+	tse_task_complete(task, rc);
+	return daos_der2errno(rc);
+}
+
 int
 dfs_access(dfs_t *dfs, dfs_obj_t *parent, const char *name, int mask)
 {
@@ -3894,8 +5439,12 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 
 out:
 	if (S_ISLNK(entry.mode)) {
+		dcache_evict(dfs, sym->parent_oid, sym->name,
+			     strlen(sym->name));
 		dfs_release(sym);
 		daos_obj_close(oh, NULL);
+	} else {
+		dcache_evict(dfs, parent->oid, name, len);
 	}
 	return rc;
 }
@@ -3946,7 +5495,7 @@ dfs_osetattr(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, int flags)
 	/* Fetch the remote entry first so we can check the oid, then keep
 	 * a track locally of what has been updated
 	 */
-	rc = entry_stat(dfs, th, oh, obj->name, len, obj, &rstat);
+	rc = entry_stat(dfs, th, oh, NULL, obj->name, len, obj, &rstat);
 	if (rc)
 		D_GOTO(out_obj, rc);
 
@@ -4024,6 +5573,7 @@ out_stat:
 
 out_obj:
 	daos_obj_close(oh, NULL);
+	dcache_evict(dfs, obj->parent_oid, obj->name, len);
 	return rc;
 }
 
@@ -4422,6 +5972,9 @@ out:
 	if (rc == ERESTART)
 		goto restart;
 
+	dcache_evict(dfs, parent->oid, name, len);
+	dcache_evict(dfs, new_parent->oid, new_name, new_len);
+
 	if (entry.value) {
 		D_ASSERT(S_ISLNK(entry.mode));
 		D_FREE(entry.value);
@@ -4549,6 +6102,9 @@ out:
 	if (rc == ERESTART)
 		goto restart;
 
+	dcache_evict(dfs, parent1->oid, name1, len1);
+	dcache_evict(dfs, parent2->oid, name2, len2);
+
 	if (entry1.value) {
 		D_ASSERT(S_ISLNK(entry1.mode));
 		D_FREE(entry1.value);
@@ -53,6 +53,15 @@ dfs_lookupx(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 	    dfs_obj_t **obj, mode_t *mode, struct stat *stbuf, int xnr,
 	    char *xnames[], void *xvals[], daos_size_t *xsizes);
 
+/*
+ * Fetch the mode and object ID of \a nr entries of \a parent concurrently,
+ * issuing all the inode fetches before waiting on any of them. Entries that do
+ * not exist are returned with a mode of 0. Objects are not opened.
+ */
+int
+dfs_lookup_entries(dfs_t *dfs, dfs_obj_t *parent, uint32_t nr,
+		   const char *names[], mode_t *modes, daos_obj_id_t *oids);
+
 /* moid is moved oid, oid is clobbered file.
  * This isn't yet fully compatible with dfuse because we also want to pass in a flag for if the
  * destination exists.
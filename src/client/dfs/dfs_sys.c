@@ -25,9 +25,16 @@
 /** Size of the hash table */
 #define DFS_SYS_HASH_SIZE 12
 
+/** Max number of directories kept open in the hash */
+#define DFS_SYS_LRU_SIZE 4096
+
 struct dfs_sys {
-	dfs_t			*dfs;	/* mounted filesystem */
-	struct d_hash_table	*hash;	/* optional lookup hash */
+	dfs_t			*dfs;		/* mounted filesystem */
+	struct d_hash_table	*hash;		/* optional lookup hash */
+	d_list_t		lru;		/* hash entries, MRU first */
+	uint32_t		lru_nr;		/* number of entries in lru */
+	bool			lru_locked;	/* lru_lock is used */
+	pthread_mutex_t		lru_lock;	/* protects lru */
 };
 
 /** struct holding parsed dirname, name, and cached parent obj */
@@ -56,9 +63,11 @@ struct dfs_sys_dir {
 struct hash_hdl {
 	dfs_obj_t	*obj;
 	d_list_t	entry;
+	d_list_t	lru;
 	char		*name;
 	size_t		name_len;
 	ATOMIC uint	ref;
+	bool		evicted;	/* removed from lru, protected by lru_lock */
 };
 
 /*
@@ -156,55 +165,168 @@ static d_hash_table_ops_t hash_hdl_ops = {
 	.hop_rec_hash	= hash_rec_hash
 };
 
+static inline void
+lru_lock(dfs_sys_t *dfs_sys)
+{
+	if (dfs_sys->lru_locked)
+		D_MUTEX_LOCK(&dfs_sys->lru_lock);
+}
+
+static inline void
+lru_unlock(dfs_sys_t *dfs_sys)
+{
+	if (dfs_sys->lru_locked)
+		D_MUTEX_UNLOCK(&dfs_sys->lru_lock);
+}
+
 /**
- * Try to get dir_name from the hash.
- * If not found, call dfs_lookup on name
- * and store in the hash.
- * Stores the hashed obj in parent.
+ * Move a cached entry to the head of the LRU.
+ * Entries being evicted are no longer on the LRU and are left alone.
+ */
+static void
+lru_touch(dfs_sys_t *dfs_sys, struct hash_hdl *hdl)
+{
+	lru_lock(dfs_sys);
+	if (!hdl->evicted && !d_list_empty(&hdl->lru))
+		d_list_move(&hdl->lru, &dfs_sys->lru);
+	lru_unlock(dfs_sys);
+}
+
+/**
+ * Add a new entry to the LRU and evict the least recently used entries
+ * to keep at most DFS_SYS_LRU_SIZE directories open.
+ * Evicted entries are removed from the hash and dropped once their
+ * last user is done with them.
  */
-/* TODO
- * We could recursively cache a path instead of blindly calling
- * dfs_lookup. For example, consider lookup on these paths in succession:
- *   dfs_lookup("/path/to/dir1")
- *   dfs_lookup("/path/to/dir2")
- * Internally, dfs_lookup will be fetching and iterating over the same
- * entries along the path. We could more efficiently do this:
- *   dfs_lookup_rel("/", "path")
- *   dfs_lookup_rel("/path", "to")
- *   dfs_lookup_rel("/path/to", "dir1")
- *   dfs_lookup_rel("/path/to", "dir2")
+static void
+lru_add(dfs_sys_t *dfs_sys, struct hash_hdl *hdl)
+{
+	struct hash_hdl	*victim;
+
+	lru_lock(dfs_sys);
+	d_list_add(&hdl->lru, &dfs_sys->lru);
+	dfs_sys->lru_nr++;
+	while (dfs_sys->lru_nr > DFS_SYS_LRU_SIZE) {
+		/* Unlink the victim before dropping the lock, so that a
+		 * concurrent lru_touch cannot put it back on the LRU.
+		 */
+		victim = d_list_entry(dfs_sys->lru.prev, struct hash_hdl, lru);
+		d_list_del_init(&victim->lru);
+		victim->evicted = true;
+		dfs_sys->lru_nr--;
+		lru_unlock(dfs_sys);
+
+		D_DEBUG(DB_TRACE, "evicting %s\n", victim->name);
+		/* Drop the reference held by the hash */
+		if (d_hash_rec_delete_at(dfs_sys->hash, &victim->entry))
+			d_hash_rec_decref(dfs_sys->hash, &victim->entry);
+
+		lru_lock(dfs_sys);
+	}
+	lru_unlock(dfs_sys);
+}
+
+static int
+hash_lookup_dir(dfs_sys_t *dfs_sys, const char *dir_name, size_t dir_name_len,
+		struct hash_hdl **_hdl);
+
+/**
+ * Lookup a directory in dfs.
+ * Its parent is resolved through the hash, so that every uncached
+ * component of the path costs a single dfs_lookup_rel, and sibling
+ * directories share the lookups of their common prefix.
+ * Paths with "." or ".." components and symlinks fall back to dfs_lookup
+ * on the full path.
  */
 static int
-hash_lookup(dfs_sys_t *dfs_sys, struct sys_path *sys_path)
+hash_dfs_lookup(dfs_sys_t *dfs_sys, const char *dir_name, size_t dir_name_len,
+		dfs_obj_t **obj, mode_t *mode)
 {
-	struct hash_hdl	*hdl;
-	d_list_t	*rlink;
-	mode_t		mode;
-	int		rc = 0;
+	struct hash_hdl	*parent;
+	char		*name;
+	size_t		end_idx = 0;
+	size_t		slash_idx = 0;
+	size_t		name_len;
+	size_t		i;
+	int		rc;
 
-	/* If we aren't caching, just call dfs_lookup */
-	if (dfs_sys->hash == NULL) {
-		rc = dfs_lookup(dfs_sys->dfs, sys_path->dir_name, O_RDWR,
-				&sys_path->parent, &mode, NULL);
-		if (rc != 0) {
-			D_DEBUG(DB_TRACE, "failed to lookup %s: (%d)\n",
-				sys_path->dir_name, rc);
-			return rc;
+	/** Find end, not including trailing slashes */
+	for (i = dir_name_len - 1; i > 0; i--) {
+		if (dir_name[i] != '/') {
+			end_idx = i;
+			break;
 		}
+	}
+	if (end_idx == 0)
+		goto full_lookup;
 
-		/* We only cache directories */
-		if (!S_ISDIR(mode)) {
-			dfs_release(sys_path->parent);
-			return ENOTDIR;
+	/** Find last slash */
+	for (; i > 0; i--) {
+		if (dir_name[i] == '/') {
+			slash_idx = i;
+			break;
 		}
+	}
+
+	name_len = end_idx - slash_idx;
+	if (name_len > NAME_MAX)
+		return ENAMETOOLONG;
+	if ((name_len == 1 && dir_name[end_idx] == '.') ||
+	    (name_len == 2 && strncmp(&dir_name[slash_idx + 1], "..", 2) == 0))
+		goto full_lookup;
+
+	rc = hash_lookup_dir(dfs_sys, dir_name, slash_idx == 0 ? 1 : slash_idx,
+			     &parent);
+	if (rc != 0)
+		return rc;
+
+	D_STRNDUP(name, &dir_name[slash_idx + 1], name_len);
+	if (name == NULL) {
+		d_hash_rec_decref(dfs_sys->hash, &parent->entry);
+		return ENOMEM;
+	}
+
+	rc = dfs_lookup_rel(dfs_sys->dfs, parent->obj, name, O_RDWR, obj, mode,
+			    NULL);
+	D_FREE(name);
+	d_hash_rec_decref(dfs_sys->hash, &parent->entry);
+	if (rc != 0) {
+		D_DEBUG(DB_TRACE, "failed to lookup %.*s: (%d)\n",
+			(int)dir_name_len, dir_name, rc);
 		return rc;
 	}
 
+	if (!S_ISLNK(*mode))
+		return 0;
+	dfs_release(*obj);
+
+full_lookup:
+	rc = dfs_lookup(dfs_sys->dfs, dir_name, O_RDWR, obj, mode, NULL);
+	if (rc != 0)
+		D_DEBUG(DB_TRACE, "failed to lookup %s: (%d)\n", dir_name, rc);
+	return rc;
+}
+
+/**
+ * Try to get dir_name from the hash.
+ * If not found, lookup dir_name in dfs and store it in the hash.
+ * The returned entry holds a reference that the caller must release
+ * with d_hash_rec_decref.
+ */
+static int
+hash_lookup_dir(dfs_sys_t *dfs_sys, const char *dir_name, size_t dir_name_len,
+		struct hash_hdl **_hdl)
+{
+	struct hash_hdl	*hdl;
+	d_list_t	*rlink;
+	mode_t		mode;
+	int		rc = 0;
+
 	/* If cached, return it */
-	rlink = d_hash_rec_find(dfs_sys->hash, sys_path->dir_name,
-				sys_path->dir_name_len);
+	rlink = d_hash_rec_find(dfs_sys->hash, dir_name, dir_name_len);
 	if (rlink != NULL) {
 		hdl = hash_hdl_obj(rlink);
+		lru_touch(dfs_sys, hdl);
 		D_GOTO(out, rc = 0);
 	}
 
@@ -213,8 +335,9 @@ hash_lookup(dfs_sys_t *dfs_sys, struct sys_path *sys_path)
 	if (hdl == NULL)
 		return ENOMEM;
 
-	hdl->name_len = sys_path->dir_name_len;
-	D_STRNDUP(hdl->name, sys_path->dir_name, sys_path->dir_name_len);
+	D_INIT_LIST_HEAD(&hdl->lru);
+	hdl->name_len = dir_name_len;
+	D_STRNDUP(hdl->name, dir_name, dir_name_len);
 	if (hdl->name == NULL)
 		D_GOTO(free_hdl, rc = ENOMEM);
 
@@ -224,12 +347,10 @@ hash_lookup(dfs_sys_t *dfs_sys, struct sys_path *sys_path)
 	atomic_store_relaxed(&hdl->ref, 2);
 
 	/* Lookup name in dfs */
-	rc = dfs_lookup(dfs_sys->dfs, sys_path->dir_name, O_RDWR, &hdl->obj,
-			&mode, NULL);
-	if (rc != 0) {
-		D_DEBUG(DB_TRACE, "failed to lookup %s: (%d)\n", sys_path->dir_name, rc);
+	rc = hash_dfs_lookup(dfs_sys, hdl->name, dir_name_len, &hdl->obj,
+			     &mode);
+	if (rc != 0)
 		D_GOTO(free_hdl_name, rc);
-	}
 
 	/* We only cache directories */
 	if (!S_ISDIR(mode))
@@ -239,17 +360,17 @@ hash_lookup(dfs_sys_t *dfs_sys, struct sys_path *sys_path)
 	 * after calling find.
 	 */
 	rlink = d_hash_rec_find_insert(dfs_sys->hash, hdl->name,
-				       sys_path->dir_name_len, &hdl->entry);
+				       dir_name_len, &hdl->entry);
 	if (rlink != &hdl->entry) {
 		/* another thread beat us. Use the existing entry. */
-		sys_path->parent = hash_hdl_obj(rlink)->obj;
-		sys_path->rlink = rlink;
+		*_hdl = hash_hdl_obj(rlink);
 		D_GOTO(free_hdl_obj, rc = 0);
 	}
 
+	lru_add(dfs_sys, hdl);
+
 out:
-	sys_path->parent = hdl->obj;
-	sys_path->rlink = rlink;
+	*_hdl = hdl;
 	return rc;
 
 free_hdl_obj:
@@ -261,6 +382,46 @@ free_hdl:
 	return rc;
 }
 
+/**
+ * Lookup the dir_name obj of a sys_path.
+ * Stores the obj in parent, and the hash entry holding it in rlink
+ * when caching.
+ */
+static int
+hash_lookup(dfs_sys_t *dfs_sys, struct sys_path *sys_path)
+{
+	struct hash_hdl	*hdl;
+	mode_t		mode;
+	int		rc = 0;
+
+	/* If we aren't caching, just call dfs_lookup */
+	if (dfs_sys->hash == NULL) {
+		rc = dfs_lookup(dfs_sys->dfs, sys_path->dir_name, O_RDWR,
+				&sys_path->parent, &mode, NULL);
+		if (rc != 0) {
+			D_DEBUG(DB_TRACE, "failed to lookup %s: (%d)\n",
+				sys_path->dir_name, rc);
+			return rc;
+		}
+
+		/* We only cache directories */
+		if (!S_ISDIR(mode)) {
+			dfs_release(sys_path->parent);
+			return ENOTDIR;
+		}
+		return rc;
+	}
+
+	rc = hash_lookup_dir(dfs_sys, sys_path->dir_name,
+			     sys_path->dir_name_len, &hdl);
+	if (rc != 0)
+		return rc;
+
+	sys_path->parent = hdl->obj;
+	sys_path->rlink = &hdl->entry;
+	return rc;
+}
+
 /**
  * Free a struct sys_path.
  */
@@ -364,13 +525,49 @@ sys_path_parse(dfs_sys_t *dfs_sys, struct sys_path *sys_path,
 	return rc;
 }
 
+/**
+ * Create the lookup hash and its LRU.
+ */
+static int
+sys_hash_init(dfs_sys_t *dfs_sys, bool no_lock)
+{
+	uint32_t	hash_feats = D_HASH_FT_EPHEMERAL;
+	int		rc;
+
+	D_INIT_LIST_HEAD(&dfs_sys->lru);
+	dfs_sys->lru_nr = 0;
+
+	if (no_lock) {
+		hash_feats |= D_HASH_FT_NOLOCK;
+	} else {
+		hash_feats |= D_HASH_FT_RWLOCK;
+		rc = D_MUTEX_INIT(&dfs_sys->lru_lock, NULL);
+		if (rc != 0)
+			return daos_der2errno(rc);
+		dfs_sys->lru_locked = true;
+	}
+
+	rc = d_hash_table_create(hash_feats, DFS_SYS_HASH_SIZE, NULL,
+				 &hash_hdl_ops, &dfs_sys->hash);
+	if (rc != 0) {
+		D_DEBUG(DB_TRACE, "failed to create hash table: "DF_RC"\n",
+			DP_RC(rc));
+		if (dfs_sys->lru_locked) {
+			D_MUTEX_DESTROY(&dfs_sys->lru_lock);
+			dfs_sys->lru_locked = false;
+		}
+		return daos_der2errno(rc);
+	}
+
+	return 0;
+}
+
 int
 dfs_sys_mount(daos_handle_t poh, daos_handle_t coh, int mflags, int sflags,
 	      dfs_sys_t **_dfs_sys)
 {
 	dfs_sys_t	*dfs_sys;
 	int		rc;
-	uint32_t	hash_feats = D_HASH_FT_EPHEMERAL;
 	bool		no_cache = false;
 	bool		no_lock = false;
 
@@ -406,19 +603,9 @@ dfs_sys_mount(daos_handle_t poh, daos_handle_t coh, int mflags, int sflags,
 
 	/* Initialize the hash */
 	if (!no_cache) {
-		if (no_lock)
-			hash_feats |= D_HASH_FT_NOLOCK;
-		else
-			hash_feats |= D_HASH_FT_RWLOCK;
-
-		rc = d_hash_table_create(hash_feats, DFS_SYS_HASH_SIZE,
-					 NULL, &hash_hdl_ops,
-					 &dfs_sys->hash);
-		if (rc != 0) {
-			D_DEBUG(DB_TRACE, "failed to create hash table "
-				DF_RC"\n", DP_RC(rc));
-			D_GOTO(err_hash, rc = daos_der2errno(rc));
-		}
+		rc = sys_hash_init(dfs_sys, no_lock);
+		if (rc != 0)
+			D_GOTO(err_hash, rc);
 	}
 
 	*_dfs_sys = dfs_sys;
@@ -459,6 +646,13 @@ dfs_sys_umount(dfs_sys_t *dfs_sys)
 			return rc;
 		}
 		dfs_sys->hash = NULL;
+		/* All entries are freed, just reset the LRU */
+		D_INIT_LIST_HEAD(&dfs_sys->lru);
+		dfs_sys->lru_nr = 0;
+		if (dfs_sys->lru_locked) {
+			D_MUTEX_DESTROY(&dfs_sys->lru_lock);
+			dfs_sys->lru_locked = false;
+		}
 	}
 
 	if (dfs_sys->dfs != NULL) {
@@ -494,7 +688,6 @@ dfs_sys_global2local(daos_handle_t poh, daos_handle_t coh, int mflags,
 	dfs_sys_t	*dfs_sys;
 	bool		no_cache = false;
 	bool		no_lock = false;
-	uint32_t	hash_feats = D_HASH_FT_EPHEMERAL;
 
 	if (_dfs_sys == NULL)
 		return EINVAL;
@@ -528,19 +721,9 @@ dfs_sys_global2local(daos_handle_t poh, daos_handle_t coh, int mflags,
 
 	/* Initialize the hash */
 	if (!no_cache) {
-		if (no_lock)
-			hash_feats |= D_HASH_FT_NOLOCK;
-		else
-			hash_feats |= D_HASH_FT_RWLOCK;
-
-		rc = d_hash_table_create(hash_feats, DFS_SYS_HASH_SIZE,
-					 NULL, &hash_hdl_ops,
-					 &dfs_sys->hash);
-		if (rc != 0) {
-			D_DEBUG(DB_TRACE, "failed to create hash table: "
-				DF_RC"\n", DP_RC(rc));
-			D_GOTO(err_hash, rc = daos_der2errno(rc));
-		}
+		rc = sys_hash_init(dfs_sys, no_lock);
+		if (rc != 0)
+			D_GOTO(err_hash, rc);
 	}
 
 	*_dfs_sys = dfs_sys;
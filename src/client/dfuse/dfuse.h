@@ -28,10 +28,27 @@ struct dfuse_info {
 	char				*di_group;
 	char				*di_mountpoint;
 	uint32_t			di_thread_count;
+	uint32_t			di_eq_count;
 	bool				di_threaded;
 	bool				di_foreground;
 	bool				di_caching;
 	bool				di_wb_cache;
+	bool				di_large_io;
+	bool				di_parallel_dirops;
+};
+
+/* Maximum number of event queues, and so progress threads, to use */
+#define DFUSE_EQ_MAX 64
+
+/** An event queue and the thread that polls it */
+struct dfuse_eq {
+	struct dfuse_projection_info	*deq_handle;
+	/* Event queue for async events */
+	daos_handle_t			deq_eq;
+	/** Semaphore to signal event waiting for async thread */
+	sem_t				deq_sem;
+	pthread_t			deq_thread;
+	uint32_t			deq_idx;
 };
 
 struct dfuse_projection_info {
@@ -42,14 +59,18 @@ struct dfuse_projection_info {
 	struct d_hash_table		dpi_pool_table;
 	/** Next available inode number */
 	ATOMIC uint64_t			dpi_ino_next;
-	/* Event queue for async events */
-	daos_handle_t			dpi_eq;
-	/** Semaphore to signal event waiting for async thread */
-	sem_t				dpi_sem;
-	pthread_t			dpi_thread;
+	/** Event queues for async events, one progress thread each */
+	struct dfuse_eq			*dpi_eqt;
+	uint32_t			dpi_eqt_count;
+	/** Number of queues with a running progress thread */
+	uint32_t			dpi_eqt_started;
 	bool				dpi_shutdown;
 };
 
+/* Return the event queue to use for an event created on the calling CPU */
+struct dfuse_eq *
+dfuse_eq_get(struct dfuse_projection_info *fs_handle);
+
 /* Launch fuse, and do not return until complete */
 int
 dfuse_launch_fuse(struct dfuse_projection_info *fs_handle, struct fuse_args *args);
@@ -68,6 +89,39 @@ struct dfuse_readdir_entry {
 	 * of directory.
 	 */
 	off_t	dre_next_offset;
+
+	/* Mode and object ID of the entry, if looked up in a batch.  A mode
+	 * of 0 with dre_valid set means that the entry no longer exists.
+	 */
+	mode_t		dre_mode;
+	daos_obj_id_t	dre_oid;
+	bool		dre_valid;
+};
+
+/* Names of a directory in enumeration order, shared by all the open handles
+ * of the directory so that seeks and concurrent readers do not restart the
+ * enumeration.  Indexed by readdir offset, minus the offsets of . and ..
+ *
+ * Each generation of the cache is reference counted.  A local change to the
+ * directory detaches the current generation from the inode rather than
+ * emptying it, so handles part way through an enumeration keep the offsets
+ * they were given, and only enumerations started afterwards see the change.
+ */
+struct dfuse_readdir_cache {
+	pthread_mutex_t	drc_lock;
+	/* References from the inode and open handles, protected by
+	 * dfs_readdir_lock of the container.
+	 */
+	uint32_t	drc_ref;
+	/* Anchor of the next enumeration batch */
+	daos_anchor_t	drc_anchor;
+	char		**drc_names;
+	uint32_t	drc_nr;
+	uint32_t	drc_alloc;
+	/* Time after which new enumerations start a new generation */
+	uint64_t	drc_expire;
+	/* All names of the directory are in the cache */
+	bool		drc_eod;
 };
 
 /** what is returned as the handle for fuse fuse_file_info on
@@ -84,12 +138,21 @@ struct dfuse_obj_hdl {
 	/** True if caching is enabled for this file. */
 	bool				doh_caching;
 
+	/** Offset the next read is expected at if the file is read
+	 * sequentially.
+	 */
+	off_t				doh_ra_next;
+	/** Current readahead window, zero if not reading sequentially */
+	size_t				doh_ra_len;
+
 	/* Below here is only used for directories */
 	/** an anchor to track listing in readdir */
 	daos_anchor_t			doh_anchor;
 
 	/** Array of entries returned by dfs but not reported to kernel */
 	struct dfuse_readdir_entry	*doh_dre;
+	/** Generation of the entry cache this handle enumerates */
+	struct dfuse_readdir_cache	*doh_readdir;
 	/** Current index into doh_dre array */
 	uint32_t			doh_dre_index;
 	/** Last index containing valid data */
@@ -140,6 +203,10 @@ struct dfuse_event {
 	size_t		de_len;
 	d_iov_t		de_iov;
 	d_sg_list_t	de_sgl;
+	/** Open handle and length requested by the kernel, for readahead */
+	struct dfuse_obj_hdl	*de_oh;
+	off_t		de_req_position;
+	size_t		de_req_len;
 };
 
 extern struct dfuse_inode_ops dfuse_dfs_ops;
@@ -210,6 +277,8 @@ struct dfuse_cont {
 	bool			dfc_data_caching;
 	bool			dfc_direct_io_disable;
 	pthread_mutex_t		dfs_read_mutex;
+	/** Protects ie_readdir of the inodes and the cache references */
+	pthread_mutex_t		dfs_readdir_lock;
 };
 
 void
@@ -537,6 +606,11 @@ struct dfuse_inode_entry {
 
 	/** File has been unlinked from daos */
 	bool			ie_unlinked;
+
+	/** Current generation of the cached entries of a directory,
+	 * allocated on first readdir.
+	 */
+	struct dfuse_readdir_cache	*ie_readdir;
 };
 
 /* Generate the inode to use for this dfs object.  This is generating a single
@@ -618,6 +692,16 @@ dfuse_cb_unlink(fuse_req_t, struct dfuse_inode_entry *,
 void
 dfuse_cb_readdir(fuse_req_t, struct dfuse_obj_hdl *, size_t, off_t, bool);
 
+/* Drop the cached entries of a directory after a local change to it, or when
+ * the inode is closed.
+ */
+void
+dfuse_readdir_invalidate(struct dfuse_inode_entry *ie);
+
+/* Drop the reference of a directory handle on the cached entries */
+void
+dfuse_readdir_release(struct dfuse_obj_hdl *oh);
+
 void
 dfuse_cb_rename(fuse_req_t, struct dfuse_inode_entry *, const char *,
 		struct dfuse_inode_entry *, const char *, unsigned int);
@@ -5,6 +5,7 @@
  */
 
 #include <pthread.h>
+#include <sched.h>
 
 #include "dfuse_common.h"
 #include "dfuse.h"
@@ -14,18 +15,20 @@
  * This thread is started at launch time with an event queue and blocks
  * on a semaphore until a asynchronous event is created, at which point
  * the thread wakes up and busy polls in daos_eq_poll() until it's complete.
+ * There is one of these per event queue.
  */
 static void *
 dfuse_progress_thread(void *arg)
 {
-	struct dfuse_projection_info *fs_handle = arg;
+	struct dfuse_eq *eqt = arg;
+	struct dfuse_projection_info *fs_handle = eqt->deq_handle;
 	int rc;
 	daos_event_t *dev;
 	struct dfuse_event *ev;
 
 	while (1) {
 		errno = 0;
-		rc = sem_wait(&fs_handle->dpi_sem);
+		rc = sem_wait(&eqt->deq_sem);
 		if (rc != 0) {
 			rc = errno;
 
@@ -38,7 +41,7 @@ dfuse_progress_thread(void *arg)
 		if (fs_handle->dpi_shutdown)
 			return NULL;
 
-		rc = daos_eq_poll(fs_handle->dpi_eq, 1, DAOS_EQ_WAIT, 1, &dev);
+		rc = daos_eq_poll(eqt->deq_eq, 1, DAOS_EQ_WAIT, 1, &dev);
 		if (rc == 1) {
 			daos_event_fini(dev);
 			ev = container_of(dev, struct dfuse_event, de_ev);
@@ -49,6 +52,75 @@ dfuse_progress_thread(void *arg)
 	return NULL;
 }
 
+/* Events are placed on the queue for the CPU the request is running on, so that
+ * with the progress threads pinned below completion happens on a nearby core.
+ */
+struct dfuse_eq *
+dfuse_eq_get(struct dfuse_projection_info *fs_handle)
+{
+	int cpu;
+
+	if (fs_handle->dpi_eqt_count == 1)
+		return &fs_handle->dpi_eqt[0];
+
+	cpu = sched_getcpu();
+	if (cpu < 0)
+		cpu = 0;
+
+	return &fs_handle->dpi_eqt[cpu % fs_handle->dpi_eqt_count];
+}
+
+/* Pin the progress thread for a queue to the CPUs that dfuse_eq_get() maps to
+ * it.  Failure is not fatal, the thread simply runs anywhere.
+ */
+static void
+dfuse_eq_set_affinity(struct dfuse_eq *eqt)
+{
+	struct dfuse_projection_info	*fs_handle = eqt->deq_handle;
+	cpu_set_t			 cpuset;
+	cpu_set_t			 eqset;
+	int				 cpu;
+	int				 rc;
+
+	if (fs_handle->dpi_eqt_count == 1)
+		return;
+
+	rc = sched_getaffinity(0, sizeof(cpuset), &cpuset);
+	if (rc != 0)
+		return;
+
+	CPU_ZERO(&eqset);
+	for (cpu = eqt->deq_idx; cpu < CPU_SETSIZE;
+	     cpu += fs_handle->dpi_eqt_count) {
+		if (CPU_ISSET(cpu, &cpuset))
+			CPU_SET(cpu, &eqset);
+	}
+
+	if (CPU_COUNT(&eqset) == 0)
+		return;
+
+	rc = pthread_setaffinity_np(eqt->deq_thread, sizeof(eqset), &eqset);
+	if (rc != 0)
+		DFUSE_TRA_WARNING(fs_handle, "Failed to set affinity for eq %d: %d (%s)",
+				  eqt->deq_idx, rc, strerror(rc));
+}
+
+static void
+dfuse_eq_stop(struct dfuse_projection_info *fs_handle)
+{
+	int i;
+
+	fs_handle->dpi_shutdown = true;
+
+	for (i = 0; i < fs_handle->dpi_eqt_started; i++)
+		sem_post(&fs_handle->dpi_eqt[i].deq_sem);
+
+	for (i = 0; i < fs_handle->dpi_eqt_started; i++)
+		pthread_join(fs_handle->dpi_eqt[i].deq_thread, NULL);
+
+	fs_handle->dpi_eqt_started = 0;
+}
+
 /* Parse a string to a time, used for reading container attributes info
  * timeouts.
  */
@@ -91,6 +163,11 @@ dfuse_parse_time(char *buff, size_t len, unsigned int *_out)
 
 /* Inode entry hash table operations */
 
+/* Initial number of buckets and number of bucket locks, as a power of two,
+ * in the inode hash table
+ */
+#define DFUSE_IE_HASH_BITS 14
+
 /* Shrink a 64 bit value into 32 bits to avoid hash collisions */
 static uint32_t
 ih_key_hash(struct d_hash_table *htable, const void *key,
@@ -355,6 +432,7 @@ static void
 _ch_free(struct dfuse_projection_info *fs_handle, struct dfuse_cont *dfc)
 {
 	D_MUTEX_DESTROY(&dfc->dfs_read_mutex);
+	D_MUTEX_DESTROY(&dfc->dfs_readdir_lock);
 
 	if (daos_handle_is_valid(dfc->dfs_coh)) {
 		int rc;
@@ -911,6 +989,7 @@ dfuse_cont_open(struct dfuse_projection_info *fs_handle, struct dfuse_pool *dfp,
 
 	dfc->dfs_ino = atomic_fetch_add_relaxed(&fs_handle->dpi_ino_next, 1);
 	D_MUTEX_INIT(&dfc->dfs_read_mutex, NULL);
+	D_MUTEX_INIT(&dfc->dfs_readdir_lock, NULL);
 
 	/* Take a reference on the pool */
 	d_hash_rec_addref(&fs_handle->dpi_pool_table, &dfp->dfp_entry);
@@ -952,6 +1031,7 @@ dfuse_fs_init(struct dfuse_info *dfuse_info,
 	      struct dfuse_projection_info **_fsh)
 {
 	struct dfuse_projection_info	*fs_handle;
+	int				i;
 	int				rc;
 
 	D_ALLOC_PTR(fs_handle);
@@ -968,28 +1048,58 @@ dfuse_fs_init(struct dfuse_info *dfuse_info,
 	if (rc != 0)
 		D_GOTO(err, rc);
 
-	rc = d_hash_table_create_inplace(D_HASH_FT_LRU | D_HASH_FT_EPHEMERAL,
-					 5, fs_handle, &ie_hops,
+	/* The inode table sees a lookup for every kernel lookup and a decref
+	 * for every forget, so let it grow with the working set and take only a
+	 * read lock on lookup.  The ie_ref count is atomic so this is safe for
+	 * addref, and the EPHEMERAL delete on the final decref still takes the
+	 * bucket lock exclusively.  LRU is not used as it needs the write lock
+	 * on every lookup and the chains are expected to be short.
+	 */
+	rc = d_hash_table_create_inplace(D_HASH_FT_RWLOCK | D_HASH_FT_EPHEMERAL |
+					 D_HASH_FT_RESIZE, DFUSE_IE_HASH_BITS,
+					 fs_handle, &ie_hops,
 					 &fs_handle->dpi_iet);
 	if (rc != 0)
 		D_GOTO(err_pt, rc);
 
 	atomic_store_relaxed(&fs_handle->dpi_ino_next, 2);
 
-	rc = daos_eq_create(&fs_handle->dpi_eq);
-	if (rc != -DER_SUCCESS)
-		D_GOTO(err_iht, rc);
+	fs_handle->dpi_eqt_count = dfuse_info->di_eq_count;
+	if (fs_handle->dpi_eqt_count == 0)
+		fs_handle->dpi_eqt_count = 1;
 
-	rc = sem_init(&fs_handle->dpi_sem, 0, 0);
-	if (rc != 0)
-		D_GOTO(err_eq, rc = daos_errno2der(errno));
+	D_ALLOC_ARRAY(fs_handle->dpi_eqt, fs_handle->dpi_eqt_count);
+	if (fs_handle->dpi_eqt == NULL)
+		D_GOTO(err_iht, rc = -DER_NOMEM);
+
+	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
+		struct dfuse_eq *eqt = &fs_handle->dpi_eqt[i];
+
+		eqt->deq_handle = fs_handle;
+		eqt->deq_idx = i;
+
+		rc = daos_eq_create(&eqt->deq_eq);
+		if (rc != -DER_SUCCESS)
+			D_GOTO(err_eq, rc);
+
+		rc = sem_init(&eqt->deq_sem, 0, 0);
+		if (rc != 0) {
+			rc = daos_errno2der(errno);
+			daos_eq_destroy(eqt->deq_eq, DAOS_EQ_DESTROY_FORCE);
+			D_GOTO(err_eq, rc);
+		}
+	}
 
 	fs_handle->dpi_shutdown = false;
 	*_fsh = fs_handle;
 	return rc;
 
 err_eq:
-	daos_eq_destroy(fs_handle->dpi_eq, DAOS_EQ_DESTROY_FORCE);
+	while (i-- > 0) {
+		sem_destroy(&fs_handle->dpi_eqt[i].deq_sem);
+		daos_eq_destroy(fs_handle->dpi_eqt[i].deq_eq, DAOS_EQ_DESTROY_FORCE);
+	}
+	D_FREE(fs_handle->dpi_eqt);
 err_iht:
 	d_hash_table_destroy_inplace(&fs_handle->dpi_iet, false);
 err_pt:
@@ -1012,6 +1122,8 @@ dfuse_ie_close(struct dfuse_projection_info *fs_handle,
 
 	D_ASSERT(ref == 0);
 
+	dfuse_readdir_invalidate(ie);
+
 	if (ie->ie_obj) {
 		rc = dfs_release(ie->ie_obj);
 		if (rc == ENOMEM)
@@ -1041,6 +1153,7 @@ dfuse_fs_start(struct dfuse_projection_info *fs_handle, struct dfuse_cont *dfs)
 {
 	struct fuse_args		args = {0};
 	struct dfuse_inode_entry	*ie = NULL;
+	int				i;
 	int				rc;
 
 	args.argc = 4;
@@ -1101,19 +1214,27 @@ dfuse_fs_start(struct dfuse_projection_info *fs_handle, struct dfuse_cont *dfs)
 			       false);
 	D_ASSERT(rc == -DER_SUCCESS);
 
-	rc = pthread_create(&fs_handle->dpi_thread, NULL,
-			    dfuse_progress_thread, fs_handle);
-	if (rc != 0)
-		D_GOTO(err_ie_remove, rc = daos_errno2der(rc));
+	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
+		struct dfuse_eq *eqt = &fs_handle->dpi_eqt[i];
 
-	pthread_setname_np(fs_handle->dpi_thread, "dfuse_progress");
+		rc = pthread_create(&eqt->deq_thread, NULL,
+				    dfuse_progress_thread, eqt);
+		if (rc != 0)
+			D_GOTO(err_threads, rc = daos_errno2der(rc));
+
+		fs_handle->dpi_eqt_started++;
+		pthread_setname_np(eqt->deq_thread, "dfuse_progress");
+		dfuse_eq_set_affinity(eqt);
+	}
 
 	rc = dfuse_launch_fuse(fs_handle, &args);
 	fuse_opt_free_args(&args);
 	if (rc == -DER_SUCCESS)
 		return rc;
 
-err_ie_remove:
+err_threads:
+	dfuse_eq_stop(fs_handle);
+	fs_handle->dpi_shutdown = false;
 	d_hash_rec_delete_at(&fs_handle->dpi_iet, &ie->ie_htl);
 err:
 	DFUSE_TRA_ERROR(fs_handle, "Failed to start dfuse, rc: "DF_RC, DP_RC(rc));
@@ -1225,12 +1346,7 @@ dfuse_fs_stop(struct dfuse_projection_info *fs_handle)
 
 	DFUSE_TRA_INFO(fs_handle, "Flushing inode table");
 
-	fs_handle->dpi_shutdown = true;
-	sem_post(&fs_handle->dpi_sem);
-
-	pthread_join(fs_handle->dpi_thread, NULL);
-
-	sem_destroy(&fs_handle->dpi_sem);
+	dfuse_eq_stop(fs_handle);
 
 	rc = d_hash_table_traverse(&fs_handle->dpi_iet, ino_flush, fs_handle);
 
@@ -1273,12 +1389,19 @@ dfuse_fs_stop(struct dfuse_projection_info *fs_handle)
 int
 dfuse_fs_fini(struct dfuse_projection_info *fs_handle)
 {
-	int	rc;
+	int	i;
+	int	rc = -DER_SUCCESS;
 	int	rc2 = -DER_SUCCESS;
 
-	rc = daos_eq_destroy(fs_handle->dpi_eq, 0);
-	if (rc)
-		DFUSE_TRA_WARNING(fs_handle, "Failed to destroy EQ");
+	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
+		rc2 = daos_eq_destroy(fs_handle->dpi_eqt[i].deq_eq, 0);
+		if (rc2) {
+			DFUSE_TRA_WARNING(fs_handle, "Failed to destroy EQ");
+			rc = rc2;
+		}
+		sem_destroy(&fs_handle->dpi_eqt[i].deq_sem);
+	}
+	D_FREE(fs_handle->dpi_eqt);
 
 	rc2 = d_hash_table_destroy_inplace(&fs_handle->dpi_iet, false);
 	if (rc2) {
@@ -53,6 +53,9 @@ dfuse_show_flags(void *handle, unsigned int in)
 		DFUSE_TRA_WARNING(handle, "Unknown flags %#x", in);
 }
 
+/* Largest read or write request to ask the kernel for */
+#define DFUSE_MAX_IO (1024 * 1024)
+
 /* Called on filesystem init.  It has the ability to both observe configuration
  * options, but also to modify them.  As we do not use the FUSE command line
  * parsing this is where we apply tunables.
@@ -86,8 +89,24 @@ dfuse_fuse_init(void *arg, struct fuse_conn_info *conn)
 	if (fs_handle->dpi_info->di_wb_cache)
 		conn->want |= FUSE_CAP_WRITEBACK_CACHE;
 
+	/* Lookups and creates in the same directory only contend on the inode
+	 * hash table, so the kernel can send them in parallel.
+	 */
+	if (fs_handle->dpi_info->di_parallel_dirops &&
+	    (conn->capable & FUSE_CAP_PARALLEL_DIROPS))
+		conn->want |= FUSE_CAP_PARALLEL_DIROPS;
+
 	dfuse_show_flags(fs_handle, conn->want);
 
+	/* Ask for large write requests, on kernels supporting it libfuse
+	 * derives max_pages from this, and clamps it to its buffer size.
+	 */
+	if (fs_handle->dpi_info->di_large_io) {
+		conn->max_write = DFUSE_MAX_IO;
+		DFUSE_TRA_INFO(fs_handle, "max write requested %#x",
+			       conn->max_write);
+	}
+
 	conn->max_background = 16;
 	conn->congestion_threshold = 8;
 
@@ -119,6 +138,7 @@ df_ll_create(fuse_req_t req, fuse_ino_t parent, const char *name,
 
 	parent_inode->ie_dfs->dfs_ops->create(req, parent_inode, name, mode,
 					      fi);
+	dfuse_readdir_invalidate(parent_inode);
 
 	d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
 	return;
@@ -148,6 +168,7 @@ df_ll_mknod(fuse_req_t req, fuse_ino_t parent, const char *name,
 		D_GOTO(err, rc = ENOTSUP);
 
 	parent_inode->ie_dfs->dfs_ops->mknod(req, parent_inode, name, mode);
+	dfuse_readdir_invalidate(parent_inode);
 
 	d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
 	return;
@@ -279,6 +300,7 @@ df_ll_mkdir(fuse_req_t req, fuse_ino_t parent, const char *name, mode_t mode)
 
 	parent_inode->ie_dfs->dfs_ops->mknod(req, parent_inode, name,
 					     mode | S_IFDIR);
+	dfuse_readdir_invalidate(parent_inode);
 
 	d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
 	return;
@@ -368,6 +390,7 @@ df_ll_unlink(fuse_req_t req, fuse_ino_t parent, const char *name)
 		D_GOTO(decref, rc = ENOTSUP);
 
 	parent_inode->ie_dfs->dfs_ops->unlink(req, parent_inode, name);
+	dfuse_readdir_invalidate(parent_inode);
 
 	d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
 	return;
@@ -432,6 +455,7 @@ df_ll_symlink(fuse_req_t req, const char *link, fuse_ino_t parent,
 		D_GOTO(decref, rc = ENOTSUP);
 
 	inode->ie_dfs->dfs_ops->symlink(req, link, inode, name);
+	dfuse_readdir_invalidate(inode);
 
 	d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
 	return;
@@ -613,6 +637,9 @@ df_ll_rename(fuse_req_t req, fuse_ino_t parent, const char *name,
 
 	parent_inode->ie_dfs->dfs_ops->rename(req, parent_inode, name,
 					      newparent_inode, newname, flags);
+	dfuse_readdir_invalidate(parent_inode);
+	if (newparent_inode)
+		dfuse_readdir_invalidate(newparent_inode);
 	if (newparent_inode)
 		d_hash_rec_decref(&fs_handle->dpi_iet, rlink2);
 
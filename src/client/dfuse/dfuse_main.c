@@ -235,11 +235,14 @@ show_help(char *name)
 		"\n"
 		"	-S --singlethread	Single threaded\n"
 		"	-t --thread-count=count	Number of fuse threads to use\n"
+		"	   --eq-count=count	Number of event queues/progress threads to use\n"
 		"	-f --foreground		Run in foreground\n"
 		"	   --enable-caching	Enable all caching (default)\n"
 		"	   --enable-wb-cache	Use write-back cache rather than write-through (default)\n"
 		"	   --disable-caching	Disable all caching\n"
 		"	   --disable-wb-cache	Use write-through rather than write-back cache\n"
+		"	   --enable-large-io	Request reads and writes of up to 1 MiB\n"
+		"	   --enable-parallel-dirops	Parallel directory operations\n"
 		"\n"
 		"	-h --help		Show this help\n"
 		"	-v --version		Show version\n"
@@ -256,6 +259,8 @@ show_help(char *name)
 		"this can be modified by running dfuse in a cpuset via numactl or similar tools.\n"
 		"One thread will be started for asynchronous I/O handling so at least two threads\n"
 		"must be specified in all cases.\n"
+		"On larger nodes one event queue and progress thread is started per 16 cores, each\n"
+		"pinned to the cores it serves.  These count towards the thread count.\n"
 		"Singlethreaded mode will use the libfuse loop to handle requests rather than the\n"
 		"threading logic in dfuse."
 		"\n"
@@ -271,6 +276,11 @@ show_help(char *name)
 		"given the data caching for the whole mount is performed in write-back mode and\n"
 		"the container attributes are still used\n"
 		"\n"
+		"By default the kernel sends I/O requests of up to 128 KiB and libfuse decides\n"
+		"whether operations in the same directory run in parallel.  --enable-large-io\n"
+		"raises the request size to 1 MiB on kernels that support it, and\n"
+		"--enable-parallel-dirops requests parallel directory operations explicitly.\n"
+		"\n"
 		"version: %s\n",
 		name, DAOS_VERSION);
 }
@@ -293,6 +303,7 @@ main(int argc, char **argv)
 	int			rc2;
 	char			*path = NULL;
 	bool			have_thread_count = false;
+	bool			have_eq_count = false;
 
 	struct option long_options[] = {
 		{"mountpoint",		required_argument, 0, 'm'},
@@ -302,11 +313,14 @@ main(int argc, char **argv)
 		{"sys-name",		required_argument, 0, 'G'},
 		{"singlethread",	no_argument,	   0, 'S'},
 		{"thread-count",	required_argument, 0, 't'},
+		{"eq-count",		required_argument, 0, 'Q'},
 		{"foreground",		no_argument,	   0, 'f'},
 		{"enable-caching",	no_argument,	   0, 'E'},
 		{"enable-wb-cache",	no_argument,	   0, 'F'},
 		{"disable-caching",	no_argument,	   0, 'A'},
 		{"disable-wb-cache",	no_argument,	   0, 'B'},
+		{"enable-large-io",	no_argument,	   0, 'L'},
+		{"enable-parallel-dirops", no_argument,	   0, 'D'},
 		{"version",		no_argument,	   0, 'v'},
 		{"help",		no_argument,	   0, 'h'},
 		{0, 0, 0, 0}
@@ -355,6 +369,12 @@ main(int argc, char **argv)
 		case 'B':
 			dfuse_info->di_wb_cache = false;
 			break;
+		case 'L':
+			dfuse_info->di_large_io = true;
+			break;
+		case 'D':
+			dfuse_info->di_parallel_dirops = true;
+			break;
 		case 'm':
 			dfuse_info->di_mountpoint = optarg;
 			break;
@@ -372,6 +392,10 @@ main(int argc, char **argv)
 			dfuse_info->di_thread_count = atoi(optarg);
 			have_thread_count = true;
 			break;
+		case 'Q':
+			dfuse_info->di_eq_count = atoi(optarg);
+			have_eq_count = true;
+			break;
 		case 'f':
 			dfuse_info->di_foreground = true;
 			break;
@@ -420,8 +444,23 @@ main(int argc, char **argv)
 		D_GOTO(out_debug, rc = -DER_INVAL);
 	}
 
-	/* Reserve one CPU thread for the daos event queue */
-	dfuse_info->di_thread_count -= 1;
+	if (!have_eq_count) {
+		if (dfuse_info->di_threaded)
+			dfuse_info->di_eq_count = dfuse_info->di_thread_count / 16;
+		else
+			dfuse_info->di_eq_count = 1;
+		if (dfuse_info->di_eq_count == 0)
+			dfuse_info->di_eq_count = 1;
+	}
+
+	if (dfuse_info->di_eq_count < 1 || dfuse_info->di_eq_count > DFUSE_EQ_MAX ||
+	    dfuse_info->di_eq_count >= dfuse_info->di_thread_count) {
+		printf("Invalid event queue count %u.\n", dfuse_info->di_eq_count);
+		D_GOTO(out_debug, rc = -DER_INVAL);
+	}
+
+	/* Reserve CPU threads for the daos event queues */
+	dfuse_info->di_thread_count -= dfuse_info->di_eq_count;
 
 	if (!dfuse_info->di_foreground) {
 		rc = dfuse_bg(dfuse_info);
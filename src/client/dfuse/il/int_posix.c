@@ -47,6 +47,8 @@ struct ioil_global {
 
 	bool		iog_show_summary;	/**< Should a summary be shown at teardown */
 
+	bool		iog_stdio;		/**< Should fopen() streams bypass the kernel */
+
 	unsigned	iog_report_count;	/**< Number of operations that should be logged */
 
 	uint64_t	iog_file_count;		/**< Number of file opens intercepted */
@@ -159,6 +161,8 @@ entry_array_close(void *arg) {
 	DFUSE_LOG_DEBUG("entry %p closing array fd_count %d",
 			entry, entry->fd_cont->ioc_open_count);
 
+	ioil_ra_fini(entry);
+
 	DFUSE_TRA_DOWN(entry->fd_dfsoh);
 	rc = dfs_release(entry->fd_dfsoh);
 	if (rc == ENOMEM)
@@ -317,6 +321,8 @@ ioil_init(void)
 		ioil_iog.iog_report_count = report_count;
 	}
 
+	d_getenv_bool("D_IL_STDIO", &ioil_iog.iog_stdio);
+
 	rc = ioil_initialize_fd_table(rlimit.rlim_max);
 	if (rc != 0) {
 		DFUSE_LOG_ERROR("Could not create fd_table, "
@@ -799,6 +805,10 @@ get_file:
 	else if (rc)
 		D_GOTO(shrink, rc);
 
+	/* Read-ahead is only safe where dfuse is caching data anyway */
+	if (!entry->fd_fstat)
+		ioil_ra_init(entry);
+
 	rc = vector_set(&fd_table, fd, entry);
 	if (rc != 0) {
 		DFUSE_LOG_DEBUG("Failed to track IOF file fd=%d., disabling kernel bypass", fd);
@@ -816,6 +826,7 @@ get_file:
 	return true;
 
 obj_close:
+	ioil_ra_fini(entry);
 	dfs_release(entry->fd_dfsoh);
 
 shrink:
@@ -1452,7 +1463,18 @@ dfuse_mmap(void *address, size_t length, int prot, int flags, int fd,
 	int rc;
 
 	rc = vector_get(&fd_table, fd, &entry);
-	if (rc == 0) {
+	if (rc == 0 && (entry->fd_flags & O_ACCMODE) == O_RDONLY) {
+		/* Neither the mapping nor the descriptor can modify the file,
+		 * so the kernel page cache behind the mapping and reads that
+		 * bypass it stay consistent; keep intercepting reads.
+		 */
+		DFUSE_LOG_DEBUG("mmap(address=%p, length=%zu, prot=%d, flags=%d,"
+				" fd=%d, offset=%zd) "
+				"intercepted, keeping kernel bypass ", address,
+				length, prot, flags, fd, offset);
+
+		vector_decref(&fd_table, entry);
+	} else if (rc == 0) {
 		DFUSE_LOG_DEBUG("mmap(address=%p, length=%zu, prot=%d, flags=%d,"
 				" fd=%d, offset=%zd) "
 				"intercepted, disabling kernel bypass ", address,
@@ -1469,6 +1491,32 @@ dfuse_mmap(void *address, size_t length, int prot, int flags, int fd,
 	return __real_mmap(address, length, prot, flags, fd, offset);
 }
 
+DFUSE_PUBLIC int
+dfuse_posix_fadvise(int fd, off_t offset, off_t len, int advice)
+{
+	struct fd_entry *entry;
+	int rc;
+
+	rc = vector_get(&fd_table, fd, &entry);
+	if (rc != 0)
+		goto do_real_fadvise;
+
+	DFUSE_LOG_DEBUG("posix_fadvise(fd=%d, offset=%zd, len=%zd, advice=%d) "
+			"intercepted, bypass=%s", fd, offset, len, advice,
+			bypass_status[entry->fd_status]);
+
+	if (drop_reference_if_disabled(entry))
+		goto do_real_fadvise;
+
+	ioil_do_fadvise(entry, offset, advice);
+
+	vector_decref(&fd_table, entry);
+
+do_real_fadvise:
+	/* Also let the kernel apply the advice to its own page cache */
+	return __real_posix_fadvise(fd, offset, len, advice);
+}
+
 DFUSE_PUBLIC int
 dfuse_fsync(int fd)
 {
@@ -1626,6 +1674,161 @@ dfuse_fcntl(int fd, int cmd, ...)
 	return newfd;
 }
 
+/* stdio buffer used if the chunk size of a file can't be queried */
+#define IOIL_STDIO_BUF_SIZE	(1024 * 1024)
+
+/* Cookie of a stream opened by ioil_fopen_stdio() */
+struct ioil_stdio {
+	int	 is_fd;
+	char	*is_buf;
+};
+
+static ssize_t
+ioil_stdio_read(void *cookie, char *buf, size_t size)
+{
+	struct ioil_stdio *is = cookie;
+
+	return dfuse_read(is->is_fd, buf, size);
+}
+
+static ssize_t
+ioil_stdio_write(void *cookie, const char *buf, size_t size)
+{
+	struct ioil_stdio	*is = cookie;
+	ssize_t			 rc;
+
+	rc = dfuse_write(is->is_fd, buf, size);
+	/* stdio expects 0 rather than -1 on write errors */
+	return rc < 0 ? 0 : rc;
+}
+
+static int
+ioil_stdio_seek(void *cookie, off64_t *offset, int whence)
+{
+	struct ioil_stdio	*is = cookie;
+	off_t			 pos;
+
+	pos = dfuse_lseek(is->is_fd, *offset, whence);
+	if (pos < 0)
+		return -1;
+
+	*offset = pos;
+	return 0;
+}
+
+static int
+ioil_stdio_close(void *cookie)
+{
+	struct ioil_stdio	*is = cookie;
+	int			 rc;
+
+	rc = dfuse_close(is->is_fd);
+	D_FREE(is->is_buf);
+	D_FREE(is);
+	return rc;
+}
+
+static cookie_io_functions_t ioil_stdio_funcs = {
+	.read	= ioil_stdio_read,
+	.write	= ioil_stdio_write,
+	.seek	= ioil_stdio_seek,
+	.close	= ioil_stdio_close,
+};
+
+/* Open flags matching an fopen() mode, or -1 if the mode isn't handled */
+static int
+ioil_stdio_flags(const char *mode)
+{
+	int flags;
+
+	switch (mode[0]) {
+	case 'r':
+		flags = 0;
+		break;
+	case 'w':
+		flags = O_CREAT | O_TRUNC;
+		break;
+	default:
+		/* Appending streams can't bypass the kernel, see dfuse_open() */
+		return -1;
+	}
+
+	for (mode++; *mode != '\0' && *mode != ','; mode++) {
+		if (*mode == '+')
+			flags |= O_RDWR;
+		else if (*mode == 'x')
+			flags |= O_EXCL;
+		else if (*mode == 'e')
+			flags |= O_CLOEXEC;
+	}
+
+	if ((flags & O_RDWR) == 0 && (flags & O_CREAT))
+		flags |= O_WRONLY;
+
+	return flags;
+}
+
+/*
+ * Open a stream with the kernel bypassed, stdio buffers are sized to the file
+ * chunk size and flushed through the intercepted read/write calls, so each
+ * buffer refill or flush is a single chunk sized DFS I/O.
+ *
+ * Such streams have no file descriptor as far as fileno() is concerned, so
+ * this is only used if D_IL_STDIO is set. Return NULL with \a fd set to -1 if
+ * the file couldn't be opened, or with \a fd set if it was opened but the
+ * interception isn't possible, the caller should then use a regular stream.
+ */
+static FILE *
+ioil_fopen_stdio(const char *path, const char *mode, int *fd)
+{
+	struct fd_entry		 entry = {0};
+	struct ioil_stdio	*is;
+	daos_size_t		 bufsize = IOIL_STDIO_BUF_SIZE;
+	FILE			*fp;
+	int			 flags;
+	int			 rc;
+
+	flags = ioil_stdio_flags(mode);
+	*fd = __real_open(path, flags, 0666);
+	if (*fd == -1)
+		return NULL;
+
+	if (!check_ioctl_on_open(*fd, &entry, flags, DFUSE_IO_BYPASS))
+		return NULL;
+
+	rc = dfs_get_chunk_size(entry.fd_dfsoh, &bufsize);
+	if (rc != 0 || bufsize == 0)
+		bufsize = IOIL_STDIO_BUF_SIZE;
+
+	D_ALLOC_PTR(is);
+	if (is == NULL)
+		goto err;
+
+	D_ALLOC(is->is_buf, bufsize);
+	if (is->is_buf == NULL)
+		goto err_free;
+
+	is->is_fd = *fd;
+	fp = fopencookie(is, mode, ioil_stdio_funcs);
+	if (fp == NULL)
+		goto err_free;
+
+	if (setvbuf(fp, is->is_buf, _IOFBF, bufsize) != 0)
+		DFUSE_LOG_DEBUG("setvbuf(%p, %zu) failed", fp, (size_t)bufsize);
+
+	atomic_fetch_add_relaxed(&ioil_iog.iog_file_count, 1);
+
+	DFUSE_LOG_DEBUG("fopen(path=%s, mode=%s) = %p(fd=%d) intercepted, buffer=%zu",
+			path, mode, fp, *fd, (size_t)bufsize);
+	return fp;
+
+err_free:
+	D_FREE(is->is_buf);
+	D_FREE(is);
+err:
+	return NULL;
+}
+
 DFUSE_PUBLIC FILE *
 dfuse_fopen(const char *path, const char *mode)
 {
@@ -1635,6 +1838,21 @@ dfuse_fopen(const char *path, const char *mode)
 
 	pthread_once(&init_links_flag, init_links);
 
+	if (ioil_iog.iog_initialized && ioil_iog.iog_stdio &&
+	    ioil_stdio_flags(mode) != -1 && dfuse_check_valid_path(path)) {
+		fp = ioil_fopen_stdio(path, mode, &fd);
+		if (fp != NULL || fd == -1)
+			return fp;
+
+		/* Opened but not intercepted, use a regular stream, dfuse_fdopen()
+		 * disables kernel bypass if the fd was added to the table.
+		 */
+		fp = dfuse_fdopen(fd, mode);
+		if (fp == NULL)
+			dfuse_close(fd);
+		return fp;
+	}
+
 	fp = __real_fopen(path, mode);
 
 	if (!ioil_iog.iog_initialized || fp == NULL)
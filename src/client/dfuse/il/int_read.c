@@ -5,6 +5,7 @@
  */
 
 #define D_LOGFAC DD_FAC(il)
+#include <fcntl.h>
 #include "dfuse_common.h"
 #include "intercept.h"
 #include "daos.h"
@@ -37,9 +38,299 @@ read_bulk(char *buff, size_t len, off_t position,
 	return read_size;
 }
 
+/* Read-ahead.
+ *
+ * Once a file descriptor has seen a few small reads each starting where the
+ * previous one ended, keep up to IOIL_RA_SLOTS windows of IOIL_RA_SIZE ahead of
+ * the reader, each one filled by an asynchronous dfs_read().  Reads are then
+ * served from memory, waiting on the window if its fetch is still in flight.
+ * This is only enabled for files where dfuse is caching data, as the windows
+ * are not kept coherent with other writers, and any write through the same
+ * file discards them.
+ */
+
+/* Wait for the fetch into a window to complete. */
+static void
+ra_slot_wait(struct ioil_ra_slot *rs)
+{
+	bool	flag;
+	int	rc;
+
+	if (!rs->rs_inflight)
+		return;
+
+	rc = daos_event_test(&rs->rs_ev, DAOS_EQ_WAIT, &flag);
+	if (rc == 0)
+		rc = rs->rs_ev.ev_error;
+	daos_event_fini(&rs->rs_ev);
+
+	rs->rs_inflight = false;
+	rs->rs_valid = (rc == 0);
+	if (rc != 0)
+		DFUSE_LOG_DEBUG("read-ahead of %#zx failed: %d", rs->rs_pos, rc);
+}
+
+/* Find the window that holds, or will hold, data at pos. */
+static struct ioil_ra_slot *
+ra_slot_find(struct ioil_ra *ra, off_t pos)
+{
+	int i;
+
+	for (i = 0; i < IOIL_RA_SLOTS; i++) {
+		struct ioil_ra_slot	*rs = &ra->ra_slots[i];
+		daos_size_t		len;
+
+		if (rs->rs_inflight)
+			len = IOIL_RA_SIZE;
+		else if (rs->rs_valid)
+			len = rs->rs_len;
+		else
+			continue;
+
+		if (pos >= rs->rs_pos && pos < rs->rs_pos + len)
+			return rs;
+	}
+	return NULL;
+}
+
+static void
+ra_slot_launch(struct fd_entry *entry, struct ioil_ra_slot *rs, off_t pos)
+{
+	int rc;
+
+	if (rs->rs_buf == NULL) {
+		D_ALLOC(rs->rs_buf, IOIL_RA_SIZE);
+		if (rs->rs_buf == NULL)
+			return;
+	}
+
+	rc = daos_event_init(&rs->rs_ev, DAOS_HDL_INVAL, NULL);
+	if (rc != -DER_SUCCESS)
+		return;
+
+	rs->rs_pos = pos;
+	rs->rs_len = 0;
+	rs->rs_valid = false;
+	d_iov_set(&rs->rs_iov, rs->rs_buf, IOIL_RA_SIZE);
+	rs->rs_sgl.sg_nr = 1;
+	rs->rs_sgl.sg_nr_out = 0;
+	rs->rs_sgl.sg_iovs = &rs->rs_iov;
+
+	rc = dfs_read(entry->fd_cont->ioc_dfs, entry->fd_dfsoh, &rs->rs_sgl,
+		      pos, &rs->rs_len, &rs->rs_ev);
+	if (rc == 0 || daos_event_fini(&rs->rs_ev) == -DER_BUSY)
+		rs->rs_inflight = true;
+
+	DFUSE_TRA_DEBUG(entry->fd_dfsoh, "read-ahead %#zx-%#zx rc %d",
+			pos, pos + IOIL_RA_SIZE - 1, rc);
+}
+
+/* Make sure the windows following start are populated, re-using any that the
+ * reader has moved past.
+ */
+static void
+ra_prefetch(struct fd_entry *entry, struct ioil_ra *ra, off_t start)
+{
+	struct ioil_ra_slot	*rs;
+	off_t			next = start;
+	int			n;
+	int			i;
+
+	for (n = 0; n < IOIL_RA_SLOTS; n++) {
+		rs = ra_slot_find(ra, next);
+		if (rs != NULL) {
+			/* A short window is the end of the file */
+			if (!rs->rs_inflight && rs->rs_len < IOIL_RA_SIZE)
+				return;
+			next = rs->rs_pos + IOIL_RA_SIZE;
+			continue;
+		}
+
+		for (i = 0; i < IOIL_RA_SLOTS; i++) {
+			rs = &ra->ra_slots[i];
+
+			if (rs->rs_inflight)
+				continue;
+			/* Do not read past a window that ended at end of file */
+			if (rs->rs_valid && rs->rs_len < IOIL_RA_SIZE &&
+			    rs->rs_pos + rs->rs_len == next)
+				return;
+			if (!rs->rs_valid || rs->rs_pos + rs->rs_len <= start)
+				break;
+		}
+		if (i == IOIL_RA_SLOTS)
+			return;
+
+		ra_slot_launch(entry, rs, next);
+		if (!rs->rs_inflight)
+			return;
+		next += IOIL_RA_SIZE;
+	}
+}
+
+/* Access pattern the application advised with posix_fadvise(). */
+static dfs_hint_t
+ra_hint(struct fd_entry *entry)
+{
+	dfs_hint_t	hint;
+
+	if (dfs_obj_get_hint(entry->fd_dfsoh, &hint) != 0)
+		return DFS_HINT_NORMAL;
+	return hint;
+}
+
+static ssize_t
+ra_read(char *buff, size_t len, off_t position, struct fd_entry *entry,
+	int *errcode)
+{
+	struct ioil_ra		*ra = entry->fd_ra;
+	struct ioil_ra_slot	*rs;
+	size_t			done = 0;
+	size_t			count;
+	off_t			pos;
+	ssize_t			rc;
+
+	D_MUTEX_LOCK(&ra->ra_lock);
+
+	if (position == ra->ra_next)
+		ra->ra_seq++;
+	else
+		ra->ra_seq = 0;
+	ra->ra_next = position + len;
+
+	while (done < len) {
+		pos = position + done;
+
+		rs = ra_slot_find(ra, pos);
+		if (rs == NULL)
+			break;
+
+		ra_slot_wait(rs);
+		if (!rs->rs_valid || pos >= rs->rs_pos + rs->rs_len)
+			break;
+
+		count = min(len - done, rs->rs_pos + rs->rs_len - pos);
+		memcpy(buff + done, rs->rs_buf + (pos - rs->rs_pos), count);
+		done += count;
+	}
+
+	if (done < len) {
+		rc = read_bulk(buff + done, len - done, position + done, entry,
+			       errcode);
+		if (rc < 0 && done == 0) {
+			D_MUTEX_UNLOCK(&ra->ra_lock);
+			return rc;
+		}
+		if (rc > 0)
+			done += rc;
+	}
+
+	if (ra->ra_seq >= 2 || ra_hint(entry) == DFS_HINT_SEQUENTIAL)
+		ra_prefetch(entry, ra, position + len);
+
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+
+	return done;
+}
+
+void
+ioil_ra_init(struct fd_entry *entry)
+{
+	struct ioil_ra	*ra;
+	int		rc;
+
+	D_ALLOC_PTR(ra);
+	if (ra == NULL)
+		return;
+
+	rc = D_MUTEX_INIT(&ra->ra_lock, NULL);
+	if (rc != -DER_SUCCESS) {
+		D_FREE(ra);
+		return;
+	}
+
+	entry->fd_ra = ra;
+}
+
+void
+ioil_ra_invalidate(struct fd_entry *entry)
+{
+	struct ioil_ra	*ra = entry->fd_ra;
+	int		i;
+
+	if (ra == NULL)
+		return;
+
+	D_MUTEX_LOCK(&ra->ra_lock);
+	for (i = 0; i < IOIL_RA_SLOTS; i++) {
+		ra_slot_wait(&ra->ra_slots[i]);
+		ra->ra_slots[i].rs_valid = false;
+	}
+	ra->ra_seq = 0;
+	D_MUTEX_UNLOCK(&ra->ra_lock);
+}
+
+void
+ioil_ra_fini(struct fd_entry *entry)
+{
+	struct ioil_ra	*ra = entry->fd_ra;
+	int		i;
+
+	if (ra == NULL)
+		return;
+
+	ioil_ra_invalidate(entry);
+
+	for (i = 0; i < IOIL_RA_SLOTS; i++)
+		D_FREE(ra->ra_slots[i].rs_buf);
+
+	D_MUTEX_DESTROY(&ra->ra_lock);
+	D_FREE(ra);
+	entry->fd_ra = NULL;
+}
+
+/* Apply posix_fadvise() advice to the read-ahead of a file.  The access pattern
+ * is recorded on the DFS object, WILLNEED starts the fetch of the windows at
+ * offset, which also warms the engine read cache, and DONTNEED drops them.
+ */
+void
+ioil_do_fadvise(struct fd_entry *entry, off_t offset, int advice)
+{
+	struct ioil_ra	*ra = entry->fd_ra;
+
+	switch (advice) {
+	case POSIX_FADV_NORMAL:
+		dfs_obj_set_hint(entry->fd_dfsoh, DFS_HINT_NORMAL);
+		break;
+	case POSIX_FADV_SEQUENTIAL:
+		dfs_obj_set_hint(entry->fd_dfsoh, DFS_HINT_SEQUENTIAL);
+		break;
+	case POSIX_FADV_RANDOM:
+		dfs_obj_set_hint(entry->fd_dfsoh, DFS_HINT_RANDOM);
+		ioil_ra_invalidate(entry);
+		break;
+	case POSIX_FADV_WILLNEED:
+		if (ra == NULL || ra_hint(entry) == DFS_HINT_RANDOM)
+			break;
+		D_MUTEX_LOCK(&ra->ra_lock);
+		ra_prefetch(entry, ra, offset);
+		D_MUTEX_UNLOCK(&ra->ra_lock);
+		break;
+	case POSIX_FADV_DONTNEED:
+		ioil_ra_invalidate(entry);
+		break;
+	default:
+		break;
+	}
+}
+
 ssize_t ioil_do_pread(char *buff, size_t len, off_t position,
 		      struct fd_entry *entry, int *errcode)
 {
+	if (entry->fd_ra != NULL && len <= IOIL_RA_MAX_IO &&
+	    ra_hint(entry) != DFS_HINT_RANDOM)
+		return ra_read(buff, len, position, entry, errcode);
+
 	return read_bulk(buff, len, position, entry, errcode);
 }
 
@@ -23,6 +23,8 @@ ioil_do_writex(const char *buff, size_t len, off_t position,
 	DFUSE_TRA_DEBUG(entry->fd_dfsoh, "%#zx-%#zx",
 			position, position + len - 1);
 
+	ioil_ra_invalidate(entry);
+
 	sgl.sg_nr = 1;
 	d_iov_set(&iov, (void *)buff, len);
 	sgl.sg_iovs = &iov;
@@ -10,6 +10,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <pthread.h>
 
 #include "daos_fs.h"
 
@@ -28,6 +29,33 @@ struct ioil_cont {
 	int		ioc_open_count;
 };
 
+/* Read-ahead window size, and number of windows kept per file */
+#define IOIL_RA_SIZE	(1024 * 1024)
+#define IOIL_RA_SLOTS	2
+/* Only reads up to this size are served through read-ahead */
+#define IOIL_RA_MAX_IO	(IOIL_RA_SIZE / 4)
+
+struct ioil_ra_slot {
+	char			*rs_buf;
+	off_t			rs_pos;
+	daos_size_t		rs_len;
+	daos_event_t		rs_ev;
+	d_iov_t			rs_iov;
+	d_sg_list_t		rs_sgl;
+	bool			rs_inflight;
+	bool			rs_valid;
+};
+
+/* Per-file read-ahead state, shared by all dup()ed descriptors */
+struct ioil_ra {
+	pthread_mutex_t		ra_lock;
+	/* Offset a sequential reader is expected to read next */
+	off_t			ra_next;
+	/* Number of consecutive sequential reads seen */
+	int			ra_seq;
+	struct ioil_ra_slot	ra_slots[IOIL_RA_SLOTS];
+};
+
 struct fd_entry {
 	struct ioil_cont	*fd_cont;
 	dfs_obj_t		*fd_dfsoh;
@@ -37,8 +65,19 @@ struct fd_entry {
 	int			fd_ino;
 	int			fd_dev;
 	bool			fd_fstat;
+	/* Read-ahead state, NULL if not in use for this file */
+	struct ioil_ra		*fd_ra;
 };
 
+void
+ioil_ra_init(struct fd_entry *entry);
+void
+ioil_ra_fini(struct fd_entry *entry);
+void
+ioil_ra_invalidate(struct fd_entry *entry);
+void
+ioil_do_fadvise(struct fd_entry *entry, off_t offset, int advice);
+
 ssize_t
 ioil_do_pread(char *buff, size_t len, off_t position,
 	      struct fd_entry *entry, int *errcode);
@@ -22,6 +22,7 @@ DFUSE_PUBLIC off_t dfuse_lseek(int, off_t, int);
 DFUSE_PUBLIC ssize_t dfuse_preadv(int, const struct iovec *, int, off_t);
 DFUSE_PUBLIC ssize_t dfuse_pwritev(int, const struct iovec *, int, off_t);
 DFUSE_PUBLIC void *dfuse_mmap(void *, size_t, int, int, int, off_t);
+DFUSE_PUBLIC int dfuse_posix_fadvise(int, off_t, off_t, int);
 DFUSE_PUBLIC int dfuse_close(int);
 DFUSE_PUBLIC ssize_t dfuse_read(int, void *, size_t);
 DFUSE_PUBLIC ssize_t dfuse_write(int, const void *, size_t);
@@ -8,6 +8,72 @@
 #include "dfuse.h"
 
 #define READAHEAD_SIZE (1024 * 1024)
+#define READAHEAD_MAX_SIZE (4 * 1024 * 1024)
+
+/* Push data read past the requested range into the kernel page cache */
+static void
+dfuse_readahead_store(struct dfuse_projection_info *fs_handle,
+		      struct dfuse_obj_hdl *oh, off_t position, void *buff,
+		      size_t len)
+{
+	struct fuse_bufvec	fb = {};
+	int			rc;
+
+	rc = pthread_mutex_trylock(&oh->doh_ie->ie_dfs->dfs_read_mutex);
+	if (rc != 0)
+		return;
+
+	fb.count = 1;
+	fb.buf[0].mem = buff;
+	fb.buf[0].size = len;
+
+	DFUSE_TRA_INFO(oh, "%#zx-%#zx was readahead",
+		       position, position + len - 1);
+
+	rc = fuse_lowlevel_notify_store(fs_handle->dpi_info->di_session,
+					oh->doh_ie->ie_stat.st_ino, position,
+					&fb, 0);
+	if (rc == 0)
+		DFUSE_TRA_DEBUG(oh, "notify_store returned %d", rc);
+	else
+		DFUSE_TRA_INFO(oh, "notify_store returned %d", rc);
+	rc = pthread_mutex_unlock(&oh->doh_ie->ie_dfs->dfs_read_mutex);
+	if (rc != 0)
+		DFUSE_TRA_ERROR(oh, "Mutex unlock failed");
+}
+
+/* Completion of a read which also fetched readahead data */
+static void
+dfuse_cb_read_ra_complete(struct dfuse_event *ev)
+{
+	struct dfuse_projection_info	*fs_handle;
+	size_t				 len = ev->de_req_len;
+
+	if (ev->de_ev.ev_error != 0) {
+		DFUSE_REPLY_ERR_RAW(ev, ev->de_req, ev->de_ev.ev_error);
+		D_GOTO(out, 0);
+	}
+
+	if (ev->de_len <= len) {
+		if (ev->de_len == 0)
+			DFUSE_TRA_DEBUG(ev, "Truncated read, (EOF)");
+		else if (ev->de_len != len)
+			DFUSE_TRA_DEBUG(ev,
+					"Truncated read, requested %#zx returned %#zx",
+					len, ev->de_len);
+		DFUSE_REPLY_BUF(ev, ev->de_req, ev->de_iov.iov_buf,
+				ev->de_len);
+		D_GOTO(out, 0);
+	}
+
+	fs_handle = fuse_req_userdata(ev->de_req);
+	dfuse_readahead_store(fs_handle, ev->de_oh, ev->de_req_position + len,
+			      ev->de_iov.iov_buf + len, ev->de_len - len);
+
+	DFUSE_REPLY_BUF(ev, ev->de_req, ev->de_iov.iov_buf, len);
+out:
+	D_FREE(ev->de_iov.iov_buf);
+}
 
 static void
 dfuse_cb_read_complete(struct dfuse_event *ev)
@@ -36,14 +102,15 @@ dfuse_cb_read(fuse_req_t req, fuse_ino_t ino, size_t len, off_t position,
 	struct dfuse_obj_hdl		*oh = (struct dfuse_obj_hdl *)fi->fh;
 	struct dfuse_projection_info	*fs_handle = fuse_req_userdata(req);
 	const struct fuse_ctx		*fc = fuse_req_ctx(req);
-	struct fuse_bufvec		fb = {};
 	void				*buff;
 	int				rc;
 	size_t				buff_len = len;
 	bool				skip_read = false;
 	bool				readahead = false;
 	bool				async = false;
+	size_t				ra_len = READAHEAD_SIZE;
 	struct dfuse_event		*ev = NULL;
+	struct dfuse_eq			*eqt;
 
 	D_ALLOC_PTR(ev);
 	if (ev == NULL)
@@ -76,25 +143,42 @@ dfuse_cb_read(fuse_req_t req, fuse_ino_t ino, size_t len, off_t position,
 		len < (1024 * 1024) &&
 		oh->doh_ie->ie_stat.st_size > (1024 * 1024)) {
 		/* Only do readahead if the requested size is less than 1Mb and
-		 * the file size is > 1Mb
+		 * the file size is > 1Mb, and the handle is read sequentially.
+		 * The window doubles for every sequential read up to
+		 * READAHEAD_MAX_SIZE and is reset on a random read.
 		 */
-
-		readahead = true;
+		if (position == 0 || position == oh->doh_ra_next) {
+			if (oh->doh_ra_len == 0)
+				oh->doh_ra_len = READAHEAD_SIZE;
+			else if (oh->doh_ra_len < READAHEAD_MAX_SIZE)
+				oh->doh_ra_len *= 2;
+			ra_len = oh->doh_ra_len;
+			readahead = true;
+		} else {
+			oh->doh_ra_len = 0;
+		}
 	}
 
-	if (readahead) {
-		buff_len += READAHEAD_SIZE;
-	} else {
-		if (!skip_read) {
-			rc = daos_event_init(&ev->de_ev,
-					     fs_handle->dpi_eq, NULL);
-			if (rc != -DER_SUCCESS)
-				D_GOTO(err, rc = daos_der2errno(rc));
-
-			ev->de_req = req;
+	if (readahead)
+		buff_len += ra_len;
+	oh->doh_ra_next = position + buff_len;
+
+	if (!skip_read) {
+		eqt = dfuse_eq_get(fs_handle);
+		rc = daos_event_init(&ev->de_ev, eqt->deq_eq, NULL);
+		if (rc != -DER_SUCCESS)
+			D_GOTO(err, rc = daos_der2errno(rc));
+
+		ev->de_req = req;
+		if (readahead) {
+			ev->de_oh = oh;
+			ev->de_req_position = position;
+			ev->de_req_len = len;
+			ev->de_complete_cb = dfuse_cb_read_ra_complete;
+		} else {
 			ev->de_complete_cb = dfuse_cb_read_complete;
-			async = true;
 		}
+		async = true;
 	}
 
 	D_ALLOC(buff, buff_len);
@@ -122,7 +206,7 @@ dfuse_cb_read(fuse_req_t req, fuse_ino_t ino, size_t len, off_t position,
 		/* Send a message to the async thread to wake it up and poll
 		 * for events
 		 */
-		sem_post(&fs_handle->dpi_sem);
+		sem_post(&eqt->deq_sem);
 		return;
 	}
 
@@ -139,25 +223,8 @@ dfuse_cb_read(fuse_req_t req, fuse_ino_t ino, size_t len, off_t position,
 		return;
 	}
 
-	rc = pthread_mutex_trylock(&oh->doh_ie->ie_dfs->dfs_read_mutex);
-	if (rc == 0) {
-		fb.count = 1;
-		fb.buf[0].mem = buff + len;
-		fb.buf[0].size = ev->de_len - len;
-
-		DFUSE_TRA_INFO(oh, "%#zx-%#zx was readahead",
-			       position + len, position + ev->de_len - 1);
-
-		rc = fuse_lowlevel_notify_store(fs_handle->dpi_info->di_session,
-						ino, position + len, &fb, 0);
-		if (rc == 0)
-			DFUSE_TRA_DEBUG(oh, "notify_store returned %d", rc);
-		else
-			DFUSE_TRA_INFO(oh, "notify_store returned %d", rc);
-		rc = pthread_mutex_unlock(&oh->doh_ie->ie_dfs->dfs_read_mutex);
-		if (rc != 0)
-			DFUSE_TRA_ERROR(oh, "Mutex unlock failed");
-	}
+	dfuse_readahead_store(fs_handle, oh, position + len, buff + len,
+			      ev->de_len - len);
 
 	DFUSE_REPLY_BUF(oh, req, buff, len);
 	D_FREE(buff);
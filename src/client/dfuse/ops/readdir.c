@@ -23,6 +23,11 @@
 /* Offset of the first file, allow two entries for . and .. */
 #define OFFSET_BASE 2
 
+/* Maximum number of names cached per directory, readers past that point
+ * enumerate the directory from their own handle.
+ */
+#define READDIR_CACHE_MAX (64 * 1024)
+
 struct iterate_data {
 	off_t			id_base_offset;
 	int			id_index;
@@ -45,6 +50,7 @@ filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *arg)
 	strncpy(dre->dre_name, name, NAME_MAX);
 	dre->dre_offset = idata->id_base_offset + idata->id_index;
 	dre->dre_next_offset = idata->id_base_offset + idata->id_index + 1;
+	dre->dre_valid = false;
 	idata->id_index++;
 
 	return 0;
@@ -83,6 +89,257 @@ fetch_dir_entries(struct dfuse_obj_hdl *oh, off_t offset, int to_fetch,
 	return rc;
 }
 
+/* Free a generation of the entry cache once the last reference is dropped */
+static void
+readdir_cache_put(struct dfuse_cont *dfc, struct dfuse_readdir_cache *cache)
+{
+	uint32_t	i;
+	bool		last;
+
+	if (cache == NULL)
+		return;
+
+	D_MUTEX_LOCK(&dfc->dfs_readdir_lock);
+	last = (--cache->drc_ref == 0);
+	D_MUTEX_UNLOCK(&dfc->dfs_readdir_lock);
+	if (!last)
+		return;
+
+	for (i = 0; i < cache->drc_nr; i++)
+		D_FREE(cache->drc_names[i]);
+	D_FREE(cache->drc_names);
+	D_MUTEX_DESTROY(&cache->drc_lock);
+	D_FREE(cache);
+}
+
+/* Take a reference on the current generation of the entry cache of a
+ * directory, starting a new generation on first use or once the current one
+ * has expired.  Returns NULL if directory entries are not cached for this
+ * container.
+ */
+static struct dfuse_readdir_cache *
+readdir_cache_get(struct dfuse_inode_entry *ie)
+{
+	struct dfuse_cont		*dfc = ie->ie_dfs;
+	struct dfuse_readdir_cache	*cache;
+	struct dfuse_readdir_cache	*old = NULL;
+
+	if (dfc->dfc_dentry_dir_timeout <= 0)
+		return NULL;
+
+	D_MUTEX_LOCK(&dfc->dfs_readdir_lock);
+	cache = ie->ie_readdir;
+	if (cache != NULL && daos_gettime_coarse() < cache->drc_expire) {
+		cache->drc_ref++;
+		goto out;
+	}
+
+	old = cache;
+	ie->ie_readdir = NULL;
+
+	D_ALLOC_PTR(cache);
+	if (cache == NULL)
+		goto out;
+
+	if (D_MUTEX_INIT(&cache->drc_lock, NULL) != 0) {
+		D_FREE(cache);
+		goto out;
+	}
+	cache->drc_expire = daos_gettime_coarse() + dfc->dfc_dentry_dir_timeout;
+	/* One reference for the inode and one for the caller */
+	cache->drc_ref = 2;
+	ie->ie_readdir = cache;
+out:
+	D_MUTEX_UNLOCK(&dfc->dfs_readdir_lock);
+	readdir_cache_put(dfc, old);
+	return cache;
+}
+
+void
+dfuse_readdir_invalidate(struct dfuse_inode_entry *ie)
+{
+	struct dfuse_cont		*dfc = ie->ie_dfs;
+	struct dfuse_readdir_cache	*cache;
+
+	D_MUTEX_LOCK(&dfc->dfs_readdir_lock);
+	cache = ie->ie_readdir;
+	ie->ie_readdir = NULL;
+	D_MUTEX_UNLOCK(&dfc->dfs_readdir_lock);
+
+	readdir_cache_put(dfc, cache);
+}
+
+void
+dfuse_readdir_release(struct dfuse_obj_hdl *oh)
+{
+	readdir_cache_put(oh->doh_ie->ie_dfs, oh->doh_readdir);
+	oh->doh_readdir = NULL;
+}
+
+static int
+cache_filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *arg)
+{
+	struct dfuse_readdir_cache *cache = arg;
+
+	D_STRNDUP(cache->drc_names[cache->drc_nr], name, NAME_MAX);
+	if (cache->drc_names[cache->drc_nr] == NULL)
+		return ENOMEM;
+	cache->drc_nr++;
+
+	return 0;
+}
+
+/* Enumerate the directory into the cache until it holds at least nr names,
+ * a full batch at a time so that the following readers find the next names
+ * already there.  Called with the cache lock held.
+ */
+static int
+readdir_cache_fill(struct dfuse_obj_hdl *oh, struct dfuse_readdir_cache *cache,
+		   uint32_t nr)
+{
+	daos_anchor_t	anchor;
+	uint32_t	count;
+	uint32_t	start;
+	int		rc;
+
+	while (!cache->drc_eod && cache->drc_nr < nr) {
+		count = min(READDIR_MAX_COUNT, READDIR_CACHE_MAX - cache->drc_nr);
+		if (count == 0)
+			break;
+
+		if (cache->drc_nr + count > cache->drc_alloc) {
+			char		**names;
+			uint32_t	alloc;
+
+			alloc = min(max(cache->drc_alloc * 2, cache->drc_nr + count),
+				    READDIR_CACHE_MAX);
+			D_REALLOC_ARRAY(names, cache->drc_names, cache->drc_alloc, alloc);
+			if (names == NULL)
+				return ENOMEM;
+			cache->drc_names = names;
+			cache->drc_alloc = alloc;
+		}
+
+		/* Other handles may be reading the cached names, so on failure
+		 * only drop the names of this batch.
+		 */
+		anchor = cache->drc_anchor;
+		start = cache->drc_nr;
+		rc = dfs_iterate(oh->doh_dfs, oh->doh_obj, &cache->drc_anchor, &count,
+				 (NAME_MAX + 1) * count, cache_filler_cb, cache);
+		if (rc != 0) {
+			while (cache->drc_nr > start)
+				D_FREE(cache->drc_names[--cache->drc_nr]);
+			cache->drc_anchor = anchor;
+			return rc;
+		}
+
+		if (daos_anchor_is_eof(&cache->drc_anchor))
+			cache->drc_eod = true;
+	}
+
+	DFUSE_TRA_DEBUG(oh, "Cached %d entries eod %d", cache->drc_nr, cache->drc_eod);
+
+	return 0;
+}
+
+/* Copy up to to_fetch cached names from offset into the handle, enumerating
+ * them first if needed.  Sets cached to false if offset is past the names the
+ * cache can hold.
+ */
+static int
+fetch_cached_entries(struct dfuse_obj_hdl *oh, struct dfuse_readdir_cache *cache,
+		     off_t offset, uint32_t to_fetch, bool *eod, bool *cached)
+{
+	uint32_t	index = offset - OFFSET_BASE;
+	uint32_t	count = 0;
+	uint32_t	i;
+	int		rc;
+
+	D_MUTEX_LOCK(&cache->drc_lock);
+
+	rc = readdir_cache_fill(oh, cache, index + to_fetch);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	if (index < cache->drc_nr)
+		count = min(cache->drc_nr - index, to_fetch);
+
+	if (count == 0) {
+		if (cache->drc_eod)
+			*eod = true;
+		else
+			*cached = false;
+		D_GOTO(out, rc = 0);
+	}
+
+	for (i = 0; i < count; i++) {
+		struct dfuse_readdir_entry *dre = &oh->doh_dre[i];
+
+		strncpy(dre->dre_name, cache->drc_names[index + i], NAME_MAX);
+		dre->dre_offset = offset + i;
+		dre->dre_next_offset = offset + i + 1;
+		dre->dre_valid = false;
+	}
+	if (cache->drc_eod && index + count == cache->drc_nr)
+		oh->doh_dre[count - 1].dre_next_offset = READDIR_EOD;
+
+	oh->doh_dre_index = 0;
+	oh->doh_dre_last_index = count;
+
+	DFUSE_TRA_DEBUG(oh, "Added %d cached entries at offset %ld", count, offset);
+out:
+	D_MUTEX_UNLOCK(&cache->drc_lock);
+	return rc;
+}
+
+/* Look up the mode and oid of all pending entries in the handle that have not
+ * been looked up yet, in batches of concurrent fetches rather than one round
+ * trip per entry.
+ */
+static int
+fetch_dir_attrs(struct dfuse_obj_hdl *oh)
+{
+	const char	*names[READDIR_BASE_COUNT];
+	mode_t		modes[READDIR_BASE_COUNT];
+	daos_obj_id_t	oids[READDIR_BASE_COUNT];
+	int		idx[READDIR_BASE_COUNT];
+	int		i = oh->doh_dre_index;
+	int		nr;
+	int		j;
+	int		rc;
+
+	while (i < oh->doh_dre_last_index) {
+		nr = 0;
+		for (; i < oh->doh_dre_last_index && nr < READDIR_BASE_COUNT;
+		     i++) {
+			if (oh->doh_dre[i].dre_valid)
+				continue;
+			idx[nr] = i;
+			names[nr++] = oh->doh_dre[i].dre_name;
+		}
+		if (nr == 0)
+			break;
+
+		rc = dfs_lookup_entries(oh->doh_dfs, oh->doh_obj, nr, names,
+					modes, oids);
+		if (rc != 0)
+			return rc;
+
+		for (j = 0; j < nr; j++) {
+			struct dfuse_readdir_entry *dre = &oh->doh_dre[idx[j]];
+
+			dre->dre_mode = modes[j];
+			dre->dre_oid = oids[j];
+			dre->dre_valid = true;
+		}
+
+		DFUSE_TRA_DEBUG(oh, "Looked up %d entries", nr);
+	}
+
+	return 0;
+}
+
 static int
 create_entry(struct dfuse_projection_info *fs_handle,
 	     struct dfuse_inode_entry *parent,
@@ -208,6 +465,7 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh,
 		 size_t size, off_t offset, bool plus)
 {
 	struct dfuse_projection_info *fs_handle = fuse_req_userdata(req);
+	struct dfuse_readdir_cache *cache;
 	char			*reply_buff;
 	off_t			buff_offset = 0;
 	int			added = 0;
@@ -231,19 +489,39 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh,
 	}
 
 	/* if starting from the beginning, reset the anchor attached to
-	 * the open handle.
+	 * the open handle, and move to the current generation of the entry
+	 * cache.  A handle keeps enumerating the generation it started on
+	 * until it is rewound, even if the directory is changed locally.
 	 */
-	if (offset == 0)
+	if (offset == 0) {
 		dfuse_readdir_reset(oh);
+		dfuse_readdir_release(oh);
+		oh->doh_readdir = readdir_cache_get(oh->doh_ie);
+	}
+
+	cache = oh->doh_readdir;
+	if (cache != NULL && offset >= READDIR_CACHE_MAX + OFFSET_BASE)
+		cache = NULL;
 
-	DFUSE_TRA_DEBUG(oh, "plus %d offset %ld idx %d idx_offset %ld",
+	DFUSE_TRA_DEBUG(oh, "plus %d offset %ld idx %d idx_offset %ld cache %d",
 			plus, offset, oh->doh_dre_index,
-			oh->doh_dre[oh->doh_dre_index].dre_offset);
+			oh->doh_dre[oh->doh_dre_index].dre_offset, cache != NULL);
+
+seek:
+	/* With the entry cache, entries are fetched by offset so a seek only
+	 * drops the entries pending in the handle.
+	 */
+	if (cache != NULL && offset &&
+	    oh->doh_dre[oh->doh_dre_index].dre_offset != offset) {
+		oh->doh_dre_index = 0;
+		oh->doh_dre_last_index = 0;
+		large_fetch = false;
+	}
 
 	/* If there is an offset, and either there is no current offset, or it's
 	 * different then seek
 	 */
-	if (offset &&
+	if (cache == NULL && offset &&
 	    oh->doh_dre[oh->doh_dre_index].dre_offset != offset &&
 	    oh->doh_anchor_index + OFFSET_BASE != offset) {
 		uint32_t num;
@@ -307,7 +585,21 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh,
 			else
 				to_fetch = READDIR_BASE_COUNT - added;
 
-			rc = fetch_dir_entries(oh, offset, to_fetch, &eod);
+			if (cache != NULL) {
+				bool cached = true;
+
+				rc = fetch_cached_entries(oh, cache, offset, to_fetch,
+							  &eod, &cached);
+				if (rc == 0 && !cached) {
+					/* Past the cached names, continue from
+					 * the anchor of the handle.
+					 */
+					cache = NULL;
+					goto seek;
+				}
+			} else {
+				rc = fetch_dir_entries(oh, offset, to_fetch, &eod);
+			}
 			if (rc != 0)
 				D_GOTO(out_reset, rc);
 
@@ -319,6 +611,12 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh,
 			D_ASSERT(offset == oh->doh_dre[oh->doh_dre_index].dre_offset);
 		}
 
+		if (!plus) {
+			rc = fetch_dir_attrs(oh);
+			if (rc != 0)
+				D_GOTO(reply, rc);
+		}
+
 		DFUSE_TRA_DEBUG(oh, "processing offset %ld", offset);
 
 		/* Populate dir */
@@ -342,18 +640,18 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh,
 					dre->dre_next_offset,
 					dre->dre_name);
 
-			if (plus)
+			if (plus) {
 				rc = dfs_lookupx(oh->doh_dfs, oh->doh_obj,
 						 dre->dre_name,
 						 O_RDWR | O_NOFOLLOW, &obj,
 						 &stbuf.st_mode, &stbuf,
 						 1, &duns_xattr_name,
 						 (void **)&outp, &attr_len);
-			else
-				rc = dfs_lookup_rel(oh->doh_dfs, oh->doh_obj,
-						    dre->dre_name,
-						    O_RDWR | O_NOFOLLOW,
-						    &obj, &stbuf.st_mode, NULL);
+			} else {
+				D_ASSERT(dre->dre_valid);
+				stbuf.st_mode = dre->dre_mode;
+				rc = dre->dre_mode == 0 ? ENOENT : 0;
+			}
 			if (rc == ENOENT) {
 				DFUSE_TRA_DEBUG(oh, "File does not exist");
 				continue;
@@ -363,7 +661,10 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh,
 				D_GOTO(reply, rc);
 			}
 
-			dfs_obj2id(obj, &oid);
+			if (plus)
+				dfs_obj2id(obj, &oid);
+			else
+				oid = dre->dre_oid;
 
 			dfuse_compute_inode(oh->doh_ie->ie_dfs,
 					    &oid, &stbuf.st_ino);
@@ -394,8 +695,6 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh,
 							  rlink);
 
 			} else {
-				dfs_release(obj);
-
 				written = FAD(req, &reply_buff[buff_offset],
 					      size - buff_offset, dre->dre_name,
 					      &stbuf, dre->dre_next_offset);
@@ -26,6 +26,7 @@ dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv,
 	const struct fuse_ctx		*fc = fuse_req_ctx(req);
 	int				rc;
 	struct dfuse_event		*ev;
+	struct dfuse_eq			*eqt;
 	size_t				len = fuse_buf_size(bufv);
 	struct fuse_bufvec		ibuf = FUSE_BUFVEC_INIT(len);
 
@@ -55,7 +56,8 @@ dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv,
 	if (rc != len)
 		D_GOTO(err, rc = EIO);
 
-	rc = daos_event_init(&ev->de_ev, fs_handle->dpi_eq, NULL);
+	eqt = dfuse_eq_get(fs_handle);
+	rc = daos_event_init(&ev->de_ev, eqt->deq_eq, NULL);
 	if (rc != -DER_SUCCESS)
 		D_GOTO(err, rc = daos_der2errno(rc));
 
@@ -94,7 +96,7 @@ dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv,
 
 	/* Send a message to the async thread to wake it up and poll for events
 	 */
-	sem_post(&fs_handle->dpi_sem);
+	sem_post(&eqt->deq_sem);
 	return;
 
 err:
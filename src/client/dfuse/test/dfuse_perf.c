@@ -0,0 +1,590 @@
+/**
+ * (C) Copyright 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * dfuse_perf -- FIO-like data and metadata workloads run over a dfuse mount
+ * point (optionally with libioil preloaded) or over the native DFS API, so
+ * that the overhead of each layer can be measured on the same container:
+ *
+ *	dfuse_perf -d /mnt/dfuse/perf                       # dfuse
+ *	LD_PRELOAD=libioil.so dfuse_perf -d /mnt/dfuse/perf # libioil
+ *	dfuse_perf -p pool -c cont                          # DFS
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <dlfcn.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <daos.h>
+#include <daos_fs.h>
+#include <daos/common.h>
+#include "ioil_api.h"
+
+/* latency histogram, bucket N covers [2^N, 2^(N+1)) us */
+#define LAT_BUCKETS	32
+
+enum perf_layer {
+	LAYER_DFUSE,
+	LAYER_IOIL,
+	LAYER_DFS,
+};
+
+static const char *layer_names[] = {
+	[LAYER_DFUSE]	= "dfuse",
+	[LAYER_IOIL]	= "ioil",
+	[LAYER_DFS]	= "dfs",
+};
+
+enum perf_workload {
+	WL_SEQ_WRITE,
+	WL_SEQ_READ,
+	WL_RAND_WRITE,
+	WL_RAND_READ,
+	WL_CREATE,
+	WL_STAT,
+	WL_READDIR,
+	WL_UNLINK,
+	WL_NR,
+};
+
+static const char *wl_names[WL_NR] = {
+	[WL_SEQ_WRITE]	= "seqwrite",
+	[WL_SEQ_READ]	= "seqread",
+	[WL_RAND_WRITE]	= "randwrite",
+	[WL_RAND_READ]	= "randread",
+	[WL_CREATE]	= "create",
+	[WL_STAT]	= "stat",
+	[WL_READDIR]	= "readdir",
+	[WL_UNLINK]	= "unlink",
+};
+
+struct perf_stats {
+	uint64_t	ps_hist[LAT_BUCKETS];
+	uint64_t	ps_ops;
+	uint64_t	ps_bytes;
+	uint64_t	ps_lat_sum;	/* us */
+	uint64_t	ps_lat_max;	/* us */
+	uint64_t	ps_elapsed;	/* us */
+};
+
+/* file handle of either layer */
+struct perf_file {
+	int		 pf_fd;
+	dfs_obj_t	*pf_obj;
+};
+
+static enum perf_layer	layer = LAYER_DFUSE;
+static char		*dir_path;
+static char		*pool_str;
+static char		*cont_str;
+static size_t		 block_size = 1 << 20;
+static size_t		 file_size = 64 << 20;
+static unsigned int	 nr_files = 1000;
+static bool		 json;
+
+static daos_handle_t	 poh;
+static daos_handle_t	 coh;
+static dfs_t		*dfs;
+static dfs_obj_t	*dfs_dir;
+static char		*buf;
+
+static inline uint64_t
+now_us(void)
+{
+	return d_timeus_secdiff(0);
+}
+
+static void
+stats_record(struct perf_stats *ps, uint64_t start, size_t bytes)
+{
+	uint64_t	lat = now_us() - start;
+	int		i = 0;
+
+	if (lat > 1)
+		i = 63 - __builtin_clzl(lat);
+	if (i >= LAT_BUCKETS)
+		i = LAT_BUCKETS - 1;
+
+	ps->ps_hist[i]++;
+	ps->ps_ops++;
+	ps->ps_bytes += bytes;
+	ps->ps_lat_sum += lat;
+	if (lat > ps->ps_lat_max)
+		ps->ps_lat_max = lat;
+}
+
+/* Latency (us) of quantile @q, interpolated within its histogram bucket */
+static double
+stats_quantile(struct perf_stats *ps, double q)
+{
+	uint64_t	rank = q * ps->ps_ops;
+	uint64_t	seen = 0;
+	double		lo;
+	int		i;
+
+	if (rank < q * ps->ps_ops || rank == 0)
+		rank++;
+
+	for (i = 0; i < LAT_BUCKETS - 1; i++) {
+		if (seen + ps->ps_hist[i] >= rank)
+			break;
+		seen += ps->ps_hist[i];
+	}
+
+	lo = i == 0 ? 0 : (double)(1UL << i);
+	return lo + ((1UL << (i + 1)) - lo) * (rank - seen) /
+	       max(ps->ps_hist[i], 1UL);
+}
+
+static void
+stats_print(enum perf_workload wl, struct perf_stats *ps)
+{
+	double	secs = ps->ps_elapsed / 1e6;
+	double	avg = ps->ps_ops ? (double)ps->ps_lat_sum / ps->ps_ops : 0;
+
+	if (secs == 0)
+		secs = 1e-6;
+
+	if (json) {
+		printf("{\"layer\": \"%s\", \"workload\": \"%s\", \"ops\": "DF_U64
+		       ", \"block_size\": %zu, \"iops\": %.2f, \"bandwidth\": %.3f"
+		       ", \"lat_avg\": %.2f, \"lat_p50\": %.1f, \"lat_p99\": %.1f"
+		       ", \"lat_p999\": %.1f, \"lat_max\": "DF_U64"}\n",
+		       layer_names[layer], wl_names[wl], ps->ps_ops, block_size,
+		       ps->ps_ops / secs, ps->ps_bytes / secs / (1024 * 1024),
+		       avg, stats_quantile(ps, 0.5), stats_quantile(ps, 0.99),
+		       stats_quantile(ps, 0.999), ps->ps_lat_max);
+		return;
+	}
+
+	printf("%-6s %-10s ops %-8"PRIu64" iops %-10.2f bw %-10.3f MB/s "
+	       "lat avg %.2f p50 %.1f p99 %.1f p99.9 %.1f max "DF_U64" us\n",
+	       layer_names[layer], wl_names[wl], ps->ps_ops, ps->ps_ops / secs,
+	       ps->ps_bytes / secs / (1024 * 1024), avg,
+	       stats_quantile(ps, 0.5), stats_quantile(ps, 0.99),
+	       stats_quantile(ps, 0.999), ps->ps_lat_max);
+}
+
+/* Layer operations, errors are returned as positive errno */
+
+static int
+file_open(const char *name, bool create, struct perf_file *pf)
+{
+	char	path[PATH_MAX];
+	int	flags = O_RDWR | (create ? O_CREAT : 0);
+	int	rc;
+
+	if (layer == LAYER_DFS) {
+		rc = dfs_open(dfs, dfs_dir, name, S_IFREG | 0644, flags, 0, 0,
+			      NULL, &pf->pf_obj);
+		return rc;
+	}
+
+	snprintf(path, sizeof(path), "%s/%s", dir_path, name);
+	pf->pf_fd = open(path, flags, 0644);
+	return pf->pf_fd < 0 ? errno : 0;
+}
+
+static int
+file_close(struct perf_file *pf)
+{
+	if (layer == LAYER_DFS)
+		return dfs_release(pf->pf_obj);
+
+	return close(pf->pf_fd) < 0 ? errno : 0;
+}
+
+static int
+file_io(struct perf_file *pf, bool write, off_t off)
+{
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	daos_size_t	read_size;
+	ssize_t		bytes;
+
+	if (layer == LAYER_DFS) {
+		d_iov_set(&iov, buf, block_size);
+		sgl.sg_nr = 1;
+		sgl.sg_nr_out = 0;
+		sgl.sg_iovs = &iov;
+		if (write)
+			return dfs_write(dfs, pf->pf_obj, &sgl, off, NULL);
+		return dfs_read(dfs, pf->pf_obj, &sgl, off, &read_size, NULL);
+	}
+
+	if (write)
+		bytes = pwrite(pf->pf_fd, buf, block_size, off);
+	else
+		bytes = pread(pf->pf_fd, buf, block_size, off);
+	if (bytes < 0)
+		return errno;
+	return bytes == block_size ? 0 : EIO;
+}
+
+static int
+file_stat(const char *name)
+{
+	char		path[PATH_MAX];
+	struct stat	stbuf;
+
+	if (layer == LAYER_DFS)
+		return dfs_stat(dfs, dfs_dir, name, &stbuf);
+
+	snprintf(path, sizeof(path), "%s/%s", dir_path, name);
+	return stat(path, &stbuf) < 0 ? errno : 0;
+}
+
+static int
+file_unlink(const char *name)
+{
+	char	path[PATH_MAX];
+
+	if (layer == LAYER_DFS)
+		return dfs_remove(dfs, dfs_dir, name, false, NULL);
+
+	snprintf(path, sizeof(path), "%s/%s", dir_path, name);
+	return unlink(path) < 0 ? errno : 0;
+}
+
+/* Read the whole directory, each batch of entries accounted as one op */
+static int
+dir_read(struct perf_stats *ps)
+{
+	struct dirent	 ents[64];
+	struct dirent	*ent;
+	daos_anchor_t	 anchor = {0};
+	DIR		*dirp;
+	uint64_t	 start;
+	uint32_t	 nr;
+	int		 rc;
+
+	if (layer == LAYER_DFS) {
+		while (!daos_anchor_is_eof(&anchor)) {
+			nr = ARRAY_SIZE(ents);
+			start = now_us();
+			rc = dfs_readdir(dfs, dfs_dir, &anchor, &nr, ents);
+			if (rc)
+				return rc;
+			stats_record(ps, start, 0);
+		}
+		return 0;
+	}
+
+	dirp = opendir(dir_path);
+	if (dirp == NULL)
+		return errno;
+
+	do {
+		start = now_us();
+		ent = readdir(dirp);
+		stats_record(ps, start, 0);
+	} while (ent != NULL);
+
+	closedir(dirp);
+	return 0;
+}
+
+static int
+run_data(enum perf_workload wl, struct perf_stats *ps)
+{
+	struct perf_file	pf;
+	uint64_t		nr_blocks = file_size / block_size;
+	uint64_t		start;
+	uint64_t		i;
+	bool			write;
+	bool			rand;
+	off_t			off;
+	int			rc;
+
+	write = wl == WL_SEQ_WRITE || wl == WL_RAND_WRITE;
+	rand = wl == WL_RAND_WRITE || wl == WL_RAND_READ;
+
+	rc = file_open("data", true, &pf);
+	if (rc)
+		return rc;
+
+	if (layer != LAYER_DFS && wl == WL_SEQ_WRITE &&
+	    dlsym(RTLD_DEFAULT, "dfuse_get_bypass_status") != NULL) {
+		int (*bypass_status)(int fd);
+
+		bypass_status = dlsym(RTLD_DEFAULT, "dfuse_get_bypass_status");
+		if (bypass_status(pf.pf_fd) == DFUSE_IO_BYPASS)
+			layer = LAYER_IOIL;
+	}
+
+	for (i = 0; i < nr_blocks; i++) {
+		off = (rand ? (uint64_t)random() % nr_blocks : i) * block_size;
+		start = now_us();
+		rc = file_io(&pf, write, off);
+		if (rc)
+			break;
+		stats_record(ps, start, block_size);
+	}
+
+	file_close(&pf);
+	return rc;
+}
+
+static int
+run_meta(enum perf_workload wl, struct perf_stats *ps)
+{
+	struct perf_file	pf;
+	char			name[32];
+	uint64_t		start;
+	unsigned int		i;
+	int			rc = 0;
+
+	if (wl == WL_READDIR)
+		return dir_read(ps);
+
+	for (i = 0; i < nr_files; i++) {
+		snprintf(name, sizeof(name), "f.%u", i);
+		start = now_us();
+		switch (wl) {
+		case WL_CREATE:
+			rc = file_open(name, true, &pf);
+			if (rc == 0)
+				rc = file_close(&pf);
+			break;
+		case WL_STAT:
+			rc = file_stat(name);
+			break;
+		case WL_UNLINK:
+			rc = file_unlink(name);
+			break;
+		default:
+			D_ASSERT(0);
+		}
+		if (rc)
+			break;
+		stats_record(ps, start, 0);
+	}
+	return rc;
+}
+
+static int
+run_workload(enum perf_workload wl)
+{
+	struct perf_stats	ps = {0};
+	uint64_t		start;
+	int			rc;
+
+	start = now_us();
+	if (wl <= WL_RAND_READ)
+		rc = run_data(wl, &ps);
+	else
+		rc = run_meta(wl, &ps);
+	ps.ps_elapsed = now_us() - start;
+
+	if (rc) {
+		fprintf(stderr, "%s failed: %d (%s)\n", wl_names[wl], rc,
+			strerror(rc));
+		return rc;
+	}
+
+	stats_print(wl, &ps);
+	return 0;
+}
+
+static int
+dfs_setup(void)
+{
+	int	rc;
+
+	rc = daos_init();
+	if (rc) {
+		fprintf(stderr, "daos_init failed: "DF_RC"\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = daos_pool_connect(pool_str, NULL, DAOS_PC_RW, &poh, NULL, NULL);
+	if (rc) {
+		fprintf(stderr, "pool connect failed: "DF_RC"\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = daos_cont_open(poh, cont_str, DAOS_COO_RW, &coh, NULL, NULL);
+	if (rc) {
+		fprintf(stderr, "cont open failed: "DF_RC"\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = dfs_mount(poh, coh, O_RDWR, &dfs);
+	if (rc) {
+		fprintf(stderr, "dfs mount failed: %d\n", rc);
+		return rc;
+	}
+
+	/* keep the files away from the other users of the container */
+	rc = dfs_open(dfs, NULL, "dfuse_perf", S_IFDIR | 0755,
+		      O_RDWR | O_CREAT, 0, 0, NULL, &dfs_dir);
+	if (rc)
+		fprintf(stderr, "dfs open dir failed: %d\n", rc);
+	return rc;
+}
+
+static void
+dfs_teardown(void)
+{
+	if (dfs_dir != NULL)
+		dfs_release(dfs_dir);
+	if (dfs != NULL)
+		dfs_umount(dfs);
+	if (daos_handle_is_valid(coh))
+		daos_cont_close(coh, NULL);
+	if (daos_handle_is_valid(poh))
+		daos_pool_disconnect(poh, NULL);
+	daos_fini();
+}
+
+static void
+print_usage(void)
+{
+	printf("dfuse_perf -- dfuse, libioil and DFS benchmark\n\n"
+	       "-d dir        Run over a directory of a dfuse mount point,\n"
+	       "              preload libioil to benchmark the interception\n"
+	       "-p pool       Pool label or UUID, run over the DFS API\n"
+	       "-c cont       Container label or UUID, run over the DFS API\n"
+	       "-w workloads  Comma separated list within seqwrite, seqread,\n"
+	       "              randwrite, randread, create, stat, readdir,\n"
+	       "              unlink (default: all of them in this order)\n"
+	       "-b size       I/O block size (default 1M)\n"
+	       "-s size       Data file size (default 64M)\n"
+	       "-n number     Number of files of metadata workloads (1000)\n"
+	       "-j            One JSON object per workload\n");
+}
+
+static size_t
+parse_size(const char *str)
+{
+	char	*end;
+	size_t	 val = strtoull(str, &end, 0);
+
+	switch (*end) {
+	case 'g':
+	case 'G':
+		val <<= 10;
+		/* fall through */
+	case 'm':
+	case 'M':
+		val <<= 10;
+		/* fall through */
+	case 'k':
+	case 'K':
+		val <<= 10;
+	}
+	return val;
+}
+
+int
+main(int argc, char **argv)
+{
+	struct option	opts[] = {
+		{ "dir",	required_argument,	NULL,	'd' },
+		{ "pool",	required_argument,	NULL,	'p' },
+		{ "cont",	required_argument,	NULL,	'c' },
+		{ "workloads",	required_argument,	NULL,	'w' },
+		{ "bsize",	required_argument,	NULL,	'b' },
+		{ "fsize",	required_argument,	NULL,	's' },
+		{ "files",	required_argument,	NULL,	'n' },
+		{ "json",	no_argument,		NULL,	'j' },
+		{ "help",	no_argument,		NULL,	'h' },
+		{ NULL,		0,			NULL,	0 },
+	};
+	bool		run[WL_NR] = {0};
+	char		*workloads = NULL;
+	char		*tok;
+	int		 i;
+	int		 rc;
+
+	while ((rc = getopt_long(argc, argv, "d:p:c:w:b:s:n:jh", opts,
+				 NULL)) != -1) {
+		switch (rc) {
+		case 'd':
+			dir_path = optarg;
+			break;
+		case 'p':
+			pool_str = optarg;
+			break;
+		case 'c':
+			cont_str = optarg;
+			break;
+		case 'w':
+			workloads = optarg;
+			break;
+		case 'b':
+			block_size = parse_size(optarg);
+			break;
+		case 's':
+			file_size = parse_size(optarg);
+			break;
+		case 'n':
+			nr_files = strtoul(optarg, NULL, 0);
+			break;
+		case 'j':
+			json = true;
+			break;
+		case 'h':
+			print_usage();
+			return 0;
+		default:
+			print_usage();
+			return EINVAL;
+		}
+	}
+
+	if ((dir_path == NULL) == (pool_str == NULL || cont_str == NULL) ||
+	    block_size == 0 || file_size < block_size) {
+		print_usage();
+		return EINVAL;
+	}
+
+	for (tok = workloads ? strtok(workloads, ",") : NULL; tok != NULL;
+	     tok = strtok(NULL, ",")) {
+		for (i = 0; i < WL_NR; i++) {
+			if (strcmp(tok, wl_names[i]) == 0)
+				break;
+		}
+		if (i == WL_NR) {
+			fprintf(stderr, "unknown workload %s\n", tok);
+			return EINVAL;
+		}
+		run[i] = true;
+	}
+	if (workloads == NULL)
+		memset(run, 1, sizeof(run));
+
+	buf = malloc(block_size);
+	if (buf == NULL)
+		return ENOMEM;
+	memset(buf, 'a', block_size);
+
+	if (dir_path == NULL) {
+		layer = LAYER_DFS;
+		rc = dfs_setup();
+		if (rc)
+			goto out;
+	}
+
+	for (i = 0; i < WL_NR; i++) {
+		if (!run[i])
+			continue;
+		rc = run_workload(i);
+		if (rc)
+			break;
+	}
+
+out:
+	if (layer == LAYER_DFS)
+		dfs_teardown();
+	free(buf);
+	return rc;
+}
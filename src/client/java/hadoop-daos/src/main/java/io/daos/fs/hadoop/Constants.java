@@ -47,6 +47,10 @@ public final class Constants {
 
   public static final String DAOS_READ_MINIMUM_SIZE = "fs.daos.read.min.size";
 
+  // number of read buffer sized chunks read ahead asynchronously on sequential read, 0 to disable
+  public static final String DAOS_READ_AHEAD_DEPTH = "fs.daos.read.ahead.depth";
+  public static final int DEFAULT_DAOS_READ_AHEAD_DEPTH = 4;
+
   // the minimum and default internal write buffer size, maximum size
   public static final String DAOS_WRITE_BUFFER_SIZE = "fs.daos.write.buffer.size";
   public static final int DEFAULT_DAOS_WRITE_BUFFER_SIZE = 1 * 1024 * 1024;
@@ -0,0 +1,55 @@
+/*
+ * (C) Copyright 2018-2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+package io.daos.fs.hadoop;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.CompletableFuture;
+
+/**
+ * A range of file to read with {@link DaosInputStream#readVectored}.
+ *
+ * <p>
+ * It mirrors Hadoop's <code>FileRange</code> (Hadoop 3.3.5+) so that the connector can expose vectored reads with
+ * the Hadoop version it's built against. The data future is set by the read.
+ */
+public class DaosFileRange {
+
+  private final long offset;
+
+  private final int length;
+
+  private CompletableFuture<ByteBuffer> data;
+
+  public DaosFileRange(long offset, int length) {
+    if (offset < 0 || length < 0) {
+      throw new IllegalArgumentException("offset/length is negative , offset = " + offset + ", length = " + length);
+    }
+    this.offset = offset;
+    this.length = length;
+  }
+
+  public long getOffset() {
+    return offset;
+  }
+
+  public int getLength() {
+    return length;
+  }
+
+  public CompletableFuture<ByteBuffer> getData() {
+    return data;
+  }
+
+  public void setData(CompletableFuture<ByteBuffer> data) {
+    this.data = data;
+  }
+
+  @Override
+  public String toString() {
+    return "range(" + offset + ", " + length + ")";
+  }
+}
@@ -9,11 +9,17 @@ package io.daos.fs.hadoop;
 import io.daos.BufferAllocator;
 import io.daos.dfs.DaosFile;
 import io.netty.buffer.ByteBuf;
+import io.netty.buffer.Unpooled;
 import org.apache.hadoop.fs.FileSystem;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import java.io.EOFException;
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.function.IntFunction;
 
 public abstract class DaosFileSource {
 
@@ -21,7 +27,7 @@ public abstract class DaosFileSource {
 
   protected final long fileLen;
 
-  protected final ByteBuf buffer;
+  protected ByteBuf buffer;  // may be swapped with read-ahead buffers by subclass
 
   private final boolean selfManagedBuf;
 
@@ -63,11 +69,12 @@ public abstract class DaosFileSource {
   }
 
   public void close() {
+    // let subclass drain in-flight IOs and give back the original buffer first
+    closeMore();
     this.daosFile.release();
     if (selfManagedBuf) {
       buffer.release();
     }
-    closeMore();
   }
 
   protected void closeMore() {}
@@ -209,6 +216,71 @@ public abstract class DaosFileSource {
 
   protected abstract int doRead(long nextReadPos, int length) throws IOException;
 
+  /**
+   * read all <code>ranges</code> into buffers got from <code>allocate</code>. Data future of each range is set and
+   * completed when this method returns. Ranges are read one by one in this default implementation.
+   *
+   * @param ranges
+   * file ranges to read
+   * @param allocate
+   * function to allocate buffer for each range. Direct buffer is filled without copy.
+   * @throws IOException
+   * DaosIOException
+   */
+  public void readVectored(List<? extends DaosFileRange> ranges, IntFunction<ByteBuffer> allocate)
+      throws IOException {
+    for (DaosFileRange range : ranges) {
+      ByteBuffer dest = startRange(range, allocate);
+      if (dest == null) {
+        continue;
+      }
+      ByteBuf buf = wrapRange(dest, range.getLength());
+      try {
+        int actualLen = (int) daosFile.read(buf, 0, range.getOffset(), range.getLength());
+        completeRange(range, dest, buf, actualLen);
+      } finally {
+        buf.release();
+      }
+    }
+  }
+
+  /**
+   * set data future of <code>range</code> and allocate its destination buffer.
+   *
+   * @return destination buffer. null if range is out of file, data future is failed in this case.
+   */
+  protected ByteBuffer startRange(DaosFileRange range, IntFunction<ByteBuffer> allocate) {
+    CompletableFuture<ByteBuffer> future = new CompletableFuture<>();
+    range.setData(future);
+    if (range.getOffset() + range.getLength() > fileLen) {
+      future.completeExceptionally(new EOFException("range " + range + " exceeds file length " + fileLen));
+      return null;
+    }
+    return allocate.apply(range.getLength());
+  }
+
+  /**
+   * wrap direct destination buffer for reading from DAOS without copy. Otherwise, a pooled direct buffer is used.
+   */
+  protected static ByteBuf wrapRange(ByteBuffer dest, int length) {
+    return dest.isDirect() ? Unpooled.wrappedBuffer(dest) : BufferAllocator.directNettyBuf(length);
+  }
+
+  protected void completeRange(DaosFileRange range, ByteBuffer dest, ByteBuf buf, int actualLen) {
+    if (actualLen < range.getLength()) {
+      range.getData().completeExceptionally(new EOFException("short read of range " + range + ", got " +
+          actualLen));
+      return;
+    }
+    dest.limit(dest.position() + actualLen);
+    if (!dest.isDirect()) {
+      buf.getBytes(0, dest.duplicate());
+    }
+    stats.incrementReadOps(1);
+    stats.incrementBytesRead(actualLen);
+    range.getData().complete(dest);
+  }
+
   public int writerIndex() {
     return buffer.writerIndex();
   }
@@ -6,6 +6,7 @@
 
 package io.daos.fs.hadoop;
 
+import io.daos.BufferAllocator;
 import io.daos.Constants;
 import io.daos.DaosEventQueue;
 import io.daos.DaosIOException;
@@ -13,13 +14,25 @@ import io.daos.dfs.DaosFile;
 import io.daos.dfs.IODfsDesc;
 import io.netty.buffer.ByteBuf;
 import org.apache.hadoop.fs.FileSystem;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
 
 import java.io.IOException;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.HashSet;
 import java.util.List;
 import java.util.Set;
+import java.util.function.IntFunction;
 
+/**
+ * File source doing IOs with {@link DaosEventQueue}.
+ *
+ * <p>
+ * For reads, up to <code>readAheadDepth</code> chunks of <code>bufCapacity</code> bytes following a sequential read
+ * are fetched asynchronously into pooled direct buffers. On hit, the read-ahead buffer is swapped with the internal
+ * buffer instead of being copied.
+ */
 public class DaosFileSourceAsync extends DaosFileSource {
 
   private IODfsDesc desc;
@@ -28,24 +41,44 @@ public class DaosFileSourceAsync extends DaosFileSource {
 
   private Set<IODfsDesc> candidates = new HashSet<>();
 
+  private Set<IODfsDesc> pending = new HashSet<>();
+
   private List<DaosEventQueue.Attachment> completed = new ArrayList<>(1);
 
+  private ByteBuf primaryBuffer;
+
+  private ReadAhead[] readAheads;
+
+  private long lastReadEnd = -1;
+
   private final static int TIMEOUT_MS = Integer.valueOf(System.getProperty(Constants.CFG_DAOS_TIMEOUT,
       Constants.DEFAULT_DAOS_TIMEOUT_MS)); // MILLI SEC
 
+  private static final Logger LOG = LoggerFactory.getLogger(DaosFileSourceAsync.class);
+
   public DaosFileSourceAsync(DaosFile daosFile, int bufCapacity, long fileLen, boolean readOrWrite,
                              FileSystem.Statistics stats) {
-    super(daosFile, bufCapacity, fileLen, stats);
-    createDesc(readOrWrite);
+    this(daosFile, bufCapacity, fileLen, readOrWrite, 0, stats);
   }
 
   public DaosFileSourceAsync(DaosFile daosFile, ByteBuf buffer, long fileLen,
                              boolean readOrWrite, FileSystem.Statistics stats) {
+    this(daosFile, buffer, fileLen, readOrWrite, 0, stats);
+  }
+
+  public DaosFileSourceAsync(DaosFile daosFile, int bufCapacity, long fileLen, boolean readOrWrite,
+                             int readAheadDepth, FileSystem.Statistics stats) {
+    super(daosFile, bufCapacity, fileLen, stats);
+    createDesc(readOrWrite, readAheadDepth);
+  }
+
+  public DaosFileSourceAsync(DaosFile daosFile, ByteBuf buffer, long fileLen,
+                             boolean readOrWrite, int readAheadDepth, FileSystem.Statistics stats) {
     super(daosFile, buffer, fileLen, stats);
-    createDesc(readOrWrite);
+    createDesc(readOrWrite, readAheadDepth);
   }
 
-  private void createDesc(boolean readOrWrite) {
+  private void createDesc(boolean readOrWrite, int readAheadDepth) {
     try {
       eq = DaosEventQueue.getInstance(0);
     } catch (IOException e) {
@@ -55,53 +88,235 @@ public class DaosFileSourceAsync extends DaosFileSource {
     desc = daosFile.createDfsDesc(buffer, eq);
     desc.setReadOrWrite(readOrWrite);
     candidates.add(desc);
+    primaryBuffer = buffer;
+    if (readOrWrite && readAheadDepth > 0) {
+      readAheads = new ReadAhead[readAheadDepth];
+      for (int i = 0; i < readAheadDepth; i++) {
+        ByteBuf buf = BufferAllocator.directNettyBuf(bufCapacity);
+        IODfsDesc raDesc = daosFile.createDfsDesc(buf, eq);
+        raDesc.setReadOrWrite(true);
+        candidates.add(raDesc);
+        readAheads[i] = new ReadAhead(buf, raDesc);
+      }
+    }
   }
 
   @Override
   public void closeMore() {
+    for (IODfsDesc d : new ArrayList<>(pending)) {
+      try {
+        waitFor(d);
+      } catch (IOException e) {
+        LOG.error("failed to wait for in-flight IO of " + daosFile.getPath(), e);
+      }
+    }
+    if (readAheads != null) {
+      // give back original buffer to parent
+      for (ReadAhead ra : readAheads) {
+        if (ra.buf == primaryBuffer) {
+          swap(ra);
+          break;
+        }
+      }
+      for (ReadAhead ra : readAheads) {
+        ra.desc.release();
+        if (!pending.contains(ra.desc)) {
+          ra.buf.release();
+        }
+      }
+    }
     desc.release();
   }
 
   @Override
   protected int doWrite(long nextWritePos) throws IOException {
-    assert Thread.currentThread().getId() == eq.getThreadId() : "current thread " + Thread.currentThread().getId() +
-        "(" + Thread.currentThread().getName() + "), is not expected " + eq.getThreadId() + "(" +
-        eq.getThreadName() + ")";
-
-    DaosEventQueue.Event event = eq.acquireEventBlocking(TIMEOUT_MS, completed, IODfsDesc.class, candidates);
-    desc.reuse();
-    desc.setEvent(event);
+    checkThread();
     int len = buffer.readableBytes();
-    daosFile.writeAsync(desc, nextWritePos, len);
-    waitForCompletion();
+    submit(desc, nextWritePos, len, false);
+    waitFor(desc);
     return len;
   }
 
   @Override
   protected int doRead(long nextReadPos, int length) throws IOException {
+    checkThread();
+    ReadAhead hit = readAheads == null ? null : lookup(nextReadPos);
+    if (hit != null) {
+      waitFor(hit.desc);
+      if (!hit.desc.isSucceeded()) {
+        // fall back to regular read
+        hit.offset = -1;
+        hit = null;
+      }
+    }
+    int actualLen;
+    if (hit != null) {
+      swap(hit);
+      actualLen = desc.getActualLength();
+    } else {
+      submit(desc, nextReadPos, length, true);
+      waitFor(desc);
+      actualLen = desc.getActualLength();
+    }
+    if (readAheads != null) {
+      boolean sequential = hit != null || nextReadPos == lastReadEnd;
+      lastReadEnd = nextReadPos + actualLen;
+      if (sequential && actualLen > 0) {
+        readAhead(lastReadEnd);
+      }
+    }
+    return actualLen;
+  }
+
+  /**
+   * read all ranges asynchronously. Each range is read into its own buffer, without copy if the allocated buffer
+   * is direct. The number of ranges in flight is bounded by number of events of the EQ.
+   */
+  @Override
+  public void readVectored(List<? extends DaosFileRange> ranges, IntFunction<ByteBuffer> allocate)
+      throws IOException {
+    checkThread();
+    List<VectoredRead> reads = new ArrayList<>(ranges.size());
+    try {
+      for (DaosFileRange range : ranges) {
+        ByteBuffer dest = startRange(range, allocate);
+        if (dest == null) {
+          continue;
+        }
+        VectoredRead vr = new VectoredRead(range, dest, wrapRange(dest, range.getLength()));
+        reads.add(vr);
+        vr.desc = daosFile.createDfsDesc(vr.buf, eq);
+        vr.desc.setReadOrWrite(true);
+        candidates.add(vr.desc);
+        submit(vr.desc, range.getOffset(), range.getLength(), true);
+      }
+      for (VectoredRead vr : reads) {
+        waitFor(vr.desc);
+        if (vr.desc.isSucceeded()) {
+          completeRange(vr.range, vr.dest, vr.buf, vr.desc.getActualLength());
+        } else {
+          vr.range.getData().completeExceptionally(new DaosIOException("failed to read " + vr.range +
+              " of " + daosFile.getPath()));
+        }
+      }
+    } finally {
+      for (VectoredRead vr : reads) {
+        if (vr.desc != null) {
+          candidates.remove(vr.desc);
+          vr.desc.release();
+        }
+        if (vr.desc == null || !pending.contains(vr.desc)) {
+          vr.buf.release();
+        }
+        if (!vr.range.getData().isDone()) {
+          vr.range.getData().completeExceptionally(new DaosIOException("failed to read " + vr.range));
+        }
+      }
+    }
+  }
+
+  private void checkThread() {
     assert Thread.currentThread().getId() == eq.getThreadId() : "current thread " + Thread.currentThread().getId() +
         "(" + Thread.currentThread().getName() + "), is not expected " + eq.getThreadId() + "(" +
         eq.getThreadName() + ")";
+  }
 
-    DaosEventQueue.Event event = eq.acquireEventBlocking(TIMEOUT_MS, completed, IODfsDesc.class, candidates);
-    desc.reuse();
-    desc.setEvent(event);
-    daosFile.readAsync(desc, nextReadPos, length);
-    waitForCompletion();
-    return desc.getActualLength();
+  private ReadAhead lookup(long offset) {
+    for (ReadAhead ra : readAheads) {
+      if (ra.offset == offset) {
+        return ra;
+      }
+    }
+    return null;
+  }
+
+  /**
+   * issue reads of chunks following <code>from</code> which are not being read ahead yet.
+   */
+  private void readAhead(long from) throws IOException {
+    long windowEnd = from + (long) readAheads.length * bufCapacity;
+    for (long next = from; next < windowEnd && next < fileLen; next += bufCapacity) {
+      if (lookup(next) != null) {
+        continue;
+      }
+      ReadAhead ra = null;
+      for (ReadAhead r : readAheads) {
+        if (!pending.contains(r.desc) && (r.offset < from || r.offset >= windowEnd)) {
+          ra = r;
+          break;
+        }
+      }
+      if (ra == null) {
+        return;
+      }
+      ra.offset = next;
+      submit(ra.desc, next, (int) Math.min(bufCapacity, fileLen - next), true);
+    }
+  }
+
+  /**
+   * exchange buffer and desc of <code>ra</code> with current ones.
+   */
+  private void swap(ReadAhead ra) {
+    ByteBuf buf = buffer;
+    IODfsDesc d = desc;
+    buffer = ra.buf;
+    desc = ra.desc;
+    ra.buf = buf;
+    ra.desc = d;
+    ra.offset = -1;
   }
 
-  private void waitForCompletion() throws IOException {
+  private void submit(IODfsDesc d, long offset, int len, boolean read) throws IOException {
     completed.clear();
+    DaosEventQueue.Event event = eq.acquireEventBlocking(TIMEOUT_MS, completed, IODfsDesc.class, candidates);
+    pending.removeAll(completed);
+    d.reuse();
+    d.setEvent(event);
+    if (read) {
+      daosFile.readAsync(d, offset, len);
+    } else {
+      daosFile.writeAsync(d, offset, len);
+    }
+    pending.add(d);
+  }
+
+  private void waitFor(IODfsDesc target) throws IOException {
     long start = System.currentTimeMillis();
     long dur;
-    while (completed.isEmpty() & ((dur = (System.currentTimeMillis() - start)) < TIMEOUT_MS)) {
-      eq.pollCompleted(completed, IODfsDesc.class, candidates, 1, TIMEOUT_MS - dur);
+    while (pending.contains(target) & ((dur = (System.currentTimeMillis() - start)) < TIMEOUT_MS)) {
+      completed.clear();
+      eq.pollCompleted(completed, IODfsDesc.class, candidates, pending.size(), TIMEOUT_MS - dur);
+      pending.removeAll(completed);
+    }
+    if (pending.contains(target)) {
+      target.discard();
+      throw new DaosIOException("failed to get expected return after waiting " + TIMEOUT_MS + " ms. desc: " +
+          target + ", candidates size: " + candidates.size() + ", dur: " + (System.currentTimeMillis() - start));
     }
-    if (completed.isEmpty()) {
-      desc.discard();
-      throw new DaosIOException("failed to get expected return after waiting " + TIMEOUT_MS + " ms. desc: " + desc +
-          ", candidates size: " + candidates.size() + ", dur: " + (System.currentTimeMillis() - start));
+  }
+
+  private static final class ReadAhead {
+    private ByteBuf buf;
+    private IODfsDesc desc;
+    private long offset = -1;
+
+    private ReadAhead(ByteBuf buf, IODfsDesc desc) {
+      this.buf = buf;
+      this.desc = desc;
+    }
+  }
+
+  private static final class VectoredRead {
+    private final DaosFileRange range;
+    private final ByteBuffer dest;
+    private final ByteBuf buf;
+    private IODfsDesc desc;
+
+    private VectoredRead(DaosFileRange range, ByteBuffer dest, ByteBuf buf) {
+      this.range = range;
+      this.dest = dest;
+      this.buf = buf;
     }
   }
 }
@@ -39,6 +39,7 @@ public class DaosFileSystem extends FileSystem {
   private int blockSize;
   private int chunkSize;
   private int minReadSize;
+  private int readAheadDepth;
   private String bucket;
   private String unsPrefix;
   private String qualifiedUriNoPrefix;
@@ -185,6 +186,11 @@ public class DaosFileSystem extends FileSystem {
       minReadSize = readBufferSize;
     }
     async = conf.getBoolean(Constants.DAOS_IO_ASYNC, Constants.DEFAULT_DAOS_IO_ASYNC);
+    readAheadDepth = conf.getInt(Constants.DAOS_READ_AHEAD_DEPTH, Constants.DEFAULT_DAOS_READ_AHEAD_DEPTH);
+    if (readAheadDepth < 0) {
+      LOG.warn("overriding negative readAheadDepth to 0");
+      readAheadDepth = 0;
+    }
 
     checkSizeMin(readBufferSize, Constants.MINIMUM_DAOS_READ_BUFFER_SIZE,
             "internal read buffer size should be no less than ");
@@ -210,6 +216,7 @@ public class DaosFileSystem extends FileSystem {
       LOG.debug("chunk size: " + chunkSize);
       LOG.debug("min read size: " + minReadSize);
       LOG.debug("async: " + async);
+      LOG.debug("read ahead depth: " + readAheadDepth);
     }
   }
 
@@ -339,7 +346,7 @@ public class DaosFileSystem extends FileSystem {
 
     return new FSDataInputStream(new DaosInputStream(
             file, statistics, readBufferSize,
-            bufferSize < minReadSize ? minReadSize : bufferSize, async));
+            bufferSize < minReadSize ? minReadSize : bufferSize, async, readAheadDepth));
   }
 
   @Override
@@ -8,6 +8,9 @@ package io.daos.fs.hadoop;
 
 import java.io.EOFException;
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.List;
+import java.util.function.IntFunction;
 
 import io.daos.dfs.DaosFile;
 
@@ -64,11 +67,34 @@ public class DaosInputStream extends FSInputStream {
   protected DaosInputStream(DaosFile daosFile,
                          FileSystem.Statistics stats,
                          int bufferCap, int readSize, boolean async) throws IOException {
+    this(daosFile, stats, bufferCap, readSize, async, 0);
+  }
+
+  /**
+   * Constructor with number of chunks to read ahead asynchronously on sequential read.
+   * @param daosFile
+   * DAOS file object
+   * @param stats
+   * Hadoop file system statistics
+   * @param bufferCap
+   * buffer capacity
+   * @param readSize
+   * size of data to read at each DAOS call.
+   * @param async
+   * read with DAOS event queue
+   * @param readAheadDepth
+   * number of <code>bufferCap</code> chunks to read ahead. Only used with async.
+   * @throws IOException
+   * DaosIOException
+   */
+  protected DaosInputStream(DaosFile daosFile,
+                         FileSystem.Statistics stats,
+                         int bufferCap, int readSize, boolean async, int readAheadDepth) throws IOException {
     this.stats = stats;
     this.bufferCapacity = readSize > bufferCap ? readSize : bufferCap;
     this.readSize = readSize;
     this.fileLen = daosFile.length();
-    this.source = async ? new DaosFileSourceAsync(daosFile, bufferCapacity, fileLen, true, stats) :
+    this.source = async ? new DaosFileSourceAsync(daosFile, bufferCapacity, fileLen, true, readAheadDepth, stats) :
         new DaosFileSourceSync(daosFile, bufferCapacity, fileLen, stats);
     source.setReadSize(readSize);
     buffer = null;
@@ -207,6 +233,23 @@ public class DaosInputStream extends FSInputStream {
     return source.read(buf, off, len);
   }
 
+  /**
+   * read multiple ranges of file, like Hadoop's <code>readVectored</code>. The ranges are issued in parallel with
+   * async IO. Each range gets its data future set and completed by the time this method returns. The stream
+   * position is not changed.
+   * @param ranges
+   * file ranges to read
+   * @param allocate
+   * function to allocate buffer for a range of given length. Direct buffers are filled without copy.
+   * @throws IOException
+   * DaosIOException
+   */
+  public synchronized void readVectored(List<? extends DaosFileRange> ranges, IntFunction<ByteBuffer> allocate)
+      throws IOException {
+    checkNotClose();
+    source.readVectored(ranges, allocate);
+  }
+
   @Override
   public synchronized void close() throws IOException {
     if (LOG.isDebugEnabled()) {
@@ -4,11 +4,15 @@ import io.daos.BufferAllocator;
 import io.daos.DaosEventQueue;
 import io.daos.dfs.DaosFile;
 import io.netty.buffer.ByteBuf;
+import org.apache.hadoop.fs.FileSystem;
 import org.junit.Assert;
 import org.junit.BeforeClass;
 import org.junit.Test;
 
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.List;
 
 public class DaosFileSourceAsyncIT {
 
@@ -36,4 +40,51 @@ public class DaosFileSourceAsyncIT {
     Assert.assertEquals(20000, v2);
     fs2.close();
   }
+
+  private DaosFile writeLongs(String path, int nbr) throws IOException {
+    DaosFile file = DaosFSFactory.getFsClient().getFile(path);
+    file.createNewFile();
+    ByteBuf buffer = BufferAllocator.directNettyBuf(nbr * 8);
+    for (int i = 0; i < nbr; i++) {
+      buffer.writeLong(i);
+    }
+    file.write(buffer, 0, 0, nbr * 8);
+    buffer.release();
+    file.release();
+    return DaosFSFactory.getFsClient().getFile(path);
+  }
+
+  @Test
+  public void testSequentialReadAhead() throws IOException {
+    int nbr = 1000;
+    DaosFile file = writeLongs("/DaosFileSourceAsyncIT_2", nbr);
+    DaosFileSourceAsync fs = new DaosFileSourceAsync(file, 800, nbr * 8, true, 3,
+        new FileSystem.Statistics("daos"));
+    fs.setReadSize(800);
+    byte[] buf = new byte[8];
+    for (int i = 0; i < nbr; i++) {
+      Assert.assertEquals(8, fs.read(buf, 0, 8));
+      Assert.assertEquals(i, ByteBuffer.wrap(buf).getLong());
+    }
+    // random read after read-ahead
+    fs.setNextReadPos(8 * 10);
+    Assert.assertEquals(8, fs.read(buf, 0, 8));
+    Assert.assertEquals(10, ByteBuffer.wrap(buf).getLong());
+    fs.close();
+  }
+
+  @Test
+  public void testReadVectored() throws Exception {
+    int nbr = 1000;
+    DaosFile file = writeLongs("/DaosFileSourceAsyncIT_3", nbr);
+    DaosFileSourceAsync fs = new DaosFileSourceAsync(file, 800, nbr * 8, true,
+        new FileSystem.Statistics("daos"));
+    List<DaosFileRange> ranges = Arrays.asList(new DaosFileRange(8 * 900, 80), new DaosFileRange(0, 16),
+        new DaosFileRange(8 * 500, 8));
+    fs.readVectored(ranges, ByteBuffer::allocateDirect);
+    Assert.assertEquals(900, ranges.get(0).getData().get().getLong(0));
+    Assert.assertEquals(1, ranges.get(1).getData().get().getLong(8));
+    Assert.assertEquals(500, ranges.get(2).getData().get().getLong(0));
+    fs.close();
+  }
 }
@@ -25,7 +25,7 @@ public class DaosFsConfigTest {
   @Test
   public void testFsConfigNamesSize() throws Exception {
     DaosFsConfig cf = DaosFsConfig.getInstance();
-    Assert.assertEquals(12, cf.getFsConfigNames().size());
+    Assert.assertEquals(13, cf.getFsConfigNames().size());
   }
 
   @Test
@@ -14,9 +14,12 @@ import org.junit.Test;
 import org.mockito.ArgumentCaptor;
 import org.mockito.stubbing.Answer;
 
+import java.io.EOFException;
 import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
 import java.util.concurrent.atomic.AtomicInteger;
 
 import static org.mockito.Mockito.*;
@@ -517,4 +520,57 @@ public class DaosInputStreamTest {
     byte[] expect = data;
     Assert.assertArrayEquals(expect, answer);
   }
+
+  private void readVectored(boolean direct) throws Exception {
+    DaosFile file = mock(DaosFile.class);
+    FileSystem.Statistics stats = mock(FileSystem.Statistics.class);
+    byte[] data = new byte[100];
+    for (int i = 0; i < data.length; i++) {
+      data[i] = (byte) i;
+    }
+    doAnswer(invocationOnMock -> {
+          ByteBuf buffer = (ByteBuf) invocationOnMock.getArguments()[0];
+          long fileOffset = (long) invocationOnMock.getArguments()[2];
+          long len = (long) invocationOnMock.getArguments()[3];
+          buffer.setBytes(0, data, (int) fileOffset, (int) len);
+          return len;
+        })
+        .when(file)
+        .read(any(ByteBuf.class), anyLong(), anyLong(), anyLong());
+    doReturn((long) data.length).when(file).length();
+
+    DaosInputStream is = new DaosInputStream(file, stats, 10, 10, false);
+    List<DaosFileRange> ranges = Arrays.asList(new DaosFileRange(5, 10), new DaosFileRange(60, 30),
+        new DaosFileRange(95, 10));
+    is.readVectored(ranges, direct ? ByteBuffer::allocateDirect : ByteBuffer::allocate);
+
+    for (int i = 0; i < 2; i++) {
+      DaosFileRange range = ranges.get(i);
+      ByteBuffer bb = range.getData().get();
+      Assert.assertEquals(range.getLength(), bb.remaining());
+      for (int j = 0; j < range.getLength(); j++) {
+        Assert.assertEquals(data[(int) range.getOffset() + j], bb.get(j));
+      }
+    }
+    // beyond EOF
+    try {
+      ranges.get(2).getData().get();
+      Assert.fail("exception expected for range beyond EOF");
+    } catch (ExecutionException e) {
+      Assert.assertTrue(e.getCause() instanceof EOFException);
+    }
+    verify(file, times(2)).read(any(ByteBuf.class), anyLong(), anyLong(), anyLong());
+    Assert.assertEquals(0, is.getPos());
+    is.close();
+  }
+
+  @Test
+  public void testReadVectoredDirect() throws Exception {
+    readVectored(true);
+  }
+
+  @Test
+  public void testReadVectoredHeap() throws Exception {
+    readVectored(false);
+  }
 }
@@ -643,3 +643,402 @@ err_task:
 		kv_decref(kv);
 	return rc;
 }
+
+static void
+kv_io_params_init(struct io_params *params, const char *key, size_t key_len,
+		  daos_size_t size, void *buf)
+{
+	/** init dkey */
+	d_iov_set(&params->dkey, (void *)key, key_len);
+
+	/** init iod. */
+	params->akey_val = '0';
+	d_iov_set(&params->iod.iod_name, &params->akey_val, 1);
+	params->iod.iod_nr	= 1;
+	params->iod.iod_recxs	= NULL;
+	params->iod.iod_size	= size;
+	params->iod.iod_type	= DAOS_IOD_SINGLE;
+
+	/** init sgl */
+	if (buf && size) {
+		d_iov_set(&params->iov, buf, size);
+		params->sgl.sg_iovs = &params->iov;
+		params->sgl.sg_nr = 1;
+	}
+}
+
+static int
+kv_ent_put_cb(tse_task_t *task, void *data)
+{
+	daos_kv_ent_t *ent = *((daos_kv_ent_t **)data);
+
+	ent->kve_rc = task->dt_result;
+	return 0;
+}
+
+static int
+kv_ent_get_cb(tse_task_t *task, void *data)
+{
+	daos_kv_ent_t		*ent = *((daos_kv_ent_t **)data);
+	daos_obj_fetch_t	*args = daos_task_get_args(task);
+
+	ent->kve_rc = task->dt_result;
+	ent->kve_size = args->iods[0].iod_size;
+	return 0;
+}
+
+/**
+ * Issue one update/fetch task per entry, all of them being dependencies of
+ * the upper task which thus completes once the whole batch is done. Keys
+ * can't be packed per target, because object RPCs carry a single dkey.
+ */
+static int
+kv_multi(tse_task_t *task, bool put)
+{
+	daos_kv_multi_t		*args = daos_task_get_args(task);
+	struct dc_kv		*kv = NULL;
+	struct io_params	*params = NULL;
+	d_list_t		 io_task_list;
+	unsigned int		 i;
+	int			 rc;
+
+	D_INIT_LIST_HEAD(&io_task_list);
+
+	if (args->nr == 0) {
+		tse_task_complete(task, 0);
+		return 0;
+	}
+	if (args->ents == NULL)
+		D_GOTO(err_task, rc = -DER_INVAL);
+
+	kv = kv_hdl2ptr(args->oh);
+	if (kv == NULL)
+		D_GOTO(err_task, rc = -DER_NO_HDL);
+
+	D_ALLOC_ARRAY(params, args->nr);
+	if (params == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	for (i = 0; i < args->nr; i++) {
+		daos_kv_ent_t	*ent = &args->ents[i];
+		tse_task_t	*io_task;
+
+		if (ent->kve_key == NULL)
+			D_GOTO(err_list, rc = -DER_INVAL);
+		if (put && (ent->kve_size == 0 || ent->kve_buf == NULL))
+			D_GOTO(err_list, rc = -DER_INVAL);
+
+		kv_io_params_init(&params[i], ent->kve_key,
+				  strlen(ent->kve_key), ent->kve_size,
+				  ent->kve_buf);
+		ent->kve_rc = 0;
+
+		if (put) {
+			daos_obj_update_t *update_args;
+
+			rc = daos_task_create(DAOS_OPC_OBJ_UPDATE,
+					      tse_task2sched(task), 0, NULL,
+					      &io_task);
+			if (rc != 0)
+				D_GOTO(err_list, rc);
+
+			update_args = daos_task_get_args(io_task);
+			update_args->oh		= kv->daos_oh;
+			update_args->th		= args->th;
+			update_args->flags	= args->flags;
+			update_args->dkey	= &params[i].dkey;
+			update_args->nr		= 1;
+			update_args->iods	= &params[i].iod;
+			update_args->sgls	= &params[i].sgl;
+		} else {
+			daos_obj_fetch_t *fetch_args;
+
+			rc = daos_task_create(DAOS_OPC_OBJ_FETCH,
+					      tse_task2sched(task), 0, NULL,
+					      &io_task);
+			if (rc != 0)
+				D_GOTO(err_list, rc);
+
+			fetch_args = daos_task_get_args(io_task);
+			fetch_args->oh		= kv->daos_oh;
+			fetch_args->th		= args->th;
+			fetch_args->flags	= args->flags;
+			fetch_args->dkey	= &params[i].dkey;
+			fetch_args->nr		= 1;
+			fetch_args->iods	= &params[i].iod;
+			if (ent->kve_buf && ent->kve_size)
+				fetch_args->sgls = &params[i].sgl;
+		}
+		tse_task_list_add(io_task, &io_task_list);
+
+		rc = tse_task_register_comp_cb(io_task, put ? kv_ent_put_cb :
+					       kv_ent_get_cb, &ent,
+					       sizeof(ent));
+		if (rc != 0)
+			D_GOTO(err_list, rc);
+
+		rc = tse_task_register_deps(task, 1, &io_task);
+		if (rc != 0)
+			D_GOTO(err_list, rc);
+	}
+
+	rc = tse_task_register_comp_cb(task, free_io_params_cb, &params,
+				       sizeof(params));
+	if (rc != 0)
+		D_GOTO(err_list, rc);
+
+	tse_task_list_sched(&io_task_list, false);
+	tse_sched_progress(tse_task2sched(task));
+	kv_decref(kv);
+
+	return 0;
+
+err_list:
+	tse_task_list_abort(&io_task_list, rc);
+err_task:
+	D_FREE(params);
+	tse_task_complete(task, rc);
+	if (kv)
+		kv_decref(kv);
+	return rc;
+}
+
+int
+dc_kv_put_multi(tse_task_t *task)
+{
+	return kv_multi(task, true);
+}
+
+int
+dc_kv_get_multi(tse_task_t *task)
+{
+	return kv_multi(task, false);
+}
+
+struct kv_scan_params {
+	/** upper scan task */
+	tse_task_t		*ptask;
+	daos_kv_filter_t	 filter;
+	size_t			 prefix_len;
+	/** per listed key, whether it passed the key predicates */
+	bool			*match;
+	/** per listed key, value size probe */
+	struct io_params	*probes;
+};
+
+static bool
+kv_scan_size_filter(struct kv_scan_params *sp)
+{
+	return sp->filter.kf_size_min != 0 || sp->filter.kf_size_max != 0;
+}
+
+/**
+ * Evaluate the key predicates on the listed keys and, if the value size
+ * matters, issue a size-only fetch for each surviving key. Those fetches are
+ * added as dependencies of the upper task.
+ */
+static int
+kv_scan_list_cb(tse_task_t *task, void *data)
+{
+	struct kv_scan_params	*sp = *((struct kv_scan_params **)data);
+	daos_kv_scan_t		*args = daos_task_get_args(sp->ptask);
+	struct dc_kv		*kv;
+	char			*buf;
+	size_t			 off = 0;
+	uint32_t		 nr = *args->nr;
+	uint32_t		 i;
+	int			 rc = 0;
+
+	if (task->dt_result != 0 || nr == 0)
+		return task->dt_result;
+
+	D_ALLOC_ARRAY(sp->match, nr);
+	if (sp->match == NULL)
+		return -DER_NOMEM;
+
+	buf = args->sgl->sg_iovs[0].iov_buf;
+	for (i = 0; i < nr; i++) {
+		size_t len = args->kds[i].kd_key_len;
+
+		sp->match[i] = len >= sp->prefix_len &&
+			       memcmp(buf + off, sp->filter.kf_prefix,
+				      sp->prefix_len) == 0;
+		off += len;
+	}
+
+	if (!kv_scan_size_filter(sp))
+		return 0;
+
+	D_ALLOC_ARRAY(sp->probes, nr);
+	if (sp->probes == NULL)
+		return -DER_NOMEM;
+
+	kv = kv_hdl2ptr(args->oh);
+	if (kv == NULL)
+		return -DER_NO_HDL;
+
+	for (i = 0, off = 0; i < nr; off += args->kds[i].kd_key_len, i++) {
+		daos_obj_fetch_t	*fetch_args;
+		tse_task_t		*fetch_task;
+
+		if (!sp->match[i])
+			continue;
+
+		kv_io_params_init(&sp->probes[i], buf + off,
+				  args->kds[i].kd_key_len, DAOS_REC_ANY, NULL);
+
+		rc = daos_task_create(DAOS_OPC_OBJ_FETCH, tse_task2sched(task),
+				      0, NULL, &fetch_task);
+		if (rc != 0)
+			break;
+
+		fetch_args = daos_task_get_args(fetch_task);
+		fetch_args->oh		= kv->daos_oh;
+		fetch_args->th		= args->th;
+		fetch_args->dkey	= &sp->probes[i].dkey;
+		fetch_args->nr		= 1;
+		fetch_args->iods	= &sp->probes[i].iod;
+
+		rc = tse_task_register_deps(sp->ptask, 1, &fetch_task);
+		if (rc != 0) {
+			tse_task_complete(fetch_task, rc);
+			break;
+		}
+
+		rc = tse_task_schedule(fetch_task, false);
+		if (rc != 0)
+			break;
+	}
+	kv_decref(kv);
+
+	return rc;
+}
+
+/** drop non-matching keys from the user key descriptors and buffer */
+static int
+kv_scan_fini_cb(tse_task_t *task, void *data)
+{
+	struct kv_scan_params	*sp = *((struct kv_scan_params **)data);
+	daos_kv_scan_t		*args = daos_task_get_args(task);
+	daos_kv_filter_t	*filter = &sp->filter;
+	char			*buf;
+	size_t			 src = 0;
+	size_t			 dst = 0;
+	uint32_t		 i;
+	uint32_t		 j = 0;
+
+	if (task->dt_result != 0 || sp->match == NULL)
+		goto out;
+
+	buf = args->sgl->sg_iovs[0].iov_buf;
+	for (i = 0; i < *args->nr; i++) {
+		size_t	len = args->kds[i].kd_key_len;
+		bool	keep = sp->match[i];
+
+		if (keep && sp->probes != NULL) {
+			daos_size_t size = sp->probes[i].iod.iod_size;
+
+			keep = size >= filter->kf_size_min &&
+			       (filter->kf_size_max == 0 ||
+				size <= filter->kf_size_max);
+		}
+
+		if (keep) {
+			if (dst != src)
+				memmove(buf + dst, buf + src, len);
+			args->kds[j++] = args->kds[i];
+			dst += len;
+		}
+		src += len;
+	}
+	*args->nr = j;
+
+out:
+	D_FREE(sp->match);
+	D_FREE(sp->probes);
+	D_FREE(sp);
+	return 0;
+}
+
+int
+dc_kv_scan(tse_task_t *task)
+{
+	daos_kv_scan_t		*args = daos_task_get_args(task);
+	struct dc_kv		*kv = NULL;
+	struct kv_scan_params	*sp = NULL;
+	daos_obj_list_dkey_t	*list_args;
+	tse_task_t		*list_task = NULL;
+	int			 rc;
+
+	if (args->nr == NULL || args->kds == NULL || args->sgl == NULL ||
+	    args->sgl->sg_nr != 1 || args->anchor == NULL)
+		D_GOTO(err_task, rc = -DER_INVAL);
+
+	kv = kv_hdl2ptr(args->oh);
+	if (kv == NULL)
+		D_GOTO(err_task, rc = -DER_NO_HDL);
+
+	D_ALLOC_PTR(sp);
+	if (sp == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	sp->ptask = task;
+	if (args->filter != NULL) {
+		sp->filter = *args->filter;
+		if (sp->filter.kf_size_max != 0 &&
+		    sp->filter.kf_size_max < sp->filter.kf_size_min)
+			D_GOTO(err_task, rc = -DER_INVAL);
+	}
+	if (sp->filter.kf_prefix != NULL)
+		sp->prefix_len = strlen(sp->filter.kf_prefix);
+
+	rc = daos_task_create(DAOS_OPC_OBJ_LIST_DKEY, tse_task2sched(task),
+			      0, NULL, &list_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	list_args = daos_task_get_args(list_task);
+	list_args->oh		= kv->daos_oh;
+	list_args->th		= args->th;
+	list_args->nr		= args->nr;
+	list_args->sgl		= args->sgl;
+	list_args->kds		= args->kds;
+	list_args->dkey_anchor	= args->anchor;
+
+	/** no predicate, behave like daos_kv_list() */
+	if (args->filter != NULL) {
+		rc = tse_task_register_comp_cb(list_task, kv_scan_list_cb, &sp,
+					       sizeof(sp));
+		if (rc != 0)
+			D_GOTO(err_task, rc);
+	}
+
+	rc = tse_task_register_deps(task, 1, &list_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_register_comp_cb(task, kv_scan_fini_cb, &sp, sizeof(sp));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_schedule(list_task, false);
+	if (rc != 0) {
+		/** sp is freed by kv_scan_fini_cb */
+		sp = NULL;
+		D_GOTO(err_task, rc);
+	}
+
+	tse_sched_progress(tse_task2sched(task));
+	kv_decref(kv);
+
+	return 0;
+
+err_task:
+	D_FREE(sp);
+	if (list_task)
+		tse_task_complete(list_task, rc);
+	tse_task_complete(task, rc);
+	if (kv)
+		kv_decref(kv);
+	return rc;
+}
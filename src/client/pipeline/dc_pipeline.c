@@ -0,0 +1,540 @@
+/**
+ * (C) Copyright 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of daos
+ *
+ * src/client/pipeline/dc_pipeline.c
+ *
+ * Pipelines are evaluated by the client library: dkeys are enumerated, the
+ * akeys referenced by the conditions and aggregations are fetched for the whole
+ * batch with concurrent tasks, then only the matching dkeys are handed back.
+ * This is a client-side fallback, nothing is filtered by the engine and the
+ * fetched values of non-matching dkeys still cross the network.
+ */
+#define D_LOGFAC	DD_FAC(client)
+
+#include <math.h>
+#include <daos/common.h>
+#include <daos/tse.h>
+#include <daos/pipeline.h>
+#include <daos_api.h>
+#include <daos_pipeline.h>
+#include <daos_task.h>
+
+/** decoded single value */
+union pipe_val {
+	uint64_t	u;
+	int64_t		i;
+	double		d;
+};
+
+struct pipe_params {
+	/** upper pipeline task */
+	tse_task_t		*ptask;
+	/** number of akeys fetched per dkey */
+	uint32_t		 nr_iods;
+	/** per listed dkey, fetch IODs and buffers, nr_iods each */
+	daos_key_t		*dkeys;
+	daos_iod_t		*iods;
+	d_sg_list_t		*sgls;
+	d_iov_t			*iovs;
+	uint64_t		*vals;
+	/** per listed dkey, some value did not fit in 8 bytes */
+	bool			*skip;
+};
+
+static bool
+pipe_key_valid(const daos_key_t *key)
+{
+	return key->iov_buf != NULL && key->iov_len != 0;
+}
+
+int
+daos_pipeline_check(const daos_pipeline_t *pipeline)
+{
+	uint32_t i;
+
+	if (pipeline == NULL ||
+	    (pipeline->dp_nr_conds != 0 && pipeline->dp_conds == NULL) ||
+	    (pipeline->dp_nr_aggs != 0 && pipeline->dp_aggs == NULL))
+		return -DER_INVAL;
+
+	for (i = 0; i < pipeline->dp_nr_conds; i++) {
+		const daos_pipeline_cond_t *cond = &pipeline->dp_conds[i];
+
+		if (!pipe_key_valid(&cond->pc_akey) ||
+		    cond->pc_type > DAOS_PIPELINE_DOUBLE ||
+		    cond->pc_cmp > DAOS_PIPELINE_GE) {
+			D_ERROR("invalid pipeline condition %u\n", i);
+			return -DER_INVAL;
+		}
+	}
+
+	for (i = 0; i < pipeline->dp_nr_aggs; i++) {
+		const daos_pipeline_agg_t *agg = &pipeline->dp_aggs[i];
+
+		if (agg->pa_op > DAOS_PIPELINE_MAX ||
+		    (agg->pa_op != DAOS_PIPELINE_COUNT &&
+		     (!pipe_key_valid(&agg->pa_akey) ||
+		      agg->pa_type > DAOS_PIPELINE_DOUBLE))) {
+			D_ERROR("invalid pipeline aggregation %u\n", i);
+			return -DER_INVAL;
+		}
+	}
+
+	return 0;
+}
+
+void
+daos_pipeline_stats_init(const daos_pipeline_t *pipeline,
+			 daos_pipeline_stats_t *stats)
+{
+	uint32_t i;
+
+	stats->ps_nr_scanned = 0;
+	stats->ps_nr_matched = 0;
+	for (i = 0; i < pipeline->dp_nr_aggs; i++) {
+		switch (pipeline->dp_aggs[i].pa_op) {
+		case DAOS_PIPELINE_MIN:
+			stats->ps_aggs[i] = INFINITY;
+			break;
+		case DAOS_PIPELINE_MAX:
+			stats->ps_aggs[i] = -INFINITY;
+			break;
+		default:
+			stats->ps_aggs[i] = 0;
+			break;
+		}
+	}
+}
+
+/** number of akeys to fetch for each dkey */
+static uint32_t
+pipe_nr_iods(const daos_pipeline_t *pipeline)
+{
+	uint32_t nr = pipeline->dp_nr_conds;
+	uint32_t i;
+
+	for (i = 0; i < pipeline->dp_nr_aggs; i++)
+		if (pipeline->dp_aggs[i].pa_op != DAOS_PIPELINE_COUNT)
+			nr++;
+	return nr;
+}
+
+static int
+pipe_decode(daos_pipeline_type_t type, const daos_iod_t *iod,
+	    const uint64_t *buf, union pipe_val *val)
+{
+	switch (type) {
+	case DAOS_PIPELINE_UINT:
+		switch (iod->iod_size) {
+		case 1:
+			val->u = *(const uint8_t *)buf;
+			return 0;
+		case 2:
+			val->u = *(const uint16_t *)buf;
+			return 0;
+		case 4:
+			val->u = *(const uint32_t *)buf;
+			return 0;
+		case 8:
+			val->u = *buf;
+			return 0;
+		}
+		break;
+	case DAOS_PIPELINE_INT:
+		switch (iod->iod_size) {
+		case 1:
+			val->i = *(const int8_t *)buf;
+			return 0;
+		case 2:
+			val->i = *(const int16_t *)buf;
+			return 0;
+		case 4:
+			val->i = *(const int32_t *)buf;
+			return 0;
+		case 8:
+			val->i = *(const int64_t *)buf;
+			return 0;
+		}
+		break;
+	case DAOS_PIPELINE_DOUBLE:
+		switch (iod->iod_size) {
+		case 4:
+			val->d = *(const float *)buf;
+			return 0;
+		case 8:
+			val->d = *(const double *)buf;
+			return 0;
+		}
+		break;
+	}
+	/** missing akey or unexpected size */
+	return -DER_INVAL;
+}
+
+static double
+pipe_val2d(daos_pipeline_type_t type, const union pipe_val *val)
+{
+	switch (type) {
+	case DAOS_PIPELINE_UINT:
+		return val->u;
+	case DAOS_PIPELINE_INT:
+		return val->i;
+	default:
+		return val->d;
+	}
+}
+
+#define PIPE_CMP(a, b)	((a) < (b) ? -1 : (a) > (b) ? 1 : 0)
+
+static bool
+pipe_cond_eval(const daos_pipeline_cond_t *cond, const union pipe_val *val)
+{
+	int c;
+
+	switch (cond->pc_type) {
+	case DAOS_PIPELINE_UINT:
+		c = PIPE_CMP(val->u, cond->pc_const.u);
+		break;
+	case DAOS_PIPELINE_INT:
+		c = PIPE_CMP(val->i, cond->pc_const.i);
+		break;
+	default:
+		if (isnan(val->d) || isnan(cond->pc_const.d))
+			return cond->pc_cmp == DAOS_PIPELINE_NE;
+		c = PIPE_CMP(val->d, cond->pc_const.d);
+		break;
+	}
+
+	switch (cond->pc_cmp) {
+	case DAOS_PIPELINE_EQ:
+		return c == 0;
+	case DAOS_PIPELINE_NE:
+		return c != 0;
+	case DAOS_PIPELINE_LT:
+		return c < 0;
+	case DAOS_PIPELINE_LE:
+		return c <= 0;
+	case DAOS_PIPELINE_GT:
+		return c > 0;
+	default:
+		return c >= 0;
+	}
+}
+
+/** evaluate the conditions on dkey \a k, then aggregate it if matching */
+static bool
+pipe_eval(struct pipe_params *pp, const daos_pipeline_t *pipeline,
+	  daos_pipeline_stats_t *stats, uint32_t k)
+{
+	daos_iod_t	*iods = NULL;
+	uint64_t	*vals = NULL;
+	union pipe_val	 val;
+	uint32_t	 i;
+	uint32_t	 j;
+
+	if (pp->nr_iods != 0) {
+		if (pp->skip[k])
+			return false;
+		iods = &pp->iods[k * pp->nr_iods];
+		vals = &pp->vals[k * pp->nr_iods];
+	}
+
+	for (i = 0; i < pipeline->dp_nr_conds; i++) {
+		const daos_pipeline_cond_t *cond = &pipeline->dp_conds[i];
+
+		if (pipe_decode(cond->pc_type, &iods[i], &vals[i], &val) != 0 ||
+		    !pipe_cond_eval(cond, &val))
+			return false;
+	}
+
+	if (stats == NULL)
+		return true;
+
+	/** IODs of the aggregations follow the ones of the conditions */
+	for (i = 0, j = pipeline->dp_nr_conds; i < pipeline->dp_nr_aggs; i++) {
+		const daos_pipeline_agg_t	*agg = &pipeline->dp_aggs[i];
+		double				*res = &stats->ps_aggs[i];
+		double				 d;
+
+		if (agg->pa_op == DAOS_PIPELINE_COUNT) {
+			*res += 1;
+			continue;
+		}
+
+		if (pipe_decode(agg->pa_type, &iods[j], &vals[j], &val) != 0) {
+			j++;
+			continue;
+		}
+		j++;
+
+		d = pipe_val2d(agg->pa_type, &val);
+		switch (agg->pa_op) {
+		case DAOS_PIPELINE_SUM:
+			*res += d;
+			break;
+		case DAOS_PIPELINE_MIN:
+			if (d < *res)
+				*res = d;
+			break;
+		default:
+			if (d > *res)
+				*res = d;
+			break;
+		}
+	}
+
+	return true;
+}
+
+static void
+pipe_params_free(struct pipe_params *pp)
+{
+	D_FREE(pp->dkeys);
+	D_FREE(pp->iods);
+	D_FREE(pp->sgls);
+	D_FREE(pp->iovs);
+	D_FREE(pp->vals);
+	D_FREE(pp->skip);
+	D_FREE(pp);
+}
+
+static int
+pipe_params_alloc(struct pipe_params *pp, uint32_t nr)
+{
+	size_t n = (size_t)nr * pp->nr_iods;
+
+	D_ALLOC_ARRAY(pp->dkeys, nr);
+	D_ALLOC_ARRAY(pp->skip, nr);
+	D_ALLOC_ARRAY(pp->iods, n);
+	D_ALLOC_ARRAY(pp->sgls, n);
+	D_ALLOC_ARRAY(pp->iovs, n);
+	D_ALLOC_ARRAY(pp->vals, n);
+	if (pp->dkeys == NULL || pp->skip == NULL || pp->iods == NULL ||
+	    pp->sgls == NULL || pp->iovs == NULL || pp->vals == NULL)
+		return -DER_NOMEM;
+	return 0;
+}
+
+static void
+pipe_iod_init(struct pipe_params *pp, size_t idx, const daos_key_t *akey)
+{
+	daos_iod_t	*iod = &pp->iods[idx];
+	d_sg_list_t	*sgl = &pp->sgls[idx];
+
+	iod->iod_name	= *akey;
+	iod->iod_type	= DAOS_IOD_SINGLE;
+	iod->iod_size	= sizeof(pp->vals[idx]);
+	iod->iod_nr	= 1;
+	iod->iod_recxs	= NULL;
+
+	d_iov_set(&pp->iovs[idx], &pp->vals[idx], sizeof(pp->vals[idx]));
+	sgl->sg_nr	= 1;
+	sgl->sg_iovs	= &pp->iovs[idx];
+}
+
+/** a value larger than the 8-byte buffer makes the dkey a non-match */
+static int
+pipe_fetch_cb(tse_task_t *task, void *data)
+{
+	bool *skip = *((bool **)data);
+
+	if (task->dt_result == -DER_REC2BIG) {
+		*skip = true;
+		task->dt_result = 0;
+	}
+	return 0;
+}
+
+/**
+ * Issue one fetch of all the akeys referenced by the pipeline for each listed
+ * dkey. Those fetches are added as dependencies of the upper task.
+ */
+static int
+pipe_list_cb(tse_task_t *task, void *data)
+{
+	struct pipe_params	*pp = *((struct pipe_params **)data);
+	daos_pipeline_run_t	*args = daos_task_get_args(pp->ptask);
+	const daos_pipeline_t	*pipeline = args->pipeline;
+	char			*buf;
+	size_t			 off = 0;
+	uint32_t		 nr = *args->nr;
+	uint32_t		 k;
+	int			 rc;
+
+	if (task->dt_result != 0 || nr == 0 || pp->nr_iods == 0)
+		return task->dt_result;
+
+	rc = pipe_params_alloc(pp, nr);
+	if (rc != 0)
+		return rc;
+
+	buf = args->sgl->sg_iovs[0].iov_buf;
+	for (k = 0; k < nr; off += args->kds[k].kd_key_len, k++) {
+		daos_obj_fetch_t	*fetch_args;
+		tse_task_t		*fetch_task;
+		size_t			 idx = (size_t)k * pp->nr_iods;
+		bool			*skip = &pp->skip[k];
+		uint32_t		 i;
+
+		d_iov_set(&pp->dkeys[k], buf + off, args->kds[k].kd_key_len);
+		for (i = 0; i < pipeline->dp_nr_conds; i++)
+			pipe_iod_init(pp, idx++,
+				      &pipeline->dp_conds[i].pc_akey);
+		for (i = 0; i < pipeline->dp_nr_aggs; i++) {
+			if (pipeline->dp_aggs[i].pa_op == DAOS_PIPELINE_COUNT)
+				continue;
+			pipe_iod_init(pp, idx++, &pipeline->dp_aggs[i].pa_akey);
+		}
+
+		rc = daos_task_create(DAOS_OPC_OBJ_FETCH, tse_task2sched(task),
+				      0, NULL, &fetch_task);
+		if (rc != 0)
+			break;
+
+		idx = (size_t)k * pp->nr_iods;
+		fetch_args = daos_task_get_args(fetch_task);
+		fetch_args->oh		= args->oh;
+		fetch_args->th		= args->th;
+		fetch_args->dkey	= &pp->dkeys[k];
+		fetch_args->nr		= pp->nr_iods;
+		fetch_args->iods	= &pp->iods[idx];
+		fetch_args->sgls	= &pp->sgls[idx];
+
+		rc = tse_task_register_comp_cb(fetch_task, pipe_fetch_cb, &skip,
+					       sizeof(skip));
+		if (rc != 0) {
+			tse_task_complete(fetch_task, rc);
+			break;
+		}
+
+		rc = tse_task_register_deps(pp->ptask, 1, &fetch_task);
+		if (rc != 0) {
+			tse_task_complete(fetch_task, rc);
+			break;
+		}
+
+		rc = tse_task_schedule(fetch_task, false);
+		if (rc != 0)
+			break;
+	}
+
+	return rc;
+}
+
+/** evaluate the listed dkeys and drop the non-matching ones */
+static int
+pipe_fini_cb(tse_task_t *task, void *data)
+{
+	struct pipe_params	*pp = *((struct pipe_params **)data);
+	daos_pipeline_run_t	*args = daos_task_get_args(task);
+	char			*buf;
+	size_t			 src = 0;
+	size_t			 dst = 0;
+	uint32_t		 k;
+	uint32_t		 j = 0;
+
+	if (task->dt_result != 0 || (pp->nr_iods != 0 && pp->skip == NULL))
+		goto out;
+
+	buf = args->sgl->sg_iovs[0].iov_buf;
+	for (k = 0; k < *args->nr; k++) {
+		size_t len = args->kds[k].kd_key_len;
+
+		if (pipe_eval(pp, args->pipeline, args->stats, k)) {
+			if (dst != src)
+				memmove(buf + dst, buf + src, len);
+			args->kds[j++] = args->kds[k];
+			dst += len;
+		}
+		src += len;
+	}
+
+	if (args->stats != NULL) {
+		args->stats->ps_nr_scanned += *args->nr;
+		args->stats->ps_nr_matched += j;
+	}
+	*args->nr = j;
+
+out:
+	pipe_params_free(pp);
+	return 0;
+}
+
+int
+dc_pipeline_run(tse_task_t *task)
+{
+	daos_pipeline_run_t	*args = daos_task_get_args(task);
+	struct pipe_params	*pp = NULL;
+	daos_obj_list_dkey_t	*list_args;
+	tse_task_t		*list_task = NULL;
+	int			 rc;
+
+	if (args->nr == NULL || args->kds == NULL || args->sgl == NULL ||
+	    args->sgl->sg_nr != 1 || args->anchor == NULL)
+		D_GOTO(err_task, rc = -DER_INVAL);
+
+	rc = daos_pipeline_check(args->pipeline);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	if (args->pipeline->dp_nr_aggs != 0 &&
+	    (args->stats == NULL || args->stats->ps_aggs == NULL))
+		D_GOTO(err_task, rc = -DER_INVAL);
+
+	D_ALLOC_PTR(pp);
+	if (pp == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	pp->ptask	= task;
+	pp->nr_iods	= pipe_nr_iods(args->pipeline);
+
+	rc = daos_task_create(DAOS_OPC_OBJ_LIST_DKEY, tse_task2sched(task),
+			      0, NULL, &list_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	list_args = daos_task_get_args(list_task);
+	list_args->oh		= args->oh;
+	list_args->th		= args->th;
+	list_args->nr		= args->nr;
+	list_args->sgl		= args->sgl;
+	list_args->kds		= args->kds;
+	list_args->dkey_anchor	= args->anchor;
+
+	rc = tse_task_register_comp_cb(list_task, pipe_list_cb, &pp,
+				       sizeof(pp));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_register_deps(task, 1, &list_task);
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_register_comp_cb(task, pipe_fini_cb, &pp, sizeof(pp));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_schedule(list_task, false);
+	if (rc != 0) {
+		/** pp is freed by pipe_fini_cb */
+		pp = NULL;
+		D_GOTO(err_task, rc);
+	}
+
+	tse_sched_progress(tse_task2sched(task));
+
+	return 0;
+
+err_task:
+	if (list_task)
+		tse_task_complete(list_task, rc);
+	if (pp != NULL)
+		pipe_params_free(pp);
+	tse_task_complete(task, rc);
+	return rc;
+}
@@ -0,0 +1,185 @@
+# (C) Copyright 2021 Intel Corporation.
+#
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+"""
+PyDAOS dataset loader reading samples directly from a DFS container.
+
+Samples stored as files of a DFS directory are exposed as an iterable
+dataset that can be fed to a PyTorch DataLoader (or consumed directly, e.g.
+via numpy). Files are read by a pool of prefetch threads straight into a set
+of reusable buffers, bypassing dfuse and the kernel page cache.
+"""
+
+import collections
+import concurrent.futures
+import os
+import random
+
+# pylint: disable=relative-beyond-top-level
+from . import pydaos_shim
+# pylint: enable=relative-beyond-top-level
+
+from . import DAOS_MAGIC
+from . import PyDError
+from . import DaosClient
+
+try:
+    import torch.utils.data
+    _DatasetBase = torch.utils.data.IterableDataset
+except ImportError:
+    torch = None
+    _DatasetBase = object
+
+
+class DFSDataset(_DatasetBase):
+    # pylint: disable=too-many-instance-attributes
+    """
+    Iterable dataset over the files of a DFS directory.
+
+    Attributes
+    ----------
+    pool : string
+        Pool label or UUID string.
+    cont : string
+        POSIX container label or UUID string.
+    path : string
+        Directory of the container holding one sample per file.
+    shuffle : bool
+        Shuffle the sample order at every epoch.
+    seed : int
+        Base seed of the shuffle, the epoch number is added to it.
+    prefetch : int
+        Number of samples read ahead of the consumer.
+    threads : int
+        Number of threads issuing the reads.
+    buffer_size : int
+        Initial size of the read buffers, grown on demand.
+    transform : callable
+        Applied to the memoryview of each sample.
+
+    Each sample is yielded as (name, data) where data is a memoryview over one
+    of the prefetch buffers (or the result of transform). Buffers are recycled
+    as soon as the next sample is requested, so the consumer has to copy or
+    convert the data (e.g. numpy.frombuffer(...).copy(), torch.tensor) before
+    moving on.
+
+    When used with a multi-worker PyTorch DataLoader, the directory listing
+    is split between the workers.
+
+    Methods
+    -------
+    set_epoch(epoch)
+        Select the shuffle order for the next iteration.
+    close()
+        Unmount the container.
+    """
+
+    # Number of entries fetched per dfs_readdir() call.
+    list_batch = 1024
+
+    def __init__(self, pool, cont, path='/', shuffle=True, seed=0,
+                 prefetch=16, threads=8, buffer_size=1024*1024,
+                 transform=None):
+        # pylint: disable=too-many-arguments
+        super().__init__()
+        self._dc = DaosClient()
+        self.pool = pool
+        self.cont = cont
+        self.path = path
+        self.shuffle = shuffle
+        self.seed = seed
+        self.prefetch = max(prefetch, 1)
+        self.threads = max(threads, 1)
+        self.buffer_size = buffer_size
+        self.transform = transform
+        self.epoch = 0
+        self._hdl = None
+
+        (ret, hdl) = pydaos_shim.dfs_connect(DAOS_MAGIC, pool, cont)
+        if ret != pydaos_shim.DER_SUCCESS:
+            raise PyDError("failed to mount DFS container", ret)
+        self._hdl = hdl
+
+        self._names = []
+        ret = pydaos_shim.dfs_list(DAOS_MAGIC, self._hdl, path, self._names,
+                                   self.list_batch)
+        if ret != pydaos_shim.DER_SUCCESS:
+            raise PyDError("failed to list dataset directory", ret)
+        # readdir order depends on the key hashing, make it reproducible
+        self._names.sort()
+
+    def close(self):
+        """Unmount the container."""
+        if self._hdl is None:
+            return
+        ret = pydaos_shim.dfs_disconnect(DAOS_MAGIC, self._hdl)
+        self._hdl = None
+        if ret != pydaos_shim.DER_SUCCESS:
+            raise PyDError("failed to unmount DFS container", ret)
+
+    def __del__(self):
+        if not pydaos_shim or self._hdl is None:
+            return
+        self.close()
+
+    def __len__(self):
+        return len(self._names)
+
+    def set_epoch(self, epoch):
+        """Select the shuffle order for the next iteration."""
+        self.epoch = epoch
+
+    def _order(self):
+        names = list(self._names)
+        if self.shuffle:
+            random.Random(self.seed + self.epoch).shuffle(names)
+        if torch is not None:
+            info = torch.utils.data.get_worker_info()
+            if info is not None:
+                names = names[info.id::info.num_workers]
+        return names
+
+    def _read(self, name, buf):
+        path = os.path.join(self.path, name)
+        (ret, size, rsize) = pydaos_shim.dfs_read(DAOS_MAGIC, self._hdl, path,
+                                                  buf)
+        if ret == pydaos_shim.DER_SUCCESS and size > len(buf):
+            # sample bigger than the buffer, grow it and keep it in the pool
+            buf = bytearray(size)
+            (ret, size, rsize) = pydaos_shim.dfs_read(DAOS_MAGIC, self._hdl,
+                                                      path, buf)
+        if ret != pydaos_shim.DER_SUCCESS:
+            raise PyDError("failed to read {}".format(path), ret)
+        return (name, buf, rsize)
+
+    def __iter__(self):
+        names = iter(self._order())
+        # one buffer per in-flight read plus the one held by the consumer
+        free = [bytearray(self.buffer_size) for _ in range(self.prefetch + 1)]
+        pending = collections.deque()
+        held = None
+
+        with concurrent.futures.ThreadPoolExecutor(self.threads) as pool:
+            try:
+                for name in names:
+                    pending.append(pool.submit(self._read, name, free.pop()))
+                    if len(pending) == self.prefetch:
+                        break
+
+                while pending:
+                    (name, buf, size) = pending.popleft().result()
+                    if held is not None:
+                        free.append(held)
+                    name_next = next(names, None)
+                    if name_next is not None:
+                        pending.append(pool.submit(self._read, name_next,
+                                                   free.pop()))
+                    held = buf
+                    data = memoryview(buf)[:size]
+                    if self.transform is not None:
+                        data = self.transform(data)
+                    yield (name, data)
+            finally:
+                for fut in pending:
+                    fut.cancel()
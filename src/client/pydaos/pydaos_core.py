@@ -6,6 +6,7 @@
 PyDAOS Module allowing global access to the DAOS containers and objects.
 """
 
+import asyncio
 import enum
 
 # pylint: disable=relative-beyond-top-level
@@ -225,7 +226,12 @@ class DDict(_DObj):
     Key-value pair can be inserted/looked up once at a time (see put/get) or
     in bulk (see bput/bget) taking a python dict as an input. The bulk
     operations are issued in parallel (up to 16 operations in flight) to
-    maximize the operation rate.
+    maximize the operation rate. The bulk_put/bulk_get variants keep a larger,
+    configurable number of operations in flight (see 'inflight').
+    Values can also be any object supporting the buffer protocol (bytearray,
+    memoryview, numpy array, ...). Such values are sent by bput without any
+    copy and, when passed to bget, are used as the destination buffer of the
+    fetch (zero-copy read).
     Key-value pair are deleted via the put/bput operations by setting the value
     to either None or the empty string. Once deleted, the key won't be reported
     during iteration.
@@ -262,6 +268,15 @@ class DDict(_DObj):
         Put operations are issued in parallel over the network.
         If the value is set to None or an empty string, the key is deleted from
         the DAOS dictionary.
+    bulk_get(ddict, value_size=None, inflight=None)
+        Same as bget with up to 'inflight' operations in flight.
+    bulk_put(ddict, inflight=None)
+        Same as bput with up to 'inflight' operations in flight.
+    bulk_get_async(ddict, value_size=None, inflight=None)
+    bulk_put_async(ddict, inflight=None)
+        Coroutine versions of bulk_get/bulk_put for asyncio. The operations
+        run in the loop default executor and the GIL is released while
+        waiting for completions, so the event loop keeps running.
     dump()
         Fetch all the key-value pairs and return them in a python dictionary.
     """
@@ -270,6 +285,9 @@ class DDict(_DObj):
     # then it'll require two round trips rather than one.
     value_size = 1024*1024
 
+    # Number of operations kept in flight by bulk_get/bulk_put.
+    inflight = 256
+
     def _open(self, hdl):
         (ret, oh) = pydaos_shim.kv_open(DAOS_MAGIC, hdl, self.hi, self.lo, 0)
         if ret != pydaos_shim.DER_SUCCESS:
@@ -327,6 +345,40 @@ class DDict(_DObj):
         if ret != pydaos_shim.DER_SUCCESS:
             raise PyDError("failed to store KV value", ret)
 
+    def bulk_get(self, d, value_size=None, inflight=None):
+        """Bulk get with up to 'inflight' operations in flight."""
+        if d is None:
+            return d
+        if value_size is None:
+            value_size = self.value_size
+        if inflight is None:
+            inflight = self.inflight
+        ret = pydaos_shim.kv_get(DAOS_MAGIC, self.oh, d, value_size, inflight)
+        if ret != pydaos_shim.DER_SUCCESS:
+            raise PyDError("failed to retrieve KV value", ret)
+        return d
+
+    def bulk_put(self, d, inflight=None):
+        """Bulk put with up to 'inflight' operations in flight."""
+        if d is None:
+            return
+        if inflight is None:
+            inflight = self.inflight
+        ret = pydaos_shim.kv_put(DAOS_MAGIC, self.oh, d, inflight)
+        if ret != pydaos_shim.DER_SUCCESS:
+            raise PyDError("failed to store KV value", ret)
+
+    async def bulk_get_async(self, d, value_size=None, inflight=None):
+        """Coroutine version of bulk_get."""
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(None, self.bulk_get, d, value_size,
+                                          inflight)
+
+    async def bulk_put_async(self, d, inflight=None):
+        """Coroutine version of bulk_put."""
+        loop = asyncio.get_running_loop()
+        await loop.run_in_executor(None, self.bulk_put, d, inflight)
+
     def dump(self):
         """Fetch all the key-value pairs, return them in a python dictionary."""
         # leverage python iterator, see __iter__/__next__ below
@@ -11,6 +11,7 @@
 #define PyString_AsString	PyBytes_AsString
 
 #include <Python.h>
+#include <fcntl.h>
 
 #include <daos_errno.h>
 #include <gurt/debug.h>
@@ -23,6 +24,8 @@
 #include <gurt/common.h>
 #include <daos_kv.h>
 #include <daos_uns.h>
+#include <daos_fs.h>
+#include <daos/common.h>
 
 #define PY_SHIM_MAGIC_NUMBER 0x7A89
 #define MAX_OID_HI ((1UL << 32) - 1)
@@ -601,7 +604,7 @@ __shim_handle__kv_close(PyObject *self, PyObject *args)
  * Implementation of kv functions
  */
 
-/** max number of concurrent put/get requests */
+/** default number of concurrent put/get requests */
 #define MAX_INFLIGHT 16
 
 struct kv_op {
@@ -610,9 +613,94 @@ struct kv_op {
 	char		*key;
 	char		*buf;
 	daos_size_t	 size;
-	daos_size_t	buf_size;
+	daos_size_t	 buf_size;
+	/** buffer the value is fetched into, either buf or view.buf */
+	char		*dst;
+	/** caller-supplied writable buffer, filled in place */
+	Py_buffer	 view;
+	bool		 has_view;
 };
 
+/**
+ * Wait for one event with the GIL released so that other python threads
+ * (e.g. an asyncio loop handing bulk operations to an executor) can make
+ * progress while we block on the network.
+ */
+static inline int
+kv_eq_poll(daos_handle_t eq, daos_event_t **evp)
+{
+	int rc;
+
+	Py_BEGIN_ALLOW_THREADS
+	rc = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, evp);
+	Py_END_ALLOW_THREADS
+
+	return rc;
+}
+
+/**
+ * Values exposing a writable buffer (bytearray, memoryview, numpy array, ...)
+ * are used as the destination of the fetch and filled without any copy.
+ */
+static inline bool
+kv_value_is_buffer(PyObject *value)
+{
+	return value != NULL && value != Py_None && !PyBytes_Check(value) &&
+	       !PyUnicode_Check(value) && PyObject_CheckBuffer(value);
+}
+
+static inline void
+kv_op_release(struct kv_op *op)
+{
+	if (!op->has_view)
+		return;
+	PyBuffer_Release(&op->view);
+	op->has_view = false;
+}
+
+static inline int
+kv_get_prep(struct kv_op *op, PyObject *value)
+{
+	if (kv_value_is_buffer(value)) {
+		if (PyObject_GetBuffer(value, &op->view, PyBUF_WRITABLE) != 0)
+			return -DER_INVAL;
+		op->has_view = true;
+		op->dst = op->view.buf;
+		op->size = op->view.len;
+		return 0;
+	}
+
+	if (op->buf == NULL) {
+		D_ALLOC(op->buf, op->buf_size);
+		if (op->buf == NULL)
+			return -DER_NOMEM;
+	}
+	op->dst = op->buf;
+	op->size = op->buf_size;
+	return 0;
+}
+
+static inline PyObject *
+kv_view2value(struct kv_op *op)
+{
+	PyObject	*mv;
+	PyObject	*flat;
+	PyObject	*val;
+
+	/** flat byte view of the caller buffer, trimmed to the value size */
+	mv = PyMemoryView_FromObject(op->view.obj);
+	if (mv == NULL)
+		return NULL;
+	flat = PyObject_CallMethod(mv, "cast", "s", "B");
+	Py_DECREF(mv);
+	if (flat == NULL)
+		return NULL;
+	val = PySequence_GetSlice(flat, 0, op->size);
+	Py_DECREF(flat);
+
+	return val;
+}
+
 static inline int
 kv_get_comp(struct kv_op *op, PyObject *daos_dict)
 {
@@ -623,9 +711,12 @@ kv_get_comp(struct kv_op *op, PyObject *daos_dict)
 	if (op->size == 0) {
 		Py_INCREF(Py_None);
 		val = Py_None;
+	} else if (op->has_view) {
+		val = kv_view2value(op);
 	} else {
 		val = PyBytes_FromStringAndSize(op->buf, op->size);
 	}
+	kv_op_release(op);
 
 	if (val == NULL)
 		return -DER_IO;
@@ -645,34 +736,56 @@ static PyObject *
 __shim_handle__kv_get(PyObject *self, PyObject *args)
 {
 	PyObject	*daos_dict;
+	PyObject	*items = NULL;
 	daos_handle_t	 oh;
 	PyObject	*key;
-	Py_ssize_t	 pos = 0;
+	PyObject	*value;
+	Py_ssize_t	 pos;
+	Py_ssize_t	 nr;
 	daos_handle_t	 eq;
 	struct kv_op	*kv_array = NULL;
 	struct kv_op	*op;
 	daos_event_t	*evp;
+	int		 inflight = MAX_INFLIGHT;
 	int		 i = 0;
 	int		 rc;
 	int		 ret;
 	size_t		 v_size;
 
 	/* Parse arguments */
-	RETURN_NULL_IF_FAILED_TO_PARSE(args, "LO!l", &oh.cookie, &PyDict_Type,
-				       &daos_dict, &v_size);
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "LO!l|i", &oh.cookie,
+				       &PyDict_Type, &daos_dict, &v_size,
+				       &inflight);
+	if (inflight <= 0)
+		return PyInt_FromLong(-DER_INVAL);
 
 	rc = daos_eq_create(&eq);
 	if (rc)
 		return PyInt_FromLong(rc);
 
-	D_ALLOC_ARRAY(kv_array, MAX_INFLIGHT);
+	D_ALLOC_ARRAY(kv_array, inflight);
 	if (kv_array == NULL) {
 		rc = -DER_NOMEM;
 		goto out;
 	}
 
-	while (PyDict_Next(daos_dict, &pos, &key, NULL)) {
-		if (i < MAX_INFLIGHT) {
+	/**
+	 * The GIL is dropped while waiting for completions, so work on a
+	 * snapshot of the items: it keeps the keys, and the UTF-8 or bytes
+	 * buffers they own, alive even if another thread changes the dict.
+	 */
+	items = PyDict_Items(daos_dict);
+	if (items == NULL) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
+	nr = PyList_GET_SIZE(items);
+
+	for (pos = 0; pos < nr; pos++) {
+		key = PyTuple_GET_ITEM(PyList_GET_ITEM(items, pos), 0);
+		value = PyTuple_GET_ITEM(PyList_GET_ITEM(items, pos), 1);
+
+		if (i < inflight) {
 			/** haven't reached max request in flight yet */
 			op = &kv_array[i];
 			evp = &op->ev;
@@ -680,13 +793,6 @@ __shim_handle__kv_get(PyObject *self, PyObject *args)
 			if (rc)
 				break;
 			op->buf_size = v_size;
-			op->size = op->buf_size;
-			D_ALLOC(op->buf, op->buf_size);
-			if (op->buf == NULL) {
-				rc = -DER_NOMEM;
-				break;
-			}
-
 			i++;
 		} else {
 			/**
@@ -694,7 +800,7 @@ __shim_handle__kv_get(PyObject *self, PyObject *args)
 			 * for one i/o to complete to reuse the slot
 			 */
 rewait:
-			rc = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
+			rc = kv_eq_poll(eq, &evp);
 			if (rc < 0)
 				break;
 			if (rc == 0) {
@@ -709,10 +815,9 @@ rewait:
 				rc = kv_get_comp(op, daos_dict);
 				if (rc != DER_SUCCESS)
 					D_GOTO(err, rc);
-				/* Reset the size of the request */
-				op->size = op->buf_size;
 				evp->ev_error = 0;
-			} else if (evp->ev_error == -DER_REC2BIG) {
+			} else if (evp->ev_error == -DER_REC2BIG &&
+				   !op->has_view) {
 				char *new_buff;
 
 				D_REALLOC_NZ(new_buff, op->buf, op->size);
@@ -722,6 +827,7 @@ rewait:
 				}
 				op->buf_size = op->size;
 				op->buf = new_buff;
+				op->dst = new_buff;
 
 				daos_event_fini(evp);
 				rc = daos_event_init(evp, eq, NULL);
@@ -729,11 +835,13 @@ rewait:
 					break;
 
 				rc = daos_kv_get(oh, DAOS_TX_NONE, 0, op->key,
-						&op->size, op->buf, evp);
+						&op->size, op->dst, evp);
 				if (rc != -DER_SUCCESS)
 					break;
 				D_GOTO(rewait, rc);
 			} else {
+				/** a caller buffer can't be grown for us */
+				kv_op_release(op);
 				rc = evp->ev_error;
 				break;
 			}
@@ -749,16 +857,24 @@ rewait:
 		}
 		if (!op->key)
 			D_GOTO(err, rc = 0);
+
+		rc = kv_get_prep(op, value);
+		if (rc == -DER_INVAL)
+			D_GOTO(err, rc);
+		if (rc)
+			break;
+
 		rc = daos_kv_get(oh, DAOS_TX_NONE, 0, op->key, &op->size,
-				 op->buf, evp);
+				 op->dst, evp);
 		if (rc) {
+			kv_op_release(op);
 			break;
 		}
 	}
 
 	/** wait for completion of all in-flight requests */
 	do {
-		ret = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
+		ret = kv_eq_poll(eq, &evp);
 		if (ret == 1) {
 			int rc2;
 
@@ -770,7 +886,8 @@ rewait:
 				if (rc == DER_SUCCESS && rc2 != DER_SUCCESS)
 					D_GOTO(err, rc = rc2);
 				continue;
-			} else if (evp->ev_error == -DER_REC2BIG) {
+			} else if (evp->ev_error == -DER_REC2BIG &&
+				   !op->has_view) {
 				char *new_buff;
 
 				daos_event_fini(evp);
@@ -782,12 +899,14 @@ rewait:
 
 				op->buf_size = op->size;
 				op->buf = new_buff;
+				op->dst = new_buff;
 
 				rc2 = daos_kv_get(oh, DAOS_TX_NONE, 0, op->key,
-						&op->size, op->buf, evp);
+						&op->size, op->dst, evp);
 				if (rc2 != -DER_SUCCESS)
 					D_GOTO(out, rc = rc2);
 			} else {
+				kv_op_release(op);
 				if (rc == DER_SUCCESS)
 					rc = evp->ev_error;
 			}
@@ -800,8 +919,9 @@ rewait:
 		rc = ret;
 
 	/** free up all buffers */
-	for (i = 0; i < MAX_INFLIGHT; i++) {
+	for (i = 0; i < inflight; i++) {
 		op = &kv_array[i];
+		kv_op_release(op);
 		D_FREE(op->buf);
 	}
 
@@ -812,47 +932,99 @@ out:
 	ret = daos_eq_destroy(eq, DAOS_EQ_DESTROY_FORCE);
 	if (rc == DER_SUCCESS && ret < 0)
 		rc = ret;
+	Py_XDECREF(items);
 
 	/* Populate return list */
 	return PyInt_FromLong(rc);
 
 err:
+	/** abort what is still in flight before releasing its buffers */
+	daos_eq_destroy(eq, DAOS_EQ_DESTROY_FORCE);
+	for (i = 0; i < inflight; i++) {
+		kv_op_release(&kv_array[i]);
+		D_FREE(kv_array[i].buf);
+	}
 	D_FREE(kv_array);
+	Py_XDECREF(items);
 
 	return NULL;
 }
 
+struct kv_put_op {
+	daos_event_t	 ev;
+	/** pinned value buffer, released once the put completes */
+	Py_buffer	 view;
+	bool		 has_view;
+};
+
+static inline void
+kv_put_release(struct kv_put_op *op)
+{
+	if (!op->has_view)
+		return;
+	PyBuffer_Release(&op->view);
+	op->has_view = false;
+}
+
 static PyObject *
 __shim_handle__kv_put(PyObject *self, PyObject *args)
 {
-	PyObject	*daos_dict;
-	daos_handle_t	 oh;
-	PyObject	*key;
-	PyObject	*value;
-	Py_ssize_t	 pos = 0;
-	daos_handle_t	 eq;
-	daos_event_t	 ev_array[MAX_INFLIGHT];
-	daos_event_t	*evp;
-	int		 i = 0;
-	int		 rc;
-	int		 ret;
+	PyObject		*daos_dict;
+	PyObject		*items;
+	daos_handle_t		 oh;
+	PyObject		*key;
+	PyObject		*value;
+	Py_ssize_t		 pos;
+	Py_ssize_t		 nr;
+	daos_handle_t		 eq;
+	struct kv_put_op	*op_array = NULL;
+	struct kv_put_op	*op;
+	daos_event_t		*evp;
+	int			 inflight = MAX_INFLIGHT;
+	int			 i = 0;
+	int			 rc;
+	int			 ret;
 
 	/* Parse arguments */
-	RETURN_NULL_IF_FAILED_TO_PARSE(args, "LO!", &oh.cookie,
-				       &PyDict_Type, &daos_dict);
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "LO!|i", &oh.cookie,
+				       &PyDict_Type, &daos_dict, &inflight);
+	if (inflight <= 0)
+		return PyInt_FromLong(-DER_INVAL);
 
 	rc = daos_eq_create(&eq);
 	if (rc)
 		return PyInt_FromLong(rc);
 
-	while (PyDict_Next(daos_dict, &pos, &key, &value)) {
+	D_ALLOC_ARRAY(op_array, inflight);
+	if (op_array == NULL) {
+		daos_eq_destroy(eq, 0);
+		return PyInt_FromLong(-DER_NOMEM);
+	}
+
+	/**
+	 * Snapshot the items, the keys and values, hence the buffers being
+	 * sent, must stay alive while the GIL is dropped in kv_eq_poll().
+	 */
+	items = PyDict_Items(daos_dict);
+	if (items == NULL) {
+		daos_eq_destroy(eq, 0);
+		D_FREE(op_array);
+		return PyInt_FromLong(-DER_NOMEM);
+	}
+	nr = PyList_GET_SIZE(items);
+
+	for (pos = 0; pos < nr; pos++) {
 		char		*buf;
 		daos_size_t	 size;
 		char		*key_str;
 
-		if (i < MAX_INFLIGHT) {
+		key = PyTuple_GET_ITEM(PyList_GET_ITEM(items, pos), 0);
+		value = PyTuple_GET_ITEM(PyList_GET_ITEM(items, pos), 1);
+
+		if (i < inflight) {
 			/** haven't reached max request in flight yet */
-			evp = &ev_array[i];
+			op = &op_array[i];
+			evp = &op->ev;
 			rc = daos_event_init(evp, eq, NULL);
 			if (rc)
 				break;
@@ -862,7 +1034,7 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 			 * max request request in flight reached, wait
 			 * for one i/o to complete to reuse the slot
 			 */
-			rc = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
+			rc = kv_eq_poll(eq, &evp);
 			if (rc < 0)
 				break;
 			if (rc == 0) {
@@ -870,6 +1042,9 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 				break;
 			}
 
+			op = container_of(evp, struct kv_put_op, ev);
+			kv_put_release(op);
+
 			/** check if completed operation failed */
 			if (evp->ev_error != DER_SUCCESS) {
 				rc = evp->ev_error;
@@ -878,7 +1053,10 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 			evp->ev_error = 0;
 		}
 
-		/** XXX: Interpret all values as strings for now */
+		/**
+		 * Values are strings, bytes or any object exposing a
+		 * contiguous buffer, which is sent as is without a copy.
+		 */
 		if (value == Py_None) {
 			size = 0;
 		} else if (PyUnicode_Check(value)) {
@@ -886,6 +1064,13 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 
 			buf = (char *)PyUnicode_AsUTF8AndSize(value, &pysize);
 			size = pysize;
+		} else if (kv_value_is_buffer(value)) {
+			if (PyObject_GetBuffer(value, &op->view,
+					       PyBUF_SIMPLE) != 0)
+				D_GOTO(err, rc = 0);
+			op->has_view = true;
+			buf = op->view.buf;
+			size = op->view.len;
 		} else {
 			Py_ssize_t pysize = 0;
 
@@ -910,13 +1095,18 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 		else
 			rc = daos_kv_put(oh, DAOS_TX_NONE, 0, key_str, size,
 					 buf, evp);
-		if (rc)
+		if (rc) {
+			kv_put_release(op);
 			break;
+		}
 	}
 
 	/** wait for completion of all in-flight requests */
 	do {
-		ret = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
+		ret = kv_eq_poll(eq, &evp);
+		if (ret == 1)
+			kv_put_release(container_of(evp, struct kv_put_op,
+						    ev));
 		if (rc == DER_SUCCESS && ret == 1)
 			rc = evp->ev_error;
 	} while (ret == 1);
@@ -929,9 +1119,19 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 	if (rc == DER_SUCCESS && ret < 0)
 		rc = ret;
 
+	for (i = 0; i < inflight; i++)
+		kv_put_release(&op_array[i]);
+	D_FREE(op_array);
+	Py_DECREF(items);
+
 	return PyInt_FromLong(rc);
 err:
-	daos_eq_destroy(eq, 0);
+	/** abort what is still in flight before releasing its buffers */
+	daos_eq_destroy(eq, DAOS_EQ_DESTROY_FORCE);
+	for (i = 0; i < inflight; i++)
+		kv_put_release(&op_array[i]);
+	D_FREE(op_array);
+	Py_DECREF(items);
 	return NULL;
 }
 
@@ -1100,6 +1300,227 @@ out:
 	return return_list;
 }
 
+/**
+ * Implementation of DFS functions used by the dataset loader
+ */
+
+struct dfs_handle {
+	daos_handle_t	 poh;	/** pool handle */
+	daos_handle_t	 coh;	/** container handle */
+	dfs_t		*dfs;	/** read-only DFS mount */
+};
+
+/** number of directory entries fetched per dfs_readdir() call by default */
+#define DFS_LIST_BATCH 1024
+
+static PyObject *
+__shim_handle__dfs_connect(PyObject *self, PyObject *args)
+{
+	PyObject		*return_list;
+	struct dfs_handle	*hdl = NULL;
+	daos_handle_t		 poh = {0};
+	daos_handle_t		 coh = {0};
+	dfs_t			*dfs = NULL;
+	char			*pool;
+	char			*cont;
+	int			 rc;
+
+	/* Parse arguments */
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "ss", &pool, &cont);
+
+	rc = daos_pool_connect(pool, NULL, DAOS_PC_RO, &poh, NULL, NULL);
+	if (rc)
+		goto out;
+
+	rc = daos_cont_open(poh, cont, DAOS_COO_RO, &coh, NULL, NULL);
+	if (rc)
+		goto out;
+
+	rc = dfs_mount(poh, coh, O_RDONLY, &dfs);
+	if (rc) {
+		rc = daos_errno2der(rc);
+		goto out;
+	}
+
+	D_ALLOC_PTR(hdl);
+	if (hdl == NULL) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
+	hdl->poh = poh;
+	hdl->coh = coh;
+	hdl->dfs = dfs;
+out:
+	if (rc) {
+		if (dfs)
+			dfs_umount(dfs);
+		if (daos_handle_is_valid(coh))
+			daos_cont_close(coh, NULL);
+		if (daos_handle_is_valid(poh))
+			daos_pool_disconnect(poh, NULL);
+	}
+
+	/* Populate return list */
+	return_list = PyList_New(2);
+	PyList_SetItem(return_list, 0, PyInt_FromLong(rc));
+	PyList_SetItem(return_list, 1, PyLong_FromVoidPtr(hdl));
+
+	return return_list;
+}
+
+static PyObject *
+__shim_handle__dfs_disconnect(PyObject *self, PyObject *args)
+{
+	struct dfs_handle	*hdl;
+	int			 rc;
+	int			 ret;
+
+	/* Parse arguments */
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "K", &hdl);
+
+	rc = dfs_umount(hdl->dfs);
+	if (rc)
+		rc = daos_errno2der(rc);
+
+	ret = daos_cont_close(hdl->coh, NULL);
+	if (rc == DER_SUCCESS)
+		rc = ret;
+
+	ret = daos_pool_disconnect(hdl->poh, NULL);
+	if (rc == DER_SUCCESS)
+		rc = ret;
+
+	D_FREE(hdl);
+
+	return PyInt_FromLong(rc);
+}
+
+/**
+ * Append the name of every entry of directory \a path to \a entries. The
+ * directory is enumerated in batches of \a nr entries via dfs_readdir().
+ */
+static PyObject *
+__shim_handle__dfs_list(PyObject *self, PyObject *args)
+{
+	struct dfs_handle	*hdl;
+	char			*path;
+	PyObject		*entries;
+	dfs_obj_t		*dir = NULL;
+	struct dirent		*dirs = NULL;
+	daos_anchor_t		 anchor = {0};
+	mode_t			 mode;
+	uint32_t		 nr_req = DFS_LIST_BATCH;
+	uint32_t		 nr;
+	uint32_t		 i;
+	int			 rc;
+
+	/* Parse arguments */
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "KsO!|I", &hdl, &path,
+				       &PyList_Type, &entries, &nr_req);
+	if (nr_req == 0)
+		return PyInt_FromLong(-DER_INVAL);
+
+	D_ALLOC_ARRAY(dirs, nr_req);
+	if (dirs == NULL)
+		return PyInt_FromLong(-DER_NOMEM);
+
+	rc = dfs_lookup(hdl->dfs, path, O_RDONLY, &dir, &mode, NULL);
+	if (rc)
+		D_GOTO(out, rc = daos_errno2der(rc));
+
+	if (!S_ISDIR(mode))
+		D_GOTO(out, rc = -DER_NOTDIR);
+
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr = nr_req;
+		Py_BEGIN_ALLOW_THREADS
+		rc = dfs_readdir(hdl->dfs, dir, &anchor, &nr, dirs);
+		Py_END_ALLOW_THREADS
+		if (rc)
+			D_GOTO(out, rc = daos_errno2der(rc));
+
+		for (i = 0; i < nr; i++) {
+			PyObject *name;
+
+			name = PyUnicode_FromString(dirs[i].d_name);
+			if (name == NULL)
+				D_GOTO(err, rc);
+			rc = PyList_Append(entries, name);
+			Py_DECREF(name);
+			if (rc < 0)
+				D_GOTO(err, rc);
+		}
+	}
+
+out:
+	if (dir)
+		dfs_release(dir);
+	D_FREE(dirs);
+	return PyInt_FromLong(rc);
+err:
+	dfs_release(dir);
+	D_FREE(dirs);
+	return NULL;
+}
+
+/**
+ * Read file \a path into the caller-supplied writable buffer without any
+ * intermediate copy. Returns the file size along with the number of bytes
+ * read so that the caller can retry with a larger buffer if needed.
+ */
+static PyObject *
+__shim_handle__dfs_read(PyObject *self, PyObject *args)
+{
+	PyObject		*return_list;
+	struct dfs_handle	*hdl;
+	char			*path;
+	PyObject		*buf_obj;
+	Py_buffer		 view;
+	dfs_obj_t		*obj = NULL;
+	struct stat		 stbuf = {0};
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	daos_size_t		 read_size = 0;
+	mode_t			 mode;
+	int			 rc;
+
+	/* Parse arguments */
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "KsO", &hdl, &path, &buf_obj);
+
+	if (PyObject_GetBuffer(buf_obj, &view, PyBUF_WRITABLE) != 0)
+		return NULL;
+
+	d_iov_set(&iov, view.buf, view.len);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+
+	/** file descriptor and data fetch don't touch any python object */
+	Py_BEGIN_ALLOW_THREADS
+	rc = dfs_lookup(hdl->dfs, path, O_RDONLY, &obj, &mode, &stbuf);
+	if (rc == 0) {
+		if (S_ISREG(mode))
+			rc = dfs_read(hdl->dfs, obj, &sgl, 0, &read_size,
+				      NULL);
+		else
+			rc = EINVAL;
+		dfs_release(obj);
+	}
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(&view);
+	if (rc)
+		rc = daos_errno2der(rc);
+
+	/* Populate return list */
+	return_list = PyList_New(3);
+	PyList_SetItem(return_list, 0, PyInt_FromLong(rc));
+	PyList_SetItem(return_list, 1, PyLong_FromLong(stbuf.st_size));
+	PyList_SetItem(return_list, 2, PyLong_FromLong(read_size));
+
+	return return_list;
+}
+
 /**
  * Python shim module
  */
@@ -1131,6 +1552,12 @@ static PyMethodDef daosMethods[] = {
 	EXPORT_PYTHON_METHOD(kv_put),
 	EXPORT_PYTHON_METHOD(kv_iter),
 
+	/** DFS operations */
+	EXPORT_PYTHON_METHOD(dfs_connect),
+	EXPORT_PYTHON_METHOD(dfs_disconnect),
+	EXPORT_PYTHON_METHOD(dfs_list),
+	EXPORT_PYTHON_METHOD(dfs_read),
+
 	/** Array operations */
 
 	{NULL, NULL}
@@ -1324,6 +1324,53 @@ btr_cmp(struct btr_context *tcx, umem_off_t nd_off,
 	return cmp;
 }
 
+static inline uint64_t
+btr_ukey_at(char *addr, uint32_t rec_size, int at)
+{
+	return ((struct btr_record *)&addr[rec_size * at])->rec_ukey[0];
+}
+
+/**
+ * Search a node of an integer key tree without calling btr_cmp() for each
+ * record. Keys are read directly from the records and the search is
+ * branchless, so it has a fixed number of steps for the node size and no
+ * mispredicted branch per level. The returned position and \a cmp are the
+ * same as those the generic binary search in btr_probe() would end with.
+ *
+ * \return	position of the record compared with \a key
+ */
+static int
+btr_node_search_ukey(struct btr_context *tcx, umem_off_t nd_off,
+		     uint64_t key, int *cmp)
+{
+	struct btr_node	*nd = btr_off2ptr(tcx, nd_off);
+	char		*addr = (char *)&nd[1];
+	uint32_t	 rec_size = btr_rec_size(tcx);
+	int		 base = 0;
+	int		 nr = nd->tn_keyn;
+	int		 half;
+	uint64_t	 ukey;
+
+	D_ASSERT(nr > 0);
+	/* lower bound: the first record which is not less than the key */
+	while (nr > 1) {
+		half = nr / 2;
+		if (btr_ukey_at(addr, rec_size, base + half) < key)
+			base += half;
+		nr -= half;
+	}
+	base += (btr_ukey_at(addr, rec_size, base) < key);
+
+	if (base == nd->tn_keyn) {
+		*cmp = BTR_CMP_LT;
+		return base - 1;
+	}
+
+	ukey = btr_ukey_at(addr, rec_size, base);
+	*cmp = (ukey == key) ? BTR_CMP_EQ : BTR_CMP_GT;
+	return base;
+}
+
 bool
 btr_probe_valid(dbtree_probe_opc_t opc)
 {
@@ -1353,6 +1400,7 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 	int			 level = -1;
 	int			 saved = -1;
 	bool			 next_level;
+	bool			 ukey_search;
 	struct btr_node		*nd;
 	struct btr_check_alb	 alb;
 	umem_off_t		 nd_off;
@@ -1378,6 +1426,8 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 	}
 
 	nd_off = tcx->tc_tins.ti_root->tr_node;
+	ukey_search = btr_is_int_key(tcx) && hkey != NULL &&
+		      (probe_opc & BTR_PROBE_SPEC);
 
 	for (start = end = 0, level = 0, next_level = true ;;) {
 		if (next_level) { /* search a new level of the tree */
@@ -1398,6 +1448,10 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 		} else if (probe_opc == BTR_PROBE_LAST) {
 			at = start = end;
 			cmp = BTR_CMP_LT;
+		} else if (ukey_search) {
+			at = btr_node_search_ukey(tcx, nd_off,
+						  *(uint64_t *)hkey, &cmp);
+			start = end = at;
 		} else {
 			D_ASSERT(probe_opc & BTR_PROBE_SPEC);
 			/* binary search */
@@ -1611,6 +1665,25 @@ btr_probe_key(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 	return btr_probe(tcx, probe_opc, intent, key, hkey);
 }
 
+/**
+ * Iteration visits leaf records in order, the record bodies they point to
+ * are scattered in SCM though. Prefetch the body of the record after the
+ * current one, so it is likely cached when the iterator moves to it.
+ */
+static inline void
+btr_prefetch_next(struct btr_context *tcx, struct btr_trace *trace)
+{
+	struct btr_node		*nd = btr_off2ptr(tcx, trace->tr_node);
+	struct btr_record	*rec;
+
+	if (trace->tr_at + 1 >= nd->tn_keyn)
+		return;
+
+	rec = btr_node_rec_at(tcx, trace->tr_node, trace->tr_at + 1);
+	if (!UMOFF_IS_NULL(rec->rec_off))
+		prefetch(umem_off2ptr(btr_umm(tcx), rec->rec_off));
+}
+
 static bool
 btr_probe_next(struct btr_context *tcx)
 {
@@ -1664,6 +1737,7 @@ btr_probe_next(struct btr_context *tcx)
 	}
 
 	btr_trace_debug(tcx, trace, "is the next\n");
+	btr_prefetch_next(tcx, trace);
 	return true;
 }
 
@@ -2134,6 +2208,57 @@ dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 	return btr_tx_end(tcx, rc);
 }
 
+/**
+ * Update or insert a batch of records in one transaction.
+ *
+ * Each key is probed with BTR_PROBE_EQ, so the result is the same as calling
+ * dbtree_upsert() for each key in order. When the tree is in persistent
+ * memory, all changes are made in a single transaction: nodes touched by
+ * several records are only added to the undo log once, and either all the
+ * records are stored or none of them. Sorting \a keys makes consecutive
+ * records land in the same leaf.
+ *
+ * \param toh		[IN]	Tree open handle.
+ * \param intent	[IN]	The operation intent.
+ * \param nr		[IN]	Number of records.
+ * \param keys		[IN]	Array of \a nr keys.
+ * \param vals		[IN]	Array of \a nr values.
+ *
+ * \return		0	success
+ *			-ve	error code
+ */
+int
+dbtree_upsert_bulk(daos_handle_t toh, uint32_t intent, unsigned int nr,
+		   d_iov_t *keys, d_iov_t *vals)
+{
+	struct btr_context *tcx;
+	unsigned int	    i;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (nr == 0)
+		return 0;
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	for (i = 0; i < nr; i++) {
+		rc = btr_upsert(tcx, BTR_PROBE_EQ, intent, &keys[i], &vals[i],
+				NULL);
+		if (rc != 0) {
+			D_DEBUG(DB_TRACE, "Bulk upsert failed at %u/%u: "
+				DF_RC"\n", i, nr, DP_RC(rc));
+			break;
+		}
+	}
+
+	return btr_tx_end(tcx, rc);
+}
+
 /**
  * Delete the leaf record pointed by @cur_tr from the current node, then fill
  * the deletion gap by shifting remainded records on the specified direction.
@@ -2953,6 +3078,67 @@ delete:
 	return rc;
 }
 
+/**
+ * Delete a batch of keys from the btree in one transaction.
+ *
+ * When the tree is in persistent memory, either all the keys are deleted or
+ * none of them. It fails with -DER_NONEXIST if any of the keys cannot be
+ * found.
+ *
+ * \param toh		[IN]	Tree open handle.
+ * \param nr		[IN]	Number of keys.
+ * \param keys		[IN]	Array of \a nr keys to delete.
+ * \param args		[IN/OUT]
+ *				Optional: buffer to provide args to handle
+ *				special cases(if any), passed for each key.
+ */
+int
+dbtree_delete_bulk(daos_handle_t toh, unsigned int nr, d_iov_t *keys,
+		   void *args)
+{
+	struct btr_context *tcx;
+	unsigned int	    i;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (nr == 0)
+		return 0;
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	for (i = 0; i < nr; i++) {
+		rc = btr_probe_key(tcx, BTR_PROBE_EQ, DAOS_INTENT_PUNCH,
+				   &keys[i]);
+		if (rc == PROBE_RC_INPROGRESS) {
+			rc = -DER_INPROGRESS;
+			break;
+		}
+
+		if (rc == PROBE_RC_DATA_LOSS) {
+			rc = -DER_DATA_LOSS;
+			break;
+		}
+
+		if (rc != PROBE_RC_OK) {
+			D_DEBUG(DB_TRACE, "Cannot find key %u/%u\n", i, nr);
+			rc = -DER_NONEXIST;
+			break;
+		}
+
+		rc = btr_delete(tcx, args);
+		if (rc != 0)
+			break;
+	}
+
+	tcx->tc_probe_rc = PROBE_RC_UNKNOWN;
+	return btr_tx_end(tcx, rc);
+}
+
 /** gather statistics from a tree node and all its children recursively. */
 static void
 btr_node_stat(struct btr_context *tcx, umem_off_t nd_off,
@@ -4060,6 +4246,12 @@ dbtree_class_register(unsigned int tree_class, uint64_t tree_feats,
 	return 0;
 }
 
+int
+dbtree_handle_dram_size(void)
+{
+	return sizeof(struct btr_context);
+}
+
 int
 dbtree_overhead_get(int alloc_overhead, unsigned int tclass, uint64_t ofeat,
 		    int tree_order, struct daos_tree_overhead *ovhd)
@@ -250,6 +250,35 @@ daos_csummer_finish(struct daos_csummer *obj)
 	return rc;
 }
 
+int
+daos_csummer_multi(struct daos_csummer *obj, d_iov_t *bufs, uint32_t nr,
+		   uint8_t *csums, uint32_t csum_len)
+{
+	uint32_t	i;
+	int		rc = 0;
+
+	D_ASSERT(csum_len >= daos_csummer_get_csum_len(obj));
+
+	if (obj->dcs_algo->cf_multi) {
+		rc = obj->dcs_algo->cf_multi(obj->dcs_ctx, bufs, nr, csums,
+					     csum_len);
+		C_TRACE("Calculated %u csum(s) (type=%s) in one pass\n", nr,
+			daos_csummer_get_name(obj));
+		return rc;
+	}
+
+	for (i = 0; i < nr && rc == 0; i++) {
+		daos_csummer_set_buffer(obj, csums + i * csum_len, csum_len);
+		daos_csummer_reset(obj);
+		rc = daos_csummer_update(obj, bufs[i].iov_buf,
+					 bufs[i].iov_len);
+		if (rc == 0)
+			rc = daos_csummer_finish(obj);
+	}
+
+	return rc;
+}
+
 bool
 daos_csummer_compare_csum_info(struct daos_csummer *obj,
 			       struct dcs_csum_info *a,
@@ -455,6 +484,33 @@ done:
 	return rc;
 }
 
+/** Max number of chunks handed to the hash algorithm in one call */
+#define CSUM_MULTI_BATCH	16
+
+/**
+ * If the next \a bytes of the sgl live in a single iov, point \a iov at them
+ * and move the index past them.
+ */
+static bool
+sgl_idx_get_contig(d_sg_list_t *sgl, struct daos_sgl_idx *idx, size_t bytes,
+		   d_iov_t *iov)
+{
+	d_iov_t	*cur;
+	uint8_t	*buf;
+
+	if (idx->iov_idx >= sgl->sg_nr)
+		return false;
+
+	cur = &sgl->sg_iovs[idx->iov_idx];
+	if (cur->iov_buf == NULL || idx->iov_offset + bytes > cur->iov_len)
+		return false;
+
+	daos_sgl_get_bytes(sgl, false, idx, bytes, &buf, NULL);
+	d_iov_set(iov, buf, bytes);
+
+	return true;
+}
+
 static int
 calc_csum_recx_with_no_map(struct daos_csummer *obj, size_t csum_nr,
 			   daos_recx_t *recx,
@@ -465,19 +521,52 @@ calc_csum_recx_with_no_map(struct daos_csummer *obj, size_t csum_nr,
 {
 	struct daos_csum_range	 chunk;
 	daos_size_t		 bytes_for_csum;
+	d_iov_t			 batch[CSUM_MULTI_BATCH];
+	uint32_t		 batch_nr = 0;
 	uint8_t			*buf;
 	uint32_t		 i;
 	int			 rc;
 
 	for (i = 0; i < csum_nr; i++) {
+		chunk = csum_recx_chunkidx2range(recx, rec_len,
+						 rec_chunksize, i);
+		bytes_for_csum = chunk.dcr_nr * rec_len;
+
+		/**
+		 * Chunks that don't cross an iov boundary are collected and
+		 * calculated together, so the algorithm can hash several of
+		 * them at once. The checksums of consecutive chunks are
+		 * consecutive in csum_info.
+		 */
+		if (sgl_idx_get_contig(sgl, idx, bytes_for_csum,
+				       &batch[batch_nr])) {
+			batch_nr++;
+			if (batch_nr < CSUM_MULTI_BATCH && i + 1 < csum_nr)
+				continue;
+			rc = daos_csummer_multi(obj, batch, batch_nr,
+						ci_idx2csum(csum_info,
+							    i + 1 - batch_nr),
+						csum_info->cs_len);
+			batch_nr = 0;
+			if (rc != 0)
+				return rc;
+			continue;
+		}
+
+		if (batch_nr > 0) {
+			rc = daos_csummer_multi(obj, batch, batch_nr,
+						ci_idx2csum(csum_info,
+							    i - batch_nr),
+						csum_info->cs_len);
+			batch_nr = 0;
+			if (rc != 0)
+				return rc;
+		}
+
 		buf = ci_idx2csum(csum_info, i);
 		daos_csummer_set_buffer(obj, buf, csum_info->cs_len);
 		daos_csummer_reset(obj);
 
-		chunk = csum_recx_chunkidx2range(recx, rec_len,
-						 rec_chunksize, i);
-
-		bytes_for_csum = chunk.dcr_nr * rec_len;
 		rc = daos_sgl_processor(sgl, false, idx, bytes_for_csum,
 					checksum_sgl_cb, obj);
 		if (rc != 0) {
@@ -157,6 +157,60 @@ d_fd_tree_reset(struct d_fd_tree *tree)
 	return 0;
 }
 
+static int
+fd_tree_collect_ranks(struct d_fd_tree *tree, d_rank_list_t *ranks,
+		      uint32_t *nr)
+{
+	struct d_fd_node	node;
+	int			rc;
+
+	*nr = 0;
+	rc = d_fd_tree_reset(tree);
+	if (rc != 0)
+		return rc;
+
+	while ((rc = d_fd_tree_next(tree, &node)) == 0) {
+		if (node.fdn_type != D_FD_NODE_TYPE_RANK)
+			continue;
+		if (ranks != NULL)
+			ranks->rl_ranks[*nr] = node.fdn_val.rank;
+		(*nr)++;
+	}
+
+	return rc == -DER_NONEXIST ? 0 : rc;
+}
+
+int
+d_fd_tree_get_rank_order(struct d_fd_tree *tree, d_rank_list_t **ranks)
+{
+	d_rank_list_t	*list;
+	uint32_t	 nr;
+	int		 rc;
+
+	if (ranks == NULL) {
+		D_ERROR("null pointer for result\n");
+		return -DER_INVAL;
+	}
+
+	rc = fd_tree_collect_ranks(tree, NULL, &nr);
+	if (rc != 0)
+		return rc;
+
+	list = d_rank_list_alloc(nr);
+	if (list == NULL)
+		return -DER_NOMEM;
+
+	rc = fd_tree_collect_ranks(tree, list, &nr);
+	d_fd_tree_reset(tree);
+	if (rc != 0) {
+		d_rank_list_free(list);
+		return rc;
+	}
+
+	*ranks = list;
+	return 0;
+}
+
 int
 d_fd_get_exp_num_domains(uint32_t compressed_len, uint32_t exp_num_ranks,
 			 uint32_t *result)
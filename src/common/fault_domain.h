@@ -125,4 +125,20 @@ int
 d_fd_get_exp_num_domains(uint32_t compressed_len, uint32_t exp_num_ranks,
 			 uint32_t *result);
 
+/**
+ * Get all the ranks of a fault domain tree in traversal order, i.e. the ranks
+ * of the same lowest level domain are adjacent in the list, and so are the
+ * domains sharing the same parent. The tree is reset on return.
+ * \param[in]	tree	Tree to traverse
+ * \param[out]	ranks	Newly allocated rank list, to be freed by the caller
+ *			with d_rank_list_free()
+ * \return	0		Success
+ *		-DER_INVAL	Invalid inputs
+ *		-DER_UNINIT	Tree isn't initialized
+ *		-DER_NOMEM	Out of memory
+ *		-DER_TRUNC	Tree is truncated
+ */
+int
+d_fd_tree_get_rank_order(struct d_fd_tree *tree, d_rank_list_t **ranks);
+
 #endif /* __DAOS_COMMON_FAULT_DOMAIN__ */
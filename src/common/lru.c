@@ -145,6 +145,7 @@ daos_lru_cache_create(int bits, uint32_t feats,
 	lcache->dlc_count = 0;
 	lcache->dlc_ops = ops;
 	D_INIT_LIST_HEAD(&lcache->dlc_lru);
+	D_INIT_LIST_HEAD(&lcache->dlc_cold);
 
 	*lcache_pp = lcache;
 	lcache = NULL;
@@ -167,11 +168,23 @@ daos_lru_cache_destroy(struct daos_lru_cache *lcache)
 }
 
 struct lru_evict_arg {
+	struct daos_lru_cache	*lcache;
 	daos_lru_cond_cb_t	 cb;
 	void			*arg;
 	d_list_t		 list;
 };
 
+/** Remove an idle ref from the hot or cold list */
+static inline void
+lru_idle_del(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	if (llink->ll_hot) {
+		D_ASSERT(lcache->dlc_hot_count > 0);
+		lcache->dlc_hot_count--;
+	}
+	d_list_del_init(&llink->ll_qlink);
+}
+
 static int
 lru_evict_cb(d_list_t *link, void *arg)
 {
@@ -181,8 +194,10 @@ lru_evict_cb(d_list_t *link, void *arg)
 	if (llink->ll_evicted || cb_arg->cb == NULL ||
 	    cb_arg->cb(llink, cb_arg->arg)) {
 		llink->ll_evicted = 1;
-		if (llink->ll_ref == 1) /* the last refcount */
-			d_list_move(&llink->ll_qlink, &cb_arg->list);
+		if (llink->ll_ref == 1) { /* the last refcount */
+			lru_idle_del(cb_arg->lcache, llink);
+			d_list_add(&llink->ll_qlink, &cb_arg->list);
+		}
 	}
 
 	return 0;
@@ -203,7 +218,8 @@ void
 daos_lru_cache_evict(struct daos_lru_cache *lcache,
 		     daos_lru_cond_cb_t cond, void *arg)
 {
-	struct lru_evict_arg	 cb_arg = { .cb = cond, .arg = arg };
+	struct lru_evict_arg	 cb_arg = { .lcache = lcache, .cb = cond,
+					    .arg = arg };
 	struct daos_llink	*llink;
 	struct daos_llink	*tmp;
 	unsigned int		 count = 0;
@@ -223,6 +239,30 @@ daos_lru_cache_evict(struct daos_lru_cache *lcache,
 		count, lcache->dlc_count, lcache->dlc_csize);
 }
 
+/**
+ * Evict the least recently used idle ref, cold items go first, hot ones only
+ * if nothing else is left. Return false if all refs are busy.
+ */
+static bool
+lru_evict_idle(struct daos_lru_cache *lcache)
+{
+	struct daos_llink	*llink;
+
+	if (!d_list_empty(&lcache->dlc_cold))
+		llink = d_list_entry(lcache->dlc_cold.prev, struct daos_llink,
+				     ll_qlink);
+	else if (!d_list_empty(&lcache->dlc_lru))
+		llink = d_list_entry(lcache->dlc_lru.prev, struct daos_llink,
+				     ll_qlink);
+	else
+		return false;
+
+	lru_idle_del(lcache, llink);
+	lru_del_evicted(lcache, llink);
+	lcache->dlc_evictions++;
+	return true;
+}
+
 int
 daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 		  unsigned int key_size, void *create_args,
@@ -242,10 +282,14 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 		D_ASSERT(llink->ll_evicted == 0);
 		/* remove busy item from LRU */
 		if (!d_list_empty(&llink->ll_qlink))
-			d_list_del_init(&llink->ll_qlink);
+			lru_idle_del(lcache, llink);
+		/* referenced again, it goes to the hot list once idle */
+		llink->ll_hot = 1;
+		lcache->dlc_hits++;
 		D_GOTO(found, rc = 0);
 	}
 
+	lcache->dlc_misses++;
 	if (create_args == NULL)
 		D_GOTO(out, rc = -DER_NONEXIST);
 
@@ -256,6 +300,7 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 
 	D_DEBUG(DB_TRACE, "Inserting %p item into LRU Hash table\n", llink);
 	llink->ll_evicted = 0;
+	llink->ll_hot	  = 0;
 	llink->ll_ref	  = 1; /* 1 for caller */
 	llink->ll_ops	  = lcache->dlc_ops;
 	D_INIT_LIST_HEAD(&llink->ll_qlink);
@@ -286,19 +331,41 @@ daos_lru_ref_release(struct daos_lru_cache *lcache, struct daos_llink *llink)
 
 		if (llink->ll_evicted) {
 			lru_del_evicted(lcache, llink);
-		} else {
+		} else if (llink->ll_hot) {
 			D_ASSERT(d_list_empty(&llink->ll_qlink));
 			d_list_add(&llink->ll_qlink, &lcache->dlc_lru);
+			lcache->dlc_hot_count++;
+		} else {
+			D_ASSERT(d_list_empty(&llink->ll_qlink));
+			d_list_add(&llink->ll_qlink, &lcache->dlc_cold);
 		}
 	}
 
-	while (!d_list_empty(&lcache->dlc_lru)) {
+	/* demote the least recently used hot items if there are too many */
+	while (lcache->dlc_hot_count >
+	       (uint64_t)lcache->dlc_csize * DLC_HOT_PCT / 100) {
 		llink = d_list_entry(lcache->dlc_lru.prev, struct daos_llink,
 				     ll_qlink);
-		if (lcache->dlc_count < lcache->dlc_csize)
-			break; /* within threshold and no old item */
+		lru_idle_del(lcache, llink);
+		llink->ll_hot = 0;
+		d_list_add(&llink->ll_qlink, &lcache->dlc_cold);
+	}
 
-		d_list_del_init(&llink->ll_qlink);
-		lru_del_evicted(lcache, llink);
+	while (lcache->dlc_count >= lcache->dlc_csize) {
+		if (!lru_evict_idle(lcache))
+			break; /* all items are busy */
 	}
 }
+
+uint32_t
+daos_lru_cache_shrink(struct daos_lru_cache *lcache, uint32_t nr)
+{
+	uint32_t	count = 0;
+
+	while (count < nr && lru_evict_idle(lcache))
+		count++;
+
+	D_DEBUG(DB_TRACE, "Shrunk %u items, total count %u of %u\n",
+		count, lcache->dlc_count, lcache->dlc_csize);
+	return count;
+}
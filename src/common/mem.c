@@ -27,6 +27,13 @@ struct umem_tx_stage_item {
 	void		*txi_data;
 };
 
+/**
+ * Ranges added to transactions by this thread. Tree instances carry their own
+ * copies of the pool's umem instance, so the statistics can't live there, and
+ * a pool is only ever modified by one xstream.
+ */
+static __thread struct umem_tx_stats umem_tx_stats;
+
 #ifdef DAOS_PMEM_BUILD
 /** Convert an offset to an id.   No invalid flags will be maintained
  *  in the conversion.
@@ -109,6 +116,8 @@ pmem_tx_add(struct umem_instance *umm, umem_off_t umoff,
 {
 	int	rc;
 
+	umem_tx_stats.uts_add_cnt++;
+	umem_tx_stats.uts_add_bytes += size;
 	rc = pmemobj_tx_add_range(umem_off2id(umm, umoff), offset, size);
 	return rc ? umem_tx_errno(rc) : 0;
 }
@@ -119,6 +128,8 @@ pmem_tx_xadd(struct umem_instance *umm, umem_off_t umoff, uint64_t offset,
 {
 	int	rc;
 
+	umem_tx_stats.uts_add_cnt++;
+	umem_tx_stats.uts_add_bytes += size;
 	rc = pmemobj_tx_xadd_range(umem_off2id(umm, umoff), offset, size,
 				   flags);
 	return rc ? umem_tx_errno(rc) : 0;
@@ -130,6 +141,8 @@ pmem_tx_add_ptr(struct umem_instance *umm, void *ptr, size_t size)
 {
 	int	rc;
 
+	umem_tx_stats.uts_add_cnt++;
+	umem_tx_stats.uts_add_bytes += size;
 	rc = pmemobj_tx_add_range_direct(ptr, size);
 	return rc ? umem_tx_errno(rc) : 0;
 }
@@ -544,6 +557,15 @@ umem_attr_get(struct umem_instance *umm, struct umem_attr *uma)
 	uma->uma_pool = umm->umm_pool;
 }
 
+/**
+ * Get the transaction statistics of the calling thread.
+ */
+void
+umem_tx_stats_get(struct umem_tx_stats *stats)
+{
+	*stats = umem_tx_stats;
+}
+
 /*
  * To avoid allocating stage data for each transaction, umem user should
  * prepare per-xstream stage data and initialize it by umem_init_txd(),
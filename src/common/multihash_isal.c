@@ -69,12 +69,28 @@ crc16_finish(void *daos_mhash_ctx, uint8_t *buf, size_t buf_len)
 	return 0;
 }
 
+static int
+crc16_multi(void *daos_mhash_ctx, d_iov_t *bufs, uint32_t nr,
+	    uint8_t *hashes, size_t hash_len)
+{
+	uint32_t i;
+
+	for (i = 0; i < nr; i++) {
+		*((uint16_t *)hashes) = crc16_t10dif(0, bufs[i].iov_buf,
+						     (int)bufs[i].iov_len);
+		hashes += hash_len;
+	}
+
+	return 0;
+}
+
 struct hash_ft crc16_algo = {
 	.cf_update	= crc16_update,
 	.cf_init	= crc16_init,
 	.cf_reset	= crc16_reset,
 	.cf_destroy	= crc16_destroy,
 	.cf_finish	= crc16_finish,
+	.cf_multi	= crc16_multi,
 	.cf_hash_len	= sizeof(uint16_t),
 	.cf_name	= "crc16",
 	.cf_type	= HASH_TYPE_CRC16
@@ -126,12 +142,28 @@ crc32_finish(void *daos_mhash_ctx, uint8_t *buf, size_t buf_len)
 	return 0;
 }
 
+static int
+crc32_multi(void *daos_mhash_ctx, d_iov_t *bufs, uint32_t nr,
+	    uint8_t *hashes, size_t hash_len)
+{
+	uint32_t i;
+
+	for (i = 0; i < nr; i++) {
+		*((uint32_t *)hashes) = crc32_iscsi(bufs[i].iov_buf,
+						    (int)bufs[i].iov_len, 0);
+		hashes += hash_len;
+	}
+
+	return 0;
+}
+
 struct hash_ft crc32_algo = {
 	.cf_update	= crc32_update,
 	.cf_init	= crc32_init,
 	.cf_reset	= crc32_reset,
 	.cf_destroy	= crc32_destroy,
 	.cf_finish	= crc32_finish,
+	.cf_multi	= crc32_multi,
 	.cf_hash_len	= sizeof(uint32_t),
 	.cf_name	= "crc32",
 	.cf_type	= HASH_TYPE_CRC32
@@ -180,12 +212,28 @@ adler32_finish(void *daos_mhash_ctx, uint8_t *buf, size_t buf_len)
 	return 0;
 }
 
+static int
+adler32_multi(void *daos_mhash_ctx, d_iov_t *bufs, uint32_t nr,
+	      uint8_t *hashes, size_t hash_len)
+{
+	uint32_t i;
+
+	for (i = 0; i < nr; i++) {
+		*((uint32_t *)hashes) = isal_adler32(0, bufs[i].iov_buf,
+						     bufs[i].iov_len);
+		hashes += hash_len;
+	}
+
+	return 0;
+}
+
 struct hash_ft adler32_algo = {
 	.cf_update	= adler32_update,
 	.cf_init	= adler32_init,
 	.cf_reset	= adler32_reset,
 	.cf_destroy	= adler32_destroy,
 	.cf_finish	= adler32_finish,
+	.cf_multi	= adler32_multi,
 	.cf_hash_len	= sizeof(uint32_t),
 	.cf_name	= "adler32",
 	.cf_type	= HASH_TYPE_ADLER32
@@ -237,12 +285,28 @@ crc64_finish(void *daos_mhash_ctx, uint8_t *buf, size_t buf_len)
 	return 0;
 }
 
+static int
+crc64_multi(void *daos_mhash_ctx, d_iov_t *bufs, uint32_t nr,
+	    uint8_t *hashes, size_t hash_len)
+{
+	uint32_t i;
+
+	for (i = 0; i < nr; i++) {
+		*((uint64_t *)hashes) = crc64_ecma_refl(0, bufs[i].iov_buf,
+							bufs[i].iov_len);
+		hashes += hash_len;
+	}
+
+	return 0;
+}
+
 struct hash_ft crc64_algo = {
 	.cf_update	= crc64_update,
 	.cf_init	= crc64_init,
 	.cf_reset	= crc64_reset,
 	.cf_destroy	= crc64_destroy,
 	.cf_finish	= crc64_finish,
+	.cf_multi	= crc64_multi,
 	.cf_hash_len	= sizeof(uint64_t),
 	.cf_name	= "crc64",
 	.cf_type	= HASH_TYPE_CRC64
@@ -386,6 +450,8 @@ struct hash_ft sha256_algo = {
 struct sha512_ctx {
 	SHA512_HASH_CTX_MGR	s5_mgr;
 	SHA512_HASH_CTX		s5_ctx;
+	/** one context per lane for independent multi-buffer hashes */
+	SHA512_HASH_CTX		s5_lanes[SHA512_MAX_LANES];
 	bool			s5_updated;
 };
 
@@ -468,12 +534,47 @@ sha512_finish(void *daos_mhash_ctx, uint8_t *buf, size_t buf_len)
 	return 0;
 }
 
+static int
+sha512_multi(void *daos_mhash_ctx, d_iov_t *bufs, uint32_t nr,
+	     uint8_t *hashes, size_t hash_len)
+{
+	struct sha512_ctx	*ctx = daos_mhash_ctx;
+	uint32_t		 lanes;
+	uint32_t		 i, j;
+
+	for (i = 0; i < nr; i += lanes) {
+		lanes = min(nr - i, SHA512_MAX_LANES);
+
+		/** Fill all the lanes and let the manager hash them together */
+		for (j = 0; j < lanes; j++) {
+			hash_ctx_init(&ctx->s5_lanes[j]);
+			sha512_ctx_mgr_submit(&ctx->s5_mgr, &ctx->s5_lanes[j],
+					      bufs[i + j].iov_buf,
+					      bufs[i + j].iov_len,
+					      HASH_ENTIRE);
+		}
+		while (sha512_ctx_mgr_flush(&ctx->s5_mgr) != NULL)
+			;
+
+		for (j = 0; j < lanes; j++) {
+			if (ctx->s5_lanes[j].error)
+				return ctx->s5_lanes[j].error;
+			memcpy(hashes, ctx->s5_lanes[j].job.result_digest,
+			       hash_len);
+			hashes += hash_len;
+		}
+	}
+
+	return 0;
+}
+
 struct hash_ft sha512_algo = {
 	.cf_update	= sha512_update,
 	.cf_init	= sha512_init,
 	.cf_reset	= sha512_reset,
 	.cf_destroy	= sha512_destroy,
 	.cf_finish	= sha512_finish,
+	.cf_multi	= sha512_multi,
 	.cf_hash_len	= 512 / 8,
 	.cf_name	= "sha512",
 	.cf_type	= HASH_TYPE_SHA512
@@ -80,9 +80,20 @@ struct pool_map {
 	 * of component found in the pool
 	 */
 	struct pool_fail_comp	*po_comp_fail_cnts;
-
+	/**
+	 * Direct lookup tables indexed by target ID and by rank, they are
+	 * NULL if the IDs or ranks are too sparse, in which case lookups
+	 * fall back to the binary and linear searches.
+	 */
+	struct pool_target	**po_target_idx;
+	unsigned int		 po_target_idx_nr;
+	struct pool_domain	**po_rank_idx;
+	unsigned int		 po_rank_idx_nr;
 };
 
+/** Don't build a direct lookup table bigger than this many times the items */
+#define POOL_MAP_IDX_SPARSE	2
+
 static struct pool_comp_state_dict comp_state_dict[] = {
 	{
 		.sd_state	= PO_COMP_ST_UP,
@@ -879,6 +890,58 @@ pool_tree_copy(struct pool_domain *dst, struct pool_domain *src)
 	pool_tree_build_ptrs(dst, &cntr);
 }
 
+static void
+pool_map_index_fini(struct pool_map *map)
+{
+	D_FREE(map->po_target_idx);
+	map->po_target_idx_nr = 0;
+	D_FREE(map->po_rank_idx);
+	map->po_rank_idx_nr = 0;
+}
+
+/**
+ * Build the direct lookup tables of target ID and rank. Both tables are
+ * optional, so failing to allocate them is not an error.
+ */
+static void
+pool_map_index_init(struct pool_map *map)
+{
+	struct pool_target	*tgts = map->po_tree[0].do_targets;
+	struct pool_domain	*doms;
+	unsigned int		 tgt_nr = map->po_tree[0].do_target_nr;
+	unsigned int		 max;
+	int			 dom_nr;
+	int			 i;
+
+	for (i = 0, max = 0; i < tgt_nr; i++)
+		max = max(max, tgts[i].ta_comp.co_id);
+
+	if (tgt_nr > 0 && max < tgt_nr * POOL_MAP_IDX_SPARSE) {
+		D_ALLOC_ARRAY(map->po_target_idx, max + 1);
+		if (map->po_target_idx != NULL) {
+			map->po_target_idx_nr = max + 1;
+			for (i = 0; i < tgt_nr; i++)
+				map->po_target_idx[tgts[i].ta_comp.co_id] =
+					&tgts[i];
+		}
+	}
+
+	dom_nr = pool_map_find_nodes(map, PO_COMP_ID_ALL, &doms);
+	for (i = 0, max = 0; i < dom_nr; i++)
+		max = max(max, doms[i].do_comp.co_rank);
+
+	if (dom_nr > 0 && max < dom_nr * POOL_MAP_IDX_SPARSE) {
+		D_ALLOC_ARRAY(map->po_rank_idx, max + 1);
+		if (map->po_rank_idx != NULL) {
+			map->po_rank_idx_nr = max + 1;
+			/* keep the first match, same as the linear search */
+			for (i = dom_nr - 1; i >= 0; i--)
+				map->po_rank_idx[doms[i].do_comp.co_rank] =
+					&doms[i];
+		}
+	}
+}
+
 /** free data members of a pool map */
 static void
 pool_map_finalise(struct pool_map *map)
@@ -887,6 +950,7 @@ pool_map_finalise(struct pool_map *map)
 
 	D_DEBUG(DB_TRACE, "Release buffers for pool map\n");
 
+	pool_map_index_fini(map);
 	comp_sorter_fini(&map->po_target_sorter);
 
 	if (map->po_comp_fail_cnts != NULL)
@@ -999,6 +1063,7 @@ pool_map_initialise(struct pool_map *map, struct pool_domain *tree)
 	if (rc != 0)
 		goto out_target_sorter;
 
+	pool_map_index_init(map);
 	return 0;
 
 out_target_sorter:
@@ -1801,7 +1866,11 @@ pool_map_find_target(struct pool_map *map, uint32_t id,
 		return map->po_tree[0].do_target_nr;
 	}
 
-	target = comp_sorter_find_target(sorter, id);
+	if (map->po_target_idx != NULL)
+		target = id < map->po_target_idx_nr ?
+			 map->po_target_idx[id] : NULL;
+	else
+		target = comp_sorter_find_target(sorter, id);
 	if (target == NULL)
 		return 0;
 
@@ -1825,12 +1894,15 @@ pool_map_find_node_by_rank(struct pool_map *map, uint32_t rank)
 	int			doms_cnt;
 	int			i;
 
+	if (map->po_rank_idx != NULL)
+		return rank < map->po_rank_idx_nr ?
+		       map->po_rank_idx[rank] : NULL;
+
 	doms_cnt = pool_map_find_nodes(map, PO_COMP_ID_ALL, &doms);
 	if (doms_cnt <= 0)
 		return NULL;
 
 	for (i = 0; i < doms_cnt; i++) {
-		/* FIXME add rank sorter to the pool map */
 		if (doms[i].do_comp.co_rank == rank) {
 			found = &doms[i];
 			break;
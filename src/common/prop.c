@@ -299,6 +299,13 @@ daos_prop_valid(daos_prop_t *prop, bool pool, bool input)
 		case DAOS_PROP_PO_SELF_HEAL:
 		case DAOS_PROP_PO_EC_CELL_SZ:
 			break;
+		case DAOS_PROP_PO_SCHED_WEIGHT:
+			val = prop->dpp_entries[i].dpe_val;
+			if (val == 0 || val > DAOS_PROP_PO_SCHED_WEIGHT_MAX) {
+				D_ERROR("invalid sched weight "DF_U64".\n", val);
+				return false;
+			}
+			break;
 		case DAOS_PROP_PO_RECLAIM:
 			val = prop->dpp_entries[i].dpe_val;
 			if (val != DAOS_RECLAIM_DISABLED &&
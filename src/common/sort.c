@@ -14,6 +14,29 @@
 
 #include <daos/common.h>
 
+/**
+ * Linear scan for arrays that are already sorted, which is common for the
+ * callers: maps and layouts are often generated in order.
+ *
+ * It returns 1 if the array is sorted, 0 if it is not, or -DER_INVAL if
+ * \a unique is true and two adjacent elements have the same key.
+ */
+static int
+array_sorted(void *array, unsigned int len, bool unique, daos_sort_ops_t *ops)
+{
+	int	i;
+	int	rc;
+
+	for (i = 1; i < len; i++) {
+		rc = ops->so_cmp(array, i - 1, i);
+		if (rc == 0 && unique)
+			return -DER_INVAL;
+		if (rc > 0)
+			return 0;
+	}
+	return 1;
+}
+
 /**
  * Combsort for an array.
  *
@@ -30,6 +53,11 @@ daos_array_sort(void *array, unsigned int len, bool unique,
 	int	gap;
 	int	rc;
 
+	/* nothing to swap, the duplicates check of unique arrays is done */
+	rc = array_sorted(array, len, unique, ops);
+	if (rc != 0)
+		return rc < 0 ? rc : 0;
+
 	for (gap = len, swapped = true; gap > 1 || swapped; ) {
 		int	i;
 		int	j;
@@ -749,6 +749,115 @@ ik_btr_batch_oper(void **state)
 	D_FREE(arr);
 }
 
+#define BULK_BATCH	1000
+/**
+ * bulk btree operations:
+ * 1) insert @key_nr number of integer keys, BULK_BATCH keys per call
+ * 2) lookup all the keys
+ * 3) delete all the keys, BULK_BATCH keys per call
+ */
+static void
+ik_btr_bulk_oper(void **state)
+{
+	unsigned int	*arr;
+	uint64_t	*keys;
+	d_iov_t		*key_iovs;
+	d_iov_t		*val_iovs;
+	unsigned int	 key_nr;
+	int		 nr;
+	int		 i;
+	int		 j;
+	int		 rc;
+
+	key_nr = atoi(tst_fn_val.optval);
+	if (key_nr == 0 || key_nr > (1U << 28)) {
+		D_PRINT("Invalid key number: %d\n", key_nr);
+		fail();
+	}
+
+	D_ALLOC_ARRAY(arr, key_nr);
+	D_ALLOC_ARRAY(keys, BULK_BATCH);
+	D_ALLOC_ARRAY(key_iovs, BULK_BATCH);
+	D_ALLOC_ARRAY(val_iovs, BULK_BATCH);
+	if (arr == NULL || keys == NULL || key_iovs == NULL ||
+	    val_iovs == NULL)
+		fail_msg("Array allocation failed");
+
+	D_PRINT("Bulk add %d records.\n", key_nr);
+	ik_btr_gen_keys(arr, key_nr);
+	for (i = 0; i < key_nr; i += nr) {
+		nr = min(key_nr - i, BULK_BATCH);
+		for (j = 0; j < nr; j++) {
+			keys[j] = arr[i + j];
+			d_iov_set(&key_iovs[j], &keys[j], sizeof(keys[j]));
+			/* value is the key itself */
+			d_iov_set(&val_iovs[j], &keys[j], sizeof(keys[j]));
+		}
+
+		rc = dbtree_upsert_bulk(ik_toh, DAOS_INTENT_UPDATE, nr,
+					key_iovs, val_iovs);
+		if (rc != 0)
+			fail_msg("Bulk upsert failed: "DF_RC"\n", DP_RC(rc));
+	}
+	ik_btr_query(NULL);
+
+	D_PRINT("Lookup %d records.\n", key_nr);
+	for (i = 0; i < key_nr; i++) {
+		d_iov_t	val_iov;
+
+		keys[0] = arr[i];
+		d_iov_set(&key_iovs[0], &keys[0], sizeof(keys[0]));
+		d_iov_set(&val_iov, NULL, 0); /* get address */
+		rc = dbtree_lookup(ik_toh, &key_iovs[0], &val_iov);
+		if (rc != 0)
+			fail_msg("Failed to lookup %u\n", arr[i]);
+		assert_int_equal(val_iov.iov_len, sizeof(uint64_t));
+		assert_int_equal(*(uint64_t *)val_iov.iov_buf, arr[i]);
+	}
+
+	/* Deleting a missing key fails the whole batch */
+	keys[0] = arr[0];
+	keys[1] = key_nr + 1;
+	d_iov_set(&key_iovs[0], &keys[0], sizeof(keys[0]));
+	d_iov_set(&key_iovs[1], &keys[1], sizeof(keys[1]));
+	rc = dbtree_delete_bulk(ik_toh, 2, key_iovs, NULL);
+	assert_int_equal(rc, -DER_NONEXIST);
+
+	/* The batch is only undone by the transaction of a pmem tree, the
+	 * keys deleted before the failure stay deleted in a vmem tree.
+	 */
+	d_iov_set(&val_iovs[0], NULL, 0);
+	rc = dbtree_lookup(ik_toh, &key_iovs[0], &val_iovs[0]);
+	if (ik_uma->uma_id == UMEM_CLASS_VMEM && rc == -DER_NONEXIST) {
+		d_iov_set(&val_iovs[0], &keys[0], sizeof(keys[0]));
+		rc = dbtree_update(ik_toh, &key_iovs[0], &val_iovs[0]);
+	}
+	if (rc != 0)
+		fail_msg("Key %u lost by failed bulk delete: "DF_RC"\n",
+			 arr[0], DP_RC(rc));
+
+	D_PRINT("Bulk delete %d records.\n", key_nr);
+	ik_btr_gen_keys(arr, key_nr);
+	for (i = 0; i < key_nr; i += nr) {
+		nr = min(key_nr - i, BULK_BATCH);
+		for (j = 0; j < nr; j++) {
+			keys[j] = arr[i + j];
+			d_iov_set(&key_iovs[j], &keys[j], sizeof(keys[j]));
+		}
+
+		rc = dbtree_delete_bulk(ik_toh, nr, key_iovs, NULL);
+		if (rc != 0)
+			fail_msg("Bulk delete failed: "DF_RC"\n", DP_RC(rc));
+	}
+	ik_btr_query(NULL);
+	assert_true(dbtree_is_empty(ik_toh));
+
+	D_FREE(val_iovs);
+	D_FREE(key_iovs);
+	D_FREE(keys);
+	D_FREE(arr);
+}
+
 static void
 ik_btr_perf(void **state)
 {
@@ -879,6 +988,7 @@ static struct option btr_ops[] = {
 	{ "query",	no_argument,		NULL,	'q'	},
 	{ "iterate",	required_argument,	NULL,	'i'	},
 	{ "batch",	required_argument,	NULL,	'b'	},
+	{ "bulk",	required_argument,	NULL,	'B'	},
 	{ "perf",	required_argument,	NULL,	'p'	},
 	{ NULL,		0,			NULL,	0	},
 };
@@ -904,7 +1014,7 @@ ts_group(void **state) {
 
 	while ((opt = getopt_long(test_group_stop-test_group_start+1,
 				  test_group_args+test_group_start,
-				  "tmC:Deocqu:d:r:f:i:b:p:",
+				  "tmC:Deocqu:d:r:f:i:b:B:p:",
 				  btr_ops,
 				  NULL)) != -1) {
 		tst_fn_val.optval = optarg;
@@ -955,6 +1065,9 @@ ts_group(void **state) {
 		case 'b':
 			ik_btr_batch_oper(st);
 			break;
+		case 'B':
+			ik_btr_bulk_oper(st);
+			break;
 		case 'p':
 			ik_btr_perf(st);
 			break;
@@ -1035,7 +1148,7 @@ main(int argc, char **argv)
 		test_name = "Btree testing tool";
 		optind = 0;
 		/* Check for -m option first */
-		while ((opt = getopt_long(argc, argv, "tmC:Deocqu:d:r:f:i:b:p:",
+		while ((opt = getopt_long(argc, argv, "tmC:Deocqu:d:r:f:i:b:B:p:",
 					  btr_ops, NULL)) != -1) {
 			if (opt == 'm') {
 				rc = use_pmem();
@@ -127,6 +127,15 @@ run_test()
         -b "$BAT_NUM"                               \
         -D
 
+        echo "B+tree bulk operations test..."
+        eval "${VCMD[@]}" "$BTR" \
+        --start-test "btree bulk operations ${test_conf_pre} ${test_conf}" \
+        "${DYN}" "${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
+        -c                                          \
+        -o                                          \
+        -B "$BAT_NUM"                               \
+        -D
+
         echo "B+tree drain test..."
         eval "${VCMD[@]}" "$BTR" \
         --start-test "btree drain ${test_conf_pre} ${test_conf}" \
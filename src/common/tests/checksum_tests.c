@@ -1116,6 +1116,53 @@ test_repeat_updates(void **state)
  * Test some helper functions for indexing checksums within a daos_csum_info
  * -----------------------------------------------------------------------------
  */
+static void
+test_multi_buffer(void **state)
+{
+	enum DAOS_HASH_TYPE	 type;
+	struct daos_csummer	*csummer = NULL;
+	const uint32_t		 buf_nr = 9;
+	const uint32_t		 buf_len = 1024;
+	uint8_t			 data[9 * 1024];
+	uint8_t			 multi[9 * 64];
+	uint8_t			 single[64];
+	d_iov_t			 bufs[9];
+	uint32_t		 csum_len;
+	uint32_t		 i;
+	int			 rc;
+
+	for (i = 0; i < sizeof(data); i++)
+		data[i] = i * 7 + 3;
+	for (i = 0; i < buf_nr; i++)
+		/** different lengths so the lanes finish out of order */
+		d_iov_set(&bufs[i], &data[i * buf_len], buf_len - i * 16);
+
+	for (type = HASH_TYPE_UNKNOWN + 1; type < HASH_TYPE_END; type++) {
+		rc = daos_csummer_init(&csummer,
+				       daos_mhash_type2algo(type), 128, 0);
+		assert_rc_equal(0, rc);
+		csum_len = daos_csummer_get_csum_len(csummer);
+
+		memset(multi, 0, sizeof(multi));
+		rc = daos_csummer_multi(csummer, bufs, buf_nr, multi,
+					csum_len);
+		assert_rc_equal(0, rc);
+
+		/** must match the reset/update/finish flow for each buffer */
+		for (i = 0; i < buf_nr; i++) {
+			memset(single, 0, sizeof(single));
+			daos_csummer_set_buffer(csummer, single, csum_len);
+			daos_csummer_reset(csummer);
+			daos_csummer_update(csummer, bufs[i].iov_buf,
+					    bufs[i].iov_len);
+			daos_csummer_finish(csummer);
+			assert_memory_equal(single, &multi[i * csum_len],
+					    csum_len);
+		}
+		daos_csummer_destroy(&csummer);
+	}
+}
+
 static void
 test_helper_functions(void **state)
 {
@@ -1806,6 +1853,10 @@ static const struct CMUnitTest tests[] = {
 	     "for different source buffers results in same checksum if all "
 	     "data passed at once ",
 	     test_repeat_updates),
+	TEST("CSUM09.3: Test all checksum algorithms: Calculating "
+	     "checksums for several buffers at once matches calculating them "
+	     "one at a time",
+	     test_multi_buffer),
 
 	TEST("CSUM10: Test map from container prop to csum type",
 	     test_container_prop_to_csum_type),
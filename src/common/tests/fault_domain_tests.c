@@ -255,6 +255,34 @@ test_fd_get_exp_num_domains(void **state)
 	assert_int_equal(result, 3);
 }
 
+static void
+test_fd_tree_get_rank_order(void **state)
+{
+	struct d_fd_tree	 tree = {0};
+	d_rank_list_t		*ranks = NULL;
+	size_t			 exp_idx = 0;
+	uint32_t		 i;
+
+	assert_rc_equal(d_fd_tree_get_rank_order(&tree, &ranks), -DER_UNINIT);
+
+	assert_rc_equal(d_fd_tree_init(&tree, test_compressed,
+				       ARRAY_SIZE(test_compressed)), 0);
+	assert_rc_equal(d_fd_tree_get_rank_order(&tree, NULL), -DER_INVAL);
+
+	assert_rc_equal(d_fd_tree_get_rank_order(&tree, &ranks), 0);
+	assert_non_null(ranks);
+	assert_int_equal(ranks->rl_nr, TEST_NUM_RANKS);
+	for (i = 0; i < TEST_NUM_RANKS; i++)
+		assert_int_equal(ranks->rl_ranks[i],
+				 test_compressed[TEST_NUM_DOMAINS * DOM_LEN +
+						 i]);
+	d_rank_list_free(ranks);
+
+	/* tree was reset */
+	expect_domains(&tree, TEST_NUM_DOMAINS, &exp_idx);
+	expect_ranks(&tree, TEST_NUM_RANKS, &exp_idx);
+}
+
 int
 main(void)
 {
@@ -268,6 +296,7 @@ main(void)
 		cmocka_unit_test(test_fd_tree_next_len_bigger_than_tree),
 		cmocka_unit_test(test_fd_tree_reset),
 		cmocka_unit_test(test_fd_get_exp_num_domains),
+		cmocka_unit_test(test_fd_tree_get_rank_order),
 	};
 
 	return cmocka_run_group_tests_name("common_fault_domain",
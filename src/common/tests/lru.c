@@ -182,6 +182,13 @@ main(int argc, char **argv)
 	daos_lru_ref_release(tcache, link_ret[1]);
 	D_PRINT("Completed ref release for key: %"PRIu64"\n",
 		keys[1]);
+
+	/* all refs are idle now, shrinking should drop them all */
+	i = tcache->dlc_count;
+	j = daos_lru_cache_shrink(tcache, i + 1);
+	D_ASSERTF(j == i && tcache->dlc_count == 0,
+		  "shrunk %d of %d refs, %u left\n", j, i, tcache->dlc_count);
+	D_PRINT("Completed shrink of %d refs\n", j);
 exit:
 	daos_lru_cache_destroy(tcache);
 	D_FREE(keys);
@@ -43,6 +43,7 @@ static daos_sort_ops_t sort_ops = {
 
 static struct option opts[] = {
 	{ "sort",		required_argument,	NULL,   's'},
+	{ "perf",		required_argument,	NULL,   'p'},
 	{  NULL,		0,			NULL,	 0 }
 };
 
@@ -77,6 +78,45 @@ comb_sort_test(int num)
 	return 0;
 }
 
+static void
+sort_perf_run(const char *name, int *arr, int num)
+{
+	uint64_t	start;
+
+	start = daos_get_ntime();
+	daos_array_sort(arr, num, false, &sort_ops);
+	D_PRINT("%-14s: %10lu usecs\n", name,
+		(daos_get_ntime() - start) / NSEC_PER_USEC);
+}
+
+/* time the sort of random, sorted and nearly sorted (1% swapped) arrays */
+static int
+sort_perf_test(int num)
+{
+	int	*arr;
+	int	 i;
+
+	D_ALLOC_ARRAY(arr, num);
+	if (arr == NULL)
+		return -ENOMEM;
+
+	srand(daos_get_ntime());
+	D_PRINT("Sorting %d integers\n", num);
+
+	for (i = 0; i < num; i++)
+		arr[i] = rand() % (4 * num);
+	sort_perf_run("random", arr, num);
+
+	sort_perf_run("sorted", arr, num);
+
+	for (i = 0; i < num / 100 + 1; i++)
+		sort_swap(arr, rand() % num, rand() % num);
+	sort_perf_run("nearly sorted", arr, num);
+
+	D_FREE(arr);
+	return 0;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -87,7 +127,7 @@ main(int argc, char **argv)
 	if (rc != 0)
 		return rc;
 
-	while ((opc = getopt_long(argc, argv, "s:", opts, NULL)) != -1) {
+	while ((opc = getopt_long(argc, argv, "s:p:", opts, NULL)) != -1) {
 		int	num;
 
 		switch (opc) {
@@ -100,6 +140,13 @@ main(int argc, char **argv)
 
 			rc = comb_sort_test(num);
 			break;
+		case 'p':
+			num = strtoul(optarg, NULL, 0);
+			if (num <= 0)
+				return -EINVAL;
+
+			rc = sort_perf_test(num);
+			break;
 		}
 	}
 
@@ -293,6 +293,7 @@ tse_sched_fini(tse_sched_t *sched)
 	D_ASSERT(d_list_empty(&dsp->dsp_running_list));
 	D_ASSERT(d_list_empty(&dsp->dsp_complete_list));
 	D_ASSERT(d_list_empty(&dsp->dsp_sleeping_list));
+	D_ASSERT(dsp->dsp_comp_queue == NULL);
 	D_MUTEX_DESTROY(&dsp->dsp_lock);
 	D_MUTEX_DESTROY(&dsp->dsp_comp_lock);
 }
@@ -304,14 +305,14 @@ tse_sched_priv_addref_locked(struct tse_sched_private *dsp)
 }
 
 static void
-tse_sched_priv_decref(struct tse_sched_private *dsp)
+tse_sched_priv_decref_n(struct tse_sched_private *dsp, int n)
 {
 	bool	finalize;
 
 	D_MUTEX_LOCK(&dsp->dsp_lock);
 
-	D_ASSERT(dsp->dsp_refcount > 0);
-	dsp->dsp_refcount--;
+	D_ASSERT(dsp->dsp_refcount >= n);
+	dsp->dsp_refcount -= n;
 	finalize = dsp->dsp_refcount == 0;
 
 	D_MUTEX_UNLOCK(&dsp->dsp_lock);
@@ -320,6 +321,12 @@ tse_sched_priv_decref(struct tse_sched_private *dsp)
 		tse_sched_fini(tse_priv2sched(dsp));
 }
 
+static void
+tse_sched_priv_decref(struct tse_sched_private *dsp)
+{
+	tse_sched_priv_decref_n(dsp, 1);
+}
+
 void
 tse_sched_addref(tse_sched_t *sched)
 {
@@ -396,9 +403,74 @@ tse_task_complete_locked(struct tse_task_private *dtp,
 	dtp->dtp_running = 0;
 	dtp->dtp_completing = 0;
 	dtp->dtp_completed = 1;
+	__atomic_store_n(&dtp->dtp_comp_queued, 0, __ATOMIC_RELEASE);
 	d_list_move_tail(&dtp->dtp_list, &dsp->dsp_complete_list);
 }
 
+/* Tail of the completion queue, so a queued task never has NULL next */
+#define TSE_COMP_QUEUE_TAIL	((struct tse_task_private *)1)
+
+/*
+ * Whether the task was queued for completion. The flag is set before the task
+ * is queued, and cleared under dsp_lock after dtp_completed is set, so checking
+ * both under dsp_lock never misses a completion.
+ */
+static inline bool
+tse_task_comp_queued(struct tse_task_private *dtp)
+{
+	return __atomic_load_n(&dtp->dtp_comp_queued, __ATOMIC_ACQUIRE) != 0;
+}
+
+/* Push a completed running task to the completion queue without lock */
+static void
+tse_task_comp_enqueue(struct tse_task_private *dtp,
+		      struct tse_sched_private *dsp)
+{
+	struct tse_task_private	*head;
+
+	D_ASSERT(dtp->dtp_running && dtp->dtp_wakeup_time == 0);
+	__atomic_store_n(&dtp->dtp_comp_queued, 1, __ATOMIC_RELEASE);
+	head = __atomic_load_n(&dsp->dsp_comp_queue, __ATOMIC_RELAXED);
+	do {
+		dtp->dtp_comp_next = head ? head : TSE_COMP_QUEUE_TAIL;
+	} while (!__atomic_compare_exchange_n(&dsp->dsp_comp_queue, &head, dtp,
+					      true, __ATOMIC_RELEASE,
+					      __ATOMIC_RELAXED));
+}
+
+/*
+ * Move all the queued tasks to the complete list in their completion order,
+ * the caller should hold dsp_lock.
+ */
+static void
+tse_sched_drain_comp_queue(struct tse_sched_private *dsp)
+{
+	struct tse_task_private	*dtp;
+	struct tse_task_private	*next;
+	struct tse_task_private	*prev = NULL;
+
+	if (__atomic_load_n(&dsp->dsp_comp_queue, __ATOMIC_RELAXED) == NULL)
+		return;
+
+	dtp = __atomic_exchange_n(&dsp->dsp_comp_queue, NULL,
+				  __ATOMIC_ACQUIRE);
+	/* The queue is LIFO, reverse it */
+	while (dtp != NULL && dtp != TSE_COMP_QUEUE_TAIL) {
+		next = dtp->dtp_comp_next;
+		dtp->dtp_comp_next = prev;
+		prev = dtp;
+		dtp = next;
+	}
+
+	while (prev != NULL) {
+		dtp = prev;
+		prev = dtp->dtp_comp_next;
+		/* Reset dtp_wakeup_time as well */
+		dtp->dtp_comp_next = NULL;
+		tse_task_complete_locked(dtp, dsp);
+	}
+}
+
 static int
 register_cb(tse_task_t *task, bool is_comp, tse_task_cb_t cb,
 	    void *arg, daos_size_t arg_size)
@@ -474,7 +546,7 @@ tse_task_prep_callback(tse_task_t *task)
 	d_list_for_each_entry_safe(dtc, tmp, &dtp->dtp_prep_cb_list, dtc_list) {
 		d_list_del(&dtc->dtc_list);
 		/** no need to call if task was completed in one of the cbs */
-		if (!dtp->dtp_completed) {
+		if (!dtp->dtp_completed && !tse_task_comp_queued(dtp)) {
 			rc = dtc->dtc_cb(task, dtc->dtc_arg);
 			if (task->dt_result == 0)
 				task->dt_result = rc;
@@ -599,7 +671,7 @@ tse_sched_process_init(struct tse_sched_private *dsp)
 				continue;
 			}
 			D_ASSERT(dtp->dtp_func != NULL);
-			if (!dtp->dtp_completed)
+			if (!dtp->dtp_completed && !tse_task_comp_queued(dtp))
 				dtp->dtp_func(task);
 		}
 		if (bumped)
@@ -708,6 +780,7 @@ tse_sched_process_complete(struct tse_sched_private *dsp)
 	/* pick tasks from complete_list */
 	D_INIT_LIST_HEAD(&comp_list);
 	D_MUTEX_LOCK(&dsp->dsp_lock);
+	tse_sched_drain_comp_queue(dsp);
 	d_list_splice_init(&dsp->dsp_complete_list, &comp_list);
 	D_MUTEX_UNLOCK(&dsp->dsp_lock);
 
@@ -716,11 +789,14 @@ tse_sched_process_complete(struct tse_sched_private *dsp)
 
 		d_list_del_init(&dtp->dtp_list);
 		tse_task_post_process(task);
-		/* addref when the task add to dsp (tse_task_schedule) */
-		tse_sched_priv_decref(dsp);
 		tse_task_decref(task);  /* drop final ref */
 		processed++;
 	}
+
+	/* addref when the tasks add to dsp (tse_task_schedule) */
+	if (processed > 0)
+		tse_sched_priv_decref_n(dsp, processed);
+
 	return processed;
 }
 
@@ -793,9 +869,11 @@ tse_sched_complete_inflight(struct tse_sched_private *dsp)
 	int			  processed = 0;
 
 	D_MUTEX_LOCK(&dsp->dsp_lock);
+	tse_sched_drain_comp_queue(dsp);
 	d_list_for_each_entry_safe(dtp, tmp, &dsp->dsp_running_list,
 				      dtp_list)
-		if (dtp->dtp_dep_cnt == 0) {
+		/* Queued tasks will be completed on next drain */
+		if (dtp->dtp_dep_cnt == 0 && !tse_task_comp_queued(dtp)) {
 			d_list_del(&dtp->dtp_list);
 			tse_task_complete_locked(dtp, dsp);
 			processed++;
@@ -851,7 +929,7 @@ tse_task_complete(tse_task_t *task, int ret)
 	struct tse_sched_private	*dsp	= dtp->dtp_sched;
 	bool				done;
 
-	if (dtp->dtp_completed)
+	if (dtp->dtp_completed || tse_task_comp_queued(dtp))
 		return;
 
 	if (task->dt_result == 0)
@@ -861,7 +939,16 @@ tse_task_complete(tse_task_t *task, int ret)
 	/** Execute task completion callbacks first. */
 	done = tse_task_complete_callback(task);
 
-	D_MUTEX_LOCK(&dsp->dsp_lock);
+	if (!done || dsp->dsp_cancelling || !dtp->dtp_running) {
+		D_MUTEX_LOCK(&dsp->dsp_lock);
+	} else if (pthread_mutex_trylock(&dsp->dsp_lock) != 0) {
+		/**
+		 * Don't wait for the contended scheduler lock, queue the task
+		 * and let the progressing thread move it to complete list.
+		 */
+		tse_task_comp_enqueue(dtp, dsp);
+		return;
+	}
 
 	if (!dsp->dsp_cancelling) {
 		/** if task reinserted itself in scheduler, don't complete */
@@ -924,19 +1011,79 @@ tse_task_add_dependent(tse_task_t *task, tse_task_t *dep)
 	return 0;
 }
 
+/**
+ * Register all the dependencies under single scheduler lock, links are
+ * allocated in advance so that either all or none of them are registered.
+ */
 int
 tse_task_register_deps(tse_task_t *task, int num_deps,
 		       tse_task_t *dep_tasks[])
 {
-	int i;
-	int rc;
+	struct tse_task_private  *dtp = tse_task2priv(task);
+	struct tse_task_private  *dep_dtp;
+	struct tse_task_link	 *tlink;
+	struct tse_task_link	 *tmp;
+	d_list_t		  tlinks;
+	int			  cnt = 0;
+	int			  i;
+	int			  rc = 0;
+
+	if (num_deps == 0)
+		return 0;
+
+	if (num_deps == 1)
+		return tse_task_add_dependent(task, dep_tasks[0]);
+
+	if (dtp->dtp_completed) {
+		D_ERROR("Can't add a dependency for a completed task (%p)\n",
+			task);
+		return -DER_NO_PERM;
+	}
 
+	D_INIT_LIST_HEAD(&tlinks);
 	for (i = 0; i < num_deps; i++) {
-		rc = tse_task_add_dependent(task, dep_tasks[i]);
-		if (rc)
-			return rc;
+		dep_dtp = tse_task2priv(dep_tasks[i]);
+		D_ASSERT(task != dep_tasks[i]);
+
+		if (dtp->dtp_sched != dep_dtp->dtp_sched) {
+			D_ERROR("Two tasks should belong to the same "
+				"scheduler.\n");
+			D_GOTO(out, rc = -DER_NO_PERM);
+		}
+
+		/** if task to depend on has completed already, skip it */
+		if (dep_dtp->dtp_completed)
+			continue;
+
+		D_ALLOC_PTR(tlink);
+		if (tlink == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+
+		/** point to the dep task until it's linked */
+		tlink->tl_task = dep_tasks[i];
+		d_list_add_tail(&tlink->tl_link, &tlinks);
 	}
-	return 0;
+
+	D_MUTEX_LOCK(&dtp->dtp_sched->dsp_lock);
+	d_list_for_each_entry_safe(tlink, tmp, &tlinks, tl_link) {
+		dep_dtp = tse_task2priv(tlink->tl_task);
+		if (dep_dtp->dtp_completed)
+			continue;
+
+		D_DEBUG(DB_TRACE, "Add dependent %p ---> %p\n", dep_dtp, dtp);
+		tlink->tl_task = task;
+		d_list_move_tail(&tlink->tl_link, &dep_dtp->dtp_dep_list);
+		cnt++;
+	}
+	dtp->dtp_refcnt += cnt;
+	dtp->dtp_dep_cnt += cnt;
+	D_MUTEX_UNLOCK(&dtp->dtp_sched->dsp_lock);
+out:
+	d_list_for_each_entry_safe(tlink, tmp, &tlinks, tl_link) {
+		d_list_del(&tlink->tl_link);
+		D_FREE(tlink);
+	}
+	return rc;
 }
 
 int
@@ -1042,10 +1189,15 @@ tse_task_schedule_with_delay(tse_task_t *task, bool instant, uint64_t delay)
 	 * function now.
 	 */
 	if (instant) {
+		bool	completed;
+
 		dtp->dtp_func(task);
 
 		/** If task was completed return the task result */
-		if (dtp->dtp_completed)
+		D_MUTEX_LOCK(&dsp->dsp_lock);
+		completed = dtp->dtp_completed || tse_task_comp_queued(dtp);
+		D_MUTEX_UNLOCK(&dsp->dsp_lock);
+		if (completed)
 			rc = task->dt_result;
 
 		tse_task_decref(task);
@@ -1082,6 +1234,11 @@ tse_task_reinit_with_delay(tse_task_t *task, uint64_t delay)
 		D_GOTO(err_unlock, rc = -DER_INVAL);
 	}
 
+	if (tse_task_comp_queued(dtp)) {
+		D_ERROR("Can't re-init a task queued for completion.\n");
+		D_GOTO(err_unlock, rc = -DER_NO_PERM);
+	}
+
 	if (dtp->dtp_completed) {
 		D_ASSERT(d_list_empty(&dtp->dtp_list));
 		/* +1 ref for valid until complete */
@@ -30,8 +30,15 @@ struct tse_task_private {
 	/* links to scheduler */
 	d_list_t			 dtp_list;
 
-	/* time to start running this task */
-	uint64_t			 dtp_wakeup_time;
+	union {
+		/* time to start running this task */
+		uint64_t			 dtp_wakeup_time;
+		/*
+		 * link to scheduler's completion queue, it's only used by
+		 * running task whose dtp_wakeup_time is always zero.
+		 */
+		struct tse_task_private		*dtp_comp_next;
+	};
 
 	/* list of tasks that depend on this task */
 	d_list_t			 dtp_dep_list;
@@ -78,8 +85,13 @@ struct tse_task_private {
 	 * The sum of dtp_stack_top and dtp_embed_top should not exceed
 	 * TSE_TASK_ARG_LEN.
 	 */
-	uint32_t			 dtp_stack_top;
-	uint32_t			 dtp_embed_top;
+	uint16_t			 dtp_stack_top;
+	uint16_t			 dtp_embed_top;
+	/**
+	 * task is on the scheduler's completion queue, set atomically before
+	 * the task is queued and cleared under dsp_lock once it's completed.
+	 */
+	uint32_t			 dtp_comp_queued;
 	char				 dtp_buf[TSE_TASK_ARG_LEN];
 };
 
@@ -118,6 +130,13 @@ struct tse_sched_private {
 	/* the list for complete callback */
 	d_list_t	dsp_comp_cb_list;
 
+	/*
+	 * Lock-free (multi-producer, single-consumer) queue of the tasks
+	 * completed while dsp_lock is contended, it's drained into the
+	 * complete list by the thread progressing the scheduler.
+	 */
+	struct tse_task_private	*dsp_comp_queue;
+
 	int		dsp_refcount;
 
 	/* number of tasks being executed */
@@ -23,6 +23,16 @@
 #include "cli_internal.h"
 #include "rpc.h"
 
+/**
+ * When DAOS_CONT_OPEN_SHARE is set, repeated opens from the same process of
+ * the same container through the same pool handle with the same flags share
+ * one container handle instead of each sending a CONT_OPEN RPC. The container
+ * service only sees the first open and the last close.
+ */
+static bool		cont_open_share;
+static D_LIST_HEAD(cont_share_list);
+static pthread_mutex_t	cont_share_lock = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * Initialize container interface
  */
@@ -31,6 +41,9 @@ dc_cont_init(void)
 {
 	int rc;
 
+	cont_open_share = false;
+	d_getenv_bool("DAOS_CONT_OPEN_SHARE", &cont_open_share);
+
 	rc = daos_rpc_register(&cont_proto_fmt, CONT_PROTO_CLI_COUNT,
 				NULL, DAOS_CONT_MODULE);
 	if (rc != 0)
@@ -504,6 +517,7 @@ void
 dc_cont_free(struct dc_cont *dc)
 {
 	D_ASSERT(daos_hhash_link_empty(&dc->dc_hlink));
+	D_ASSERT(d_list_empty(&dc->dc_share_link));
 	D_RWLOCK_DESTROY(&dc->dc_obj_list_lock);
 	D_ASSERT(d_list_empty(&dc->dc_po_list));
 	D_ASSERT(d_list_empty(&dc->dc_obj_list));
@@ -523,12 +537,78 @@ dc_cont_alloc(const uuid_t uuid)
 	uuid_copy(dc->dc_uuid, uuid);
 	D_INIT_LIST_HEAD(&dc->dc_obj_list);
 	D_INIT_LIST_HEAD(&dc->dc_po_list);
+	D_INIT_LIST_HEAD(&dc->dc_share_link);
 	if (D_RWLOCK_INIT(&dc->dc_obj_list_lock, NULL) != 0)
 		D_FREE(dc);
 
 	return dc;
 }
 
+/**
+ * Look for an open handle of the container identified by @label or @uuid that
+ * was opened through pool handle @poh with the same @capas. On success, take a
+ * share of it and return a handle to it in @coh.
+ */
+static bool
+cont_share_get(const char *label, uuid_t uuid, daos_handle_t poh,
+	       uint64_t capas, daos_handle_t *coh)
+{
+	struct dc_cont	*cont;
+	bool		 found = false;
+
+	D_MUTEX_LOCK(&cont_share_lock);
+	d_list_for_each_entry(cont, &cont_share_list, dc_share_link) {
+		if (cont->dc_capas != capas || cont->dc_closing ||
+		    cont->dc_pool_hdl.cookie != poh.cookie)
+			continue;
+		if (label != NULL ? strcmp(cont->dc_label, label) != 0 :
+		    uuid_compare(cont->dc_uuid, uuid) != 0)
+			continue;
+
+		cont->dc_share_nr++;
+		dc_cont2hdl(cont, coh);
+		found = true;
+		D_DEBUG(DF_DSMC, DF_UUID": opened: cookie="DF_X64" hdl="DF_UUID
+			" shared %u\n", DP_UUID(cont->dc_uuid), coh->cookie,
+			DP_UUID(cont->dc_cont_hdl), cont->dc_share_nr);
+		break;
+	}
+	D_MUTEX_UNLOCK(&cont_share_lock);
+
+	return found;
+}
+
+static void
+cont_share_add(struct dc_cont *cont)
+{
+	D_MUTEX_LOCK(&cont_share_lock);
+	cont->dc_share_nr = 1;
+	d_list_add(&cont->dc_share_link, &cont_share_list);
+	D_MUTEX_UNLOCK(&cont_share_lock);
+}
+
+/**
+ * Drop one share of the handle. Returns true if other opens still share it,
+ * in which case the caller must not close the container.
+ */
+static bool
+cont_share_put(struct dc_cont *cont)
+{
+	bool	shared = false;
+
+	D_MUTEX_LOCK(&cont_share_lock);
+	if (!d_list_empty(&cont->dc_share_link)) {
+		D_ASSERT(cont->dc_share_nr > 0);
+		if (--cont->dc_share_nr > 0)
+			shared = true;
+		else
+			d_list_del_init(&cont->dc_share_link);
+	}
+	D_MUTEX_UNLOCK(&cont_share_lock);
+
+	return shared;
+}
+
 static int
 dc_cont_props_init(struct dc_cont *cont)
 {
@@ -763,6 +843,8 @@ cont_open_complete(tse_task_t *task, void *data)
 
 	dc_cont_hdl_link(cont); /* +1 ref */
 	dc_cont2hdl(cont, arg->hdlp); /* +1 ref */
+	if (cont_open_share)
+		cont_share_add(cont);
 
 	D_DEBUG(DF_DSMC, DF_CONT": opened: cookie="DF_X64" hdl="DF_UUID
 		" master\n", DP_CONT(pool->dp_pool, cont->dc_uuid),
@@ -907,11 +989,22 @@ dc_cont_open(tse_task_t *task)
 		D_GOTO(err, rc = -DER_NO_HDL);
 
 	if (cont == NULL) {
+		/** container info comes from the open RPC, don't share */
+		if (cont_open_share && args->info == NULL &&
+		    cont_share_get(label, uuid, args->poh, args->flags,
+				   args->coh)) {
+			dc_pool_put(pool);
+			tse_task_complete(task, 0);
+			return 0;
+		}
+
 		cont = dc_cont_alloc(uuid);
 		if (cont == NULL)
 			D_GOTO(err_pool, rc = -DER_NOMEM);
 		uuid_generate(cont->dc_cont_hdl);
 		cont->dc_capas = args->flags;
+		if (label)
+			strncpy(cont->dc_label, label, DAOS_PROP_LABEL_MAX_LEN);
 		dc_task_set_priv(task, cont);
 	}
 
@@ -1025,6 +1118,14 @@ dc_cont_close(tse_task_t *task)
 	if (cont == NULL)
 		D_GOTO(err, rc = -DER_NO_HDL);
 
+	/* other opens still use the handle, objects may be open */
+	if (cont_share_put(cont)) {
+		dc_cont_put(cont); /* the ref taken by cont_share_get() */
+		dc_cont_put(cont);
+		tse_task_complete(task, 0);
+		return 0;
+	}
+
 	/* Check if there are not objects opened for this container */
 	D_RWLOCK_RDLOCK(&cont->dc_obj_list_lock);
 	if (!d_list_empty(&cont->dc_obj_list)) {
@@ -16,6 +16,10 @@ struct dc_cont {
 	struct d_hlink		dc_hlink;
 	/* list to pool */
 	d_list_t		dc_po_list;
+	/* link chain in the shared open list */
+	d_list_t		dc_share_link;
+	/* number of opens sharing this handle */
+	unsigned int		dc_share_nr;
 	/* object list for this container */
 	d_list_t		dc_obj_list;
 	/* lock for list of dc_obj_list */
@@ -24,6 +28,8 @@ struct dc_cont {
 	uuid_t			dc_uuid;
 	uuid_t			dc_cont_hdl;
 	uint64_t		dc_capas;
+	/* label this container was opened by, if any */
+	char			dc_label[DAOS_PROP_LABEL_MAX_LEN + 1];
 	/* pool handler of the container */
 	daos_handle_t		dc_pool_hdl;
 	struct daos_csummer    *dc_csummer;
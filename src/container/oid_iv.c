@@ -17,6 +17,12 @@
 #include "srv_internal.h"
 
 #define OID_BLOCK 32
+/**
+ * Upper bound of the range a node requests from its parent. Each forward
+ * doubles the range of the entry, so the nodes that allocate the most come
+ * to reserve ahead of demand and rarely go up the tree.
+ */
+#define OID_BLOCK_MAX (32 * 1024)
 
 struct oid_iv_key {
 	/** The Key ID, being the container uuid */
@@ -29,6 +35,8 @@ struct oid_iv_key {
 struct oid_iv_entry {
 	/** value of the IV entry */
 	struct oid_iv_range	rg;
+	/** num of oids to request from the parent next time */
+	daos_size_t		block;
 	/** protect the entry */
 	ABT_mutex		lock;
 };
@@ -179,6 +187,10 @@ oid_iv_ent_update(struct ds_iv_entry *ns_entry, struct ds_iv_key *iv_key,
 		oids->num_oids = OID_BLOCK;
 	else
 		oids->num_oids = (num_oids / OID_BLOCK) * OID_BLOCK * 2;
+	if (oids->num_oids < entry->block)
+		oids->num_oids = entry->block;
+	entry->block = min(max(entry->block, (daos_size_t)OID_BLOCK) * 2,
+			   (daos_size_t)OID_BLOCK_MAX);
 
 	/** Keep track of how much this node originally requested */
 	priv->num_oids = num_oids;
@@ -16,11 +16,26 @@
 #include "rpc.h"
 #include "srv_internal.h"
 
+/* Number of ULTs aggregating a VOS container in parallel */
+unsigned int cont_agg_ults = 1;
+
 static int
 init(void)
 {
 	int rc;
 
+	d_getenv_int("DAOS_AGG_ULTS", &cont_agg_ults);
+	if (cont_agg_ults == 0)
+		cont_agg_ults = 1;
+	if (cont_agg_ults > CONT_AGG_ULTS_MAX) {
+		D_WARN("DAOS_AGG_ULTS %u is too large, use %u\n",
+		       cont_agg_ults, CONT_AGG_ULTS_MAX);
+		cont_agg_ults = CONT_AGG_ULTS_MAX;
+	}
+	if (cont_agg_ults > 1)
+		D_INFO("Aggregate VOS container with %u ULTs\n",
+		       cont_agg_ults);
+
 	rc = ds_oid_iv_init();
 	if (rc)
 		D_GOTO(err, rc);
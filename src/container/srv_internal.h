@@ -35,10 +35,15 @@ struct cont_pool_metrics {
 	struct d_tm_node_t	*cpm_open_cont_gauge;
 };
 
+/* Number of recently used container handles cached per xstream */
+#define DSM_HDL_MRU_NR	4
+
 /* ds_cont thread local storage structure */
 struct dsm_tls {
 	struct daos_lru_cache  *dt_cont_cache;
 	struct d_hash_table	dt_cont_hdl_hash;
+	/* Most recently looked up handles, all of them are in dt_cont_hdl_hash */
+	struct ds_cont_hdl     *dt_cont_hdl_mru[DSM_HDL_MRU_NR];
 };
 
 extern struct dss_module_key cont_module_key;
@@ -56,6 +61,10 @@ dsm_tls_get()
 
 extern bool ec_agg_disabled;
 
+/* Max number of ULTs aggregating a VOS container in parallel */
+#define CONT_AGG_ULTS_MAX	16
+extern unsigned int cont_agg_ults;
+
 struct ec_eph {
 	d_rank_t	rank;
 	daos_epoch_t	eph;
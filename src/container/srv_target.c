@@ -48,6 +48,12 @@
 
 #define DAOS_AGG_LAZY_RATE	50 /* ms */
 
+daos_epoch_t
+ds_cont_stable_epoch(void)
+{
+	return crt_hlc_get() - crt_sec2hlc(DAOS_AGG_THRESHOLD);
+}
+
 bool
 agg_rate_ctl(void *arg)
 {
@@ -230,6 +236,49 @@ cont_aggregate_runnable(struct ds_cont_child *cont, struct sched_request *req,
 	return true;
 }
 
+/*
+ * Return the epoch aggregation has to restart from after snapshot deletions
+ * or rebuild. If only snapshots were deleted since the last full pass of
+ * \a param, the intervals below the lowest deleted snapshot have not changed.
+ */
+static daos_epoch_t
+cont_agg_restart_eph(struct ds_cont_child *cont, struct agg_param *param)
+{
+	daos_epoch_t	eph = DAOS_EPOCH_MAX;
+	uint64_t	i;
+
+	if (param->ap_full_scan_hlc == 0 ||
+	    param->ap_full_scan_hlc < cont->sc_pool->spc_rebuild_end_hlc ||
+	    cont->sc_snapshot_delete_nr - param->ap_snapshot_delete_nr >
+	    CONT_SNAP_DEL_LOG_NR)
+		return 0;
+
+	for (i = param->ap_snapshot_delete_nr; i < cont->sc_snapshot_delete_nr; i++)
+		eph = min(eph, cont->sc_snapshot_delete_ephs[i % CONT_SNAP_DEL_LOG_NR]);
+
+	return eph == DAOS_EPOCH_MAX ? 0 : eph;
+}
+
+/* Return the index of the first snapshot not less than \a epoch. */
+static int
+cont_agg_snap_lower_bound(uint64_t *snapshots, int snapshots_nr,
+			  daos_epoch_t epoch)
+{
+	int	lo = 0;
+	int	hi = snapshots_nr;
+
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+
+		if (snapshots[mid] < epoch)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
 #define MAX_SNAPSHOT_LOCAL	16
 static int
 cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
@@ -245,7 +294,9 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 	uint64_t		*snapshots = NULL;
 	int			snapshots_nr;
 	int			tgt_id = dss_get_module_info()->dmi_tgt_id;
+	uint64_t		del_nr;
 	uint32_t		flags = 0;
+	bool			restart = false;
 	int			i, rc = 0;
 
 	/* Check if it's ok to start aggregation in every 2 seconds */
@@ -255,11 +306,17 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 
 	change_hlc = max(cont->sc_snapshot_delete_hlc,
 			 cont->sc_pool->spc_rebuild_end_hlc);
+	del_nr = cont->sc_snapshot_delete_nr;
 	if (param->ap_full_scan_hlc < change_hlc) {
 		/* Snapshot has been deleted or rebuild happens since the last
-		 * aggregation, let's restart from 0.
+		 * aggregation, let's restart from 0, or from the lowest deleted
+		 * snapshot if only snapshots were deleted.
 		 */
-		epoch_min = 0;
+		D_ASSERT(param->ap_start_eph_get != NULL);
+		epoch_min = cont_agg_restart_eph(cont, param);
+		if (epoch_min != 0)
+			epoch_min = min(epoch_min, param->ap_start_eph_get(cont));
+		restart = true;
 		flags |= VOS_AGG_FL_FORCE_SCAN;
 		D_DEBUG(DB_EPC, "change hlc "DF_X64" > full "DF_X64"\n",
 			change_hlc, param->ap_full_scan_hlc);
@@ -293,8 +350,13 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 		 * When there isn't space pressure, don't aggregate too often,
 		 * otherwise, aggregation will be inefficient because the data
 		 * to be aggregated could be changed by new update very soon.
+		 *
+		 * Objects with high overwrite ratio are exception, aggregate
+		 * them alone, cold objects will wait for next interval.
 		 */
-		return 0;
+		if (!param->ap_vos_agg || !vos_aggregate_hot(cont->sc_hdl))
+			return 0;
+		flags |= VOS_AGG_FL_HOT_ONLY;
 	}
 
 	/* Adjust aggregation top boundary */
@@ -350,8 +412,7 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 	}
 
 	/* Find highest snapshot less than last aggregated epoch. */
-	for (i = 0; i < snapshots_nr && snapshots[i] < epoch_min; ++i)
-		;
+	i = cont_agg_snap_lower_bound(snapshots, snapshots_nr, epoch_min);
 
 	if (i == 0)
 		epoch_range.epr_lo = 0;
@@ -393,8 +454,13 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 		flags &= ~VOS_AGG_FL_FORCE_MERGE;
 	rc = agg_cb(cont, &epoch_range, flags, param, msecs);
 out:
-	if (rc == 0 && epoch_min == 0)
+	if (flags & VOS_AGG_FL_HOT_ONLY)
+		/* Don't run hot objects aggregation more often than checking */
+		*msecs = 2ULL * 1000;
+	else if (rc == 0 && (epoch_min == 0 || restart)) {
 		param->ap_full_scan_hlc = hlc;
+		param->ap_snapshot_delete_nr = del_nr;
+	}
 
 	D_DEBUG(DB_EPC, DF_CONT"[%d]: Aggregating finished, sleep "DF_U64
 		" mseconds: %d\n",
@@ -450,13 +516,131 @@ out:
 		dmi->dmi_tgt_id);
 }
 
+/* One partition of a parallel VOS aggregation */
+struct cont_agg_part {
+	/* Own copy of aggregation parameters, ap_req is the partition ULT */
+	struct agg_param	 cap_param;
+	/* Request of the aggregation ULT which spawned the partition */
+	struct sched_request	*cap_parent;
+	daos_epoch_range_t	*cap_epr;
+	uint32_t		 cap_flags;
+	uint32_t		 cap_part;
+	uint32_t		 cap_part_nr;
+	int			 cap_rc;
+};
+
+static bool
+agg_part_rate_ctl(void *arg)
+{
+	struct cont_agg_part	*cap = arg;
+
+	/* Container is being stopped, the parent is waiting for us */
+	if (dss_ult_exiting(cap->cap_parent))
+		return true;
+
+	return agg_rate_ctl(&cap->cap_param);
+}
+
+static void
+cont_agg_part_ult(void *arg)
+{
+	struct cont_agg_part	*cap = arg;
+	struct ds_cont_child	*cont = cap->cap_param.ap_cont;
+
+	cap->cap_rc = vos_aggregate_part(cont->sc_hdl, cap->cap_epr,
+					 cap->cap_part, cap->cap_part_nr,
+					 agg_part_rate_ctl, cap,
+					 cap->cap_flags);
+}
+
+/*
+ * Aggregate the container with @cont_agg_ults ULTs, each one aggregates the
+ * objects of one partition. Partition 0 is aggregated by current ULT, all
+ * partition ULTs are GC requests, so they are throttled by the scheduler
+ * as a whole.
+ */
+static int
+cont_vos_aggregate_parallel(struct ds_cont_child *cont,
+			    daos_epoch_range_t *epr, uint32_t flags,
+			    struct agg_param *param)
+{
+	struct cont_agg_part	 caps[CONT_AGG_ULTS_MAX];
+	struct sched_request	*reqs[CONT_AGG_ULTS_MAX] = { 0 };
+	struct sched_req_attr	 attr;
+	uint32_t		 part_nr = cont_agg_ults;
+	uint32_t		 i;
+	int			 rc = 0;
+
+	D_ASSERT(part_nr > 1 && part_nr <= CONT_AGG_ULTS_MAX);
+	sched_req_attr_init(&attr, SCHED_REQ_GC, &cont->sc_pool->spc_uuid);
+
+	for (i = 0; i < part_nr; i++) {
+		caps[i].cap_param = *param;
+		caps[i].cap_parent = param->ap_req;
+		caps[i].cap_epr = epr;
+		caps[i].cap_flags = flags;
+		caps[i].cap_part = i;
+		caps[i].cap_part_nr = part_nr;
+		caps[i].cap_rc = 0;
+	}
+
+	/* Spawned ULTs don't run before current ULT yields */
+	for (i = 1; i < part_nr; i++) {
+		reqs[i] = sched_create_ult(&attr, cont_agg_part_ult, &caps[i],
+					   DSS_DEEP_STACK_SZ);
+		if (reqs[i] == NULL) {
+			D_ERROR(DF_CONT": Failed to create aggregation ULT %u\n",
+				DP_CONT(cont->sc_pool->spc_uuid, cont->sc_uuid),
+				i);
+			rc = -DER_NOMEM;
+			break;
+		}
+		caps[i].cap_param.ap_req = reqs[i];
+	}
+
+	if (rc == 0)
+		caps[0].cap_rc = vos_aggregate_part(cont->sc_hdl, epr, 0,
+						    part_nr, agg_rate_ctl,
+						    &caps[0].cap_param, flags);
+
+	for (i = 1; i < part_nr; i++) {
+		if (reqs[i] == NULL)
+			continue;
+
+		sched_req_wait(reqs[i], rc != 0);
+		sched_req_put(reqs[i]);
+	}
+
+	if (rc != 0)
+		return rc;
+
+	for (i = 0; i < part_nr; i++) {
+		if (caps[i].cap_rc == 0 || caps[i].cap_rc == -DER_CSUM)
+			continue;
+
+		D_DEBUG(DB_EPC, DF_CONT": Aggregation partition %u/%u: "DF_RC"\n",
+			DP_CONT(cont->sc_pool->spc_uuid, cont->sc_uuid), i,
+			part_nr, DP_RC(caps[i].cap_rc));
+		return caps[i].cap_rc;
+	}
+
+	/* All objects are aggregated, bump HAE */
+	if (!(flags & VOS_AGG_FL_HOT_ONLY))
+		vos_aggregate_hae_update(cont->sc_hdl, epr->epr_hi);
+	return 0;
+}
+
 static int
 cont_vos_aggregate_cb(struct ds_cont_child *cont, daos_epoch_range_t *epr,
 		      uint32_t flags, struct agg_param *param, uint64_t *msecs)
 {
 	int rc;
 
-	rc = vos_aggregate(cont->sc_hdl, epr, agg_rate_ctl, param, flags);
+	if (cont_agg_ults > 1)
+		rc = cont_vos_aggregate_parallel(cont, epr, flags, param);
+	else
+		rc = vos_aggregate(cont->sc_hdl, epr, agg_rate_ctl, param,
+				   flags);
 
 	/* Suppress csum error and continue on other epoch ranges */
 	if (rc == -DER_CSUM)
@@ -1046,7 +1230,14 @@ cont_hdl_add(struct d_hash_table *hash, struct ds_cont_hdl *hdl)
 static void
 cont_hdl_delete(struct d_hash_table *hash, struct ds_cont_hdl *hdl)
 {
-	bool deleted;
+	struct dsm_tls	*tls = dsm_tls_get();
+	bool		 deleted;
+	int		 i;
+
+	for (i = 0; i < DSM_HDL_MRU_NR; i++) {
+		if (tls->dt_cont_hdl_mru[i] == hdl)
+			tls->dt_cont_hdl_mru[i] = NULL;
+	}
 
 	deleted = d_hash_rec_delete(hash, hdl->sch_uuid, sizeof(uuid_t));
 	D_ASSERT(deleted == true);
@@ -1064,6 +1255,20 @@ cont_hdl_lookup_internal(struct d_hash_table *hash, const uuid_t uuid)
 	return cont_hdl_obj(rlink);
 }
 
+static void
+cont_hdl_put_internal(struct d_hash_table *hash,
+		      struct ds_cont_hdl *hdl)
+{
+	d_hash_rec_decref(hash, &hdl->sch_entry);
+}
+
+static void
+cont_hdl_get_internal(struct d_hash_table *hash,
+		      struct ds_cont_hdl *hdl)
+{
+	d_hash_rec_addref(hash, &hdl->sch_entry);
+}
+
 /**
  * lookup target container handle by container handle uuid (usually from req)
  *
@@ -1075,23 +1280,31 @@ cont_hdl_lookup_internal(struct d_hash_table *hash, const uuid_t uuid)
 struct ds_cont_hdl *
 ds_cont_hdl_lookup(const uuid_t uuid)
 {
-	struct d_hash_table *hash = &dsm_tls_get()->dt_cont_hdl_hash;
+	struct dsm_tls		*tls = dsm_tls_get();
+	struct ds_cont_hdl	*hdl;
+	int			 i;
 
-	return cont_hdl_lookup_internal(hash, uuid);
-}
+	/*
+	 * Every I/O RPC looks up its container handle, and an xstream usually
+	 * serves a handful of them: check the recently used ones before
+	 * hashing the uuid.
+	 */
+	for (i = 0; i < DSM_HDL_MRU_NR; i++) {
+		hdl = tls->dt_cont_hdl_mru[i];
+		if (hdl != NULL && uuid_compare(hdl->sch_uuid, uuid) == 0) {
+			cont_hdl_get_internal(&tls->dt_cont_hdl_hash, hdl);
+			return hdl;
+		}
+	}
 
-static void
-cont_hdl_put_internal(struct d_hash_table *hash,
-		      struct ds_cont_hdl *hdl)
-{
-	d_hash_rec_decref(hash, &hdl->sch_entry);
-}
+	hdl = cont_hdl_lookup_internal(&tls->dt_cont_hdl_hash, uuid);
+	if (hdl != NULL) {
+		memmove(&tls->dt_cont_hdl_mru[1], &tls->dt_cont_hdl_mru[0],
+			(DSM_HDL_MRU_NR - 1) * sizeof(hdl));
+		tls->dt_cont_hdl_mru[0] = hdl;
+	}
 
-static void
-cont_hdl_get_internal(struct d_hash_table *hash,
-		      struct ds_cont_hdl *hdl)
-{
-	d_hash_rec_addref(hash, &hdl->sch_entry);
+	return hdl;
 }
 
 /**
@@ -1895,11 +2108,28 @@ cont_snap_update_one(void *vin)
 {
 	struct cont_snap_args	*args = vin;
 	struct ds_cont_child	*cont;
+	uint64_t		 del_eph = 0;
+	int			 i;
 	int			 rc;
 
 	rc = ds_cont_child_lookup(args->pool_uuid, args->cont_uuid, &cont);
 	if (rc != 0)
 		return rc;
+
+	/*
+	 * Both lists are sorted and new snapshots only come at the tail, so
+	 * the first entry that differs is the lowest deleted snapshot.
+	 */
+	for (i = 0; i < cont->sc_snapshots_nr; i++) {
+		if (i >= args->snap_count ||
+		    cont->sc_snapshots[i] != args->snapshots[i]) {
+			del_eph = cont->sc_snapshots[i];
+			if (i < args->snap_count)
+				del_eph = min(del_eph, args->snapshots[i]);
+			break;
+		}
+	}
+
 	if (args->snap_count == 0) {
 		if (cont->sc_snapshots != NULL) {
 			D_ASSERT(cont->sc_snapshots_nr > 0);
@@ -1921,6 +2151,9 @@ cont_snap_update_one(void *vin)
 
 	/* Snapshot deleted, reset aggregation lower bound epoch */
 	if (cont->sc_snapshots_nr > args->snap_count) {
+		cont->sc_snapshot_delete_ephs[cont->sc_snapshot_delete_nr %
+					      CONT_SNAP_DEL_LOG_NR] = del_eph;
+		cont->sc_snapshot_delete_nr++;
 		cont->sc_snapshot_delete_hlc = crt_hlc_get();
 		D_DEBUG(DB_EPC, DF_CONT": Reset aggregation lower bound\n",
 			DP_CONT(args->pool_uuid, args->cont_uuid));
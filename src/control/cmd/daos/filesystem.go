@@ -33,6 +33,7 @@ type fsCmd struct {
 	ResetAttr      fsResetAttrCmd      `command:"reset-attr" description:"reset fs attributes"`
 	ResetChunkSize fsResetChunkSizeCmd `command:"reset-chunk-size" description:"reset fs chunk size"`
 	ResetObjClass  fsResetOclassCmd    `command:"reset-oclass" description:"reset fs obj class"`
+	SuggestOclass  fsSuggestOclassCmd  `command:"suggest-oclass" description:"suggest obj class for new files of a directory"`
 }
 
 type fsCopyCmd struct {
@@ -230,3 +231,70 @@ func (cmd *fsGetAttrCmd) Execute(_ []string) error {
 
 	return nil
 }
+
+type fsSuggestOclassCmd struct {
+	fsAttrCmd
+
+	Sharers uint32 `long:"sharers" short:"n" description:"number of clients accessing a same file concurrently"`
+	Apply   bool   `long:"apply" short:"a" description:"set the suggested obj class on the directory"`
+}
+
+func (cmd *fsSuggestOclassCmd) Execute(_ []string) error {
+	ap, deallocCmdArgs, err := setupFSAttrCmd(&cmd.fsAttrCmd)
+	if err != nil {
+		return err
+	}
+	defer deallocCmdArgs()
+
+	flags := C.uint(C.DAOS_COO_RO)
+	dfsFlags := C.int(0)
+	if cmd.Apply {
+		flags = C.uint(C.DAOS_COO_RW)
+		dfsFlags = C.DFS_OCLASS_APPLY
+	}
+
+	cleanup, err := cmd.resolveAndConnect(flags, ap)
+	if err != nil {
+		return err
+	}
+	defer cleanup()
+
+	var advice C.dfs_oclass_advice_t
+	advice.doa_sharers = C.uint32_t(cmd.Sharers)
+	if err := dfsError(C.fs_dfs_suggest_oclass_hdlr(ap, dfsFlags, &advice)); err != nil {
+		return errors.Wrap(err, "suggest-oclass failed")
+	}
+
+	var curName, newName [16]C.char
+	C.daos_oclass_id2name(advice.doa_cur_oclass, &curName[0])
+	C.daos_oclass_id2name(advice.doa_oclass, &newName[0])
+
+	if cmd.jsonOutputEnabled() {
+		jsonAdvice := &struct {
+			Files    uint64 `json:"files"`
+			AvgSize  uint64 `json:"avg_size"`
+			MaxSize  uint64 `json:"max_size"`
+			ObjClass string `json:"oclass"`
+			Suggest  string `json:"suggested_oclass"`
+			Applied  bool   `json:"applied"`
+		}{
+			Files:    uint64(advice.doa_nr_files),
+			AvgSize:  uint64(advice.doa_avg_size),
+			MaxSize:  uint64(advice.doa_max_size),
+			ObjClass: C.GoString(&curName[0]),
+			Suggest:  C.GoString(&newName[0]),
+			Applied:  cmd.Apply && advice.doa_oclass != advice.doa_cur_oclass,
+		}
+		return cmd.outputJSON(jsonAdvice, nil)
+	}
+
+	cmd.log.Infof("Files Sampled = %d (avg size %d, max size %d)",
+		advice.doa_nr_files, advice.doa_avg_size, advice.doa_max_size)
+	cmd.log.Infof("Object Class = %s", C.GoString(&curName[0]))
+	cmd.log.Infof("Suggested Object Class = %s", C.GoString(&newName[0]))
+	if cmd.Apply && advice.doa_oclass != advice.doa_cur_oclass {
+		cmd.log.Info("Suggested Object Class applied to new files")
+	}
+
+	return nil
+}
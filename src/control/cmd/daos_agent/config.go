@@ -32,6 +32,8 @@ type Config struct {
 	LogFile          string                    `yaml:"log_file"`
 	TransportConfig  *security.TransportConfig `yaml:"transport_config"`
 	FabricInterfaces []*NUMAFabricConfig       `yaml:"fabric_ifaces,omitempty"`
+	// Period in seconds of the GetAttachInfo cache refresh, 0 to disable
+	CacheRefreshInterval int `yaml:"cache_refresh_interval,omitempty"`
 }
 
 // NUMAFabricConfig defines a list of fabric interfaces that belong to a NUMA
@@ -9,6 +9,7 @@ package main
 import (
 	"context"
 	"sync"
+	"time"
 
 	"github.com/pkg/errors"
 	"google.golang.org/protobuf/proto"
@@ -45,6 +46,11 @@ type attachInfoCache struct {
 
 	// cached response from remote server
 	attachInfo *mgmtpb.GetAttachInfoResp
+
+	// last remote request, replayed by Refresh()
+	numaNode  int
+	sys       string
+	getRemote getAttachInfoFn
 }
 
 func (c *attachInfoCache) isCached() bool {
@@ -87,10 +93,71 @@ func (c *attachInfoCache) Get(ctx context.Context, numaNode int, sys string, get
 
 	c.attachInfo = attachInfo
 	c.initialized.SetTrue()
+	c.numaNode = numaNode
+	c.sys = sys
+	c.getRemote = getRemote
 
 	return c.getAttachInfoResp()
 }
 
+// Invalidate drops the cached response, so that the next Get() fetches it
+// again from the remote server.
+func (c *attachInfoCache) Invalidate() {
+	c.mutex.Lock()
+	defer c.mutex.Unlock()
+
+	c.initialized.SetFalse()
+	c.attachInfo = nil
+}
+
+// Refresh fetches the response from the remote server again and replaces the
+// cached one with it. The cached response is kept if the remote call fails.
+// Nothing is done if no response has ever been cached.
+func (c *attachInfoCache) Refresh(ctx context.Context) error {
+	c.mutex.Lock()
+	numaNode, sys, getRemote := c.numaNode, c.sys, c.getRemote
+	c.mutex.Unlock()
+
+	if !c.isEnabled() || getRemote == nil {
+		return nil
+	}
+
+	// Clients keep being served from the cache while the remote call runs.
+	attachInfo, err := getRemote(ctx, numaNode, sys)
+	if err != nil {
+		return err
+	}
+
+	c.mutex.Lock()
+	defer c.mutex.Unlock()
+
+	c.attachInfo = attachInfo
+	c.initialized.SetTrue()
+
+	return nil
+}
+
+// startRefresh refreshes the cached response every interval until the
+// context is canceled. The remote server then sees one request per agent and
+// interval, whatever the number of client processes.
+func (c *attachInfoCache) startRefresh(ctx context.Context, interval time.Duration) {
+	go func() {
+		ticker := time.NewTicker(interval)
+		defer ticker.Stop()
+
+		for {
+			select {
+			case <-ctx.Done():
+				return
+			case <-ticker.C:
+				if err := c.Refresh(ctx); err != nil {
+					c.log.Errorf("failed to refresh cached GetAttachInfo: %s", err)
+				}
+			}
+		}
+	}()
+}
+
 func newLocalFabricCache(log logging.Logger, enabled bool) *localFabricCache {
 	return &localFabricCache{
 		log:             log,
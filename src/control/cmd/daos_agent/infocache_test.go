@@ -125,6 +125,120 @@ func TestAgent_attachInfoCache_Get(t *testing.T) {
 	}
 }
 
+func TestAgent_attachInfoCache_Refresh(t *testing.T) {
+	oldResp := &mgmtpb.GetAttachInfoResp{
+		RankUris: []*mgmtpb.GetAttachInfoResp_RankUri{
+			{Rank: 1, Uri: "firsturi"},
+		},
+	}
+	newResp := &mgmtpb.GetAttachInfoResp{
+		RankUris: []*mgmtpb.GetAttachInfoResp_RankUri{
+			{Rank: 1, Uri: "firsturi"},
+			{Rank: 2, Uri: "nexturi"},
+		},
+	}
+
+	for name, tc := range map[string]struct {
+		enabled   bool
+		noGet     bool
+		remoteErr error
+		expRemote bool
+		expResp   *mgmtpb.GetAttachInfoResp
+		expErr    error
+	}{
+		"not enabled": {},
+		"never fetched": {
+			enabled: true,
+			noGet:   true,
+		},
+		"refreshed": {
+			enabled:   true,
+			expRemote: true,
+			expResp:   newResp,
+		},
+		"remote fails": {
+			enabled:   true,
+			remoteErr: errors.New("no soup for you"),
+			expRemote: true,
+			expResp:   oldResp,
+			expErr:    errors.New("no soup for you"),
+		},
+	} {
+		t.Run(name, func(t *testing.T) {
+			log, buf := logging.NewTestLogger(t.Name())
+			defer common.ShowBufferOnFailure(t, buf)
+
+			aic := newAttachInfoCache(log, tc.enabled)
+
+			numaNode := 42
+			sysName := "snekSezSyss"
+			remoteResp := oldResp
+			remoteInvoked := atm.NewBool(false)
+			getFn := func(_ context.Context, node int, name string) (*mgmtpb.GetAttachInfoResp, error) {
+				common.AssertEqual(t, numaNode, node, "node was not supplied")
+				common.AssertEqual(t, sysName, name, "name was not supplied")
+
+				remoteInvoked.SetTrue()
+				if remoteResp != oldResp && tc.remoteErr != nil {
+					return nil, tc.remoteErr
+				}
+				return remoteResp, nil
+			}
+
+			if !tc.noGet {
+				if _, err := aic.Get(context.Background(), numaNode, sysName, getFn); err != nil {
+					t.Fatal(err)
+				}
+			}
+
+			remoteResp = newResp
+			remoteInvoked.SetFalse()
+			gotErr := aic.Refresh(context.Background())
+			common.CmpErr(t, tc.expErr, gotErr)
+			common.AssertEqual(t, tc.expRemote, remoteInvoked.Load(), "remote invoked")
+
+			if tc.expResp == nil {
+				return
+			}
+			cachedResp, err := aic.getAttachInfoResp()
+			if err != nil {
+				t.Fatal(err)
+			}
+			if diff := cmp.Diff(tc.expResp, cachedResp, common.DefaultCmpOpts()...); diff != "" {
+				t.Fatalf("-want, +got:\n%s", diff)
+			}
+		})
+	}
+}
+
+func TestAgent_attachInfoCache_Invalidate(t *testing.T) {
+	log, buf := logging.NewTestLogger(t.Name())
+	defer common.ShowBufferOnFailure(t, buf)
+
+	aic := newAttachInfoCache(log, true)
+	remoteCalls := 0
+	getFn := func(_ context.Context, _ int, _ string) (*mgmtpb.GetAttachInfoResp, error) {
+		remoteCalls++
+		return &mgmtpb.GetAttachInfoResp{}, nil
+	}
+
+	for i := 0; i < 2; i++ {
+		if _, err := aic.Get(context.Background(), 0, "", getFn); err != nil {
+			t.Fatal(err)
+		}
+	}
+	common.AssertEqual(t, 1, remoteCalls, "remote calls before invalidation")
+
+	aic.Invalidate()
+	common.AssertFalse(t, aic.isCached(), "cached after invalidation")
+
+	if _, err := aic.Get(context.Background(), 0, "", getFn); err != nil {
+		t.Fatal(err)
+	}
+	common.AssertEqual(t, 2, remoteCalls, "remote calls after invalidation")
+	common.AssertTrue(t, aic.isCached(), "not cached after Get")
+}
+
 func TestAgent_newLocalFabricCache(t *testing.T) {
 	for name, tc := range map[string]struct {
 		enabled bool
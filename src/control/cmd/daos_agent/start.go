@@ -77,12 +77,18 @@ func (cmd *startCmd) Execute(_ []string) error {
 		fabricCache.Cache(ctx, nf)
 	}
 
+	attachInfo := newAttachInfoCache(cmd.log, aicEnabled)
+	if aicEnabled && cmd.cfg.CacheRefreshInterval > 0 {
+		cmd.log.Debugf("GetAttachInfo cache refreshed every %ds", cmd.cfg.CacheRefreshInterval)
+		attachInfo.startRefresh(ctx, time.Duration(cmd.cfg.CacheRefreshInterval)*time.Second)
+	}
+
 	drpcServer.RegisterRPCModule(NewSecurityModule(cmd.log, cmd.cfg.TransportConfig))
 	drpcServer.RegisterRPCModule(&mgmtModule{
 		log:        cmd.log,
 		sys:        cmd.cfg.SystemName,
 		ctlInvoker: cmd.ctlInvoker,
-		attachInfo: newAttachInfoCache(cmd.log, aicEnabled),
+		attachInfo: attachInfo,
 		fabricInfo: fabricCache,
 		numaAware:  numaAware,
 		netCtx:     netCtx,
@@ -102,23 +108,31 @@ func (cmd *startCmd) Execute(_ []string) error {
 	signals := make(chan os.Signal)
 	finish := make(chan struct{})
 
-	signal.Notify(signals, syscall.SIGINT, syscall.SIGTERM, syscall.SIGPIPE)
+	signal.Notify(signals, syscall.SIGINT, syscall.SIGTERM, syscall.SIGPIPE, syscall.SIGHUP)
 	// Anonymous goroutine to wait on the signals channel and tell the
 	// program to finish when it receives a signal. Since we notify on
 	// SIGINT and SIGTERM we should only catch these on a kill or ctrl+c
 	// SIGPIPE is caught and logged to avoid killing the agent.
+	// SIGHUP drops the cached GetAttachInfo response, e.g. after the
+	// system membership changed.
 	// The syntax looks odd but <- Channel means wait on any input on the
 	// channel.
 	var shutdownRcvd time.Time
 	go func() {
-		sig := <-signals
-		switch sig {
-		case syscall.SIGPIPE:
-			cmd.log.Infof("Signal received.  Caught non-fatal %s; continuing", sig)
-		default:
-			shutdownRcvd = time.Now()
-			cmd.log.Infof("Signal received.  Caught %s; shutting down", sig)
-			close(finish)
+		for {
+			sig := <-signals
+			switch sig {
+			case syscall.SIGPIPE:
+				cmd.log.Infof("Signal received.  Caught non-fatal %s; continuing", sig)
+			case syscall.SIGHUP:
+				cmd.log.Infof("Signal received.  Caught %s; invalidating GetAttachInfo cache", sig)
+				attachInfo.Invalidate()
+			default:
+				shutdownRcvd = time.Now()
+				cmd.log.Infof("Signal received.  Caught %s; shutting down", sig)
+				close(finish)
+				return
+			}
 		}
 	}()
 	<-finish
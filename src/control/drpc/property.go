@@ -36,6 +36,10 @@ const (
 	PoolPropertyOwnerGroup = C.DAOS_PROP_PO_OWNER_GROUP
 	// PoolPropertyECCellSize is the EC Cell size.
 	PoolPropertyECCellSize = C.DAOS_PROP_PO_EC_CELL_SZ
+	// PoolPropertySchedWeight is the WFQ scheduling weight of the pool IO.
+	PoolPropertySchedWeight = C.DAOS_PROP_PO_SCHED_WEIGHT
+	// PoolSchedWeightMax is the maximum of PoolPropertySchedWeight.
+	PoolSchedWeightMax = C.DAOS_PROP_PO_SCHED_WEIGHT_MAX
 )
 
 const (
@@ -116,6 +116,25 @@ func PoolProperties() PoolPropertyMap {
 				jsonNumeric: true,
 			},
 		},
+		"sched_weight": {
+			Property: PoolProperty{
+				Number:      drpc.PoolPropertySchedWeight,
+				Description: "Scheduling weight",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					swErr := errors.Errorf("invalid sched_weight value %s (valid values: 1-%d)",
+						s, drpc.PoolSchedWeightMax)
+					w, err := strconv.ParseUint(s, 10, 64)
+					if err != nil {
+						return nil, swErr
+					}
+					if w == 0 || w > drpc.PoolSchedWeightMax {
+						return nil, swErr
+					}
+					return &PoolPropertyValue{w}, nil
+				},
+				jsonNumeric: true,
+			},
+		},
 	}
 }
 
@@ -129,6 +129,17 @@ func TestControl_PoolProperties(t *testing.T) {
 			value:  "wat",
 			expErr: errors.New("invalid"),
 		},
+		"sched_weight-valid": {
+			name:    "sched_weight",
+			value:   "200",
+			expStr:  "sched_weight:200",
+			expJson: []byte(`{"name":"sched_weight","description":"Scheduling weight","value":200}`),
+		},
+		"sched_weight-invalid": {
+			name:   "sched_weight",
+			value:  "0",
+			expErr: errors.New("invalid"),
+		},
 		"space_rb-valid": {
 			name:    "space_rb",
 			value:   "25",
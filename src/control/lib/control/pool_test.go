@@ -694,6 +694,10 @@ func TestPoolGetProp(t *testing.T) {
 							Number: propWithVal("ec_cell_sz", "").Number,
 							Value:  &mgmtpb.PoolProperty_Numval{1024},
 						},
+						{
+							Number: propWithVal("sched_weight", "").Number,
+							Value:  &mgmtpb.PoolProperty_Numval{200},
+						},
 					},
 				}),
 			},
@@ -704,6 +708,7 @@ func TestPoolGetProp(t *testing.T) {
 				propWithVal("ec_cell_sz", "1024"),
 				propWithVal("label", "foo"),
 				propWithVal("reclaim", "disabled"),
+				propWithVal("sched_weight", "200"),
 				propWithVal("self_heal", "exclude"),
 				propWithVal("space_rb", "42"),
 			},
@@ -32,6 +32,15 @@ type (
 		sources        []*EngineSource
 		cleanupSource  map[uint32]func()
 		sourceMutex    sync.RWMutex // To protect sources
+		ignoreCache    map[string]bool
+		ignoreMutex    sync.RWMutex // To protect ignoreCache
+	}
+
+	// filteredCollector exports the subset of the metrics of a Collector
+	// whose names match one of its patterns.
+	filteredCollector struct {
+		c       *Collector
+		matches []*regexp.Regexp
 	}
 
 	CollectorOpts struct {
@@ -168,8 +177,7 @@ func sanitizeMetricName(in string) string {
 	}, strings.TrimLeft(in, "/"))
 }
 
-func parseNameSubstr(labels labelMap, name string, matchRE string, replacement string, assignLabels func(labelMap, []string)) string {
-	re := regexp.MustCompile(matchRE)
+func parseNameSubstr(labels labelMap, name string, re *regexp.Regexp, replacement string, assignLabels func(labelMap, []string)) string {
 	matches := re.FindStringSubmatch(name)
 	if len(matches) > 0 {
 		assignLabels(labels, matches)
@@ -183,6 +191,28 @@ func parseNameSubstr(labels labelMap, name string, matchRE string, replacement s
 	return name
 }
 
+func getHexRE(numDigits int) string {
+	return strings.Repeat(`[[:xdigit:]]`, numDigits)
+}
+
+// Compiled once, since label extraction runs for every new metric.
+var (
+	idRE       = regexp.MustCompile(`ID_+(\d+)_?`)
+	xsRE       = regexp.MustCompile(`_?xs_(\d+)`)
+	tgtRE      = regexp.MustCompile(`_?tgt_(\d+)`)
+	ctxRE      = regexp.MustCompile(`_?ctx_(\d+)`)
+	netRE      = regexp.MustCompile(`net_+(\d+)`)
+	poolRE     = regexp.MustCompile(`pool_+(` + fmt.Sprintf("%s_%s_%s_%s_%s", getHexRE(8), getHexRE(4), getHexRE(4), getHexRE(4), getHexRE(12)) + `)`)
+	latencyREs = map[string]*regexp.Regexp{
+		"fetch":  latencySizeRE("fetch"),
+		"update": latencySizeRE("update"),
+	}
+)
+
+func latencySizeRE(latencyType string) *regexp.Regexp {
+	return regexp.MustCompile(`_+latency_+` + latencyType + `_+((?:GT)?[0-9]+[A-Z]?B)`)
+}
+
 func extractLabels(in string) (labels labelMap, name string) {
 	name = sanitizeMetricName(in)
 
@@ -190,39 +220,32 @@ func extractLabels(in string) (labels labelMap, name string) {
 
 	// Clean up metric names and parse out useful labels
 
-	ID_re := regexp.MustCompile(`ID_+(\d+)_?`)
-	name = ID_re.ReplaceAllString(name, "")
+	name = idRE.ReplaceAllString(name, "")
 
 	name = extractLatencySize(labels, name, "fetch")
 	name = extractLatencySize(labels, name, "update")
 
-	name = parseNameSubstr(labels, name, `_?xs_(\d+)`, "",
+	name = parseNameSubstr(labels, name, xsRE, "",
 		func(labels labelMap, matches []string) {
 			labels["xstream"] = matches[1]
 		})
 
-	name = parseNameSubstr(labels, name, `_?tgt_(\d+)`, "",
+	name = parseNameSubstr(labels, name, tgtRE, "",
 		func(labels labelMap, matches []string) {
 			labels["target"] = matches[1]
 		})
 
-	name = parseNameSubstr(labels, name, `_?ctx_(\d+)`, "",
+	name = parseNameSubstr(labels, name, ctxRE, "",
 		func(labels labelMap, matches []string) {
 			labels["context"] = matches[1]
 		})
 
-	name = parseNameSubstr(labels, name, `net_+(\d+)`, "net",
+	name = parseNameSubstr(labels, name, netRE, "net",
 		func(labels labelMap, matches []string) {
 			labels["rank"] = matches[1]
 		})
 
-	getHexRE := func(numDigits int) string {
-		return strings.Repeat(`[[:xdigit:]]`, numDigits)
-	}
-	uuid_re := fmt.Sprintf("%s_%s_%s_%s_%s", getHexRE(8), getHexRE(4), getHexRE(4),
-		getHexRE(4), getHexRE(12))
-
-	name = parseNameSubstr(labels, name, `pool_+(`+uuid_re+`)`, "pool",
+	name = parseNameSubstr(labels, name, poolRE, "pool",
 		func(labels labelMap, matches []string) {
 			labels["pool"] = strings.Replace(matches[1], "_", "-", -1)
 		})
@@ -230,8 +253,12 @@ func extractLabels(in string) (labels labelMap, name string) {
 }
 
 func extractLatencySize(labels labelMap, name, latencyType string) string {
-	return parseNameSubstr(labels, name, `_+latency_+`+latencyType+`_+((?:GT)?[0-9]+[A-Z]?B)`,
-		"_latency_"+latencyType,
+	re, found := latencyREs[latencyType]
+	if !found {
+		re = latencySizeRE(latencyType)
+	}
+
+	return parseNameSubstr(labels, name, re, "_latency_"+latencyType,
 		func(labels labelMap, matches []string) {
 			labels["size"] = matches[1]
 		})
@@ -253,7 +280,7 @@ func (es *EngineSource) Collect(log logging.Logger, ch chan<- *rankMetric) {
 	es.tmMutex.RLock()
 	defer es.tmMutex.RUnlock()
 
-	metrics := make(chan telemetry.Metric)
+	metrics := make(chan telemetry.Metric, collectChanSize)
 	go func() {
 		if err := telemetry.CollectMetrics(es.ctx, es.tmSchema, metrics); err != nil {
 			log.Errorf("failed to collect metrics for engine rank %d: %s", es.Rank, err)
@@ -283,6 +310,10 @@ func (es *EngineSource) Disable() {
 	es.enabled.SetFalse()
 }
 
+// Number of metrics buffered between the stages of a scrape, so that the
+// shared memory walk doesn't context switch for every metric.
+const collectChanSize = 128
+
 type gvMap map[string]*prometheus.GaugeVec
 
 func (m gvMap) add(name, help string, labels labelMap) {
@@ -387,8 +418,8 @@ func newRankMetric(log logging.Logger, rank uint32, m telemetry.Metric) *rankMet
 	return rm
 }
 
-func (c *Collector) isIgnored(name string) bool {
-	for _, re := range c.ignoredMetrics {
+func matchesAny(res []*regexp.Regexp, name string) bool {
+	for _, re := range res {
 		if re.MatchString(name) {
 			return true
 		}
@@ -397,6 +428,32 @@ func (c *Collector) isIgnored(name string) bool {
 	return false
 }
 
+// isIgnored checks whether a metric is in the ignore list. The result is
+// cached per metric name, as the same names come back on every scrape.
+func (c *Collector) isIgnored(name string) bool {
+	if len(c.ignoredMetrics) == 0 {
+		return false
+	}
+
+	c.ignoreMutex.RLock()
+	ignored, found := c.ignoreCache[name]
+	c.ignoreMutex.RUnlock()
+	if found {
+		return ignored
+	}
+
+	ignored = matchesAny(c.ignoredMetrics, name)
+
+	c.ignoreMutex.Lock()
+	if c.ignoreCache == nil {
+		c.ignoreCache = make(map[string]bool)
+	}
+	c.ignoreCache[name] = ignored
+	c.ignoreMutex.Unlock()
+
+	return ignored
+}
+
 type metricStat struct {
 	name  string
 	desc  string
@@ -499,12 +556,19 @@ func (c *Collector) Collect(ch chan<- prometheus.Metric) {
 	if c == nil {
 		return
 	}
+
+	c.collect(ch, c.isIgnored)
+}
+
+// collect collects the metrics from all EngineSources, except the ones for
+// which skip returns true. Those are dropped before their value is read.
+func (c *Collector) collect(ch chan<- prometheus.Metric, skip func(string) bool) {
 	if ch == nil {
 		c.log.Error("passed a nil channel")
 		return
 	}
 
-	rankMetrics := make(chan *rankMetric)
+	rankMetrics := make(chan *rankMetric, collectChanSize)
 	go func(sources []*EngineSource) {
 		for _, source := range sources {
 			source.Collect(c.log, rankMetrics)
@@ -513,7 +577,7 @@ func (c *Collector) Collect(ch chan<- prometheus.Metric) {
 	}(c.getSources())
 
 	for rm := range rankMetrics {
-		if c.isIgnored(rm.baseName) {
+		if skip(rm.baseName) {
 			continue
 		}
 
@@ -549,3 +613,37 @@ func (c *Collector) Collect(ch chan<- prometheus.Metric) {
 func (c *Collector) Describe(ch chan<- *prometheus.Desc) {
 	c.summary.Describe(ch)
 }
+
+// NewFilteredCollector creates a collector exporting only the metrics of c
+// with a name matching at least one of the regular expressions in matches.
+// It is meant to be registered for a single scrape, so that the value of the
+// other metrics isn't read at all.
+func NewFilteredCollector(c *Collector, matches []string) (prometheus.Collector, error) {
+	if c == nil {
+		return nil, errors.New("nil collector")
+	}
+
+	fc := &filteredCollector{
+		c: c,
+	}
+	for _, pat := range matches {
+		re, err := regexp.Compile(pat)
+		if err != nil {
+			return nil, errors.Wrapf(err, "failed to compile %q", pat)
+		}
+		fc.matches = append(fc.matches, re)
+	}
+
+	return fc, nil
+}
+
+// Collect collects the matching metrics from all EngineSources.
+func (fc *filteredCollector) Collect(ch chan<- prometheus.Metric) {
+	fc.c.collect(ch, func(name string) bool {
+		return fc.c.isIgnored(name) || !matchesAny(fc.matches, name)
+	})
+}
+
+func (fc *filteredCollector) Describe(ch chan<- *prometheus.Desc) {
+	fc.c.Describe(ch)
+}
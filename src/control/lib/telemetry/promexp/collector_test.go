@@ -288,6 +288,7 @@ func TestPromExp_NewCollector(t *testing.T) {
 					// Ignore a few specific fields
 					return (strings.HasSuffix(p.String(), "log") ||
 						strings.HasSuffix(p.String(), "sourceMutex") ||
+						strings.HasSuffix(p.String(), "ignoreMutex") ||
 						strings.HasSuffix(p.String(), "cleanupSource"))
 				}, cmp.Ignore()),
 			}
@@ -510,6 +511,97 @@ func TestPromExp_Collector_Collect(t *testing.T) {
 	}
 }
 
+func TestPromExp_FilteredCollector_Collect(t *testing.T) {
+	log, buf := logging.NewTestLogger(t.Name())
+	defer common.ShowBufferOnFailure(t, buf)
+
+	testIdx := uint32(telemetry.NextTestID(telemetry.PromexpIDBase))
+	testRank := uint32(123)
+	telemetry.InitTestMetricsProducer(t, int(testIdx), 4096)
+	defer telemetry.CleanupTestMetricsProducer(t)
+
+	realMetrics := allTestMetrics(t)
+	telemetry.AddTestMetrics(t, realMetrics)
+
+	engSrc, cleanup, err := NewEngineSource(context.Background(), testIdx, testRank)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer cleanup()
+
+	collector, err := NewCollector(log, &CollectorOpts{
+		Ignores: []string{"engine_simple_gauge1"},
+	}, engSrc)
+	if err != nil {
+		t.Fatalf("failed to create collector: %s", err.Error())
+	}
+
+	for name, tc := range map[string]struct {
+		collector      *Collector
+		matches        []string
+		expErr         error
+		expMetricNames []string
+	}{
+		"nil collector": {
+			expErr: errors.New("nil collector"),
+		},
+		"bad regexp": {
+			collector: collector,
+			matches:   []string{"(two////********["},
+			expErr:    errors.New("failed to compile"),
+		},
+		"no match": {
+			collector: collector,
+			matches:   []string{"engine_nothing"},
+		},
+		"match some metrics": {
+			collector: collector,
+			matches:   []string{"engine_simple_.*", "engine_timer_stamp"},
+			expMetricNames: []string{
+				"engine_simple_counter1",
+				"engine_timer_stamp",
+			},
+		},
+	} {
+		t.Run(name, func(t *testing.T) {
+			fc, err := NewFilteredCollector(tc.collector, tc.matches)
+			common.CmpErr(t, tc.expErr, err)
+			if tc.expErr != nil {
+				return
+			}
+
+			resultChan := make(chan prometheus.Metric)
+			go fc.Collect(resultChan)
+
+			gotMetrics := []prometheus.Metric{}
+			done := false
+			for !done {
+				select {
+				case <-time.After(500 * time.Millisecond):
+					done = true
+				case m := <-resultChan:
+					gotMetrics = append(gotMetrics, m)
+				}
+			}
+
+			common.AssertEqual(t, len(tc.expMetricNames), len(gotMetrics), "wrong number of metrics returned")
+			for _, exp := range tc.expMetricNames {
+				found := false
+				for _, got := range gotMetrics {
+					if strings.Contains(got.Desc().String(), exp) {
+						found = true
+						break
+					}
+				}
+
+				if !found {
+					t.Errorf("expected metric %q not found", exp)
+				}
+			}
+		})
+	}
+}
+
 func TestPromExp_extractLabels(t *testing.T) {
 	for name, tc := range map[string]struct {
 		input     string
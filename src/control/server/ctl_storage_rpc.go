@@ -9,6 +9,7 @@ package server
 import (
 	"fmt"
 	"os/user"
+	"sync"
 
 	"github.com/pkg/errors"
 	"golang.org/x/net/context"
@@ -177,6 +178,28 @@ func (c *ControlService) StorageScan(ctx context.Context, req *ctlpb.StorageScan
 	return resp, nil
 }
 
+type nvmeFormatResult struct {
+	cResults proto.NvmeControllerResults
+	errMsg   string
+}
+
+// formatEngineNVMe formats the NVMe devices of an engine instance and writes
+// the engine NVMe config if format succeeded.
+func formatEngineNVMe(ctx context.Context, ei Engine) (res nvmeFormatResult) {
+	res.cResults = ei.StorageFormatNVMe()
+	if res.cResults.HasErrors() {
+		res.errMsg = res.cResults.Errors()
+		return
+	}
+
+	if err := ei.StorageWriteNvmeConfig(ctx); err != nil {
+		res.errMsg = err.Error()
+		res.cResults = append(res.cResults, ei.newCret("", err))
+	}
+
+	return
+}
+
 // StorageFormat delegates to Storage implementation's Format methods to prepare
 // storage for use by DAOS data plane.
 //
@@ -218,31 +241,34 @@ func (c *ControlService) StorageFormat(ctx context.Context, req *ctlpb.StorageFo
 		}
 	}
 
-	// allow format to complete on one instance even if another fail
-	// TODO: perform bdev format in parallel
-	for _, ei := range instances {
+	// Allow format to complete on one instance even if another fail.
+	// Instances format NVMe concurrently, as each one formats its own
+	// devices through a separate privileged helper process.
+	nvmeResults := make([]nvmeFormatResult, len(instances))
+	var wg sync.WaitGroup
+	for i, ei := range instances {
 		if _, hasError := instanceErrored[ei.Index()]; hasError {
 			// if scm errored, indicate skipping bdev format
 			ret := ei.newCret("", nil)
 			ret.State.Info = fmt.Sprintf(msgNvmeFormatSkip, ei.Index())
-			resp.Crets = append(resp.Crets, ret)
+			nvmeResults[i].cResults = proto.NvmeControllerResults{ret}
 			continue
 		}
 
 		// SCM formatted correctly on this instance, format NVMe
-		cResults := ei.StorageFormatNVMe()
-		if cResults.HasErrors() {
-			instanceErrored[ei.Index()] = cResults.Errors()
-			resp.Crets = append(resp.Crets, cResults...)
-			continue
-		}
+		wg.Add(1)
+		go func(e Engine, res *nvmeFormatResult) {
+			defer wg.Done()
+			*res = formatEngineNVMe(ctx, e)
+		}(ei, &nvmeResults[i])
+	}
+	wg.Wait()
 
-		if err := ei.StorageWriteNvmeConfig(ctx); err != nil {
-			instanceErrored[ei.Index()] = err.Error()
-			cResults = append(cResults, ei.newCret("", err))
+	for i, ei := range instances {
+		if msg := nvmeResults[i].errMsg; msg != "" {
+			instanceErrored[ei.Index()] = msg
 		}
-
-		resp.Crets = append(resp.Crets, cResults...)
+		resp.Crets = append(resp.Crets, nvmeResults[i].cResults...)
 	}
 
 	// Notify storage ready for instances formatted without error.
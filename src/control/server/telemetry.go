@@ -21,10 +21,10 @@ import (
 	"github.com/daos-stack/daos/src/control/system"
 )
 
-func regPromEngineSources(ctx context.Context, log logging.Logger, engines []Engine) error {
+func regPromEngineSources(ctx context.Context, log logging.Logger, engines []Engine) (*promexp.Collector, error) {
 	numEngines := len(engines)
 	if numEngines == 0 {
-		return nil
+		return nil, nil
 	}
 
 	opts := &promexp.CollectorOpts{
@@ -34,7 +34,7 @@ func regPromEngineSources(ctx context.Context, log logging.Logger, engines []Eng
 	}
 	c, err := promexp.NewCollector(log, opts)
 	if err != nil {
-		return err
+		return nil, err
 	}
 	prometheus.MustRegister(c)
 
@@ -61,12 +61,12 @@ func regPromEngineSources(ctx context.Context, log logging.Logger, engines []Eng
 	for i := 0; i < numEngines; i++ {
 		er, err := engines[i].GetRank()
 		if err != nil {
-			return errors.Wrapf(err, "failed to get rank for idx %d", i)
+			return nil, errors.Wrapf(err, "failed to get rank for idx %d", i)
 		}
 
 		addEngineSrc := addFn(uint32(i), er)
 		if err := addEngineSrc(ctx); err != nil {
-			return err
+			return nil, err
 		}
 
 		// Set up engine to add/remove source on exit/restart
@@ -74,20 +74,49 @@ func regPromEngineSources(ctx context.Context, log logging.Logger, engines []Eng
 		engines[i].OnInstanceExit(delFn(uint32(i)))
 	}
 
-	return nil
+	return c, nil
+}
+
+// metricsHandler serves all the metrics, unless the scrape request has
+// "match" parameters. In that case only the engine metrics with a name
+// matching one of the regular expressions given are read and exported,
+// e.g. "/metrics?match=engine_pool_.*&match=engine_io_.*".
+func metricsHandler(log logging.Logger, c *promexp.Collector) http.Handler {
+	defHandler := promhttp.HandlerFor(prometheus.DefaultGatherer, promhttp.HandlerOpts{})
+
+	return http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		matches := r.URL.Query()["match"]
+		if len(matches) == 0 || c == nil {
+			defHandler.ServeHTTP(w, r)
+			return
+		}
+
+		fc, err := promexp.NewFilteredCollector(c, matches)
+		if err != nil {
+			log.Debugf("bad metrics filter: %s", err)
+			http.Error(w, err.Error(), http.StatusBadRequest)
+			return
+		}
+
+		reg := prometheus.NewRegistry()
+		if err := reg.Register(fc); err != nil {
+			http.Error(w, err.Error(), http.StatusInternalServerError)
+			return
+		}
+		promhttp.HandlerFor(reg, promhttp.HandlerOpts{}).ServeHTTP(w, r)
+	})
 }
 
 func startPrometheusExporter(ctx context.Context, log logging.Logger, port int, engines []Engine) (func(), error) {
-	if err := regPromEngineSources(ctx, log, engines); err != nil {
+	c, err := regPromEngineSources(ctx, log, engines)
+	if err != nil {
 		return nil, err
 	}
 
 	listenAddress := fmt.Sprintf("0.0.0.0:%d", port)
 
 	srv := http.Server{Addr: listenAddress}
-	http.Handle("/metrics", promhttp.HandlerFor(
-		prometheus.DefaultGatherer, promhttp.HandlerOpts{},
-	))
+	http.Handle("/metrics", metricsHandler(log, c))
 	http.HandleFunc("/", func(w http.ResponseWriter, r *http.Request) {
 		num, err := w.Write([]byte(`<html>
 				<head><title>DAOS Exporter</title></head>
@@ -23,6 +23,7 @@ uint32_t dtx_agg_thd_cnt_up;
 uint32_t dtx_agg_thd_cnt_lo;
 uint32_t dtx_agg_thd_age_up;
 uint32_t dtx_agg_thd_age_lo;
+uint32_t dtx_cmt_lat_target;
 
 struct dtx_batched_pool_args {
 	/* Link to dss_module_info::dmi_dtx_batched_pool_list. */
@@ -49,6 +50,13 @@ struct dtx_batched_cont_args {
 	struct dtx_batched_pool_args	*dbca_pool;
 	int				 dbca_refs;
 	uint32_t			 dbca_reg_gen;
+	/* Adaptive count threshold for batched commit. */
+	uint32_t			 dbca_cmt_thd;
+	/* Arrival rate (per second) of committable DTXs. */
+	uint32_t			 dbca_cmt_rate;
+	/* Committable DTXs count and time (us) at the last sampling. */
+	uint32_t			 dbca_cmt_cnt;
+	uint64_t			 dbca_cmt_ts;
 	uint32_t			 dbca_deregister:1,
 					 dbca_cleanup_done:1,
 					 dbca_commit_done:1,
@@ -466,10 +474,64 @@ dtx_aggregation_main(void *arg)
 	}
 }
 
+/* The interval (in us) for sampling committable DTXs arrival rate. */
+#define DTX_CMT_SAMPLE_INTV	(100 * 1000)
+
+static void
+dtx_cmt_thd_adjust(struct dtx_batched_cont_args *dbca, uint32_t count)
+{
+	uint64_t	now = daos_getutime();
+	uint64_t	rate;
+	uint64_t	thd;
+
+	if (now < dbca->dbca_cmt_ts + DTX_CMT_SAMPLE_INTV)
+		return;
+
+	if (count > dbca->dbca_cmt_cnt)
+		rate = (uint64_t)(count - dbca->dbca_cmt_cnt) * 1000000 /
+		       (now - dbca->dbca_cmt_ts);
+	else
+		rate = 0;
+
+	dbca->dbca_cmt_rate = (dbca->dbca_cmt_rate * 3 + rate) / 4;
+	dbca->dbca_cmt_cnt = count;
+	dbca->dbca_cmt_ts = now;
+
+	/* Use half of the latency target to accumulate the batch. */
+	thd = (uint64_t)dbca->dbca_cmt_rate * dtx_cmt_lat_target / 2000;
+	if (thd < DTX_CMT_THD_MIN)
+		thd = DTX_CMT_THD_MIN;
+	else if (thd > DTX_THRESHOLD_COUNT)
+		thd = DTX_THRESHOLD_COUNT;
+
+	dbca->dbca_cmt_thd = thd;
+}
+
+static inline uint64_t
+dtx_hlc_age2msec(uint64_t hlc)
+{
+	uint64_t now = crt_hlc_get();
+
+	if (now <= hlc)
+		return 0;
+
+	return crt_hlc2msec(now - hlc);
+}
+
+static inline bool
+dtx_cmt_needed(struct dtx_batched_cont_args *dbca, struct dtx_stat *stat)
+{
+	return stat->dtx_committable_count > dbca->dbca_cmt_thd ||
+	       (stat->dtx_oldest_committable_time != 0 &&
+		dtx_hlc_age2msec(stat->dtx_oldest_committable_time) >=
+		dtx_cmt_lat_target);
+}
+
 static void
 dtx_batched_commit_one(void *arg)
 {
 	struct dss_module_info		*dmi = dss_get_module_info();
+	struct dtx_tls			*tls = dtx_tls_get();
 	struct dtx_batched_cont_args	*dbca = arg;
 	struct ds_cont_child		*cont = dbca->dbca_cont;
 
@@ -504,16 +566,20 @@ dtx_batched_commit_one(void *arg)
 			break;
 		}
 
+		d_tm_set_gauge(tls->dt_cmt_batch, cnt);
+		/* Exclude the committed ones from next arrival sampling. */
+		if (dbca->dbca_cmt_cnt > cnt)
+			dbca->dbca_cmt_cnt -= cnt;
+		else
+			dbca->dbca_cmt_cnt = 0;
+
 		dtx_stat(cont, &stat);
 
 		if (stat.dtx_pool_cmt_count >= dtx_agg_thd_cnt_up &&
 		    !dbca->dbca_pool->dbpa_aggregating)
 			sched_req_wakeup(dmi->dmi_dtx_agg_req);
 
-		if ((stat.dtx_committable_count <= DTX_THRESHOLD_COUNT) &&
-		    (stat.dtx_oldest_committable_time == 0 ||
-		     dtx_hlc_age2sec(stat.dtx_oldest_committable_time) <
-		     DTX_COMMIT_THRESHOLD_AGE))
+		if (!dtx_cmt_needed(dbca, &stat))
 			break;
 	}
 
@@ -527,6 +593,7 @@ void
 dtx_batched_commit(void *arg)
 {
 	struct dss_module_info		*dmi = dss_get_module_info();
+	struct dtx_tls			*tls = dtx_tls_get();
 	struct dtx_batched_cont_args	*dbca;
 	struct dtx_batched_cont_args	*tmp;
 	struct sched_req_attr		 attr;
@@ -571,6 +638,7 @@ dtx_batched_commit(void *arg)
 		d_list_move_tail(&dbca->dbca_sys_link,
 				 &dmi->dmi_dtx_batched_cont_list);
 		dtx_stat(cont, &stat);
+		dtx_cmt_thd_adjust(dbca, stat.dtx_committable_count);
 
 		if (dbca->dbca_commit_req != NULL && dbca->dbca_commit_done) {
 			sched_req_put(dbca->dbca_commit_req);
@@ -580,12 +648,13 @@ dtx_batched_commit(void *arg)
 
 		if (!cont->sc_closing &&
 		    !dbca->dbca_deregister && dbca->dbca_commit_req == NULL &&
-		    ((stat.dtx_committable_count > DTX_THRESHOLD_COUNT) ||
-		     (stat.dtx_oldest_committable_time != 0 &&
-		      dtx_hlc_age2sec(stat.dtx_oldest_committable_time) >=
-		      DTX_COMMIT_THRESHOLD_AGE))) {
+		    dtx_cmt_needed(dbca, &stat)) {
 			D_ASSERT(!dbca->dbca_commit_done);
 			sleep_time = 0;
+			if (stat.dtx_oldest_committable_time != 0)
+				d_tm_set_gauge(tls->dt_cmt_age,
+					       dtx_hlc_age2msec(
+						stat.dtx_oldest_committable_time));
 			dtx_get_dbca(dbca);
 
 			D_ASSERT(dbca->dbca_cont);
@@ -1560,6 +1629,8 @@ add:
 	dbca->dbca_cont = cont;
 	dbca->dbca_pool = dbpa;
 	dbca->dbca_agg_gen = dtx_agg_gen;
+	dbca->dbca_cmt_thd = DTX_THRESHOLD_COUNT;
+	dbca->dbca_cmt_ts = daos_getutime();
 	d_list_add_tail(&dbca->dbca_sys_link, cont_head);
 	d_list_add_tail(&dbca->dbca_pool_link, &dbpa->dbpa_cont_list);
 	if (new_pool)
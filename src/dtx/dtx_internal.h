@@ -22,7 +22,7 @@
  * These are for daos_rpc::dr_opc and DAOS_RPC_OPCODE(opc, ...) rather than
  * crt_req_create(..., opc, ...). See src/include/daos/rpc.h.
  */
-#define DAOS_DTX_VERSION	2
+#define DAOS_DTX_VERSION	3
 
 /* LIST of internal RPCS in form of:
  * OPCODE, flags, FMT, handler, corpc_hdlr,
@@ -31,7 +31,9 @@
 	X(DTX_COMMIT, 0, &CQF_dtx, dtx_handler, NULL, "dtx_commit")	\
 	X(DTX_ABORT, 0, &CQF_dtx, dtx_handler, NULL, "dtx_abort")	\
 	X(DTX_CHECK, 0, &CQF_dtx, dtx_handler, NULL, "dtx_check")	\
-	X(DTX_REFRESH, 0, &CQF_dtx, dtx_handler, NULL, "dtx_refresh")
+	X(DTX_REFRESH, 0, &CQF_dtx, dtx_handler, NULL, "dtx_refresh")	\
+	X(DTX_COMMIT_BATCH, 0, &CQF_dtx_batch, dtx_batch_handler, NULL,	\
+	  "dtx_commit_batch")
 
 #define X(a, b, c, d, e, f) a,
 enum dtx_operation {
@@ -55,6 +57,27 @@ enum dtx_operation {
 
 CRT_RPC_DECLARE(dtx, DAOS_ISEQ_DTX, DAOS_OSEQ_DTX);
 
+/* Container of a DTX_COMMIT_BATCH RPC, owning the next dbc_dtx_nr DTXs */
+struct dtx_batch_cont {
+	uuid_t			dbc_po_uuid;
+	uuid_t			dbc_co_uuid;
+	uint32_t		dbc_dtx_nr;
+	uint32_t		dbc_padding;
+};
+
+/* DTX_COMMIT_BATCH RPC input fields */
+#define DAOS_ISEQ_DTX_BATCH						\
+	((struct dtx_batch_cont)	(dbi_conts)	CRT_RAW_ARRAY)	\
+	((struct dtx_id)		(dbi_dtx_array)	CRT_RAW_ARRAY)
+
+/* DTX_COMMIT_BATCH RPC output fields, one sub result per container */
+#define DAOS_OSEQ_DTX_BATCH						\
+	((int32_t)		(dbo_status)		CRT_VAR)	\
+	((int32_t)		(dbo_pad)		CRT_VAR)	\
+	((int32_t)		(dbo_sub_rets)		CRT_RAW_ARRAY)
+
+CRT_RPC_DECLARE(dtx_batch, DAOS_ISEQ_DTX_BATCH, DAOS_OSEQ_DTX_BATCH);
+
 /* The time threshold for triggerring DTX cleanup of stale entries.
  * If the oldest active DTX exceeds such threshold, it will trigger
  * DTX cleanup locally.
@@ -110,6 +133,35 @@ extern uint32_t dtx_agg_thd_age_up;
  */
 extern uint32_t dtx_agg_thd_age_lo;
 
+/* The latency target (in ms) for batched DTX commit. */
+#define DTX_CMT_LAT_MAX		(DTX_COMMIT_THRESHOLD_AGE * 1000)
+#define DTX_CMT_LAT_MIN		100
+#define DTX_CMT_LAT_DEF		DTX_CMT_LAT_MAX
+
+/* The minimum count threshold for batched DTX commit. */
+#define DTX_CMT_THD_MIN		16
+
+/* If the oldest committable DTX exceeds such age, the batched commit
+ * will be triggered even if there are not enough committable DTXs.
+ * The count threshold for batched commit is adjusted as the committable
+ * DTXs arrival rate multiples half of this target, so the DTXs will be
+ * committed earlier under light load.
+ *
+ * XXX: It is controlled via the environment "DTX_CMT_LAT_TARGET".
+ */
+extern uint32_t dtx_cmt_lat_target;
+
+/* The maximum delay (in ms) for merging DTX commit RPCs. */
+#define DTX_BATCH_DELAY_MAX	100
+
+/* If not zero, the DTX_COMMIT RPCs sent by all the containers of an xstream
+ * to the same target are queued for up to this delay (in ms), then sent as
+ * one DTX_COMMIT_BATCH RPC.
+ *
+ * XXX: It is controlled via the environment "DTX_BATCH_DELAY".
+ */
+extern uint32_t dtx_batch_delay;
+
 struct dtx_pool_metrics {
 	struct d_tm_node_t	*dpm_batched_degree;
 	struct d_tm_node_t	*dpm_batched_total;
@@ -121,6 +173,14 @@ struct dtx_pool_metrics {
  */
 struct dtx_tls {
 	struct d_tm_node_t	*dt_committable;
+	struct d_tm_node_t	*dt_cmt_batch;
+	struct d_tm_node_t	*dt_cmt_age;
+	struct d_tm_node_t	*dt_resync_cont;
+	struct d_tm_node_t	*dt_resync_dtx;
+	struct d_tm_node_t	*dt_cmt_merged;
+	/* DTX_COMMIT requests waiting to be merged, see dtx_batch_delay. */
+	d_list_t		 dt_batch_list;
+	uint32_t		 dt_batch_flushing:1;
 };
 
 extern struct dss_module_key dtx_module_key;
@@ -33,6 +33,9 @@ struct dtx_resync_head {
 	int			drh_count;
 };
 
+/* The max count of concurrent DTX resync ULTs for the containers on a target. */
+#define DTX_RESYNC_ULT_MAX	8
+
 struct dtx_resync_args {
 	struct ds_cont_child	*cont;
 	struct dtx_resync_head	 tables;
@@ -376,6 +379,7 @@ dtx_status_handle(struct dtx_resync_args *dra)
 	struct dtx_resync_entry		*dre;
 	struct dtx_resync_entry		*next;
 	struct ds_pool			*pool = cont->sc_pool->spc_pool;
+	struct dtx_tls			*tls = dtx_tls_get();
 	int				*tgt_array = NULL;
 	int				 tgt_cnt;
 	int				 count = 0;
@@ -417,6 +421,7 @@ dtx_status_handle(struct dtx_resync_args *dra)
 
 		rc = dtx_status_handle_one(cont, &dre->dre_dte, dre->dre_epoch,
 					   tgt_array, &err);
+		d_tm_inc_counter(tls->dt_resync_dtx, 1);
 		switch (rc) {
 		case DSHR_NEED_COMMIT:
 			goto commit;
@@ -636,9 +641,20 @@ out:
 	return rc;
 }
 
+struct dtx_resync_cont {
+	d_list_t		 drc_link;
+	uuid_t			 drc_uuid;
+	daos_handle_t		 drc_po_hdl;
+	struct dtx_scan_args	*drc_arg;
+	ABT_thread		 drc_ult;
+	int			 drc_rc;
+};
+
 struct dtx_container_scan_arg {
 	uuid_t			co_uuid;
 	struct dtx_scan_args	arg;
+	/* The containers to be resynced. */
+	d_list_t		conts;
 };
 
 static int
@@ -647,8 +663,7 @@ container_scan_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 		  void *data, unsigned *acts)
 {
 	struct dtx_container_scan_arg	*scan_arg = data;
-	struct dtx_scan_args		*arg = &scan_arg->arg;
-	int				rc;
+	struct dtx_resync_cont		*drc;
 
 	if (uuid_compare(scan_arg->co_uuid, entry->ie_couuid) == 0) {
 		D_DEBUG(DB_REBUILD, DF_UUID" already scan\n",
@@ -657,14 +672,99 @@ container_scan_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 	}
 
 	uuid_copy(scan_arg->co_uuid, entry->ie_couuid);
-	rc = dtx_resync(iter_param->ip_hdl, arg->pool_uuid, entry->ie_couuid,
-			arg->version, true, false);
-	if (rc)
-		D_ERROR(DF_UUID" dtx resync failed: rc %d\n",
-			DP_UUID(arg->pool_uuid), rc);
 
-	/* Since dtx_resync might yield, let's reprobe anyway */
-	*acts |= VOS_ITER_CB_YIELD;
+	/* Only collect the containers here, they will be resynced in parallel
+	 * after the iteration, so the iteration will not be yield.
+	 */
+	D_ALLOC_PTR(drc);
+	if (drc == NULL)
+		return -DER_NOMEM;
+
+	uuid_copy(drc->drc_uuid, entry->ie_couuid);
+	drc->drc_po_hdl = iter_param->ip_hdl;
+	drc->drc_arg = &scan_arg->arg;
+	drc->drc_ult = ABT_THREAD_NULL;
+	d_list_add_tail(&drc->drc_link, &scan_arg->conts);
+
+	return 0;
+}
+
+static void
+dtx_resync_cont_ult(void *data)
+{
+	struct dtx_resync_cont	*drc = data;
+	struct dtx_scan_args	*arg = drc->drc_arg;
+
+	drc->drc_rc = dtx_resync(drc->drc_po_hdl, arg->pool_uuid, drc->drc_uuid,
+				 arg->version, true, false);
+	if (drc->drc_rc != 0)
+		D_ERROR(DF_UUID"/"DF_UUID" dtx resync failed: rc %d\n",
+			DP_UUID(arg->pool_uuid), DP_UUID(drc->drc_uuid),
+			drc->drc_rc);
+
+	d_tm_dec_gauge(dtx_tls_get()->dt_resync_cont, 1);
+}
+
+/* Wait for the eldest in-flight container resync, return its result. */
+static int
+dtx_resync_cont_wait(d_list_t *inflight, int *count)
+{
+	struct dtx_resync_cont	*drc;
+	int			 rc;
+
+	drc = d_list_pop_entry(inflight, struct dtx_resync_cont, drc_link);
+	D_ASSERT(drc != NULL);
+
+	if (drc->drc_ult != ABT_THREAD_NULL)
+		ABT_thread_free(&drc->drc_ult);
+
+	rc = drc->drc_rc;
+	D_FREE(drc);
+	(*count)--;
+
+	return rc;
+}
+
+/* Resync the collected containers with at most DTX_RESYNC_ULT_MAX ULTs. */
+static int
+dtx_resync_conts(d_list_t *conts)
+{
+	struct dtx_resync_cont	*drc;
+	d_list_t		 inflight;
+	int			 count = 0;
+	int			 rc = 0;
+	int			 rc1;
+
+	D_INIT_LIST_HEAD(&inflight);
+	d_list_for_each_entry(drc, conts, drc_link)
+		d_tm_inc_gauge(dtx_tls_get()->dt_resync_cont, 1);
+
+	while ((drc = d_list_pop_entry(conts, struct dtx_resync_cont,
+				       drc_link)) != NULL) {
+		if (count >= DTX_RESYNC_ULT_MAX) {
+			rc1 = dtx_resync_cont_wait(&inflight, &count);
+			if (rc == 0)
+				rc = rc1;
+		}
+
+		d_list_add_tail(&drc->drc_link, &inflight);
+		count++;
+		rc1 = dss_ult_create(dtx_resync_cont_ult, drc, DSS_XS_SELF, 0,
+				     DSS_DEEP_STACK_SZ, &drc->drc_ult);
+		if (rc1 != 0) {
+			D_WARN("Failed to create DTX resync ULT for "DF_UUID
+			       ", resync it in place: "DF_RC"\n",
+			       DP_UUID(drc->drc_uuid), DP_RC(rc1));
+			drc->drc_ult = ABT_THREAD_NULL;
+			dtx_resync_cont_ult(drc);
+		}
+	}
+
+	while (count > 0) {
+		rc1 = dtx_resync_cont_wait(&inflight, &count);
+		if (rc == 0)
+			rc = rc1;
+	}
 
 	return rc;
 }
@@ -674,20 +774,34 @@ dtx_resync_one(void *data)
 {
 	struct dtx_scan_args		*arg = data;
 	struct ds_pool_child		*child;
+	struct dtx_resync_cont		*drc;
 	vos_iter_param_t		 param = { 0 };
 	struct vos_iter_anchors		 anchor = { 0 };
 	struct dtx_container_scan_arg	 cb_arg = { 0 };
 	int				 rc;
+	int				 rc1;
 
 	child = ds_pool_child_lookup(arg->pool_uuid);
 	if (child == NULL)
 		D_GOTO(out, rc = -DER_NONEXIST);
 
 	cb_arg.arg = *arg;
+	D_INIT_LIST_HEAD(&cb_arg.conts);
 	param.ip_hdl = child->spc_hdl;
 	param.ip_flags = VOS_IT_FOR_MIGRATION;
 	rc = vos_iterate(&param, VOS_ITER_COUUID, false, &anchor,
 			 container_scan_cb, NULL, &cb_arg, NULL);
+	if (rc != 0) {
+		while ((drc = d_list_pop_entry(&cb_arg.conts,
+					       struct dtx_resync_cont,
+					       drc_link)) != NULL)
+			D_FREE(drc);
+	} else {
+		/* Resync the containers even if some of them failed. */
+		rc1 = dtx_resync_conts(&cb_arg.conts);
+		if (rc == 0)
+			rc = rc1;
+	}
 
 	ds_pool_child_put(child);
 out:
@@ -20,6 +20,9 @@
 #include "dtx_internal.h"
 
 CRT_RPC_DEFINE(dtx, DAOS_ISEQ_DTX, DAOS_OSEQ_DTX);
+CRT_RPC_DEFINE(dtx_batch, DAOS_ISEQ_DTX_BATCH, DAOS_OSEQ_DTX_BATCH);
+
+uint32_t dtx_batch_delay;
 
 #define X(a, b, c, d, e, f)	\
 {				\
@@ -80,6 +83,8 @@ struct dtx_req_rec {
 	int				 drr_count; /* DTX count */
 	int				 drr_result; /* The RPC result */
 	uint32_t			 drr_comp:1;
+	/* Link into dtx_tls::dt_batch_list or a DTX_COMMIT_BATCH RPC. */
+	d_list_t			 drr_batch_link;
 	struct dtx_id			*drr_dti; /* The DTX array */
 	struct dtx_share_peer		**drr_cb_args; /* Used by dtx_req_cb. */
 };
@@ -224,7 +229,7 @@ out:
 }
 
 static int
-dtx_req_send(struct dtx_req_rec *drr, daos_epoch_t epoch)
+dtx_req_send_one(struct dtx_req_rec *drr, daos_epoch_t epoch)
 {
 	struct dtx_req_args	*dra = drr->drr_parent;
 	crt_rpc_t		*req;
@@ -264,6 +269,206 @@ dtx_req_send(struct dtx_req_rec *drr, daos_epoch_t epoch)
 	return rc;
 }
 
+/* The DTX_COMMIT requests merged into one DTX_COMMIT_BATCH RPC. */
+struct dtx_batch_req {
+	d_list_t		 dbr_reqs;
+	struct dtx_batch_cont	*dbr_conts;
+	struct dtx_id		*dbr_dtis;
+};
+
+static void
+dtx_batch_req_done(struct dtx_req_rec *drr, int rc)
+{
+	struct dtx_req_args	*dra = drr->drr_parent;
+
+	d_list_del_init(&drr->drr_batch_link);
+	drr->drr_comp = 1;
+	drr->drr_result = rc;
+	rc = ABT_future_set(dra->dra_future, drr);
+	D_ASSERTF(rc == ABT_SUCCESS,
+		  "ABT_future_set failed for DTX batch to %d/%d: rc = %d.\n",
+		  drr->drr_rank, drr->drr_tag, rc);
+}
+
+static void
+dtx_batch_req_cb(const struct crt_cb_info *cb_info)
+{
+	struct dtx_batch_req	*dbr = cb_info->cci_arg;
+	struct dtx_batch_in	*dbi = crt_req_get(cb_info->cci_rpc);
+	struct dtx_batch_out	*dbo;
+	struct dtx_req_rec	*drr;
+	int32_t			*rets = NULL;
+	int			 rc = cb_info->cci_rc;
+	int			 i = 0;
+
+	if (rc == 0) {
+		dbo = crt_reply_get(cb_info->cci_rpc);
+		rc = dbo->dbo_status;
+		if (rc == 0 && dbo->dbo_sub_rets.ca_count != dbi->dbi_conts.ca_count)
+			rc = -DER_PROTO;
+		if (rc == 0)
+			rets = dbo->dbo_sub_rets.ca_arrays;
+	}
+
+	D_DEBUG(DB_TRACE, "DTX batch req for %d containers got reply: rc %d.\n",
+		(int)dbi->dbi_conts.ca_count, rc);
+
+	while ((drr = d_list_pop_entry(&dbr->dbr_reqs, struct dtx_req_rec,
+				       drr_batch_link)) != NULL)
+		dtx_batch_req_done(drr, rets != NULL ? rets[i++] : rc);
+
+	D_FREE(dbr->dbr_conts);
+	D_FREE(dbr->dbr_dtis);
+	D_FREE(dbr);
+}
+
+/* Send the DTX_COMMIT requests of @head, all for the same target, in one RPC. */
+static void
+dtx_batch_send(d_list_t *head, int nr, int dtx_nr)
+{
+	struct dtx_tls		*tls = dtx_tls_get();
+	struct dtx_batch_req	*dbr = NULL;
+	struct dtx_batch_in	*dbi;
+	struct dtx_req_rec	*drr;
+	crt_endpoint_t		 tgt_ep;
+	crt_opcode_t		 opc;
+	crt_rpc_t		*req;
+	int			 i = 0;
+	int			 rc;
+
+	drr = d_list_entry(head->next, struct dtx_req_rec, drr_batch_link);
+	if (nr == 1) {
+		d_list_del_init(&drr->drr_batch_link);
+		dtx_req_send_one(drr, 0);
+		return;
+	}
+
+	D_ALLOC_PTR(dbr);
+	if (dbr == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	D_INIT_LIST_HEAD(&dbr->dbr_reqs);
+	D_ALLOC_ARRAY(dbr->dbr_conts, nr);
+	D_ALLOC_ARRAY(dbr->dbr_dtis, dtx_nr);
+	if (dbr->dbr_conts == NULL || dbr->dbr_dtis == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	tgt_ep.ep_grp = NULL;
+	tgt_ep.ep_rank = drr->drr_rank;
+	tgt_ep.ep_tag = daos_rpc_tag(DAOS_REQ_TGT, drr->drr_tag);
+	opc = DAOS_RPC_OPCODE(DTX_COMMIT_BATCH, DAOS_DTX_MODULE, DAOS_DTX_VERSION);
+
+	rc = crt_req_create(dss_get_module_info()->dmi_ctx, &tgt_ep, opc, &req);
+	if (rc != 0)
+		goto out;
+
+	dtx_nr = 0;
+	d_list_for_each_entry(drr, head, drr_batch_link) {
+		struct dtx_batch_cont	*dbc = &dbr->dbr_conts[i++];
+
+		uuid_copy(dbc->dbc_po_uuid, drr->drr_parent->dra_po_uuid);
+		uuid_copy(dbc->dbc_co_uuid, drr->drr_parent->dra_co_uuid);
+		dbc->dbc_dtx_nr = drr->drr_count;
+		memcpy(&dbr->dbr_dtis[dtx_nr], drr->drr_dti,
+		       sizeof(*drr->drr_dti) * drr->drr_count);
+		dtx_nr += drr->drr_count;
+	}
+	d_list_splice_init(head, &dbr->dbr_reqs);
+
+	dbi = crt_req_get(req);
+	dbi->dbi_conts.ca_count = nr;
+	dbi->dbi_conts.ca_arrays = dbr->dbr_conts;
+	dbi->dbi_dtx_array.ca_count = dtx_nr;
+	dbi->dbi_dtx_array.ca_arrays = dbr->dbr_dtis;
+
+	D_DEBUG(DB_TRACE, "DTX batch req for %d containers, count %d to %d/%d.\n",
+		nr, dtx_nr, tgt_ep.ep_rank, tgt_ep.ep_tag);
+
+	/* Send failure is reported via dtx_batch_req_cb that completes the requests. */
+	crt_req_send(req, dtx_batch_req_cb, dbr);
+	d_tm_inc_counter(tls->dt_cmt_merged, nr);
+	return;
+
+out:
+	D_ERROR("Failed to merge %d DTX commit requests: "DF_RC"\n", nr, DP_RC(rc));
+	if (dbr != NULL) {
+		D_FREE(dbr->dbr_conts);
+		D_FREE(dbr->dbr_dtis);
+		D_FREE(dbr);
+	}
+
+	/* Send them one by one instead. */
+	while ((drr = d_list_pop_entry(head, struct dtx_req_rec, drr_batch_link)) != NULL)
+		dtx_req_send_one(drr, 0);
+}
+
+/* Send the queued DTX_COMMIT requests, merged per target. */
+static void
+dtx_batch_flush(void)
+{
+	struct dtx_tls		*tls = dtx_tls_get();
+	struct dtx_req_rec	*first;
+	struct dtx_req_rec	*drr;
+	struct dtx_req_rec	*tmp;
+	d_list_t		 queue;
+	d_list_t		 batch;
+	int			 nr;
+	int			 dtx_nr;
+
+	D_INIT_LIST_HEAD(&queue);
+	d_list_splice_init(&tls->dt_batch_list, &queue);
+	tls->dt_batch_flushing = 0;
+
+	while (!d_list_empty(&queue)) {
+		first = d_list_entry(queue.next, struct dtx_req_rec, drr_batch_link);
+		D_INIT_LIST_HEAD(&batch);
+		nr = 0;
+		dtx_nr = 0;
+		d_list_for_each_entry_safe(drr, tmp, &queue, drr_batch_link) {
+			if (drr->drr_rank != first->drr_rank || drr->drr_tag != first->drr_tag)
+				continue;
+
+			d_list_move_tail(&drr->drr_batch_link, &batch);
+			nr++;
+			dtx_nr += drr->drr_count;
+		}
+
+		dtx_batch_send(&batch, nr, dtx_nr);
+	}
+}
+
+/* Wait for more DTX_COMMIT requests from other containers, then flush. */
+static void
+dtx_batch_flush_ult(void *arg)
+{
+	dss_sleep(dtx_batch_delay);
+	dtx_batch_flush();
+}
+
+static int
+dtx_req_send(struct dtx_req_rec *drr, daos_epoch_t epoch)
+{
+	struct dtx_tls	*tls;
+	int		 rc;
+
+	if (dtx_batch_delay == 0 || drr->drr_parent->dra_opc != DTX_COMMIT)
+		return dtx_req_send_one(drr, epoch);
+
+	tls = dtx_tls_get();
+	d_list_add_tail(&drr->drr_batch_link, &tls->dt_batch_list);
+	if (tls->dt_batch_flushing)
+		return 0;
+
+	tls->dt_batch_flushing = 1;
+	rc = dss_ult_create(dtx_batch_flush_ult, NULL, DSS_XS_SELF, 0, 0, NULL);
+	if (rc != 0) {
+		D_WARN("Failed to create DTX batch ULT, send directly: "DF_RC"\n", DP_RC(rc));
+		dtx_batch_flush();
+	}
+
+	return 0;
+}
+
 static void
 dtx_req_list_cb(void **args)
 {
@@ -1136,3 +1341,46 @@ dtx_refresh(struct dtx_handle *dth, struct ds_cont_child *cont)
 
 	return rc;
 }
+
+/*
+ * A DTX that is still prepared on its leader usually becomes committable once
+ * its other sub-operations complete, well within a millisecond or two. Instead
+ * of bouncing -DER_INPROGRESS to the client, which retries after a round trip,
+ * wait for it on the engine a bounded number of times. What was learnt about
+ * the active DTXs is dropped, so that the next local attempt checks them with
+ * their leader again.
+ *
+ * Returns -DER_AGAIN if the caller should retry the operation locally,
+ * -DER_INPROGRESS once \a waits reaches DTX_INPROGRESS_WAIT_MAX, or the
+ * error of re-initializing \a dth for the retry.
+ */
+int
+dtx_inprogress_wait(struct dtx_handle *dth, int *waits)
+{
+	struct dtx_share_peer	*dsp;
+	int			 rc;
+
+	if (*waits >= DTX_INPROGRESS_WAIT_MAX || DAOS_FAIL_CHECK(DAOS_DTX_NO_RETRY))
+		return -DER_INPROGRESS;
+
+	while ((dsp = d_list_pop_entry(&dth->dth_share_act_list,
+				       struct dtx_share_peer, dsp_link)) != NULL)
+		D_FREE(dsp);
+	while ((dsp = d_list_pop_entry(&dth->dth_share_tbd_list,
+				       struct dtx_share_peer, dsp_link)) != NULL)
+		D_FREE(dsp);
+	dth->dth_share_tbd_count = 0;
+
+	vos_dtx_cleanup(dth);
+	rc = dtx_handle_reinit(dth);
+	if (rc != 0) {
+		D_ERROR("Failed to reinit DTX "DF_DTI" for retry: "DF_RC"\n",
+			DP_DTI(&dth->dth_xid), DP_RC(rc));
+		return rc;
+	}
+
+	(*waits)++;
+	dss_sleep(DTX_INPROGRESS_WAIT_MS);
+
+	return -DER_AGAIN;
+}
@@ -29,6 +29,8 @@ dtx_tls_init(int xs_id, int tgt_id)
 	if (tls == NULL)
 		return NULL;
 
+	D_INIT_LIST_HEAD(&tls->dt_batch_list);
+
 	/** Skip sensor setup on system xstreams */
 	if (tgt_id < 0)
 		return tls;
@@ -40,6 +42,42 @@ dtx_tls_init(int xs_id, int tgt_id)
 		D_WARN("Failed to create DTX committable metric: " DF_RC"\n",
 		       DP_RC(rc));
 
+	rc = d_tm_add_metric(&tls->dt_cmt_batch, D_TM_STATS_GAUGE,
+			     "number of DTX entries per batched commit",
+			     "entries", "io/dtx/cmt_batch/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit batch metric: " DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->dt_cmt_age, D_TM_STATS_GAUGE,
+			     "age of the oldest committable DTX entry when "
+			     "trigger batched commit", "ms",
+			     "io/dtx/cmt_age/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit age metric: " DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->dt_resync_cont, D_TM_GAUGE,
+			     "number of containers waiting for DTX resync",
+			     "containers", "io/dtx/resync/cont/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX resync cont metric: " DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->dt_resync_dtx, D_TM_COUNTER,
+			     "total DTX entries checked by DTX resync",
+			     "entries", "io/dtx/resync/dtx/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX resync entry metric: " DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->dt_cmt_merged, D_TM_COUNTER,
+			     "total DTX commit requests merged into batch RPCs",
+			     "requests", "io/dtx/cmt_merged/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit merged metric: " DF_RC"\n",
+		       DP_RC(rc));
+
 	return tls;
 }
 
@@ -348,6 +386,77 @@ out:
 		ds_cont_child_put(cont);
 }
 
+static void
+dtx_batch_handler(crt_rpc_t *rpc)
+{
+	struct dtx_batch_in	*dbi = crt_req_get(rpc);
+	struct dtx_batch_out	*dbo = crt_reply_get(rpc);
+	struct dtx_batch_cont	*dbcs = dbi->dbi_conts.ca_arrays;
+	struct dtx_id		*dtis = dbi->dbi_dtx_array.ca_arrays;
+	struct dtx_pool_metrics	*dpm;
+	struct ds_cont_child	*cont;
+	int32_t			*rets = NULL;
+	uint64_t		 dtx_nr = 0;
+	int			 count;
+	int			 i;
+	int			 j;
+	int			 rc = 0;
+	int			 rc1;
+
+	for (i = 0; i < dbi->dbi_conts.ca_count; i++)
+		dtx_nr += dbcs[i].dbc_dtx_nr;
+
+	if (dtx_nr != dbi->dbi_dtx_array.ca_count)
+		D_GOTO(out, rc = -DER_PROTO);
+
+	D_ALLOC_ARRAY(rets, dbi->dbi_conts.ca_count);
+	if (rets == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (i = 0; i < dbi->dbi_conts.ca_count; dtis += dbcs[i].dbc_dtx_nr, i++) {
+		rets[i] = ds_cont_child_lookup(dbcs[i].dbc_po_uuid, dbcs[i].dbc_co_uuid, &cont);
+		if (rets[i] != 0) {
+			D_ERROR("Failed to locate pool="DF_UUID" cont="DF_UUID
+				" for DTX batch rpc: rc = "DF_RC"\n",
+				DP_UUID(dbcs[i].dbc_po_uuid), DP_UUID(dbcs[i].dbc_co_uuid),
+				DP_RC(rets[i]));
+			continue;
+		}
+
+		if (DAOS_FAIL_CHECK(DAOS_DTX_MISS_COMMIT))
+			goto put;
+
+		for (j = 0; j < dbcs[i].dbc_dtx_nr; j += count) {
+			count = min(DTX_YIELD_CYCLE, (int)dbcs[i].dbc_dtx_nr - j);
+			rc1 = vos_dtx_commit(cont->sc_hdl, dtis + j, count, NULL);
+			if (rets[i] == 0 && rc1 < 0)
+				rets[i] = rc1;
+		}
+
+		dpm = cont->sc_pool->spc_metrics[DAOS_DTX_MODULE];
+		d_tm_inc_counter(dpm->dpm_batched_total, dbcs[i].dbc_dtx_nr);
+		d_tm_inc_counter(dpm->dpm_total[DTX_COMMIT_BATCH], 1);
+put:
+		ds_cont_child_put(cont);
+	}
+
+	dbo->dbo_sub_rets.ca_arrays = rets;
+	dbo->dbo_sub_rets.ca_count = dbi->dbi_conts.ca_count;
+
+out:
+	D_DEBUG(DB_TRACE, "Handle DTX batch rpc, containers %d, count %d: rc = "DF_RC"\n",
+		(int)dbi->dbi_conts.ca_count, (int)dbi->dbi_dtx_array.ca_count, DP_RC(rc));
+
+	dbo->dbo_status = rc;
+	rc = crt_reply_send(rpc);
+	if (rc != 0)
+		D_ERROR("send reply failed for DTX batch rpc: rc = "DF_RC"\n", DP_RC(rc));
+
+	D_FREE(rets);
+	dbo->dbo_sub_rets.ca_arrays = NULL;
+	dbo->dbo_sub_rets.ca_count = 0;
+}
+
 static int
 dtx_init(void)
 {
@@ -396,6 +505,38 @@ dtx_init(void)
 	D_INFO("Set DTX aggregation time threshold as %d (seconds)\n",
 	       dtx_agg_thd_age_up);
 
+	str = getenv("DTX_CMT_LAT_TARGET");
+	if (str != NULL) {
+		dtx_cmt_lat_target = atoi(str);
+		if (dtx_cmt_lat_target < DTX_CMT_LAT_MIN ||
+		    dtx_cmt_lat_target > DTX_CMT_LAT_MAX) {
+			D_WARN("Invalid DTX commit latency target %d, "
+			       "the valid range is [%d, %d], use the "
+			       "default value %d\n",
+			       dtx_cmt_lat_target, DTX_CMT_LAT_MIN,
+			       DTX_CMT_LAT_MAX, DTX_CMT_LAT_DEF);
+			dtx_cmt_lat_target = DTX_CMT_LAT_DEF;
+		}
+	} else {
+		dtx_cmt_lat_target = DTX_CMT_LAT_DEF;
+	}
+
+	D_INFO("Set DTX commit latency target as %d (ms)\n",
+	       dtx_cmt_lat_target);
+
+	str = getenv("DTX_BATCH_DELAY");
+	if (str != NULL) {
+		dtx_batch_delay = atoi(str);
+		if (dtx_batch_delay > DTX_BATCH_DELAY_MAX) {
+			D_WARN("Invalid DTX batch delay %d, the valid range is "
+			       "[0, %d], disable it\n", dtx_batch_delay,
+			       DTX_BATCH_DELAY_MAX);
+			dtx_batch_delay = 0;
+		}
+	}
+
+	D_INFO("Set DTX commit batch delay as %d (ms)\n", dtx_batch_delay);
+
 	rc = dbtree_class_register(DBTREE_CLASS_DTX_CF,
 				   BTR_FEAT_UINT_KEY | BTR_FEAT_DYNAMIC_ROOT,
 				   &dbtree_dtx_cf_ops);
@@ -10,6 +10,7 @@
 
 #define D_LOGFAC DD_FAC(server)
 
+#include <poll.h>
 #include <daos_srv/daos_engine.h>
 
 #include <daos_types.h>
@@ -22,6 +23,230 @@
 /** dRPC UNIX-domain socket path (full, not directory-only) */
 static char *dss_drpc_path;
 
+/** Max number of idle sessions kept open to daos_server */
+#define DSS_DRPC_IDLE_MAX	8
+/** Max number of queued dRPCs not waiting for a response */
+#define DSS_DRPC_ASYNC_MAX	1024
+
+/**
+ * Sessions to daos_server are kept open and reused by the synchronous
+ * dRPCs, one dRPC at a time per session. dRPCs not waiting for a response
+ * are queued and sent back to back by a dedicated thread over its own
+ * session, so that a burst of RAS events does not open a session per event
+ * and does not block the calling xstreams.
+ */
+static struct dss_drpc_sessions {
+	pthread_mutex_t	 ds_lock;
+	pthread_cond_t	 ds_cond;
+	struct drpc	*ds_idle[DSS_DRPC_IDLE_MAX];
+	int		 ds_idle_nr;
+	/** queue of struct dss_drpc_async */
+	d_list_t	 ds_async_list;
+	int		 ds_async_nr;
+	pthread_t	 ds_async_thread;
+	bool		 ds_async_running;
+	bool		 ds_async_stop;
+} dss_drpc_sessions = {
+	.ds_lock	= PTHREAD_MUTEX_INITIALIZER,
+	.ds_cond	= PTHREAD_COND_INITIALIZER,
+};
+
+struct dss_drpc_async {
+	d_list_t	da_link;
+	int32_t		da_module;
+	int32_t		da_method;
+	size_t		da_req_size;
+	uint8_t		da_req[0];
+};
+
+/*
+ * An idle session should have nothing to read. If it does, daos_server has
+ * closed it or it is out of sync, so it can't be reused.
+ */
+static bool
+dss_drpc_session_stale(struct drpc *ctx)
+{
+	struct pollfd	pfd = { .fd = ctx->comm->fd, .events = POLLIN };
+	int		rc;
+
+	rc = poll(&pfd, 1, 0 /* timeout */);
+	if (rc == 0)
+		return false;
+
+	return rc < 0 || pfd.revents != 0;
+}
+
+/* Get an idle session to daos_server, or open a new one. */
+static int
+dss_drpc_session_get(struct drpc **ctxp)
+{
+	struct dss_drpc_sessions	*ds = &dss_drpc_sessions;
+	struct drpc			*ctx;
+	int				 rc;
+
+	D_MUTEX_LOCK(&ds->ds_lock);
+	while (ds->ds_idle_nr > 0) {
+		ctx = ds->ds_idle[--ds->ds_idle_nr];
+		D_MUTEX_UNLOCK(&ds->ds_lock);
+
+		if (!dss_drpc_session_stale(ctx)) {
+			*ctxp = ctx;
+			return 0;
+		}
+		D_DEBUG(DB_MGMT, "closing stale dRPC session\n");
+		drpc_close(ctx);
+
+		D_MUTEX_LOCK(&ds->ds_lock);
+	}
+	D_MUTEX_UNLOCK(&ds->ds_lock);
+
+	rc = drpc_connect(dss_drpc_path, ctxp);
+	if (rc != 0)
+		D_ERROR("failed to connect to dRPC server at %s: "DF_RC"\n",
+			dss_drpc_path, DP_RC(rc));
+	return rc;
+}
+
+/*
+ * Return a session after a dRPC. A session is only reused if the dRPC
+ * succeeded, since a failure may leave the session out of sync.
+ */
+static void
+dss_drpc_session_put(struct drpc *ctx, bool reuse)
+{
+	struct dss_drpc_sessions *ds = &dss_drpc_sessions;
+
+	if (reuse) {
+		D_MUTEX_LOCK(&ds->ds_lock);
+		if (ds->ds_idle_nr < DSS_DRPC_IDLE_MAX) {
+			ds->ds_idle[ds->ds_idle_nr++] = ctx;
+			ctx = NULL;
+		}
+		D_MUTEX_UNLOCK(&ds->ds_lock);
+	}
+
+	if (ctx != NULL)
+		drpc_close(ctx);
+}
+
+/* Send a dRPC and wait for its response on a session to daos_server. */
+static int
+dss_drpc_session_call(struct drpc *ctx, int32_t module, int32_t method,
+		      void *req, size_t req_size, Drpc__Response **resp)
+{
+	Drpc__Call	*call;
+	int		 rc;
+
+	rc = drpc_call_create(ctx, module, method, &call);
+	if (rc != 0) {
+		D_ERROR("failed to create dRPC %d/%d: "DF_RC"\n",
+			module, method, DP_RC(rc));
+		return rc;
+	}
+	call->body.data = req;
+	call->body.len = req_size;
+
+	rc = drpc_call(ctx, R_SYNC, call, resp);
+	if (rc != 0)
+		D_ERROR("failed to invoke dRPC %d/%d: "DF_RC"\n",
+			module, method, DP_RC(rc));
+
+	/* Let the caller free its own buffer. */
+	call->body.data = NULL;
+	call->body.len = 0;
+	drpc_call_free(call);
+	return rc;
+}
+
+/* Send the queued dRPCs which don't wait for a response. */
+static void *
+dss_drpc_async_thread(void *varg)
+{
+	struct dss_drpc_sessions	*ds = &dss_drpc_sessions;
+	struct dss_drpc_async		*da;
+	struct drpc			*ctx = NULL;
+	Drpc__Response			*resp;
+	d_list_t			 batch;
+	int				 rc;
+
+	D_INIT_LIST_HEAD(&batch);
+	D_MUTEX_LOCK(&ds->ds_lock);
+	for (;;) {
+		while (d_list_empty(&ds->ds_async_list) && !ds->ds_async_stop)
+			pthread_cond_wait(&ds->ds_cond, &ds->ds_lock);
+		if (d_list_empty(&ds->ds_async_list))
+			break;
+
+		d_list_splice_init(&ds->ds_async_list, &batch);
+		ds->ds_async_nr = 0;
+		D_MUTEX_UNLOCK(&ds->ds_lock);
+
+		while ((da = d_list_pop_entry(&batch, struct dss_drpc_async,
+					      da_link)) != NULL) {
+			rc = 0;
+			if (ctx == NULL)
+				rc = dss_drpc_session_get(&ctx);
+			if (rc == 0)
+				rc = dss_drpc_session_call(ctx, da->da_module,
+							   da->da_method,
+							   da->da_req,
+							   da->da_req_size,
+							   &resp);
+			if (rc == 0) {
+				drpc_response_free(resp);
+			} else if (ctx != NULL) {
+				drpc_close(ctx);
+				ctx = NULL;
+			}
+			D_FREE(da);
+		}
+
+		D_MUTEX_LOCK(&ds->ds_lock);
+	}
+	D_MUTEX_UNLOCK(&ds->ds_lock);
+
+	if (ctx != NULL)
+		drpc_close(ctx);
+	return NULL;
+}
+
+/*
+ * Queue a dRPC not waiting for a response. Returns -DER_AGAIN if it can't be
+ * queued, in which case the caller should send it by itself.
+ */
+static int
+dss_drpc_async_submit(int32_t module, int32_t method, void *req,
+		      size_t req_size)
+{
+	struct dss_drpc_sessions	*ds = &dss_drpc_sessions;
+	struct dss_drpc_async		*da;
+	int				 rc = 0;
+
+	D_ALLOC(da, sizeof(*da) + req_size);
+	if (da == NULL)
+		return -DER_AGAIN;
+	da->da_module = module;
+	da->da_method = method;
+	da->da_req_size = req_size;
+	if (req_size > 0)
+		memcpy(da->da_req, req, req_size);
+
+	D_MUTEX_LOCK(&ds->ds_lock);
+	if (ds->ds_async_running && !ds->ds_async_stop &&
+	    ds->ds_async_nr < DSS_DRPC_ASYNC_MAX) {
+		d_list_add_tail(&da->da_link, &ds->ds_async_list);
+		ds->ds_async_nr++;
+		pthread_cond_signal(&ds->ds_cond);
+		da = NULL;
+	} else {
+		rc = -DER_AGAIN;
+	}
+	D_MUTEX_UNLOCK(&ds->ds_lock);
+
+	D_FREE(da);
+	return rc;
+}
+
 struct dss_drpc_thread_arg {
 	int32_t		  cta_module;
 	int32_t		  cta_method;
@@ -38,10 +263,26 @@ dss_drpc_thread(void *varg)
 	struct drpc			*ctx;
 	Drpc__Call			*call;
 	Drpc__Response			*resp;
-	int				 flags = R_SYNC;
 	int				 rc;
 
-	/* Establish a private connection to avoid dRPC concurrency problems. */
+	if (!(arg->cta_flags & DSS_DRPC_NO_RESP)) {
+		rc = dss_drpc_session_get(&ctx);
+		if (rc != 0)
+			goto out;
+
+		rc = dss_drpc_session_call(ctx, arg->cta_module,
+					   arg->cta_method, arg->cta_req,
+					   arg->cta_req_size, &resp);
+		dss_drpc_session_put(ctx, rc == 0 /* reuse */);
+		if (rc == 0)
+			*arg->cta_resp = resp;
+		goto out;
+	}
+
+	/*
+	 * The dRPC couldn't be queued, use a private connection and close it
+	 * without waiting for the response.
+	 */
 	rc = drpc_connect(dss_drpc_path, &ctx);
 	if (rc != 0) {
 		D_ERROR("failed to connect to dRPC server at %s: "DF_RC"\n",
@@ -58,20 +299,13 @@ dss_drpc_thread(void *varg)
 	call->body.data = arg->cta_req;
 	call->body.len = arg->cta_req_size;
 
-	if (arg->cta_flags & DSS_DRPC_NO_RESP)
-		flags &= ~R_SYNC;
-
-	rc = drpc_call(ctx, flags, call, &resp);
+	rc = drpc_call(ctx, 0 /* flags */, call, &resp);
 	if (rc != 0) {
 		D_ERROR("failed to invoke dRPC %d/%d: "DF_RC"\n",
 			arg->cta_module, arg->cta_method, DP_RC(rc));
 		goto out_call;
 	}
-
-	if (arg->cta_flags & DSS_DRPC_NO_RESP)
-		drpc_response_free(resp);
-	else
-		*arg->cta_resp = resp;
+	drpc_response_free(resp);
 out_call:
 	/* Let the caller free its own buffer. */
 	call->body.data = NULL;
@@ -109,6 +343,10 @@ dss_drpc_call(int32_t module, int32_t method, void *req, size_t req_size,
 	arg.cta_req_size = req_size;
 	arg.cta_resp = resp;
 
+	if ((flags & DSS_DRPC_NO_RESP) &&
+	    dss_drpc_async_submit(module, method, req, req_size) == 0)
+		return 0;
+
 	if (flags & (DSS_DRPC_NO_RESP | DSS_DRPC_NO_SCHED))
 		return (int)(intptr_t)dss_drpc_thread(&arg);
 
@@ -417,16 +655,51 @@ out:
 int
 drpc_init(void)
 {
+	struct dss_drpc_sessions	*ds = &dss_drpc_sessions;
+	int				 rc;
+
 	D_ASSERT(dss_drpc_path == NULL);
 	D_ASPRINTF(dss_drpc_path, "%s/%s", dss_socket_dir, "daos_server.sock");
 	if (dss_drpc_path == NULL)
 		return -DER_NOMEM;
+
+	D_INIT_LIST_HEAD(&ds->ds_async_list);
+	ds->ds_async_nr = 0;
+	ds->ds_async_stop = false;
+	rc = pthread_create(&ds->ds_async_thread, NULL /* attr */,
+			    dss_drpc_async_thread, NULL /* arg */);
+	if (rc != 0) {
+		/* dRPCs not waiting for a response are sent by the caller */
+		D_WARN("failed to create dRPC async thread: %d\n", rc);
+		return 0;
+	}
+	ds->ds_async_running = true;
 	return 0;
 }
 
 void
 drpc_fini(void)
 {
+	struct dss_drpc_sessions	*ds = &dss_drpc_sessions;
+	int				 rc;
+
 	D_ASSERT(dss_drpc_path != NULL);
+
+	/* Send the queued dRPCs before stopping */
+	if (ds->ds_async_running) {
+		D_MUTEX_LOCK(&ds->ds_lock);
+		ds->ds_async_stop = true;
+		pthread_cond_signal(&ds->ds_cond);
+		D_MUTEX_UNLOCK(&ds->ds_lock);
+
+		rc = pthread_join(ds->ds_async_thread, NULL);
+		D_ASSERTF(rc == 0, "failed to join dRPC async thread: %d\n",
+			  rc);
+		ds->ds_async_running = false;
+	}
+
+	while (ds->ds_idle_nr > 0)
+		drpc_close(ds->ds_idle[--ds->ds_idle_nr]);
+
 	D_FREE(dss_drpc_path);
 }
@@ -576,7 +576,7 @@ server_id_cb(uint32_t *tid, uint64_t *uid)
 static int
 server_init(int argc, char *argv[])
 {
-	uint64_t		bound;
+	uint64_t		bound, start;
 	unsigned int		ctx_nr;
 	int			rc;
 	struct engine_metrics	*metrics;
@@ -695,6 +695,7 @@ server_init(int argc, char *argv[])
 	D_INFO("Module %s successfully initialized\n", modules);
 
 	/* initialize service */
+	start = daos_getmtime_coarse();
 	rc = dss_srv_init();
 	if (rc) {
 		D_ERROR("DAOS cannot be initialized using the configured "
@@ -703,6 +704,7 @@ server_init(int argc, char *argv[])
 			dss_storage_path);
 		D_GOTO(exit_mod_loaded, rc);
 	}
+	d_tm_set_gauge(metrics->srv_init_dur, daos_getmtime_coarse() - start);
 	D_INFO("Service initialized\n");
 
 	rc = server_init_state_init();
@@ -720,9 +722,11 @@ server_init(int argc, char *argv[])
 
 	server_init_state_wait(DSS_INIT_STATE_SET_UP);
 
+	start = daos_getmtime_coarse();
 	rc = dss_module_setup_all();
 	if (rc != 0)
 		goto exit_init_state;
+	d_tm_set_gauge(metrics->setup_dur, daos_getmtime_coarse() - start);
 	D_INFO("Modules successfully set up\n");
 
 	rc = crt_register_event_cb(dss_crt_event_cb, NULL);
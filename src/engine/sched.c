@@ -11,6 +11,7 @@
 #include <daos/common.h>
 #include <daos_errno.h>
 #include <daos_srv/vos.h>
+#include <gurt/atomic.h>
 #include <gurt/telemetry_producer.h>
 #include "srv_internal.h"
 
@@ -22,6 +23,10 @@ struct sched_req_info {
 	uint32_t		sri_req_kicked;
 	/* Limit of kicked requests in current cycle */
 	uint32_t		sri_req_limit;
+	/* Kick credits left for rate capped request type */
+	uint32_t		sri_credits;
+	/* When the credits were refilled, in msecs */
+	uint64_t		sri_credits_ts;
 };
 
 struct sched_pool_info {
@@ -29,6 +34,14 @@ struct sched_pool_info {
 	d_list_t		spi_hash_link;
 	uuid_t			spi_pool_id;
 	struct sched_req_info	spi_req_array[SCHED_REQ_MAX];
+	/* Link to 'sched_info->si_wfq_list' when pool has pending IO */
+	d_list_t		spi_wfq_link;
+	/* Virtual finish time of the pool for WFQ policy */
+	uint64_t		spi_vtime;
+	/* WFQ weight, [1, SCHED_WFQ_WEIGHT_MAX] */
+	uint32_t		spi_weight;
+	/* Request types can't be kicked in current WFQ cycle */
+	uint32_t		spi_wfq_blocked;
 	/* When space pressure info acquired, in msecs */
 	uint64_t		spi_space_ts;
 	/* When pool is running into space pressure, in msecs */
@@ -42,7 +55,8 @@ struct sched_pool_info {
 
 struct sched_request {
 	/*
-	 * IO request links to 'sched_info->si_fifo_list', other types of
+	 * IO request links to 'sched_info->si_fifo_list' (FIFO policy) or
+	 * 'sched_req_info->sri_req_list' (WFQ policy), other types of
 	 * request link to each 'sched_req_info->sri_req_list' respectively.
 	 * When request is not used, it's in 'sched_info->si_idle_list'.
 	 */
@@ -52,6 +66,8 @@ struct sched_request {
 	void			*sr_arg;
 	ABT_thread		 sr_ult;
 	struct sched_pool_info	*sr_pool_info;
+	/* Position in 'sched_info->si_sleep_heap' while sleeping */
+	struct d_binheap_node	 sr_sleep_node;
 	/* Wakeup time for the sleeping request, in milli seconds */
 	uint64_t		 sr_wakeup_time;
 	/* When the request is enqueued, in msecs */
@@ -66,6 +82,16 @@ unsigned int	sched_relax_intvl = SCHED_RELAX_INTVL_DEFAULT;
 unsigned int	sched_relax_mode;
 unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
+bool		sched_rpc_acct;
+unsigned int	sched_io_deadline = 100; /* ms */
+unsigned int	sched_wfq_budget = 512; /* IO requests per cycle */
+unsigned int	sched_nvme_poll_age = SCHED_AGE_NVME_MAX; /* ULTs per NVMe poll */
+uint64_t	sched_mem_budget; /* bytes, 0 means no budget */
+
+/* DRAM used by the registered caches of all xstreams, as last sampled */
+static ATOMIC uint64_t	sched_mem_usage;
+
+#define SCHED_MEM_CHECK_INTVL	1000 /* ms */
 
 enum {
 	/* All requests for various pools are processed in FIFO */
@@ -80,9 +106,19 @@ enum {
 	 * Container ID, JobID, UID, etc.)
 	 */
 	SCHED_POLICY_ID_PRIO,
+	/*
+	 * IO requests are processed in weighted fair queueing across pools,
+	 * a pool having IO request waited longer than the deadline is always
+	 * served first.
+	 */
+	SCHED_POLICY_WFQ,
 	SCHED_POLICY_MAX
 };
 
+#define SCHED_WFQ_WEIGHT_DEF	DAOS_PROP_PO_SCHED_WEIGHT_DEF
+#define SCHED_WFQ_WEIGHT_MAX	DAOS_PROP_PO_SCHED_WEIGHT_MAX
+#define SCHED_WFQ_VTIME_SCALE	SCHED_WFQ_WEIGHT_MAX
+
 static int	sched_policy;
 
 /*
@@ -120,6 +156,20 @@ static unsigned int req_throttle[SCHED_REQ_MAX] = {
 	30,	/* SCHED_REQ_REBUILD */
 };
 
+/*
+ * Max kicked requests per second for certain type of requests, 0 means
+ * unlimited. It's applied on top of the 'req_throttle' percentage, which
+ * is relative to IO load and doesn't cap background work on a lightly
+ * loaded engine.
+ */
+static unsigned int req_rate_max[SCHED_REQ_MAX] = {
+	0,	/* SCHED_REQ_UPDATE */
+	0,	/* SCHED_REQ_FETCH */
+	0,	/* SCHED_REQ_GC */
+	0,	/* SCHED_REQ_SCRUB */
+	0,	/* SCHED_REQ_MIGRATE */
+};
+
 /*
  * Throttle certain type of requests to N percent of IO requests
  * in a cycle. IO requests can't be throttled.
@@ -146,6 +196,42 @@ sched_set_throttle(unsigned int type, unsigned int percent)
 	return 0;
 }
 
+/*
+ * Cap certain type of requests to N kicked requests per second, 0 removes
+ * the cap. IO requests can't be capped.
+ */
+int
+sched_set_rate(unsigned int type, unsigned int rate)
+{
+	if (type >= SCHED_REQ_MAX || type == SCHED_REQ_ANONYM) {
+		D_ERROR("Invalid request type: %d\n", type);
+		return -DER_INVAL;
+	}
+
+	if (type == SCHED_REQ_UPDATE || type == SCHED_REQ_FETCH) {
+		D_ERROR("Can't cap IO requests\n");
+		return -DER_INVAL;
+	}
+
+	req_rate_max[type] = rate;
+	return 0;
+}
+
+int
+sched_set_policy(const char *name)
+{
+	if (strcasecmp(name, "fifo") == 0) {
+		sched_policy = SCHED_POLICY_FIFO;
+	} else if (strcasecmp(name, "wfq") == 0) {
+		sched_policy = SCHED_POLICY_WFQ;
+	} else {
+		D_ERROR("Invalid sched policy: %s\n", name);
+		return -DER_INVAL;
+	}
+
+	return 0;
+}
+
 struct pressure_ratio {
 	unsigned int	pr_free;	/* free space ratio */
 	unsigned int	pr_throttle;	/* update throttle ratio */
@@ -277,6 +363,7 @@ spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 			  type, pool2req_cnt(spi, type));
 		D_ASSERT(d_list_empty(pool2req_list(spi, type)));
 	}
+	d_list_del_init(&spi->spi_wfq_link);
 
 	D_FREE(spi);
 }
@@ -381,8 +468,15 @@ sched_info_fini(struct dss_xstream *dx)
 	struct sched_request	*req, *tmp;
 
 	D_ASSERT(info->si_req_cnt == 0);
-	D_ASSERT(d_list_empty(&info->si_sleep_list));
+	D_ASSERT(d_binheap_is_empty(&info->si_sleep_heap));
+	d_binheap_destroy_inplace(&info->si_sleep_heap);
 	D_ASSERT(d_list_empty(&info->si_fifo_list));
+	D_ASSERT(d_list_empty(&info->si_wfq_list));
+	D_ASSERT(d_list_empty(&info->si_mem_list));
+	if (info->si_mem_usage != 0) {
+		atomic_fetch_sub_relaxed(&sched_mem_usage, info->si_mem_usage);
+		info->si_mem_usage = 0;
+	}
 
 	prune_purge_list(dx);
 
@@ -460,6 +554,123 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "ULT", "sched/cycle_size/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create cycle_size telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_io_overdue, D_TM_COUNTER,
+			     "IO requests kicked after the deadline", "req",
+			     "sched/io_overdue/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create io_overdue telemetry: "DF_RC"\n", DP_RC(rc));
+}
+
+static bool
+sleep_heap_cmp(struct d_binheap_node *a, struct d_binheap_node *b)
+{
+	struct sched_request	*ra, *rb;
+
+	ra = container_of(a, struct sched_request, sr_sleep_node);
+	rb = container_of(b, struct sched_request, sr_sleep_node);
+
+	return ra->sr_wakeup_time < rb->sr_wakeup_time;
+}
+
+static struct d_binheap_ops sleep_heap_ops = {
+	.hop_enter	= NULL,
+	.hop_exit	= NULL,
+	.hop_compare	= sleep_heap_cmp,
+};
+
+void
+dss_mem_cache_register(int xs_id, struct dss_mem_cache *cache)
+{
+	struct dss_xstream	*dx = dss_xstream_lookup(xs_id);
+	struct sched_info	*info;
+	struct dss_mem_cache	*tmp;
+	d_list_t		*pos;
+	int			 rc;
+
+	D_ASSERT(cache->mc_usage != NULL && cache->mc_shrink != NULL);
+	if (dx == NULL) {
+		D_DEBUG(DB_TRACE, "No xstream %d, %s not registered\n", xs_id,
+			cache->mc_name);
+		return;
+	}
+
+	info = &dx->dx_sched_info;
+	pos = &info->si_mem_list;
+	d_list_for_each_entry(tmp, &info->si_mem_list, mc_link) {
+		if (tmp->mc_prio > cache->mc_prio) {
+			pos = &tmp->mc_link;
+			break;
+		}
+	}
+	/* insert before the first cache having a higher priority */
+	d_list_add_tail(&cache->mc_link, pos);
+
+	cache->mc_tm_usage = NULL;
+	rc = d_tm_add_metric(&cache->mc_tm_usage, D_TM_GAUGE, "DRAM cache usage", "bytes",
+			     "sched/mem/%s/xs_%u", cache->mc_name, dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create %s DRAM usage telemetry: "DF_RC"\n",
+		       cache->mc_name, DP_RC(rc));
+}
+
+void
+dss_mem_cache_unregister(struct dss_mem_cache *cache)
+{
+	d_list_del_init(&cache->mc_link);
+}
+
+/*
+ * Sample the DRAM used by the caches of this xstream, then shrink them in
+ * priority order if the engine is over budget. Each xstream only releases
+ * its share of the excess, in proportion to its own usage, so the caches
+ * of all xstreams are shrunk evenly.
+ */
+static void
+sched_mem_check(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct dss_mem_cache	*cache;
+	uint64_t		 usage = 0, total, excess;
+
+	if (d_list_empty(&info->si_mem_list) ||
+	    info->si_cur_ts < info->si_mem_ts + SCHED_MEM_CHECK_INTVL)
+		return;
+	info->si_mem_ts = info->si_cur_ts;
+
+	d_list_for_each_entry(cache, &info->si_mem_list, mc_link) {
+		uint64_t	size = cache->mc_usage(cache->mc_arg);
+
+		d_tm_set_gauge(cache->mc_tm_usage, size);
+		usage += size;
+	}
+
+	if (usage >= info->si_mem_usage)
+		total = atomic_fetch_add_relaxed(&sched_mem_usage,
+						 usage - info->si_mem_usage);
+	else
+		total = atomic_fetch_sub_relaxed(&sched_mem_usage,
+						 info->si_mem_usage - usage);
+	total = total + usage - info->si_mem_usage;
+	info->si_mem_usage = usage;
+
+	if (sched_mem_budget == 0 || total <= sched_mem_budget || usage == 0)
+		return;
+
+	excess = (total - sched_mem_budget) * ((double)usage / total);
+	D_DEBUG(DB_TRACE, "xs:%d DRAM caches over budget "DF_U64"/"DF_U64
+		", shrink "DF_U64" bytes\n", dx->dx_xs_id, total,
+		sched_mem_budget, excess);
+
+	d_list_for_each_entry(cache, &info->si_mem_list, mc_link) {
+		uint64_t	released;
+
+		if (excess == 0)
+			break;
+
+		released = cache->mc_shrink(cache->mc_arg, excess);
+		excess = released >= excess ? 0 : excess - released;
+	}
 }
 
 static int
@@ -471,20 +682,38 @@ sched_info_init(struct dss_xstream *dx)
 	info->si_cur_ts = daos_getmtime_coarse();
 	info->si_cur_seq = 0;
 	D_INIT_LIST_HEAD(&info->si_idle_list);
-	D_INIT_LIST_HEAD(&info->si_sleep_list);
 	D_INIT_LIST_HEAD(&info->si_fifo_list);
 	D_INIT_LIST_HEAD(&info->si_purge_list);
+	D_INIT_LIST_HEAD(&info->si_wfq_list);
+	info->si_wfq_vtime = 0;
 	info->si_req_cnt = 0;
 	info->si_sleep_cnt = 0;
 	info->si_wait_cnt = 0;
+	D_INIT_LIST_HEAD(&info->si_mem_list);
+	info->si_mem_usage = 0;
+	info->si_mem_ts = info->si_cur_ts;
 	info->si_stop = 0;
+	info->si_rpc_mod = -1;
 	sched_metrics_init(dx);
 
+	/*
+	 * Sleeping ULTs (retry backoffs, GC and aggregation yields) can be
+	 * numerous, keep them in a heap rather than a sorted list so that
+	 * going to sleep does not have to walk the other sleepers.
+	 */
+	rc = d_binheap_create_inplace(DBH_FT_NOLOCK, 0, NULL, &sleep_heap_ops,
+				      &info->si_sleep_heap);
+	if (rc) {
+		D_ERROR("Create sched sleep heap failed. "DF_RC".\n", DP_RC(rc));
+		return rc;
+	}
+
 	rc = d_hash_table_create(D_HASH_FT_NOLOCK, 4,
 				 NULL, &sched_pool_hash_ops,
 				 &info->si_pool_hash);
 	if (rc) {
 		D_ERROR("Create sched pool hash failed. "DF_RC".\n", DP_RC(rc));
+		d_binheap_destroy_inplace(&info->si_sleep_heap);
 		return rc;
 	}
 
@@ -519,7 +748,9 @@ cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 		return NULL;
 	}
 	D_INIT_LIST_HEAD(&spi->spi_hash_link);
+	D_INIT_LIST_HEAD(&spi->spi_wfq_link);
 	uuid_copy(spi->spi_pool_id, pool_uuid);
+	spi->spi_weight = SCHED_WFQ_WEIGHT_DEF;
 
 	for (type = SCHED_REQ_UPDATE; type < SCHED_REQ_MAX; type++) {
 		list = pool2req_list(spi, type);
@@ -599,18 +830,71 @@ req_kickoff_internal(struct dss_xstream *dx, struct sched_req_attr *attr,
 				   0);
 }
 
+/* ULT function of the RPC handlers, i.e. the one passed to sched_req_enqueue() */
+static void	*sched_rpc_func;
+
+static inline int
+sched_rpc_mod(crt_rpc_t *rpc)
+{
+	unsigned int	mod_id = opc_get_mod_id(rpc->cr_opc);
+
+	return mod_id < DAOS_MAX_MODULE ? mod_id : SCHED_RPC_MOD_CART;
+}
+
+static struct sched_rpc_stats *
+sched_rpc_stats_get(struct dss_xstream *dx, int mod)
+{
+	struct sched_rpc_stats	*srs = &dx->dx_sched_info.si_stats.ss_rpc[mod];
+	struct dss_module	*module;
+	const char		*name = "cart";
+	int			 rc;
+
+	if (likely(srs->srs_inited))
+		return srs;
+
+	/* Created on the first RPC of the module, once all modules are loaded */
+	srs->srs_inited = true;
+	if (mod != SCHED_RPC_MOD_CART) {
+		module = dss_module_get(mod);
+		name = module != NULL ? module->sm_name : "unknown";
+	}
+
+	rc = d_tm_add_metric(&srs->srs_cpu_time, D_TM_COUNTER, "RPC handler running time", "us",
+			     "sched/rpc_cpu/%s/xs_%u", name, dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create rpc_cpu telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&srs->srs_runs, D_TM_COUNTER, "RPC handler ULT executions", "ULT",
+			     "sched/rpc_runs/%s/xs_%u", name, dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create rpc_runs telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&srs->srs_queue_delay, D_TM_STATS_GAUGE, "RPC sched queueing delay",
+			     "ms", "sched/rpc_queue/%s/xs_%u", name, dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create rpc_queue telemetry: "DF_RC"\n", DP_RC(rc));
+
+	return srs;
+}
+
 static int
 req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_pool_info	*spi = req->sr_pool_info;
 	struct sched_req_info	*sri;
+	struct sched_rpc_stats	*srs;
 	int			 rc;
 
 	if (req->sr_ult != ABT_THREAD_NULL) {
 		rc = ABT_thread_resume(req->sr_ult);
 		rc = dss_abterr2der(rc);
 	} else {
+		if (sched_rpc_acct && req->sr_func == sched_rpc_func) {
+			srs = sched_rpc_stats_get(dx, sched_rpc_mod(req->sr_arg));
+			d_tm_set_gauge(srs->srs_queue_delay,
+				       info->si_cur_ts - req->sr_enqueue_ts);
+		}
 		rc = req_kickoff_internal(dx, &req->sr_attr, req->sr_func,
 					  req->sr_arg);
 	}
@@ -632,7 +916,7 @@ req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 	return rc;
 }
 
-#define SCHED_SPACE_AGE_MAX	2000	/* 2000 msecs */
+#define SCHED_SPACE_AGE_MAX	500	/* 500 msecs */
 
 static int
 check_space_pressure(struct dss_xstream *dx, struct sched_pool_info *spi)
@@ -652,7 +936,7 @@ check_space_pressure(struct dss_xstream *dx, struct sched_pool_info *spi)
 	if ((spi->spi_space_ts + SCHED_SPACE_AGE_MAX) > info->si_cur_ts)
 		goto out;
 
-	rc = vos_pool_query_space(spi->spi_pool_id, &vps);
+	rc = vos_pool_query_space_cached(spi->spi_pool_id, &vps);
 	if (rc == -DER_NONEXIST) {	/* vos pool is destroyed */
 		add_purge_list(dx, spi);
 		goto out;
@@ -777,6 +1061,43 @@ set_req_limit(struct dss_xstream *dx, struct sched_pool_info *spi,
 	spi->spi_req_array[req_type].sri_req_kicked = 0;
 }
 
+/*
+ * Refill the kick credits of a rate capped request type, and clamp the
+ * limit of current cycle to the available credits.
+ */
+static inline unsigned int
+rate_limit(struct sched_info *info, struct sched_pool_info *spi,
+	   unsigned int req_type, unsigned int limit)
+{
+	struct sched_req_info	*sri = &spi->spi_req_array[req_type];
+	unsigned int		 rate = req_rate_max[req_type];
+	uint64_t		 credits;
+
+	if (rate == 0 || limit == 0)
+		return limit;
+
+	D_ASSERT(info->si_cur_ts >= sri->sri_credits_ts);
+	credits = (info->si_cur_ts - sri->sri_credits_ts) * rate / 1000;
+	if (credits != 0 || sri->sri_credits_ts == 0) {
+		/* Allow one second burst at most */
+		sri->sri_credits = min(rate, sri->sri_credits + credits);
+		sri->sri_credits_ts = info->si_cur_ts;
+	}
+
+	return min(limit, sri->sri_credits);
+}
+
+static inline void
+rate_consume(struct sched_pool_info *spi, unsigned int req_type)
+{
+	struct sched_req_info	*sri = &spi->spi_req_array[req_type];
+
+	if (req_rate_max[req_type] == 0)
+		return;
+
+	sri->sri_credits -= min(sri->sri_credits, sri->sri_req_kicked);
+}
+
 /* Are space reclaiming ULTs busy/pending on reclaiming space? */
 static inline bool
 is_gc_pending(struct sched_pool_info *spi)
@@ -879,6 +1200,11 @@ out:
 		mig_max = min(mig_max, mig_thr);
 	}
 
+	/* Cap rebuild, aggregation and scrub in absolute rate */
+	gc_max	= rate_limit(info, spi, SCHED_REQ_GC, gc_max);
+	scrub_max = rate_limit(info, spi, SCHED_REQ_SCRUB, scrub_max);
+	mig_max	= rate_limit(info, spi, SCHED_REQ_MIGRATE, mig_max);
+
 	set_req_limit(dx, spi, SCHED_REQ_UPDATE, u_max);
 	set_req_limit(dx, spi, SCHED_REQ_FETCH, f_max);
 	set_req_limit(dx, spi, SCHED_REQ_GC, gc_max);
@@ -889,6 +1215,10 @@ out:
 	process_req_list(dx, pool2req_list(spi, SCHED_REQ_SCRUB), true);
 	process_req_list(dx, pool2req_list(spi, SCHED_REQ_MIGRATE), true);
 
+	rate_consume(spi, SCHED_REQ_GC);
+	rate_consume(spi, SCHED_REQ_SCRUB);
+	rate_consume(spi, SCHED_REQ_MIGRATE);
+
 	return 0;
 }
 
@@ -909,6 +1239,144 @@ policy_fifo_process(struct dss_xstream *dx)
 	process_req_list(dx, &info->si_fifo_list, false);
 }
 
+static void
+policy_wfq_enqueue(struct dss_xstream *dx, struct sched_request *req,
+		   void *prio_data)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi = req->sr_pool_info;
+
+	d_list_add_tail(&req->sr_link,
+			pool2req_list(spi, req->sr_attr.sra_type));
+
+	/* Pool becomes active, don't let it claim the idle time back */
+	if (d_list_empty(&spi->spi_wfq_link)) {
+		spi->spi_vtime = max(spi->spi_vtime, info->si_wfq_vtime);
+		d_list_add_tail(&spi->spi_wfq_link, &info->si_wfq_list);
+	}
+}
+
+/* The oldest IO request of a pool which isn't blocked in current cycle */
+static struct sched_request *
+wfq_pool_head(struct sched_pool_info *spi)
+{
+	struct sched_request	*req, *head = NULL;
+	d_list_t		*list;
+	unsigned int		 type;
+
+	for (type = SCHED_REQ_UPDATE; type <= SCHED_REQ_FETCH; type++) {
+		list = pool2req_list(spi, type);
+		if (d_list_empty(list) || (spi->spi_wfq_blocked & (1U << type)))
+			continue;
+
+		req = d_list_entry(list->next, struct sched_request, sr_link);
+		if (head == NULL || req->sr_enqueue_ts < head->sr_enqueue_ts)
+			head = req;
+	}
+	return head;
+}
+
+static inline bool
+wfq_pool_idle(struct sched_pool_info *spi)
+{
+	return d_list_empty(pool2req_list(spi, SCHED_REQ_UPDATE)) &&
+	       d_list_empty(pool2req_list(spi, SCHED_REQ_FETCH));
+}
+
+/*
+ * Pick the next IO request to be kicked: the oldest request which already
+ * passed the deadline, otherwise the head of the pool with the smallest
+ * virtual finish time.
+ */
+static struct sched_request *
+wfq_pick(struct sched_info *info, bool *overdue)
+{
+	struct sched_pool_info	*spi, *tmp;
+	struct sched_request	*req, *edf = NULL, *wfq = NULL;
+
+	d_list_for_each_entry_safe(spi, tmp, &info->si_wfq_list, spi_wfq_link) {
+		if (wfq_pool_idle(spi)) {
+			d_list_del_init(&spi->spi_wfq_link);
+			continue;
+		}
+
+		req = wfq_pool_head(spi);
+		if (req == NULL)
+			continue;
+
+		D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+		if ((info->si_cur_ts - req->sr_enqueue_ts) >= sched_io_deadline) {
+			if (edf == NULL || req->sr_enqueue_ts < edf->sr_enqueue_ts)
+				edf = req;
+		}
+
+		if (wfq == NULL || spi->spi_vtime < wfq->sr_pool_info->spi_vtime)
+			wfq = req;
+	}
+
+	*overdue = (edf != NULL);
+	return edf != NULL ? edf : wfq;
+}
+
+static void
+policy_wfq_process(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi;
+	struct sched_request	*req;
+	unsigned int		 budget = sched_wfq_budget;
+	unsigned int		 req_type;
+	bool			 overdue;
+
+	d_list_for_each_entry(spi, &info->si_wfq_list, spi_wfq_link)
+		spi->spi_wfq_blocked = 0;
+
+	/* Kickoff all requests on shutdown */
+	while (info->si_stop || budget > 0) {
+		req = wfq_pick(info, &overdue);
+		if (req == NULL)
+			break;
+
+		spi = req->sr_pool_info;
+		req_type = req->sr_attr.sra_type;
+		if (process_req(dx, req)) {
+			/* Throttled, stop this type of the pool in this cycle */
+			spi->spi_wfq_blocked |= (1U << req_type);
+			continue;
+		}
+
+		if (overdue)
+			d_tm_inc_counter(info->si_stats.ss_io_overdue, 1);
+
+		D_ASSERT(spi->spi_weight > 0);
+		spi->spi_vtime += SCHED_WFQ_VTIME_SCALE / spi->spi_weight;
+		info->si_wfq_vtime = max(info->si_wfq_vtime, spi->spi_vtime);
+		if (wfq_pool_idle(spi))
+			d_list_del_init(&spi->spi_wfq_link);
+		if (budget > 0)
+			budget--;
+	}
+}
+
+int
+sched_set_pool_weight(uuid_t pool_id, unsigned int weight)
+{
+	struct dss_xstream	*dx = dss_current_xstream();
+	struct sched_pool_info	*spi;
+
+	if (weight == 0 || weight > SCHED_WFQ_WEIGHT_MAX) {
+		D_ERROR("Invalid weight: %u\n", weight);
+		return -DER_INVAL;
+	}
+
+	spi = cur_pool_info(&dx->dx_sched_info, pool_id);
+	if (spi == NULL)
+		return -DER_NOMEM;
+
+	spi->spi_weight = weight;
+	return 0;
+}
+
 struct sched_policy_ops {
 	void (*enqueue_io)(struct dss_xstream *dx, struct sched_request *req,
 			   void *prio_data);
@@ -927,6 +1395,10 @@ static struct sched_policy_ops	policy_ops[SCHED_POLICY_MAX] = {
 	{	/* SCHED_POLICY_ID_PRIO */
 		.enqueue_io = NULL,
 		.process_io = NULL,
+	},
+	{	/* SCHED_POLICY_WFQ */
+		.enqueue_io = policy_wfq_enqueue,
+		.process_io = policy_wfq_process,
 	}
 };
 
@@ -938,6 +1410,7 @@ process_all(struct dss_xstream *dx)
 
 	if (info->si_req_cnt == 0) {
 		D_ASSERT(d_list_empty(&info->si_fifo_list));
+		D_ASSERT(d_list_empty(&info->si_wfq_list));
 		return;
 	}
 
@@ -998,6 +1471,10 @@ sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 {
 	struct sched_request	*req;
 
+	/* Only the RPC handlers are enqueued here, see dss_rpc_hdlr() */
+	if (unlikely(sched_rpc_func != func))
+		sched_rpc_func = func;
+
 	if (!should_enqueue_req(dx, attr))
 		return req_kickoff_internal(dx, attr, func, arg);
 
@@ -1059,7 +1536,7 @@ sched_req_sleep(struct sched_request *req, uint32_t msecs)
 {
 	struct dss_xstream	*dx = dss_current_xstream();
 	struct sched_info	*info = &dx->dx_sched_info;
-	struct sched_request	*tmp;
+	int			 rc;
 
 	D_ASSERT(req != NULL);
 	if (msecs == 0 || info->si_stop || req->sr_abort) {
@@ -1068,18 +1545,17 @@ sched_req_sleep(struct sched_request *req, uint32_t msecs)
 	}
 
 	D_ASSERT(req->sr_ult != ABT_THREAD_NULL);
+	D_ASSERT(d_list_empty(&req->sr_link));
 	req->sr_wakeup_time = info->si_cur_ts + msecs;
 
-	D_ASSERT(d_list_empty(&req->sr_link));
-	/* Sleep list is sorted in wakeup time ascending order */
-	d_list_for_each_entry_reverse(tmp, &info->si_sleep_list, sr_link) {
-		if (req->sr_wakeup_time >= tmp->sr_wakeup_time) {
-			d_list_add(&req->sr_link, &tmp->sr_link);
-			break;
-		}
+	rc = d_binheap_insert(&info->si_sleep_heap, &req->sr_sleep_node);
+	if (rc) {
+		D_ERROR("Failed to queue sleeping request, yield instead. "DF_RC"\n",
+			DP_RC(rc));
+		req->sr_wakeup_time = 0;
+		sched_req_yield(req);
+		return;
 	}
-	if (d_list_empty(&req->sr_link))
-		d_list_add(&req->sr_link, &info->si_sleep_list);
 
 	sleep_counting(dx, req, 1);
 
@@ -1094,8 +1570,7 @@ req_wakeup_internal(struct dss_xstream *dx, struct sched_request *req)
 	if (req->sr_wakeup_time == 0)
 		return;
 
-	D_ASSERT(!d_list_empty(&req->sr_link));
-	d_list_del_init(&req->sr_link);
+	d_binheap_remove(&dx->dx_sched_info.si_sleep_heap, &req->sr_sleep_node);
 	req->sr_wakeup_time = 0;
 
 	sleep_counting(dx, req, -1);
@@ -1147,9 +1622,11 @@ static void
 wakeup_all(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
-	struct sched_request	*req, *tmp;
+	struct d_binheap_node	*node;
+	struct sched_request	*req;
 
-	d_list_for_each_entry_safe(req, tmp, &info->si_sleep_list, sr_link) {
+	while ((node = d_binheap_root(&info->si_sleep_heap)) != NULL) {
+		req = container_of(node, struct sched_request, sr_sleep_node);
 		D_ASSERT(req->sr_wakeup_time > 0);
 		if (!info->si_stop && req->sr_wakeup_time > info->si_cur_ts)
 			break;
@@ -1157,7 +1634,7 @@ wakeup_all(struct dss_xstream *dx)
 		if (!should_enqueue_req(dx, &req->sr_attr)) {
 			req_wakeup_internal(dx, req);
 		} else {
-			d_list_del_init(&req->sr_link);
+			d_binheap_remove(&info->si_sleep_heap, node);
 			req->sr_wakeup_time = 0;
 			sleep_counting(dx, req, -1);
 			D_ASSERT(req->sr_ult != ABT_THREAD_NULL);
@@ -1346,7 +1823,6 @@ sched_dump_data(struct sched_data *data)
 }
 
 #define SCHED_AGE_NET_MAX		32
-#define SCHED_AGE_NVME_MAX		64
 
 static int
 sched_init(ABT_sched sched, ABT_sched_config config)
@@ -1444,7 +1920,7 @@ need_nvme_poll(struct dss_xstream *dx, struct sched_cycle *cycle)
 	 * Need extra NVMe poll when too many ULTs are processed in
 	 * current cycle.
 	 */
-	if (cycle->sc_age_nvme > SCHED_AGE_NVME_MAX)
+	if (cycle->sc_age_nvme > sched_nvme_poll_age)
 		return true;
 
 	/* TLS is destroyed on dss_srv_handler ULT exiting */
@@ -1598,9 +2074,9 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	if (info->si_sleep_cnt > 0) {
 		struct sched_request	*req;
 
-		D_ASSERT(!d_list_empty(&info->si_sleep_list));
-		req = d_list_entry(info->si_sleep_list.next,
-				   struct sched_request, sr_link);
+		D_ASSERT(!d_binheap_is_empty(&info->si_sleep_heap));
+		req = container_of(d_binheap_root(&info->si_sleep_heap),
+				   struct sched_request, sr_sleep_node);
 
 		/* sched_start_cycle() has already been called for info->si_cur_ts */
 		D_ASSERT(req->sr_wakeup_time > info->si_cur_ts);
@@ -1655,6 +2131,7 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 
 	wakeup_all(dx);
 	process_all(dx);
+	sched_mem_check(dx);
 
 	/* Get number of ULTS in generic ABT pool */
 	D_ASSERT(cycle->sc_ults_cnt[DSS_POOL_GENERIC] == 0);
@@ -1774,6 +2251,48 @@ sched_watchdog_post(struct dss_xstream *dx)
 	free(strings);
 }
 
+/*
+ * Charge the running time of RPC handler ULTs to the module of the RPC, each
+ * execution lasts from the ULT being scheduled to its next yield or exit.
+ */
+static void
+sched_rpc_acct_prep(struct dss_xstream *dx, ABT_unit unit)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	ABT_thread		 thread;
+	void			 (*thread_func)(void *);
+	void			*arg;
+
+	info->si_rpc_mod = -1;
+	if (!sched_rpc_acct || sched_rpc_func == NULL)
+		return;
+
+	if (ABT_unit_get_thread(unit, &thread) != ABT_SUCCESS ||
+	    ABT_thread_get_thread_func(thread, &thread_func) != ABT_SUCCESS ||
+	    thread_func != sched_rpc_func)
+		return;
+
+	if (ABT_thread_get_arg(thread, &arg) != ABT_SUCCESS || arg == NULL)
+		return;
+
+	info->si_rpc_mod = sched_rpc_mod(arg);
+	info->si_rpc_start = daos_get_ntime();
+}
+
+static void
+sched_rpc_acct_post(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_rpc_stats	*srs;
+
+	if (likely(info->si_rpc_mod < 0))
+		return;
+
+	srs = sched_rpc_stats_get(dx, info->si_rpc_mod);
+	d_tm_inc_counter(srs->srs_cpu_time, (daos_get_ntime() - info->si_rpc_start) / 1000);
+	d_tm_inc_counter(srs->srs_runs, 1);
+}
+
 static void
 sched_run(ABT_sched sched)
 {
@@ -1826,9 +2345,11 @@ sched_run(ABT_sched sched)
 execute:
 		D_ASSERT(pool != ABT_POOL_NULL);
 		sched_watchdog_prep(dx, unit);
+		sched_rpc_acct_prep(dx, unit);
 
 		ABT_xstream_run_unit(unit, pool);
 
+		sched_rpc_acct_post(dx);
 		sched_watchdog_post(dx);
 start_cycle:
 		if (cycle->sc_new_cycle) {
@@ -179,6 +179,20 @@ dss_get_xstream(int stream_id)
 	return xstream_data.xd_xs_ptrs[stream_id];
 }
 
+/**
+ * Same as dss_get_xstream(), but returns NULL instead of asserting if the
+ * xstream doesn't exist, e.g. for the TLS of the main thread initialized
+ * before any xstream is started.
+ */
+struct dss_xstream *
+dss_xstream_lookup(int stream_id)
+{
+	if (stream_id < 0 || stream_id >= xstream_data.xd_xs_nr)
+		return NULL;
+
+	return xstream_data.xd_xs_ptrs[stream_id];
+}
+
 /**
  * sleep milliseconds, then being rescheduled.
  *
@@ -707,6 +721,14 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 		D_GOTO(out_xstream, rc = dss_abterr2der(rc));
 	}
 
+	/*
+	 * Published before the progress ULT starts, so that modules can find
+	 * the xstream from their TLS init, e.g. dss_mem_cache_register().
+	 */
+	ABT_mutex_lock(xstream_data.xd_mutex);
+	xstream_data.xd_xs_ptrs[xs_id] = dx;
+	ABT_mutex_unlock(xstream_data.xd_mutex);
+
 	/** start progress ULT */
 	rc = ABT_thread_create(dx->dx_pools[DSS_POOL_NET_POLL],
 			       dss_srv_handler, dx, attr,
@@ -726,7 +748,6 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 		ABT_mutex_unlock(xstream_data.xd_mutex);
 		goto out_xstream;
 	}
-	xstream_data.xd_xs_ptrs[xs_id] = dx;
 	ABT_mutex_unlock(xstream_data.xd_mutex);
 	ABT_thread_attr_free(&attr);
 
@@ -737,6 +758,9 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int xs_id)
 
 	return 0;
 out_xstream:
+	ABT_mutex_lock(xstream_data.xd_mutex);
+	xstream_data.xd_xs_ptrs[xs_id] = NULL;
+	ABT_mutex_unlock(xstream_data.xd_mutex);
 	if (attr != ABT_THREAD_ATTR_NULL)
 		ABT_thread_attr_free(&attr);
 	ABT_xstream_join(dx->dx_xstream);
@@ -901,12 +925,23 @@ dss_start_xs_id(int xs_id)
 	return 0;
 }
 
+static void
+sched_rate_init(const char *env, unsigned int type)
+{
+	unsigned int	rate = 0;
+
+	d_getenv_int(env, &rate);
+	if (rate != 0 && sched_set_rate(type, rate) == 0)
+		D_INFO("%s is set to %u reqs/sec\n", env, rate);
+}
+
 static int
 dss_xstreams_init(void)
 {
-	char	*env;
-	int	rc = 0;
-	int	i, xs_id;
+	char		*env;
+	unsigned int	 mem_budget = 0;
+	int		 rc = 0;
+	int		 i, xs_id;
 
 	D_ASSERT(dss_tgt_nr >= 1);
 
@@ -938,6 +973,41 @@ dss_xstreams_init(void)
 
 	d_getenv_int("DAOS_SCHED_UNIT_RUNTIME_MAX", &sched_unit_runtime_max);
 	d_getenv_bool("DAOS_SCHED_WATCHDOG_ALL", &sched_watchdog_all);
+	d_getenv_bool("DAOS_SCHED_RPC_ACCT", &sched_rpc_acct);
+	if (sched_rpc_acct)
+		D_INFO("Per-module RPC CPU accounting is enabled.\n");
+
+	env = getenv("DAOS_SCHED_POLICY");
+	if (env && sched_set_policy(env) == 0)
+		D_INFO("Sched policy is set to [%s]\n", env);
+
+	d_getenv_int("DAOS_SCHED_IO_DEADLINE", &sched_io_deadline);
+	d_getenv_int("DAOS_SCHED_WFQ_BUDGET", &sched_wfq_budget);
+	if (sched_wfq_budget == 0) {
+		D_WARN("Invalid WFQ budget 0, set to 1.\n");
+		sched_wfq_budget = 1;
+	}
+
+	/*
+	 * Lower NVMe poll age polls NVMe completions more often when many
+	 * request ULTs are queued, at the cost of more empty polls.
+	 */
+	d_getenv_int("DAOS_SCHED_NVME_POLL_AGE", &sched_nvme_poll_age);
+	if (sched_nvme_poll_age == 0) {
+		D_WARN("Invalid NVMe poll age 0, set to 1.\n");
+		sched_nvme_poll_age = 1;
+	}
+
+	/* Engine-wide DRAM budget of the caches registered for it, in MiB */
+	d_getenv_int("DAOS_MEM_BUDGET", &mem_budget);
+	if (mem_budget != 0) {
+		sched_mem_budget = (uint64_t)mem_budget << 20;
+		D_INFO("DRAM cache budget is set to %u MiB\n", mem_budget);
+	}
+
+	sched_rate_init("DAOS_SCHED_GC_RATE", SCHED_REQ_GC);
+	sched_rate_init("DAOS_SCHED_SCRUB_RATE", SCHED_REQ_SCRUB);
+	sched_rate_init("DAOS_SCHED_REBUILD_RATE", SCHED_REQ_MIGRATE);
 
 	/* start the execution streams */
 	D_DEBUG(DB_TRACE,
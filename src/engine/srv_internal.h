@@ -7,6 +7,7 @@
 #define __DAOS_SRV_INTERNAL__
 
 #include <daos_srv/daos_engine.h>
+#include <gurt/heap.h>
 #include <gurt/telemetry_common.h>
 
 /**
@@ -24,6 +25,17 @@ enum {
 	DSS_POOL_CNT,
 };
 
+/* Per-module RPC accounting slots, the last one for CaRT internal RPCs */
+#define SCHED_RPC_MOD_CART	DAOS_MAX_MODULE
+#define SCHED_RPC_MOD_MAX	(DAOS_MAX_MODULE + 1)
+
+struct sched_rpc_stats {
+	struct d_tm_node_t	*srs_cpu_time;		/* Handler running time (us) */
+	struct d_tm_node_t	*srs_runs;		/* Handler ULT executions */
+	struct d_tm_node_t	*srs_queue_delay;	/* Queueing delay (ms) */
+	bool			 srs_inited;
+};
+
 struct sched_stats {
 	struct d_tm_node_t	*ss_total_time;		/* Total CPU time (ms) */
 	struct d_tm_node_t	*ss_relax_time;		/* CPU relax time (ms) */
@@ -34,6 +46,8 @@ struct sched_stats {
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
+	struct d_tm_node_t	*ss_io_overdue;		/* IO kicked after deadline */
+	struct sched_rpc_stats	 ss_rpc[SCHED_RPC_MOD_MAX]; /* Per-module RPC stats */
 };
 
 struct sched_info {
@@ -41,15 +55,22 @@ struct sched_info {
 	uint64_t		 si_cur_seq;	/* Current schedule sequence */
 	uint64_t		 si_ult_start;	/* Start time of last executed unit */
 	void			*si_ult_func;	/* Function addr of last executed unit */
+	uint64_t		 si_rpc_start;	/* Start time (ns) of running RPC unit */
+	int			 si_rpc_mod;	/* Module of running RPC unit, or -1 */
 	struct sched_stats	 si_stats;	/* Sched stats */
 	d_list_t		 si_idle_list;	/* All unused requests */
-	d_list_t		 si_sleep_list;	/* All sleeping requests */
+	struct d_binheap	 si_sleep_heap;	/* Sleeping requests by wakeup time */
 	d_list_t		 si_fifo_list;	/* All IO requests in FIFO */
 	d_list_t		 si_purge_list;	/* Stale sched_pool_info */
+	d_list_t		 si_wfq_list;	/* Pools with pending IO (WFQ) */
+	uint64_t		 si_wfq_vtime;	/* WFQ system virtual time */
 	struct d_hash_table	*si_pool_hash;	/* All sched_pool_info */
 	uint32_t		 si_req_cnt;	/* Total inuse request count */
 	int			 si_sleep_cnt;	/* Sleeping request count */
 	int			 si_wait_cnt;	/* Long wait request count */
+	d_list_t		 si_mem_list;	/* DRAM caches by priority */
+	uint64_t		 si_mem_usage;	/* Last sampled cache usage */
+	uint64_t		 si_mem_ts;	/* Last cache usage sampling */
 	unsigned int		 si_stop:1;
 };
 
@@ -85,6 +106,8 @@ struct dss_xstream {
 struct engine_metrics {
 	struct d_tm_node_t	*started_time;
 	struct d_tm_node_t	*ready_time;
+	struct d_tm_node_t	*srv_init_dur;
+	struct d_tm_node_t	*setup_dur;
 	struct d_tm_node_t	*rank_id;
 	struct d_tm_node_t	*dead_rank_events;
 	struct d_tm_node_t	*last_event_time;
@@ -142,6 +165,7 @@ int dss_srv_fini(bool force);
 void dss_dump_ABT_state(FILE *fp);
 void dss_xstreams_open_barrier(void);
 struct dss_xstream *dss_get_xstream(int stream_id);
+struct dss_xstream *dss_xstream_lookup(int stream_id);
 int dss_xstream_cnt(void);
 
 /* srv_metrics.c */
@@ -187,16 +211,26 @@ sched_relax_str2mode(char *str)
 		return SCHED_RELAX_MODE_INVALID;
 }
 
+/* Default max ULTs executed between two NVMe polls */
+#define SCHED_AGE_NVME_MAX	64
+
 extern bool sched_prio_disabled;
 extern unsigned int sched_stats_intvl;
 extern unsigned int sched_relax_intvl;
 extern unsigned int sched_relax_mode;
 extern unsigned int sched_unit_runtime_max;
 extern bool sched_watchdog_all;
+extern bool sched_rpc_acct;
+extern unsigned int sched_io_deadline;
+extern unsigned int sched_wfq_budget;
+extern unsigned int sched_nvme_poll_age;
+extern uint64_t sched_mem_budget;
 
 void dss_sched_fini(struct dss_xstream *dx);
 int dss_sched_init(struct dss_xstream *dx);
 int sched_set_throttle(unsigned int type, unsigned int percent);
+int sched_set_rate(unsigned int type, unsigned int rate);
+int sched_set_policy(const char *name);
 int sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 		      void (*func)(void *), void *arg);
 void sched_stop(struct dss_xstream *dx);
@@ -40,6 +40,24 @@ dss_engine_metrics_init(void)
 		return rc;
 	}
 
+	rc = d_tm_add_metric(&dss_engine_metrics.srv_init_dur, D_TM_GAUGE,
+			     "Time spent on xstreams and NVMe setup at startup",
+			     "ms", "startup/srv_init");
+	if (rc != 0) {
+		D_ERROR("unable to add metric for service init time: "
+			DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+
+	rc = d_tm_add_metric(&dss_engine_metrics.setup_dur, D_TM_GAUGE,
+			     "Time spent on module setup at startup",
+			     "ms", "startup/module_setup");
+	if (rc != 0) {
+		D_ERROR("unable to add metric for module setup time: "
+			DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+
 	rc = d_tm_add_metric(&dss_engine_metrics.rank_id, D_TM_GAUGE,
 			     "Rank ID of this engine", "", "rank");
 	if (rc != 0) {
@@ -209,8 +209,8 @@ test_drpc_verify_notify_ready(void **state)
 
 	assert_rc_equal(drpc_notify_ready(), 0);
 
-	/* socket was closed */
-	assert_int_equal(close_call_count, 1);
+	/* session is kept open for the next dRPC */
+	assert_int_equal(close_call_count, 0);
 
 	/* Message was sent */
 	assert_non_null(sendmsg_msg_ptr);
@@ -218,6 +218,38 @@ test_drpc_verify_notify_ready(void **state)
 
 	/* Now let's shut things down... */
 	drpc_fini();
+
+	/* socket was closed */
+	assert_int_equal(close_call_count, 1);
+}
+
+static void
+test_drpc_call_reuses_session(void **state)
+{
+	Drpc__Response	*resp;
+	int		 i;
+
+	assert_rc_equal(drpc_init(), 0);
+
+	mock_valid_drpc_resp_in_recvmsg(DRPC__STATUS__SUCCESS);
+
+	for (i = 0; i < 3; i++) {
+		assert_rc_equal(dss_drpc_call(DRPC_MODULE_SRV,
+					      DRPC_METHOD_SRV_NOTIFY_READY,
+					      NULL /* req */, 0 /* req_size */,
+					      DSS_DRPC_NO_SCHED, &resp), 0);
+		assert_int_equal(resp->status, DRPC__STATUS__SUCCESS);
+		drpc_response_free(resp);
+	}
+
+	/* all dRPCs went through the same session */
+	assert_int_equal(sendmsg_call_count, 3);
+	assert_int_equal(recvmsg_call_count, 3);
+	assert_int_equal(close_call_count, 0);
+
+	drpc_fini();
+
+	assert_int_equal(close_call_count, 1);
 }
 
 static void
@@ -256,10 +288,10 @@ test_drpc_verify_notify_bio_error(void **state)
 	assert_rc_equal(drpc_init(), 0);
 
 	assert_rc_equal(ds_notify_bio_error(MET_WRITE, 0), 0);
-	verify_notify_bio_error();
 
-	/* Now let's shut things down... */
+	/* Now let's shut things down, which sends the queued dRPC... */
 	drpc_fini();
+	verify_notify_bio_error();
 
 	/* socket was closed */
 	assert_int_equal(close_call_count, 1);
@@ -427,13 +459,14 @@ test_drpc_verify_cluster_event(void **state)
 			    RAS_TYPE_INFO, RAS_SEV_ERROR, "exhwid", &rank,
 			    &inc, "exjobid", &pool, &cont, &objid, "exctlop",
 			    "{\"people\":[\"bill\",\"steve\",\"bob\"]}");
+
+	/* send the queued event */
+	drpc_fini();
 	verify_cluster_event((uint32_t)RAS_SYSTEM_STOP_FAILED, "ranks failed",
 			     (uint32_t)RAS_TYPE_INFO, (uint32_t)RAS_SEV_ERROR,
 			     "exhwid", rank, inc, "exjobid", pool_str, cont_str, "1.1",
 			     "exctlop",
 			     "{\"people\":[\"bill\",\"steve\",\"bob\"]}");
-
-	drpc_fini();
 }
 
 static void
@@ -445,12 +478,13 @@ test_drpc_verify_cluster_event_min_viable(void **state)
 	ds_notify_ras_event(RAS_ENGINE_DIED, "rank down",
 			    RAS_TYPE_STATE_CHANGE, RAS_SEV_WARNING, NULL, NULL,
 			    NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+	/* send the queued event */
+	drpc_fini();
 	verify_cluster_event((uint32_t)RAS_ENGINE_DIED, "rank down",
 			     (uint32_t)RAS_TYPE_STATE_CHANGE,
 			     (uint32_t)RAS_SEV_WARNING, "", mock_self_rank, 0, "",
 			     "", "", "", "", "");
-
-	drpc_fini();
 }
 
 static void
@@ -493,6 +527,7 @@ main(void)
 		UTEST(test_drpc_call_connect_fails),
 		UTEST(test_drpc_call_sendmsg_fails),
 		UTEST(test_drpc_verify_notify_ready),
+		UTEST(test_drpc_call_reuses_session),
 		UTEST(test_drpc_verify_notify_bio_error),
 		UTEST(test_drpc_verify_notify_pool_svc_update),
 		UTEST(test_drpc_verify_notify_pool_svc_update_noreps),
@@ -324,6 +324,38 @@ dss_thread_collective(int (*func)(void *), void *arg, unsigned int flags)
 
 /* ============== ULT create functions =================================== */
 
+/*
+ * Pick the less busy one of two shared offload xstreams: the one mapped to
+ * the target and a random one. It spreads the burst of CPU intensive tasks
+ * (checksum, EC encode, etc.) from one target over the whole helper pool.
+ */
+static uint32_t
+offload_xs_select(uint32_t base, uint32_t cnt, int tgt_id)
+{
+	struct dss_xstream	*dx, *alt_dx;
+	uint32_t		 xs_id, alt_id;
+	size_t			 size, alt_size;
+
+	xs_id = base + tgt_id % cnt;
+	if (cnt == 1)
+		return xs_id;
+
+	alt_id = base + d_rand() % cnt;
+	if (alt_id == xs_id)
+		return xs_id;
+
+	dx = dss_get_xstream(xs_id);
+	alt_dx = dss_get_xstream(alt_id);
+	if (dx == NULL || alt_dx == NULL)
+		return xs_id;
+
+	if (ABT_pool_get_size(dx->dx_pools[DSS_POOL_GENERIC], &size) != ABT_SUCCESS ||
+	    ABT_pool_get_size(alt_dx->dx_pools[DSS_POOL_GENERIC], &alt_size) != ABT_SUCCESS)
+		return xs_id;
+
+	return alt_size < size ? alt_id : xs_id;
+}
+
 static inline int
 sched_ult2xs(int xs_type, int tgt_id)
 {
@@ -388,10 +420,11 @@ sched_ult2xs(int xs_type, int tgt_id)
 		}
 
 		if (dss_tgt_offload_xs_nr > dss_tgt_nr)
-			xs_id = dss_sys_xs_nr + 2 * dss_tgt_nr +
-				(tgt_id % (dss_tgt_offload_xs_nr - dss_tgt_nr));
+			xs_id = offload_xs_select(dss_sys_xs_nr + 2 * dss_tgt_nr,
+						  dss_tgt_offload_xs_nr - dss_tgt_nr, tgt_id);
 		else if (dss_tgt_offload_xs_nr > 0)
-			xs_id = dss_sys_xs_nr + dss_tgt_nr + tgt_id % dss_tgt_offload_xs_nr;
+			xs_id = offload_xs_select(dss_sys_xs_nr + dss_tgt_nr,
+						  dss_tgt_offload_xs_nr, tgt_id);
 		else
 			xs_id = (DSS_MAIN_XS_ID(tgt_id) + 1) % dss_tgt_nr;
 		break;
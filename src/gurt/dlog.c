@@ -20,6 +20,7 @@
 #include <syslog.h>
 #include <time.h>
 #include <unistd.h>
+#include <sched.h>
 
 #ifdef DLOG_MUTEX
 #include <pthread.h>
@@ -48,8 +49,13 @@ enum {
 	LOG_SIZE_MIN	= (1ULL << 20),
 	/** default log file size is 2GB */
 	LOG_SIZE_DEF	= (1ULL << 31),
+	/** minimum per-thread buffer size for asynchronous logging is 64KB */
+	LOG_ASYNC_SIZE_MIN	= (1ULL << 16),
 };
 
+/** interval of the background flush of asynchronous logging */
+#define LOG_ASYNC_INTERVAL_MS	100
+
 /**
  * internal global state
  */
@@ -84,6 +90,43 @@ struct d_log_state {
 #ifdef DLOG_MUTEX
 	pthread_mutex_t clogmux;	/* protect clog in threaded env */
 #endif
+	/** per-thread buffer size, 0 if logging is synchronous */
+	uint64_t	 async_size;
+	/** all per-thread buffers, protected by clogmux */
+	d_list_t	 async_rings;
+	/** key of the per-thread buffer of the calling thread */
+	pthread_key_t	 async_key;
+	/** background thread flushing per-thread buffers to the log file */
+	pthread_t	 async_thread;
+	/** wake up async_thread */
+	pthread_cond_t	 async_cond;
+	/** async_thread should exit */
+	bool		 async_stop;
+	/** threads inside dlog_async_write(), the rings are kept until zero */
+	int		 async_writers;
+};
+
+/**
+ * per-thread buffer of formatted log messages for asynchronous logging.
+ *
+ * It's a single producer/single consumer ring: messages are only appended by
+ * the owner thread without locking, and are only consumed with clogmux held.
+ */
+struct dlog_ring {
+	d_list_t	 dr_link;
+	char		*dr_buf;
+	/** size of dr_buf, power of 2 */
+	uint64_t	 dr_size;
+	/** write position, only moved by the owner thread */
+	uint64_t	 dr_head;
+	/** read position, only moved with clogmux held */
+	uint64_t	 dr_tail;
+	/** number of messages dropped because the ring was full */
+	uint64_t	 dr_dropped;
+	/** number of dropped messages already reported in the log file */
+	uint64_t	 dr_dropped_rep;
+	/** owner thread exited, the ring is freed once drained */
+	bool		 dr_exited;
 };
 
 struct cache_entry {
@@ -113,6 +156,7 @@ static const char *default_fac0name = "CLOG";
 #endif
 
 static int d_log_write(char *buf, int len, bool flush);
+static void dlog_async_stop(void);
 static const char *clog_pristr(int);
 static int clog_setnfac(int);
 
@@ -278,6 +322,8 @@ static void dlog_cleanout(void)
 	struct cache_entry	*ce;
 	int			 lcv;
 
+	dlog_async_stop();
+
 	clog_lock();
 	if (mst.log_file) {
 		if (mst.log_fd >= 0) {
@@ -459,12 +505,246 @@ d_log_write(char *msg, int len, bool flush)
 	return 0;
 }
 
+static void
+dlog_ring_exit(void *arg)
+{
+	struct dlog_ring	*ring = arg;
+
+	__atomic_store_n(&ring->dr_exited, true, __ATOMIC_RELEASE);
+}
+
+/** get the ring of the calling thread, allocate it on first use */
+static struct dlog_ring *
+dlog_ring_get(void)
+{
+	struct dlog_ring	*ring;
+
+	ring = pthread_getspecific(mst.async_key);
+	if (ring != NULL)
+		return ring;
+
+	ring = calloc(1, sizeof(*ring));
+	if (ring == NULL)
+		return NULL;
+
+	ring->dr_size = mst.async_size;
+	ring->dr_buf = malloc(ring->dr_size);
+	if (ring->dr_buf == NULL) {
+		free(ring);
+		return NULL;
+	}
+
+	clog_lock();
+	d_list_add_tail(&ring->dr_link, &mst.async_rings);
+	clog_unlock();
+	pthread_setspecific(mst.async_key, ring);
+
+	return ring;
+}
+
+/** append a message to the ring, fail if there isn't enough room */
+static bool
+dlog_ring_put(struct dlog_ring *ring, const char *msg, uint64_t len)
+{
+	uint64_t	head = ring->dr_head;
+	uint64_t	tail;
+	uint64_t	off, n;
+
+	tail = __atomic_load_n(&ring->dr_tail, __ATOMIC_ACQUIRE);
+	if (len > ring->dr_size - (head - tail))
+		return false;
+
+	off = head & (ring->dr_size - 1);
+	n = min(len, ring->dr_size - off);
+	memcpy(&ring->dr_buf[off], msg, n);
+	if (n < len)
+		memcpy(ring->dr_buf, msg + n, len - n);
+
+	__atomic_store_n(&ring->dr_head, head + len, __ATOMIC_RELEASE);
+	return true;
+}
+
+/** move messages of the ring to the log buffer, caller must hold clog_lock */
+static void
+dlog_ring_drain(struct dlog_ring *ring)
+{
+	char		line[128];
+	uint64_t	head, tail, dropped;
+	uint64_t	off, n;
+	int		len;
+
+	head = __atomic_load_n(&ring->dr_head, __ATOMIC_ACQUIRE);
+	tail = ring->dr_tail;
+	while (tail != head) {
+		off = tail & (ring->dr_size - 1);
+		n = min(head - tail, ring->dr_size - off);
+		/* d_log_write() can't take more than LOG_BUF_SIZE at once */
+		n = min(n, LOG_BUF_SIZE / 2);
+		d_log_write(&ring->dr_buf[off], n, false);
+		tail += n;
+	}
+	__atomic_store_n(&ring->dr_tail, tail, __ATOMIC_RELEASE);
+
+	dropped = __atomic_load_n(&ring->dr_dropped, __ATOMIC_RELAXED);
+	if (dropped != ring->dr_dropped_rep) {
+		len = snprintf(line, sizeof(line),
+			       "%s dlog: dropped "DF_U64" log messages\n",
+			       mst.uts.nodename, dropped - ring->dr_dropped_rep);
+		d_log_write(line, min(len, (int)sizeof(line) - 1), false);
+		ring->dr_dropped_rep = dropped;
+	}
+}
+
+/**
+ * drain all rings and free the ones of exited threads, or all of them if
+ * \a free_all is true. caller must hold clog_lock.
+ */
+static void
+dlog_async_drain(bool free_all)
+{
+	struct dlog_ring	*ring, *tmp;
+	bool			 exited;
+
+	d_list_for_each_entry_safe(ring, tmp, &mst.async_rings, dr_link) {
+		exited = __atomic_load_n(&ring->dr_exited, __ATOMIC_ACQUIRE);
+		dlog_ring_drain(ring);
+		if (exited || free_all) {
+			d_list_del(&ring->dr_link);
+			free(ring->dr_buf);
+			free(ring);
+		}
+	}
+}
+
+static void *
+dlog_async_flusher(void *arg)
+{
+	struct timespec	ts;
+
+	clog_lock();
+	while (!mst.async_stop) {
+		dlog_async_drain(false);
+		d_log_write(NULL, 0, true);
+
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_nsec += LOG_ASYNC_INTERVAL_MS * NSEC_PER_MSEC;
+		if (ts.tv_nsec >= NSEC_PER_SEC) {
+			ts.tv_sec++;
+			ts.tv_nsec -= NSEC_PER_SEC;
+		}
+		pthread_cond_timedwait(&mst.async_cond, &mst.clogmux, &ts);
+	}
+	clog_unlock();
+
+	return NULL;
+}
+
+/** caller must hold clog_lock */
+static int
+dlog_async_start(uint64_t size)
+{
+	int	rc;
+
+	D_INIT_LIST_HEAD(&mst.async_rings);
+	rc = pthread_key_create(&mst.async_key, dlog_ring_exit);
+	if (rc != 0)
+		return -1;
+
+	rc = pthread_cond_init(&mst.async_cond, NULL);
+	if (rc != 0)
+		goto out_key;
+
+	mst.async_stop = false;
+	rc = pthread_create(&mst.async_thread, NULL, dlog_async_flusher, NULL);
+	if (rc != 0)
+		goto out_cond;
+
+	mst.async_size = size;
+	return 0;
+
+out_cond:
+	pthread_cond_destroy(&mst.async_cond);
+out_key:
+	pthread_key_delete(mst.async_key);
+	return -1;
+}
+
+static void
+dlog_async_stop(void)
+{
+	if (mst.async_size == 0)
+		return;
+
+	clog_lock();
+	/* messages are written synchronously from now on */
+	__atomic_store_n(&mst.async_size, 0, __ATOMIC_SEQ_CST);
+	mst.async_stop = true;
+	pthread_cond_signal(&mst.async_cond);
+	clog_unlock();
+
+	pthread_join(mst.async_thread, NULL);
+
+	/* wait for the writers which still saw asynchronous logging enabled */
+	while (__atomic_load_n(&mst.async_writers, __ATOMIC_SEQ_CST) != 0)
+		sched_yield();
+
+	/* no ring destructor must run on the rings freed below */
+	pthread_key_delete(mst.async_key);
+
+	clog_lock();
+	dlog_async_drain(true);
+	clog_unlock();
+
+	pthread_cond_destroy(&mst.async_cond);
+}
+
+/**
+ * queue a message to the ring of the calling thread. if the ring is full, debug
+ * and info messages are dropped, more important ones are written synchronously
+ * after the pending messages of the thread.
+ */
+static int
+dlog_async_write(char *msg, int len, int lvl, bool flush)
+{
+	struct dlog_ring	*ring = NULL;
+	int			 rc = 0;
+
+	/* pairs with dlog_async_stop(), which clears async_size then waits */
+	__atomic_fetch_add(&mst.async_writers, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&mst.async_size, __ATOMIC_SEQ_CST) == 0)
+		goto sync;
+
+	ring = dlog_ring_get();
+	if (ring != NULL && dlog_ring_put(ring, msg, len)) {
+		if (flush)
+			pthread_cond_signal(&mst.async_cond);
+		goto out;
+	}
+
+	if (ring != NULL && lvl < DLOG_WARN) {
+		__atomic_fetch_add(&ring->dr_dropped, 1, __ATOMIC_RELAXED);
+		goto out;
+	}
+sync:
+	clog_lock();
+	if (ring != NULL)
+		dlog_ring_drain(ring);
+	rc = d_log_write(msg, len, flush);
+	clog_unlock();
+out:
+	__atomic_fetch_sub(&mst.async_writers, 1, __ATOMIC_RELEASE);
+	return rc;
+}
+
 void
 d_log_sync(void)
 {
 	int	rc;
 
 	clog_lock();
+	if (mst.async_size != 0)
+		dlog_async_drain(false);
+
 	if (mst.log_buf_nob > 0) /* write back the inflight buffer */
 		d_log_write(NULL, 0, true);
 
@@ -510,8 +790,9 @@ void d_vlog(int flags, const char *fmt, va_list ap)
 	char *b_nopt1hdr;
 	char facstore[16], *facstr;
 	struct timeval tv;
-	struct tm *tm;
+	struct tm *tm, tm_buf;
 	unsigned int hlen_pt1, hlen, mlen, tlen;
+	bool async;
 	/*
 	 * since we ignore any potential errors in CLOG let's always re-set
 	 * errno to its original value
@@ -556,8 +837,12 @@ void d_vlog(int flags, const char *fmt, va_list ap)
 
 	/*
 	 * we must log it, start computing the parts of the log we'll need.
+	 * with asynchronous logging, the message is formatted into a per-thread
+	 * buffer, no need to lock out other threads.
 	 */
-	clog_lock();		/* lock out other threads */
+	async = __atomic_load_n(&mst.async_size, __ATOMIC_RELAXED) != 0;
+	if (!async)
+		clog_lock();	/* lock out other threads */
 	if (d_log_xst.dlog_facs[fac].fac_aname) {
 		facstr = d_log_xst.dlog_facs[fac].fac_aname;
 	} else {
@@ -565,10 +850,11 @@ void d_vlog(int flags, const char *fmt, va_list ap)
 		facstr = facstore;
 	}
 	(void)gettimeofday(&tv, 0);
-	tm = localtime(&tv.tv_sec);
+	tm = localtime_r(&tv.tv_sec, &tm_buf);
 	if (tm == NULL) {
 		dlog_print_err(errno, "localtime returned NULL\n");
-		clog_unlock();
+		if (!async)
+			clog_unlock();
 		return;
 	}
 
@@ -611,7 +897,8 @@ void d_vlog(int flags, const char *fmt, va_list ap)
 	 * check for it anyway.
 	 */
 	if (hlen + 1 >= sizeof(b)) {
-		clog_unlock();	/* drop lock, this is the only early exit */
+		if (!async)
+			clog_unlock(); /* drop lock, the only early exit */
 		dlog_print_err(E2BIG,
 			       "header overflowed %zd byte buffer (%d)\n",
 			       sizeof(b), hlen + 1);
@@ -652,16 +939,22 @@ void d_vlog(int flags, const char *fmt, va_list ap)
 	 */
 	if (mst.flush_pri == DLOG_DBG)
 		flush = true;
+	else if (async) /* the flusher thread writes every interval anyway */
+		flush = lvl >= mst.flush_pri;
 	else
 		flush = (lvl >= mst.flush_pri) || (tv.tv_sec > last_flush);
-	if (flush)
+	if (flush && !async)
 		last_flush = tv.tv_sec;
 
-	rc = d_log_write(b, tlen, flush);
+	if (async) {
+		rc = dlog_async_write(b, tlen, lvl, flush);
+	} else {
+		rc = d_log_write(b, tlen, flush);
+		clog_unlock();	/* drop lock here */
+	}
 	if (rc < 0)
 		errno = save_errno;
 
-	clog_unlock();		/* drop lock here */
 	/*
 	 * log it to stderr and/or stdout.  skip part one of the header
 	 * if the output channel is a tty
@@ -785,6 +1078,7 @@ d_log_open(char *tag, int maxfac_hint, int default_mask, int stderr_mask,
 	char		*env;
 	char		*buffer = NULL;
 	uint64_t	log_size = LOG_SIZE_DEF;
+	uint64_t	async_size = 0;
 	int		pri;
 
 	memset(&mst, 0, sizeof(mst));
@@ -810,6 +1104,19 @@ d_log_open(char *tag, int maxfac_hint, int default_mask, int stderr_mask,
 			log_size = LOG_SIZE_MIN;
 	}
 
+	env = getenv(D_LOG_ASYNC_ENV);
+	if (env != NULL) {
+		async_size = d_getenv_size(env);
+		if (async_size != 0) {
+			/* round up to a power of 2 */
+			uint64_t size = LOG_ASYNC_SIZE_MIN;
+
+			while (size < async_size)
+				size <<= 1;
+			async_size = size;
+		}
+	}
+
 	env = getenv(D_LOG_FILE_APPEND_PID_ENV);
 	if (logfile != NULL && env != NULL) {
 		if (strcmp(env, "0") != 0) {
@@ -929,6 +1236,12 @@ d_log_open(char *tag, int maxfac_hint, int default_mask, int stderr_mask,
 	mst.stdout_isatty = isatty(fileno(stdout));
 	mst.stderr_isatty = isatty(fileno(stderr));
 	d_log_xst.tag = newtag;
+
+	/* asynchronous logging only applies to the log file */
+	if (async_size != 0 && mst.log_fd >= 0 &&
+	    dlog_async_start(async_size) != 0)
+		fprintf(stderr, "d_log_open: cannot start asynchronous "
+			"logging, continuing with synchronous logging.\n");
 	clog_unlock();
 
 	/* ensure buffer+log flush upon exit in case fini routine not
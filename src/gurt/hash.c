@@ -266,6 +266,65 @@ ch_bucket_unlock(struct d_hash_table *htable, uint32_t idx, bool read_only)
 		D_SPIN_UNLOCK(&lock->spin);
 }
 
+/** lock all buckets, e.g. when the key isn't known yet */
+static inline void
+ch_bucket_lock_all(struct d_hash_table *htable)
+{
+	uint32_t	nr = 1U << htable->ht_lock_bits;
+	uint32_t	idx;
+
+	if (htable->ht_feats & D_HASH_FT_NOLOCK)
+		return;
+
+	for (idx = 0; idx < nr; idx++) {
+		ch_bucket_lock(htable, idx, false);
+		if (htable->ht_feats & D_HASH_FT_GLOCK)
+			break;
+	}
+}
+
+static inline void
+ch_bucket_unlock_all(struct d_hash_table *htable)
+{
+	uint32_t	nr = 1U << htable->ht_lock_bits;
+	uint32_t	idx;
+
+	if (htable->ht_feats & D_HASH_FT_NOLOCK)
+		return;
+
+	for (idx = 0; idx < nr; idx++) {
+		ch_bucket_unlock(htable, idx, false);
+		if (htable->ht_feats & D_HASH_FT_GLOCK)
+			break;
+	}
+}
+
+/** convert hash value to the index of its bucket lock */
+static inline uint32_t
+ch_lock_idx(struct d_hash_table *htable, uint32_t hash)
+{
+	return hash & ((1U << htable->ht_lock_bits) - 1);
+}
+
+/**
+ * Convert hash value to its bucket, caller must hold the bucket lock.
+ *
+ * With D_HASH_FT_RESIZE, the records of a lock stripe are either all in the
+ * current buckets or all in the buckets of the ongoing growth, and a bucket
+ * never changes lock stripe because the number of buckets is always a multiple
+ * of the number of locks.
+ */
+static inline struct d_hash_bucket *
+ch_bucket(struct d_hash_table *htable, uint32_t hash)
+{
+	if (htable->ht_rs_buckets != NULL &&
+	    htable->ht_rs_done[ch_lock_idx(htable, hash)])
+		return &htable->ht_rs_buckets[hash &
+					      ((1U << htable->ht_rs_bits) - 1)];
+
+	return &htable->ht_buckets[hash & ((1U << htable->ht_bits) - 1)];
+}
+
 /**
  * wrappers for member functions.
  */
@@ -284,35 +343,31 @@ ch_key_init(struct d_hash_table *htable, d_list_t *link, void *arg)
 }
 
 /**
- * Convert key to hash bucket id.
+ * Convert key to hash value, see ch_lock_idx() and ch_bucket().
  *
  * It calls DJB2 hash if no customized hash function is provided.
  */
 static inline uint32_t
 ch_key_hash(struct d_hash_table *htable, const void *key, unsigned int ksize)
 {
-	uint32_t idx;
-
 	if (htable->ht_ops->hop_key_hash)
-		idx = htable->ht_ops->hop_key_hash(htable, key, ksize);
-	else
-		idx = d_hash_string_u32((const char *)key, ksize);
+		return htable->ht_ops->hop_key_hash(htable, key, ksize);
 
-	return idx & ((1U << htable->ht_bits) - 1);
+	return d_hash_string_u32((const char *)key, ksize);
 }
 
 static inline uint32_t
 ch_rec_hash(struct d_hash_table *htable, d_list_t *link)
 {
-	uint32_t idx = 0;
+	uint32_t hash = 0;
 
 	if (htable->ht_ops->hop_rec_hash)
-		idx = htable->ht_ops->hop_rec_hash(htable, link);
+		hash = htable->ht_ops->hop_rec_hash(htable, link);
 	else
 		D_ASSERT(htable->ht_feats &
 			 (D_HASH_FT_NOLOCK | D_HASH_FT_GLOCK));
 
-	return idx & ((1U << htable->ht_bits) - 1);
+	return hash;
 }
 
 static inline void
@@ -341,6 +396,8 @@ ch_rec_insert(struct d_hash_table *htable, struct d_hash_bucket *bucket,
 	      d_list_t *link)
 {
 	d_list_add(link, &bucket->hb_head);
+	if (htable->ht_feats & D_HASH_FT_RESIZE)
+		__atomic_fetch_add(&htable->ht_nr_recs, 1, __ATOMIC_RELAXED);
 #if D_HASH_DEBUG
 	htable->ht_nr++;
 	if (htable->ht_nr > htable->ht_nr_max)
@@ -376,12 +433,14 @@ static inline void
 ch_rec_delete(struct d_hash_table *htable, d_list_t *link)
 {
 	d_list_del_init(link);
+	if (htable->ht_feats & D_HASH_FT_RESIZE)
+		__atomic_fetch_sub(&htable->ht_nr_recs, 1, __ATOMIC_RELAXED);
 #if D_HASH_DEBUG
 	htable->ht_nr--;
 	if (htable->ht_ops->hop_rec_hash) {
 		struct d_hash_bucket *bucket;
 
-		bucket = &htable->ht_buckets[ch_rec_hash(htable, link)];
+		bucket = ch_bucket(htable, ch_rec_hash(htable, link));
 		bucket->hb_dep--;
 	}
 #endif
@@ -429,6 +488,133 @@ ch_rec_find(struct d_hash_table *htable, struct d_hash_bucket *bucket,
 	return NULL;
 }
 
+/**
+ * D_HASH_FT_RESIZE: start growing the table, records are moved afterwards by
+ * ch_resize_step().
+ */
+static void
+ch_resize_start(struct d_hash_table *htable)
+{
+	struct d_hash_bucket	*buckets;
+	uint32_t		 bits = htable->ht_bits + 1;
+	uint32_t		 nr = 1U << bits;
+	uint32_t		 i;
+
+	if (!__sync_bool_compare_and_swap(&htable->ht_rs_busy, 0, 1))
+		return;
+
+	D_ALLOC_ARRAY(buckets, nr);
+	if (buckets == NULL) {
+		/* keep using current buckets, retry on next insert */
+		__atomic_store_n(&htable->ht_rs_busy, 0, __ATOMIC_RELEASE);
+		return;
+	}
+
+	for (i = 0; i < nr; i++)
+		D_INIT_LIST_HEAD(&buckets[i].hb_head);
+
+	ch_bucket_lock_all(htable);
+	htable->ht_rs_bits = bits;
+	__atomic_store_n(&htable->ht_rs_next, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&htable->ht_rs_moved, 0, __ATOMIC_RELAXED);
+	htable->ht_rs_buckets = buckets;
+	ch_bucket_unlock_all(htable);
+
+	D_DEBUG(DB_TRACE, "Growing hash table %p to %u buckets, %u records\n",
+		htable, nr, htable->ht_nr_recs);
+}
+
+/** D_HASH_FT_RESIZE: switch to the new buckets once all records are moved */
+static void
+ch_resize_finish(struct d_hash_table *htable)
+{
+	struct d_hash_bucket	*buckets;
+
+	ch_bucket_lock_all(htable);
+	buckets = htable->ht_buckets;
+	htable->ht_buckets = htable->ht_rs_buckets;
+	__atomic_store_n(&htable->ht_bits, htable->ht_rs_bits,
+			 __ATOMIC_RELAXED);
+	htable->ht_rs_buckets = NULL;
+	memset(htable->ht_rs_done, 0,
+	       sizeof(*htable->ht_rs_done) << htable->ht_lock_bits);
+	htable->ht_resizes++;
+	ch_bucket_unlock_all(htable);
+
+	D_FREE(buckets);
+	__atomic_store_n(&htable->ht_rs_busy, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * D_HASH_FT_RESIZE: move the records of the next lock stripe to the buckets of
+ * the ongoing growth.
+ */
+static void
+ch_resize_step(struct d_hash_table *htable)
+{
+	struct d_hash_bucket	*bucket;
+	struct d_hash_bucket	*new;
+	d_list_t		*link;
+	uint32_t		 nr_locks = 1U << htable->ht_lock_bits;
+	uint32_t		 nr, idx, i;
+
+	idx = __atomic_fetch_add(&htable->ht_rs_next, 1, __ATOMIC_RELAXED);
+	if (idx >= nr_locks)
+		return;
+
+	ch_bucket_lock(htable, idx, false);
+	if (htable->ht_rs_buckets == NULL || htable->ht_rs_done[idx]) {
+		/* raced with the end of a previous growth */
+		ch_bucket_unlock(htable, idx, false);
+		return;
+	}
+
+	/* buckets idx, idx + nr_locks, idx + 2 * nr_locks... */
+	nr = 1U << htable->ht_bits;
+	for (i = idx; i < nr; i += nr_locks) {
+		bucket = &htable->ht_buckets[i];
+		while (!d_list_empty(&bucket->hb_head)) {
+			/* keep the LRU order */
+			link = bucket->hb_head.next;
+			new = &htable->ht_rs_buckets[ch_rec_hash(htable, link) &
+					((1U << htable->ht_rs_bits) - 1)];
+			d_list_move_tail(link, &new->hb_head);
+		}
+	}
+	htable->ht_rs_done[idx] = true;
+	ch_bucket_unlock(htable, idx, false);
+
+	if (__atomic_add_fetch(&htable->ht_rs_moved, 1, __ATOMIC_ACQ_REL) ==
+	    nr_locks)
+		ch_resize_finish(htable);
+}
+
+/**
+ * D_HASH_FT_RESIZE: called without lock after each insert or find, to make
+ * progress on the ongoing growth or to start one if chains are too long.
+ */
+static inline void
+ch_resize_check(struct d_hash_table *htable)
+{
+	uint32_t bits;
+
+	if (!(htable->ht_feats & D_HASH_FT_RESIZE))
+		return;
+
+	if (__atomic_load_n(&htable->ht_rs_busy, __ATOMIC_ACQUIRE)) {
+		if (__atomic_load_n(&htable->ht_rs_next, __ATOMIC_RELAXED) <
+		    (1U << htable->ht_lock_bits))
+			ch_resize_step(htable);
+		return;
+	}
+
+	bits = __atomic_load_n(&htable->ht_bits, __ATOMIC_RELAXED);
+	if (bits < D_HASH_RESIZE_BITS_MAX &&
+	    __atomic_load_n(&htable->ht_nr_recs, __ATOMIC_RELAXED) >
+	    (D_HASH_RESIZE_LOAD << bits))
+		ch_resize_start(htable);
+}
+
 bool
 d_hash_rec_unlinked(d_list_t *link)
 {
@@ -441,20 +627,22 @@ d_hash_rec_find(struct d_hash_table *htable, const void *key,
 {
 	struct d_hash_bucket	*bucket;
 	d_list_t		*link;
-	uint32_t		 idx;
+	uint32_t		 hash, idx;
 	bool			 is_lru = (htable->ht_feats & D_HASH_FT_LRU);
 
 	D_ASSERT(key != NULL && ksize != 0);
-	idx = ch_key_hash(htable, key, ksize);
-	bucket = &htable->ht_buckets[idx];
+	hash = ch_key_hash(htable, key, ksize);
+	idx = ch_lock_idx(htable, hash);
 
 	ch_bucket_lock(htable, idx, !is_lru);
 
+	bucket = ch_bucket(htable, hash);
 	link = ch_rec_find(htable, bucket, key, ksize, D_HASH_LRU_HEAD);
 	if (link != NULL)
 		ch_rec_addref(htable, link);
 
 	ch_bucket_unlock(htable, idx, !is_lru);
+	ch_resize_check(htable);
 	return link;
 }
 
@@ -464,15 +652,16 @@ d_hash_rec_insert(struct d_hash_table *htable, const void *key,
 {
 	struct d_hash_bucket	*bucket;
 	d_list_t		*tmp;
-	uint32_t		 idx;
+	uint32_t		 hash, idx;
 	int			 rc = 0;
 
 	D_ASSERT(key != NULL && ksize != 0);
-	idx = ch_key_hash(htable, key, ksize);
-	bucket = &htable->ht_buckets[idx];
+	hash = ch_key_hash(htable, key, ksize);
+	idx = ch_lock_idx(htable, hash);
 
 	ch_bucket_lock(htable, idx, false);
 
+	bucket = ch_bucket(htable, hash);
 	if (exclusive) {
 		tmp = ch_rec_find(htable, bucket, key, ksize, D_HASH_LRU_NONE);
 		if (tmp) {
@@ -484,6 +673,8 @@ d_hash_rec_insert(struct d_hash_table *htable, const void *key,
 
 out_unlock:
 	ch_bucket_unlock(htable, idx, false);
+	if (rc == 0)
+		ch_resize_check(htable);
 	return rc;
 }
 
@@ -493,14 +684,15 @@ d_hash_rec_find_insert(struct d_hash_table *htable, const void *key,
 {
 	struct d_hash_bucket	*bucket;
 	d_list_t		*tmp;
-	uint32_t		 idx;
+	uint32_t		 hash, idx;
 
 	D_ASSERT(key != NULL && ksize != 0);
-	idx = ch_key_hash(htable, key, ksize);
-	bucket = &htable->ht_buckets[idx];
+	hash = ch_key_hash(htable, key, ksize);
+	idx = ch_lock_idx(htable, hash);
 
 	ch_bucket_lock(htable, idx, false);
 
+	bucket = ch_bucket(htable, hash);
 	tmp = ch_rec_find(htable, bucket, key, ksize, D_HASH_LRU_HEAD);
 	if (tmp) {
 		ch_rec_addref(htable, tmp);
@@ -511,6 +703,7 @@ d_hash_rec_find_insert(struct d_hash_table *htable, const void *key,
 
 out_unlock:
 	ch_bucket_unlock(htable, idx, false);
+	ch_resize_check(htable);
 	return link;
 }
 
@@ -519,36 +712,21 @@ d_hash_rec_insert_anonym(struct d_hash_table *htable, d_list_t *link,
 			 void *arg)
 {
 	struct d_hash_bucket	*bucket;
-	uint32_t	 idx;
-	uint32_t	 nr = 1U << htable->ht_bits;
-	bool		 need_lock = !(htable->ht_feats & D_HASH_FT_NOLOCK);
 
 	if (htable->ht_ops->hop_key_init == NULL)
 		return -DER_INVAL;
 
-	if (need_lock) {
-		/* Lock all buckets because of unknown key yet */
-		for (idx = 0; idx < nr; idx++) {
-			ch_bucket_lock(htable, idx, false);
-			if (htable->ht_feats & D_HASH_FT_GLOCK)
-				break;
-		}
-	}
+	/* Lock all buckets because of unknown key yet */
+	ch_bucket_lock_all(htable);
 
 	/* has no key, hash table should have provided key generator */
 	ch_key_init(htable, link, arg);
 
-	idx = ch_rec_hash(htable, link);
-	bucket = &htable->ht_buckets[idx];
+	bucket = ch_bucket(htable, ch_rec_hash(htable, link));
 	ch_rec_insert_addref(htable, bucket, link);
 
-	if (need_lock) {
-		for (idx = 0; idx < nr; idx++) {
-			ch_bucket_unlock(htable, idx, false);
-			if (htable->ht_feats & D_HASH_FT_GLOCK)
-				break;
-		}
-	}
+	ch_bucket_unlock_all(htable);
+	ch_resize_check(htable);
 	return 0;
 }
 
@@ -558,16 +736,17 @@ d_hash_rec_delete(struct d_hash_table *htable, const void *key,
 {
 	struct d_hash_bucket	*bucket;
 	d_list_t		*link;
-	uint32_t		 idx;
+	uint32_t		 hash, idx;
 	bool			 deleted = false;
 	bool			 zombie  = false;
 
 	D_ASSERT(key != NULL && ksize != 0);
-	idx = ch_key_hash(htable, key, ksize);
-	bucket = &htable->ht_buckets[idx];
+	hash = ch_key_hash(htable, key, ksize);
+	idx = ch_lock_idx(htable, hash);
 
 	ch_bucket_lock(htable, idx, false);
 
+	bucket = ch_bucket(htable, hash);
 	link = ch_rec_find(htable, bucket, key, ksize, D_HASH_LRU_NONE);
 	if (link != NULL) {
 		zombie  = ch_rec_del_decref(htable, link);
@@ -590,7 +769,7 @@ d_hash_rec_delete_at(struct d_hash_table *htable, d_list_t *link)
 	bool	 need_lock = !(htable->ht_feats & D_HASH_FT_NOLOCK);
 
 	if (need_lock) {
-		idx = ch_rec_hash(htable, link);
+		idx = ch_lock_idx(htable, ch_rec_hash(htable, link));
 		ch_bucket_lock(htable, idx, false);
 	}
 
@@ -613,17 +792,18 @@ d_hash_rec_evict(struct d_hash_table *htable, const void *key,
 {
 	struct d_hash_bucket	*bucket;
 	d_list_t		*link;
-	uint32_t		 idx;
+	uint32_t		 hash, idx;
 
 	if (!(htable->ht_feats & D_HASH_FT_LRU))
 		return false;
 
 	D_ASSERT(key != NULL && ksize != 0);
-	idx = ch_key_hash(htable, key, ksize);
-	bucket = &htable->ht_buckets[idx];
+	hash = ch_key_hash(htable, key, ksize);
+	idx = ch_lock_idx(htable, hash);
 
 	ch_bucket_lock(htable, idx, false);
 
+	bucket = ch_bucket(htable, hash);
 	link = ch_rec_find(htable, bucket, key, ksize, D_HASH_LRU_TAIL);
 
 	ch_bucket_unlock(htable, idx, false);
@@ -634,17 +814,18 @@ bool
 d_hash_rec_evict_at(struct d_hash_table *htable, d_list_t *link)
 {
 	struct d_hash_bucket	*bucket;
-	uint32_t		 idx;
+	uint32_t		 hash, idx;
 	bool			 evicted = false;
 
 	if (!(htable->ht_feats & D_HASH_FT_LRU))
 		return false;
 
-	idx = ch_rec_hash(htable, link);
-	bucket = &htable->ht_buckets[idx];
+	hash = ch_rec_hash(htable, link);
+	idx = ch_lock_idx(htable, hash);
 
 	ch_bucket_lock(htable, idx, false);
 
+	bucket = ch_bucket(htable, hash);
 	if (link != bucket->hb_head.prev) {
 		d_list_move_tail(link, &bucket->hb_head);
 		evicted = true;
@@ -661,7 +842,7 @@ d_hash_rec_addref(struct d_hash_table *htable, d_list_t *link)
 	bool	 need_lock = !(htable->ht_feats & D_HASH_FT_NOLOCK);
 
 	if (need_lock) {
-		idx = ch_rec_hash(htable, link);
+		idx = ch_lock_idx(htable, ch_rec_hash(htable, link));
 		ch_bucket_lock(htable, idx, true);
 	}
 
@@ -680,7 +861,7 @@ d_hash_rec_decref(struct d_hash_table *htable, d_list_t *link)
 	bool	 zombie;
 
 	if (need_lock) {
-		idx = ch_rec_hash(htable, link);
+		idx = ch_lock_idx(htable, ch_rec_hash(htable, link));
 		ch_bucket_lock(htable, idx, !ephemeral);
 	}
 
@@ -707,7 +888,7 @@ d_hash_rec_ndecref(struct d_hash_table *htable, int count, d_list_t *link)
 	int	 rc = 0;
 
 	if (need_lock) {
-		idx = ch_rec_hash(htable, link);
+		idx = ch_lock_idx(htable, ch_rec_hash(htable, link));
 		ch_bucket_lock(htable, idx, !ephemeral);
 	}
 
@@ -770,6 +951,22 @@ d_hash_rec_first(struct d_hash_table *htable)
 	return link;
 }
 
+static void
+ch_locks_destroy(struct d_hash_table *htable, uint32_t nr)
+{
+	uint32_t i;
+
+	for (i = 0; i < nr; i++) {
+		if (htable->ht_feats & D_HASH_FT_MUTEX)
+			D_MUTEX_DESTROY(&htable->ht_locks[i].mutex);
+		else if (htable->ht_feats & D_HASH_FT_RWLOCK)
+			D_RWLOCK_DESTROY(&htable->ht_locks[i].rwlock);
+		else
+			D_SPIN_DESTROY(&htable->ht_locks[i].spin);
+	}
+	D_FREE(htable->ht_locks);
+}
+
 int
 d_hash_table_create_inplace(uint32_t feats, uint32_t bits, void *priv,
 			    d_hash_table_ops_t *hops,
@@ -782,11 +979,20 @@ d_hash_table_create_inplace(uint32_t feats, uint32_t bits, void *priv,
 	D_ASSERT(hops != NULL);
 	D_ASSERT(hops->hop_key_cmp != NULL);
 
+	memset(htable, 0, sizeof(*htable));
 	htable->ht_feats = feats;
 	htable->ht_bits	 = bits;
+	htable->ht_lock_bits = bits;
 	htable->ht_ops	 = hops;
 	htable->ht_priv	 = priv;
 
+	if ((feats & D_HASH_FT_RESIZE) &&
+	    (hops->hop_rec_hash == NULL || (feats & D_HASH_FT_GLOCK))) {
+		D_ERROR("Growing hash table requires hop_rec_hash() and per "
+			"bucket locking.\n");
+		return -DER_INVAL;
+	}
+
 	if (hops->hop_rec_hash == NULL && !(feats & D_HASH_FT_NOLOCK)) {
 		htable->ht_feats |= D_HASH_FT_GLOCK;
 		D_WARN("The d_hash_table_ops_t->hop_rec_hash() callback is "
@@ -801,6 +1007,12 @@ d_hash_table_create_inplace(uint32_t feats, uint32_t bits, void *priv,
 	for (i = 0; i < nr; i++)
 		D_INIT_LIST_HEAD(&htable->ht_buckets[i].hb_head);
 
+	if (htable->ht_feats & D_HASH_FT_RESIZE) {
+		D_ALLOC_ARRAY(htable->ht_rs_done, nr);
+		if (htable->ht_rs_done == NULL)
+			D_GOTO(free_buckets, rc = -DER_NOMEM);
+	}
+
 	if (htable->ht_feats & D_HASH_FT_NOLOCK)
 		D_GOTO(out, rc = 0);
 
@@ -813,11 +1025,11 @@ d_hash_table_create_inplace(uint32_t feats, uint32_t bits, void *priv,
 			rc = D_SPIN_INIT(&htable->ht_lock.spin,
 					 PTHREAD_PROCESS_PRIVATE);
 		if (rc)
-			D_GOTO(free_buckets, rc);
+			D_GOTO(free_done, rc);
 	} else {
 		D_ALLOC_ARRAY(htable->ht_locks, nr);
 		if (htable->ht_locks == NULL)
-			D_GOTO(free_buckets, rc = -DER_NOMEM);
+			D_GOTO(free_done, rc = -DER_NOMEM);
 
 		for (i = 0; i < nr; i++) {
 			if (htable->ht_feats & D_HASH_FT_MUTEX)
@@ -837,16 +1049,10 @@ d_hash_table_create_inplace(uint32_t feats, uint32_t bits, void *priv,
 	D_GOTO(out, rc = 0);
 
 free_locks:
-	while (i > 0) {
-		i--; /* last successful */
-		if (htable->ht_feats & D_HASH_FT_MUTEX)
-			D_MUTEX_DESTROY(&htable->ht_locks[i].mutex);
-		else if (htable->ht_feats & D_HASH_FT_RWLOCK)
-			D_RWLOCK_DESTROY(&htable->ht_locks[i].rwlock);
-		else
-			D_SPIN_DESTROY(&htable->ht_locks[i].spin);
-	}
-	D_FREE(htable->ht_locks);
+	/* destroy the successful ones */
+	ch_locks_destroy(htable, i);
+free_done:
+	D_FREE(htable->ht_rs_done);
 free_buckets:
 	D_FREE(htable->ht_buckets);
 out:
@@ -873,14 +1079,34 @@ out:
 	return rc;
 }
 
+/**
+ * Get the \a nr buckets of lock stripe \a idx, they are (*buckets)[0],
+ * (*buckets)[L], (*buckets)[2 * L]... where L is the number of bucket locks.
+ * Caller must hold the bucket lock.
+ */
+static inline void
+ch_stripe_buckets(struct d_hash_table *htable, uint32_t idx,
+		  struct d_hash_bucket **buckets, uint32_t *nr)
+{
+	uint32_t bits = htable->ht_bits;
+
+	*buckets = htable->ht_buckets;
+	if (htable->ht_rs_buckets != NULL && htable->ht_rs_done[idx]) {
+		*buckets = htable->ht_rs_buckets;
+		bits = htable->ht_rs_bits;
+	}
+	*buckets += idx;
+	*nr = 1U << (bits - htable->ht_lock_bits);
+}
+
 int
 d_hash_table_traverse(struct d_hash_table *htable, d_hash_traverse_cb_t cb,
 		      void *arg)
 {
-	struct d_hash_bucket	*bucket;
+	struct d_hash_bucket	*buckets;
 	d_list_t		*link;
-	uint32_t		 nr = 1U << htable->ht_bits;
-	uint32_t		 idx;
+	uint32_t		 nr_locks = 1U << htable->ht_lock_bits;
+	uint32_t		 idx, i, nr;
 	int			 rc = 0;
 
 	if (htable->ht_buckets == NULL) {
@@ -893,13 +1119,16 @@ d_hash_table_traverse(struct d_hash_table *htable, d_hash_traverse_cb_t cb,
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
-	for (idx = 0; idx < nr && !rc; idx++) {
-		bucket = &htable->ht_buckets[idx];
+	for (idx = 0; idx < nr_locks && !rc; idx++) {
 		ch_bucket_lock(htable, idx, true);
-		d_list_for_each(link, &bucket->hb_head) {
-			rc = cb(link, arg);
-			if (rc)
-				break;
+		ch_stripe_buckets(htable, idx, &buckets, &nr);
+		for (i = 0; i < nr && !rc; i++) {
+			d_list_for_each(link,
+					&buckets[(size_t)i * nr_locks].hb_head) {
+				rc = cb(link, arg);
+				if (rc)
+					break;
+			}
 		}
 		ch_bucket_unlock(htable, idx, true);
 	}
@@ -910,9 +1139,10 @@ out:
 static bool
 d_hash_table_is_empty(struct d_hash_table *htable)
 {
-	uint32_t	 nr = 1U << htable->ht_bits;
-	uint32_t	 idx;
-	bool		 is_empty = true;
+	struct d_hash_bucket	*buckets;
+	uint32_t		 nr_locks = 1U << htable->ht_lock_bits;
+	uint32_t		 idx, i, nr;
+	bool			 is_empty = true;
 
 	if (htable->ht_buckets == NULL) {
 		D_ERROR("d_hash_table %p not initialized (NULL buckets).\n",
@@ -920,9 +1150,12 @@ d_hash_table_is_empty(struct d_hash_table *htable)
 		D_GOTO(out, 0);
 	}
 
-	for (idx = 0; idx < nr && is_empty; idx++) {
+	for (idx = 0; idx < nr_locks && is_empty; idx++) {
 		ch_bucket_lock(htable, idx, true);
-		is_empty = d_list_empty(&htable->ht_buckets[idx].hb_head);
+		ch_stripe_buckets(htable, idx, &buckets, &nr);
+		for (i = 0; i < nr && is_empty; i++)
+			is_empty = d_list_empty(
+				&buckets[(size_t)i * nr_locks].hb_head);
 		ch_bucket_unlock(htable, idx, true);
 	}
 
@@ -934,10 +1167,17 @@ int
 d_hash_table_destroy_inplace(struct d_hash_table *htable, bool force)
 {
 	struct d_hash_bucket	*bucket;
-	uint32_t		 nr = 1U << htable->ht_bits;
+	uint32_t		 nr;
 	uint32_t		 i;
 	int			 rc = 0;
 
+	/* complete the ongoing growth, so that all records are in ht_buckets */
+	while (htable->ht_rs_buckets != NULL) {
+		D_ASSERT(htable->ht_rs_next < (1U << htable->ht_lock_bits));
+		ch_resize_step(htable);
+	}
+
+	nr = 1U << htable->ht_bits;
 	for (i = 0; i < nr; i++) {
 		bucket = &htable->ht_buckets[i];
 		while (!d_list_empty(&bucket->hb_head)) {
@@ -960,18 +1200,11 @@ d_hash_table_destroy_inplace(struct d_hash_table *htable, bool force)
 		else
 			D_SPIN_DESTROY(&htable->ht_lock.spin);
 	} else {
-		for (i = 0; i < nr; i++) {
-			if (htable->ht_feats & D_HASH_FT_MUTEX)
-				D_MUTEX_DESTROY(&htable->ht_locks[i].mutex);
-			else if (htable->ht_feats & D_HASH_FT_RWLOCK)
-				D_RWLOCK_DESTROY(&htable->ht_locks[i].rwlock);
-			else
-				D_SPIN_DESTROY(&htable->ht_locks[i].spin);
-		}
-		D_FREE(htable->ht_locks);
+		ch_locks_destroy(htable, 1U << htable->ht_lock_bits);
 	}
 
 free_buckets:
+	D_FREE(htable->ht_rs_done);
 	D_FREE(htable->ht_buckets);
 	memset(htable, 0, sizeof(*htable));
 out:
@@ -997,6 +1230,37 @@ d_hash_table_debug(struct d_hash_table *htable)
 #endif
 }
 
+void
+d_hash_table_stats(struct d_hash_table *htable, struct d_hash_stats *stats)
+{
+	struct d_hash_bucket	*buckets;
+	d_list_t		*link;
+	uint32_t		 nr_locks = 1U << htable->ht_lock_bits;
+	uint32_t		 idx, i, nr, len;
+
+	memset(stats, 0, sizeof(*stats));
+	for (idx = 0; idx < nr_locks; idx++) {
+		ch_bucket_lock(htable, idx, true);
+		ch_stripe_buckets(htable, idx, &buckets, &nr);
+		for (i = 0; i < nr; i++) {
+			len = 0;
+			d_list_for_each(link,
+					&buckets[(size_t)i * nr_locks].hb_head)
+				len++;
+
+			stats->hs_nr += len;
+			if (len > 0)
+				stats->hs_used++;
+			if (len > stats->hs_chain_max)
+				stats->hs_chain_max = len;
+		}
+		/* the stripe is either in current or in new buckets */
+		stats->hs_buckets += nr;
+		ch_bucket_unlock(htable, idx, true);
+	}
+	stats->hs_resizes = htable->ht_resizes;
+}
+
 /******************************************************************************
  * DAOS Handle Hash Table Wrapper
  *
@@ -1200,8 +1464,6 @@ d_uhash_link_empty(struct d_ulink *ulink)
 void
 d_hhash_link_insert(struct d_hhash *hhash, struct d_hlink *hlink, int type)
 {
-	bool need_lock = !(hhash->ch_htable.ht_feats & D_HASH_FT_NOLOCK);
-
 	D_ASSERT(hlink->hl_link.rl_initialized);
 
 	/* check if handle type fits in allocated bits */
@@ -1211,33 +1473,19 @@ d_hhash_link_insert(struct d_hhash *hhash, struct d_hlink *hlink, int type)
 
 	if (d_hhash_is_ptrtype(hhash)) {
 		uint64_t ptr_key = (uintptr_t)hlink;
-		uint32_t nr = 1U << hhash->ch_htable.ht_bits;
-		uint32_t idx = 0;
 
 		D_ASSERTF(type == D_HTYPE_PTR, "direct/ptr-based htable can "
 			  "only contain D_HTYPE_PTR type entries");
 		D_ASSERTF(d_hhash_key_isptr(ptr_key), "hlink ptr %p is invalid "
 			  "D_HTYPE_PTR type", hlink);
 
-		if (need_lock) {
-			/* Lock all buckets to emulate proper hlink lock */
-			for (idx = 0; idx < nr; idx++) {
-				ch_bucket_lock(&hhash->ch_htable, idx, false);
-				if (hhash->ch_htable.ht_feats & D_HASH_FT_GLOCK)
-					break;
-			}
-		}
+		/* Lock all buckets to emulate proper hlink lock */
+		ch_bucket_lock_all(&hhash->ch_htable);
 
 		ch_rec_addref(&hhash->ch_htable, &hlink->hl_link.rl_link);
 		hlink->hl_key = ptr_key;
 
-		if (need_lock) {
-			for (idx = 0; idx < nr; idx++) {
-				ch_bucket_unlock(&hhash->ch_htable, idx, false);
-				if (hhash->ch_htable.ht_feats & D_HASH_FT_GLOCK)
-					break;
-			}
-		}
+		ch_bucket_unlock_all(&hhash->ch_htable);
 	} else {
 		D_ASSERTF(type != D_HTYPE_PTR, "PTR type key being inserted "
 			  "in a non ptr-based htable.\n");
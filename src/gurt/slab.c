@@ -8,6 +8,7 @@
 
 #include <gurt/debug.h>
 #include <gurt/common.h>
+#include <gurt/atomic.h>
 
 #include "gurt/slab.h"
 
@@ -28,6 +29,365 @@ debug_dump(struct d_slab_type *type)
 		      type->st_op_reset);
 	D_TRACE_DEBUG(DB_ANY, type, "No restock: current %d hwm %d",
 		      type->st_no_restock, type->st_no_restock_hwm);
+	D_TRACE_DEBUG(DB_ANY, type, "Magazines: size %d fill %d flush %d",
+		      type->st_reg.sr_mag_size, type->st_mag_fill,
+		      type->st_mag_flush);
+}
+
+static int
+restock(struct d_slab_type *type, int count);
+
+/* Per-thread cache of descriptors of a type.
+ *
+ * The free list holds descriptors ready for use, the pending list holds
+ * descriptors released by the thread and not yet reset.  The magazine lock
+ * is only contended when d_slab_reclaim() empties all magazines, it can be
+ * taken while holding the type lock but not the other way around.
+ */
+struct d_slab_mag {
+	d_list_t		sm_link;
+	/* Type of the magazine, NULL once the type is destroyed */
+	struct d_slab_type	*sm_type;
+	pthread_spinlock_t	sm_lock;
+	d_list_t		sm_free;
+	d_list_t		sm_pending;
+	int			sm_free_count;
+	int			sm_pending_count;
+	int			sm_reset_count;
+};
+
+/* Magazines of a thread for all types, indexed by st_mag_id.
+ *
+ * A single thread key is used for all slabs so that the number of types
+ * using magazines is not bounded by the number of thread keys.
+ */
+struct d_slab_mag_tls {
+	int			mt_nr;
+	struct d_slab_mag	**mt_mags;
+};
+
+static pthread_once_t	mag_once = PTHREAD_ONCE_INIT;
+static pthread_key_t	mag_key;
+static int		mag_key_rc;
+/* Protects sm_type and sm_link of all magazines, and mag_next_id.  Taken
+ * before the type lock.
+ */
+static pthread_mutex_t	mag_lock = PTHREAD_MUTEX_INITIALIZER;
+static int		mag_next_id;
+
+/* Number of free descriptors of a type, including those cached by magazines.
+ *
+ * This can be called without the type lock, in which case the result is only
+ * approximate.
+ */
+static inline int
+free_count(struct d_slab_type *type)
+{
+	return type->st_free_count + atomic_load_relaxed(&type->st_mag_free_count);
+}
+
+/* Check if a type holds as many free descriptors as it is allowed to */
+static inline bool
+free_full(struct d_slab_type *type)
+{
+	return type->st_reg.sr_max_free_desc != 0 &&
+	       free_count(type) >= type->st_reg.sr_max_free_desc;
+}
+
+/* Move all descriptors of a magazine back to the type lists.
+ *
+ * This function should be called with the type lock held.
+ */
+static void
+mag_drain(struct d_slab_type *type, struct d_slab_mag *mag)
+{
+	D_SPIN_LOCK(&mag->sm_lock);
+	d_list_splice_init(&mag->sm_free, &type->st_free_list);
+	type->st_free_count += mag->sm_free_count;
+	atomic_fetch_sub_relaxed(&type->st_mag_free_count, mag->sm_free_count);
+	mag->sm_free_count = 0;
+	d_list_splice_init(&mag->sm_pending, &type->st_pending_list);
+	type->st_pending_count += mag->sm_pending_count;
+	mag->sm_pending_count = 0;
+	type->st_reset_count += mag->sm_reset_count;
+	type->st_op_reset += mag->sm_reset_count;
+	mag->sm_reset_count = 0;
+	D_SPIN_UNLOCK(&mag->sm_lock);
+}
+
+/* Thread exit destructor of the magazines of a thread */
+static void
+mag_tls_free(void *arg)
+{
+	struct d_slab_mag_tls	*tls = arg;
+	int			i;
+
+	for (i = 0; i < tls->mt_nr; i++) {
+		struct d_slab_mag	*mag = tls->mt_mags[i];
+		struct d_slab_type	*type;
+
+		if (!mag)
+			continue;
+
+		D_MUTEX_LOCK(&mag_lock);
+		type = mag->sm_type;
+		if (type) {
+			D_MUTEX_LOCK(&type->st_lock);
+			mag_drain(type, mag);
+			d_list_del(&mag->sm_link);
+			D_MUTEX_UNLOCK(&type->st_lock);
+		}
+		D_MUTEX_UNLOCK(&mag_lock);
+
+		D_SPIN_DESTROY(&mag->sm_lock);
+		D_FREE(mag);
+	}
+	D_FREE(tls->mt_mags);
+	D_FREE(tls);
+}
+
+static void
+mag_key_create(void)
+{
+	mag_key_rc = pthread_key_create(&mag_key, mag_tls_free);
+}
+
+/* Return the magazine array of the calling thread, with room for the
+ * magazine of a type, creating or extending it as needed.
+ */
+static struct d_slab_mag_tls *
+mag_tls_get(struct d_slab_type *type)
+{
+	struct d_slab_mag_tls	*tls;
+	struct d_slab_mag	**mags;
+	int			nr;
+	int			rc;
+
+	tls = pthread_getspecific(mag_key);
+	if (!tls) {
+		D_ALLOC_PTR(tls);
+		if (!tls)
+			return NULL;
+
+		rc = pthread_setspecific(mag_key, tls);
+		if (rc != 0) {
+			D_TRACE_ERROR(type, "Failed to set magazines %d %s",
+				      rc, strerror(rc));
+			D_FREE(tls);
+			return NULL;
+		}
+	}
+
+	if (type->st_mag_id < tls->mt_nr)
+		return tls;
+
+	nr = max(type->st_mag_id + 1, tls->mt_nr * 2);
+	D_REALLOC_ARRAY(mags, tls->mt_mags, tls->mt_nr, nr);
+	if (!mags)
+		return NULL;
+	tls->mt_mags = mags;
+	tls->mt_nr = nr;
+
+	return tls;
+}
+
+/* Return the magazine of the calling thread, creating it on first use */
+static struct d_slab_mag *
+mag_get(struct d_slab_type *type)
+{
+	struct d_slab_mag_tls	*tls;
+	struct d_slab_mag	*mag;
+	int			rc;
+
+	tls = pthread_getspecific(mag_key);
+	if (tls && type->st_mag_id < tls->mt_nr && tls->mt_mags[type->st_mag_id])
+		return tls->mt_mags[type->st_mag_id];
+
+	tls = mag_tls_get(type);
+	if (!tls)
+		return NULL;
+
+	D_ALLOC_PTR(mag);
+	if (!mag)
+		return NULL;
+
+	rc = D_SPIN_INIT(&mag->sm_lock, PTHREAD_PROCESS_PRIVATE);
+	if (rc != -DER_SUCCESS) {
+		D_FREE(mag);
+		return NULL;
+	}
+
+	mag->sm_type = type;
+	D_INIT_LIST_HEAD(&mag->sm_free);
+	D_INIT_LIST_HEAD(&mag->sm_pending);
+
+	D_MUTEX_LOCK(&type->st_lock);
+	d_list_add_tail(&mag->sm_link, &type->st_mag_list);
+	D_MUTEX_UNLOCK(&type->st_lock);
+
+	tls->mt_mags[type->st_mag_id] = mag;
+
+	return mag;
+}
+
+/* Reset the descriptors released by this thread so they can be reused.
+ *
+ * This stops once the type holds max_free_desc free descriptors, counting
+ * those of all magazines.  Returns the number of descriptors which failed
+ * reset and were freed.
+ * This function should be called with the magazine lock held.
+ */
+static int
+mag_reuse(struct d_slab_type *type, struct d_slab_mag *mag)
+{
+	d_list_t *entry, *enext;
+	int failed = 0;
+
+	d_list_for_each_safe(entry, enext, &mag->sm_pending) {
+		void *ptr = (void *)entry - type->st_reg.sr_offset;
+		bool rcb = true;
+
+		if (free_full(type))
+			break;
+
+		d_list_del(entry);
+		mag->sm_pending_count--;
+
+		if (type->st_reg.sr_reset) {
+			mag->sm_reset_count++;
+			rcb = type->st_reg.sr_reset(ptr);
+		}
+		if (rcb) {
+			d_list_add_tail(entry, &mag->sm_free);
+			mag->sm_free_count++;
+			atomic_fetch_add_relaxed(&type->st_mag_free_count, 1);
+		} else {
+			D_TRACE_INFO(ptr, "entry %p failed reset", ptr);
+			D_FREE(ptr);
+			failed++;
+		}
+	}
+	return failed;
+}
+
+/* Take a descriptor from the magazine free list.
+ *
+ * This function should be called with the magazine lock held.
+ */
+static void *
+mag_pop(struct d_slab_type *type, struct d_slab_mag *mag)
+{
+	d_list_t *entry;
+
+	if (d_list_empty(&mag->sm_free))
+		return NULL;
+
+	entry = mag->sm_free.next;
+	d_list_del(entry);
+	entry->next = NULL;
+	entry->prev = NULL;
+	mag->sm_free_count--;
+	atomic_fetch_sub_relaxed(&type->st_mag_free_count, 1);
+	return (void *)entry - type->st_reg.sr_offset;
+}
+
+/* Acquire a descriptor from the magazine of the calling thread.
+ *
+ * Once the magazine is empty it is refilled with the descriptors previously
+ * released by the thread, or else with a batch from the type free list.
+ * Returns NULL if there are no free descriptors, in which case the caller
+ * should create one.
+ */
+static void *
+mag_acquire(struct d_slab_type *type)
+{
+	struct d_slab_mag	*mag;
+	d_list_t		batch;
+	void			*ptr;
+	int			failed = 0;
+	int			nr = 0;
+
+	mag = mag_get(type);
+	if (!mag)
+		return NULL;
+
+	D_SPIN_LOCK(&mag->sm_lock);
+	if (mag->sm_free_count == 0)
+		failed = mag_reuse(type, mag);
+	ptr = mag_pop(type, mag);
+	D_SPIN_UNLOCK(&mag->sm_lock);
+
+	if (ptr && !failed)
+		return ptr;
+
+	D_INIT_LIST_HEAD(&batch);
+	D_MUTEX_LOCK(&type->st_lock);
+	type->st_count -= failed;
+	if (!ptr) {
+		type->st_op_reset += restock(type, type->st_reg.sr_mag_size);
+		while (nr < type->st_reg.sr_mag_size &&
+		       !d_list_empty(&type->st_free_list)) {
+			d_list_move_tail(type->st_free_list.next, &batch);
+			nr++;
+		}
+		type->st_free_count -= nr;
+		if (nr)
+			type->st_mag_fill++;
+	}
+	D_MUTEX_UNLOCK(&type->st_lock);
+
+	if (nr == 0)
+		return ptr;
+
+	D_SPIN_LOCK(&mag->sm_lock);
+	d_list_splice_init(&batch, &mag->sm_free);
+	mag->sm_free_count += nr;
+	atomic_fetch_add_relaxed(&type->st_mag_free_count, nr);
+	ptr = mag_pop(type, mag);
+	D_SPIN_UNLOCK(&mag->sm_lock);
+
+	return ptr;
+}
+
+/* Release a descriptor to the magazine of the calling thread.
+ *
+ * Once the magazine holds more than sr_mag_size released descriptors they are
+ * all moved to the type pending list, to be reset by restock.  Returns false
+ * if the thread has no magazine, in which case the caller should release the
+ * descriptor to the type.
+ */
+static bool
+mag_release(struct d_slab_type *type, d_list_t *entry)
+{
+	struct d_slab_mag	*mag;
+	d_list_t		batch;
+	int			nr = 0;
+
+	mag = mag_get(type);
+	if (!mag)
+		return false;
+
+	D_INIT_LIST_HEAD(&batch);
+	D_SPIN_LOCK(&mag->sm_lock);
+	d_list_add_tail(entry, &mag->sm_pending);
+	mag->sm_pending_count++;
+	if (mag->sm_pending_count > type->st_reg.sr_mag_size) {
+		d_list_splice_init(&mag->sm_pending, &batch);
+		nr = mag->sm_pending_count;
+		mag->sm_pending_count = 0;
+	}
+	D_SPIN_UNLOCK(&mag->sm_lock);
+
+	if (nr == 0)
+		return true;
+
+	D_MUTEX_LOCK(&type->st_lock);
+	d_list_splice_init(&batch, &type->st_pending_list);
+	type->st_pending_count += nr;
+	type->st_mag_flush++;
+	D_MUTEX_UNLOCK(&type->st_lock);
+
+	return true;
 }
 
 /* Create a data slab manager */
@@ -74,6 +434,19 @@ d_slab_destroy(struct d_slab *slab)
 					st_type_list))) {
 		if (type->st_count != 0)
 			D_TRACE_WARN(type, "Freeing type with active objects");
+		if (type->st_reg.sr_mag_size) {
+			struct d_slab_mag *mag;
+
+			/* The magazines are freed when their thread exits */
+			D_MUTEX_LOCK(&mag_lock);
+			D_MUTEX_LOCK(&type->st_lock);
+			while ((mag = d_list_pop_entry(&type->st_mag_list,
+						       struct d_slab_mag,
+						       sm_link)))
+				mag->sm_type = NULL;
+			D_MUTEX_UNLOCK(&type->st_lock);
+			D_MUTEX_UNLOCK(&mag_lock);
+		}
 		rc = pthread_mutex_destroy(&type->st_lock);
 		if (rc != 0)
 			D_TRACE_ERROR(type, "Failed to destroy lock %d %s",
@@ -103,10 +476,9 @@ restock(struct d_slab_type *type, int count)
 	if (type->st_free_count >= count)
 		return 0;
 
-	if (type->st_reg.sr_max_free_desc != 0 &&
-	    type->st_free_count >= type->st_reg.sr_max_free_desc) {
+	if (free_full(type)) {
 		D_TRACE_DEBUG(DB_ANY, type, "free_count %d, max_free_desc %d, "
-			      "cannot append.", type->st_free_count,
+			      "cannot append.", free_count(type),
 			      type->st_reg.sr_max_free_desc);
 		return 0;
 	}
@@ -137,8 +509,7 @@ restock(struct d_slab_type *type, int count)
 		if (type->st_free_count == count)
 			return reset_calls;
 
-		if (type->st_reg.sr_max_free_desc != 0 &&
-		    type->st_free_count >= type->st_reg.sr_max_free_desc)
+		if (free_full(type))
 			return reset_calls;
 	}
 	return reset_calls;
@@ -157,30 +528,43 @@ d_slab_reclaim(struct d_slab *slab)
 
 	D_MUTEX_LOCK(&slab->slab_lock);
 	d_list_for_each_entry(type, &slab->slab_list, st_type_list) {
+		struct d_slab_mag *mag;
 		d_list_t *entry, *enext;
 
 		D_TRACE_DEBUG(DB_ANY, type, "Resetting type");
 
 		D_MUTEX_LOCK(&type->st_lock);
 
+		/* Collect the objects cached by all threads */
+		d_list_for_each_entry(mag, &type->st_mag_list, sm_link)
+			mag_drain(type, mag);
+
 		/* Reclaim any pending objects.  Count here just needs to be
 		 * larger than pending_count + free_count however simply
 		 * using count is adequate as is guaranteed to be larger.
+		 * Restock stops at max_free_desc, so repeat until it has no
+		 * more objects to free.
 		 */
-		restock(type, type->st_count);
-
-		d_list_for_each_safe(entry, enext, &type->st_free_list) {
-			void *ptr = (void *)entry - type->st_reg.sr_offset;
-
-			if (type->st_reg.sr_release) {
-				type->st_reg.sr_release(ptr);
-				type->st_release_count++;
+		while (true) {
+			restock(type, type->st_count);
+			if (d_list_empty(&type->st_free_list))
+				break;
+
+			d_list_for_each_safe(entry, enext,
+					     &type->st_free_list) {
+				void *ptr = (void *)entry -
+					    type->st_reg.sr_offset;
+
+				if (type->st_reg.sr_release) {
+					type->st_reg.sr_release(ptr);
+					type->st_release_count++;
+				}
+
+				d_list_del(entry);
+				D_FREE(ptr);
+				type->st_free_count--;
+				type->st_count--;
 			}
-
-			d_list_del(entry);
-			D_FREE(ptr);
-			type->st_free_count--;
-			type->st_count--;
 		}
 		D_TRACE_DEBUG(DB_ANY, type, "%d in use", type->st_count);
 		if (type->st_count) {
@@ -237,8 +621,7 @@ create_many(struct d_slab_type *type)
 		void *ptr;
 		d_list_t *entry;
 
-		if (type->st_reg.sr_max_free_desc != 0 &&
-		    type->st_free_count >= type->st_reg.sr_max_free_desc)
+		if (free_full(type))
 			break;
 
 		ptr = create(type);
@@ -276,11 +659,26 @@ d_slab_register(struct d_slab *slab, struct d_slab_reg *reg)
 
 	D_INIT_LIST_HEAD(&type->st_free_list);
 	D_INIT_LIST_HEAD(&type->st_pending_list);
+	D_INIT_LIST_HEAD(&type->st_mag_list);
 	type->st_slab = slab;
 
 	type->st_count = 0;
 	type->st_reg = *reg;
 
+	/* Run without magazines if the thread key cannot be created */
+	if (type->st_reg.sr_mag_size) {
+		pthread_once(&mag_once, mag_key_create);
+		if (mag_key_rc != 0) {
+			D_TRACE_INFO(type, "Not using magazines %d %s",
+				     mag_key_rc, strerror(mag_key_rc));
+			type->st_reg.sr_mag_size = 0;
+		} else {
+			D_MUTEX_LOCK(&mag_lock);
+			type->st_mag_id = mag_next_id++;
+			D_MUTEX_UNLOCK(&mag_lock);
+		}
+	}
+
 	create_many(type);
 
 	if (type->st_free_count == 0) {
@@ -318,6 +716,14 @@ d_slab_acquire(struct d_slab_type *type)
 	d_list_t	*entry;
 	bool		at_limit = false;
 
+	if (type->st_reg.sr_mag_size) {
+		ptr = mag_acquire(type);
+		if (ptr) {
+			D_TRACE_DEBUG(DB_ANY, type, "Using %p", ptr);
+			return ptr;
+		}
+	}
+
 	D_MUTEX_LOCK(&type->st_lock);
 
 	type->st_no_restock++;
@@ -368,6 +774,9 @@ d_slab_release(struct d_slab_type *type, void *ptr)
 	d_list_t *entry = ptr + type->st_reg.sr_offset;
 
 	D_TRACE_DOWN(DB_ANY, ptr);
+	if (type->st_reg.sr_mag_size && mag_release(type, entry))
+		return;
+
 	D_MUTEX_LOCK(&type->st_lock);
 	type->st_pending_count++;
 	d_list_add_tail(entry, &type->st_pending_list);
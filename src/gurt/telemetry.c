@@ -1490,21 +1490,32 @@ void
 d_tm_compute_histogram(struct d_tm_node_t *node, uint64_t value)
 {
 	struct d_tm_histogram_t	*dtm_histogram;
-	struct d_tm_node_t	*bucket;
-	int			i;
+	struct d_tm_bucket_t	*buckets;
+	int			lo, hi, mid;
 
 	if (!node || !node->dtn_metric || !node->dtn_metric->dtm_histogram)
 		return;
 
 	dtm_histogram = node->dtn_metric->dtm_histogram;
+	buckets = dtm_histogram->dth_buckets;
+	if (dtm_histogram->dth_num_buckets <= 0)
+		return;
 
-	for (i = 0; i < dtm_histogram->dth_num_buckets; i++) {
-		if (value <= dtm_histogram->dth_buckets[i].dtb_max) {
-			bucket = dtm_histogram->dth_buckets[i].dtb_bucket;
-			d_tm_inc_counter(bucket, 1);
-			break;
-		}
+	/* Buckets are sorted by dtb_max, find the first one covering value */
+	lo = 0;
+	hi = dtm_histogram->dth_num_buckets - 1;
+	if (value > buckets[hi].dtb_max)
+		return;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (value <= buckets[mid].dtb_max)
+			hi = mid;
+		else
+			lo = mid + 1;
 	}
+
+	d_tm_inc_counter(buckets[lo].dtb_bucket, 1);
 }
 
 static void
@@ -2755,6 +2766,88 @@ d_tm_get_bucket_range(struct d_tm_context *ctx, struct d_tm_bucket_t *bucket,
 	return DER_SUCCESS;
 }
 
+/**
+ * Estimates the given quantile of the samples recorded by the histogram of
+ * a gauge or duration node. The value is linearly interpolated inside the
+ * bucket holding the quantile; for the last, open-ended bucket the lower
+ * bound of the bucket is reported.
+ *
+ * \param[in]	ctx		Client context
+ * \param[out]	val		The estimated quantile value
+ * \param[in]	quantile	Quantile to estimate, in (0, 1], e.g. 0.99
+ * \param[in]	node		Pointer to the metric node with a
+ *				histogram.
+ *
+ * \return	DER_SUCCESS		Success, \a val is 0 if no samples
+ *		-DER_INVAL		node, val or quantile is invalid.
+ *		-DER_METRIC_NOT_FOUND	The metric node, the
+ *					metric data, histogram
+ *					or bucket data was
+ *					not found.
+ *		-DER_OP_NOT_PERMITTED	Node was not a gauge
+ *					or duration with
+ *					an associated histogram.
+ */
+int
+d_tm_get_quantile(struct d_tm_context *ctx, uint64_t *val, double quantile,
+		  struct d_tm_node_t *node)
+{
+	struct d_tm_histogram_t	 histogram;
+	struct d_tm_bucket_t	 bucket;
+	uint64_t		*counts;
+	uint64_t		 total = 0, rank, before = 0;
+	int			 i, rc;
+
+	if (val == NULL || quantile <= 0 || quantile > 1)
+		return -DER_INVAL;
+
+	rc = d_tm_get_num_buckets(ctx, &histogram, node);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_ARRAY(counts, histogram.dth_num_buckets);
+	if (counts == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < histogram.dth_num_buckets; i++) {
+		rc = d_tm_get_bucket_range(ctx, &bucket, i, node);
+		if (rc != 0)
+			goto out;
+		rc = d_tm_get_counter(ctx, &counts[i], bucket.dtb_bucket);
+		if (rc != 0)
+			goto out;
+		total += counts[i];
+	}
+
+	*val = 0;
+	if (total == 0)
+		goto out;
+
+	rank = (uint64_t)ceil(quantile * total);
+	if (rank == 0)
+		rank = 1;
+
+	for (i = 0; i < histogram.dth_num_buckets; i++) {
+		if (before + counts[i] >= rank)
+			break;
+		before += counts[i];
+	}
+	D_ASSERT(i < histogram.dth_num_buckets);
+
+	rc = d_tm_get_bucket_range(ctx, &bucket, i, node);
+	if (rc != 0)
+		goto out;
+
+	if (bucket.dtb_max == UINT64_MAX)
+		*val = bucket.dtb_min;
+	else
+		*val = bucket.dtb_min + (bucket.dtb_max - bucket.dtb_min) *
+		       (rank - before) / counts[i];
+out:
+	D_FREE(counts);
+	return rc;
+}
+
 /**
  * Read the specified counter.
  *
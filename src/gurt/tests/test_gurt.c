@@ -21,6 +21,7 @@
 #include <gurt/dlog.h>
 #include <gurt/hash.h>
 #include <gurt/atomic.h>
+#include <gurt/slab.h>
 
 /* machine epsilon */
 #define EPSILON (1.0E-16)
@@ -1004,6 +1005,10 @@ test_gurt_hash_empty(void **state)
 	test_gurt_hash_free_items(entries, TEST_GURT_HASH_NUM_ENTRIES);
 }
 
+static d_hash_table_ops_t th_ops_nohash = {
+	.hop_key_cmp	= test_gurt_hash_op_key_cmp,
+};
+
 static d_hash_table_ops_t th_ops_ref = {
 	.hop_key_cmp		= test_gurt_hash_op_key_cmp,
 	.hop_rec_hash		= test_gurt_hash_op_rec_hash,
@@ -1099,6 +1104,76 @@ test_gurt_hash_insert_lookup_delete(void **state)
 	test_gurt_hash_free_items(entries, TEST_GURT_HASH_NUM_ENTRIES);
 }
 
+/* Check that a D_HASH_FT_RESIZE table grows and keeps all its entries */
+static void
+test_gurt_hash_resize(void **state)
+{
+	struct d_hash_table	 *thtab;
+	struct d_hash_stats	  stats;
+	struct test_hash_entry	**entries;
+	d_list_t		 *test;
+	int			  expected_count;
+	int			  rc;
+	int			  i;
+
+	entries = test_gurt_hash_alloc_items(TEST_GURT_HASH_NUM_ENTRIES);
+	assert_non_null(entries);
+
+	/* Growth requires hop_rec_hash() */
+	rc = d_hash_table_create(D_HASH_FT_RESIZE, 1, NULL, &th_ops_nohash,
+				 &thtab);
+	assert_int_equal(rc, -DER_INVAL);
+
+	/* Start with a minimum-size hash table */
+	rc = d_hash_table_create(D_HASH_FT_RESIZE, 1, NULL, &th_ops, &thtab);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < TEST_GURT_HASH_NUM_ENTRIES; i++) {
+		rc = d_hash_rec_insert(thtab, entries[i]->tl_key,
+				       TEST_GURT_HASH_KEY_LEN,
+				       &entries[i]->tl_link, 1);
+		assert_int_equal(rc, 0);
+
+		/* lookups must succeed while the records are being moved */
+		test = d_hash_rec_find(thtab, entries[i / 2]->tl_key,
+				       TEST_GURT_HASH_KEY_LEN);
+		assert_int_equal(test, &entries[i / 2]->tl_link);
+	}
+
+	d_hash_table_stats(thtab, &stats);
+	assert_int_equal(stats.hs_nr, TEST_GURT_HASH_NUM_ENTRIES);
+	assert_true(stats.hs_resizes > 0);
+	assert_true(stats.hs_buckets > 2);
+	assert_true(stats.hs_used <= stats.hs_buckets);
+	assert_true(stats.hs_chain_max > 0);
+
+	expected_count = TEST_GURT_HASH_NUM_ENTRIES;
+	rc = d_hash_table_traverse(thtab, test_gurt_hash_traverse_count_cb,
+				   &expected_count);
+	assert_int_equal(rc, 0);
+	assert_int_equal(expected_count, 0);
+
+	for (i = 0; i < TEST_GURT_HASH_NUM_ENTRIES; i++) {
+		rc = d_hash_rec_insert(thtab, entries[i]->tl_key,
+				       TEST_GURT_HASH_KEY_LEN,
+				       &entries[i]->tl_link, 1);
+		assert_int_equal(rc, -DER_EXIST);
+	}
+
+	for (i = 0; i < TEST_GURT_HASH_NUM_ENTRIES; i++)
+		assert_true(d_hash_rec_delete(thtab, entries[i]->tl_key,
+					      TEST_GURT_HASH_KEY_LEN));
+
+	d_hash_table_stats(thtab, &stats);
+	assert_int_equal(stats.hs_nr, 0);
+	assert_int_equal(stats.hs_used, 0);
+
+	rc = d_hash_table_destroy(thtab, 0);
+	assert_int_equal(rc, 0);
+
+	test_gurt_hash_free_items(entries, TEST_GURT_HASH_NUM_ENTRIES);
+}
+
 /* Check that addref/decref work with D_HASH_FT_EPHEMERAL
  */
 static void
@@ -1943,6 +2018,93 @@ test_gurt_atomic(void **state)
 	assert(mix  == 123456);
 }
 
+/* More slab types with magazines than the usual PTHREAD_KEYS_MAX */
+#define SLAB_MAG_TYPES		1100
+#define SLAB_MAG_SIZE		4
+#define SLAB_MAG_MAX_FREE	8
+#define SLAB_MAG_DESCS		32
+
+struct test_slab_desc {
+	d_list_t	tsd_link;
+	int		tsd_val;
+};
+
+static void
+slab_mag_cycle(struct d_slab_type *type)
+{
+	struct test_slab_desc	*descs[SLAB_MAG_DESCS];
+	int			 loop;
+	int			 i;
+
+	for (loop = 0; loop < 4; loop++) {
+		for (i = 0; i < SLAB_MAG_DESCS; i++) {
+			descs[i] = d_slab_acquire(type);
+			assert_non_null(descs[i]);
+		}
+		for (i = 0; i < SLAB_MAG_DESCS; i++)
+			d_slab_release(type, descs[i]);
+		d_slab_restock(type);
+	}
+}
+
+static void *
+slab_mag_thread(void *arg)
+{
+	slab_mag_cycle(arg);
+	return NULL;
+}
+
+static void
+test_gurt_slab_mag(void **state)
+{
+	struct d_slab		 slab;
+	struct d_slab_reg	 reg = { POOL_TYPE_INIT(test_slab_desc, tsd_link)
+					 .sr_max_free_desc = SLAB_MAG_MAX_FREE,
+					 .sr_mag_size = SLAB_MAG_SIZE };
+	struct d_slab_type	**types;
+	pthread_t		 thread;
+	int			 i;
+	int			 rc;
+
+	rc = d_slab_init(&slab, NULL);
+	assert_int_equal(rc, 0);
+
+	D_ALLOC_ARRAY(types, SLAB_MAG_TYPES);
+	assert_non_null(types);
+
+	/* Magazines do not use one thread key per type */
+	for (i = 0; i < SLAB_MAG_TYPES; i++) {
+		types[i] = d_slab_register(&slab, &reg);
+		assert_non_null(types[i]);
+		assert_int_equal(types[i]->st_reg.sr_mag_size, SLAB_MAG_SIZE);
+	}
+
+	slab_mag_cycle(types[0]);
+	slab_mag_cycle(types[SLAB_MAG_TYPES - 1]);
+
+	/* Free descriptors in magazines count against max_free_desc */
+	for (i = 0; i < SLAB_MAG_TYPES; i++)
+		assert_true(types[i]->st_free_count +
+			    types[i]->st_mag_free_count <= SLAB_MAG_MAX_FREE);
+
+	/* The magazine of an exiting thread goes back to the type */
+	rc = pthread_create(&thread, NULL, slab_mag_thread, types[0]);
+	assert_int_equal(rc, 0);
+	rc = pthread_join(thread, NULL);
+	assert_int_equal(rc, 0);
+	assert_true(types[0]->st_free_count + types[0]->st_mag_free_count <=
+		    SLAB_MAG_MAX_FREE);
+
+	assert_false(d_slab_reclaim(&slab));
+	for (i = 0; i < SLAB_MAG_TYPES; i++) {
+		assert_int_equal(types[i]->st_count, 0);
+		assert_int_equal(types[i]->st_mag_free_count, 0);
+	}
+
+	d_slab_destroy(&slab);
+	D_FREE(types);
+}
+
 static void
 check_string_buffer(struct d_string_buffer_t *str_buf, int str_size,
 		    int buf_size, const char *test_str)
@@ -2131,12 +2293,14 @@ main(int argc, char **argv)
 		cmocka_unit_test(test_log),
 		cmocka_unit_test(test_gurt_hash_empty),
 		cmocka_unit_test(test_gurt_hash_insert_lookup_delete),
+		cmocka_unit_test(test_gurt_hash_resize),
 		cmocka_unit_test(test_gurt_hash_decref),
 		cmocka_unit_test(test_gurt_alloc),
 		cmocka_unit_test(test_gurt_hash_parallel_same_operations),
 		cmocka_unit_test(test_gurt_hash_parallel_different_operations),
 		cmocka_unit_test(test_gurt_hash_parallel_refcounting),
 		cmocka_unit_test(test_gurt_atomic),
+		cmocka_unit_test(test_gurt_slab_mag),
 		cmocka_unit_test(test_gurt_string_buffer),
 		cmocka_unit_test(test_hash_perf),
 	};
@@ -370,6 +370,38 @@ check_histogram_m1_stats(char *path)
 	check_bucket_counter(path, 9, 1);
 }
 
+static void
+check_histogram_m1_quantiles(char *path)
+{
+	struct d_tm_node_t	*gauge;
+	uint64_t		 val;
+	int			 rc;
+
+	gauge = d_tm_find_metric(cli_ctx, path);
+	assert_non_null(gauge);
+
+	/* 15 samples, 2nd one is in bucket 0 [0 .. 4] of 3 samples */
+	rc = d_tm_get_quantile(cli_ctx, &val, 0.1, gauge);
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(val, 2);
+
+	/* 8th sample is the last one of bucket 1 [5 .. 9] */
+	rc = d_tm_get_quantile(cli_ctx, &val, 0.5, gauge);
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(val, 9);
+
+	/* Last sample is in the open-ended bucket 9 [45 .. max] */
+	rc = d_tm_get_quantile(cli_ctx, &val, 0.99, gauge);
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(val, 45);
+
+	rc = d_tm_get_quantile(cli_ctx, &val, 0, gauge);
+	assert_rc_equal(rc, -DER_INVAL);
+
+	rc = d_tm_get_quantile(cli_ctx, &val, 1.5, gauge);
+	assert_rc_equal(rc, -DER_INVAL);
+}
+
 static void
 check_bucket_metadata(struct d_tm_node_t *node, int bucket_id)
 {
@@ -505,6 +537,7 @@ test_gauge_with_histogram_multiplier_1(void **state)
 	/* Verify result data */
 	check_histogram_m1_data(path);
 	check_histogram_m1_stats(path);
+	check_histogram_m1_quantiles(path);
 	check_histogram_metadata(path);
 }
 
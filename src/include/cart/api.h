@@ -105,6 +105,26 @@ crt_context_create(crt_context_t *crt_ctx);
 int
 crt_context_set_timeout(crt_context_t crt_ctx, uint32_t timeout_sec);
 
+/**
+ * Set the busy-poll budget of crt_progress() on the specified context.
+ *
+ * With a non-zero budget, crt_progress() called with a non-zero timeout first
+ * polls the network w/o blocking for up to \a spin_us micro-seconds when RPCs
+ * are in flight or the context was recently active, and only then blocks for
+ * the remaining timeout. This trades CPU for lower latency on busy contexts.
+ *
+ * This is an optional function. The default budget comes from the
+ * CRT_PROGRESS_SPIN_US environment variable (zero, i.e. disabled, if unset).
+ *
+ * \param[in] crt_ctx          CaRT context
+ * \param[in] spin_us          busy-poll budget in micro-seconds, zero
+ *                             disables busy-polling.
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_context_set_spin(crt_context_t crt_ctx, uint32_t spin_us);
+
 /**
  * Destroy CRT transport context.
  *
@@ -407,6 +427,22 @@ crt_req_dst_rank_get(crt_rpc_t *req, d_rank_t *rank);
 int
 crt_req_dst_tag_get(crt_rpc_t *req, uint32_t *tag);
 
+/**
+ * Return the trace context of a sampled RPC (see CRT_TRACE_SAMPLE). The
+ * trace ID is the RPC ID assigned by the originator, so spans recorded by the
+ * client and by the server for the same request share it.
+ *
+ * \param[in] req              Pointer to RPC request
+ * \param[out] trace_id        Returned trace ID, 0 if the RPC is not traced
+ * \param[out] start_us        Optional, returned send time on the origin or
+ *                             arrival time on the target (d_timeus_secdiff)
+ *
+ * \return                     DER_SUCCESS on success or error
+ *                             on failure
+ */
+int
+crt_req_trace_get(crt_rpc_t *req, uint64_t *trace_id, uint64_t *start_us);
+
 /**
  * Return reply buffer
  *
@@ -688,6 +724,12 @@ crt_ep_abort(crt_endpoint_t *ep);
 #define CRT_PTR		(1)
 #define CRT_ARRAY	(2)
 #define CRT_RAW		(3)
+/**
+ * Array of plain data elements, packed with a single copy instead of calling
+ * the element proc function for each entry. The elements need no allocation
+ * or free of their own, and their encoding is their memory layout.
+ */
+#define CRT_RAW_ARRAY	(4)
 
 #define CRT_GEN_GET_TYPE(seq) BOOST_PP_SEQ_ELEM(0, seq)
 #define CRT_GEN_GET_NAME(seq) BOOST_PP_SEQ_ELEM(1, seq)
@@ -703,9 +745,13 @@ crt_ep_abort(crt_endpoint_t *ep);
 #define CRT_GEN_X3(x) CRT_GEN_X BOOST_PP_LPAREN() fail_##x BOOST_PP_RPAREN()
 #define CRT_GEN_FAIL_LABEL(seq) CRT_GEN_X3 BOOST_PP_SEQ_TAIL(BOOST_PP_SEQ_FIRST_N(2, seq))
 
+#define CRT_GEN_IS_ARRAY(seq)						\
+	BOOST_PP_OR(BOOST_PP_EQUAL(CRT_GEN_X CRT_ARRAY, CRT_GEN_GET_KIND(seq)),\
+		    BOOST_PP_EQUAL(CRT_GEN_X CRT_RAW_ARRAY, CRT_GEN_GET_KIND(seq)))
+
 #define CRT_GEN_STRUCT_FIELD(seq)					\
 	BOOST_PP_EXPAND(						\
-	BOOST_PP_IF(BOOST_PP_EQUAL(CRT_GEN_X CRT_ARRAY, CRT_GEN_GET_KIND(seq)),\
+	BOOST_PP_IF(CRT_GEN_IS_ARRAY(seq),				\
 		struct {						\
 			uint64_t		 ca_count;		\
 			CRT_GEN_GET_TYPE(seq)	*ca_arrays;		\
@@ -759,6 +805,42 @@ crt_ep_abort(crt_endpoint_t *ep);
 		D_FREE(*e_ptrp);					\
 	} while (0);
 
+#define CRT_GEN_PROC_RAW_ARRAY(ptr, seq)				\
+	do {								\
+	CRT_GEN_GET_TYPE(seq) **e_ptrp = &ptr->CRT_GEN_GET_NAME(seq).ca_arrays;\
+	uint64_t count = ptr->CRT_GEN_GET_NAME(seq).ca_count;		\
+	if (proc_op == CRT_PROC_FREE) {					\
+		D_FREE(*e_ptrp);					\
+		break;							\
+	}								\
+	if (proc_op == CRT_PROC_DECODE)					\
+		*e_ptrp = NULL;						\
+	rc = crt_proc_uint64_t(proc, proc_op, &count);			\
+	if (unlikely(rc))						\
+		goto CRT_GEN_FAIL_LABEL(seq);				\
+	ptr->CRT_GEN_GET_NAME(seq).ca_count = count;			\
+	if (unlikely(count == 0))					\
+		break; /* goto next field */				\
+	if (proc_op == CRT_PROC_DECODE) {				\
+		D_ALLOC_ARRAY(*e_ptrp, (int)count);			\
+		if (unlikely(*e_ptrp == NULL)) {			\
+			rc = -DER_NOMEM;				\
+			goto CRT_GEN_FAIL_LABEL(seq);			\
+		}							\
+	}								\
+	rc = crt_proc_memcpy(proc, proc_op, *e_ptrp,			\
+			     count * sizeof(CRT_GEN_GET_TYPE(seq)));	\
+	if (unlikely(rc))						\
+		goto CRT_GEN_FAIL_LABEL(seq);				\
+	} while (0);
+
+#define CRT_GEN_FAIL_RAW_ARRAY(ptr, seq)				\
+	CRT_GEN_FAIL_LABEL(seq):					\
+	if (proc_op == CRT_PROC_DECODE) {				\
+		D_FREE(ptr->CRT_GEN_GET_NAME(seq).ca_arrays);		\
+		ptr->CRT_GEN_GET_NAME(seq).ca_count = 0;		\
+	}
+
 #define CRT_GEN_FAIL_ARRAY(ptr, seq)					\
 	CRT_GEN_FAIL_LABEL(seq):					\
 	if (proc_op == CRT_PROC_DECODE) {				\
@@ -800,7 +882,9 @@ crt_ep_abort(crt_endpoint_t *ep);
 		CRT_GEN_PROC_ARRAY(ptr, seq),				\
 	BOOST_PP_IF(BOOST_PP_EQUAL(CRT_GEN_X CRT_RAW, CRT_GEN_GET_KIND(seq)), \
 		CRT_GEN_PROC_RAW(ptr, seq),				\
-		CRT_GEN_PROC_ALL(ptr, seq))))
+	BOOST_PP_IF(BOOST_PP_EQUAL(CRT_GEN_X CRT_RAW_ARRAY, CRT_GEN_GET_KIND(seq)), \
+		CRT_GEN_PROC_RAW_ARRAY(ptr, seq),			\
+		CRT_GEN_PROC_ALL(ptr, seq)))))
 
 #define CRT_GEN_FAIL_FIELD(ptr, seq)					\
 	BOOST_PP_EXPAND(						\
@@ -808,7 +892,9 @@ crt_ep_abort(crt_endpoint_t *ep);
 		CRT_GEN_FAIL_ARRAY(ptr, seq),				\
 	BOOST_PP_IF(BOOST_PP_EQUAL(CRT_GEN_X CRT_RAW, CRT_GEN_GET_KIND(seq)), \
 		CRT_GEN_FAIL_RAW(ptr, seq),				\
-		CRT_GEN_FAIL_ALL(ptr, seq))))
+	BOOST_PP_IF(BOOST_PP_EQUAL(CRT_GEN_X CRT_RAW_ARRAY, CRT_GEN_GET_KIND(seq)), \
+		CRT_GEN_FAIL_RAW_ARRAY(ptr, seq),			\
+		CRT_GEN_FAIL_ALL(ptr, seq)))))
 
 #define CRT_GEN_PROC_FIELDS(z, n, seq)					\
 	CRT_GEN_PROC_FIELD(ptr, BOOST_PP_SEQ_ELEM(n, seq))
@@ -1153,7 +1239,12 @@ enum crt_tree_type {
 	CRT_TREE_FLAT		= 1,
 	CRT_TREE_KARY		= 2,
 	CRT_TREE_KNOMIAL	= 3,
-	CRT_TREE_MAX		= 3,
+	/**
+	 * KNOMIAL tree built over the locality order set by
+	 * crt_group_tree_order_set(), see there.
+	 */
+	CRT_TREE_DOMAIN		= 4,
+	CRT_TREE_MAX		= 4,
 };
 
 #define CRT_TREE_TYPE_SHIFT	(16U)
@@ -1475,6 +1566,28 @@ crt_group_version(crt_group_t *grp, uint32_t *version);
 int
 crt_group_version_set(crt_group_t *grp, uint32_t version);
 
+/**
+ * Set the locality order of the group members used by CRT_TREE_DOMAIN trees,
+ * typically the ranks in fault domain order (e.g. per rack or switch). As each
+ * sub-tree of a KNOMIAL tree covers a contiguous range of tree ranks, building
+ * it over this order keeps most of the collective RPC traffic within a domain
+ * and only crosses domains O(number of domains) times.
+ *
+ * Ranks of the group that are not in \p ranks are placed after the listed ones
+ * in rank order, ranks that are not group members are ignored. The order must
+ * be the same on all the members taking part in a collective RPC, like the
+ * membership itself.
+ *
+ * \param[in] grp              CRT group handle, NULL means the local
+ *                             primary/global group
+ * \param[in] ranks            ranks in locality order, NULL or empty to
+ *                             reset to the default rank order
+ *
+ * \return                     DER_SUCCESS on success, negative value on error
+ */
+int
+crt_group_tree_order_set(crt_group_t *grp, d_rank_list_t *ranks);
+
 /**
  * Query number of group members.
  *
@@ -19,6 +19,7 @@
 #include <daos_obj.h>
 #include <daos_array.h>
 #include <daos_kv.h>
+#include <daos_pipeline.h>
 #include <daos_prop.h>
 #include <daos_cont.h>
 #include <daos_pool.h>
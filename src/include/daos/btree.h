@@ -542,6 +542,10 @@ int  dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 		   d_iov_t *key, d_iov_t *val, d_iov_t *val_out);
 int  dbtree_delete(daos_handle_t toh, dbtree_probe_opc_t opc,
 		   d_iov_t *key, void *args);
+int  dbtree_upsert_bulk(daos_handle_t toh, uint32_t intent, unsigned int nr,
+			d_iov_t *keys, d_iov_t *vals);
+int  dbtree_delete_bulk(daos_handle_t toh, unsigned int nr, d_iov_t *keys,
+			void *args);
 int  dbtree_query(daos_handle_t toh, struct btr_attr *attr,
 		  struct btr_stat *stat);
 int  dbtree_is_empty(daos_handle_t toh);
@@ -605,4 +609,7 @@ enum {
 int dbtree_overhead_get(int alloc_overhead, unsigned int tclass, uint64_t feats,
 			int tree_order, struct daos_tree_overhead *ovhd);
 
+/** Return the DRAM size of an open tree handle, trace buffer included */
+int dbtree_handle_dram_size(void);
+
 #endif /* __DAOS_BTREE_H__ */
@@ -237,6 +237,15 @@ daos_csummer_update(struct daos_csummer *obj, uint8_t *buf, size_t buf_len);
 int
 daos_csummer_finish(struct daos_csummer *obj);
 
+/**
+ * Calculate \a nr independent checksums, one for each buffer in \a bufs,
+ * storing them \a csum_len bytes apart in \a csums. Uses the algorithm's
+ * multi-buffer support when it has any, otherwise one checksum at a time.
+ */
+int
+daos_csummer_multi(struct daos_csummer *obj, d_iov_t *bufs, uint32_t nr,
+		   uint8_t *csums, uint32_t csum_len);
+
 bool
 daos_csummer_compare_csum_info(struct daos_csummer *obj,
 			       struct dcs_csum_info *a,
@@ -65,17 +65,32 @@ struct daos_llink {
 	d_list_t		 ll_link;	/**< LRU hash link */
 	d_list_t		 ll_qlink;	/**< Temp link for traverse */
 	uint32_t		 ll_ref;	/**< refcount for this ref */
-	uint32_t		 ll_evicted:1;	/**< has been evicted */
+	uint32_t		 ll_evicted:1,	/**< has been evicted */
+				 ll_hot:1;	/**< referenced more than once */
 	struct daos_llink_ops	*ll_ops;	/**< ops to maintain refs */
 };
 
 /**
  * LRU cache implementation using d_hash_table and d_list_t
+ *
+ * Idle refs are kept in two LRU lists (segmented LRU). A ref that was only
+ * referenced once sits on the cold list and is the first to be evicted, so
+ * a scan over many objects can't push out the ones that are used over and
+ * over. Those are promoted to the hot list, which is limited to
+ * DLC_HOT_PCT percent of the cache size; when it overflows, its LRU refs
+ * are demoted back to the cold list.
  */
+#define DLC_HOT_PCT		75
+
 struct daos_lru_cache {
 	uint32_t		 dlc_csize;	/**< Provided cache size */
 	uint32_t		 dlc_count;	/**< count of refs in cache */
-	d_list_t		 dlc_lru;	/**< list head of LRU */
+	uint32_t		 dlc_hot_count;	/**< count of refs in dlc_lru */
+	d_list_t		 dlc_lru;	/**< list head of hot LRU */
+	d_list_t		 dlc_cold;	/**< list head of cold LRU */
+	uint64_t		 dlc_hits;	/**< lookups found in cache */
+	uint64_t		 dlc_misses;	/**< lookups not in cache */
+	uint64_t		 dlc_evictions;	/**< refs evicted for space */
 	struct d_hash_table	 dlc_htable;	/**< Hash table for all refs */
 	struct daos_llink_ops	*dlc_ops;	/**< ops to maintain refs */
 };
@@ -119,6 +134,17 @@ void
 daos_lru_cache_evict(struct daos_lru_cache *lcache,
 		     daos_lru_cond_cb_t cond, void *arg);
 
+/**
+ * Evict up to \a nr idle items from the LRU, least recently used first.
+ *
+ * \param[in] lcache		DAOS LRU cache
+ * \param[in] nr		Number of items to evict
+ *
+ * \return			Number of items evicted
+ */
+uint32_t
+daos_lru_cache_shrink(struct daos_lru_cache *lcache, uint32_t nr);
+
 /**
  * Find a ref in the cache \a lcache and take its reference.
  * if reference is not found add it.
@@ -297,6 +297,14 @@ struct umem_attr {
 #endif
 };
 
+/** transaction statistics of the calling thread, see umem_tx_stats_get() */
+struct umem_tx_stats {
+	/** number of ranges added to transactions */
+	uint64_t		uts_add_cnt;
+	/** bytes of ranges added to transactions */
+	uint64_t		uts_add_bytes;
+};
+
 /** instance of an unified memory class */
 struct umem_instance {
 	umem_class_id_t		 umm_id;
@@ -344,6 +352,7 @@ umem_slab_usize(struct umem_instance *umm, unsigned int slab_id)
 
 int  umem_class_init(struct umem_attr *uma, struct umem_instance *umm);
 void umem_attr_get(struct umem_instance *umm, struct umem_attr *uma);
+void umem_tx_stats_get(struct umem_tx_stats *stats);
 
 /** Convert an offset to pointer.
  *
@@ -48,6 +48,14 @@ struct hash_ft {
 	bool		(*cf_compare)(void *daos_mhash_ctx,
 				      uint8_t *buf1, uint8_t *buf2,
 				      size_t buf_len);
+	/** Optional. Calculate \a nr independent hashes, one for each buffer
+	 *  in \a bufs, and store them \a hash_len bytes apart in \a hashes.
+	 *  Algorithms that can interleave several buffers (e.g. ISA-L
+	 *  multi-buffer lanes) should provide it.
+	 */
+	int		(*cf_multi)(void *daos_mhash_ctx, d_iov_t *bufs,
+				    uint32_t nr, uint8_t *hashes,
+				    size_t hash_len);
 
 	/** Len in bytes. Ft can either statically set csum_len or provide
 	 *  a get_len function
@@ -0,0 +1,15 @@
+/**
+ * (C) Copyright 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Pipeline task functions.
+ */
+
+#ifndef __DAOS_PIPELINEX_H__
+#define __DAOS_PIPELINEX_H__
+
+int dc_pipeline_run(tse_task_t *task);
+
+#endif /* __DAOS_PIPELINEX_H__ */
@@ -30,6 +30,8 @@ typedef enum {
 	PL_TYPE_JUMP_MAP,
 	/** reserved */
 	PL_TYPE_PETALS,
+	/** jump map with rendezvous hashing of domains and targets */
+	PL_TYPE_RENDEZVOUS,
 } pl_map_type_t;
 
 struct pl_map_init_attr {
@@ -93,6 +95,8 @@ struct pl_map {
 	struct pool_map		*pl_poolmap;
 	/** placement map operations */
 	struct pl_map_ops       *pl_ops;
+	/** layouts computed against this map, protected by pl_lock */
+	struct pl_layout_slot	*pl_layouts;
 };
 
 /** attributes of the placement map */
@@ -132,6 +136,9 @@ int pl_obj_place(struct pl_map *map,
 		 struct daos_obj_shard_md *shard_md,
 		 struct pl_obj_layout **layout_pp);
 
+int pl_obj_place_batch(struct pl_map *map, struct daos_obj_md *mds,
+		       unsigned int nr, struct pl_obj_layout **layouts);
+
 int pl_obj_find_rebuild(struct pl_map *map,
 			struct daos_obj_md *md,
 			struct daos_obj_shard_md *shard_md,
@@ -33,13 +33,14 @@
 #define DAOS_PO_QUERY_PROP_OWNER_GROUP	(1ULL << 22)
 #define DAOS_PO_QUERY_PROP_SVC_LIST	(1ULL << 23)
 #define DAOS_PO_QUERY_PROP_EC_CELL_SZ	(1ULL << 24)
+#define DAOS_PO_QUERY_PROP_SCHED_WEIGHT	(1ULL << 25)
 
 #define DAOS_PO_QUERY_PROP_ALL						\
 	(DAOS_PO_QUERY_PROP_LABEL | DAOS_PO_QUERY_PROP_SPACE_RB |	\
 	 DAOS_PO_QUERY_PROP_SELF_HEAL | DAOS_PO_QUERY_PROP_RECLAIM |	\
 	 DAOS_PO_QUERY_PROP_ACL | DAOS_PO_QUERY_PROP_OWNER |		\
 	 DAOS_PO_QUERY_PROP_OWNER_GROUP | DAOS_PO_QUERY_PROP_SVC_LIST |	\
-	 DAOS_PO_QUERY_PROP_EC_CELL_SZ)
+	 DAOS_PO_QUERY_PROP_EC_CELL_SZ | DAOS_PO_QUERY_PROP_SCHED_WEIGHT)
 
 
 int dc_pool_init(void);
@@ -69,6 +70,12 @@ struct dc_pool {
 				dp_slave:1; /* generated via g2l */
 	/* required/allocated pool map size */
 	size_t			dp_map_sz;
+	/* link in the list of shareable connections, see dc_pool_connect() */
+	d_list_t		dp_share_link;
+	/* number of daos_pool_connect() calls sharing this connection */
+	uint32_t		dp_share_nr;
+	/* label the pool was connected by, empty if connected by UUID */
+	char			dp_label[DAOS_PROP_LABEL_MAX_LEN + 1];
 };
 
 static inline unsigned int
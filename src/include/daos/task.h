@@ -97,6 +97,9 @@ struct daos_task_args {
 		daos_kv_put_t		kv_put;
 		daos_kv_remove_t	kv_remove;
 		daos_kv_list_t		kv_list;
+		daos_kv_multi_t		kv_multi;
+		daos_kv_scan_t		kv_scan;
+		daos_pipeline_run_t	pipeline_run;
 	}		 ta_u;
 	daos_event_t	*ta_ev;
 };
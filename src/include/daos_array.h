@@ -402,6 +402,27 @@ int
 daos_array_get_attr(daos_handle_t oh, daos_size_t *chunk_size,
 		    daos_size_t *cell_size);
 
+/**
+ * Maintain the size of the array in a dedicated record of the metadata dkey.
+ *
+ * Writes through the handle also raise the size record to the end of the
+ * highest written range, daos_array_set_size() resets it, and
+ * daos_array_get_size() queries only the shard holding it instead of every
+ * shard of the array. Punching the tail of the array does not shrink the
+ * tracked size.
+ *
+ * The size record is only accurate if every handle that ever wrote the array
+ * tracks its size, so this should be enabled right after the array is created
+ * and on every later open. The setting is carried by daos_array_local2global().
+ *
+ * \param[in]	oh	Array object open handle.
+ *
+ * \return		0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ */
+int
+daos_array_track_size(daos_handle_t oh);
+
 #if defined(__cplusplus)
 }
 #endif
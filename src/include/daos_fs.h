@@ -196,6 +196,43 @@ int
 dfs_global2local(daos_handle_t poh, daos_handle_t coh, int flags, d_iov_t glob,
 		 dfs_t **dfs);
 
+/**
+ * Broadcast callback used by the collective DFS calls, typically a wrapper
+ * around MPI_Bcast on the communicator of the job. It must send \a size bytes
+ * of \a buf from the root process to all the others, which receive them in
+ * \a buf.
+ *
+ * \param[in,out]
+ *		buf	Buffer to send (root) or to receive into (others).
+ * \param[in]	size	Number of bytes to broadcast, same on all processes.
+ * \param[in]	arg	Argument passed to the collective call.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+typedef int (*dfs_bcast_cb_t)(void *buf, size_t size, void *arg);
+
+/**
+ * Collective version of dfs_mount(). Only the root process mounts the file
+ * system, then it shares the mount with the others through \a bcast, which
+ * rebuild it without any RPC. All the processes must call this function, with
+ * pool and container handles that are valid locally (e.g. shared with
+ * daos_pool_local2global() and daos_cont_local2global()).
+ *
+ * \param[in]	poh	Pool connection handle
+ * \param[in]	coh	Container open handle.
+ * \param[in]	flags	Mount flags (O_RDONLY or O_RDWR).
+ * \param[in]	root	True on the root process of the broadcast.
+ * \param[in]	bcast	Broadcast callback.
+ * \param[in]	arg	Argument passed to \a bcast.
+ * \param[out]	dfs	Returned dfs mount, to be closed with dfs_umount().
+ *
+ * \return		0 on success, errno code on failure. Errors on the root
+ *			process are returned on all processes.
+ */
+int
+dfs_mount_coll(daos_handle_t poh, daos_handle_t coh, int flags, bool root,
+	       dfs_bcast_cb_t bcast, void *arg, dfs_t **dfs);
+
 /**
  * Optionally set a prefix on the dfs mount where all paths passed to dfs_lookup
  * are trimmed off that prefix. This is helpful when using DFS API with a dfuse
@@ -211,6 +248,34 @@ dfs_global2local(daos_handle_t poh, daos_handle_t coh, int flags, d_iov_t glob,
 int
 dfs_set_prefix(dfs_t *dfs, const char *prefix);
 
+/**
+ * Enable, reconfigure or disable the client side dentry and attribute cache
+ * of a dfs mount. When enabled, path walks in dfs_lookup(), dfs_lookup_rel()
+ * and dfs_stat() reuse entries fetched within the last \a dentry_timeout
+ * seconds instead of fetching every path component again. Changes made
+ * through this mount invalidate the affected entries; changes made by other
+ * clients are only seen once the cached entries time out. Symbolic links
+ * are never cached.
+ *
+ * The cache can also be enabled at mount time by setting the
+ * DFS_DENTRY_TIMEOUT (and optionally DFS_ATTR_TIMEOUT) environment
+ * variables. This call must not race with other operations on \a dfs.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	dentry_timeout
+ *			Seconds a cached entry can be used to resolve a path.
+ *			0 disables the cache and drops all cached entries.
+ * \param[in]	attr_timeout
+ *			Seconds the cached mode and times of an entry can be
+ *			returned in a stat buffer (capped at \a dentry_timeout).
+ *			File sizes are never cached.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_set_dcache(dfs_t *dfs, unsigned int dentry_timeout,
+	       unsigned int attr_timeout);
+
 /**
  * Convert from a dfs_obj_t to a daos_obj_id_t.
  *
@@ -262,6 +327,31 @@ int
 dfs_lookup_rel(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 	       dfs_obj_t **obj, mode_t *mode, struct stat *stbuf);
 
+/**
+ * Create several empty regular files in the same directory.  Each entry is
+ * inserted with a conditional update and all the updates are in flight at
+ * the same time, rather than one create round trip per file.  The files are
+ * not opened.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	nr	Number of entries in \a names.
+ * \param[in]	names	Link names of the files to create.
+ * \param[in]	mode	Permission bits of the files.
+ * \param[in]	cid	DAOS object class id (pass 0 for default).
+ * \param[in]	chunk_size
+ *			Chunk size of the files (pass 0 for default).
+ * \param[out]	rcs	Array of \a nr errno codes, one per entry, EEXIST if
+ *			the entry already exists.
+ *
+ * \return		0 if every file was created, otherwise the first error
+ *			seen, with the per entry results in \a rcs.
+ */
+int
+dfs_create_many(dfs_t *dfs, dfs_obj_t *parent, uint32_t nr, const char *names[],
+		mode_t mode, daos_oclass_id_t cid, daos_size_t chunk_size,
+		int rcs[]);
+
 /**
  * Create/Open a directory, file, or Symlink.
  * The object must be released with dfs_release().
@@ -279,7 +369,8 @@ dfs_lookup_rel(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
  *			Valid on create only; ignored otherwise.
  * \param[in]	chunk_size
  *			Chunk size of the array object to be created.
- *			(pass 0 for default 1 MiB chunk size).
+ *			(pass 0 for default 1 MiB chunk size, rounded up to a
+ *			multiple of the full stripe for EC object classes).
  *			Valid on file create only; ignored otherwise.
  * \param[in]	value	Symlink value (NULL if not syml).
  * \param[out]	obj	Pointer to object opened.
@@ -338,6 +429,60 @@ dfs_obj_local2global(dfs_t *dfs, dfs_obj_t *obj, d_iov_t *glob);
 int
 dfs_obj_global2local(dfs_t *dfs, int flags, d_iov_t glob, dfs_obj_t **obj);
 
+/**
+ * Collective version of dfs_lookup() for a regular file. Only the root process
+ * looks up the path, then it shares the open object with the others through
+ * \a bcast. All the processes must call this function with the same \a path
+ * and a \a dfs mount of the same container.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	path	Absolute path to the file to open.
+ * \param[in]	flags	Access flags (O_RDONLY/O_RDWR).
+ * \param[in]	root	True on the root process of the broadcast.
+ * \param[in]	bcast	Broadcast callback.
+ * \param[in]	arg	Argument passed to \a bcast.
+ * \param[out]	obj	Returned open object, to be released with
+ *			dfs_release().
+ *
+ * \return		0 on success, errno code on failure. EINVAL is returned
+ *			if \a path is not a regular file. Errors on the root
+ *			process are returned on all processes.
+ */
+int
+dfs_lookup_coll(dfs_t *dfs, const char *path, int flags, bool root,
+		dfs_bcast_cb_t bcast, void *arg, dfs_obj_t **obj);
+
+/**
+ * Create a new regular file and write its first bytes at offset 0.
+ *
+ * This is the same as dfs_open() with O_CREAT | O_EXCL followed by
+ * dfs_write(), except that the data write is issued while the directory entry
+ * is inserted, so both complete in a single round trip. It suits file per
+ * process checkpoints where every file is new and written once.
+ *
+ * If the entry already exists, the data is discarded and EEXIST is returned.
+ * If the write fails after the entry was inserted, the file is left in place
+ * and the error is returned.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	name	Link name of the file to create.
+ * \param[in]	mode	mode_t (permissions + type), must be S_IFREG.
+ * \param[in]	flags	Access flags (O_CREAT | O_EXCL are implied).
+ * \param[in]	cid	DAOS object class id (pass 0 for default).
+ * \param[in]	chunk_size
+ *			Chunk size of the array object to be created.
+ *			(pass 0 for default 1 MiB chunk size).
+ * \param[in]	sgl	Data to write at offset 0, can be NULL or empty.
+ * \param[out]	obj	Pointer to object opened.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_create_write(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
+		 int flags, daos_oclass_id_t cid, daos_size_t chunk_size,
+		 d_sg_list_t *sgl, dfs_obj_t **obj);
+
 /**
  * Close/release open object.
  *
@@ -496,6 +641,25 @@ int
 dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor,
 	    uint32_t *nr, size_t size, dfs_filler_cb_t op, void *arg);
 
+/**
+ * Iterate over all entries of a directory, enumerating every redundancy
+ * group of the directory object concurrently (see dfs_obj_anchor_split()).
+ * This is only faster than dfs_iterate() for directories created with a
+ * sharded object class, or with the DFS_DIR_SHARDING environment variable
+ * set on the client that created them. The callback is issued serially from
+ * the calling thread and entries are not returned in any particular order.
+ * Iteration stops at the first non-zero return of \a op, which is returned.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Opened directory object.
+ * \param[in]	op	Callback to be issued on every entry.
+ * \param[in]	arg	Pointer to user data to be passed to \a op.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_iterate_shards(dfs_t *dfs, dfs_obj_t *obj, dfs_filler_cb_t op, void *arg);
+
 /**
  * Provide a function for large directories to split an anchor to be able to
  * execute a parallel readdir or iterate. This routine suggests the optimal
@@ -624,6 +788,42 @@ dfs_get_mode(dfs_obj_t *obj, mode_t *mode);
 int
 dfs_obj_get_info(dfs_t *dfs, dfs_obj_t *obj, dfs_obj_info_t *info);
 
+/** Expected access pattern of a file, see dfs_obj_set_hint() */
+typedef enum {
+	/** No particular pattern, read-ahead is adapted to the reads seen */
+	DFS_HINT_NORMAL,
+	/** File is read sequentially, read-ahead can start right away */
+	DFS_HINT_SEQUENTIAL,
+	/** File is read at random offsets, read-ahead is useless */
+	DFS_HINT_RANDOM,
+} dfs_hint_t;
+
+/**
+ * Set the expected access pattern of an open file, in the way of POSIX_FADV_*
+ * advice. The hint is kept on the open handle only, it is neither stored in
+ * the container nor shared with other handles of the same file, and consumers
+ * doing read-ahead over DFS (such as the interception library) query it with
+ * dfs_obj_get_hint().
+ *
+ * \param[in]	obj	Open file handle.
+ * \param[in]	hint	Access pattern.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_obj_set_hint(dfs_obj_t *obj, dfs_hint_t hint);
+
+/**
+ * Retrieve the access pattern hint of an open file.
+ *
+ * \param[in]	obj	Open file handle.
+ * \param[out]	hint	Access pattern, DFS_HINT_NORMAL if never set.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_obj_get_hint(dfs_obj_t *obj, dfs_hint_t *hint);
+
 /**
  * Set the object class on a directory for new files or sub-dirs that are
  * created in that dir.  This does not change the chunk size for existing files
@@ -658,6 +858,50 @@ int
 dfs_obj_set_chunk_size(dfs_t *dfs, dfs_obj_t *obj, int flags,
 		       daos_size_t csize);
 
+/** Apply the suggested object class on the directory */
+#define DFS_OCLASS_APPLY	(1 << 0)
+
+/** Object class advice for the files of a directory */
+typedef struct {
+	/**
+	 * [in]: number of clients expected to access a same file concurrently,
+	 * 0 if unknown.
+	 */
+	uint32_t		doa_sharers;
+	/** [out]: number of regular files sampled */
+	uint64_t		doa_nr_files;
+	/** [out]: average size of the sampled files */
+	daos_size_t		doa_avg_size;
+	/** [out]: size of the largest sampled file */
+	daos_size_t		doa_max_size;
+	/** [out]: object class new files of the directory currently get */
+	daos_oclass_id_t	doa_cur_oclass;
+	/** [out]: suggested object class for new files of the directory */
+	daos_oclass_id_t	doa_oclass;
+} dfs_oclass_advice_t;
+
+/**
+ * Suggest an object class for new files of a directory from the sizes of the
+ * files it already holds and the expected number of concurrent clients per
+ * file. The redundancy of the current class is kept, only the number of
+ * redundancy groups is adjusted: files spanning a single chunk and accessed by
+ * a single client get one group, while large or shared files are striped over
+ * as many groups as they have chunks (or clients), up to all the targets of
+ * the pool. Only the first 4096 files of the directory are sampled.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Open directory object.
+ * \param[in]	flags	DFS_OCLASS_APPLY to also set the suggested class on
+ *			the directory (see dfs_obj_set_oclass()).
+ * \param[in,out]
+ *		advice	Sampling input and results.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_obj_suggest_oclass(dfs_t *dfs, dfs_obj_t *obj, int flags,
+		       dfs_oclass_advice_t *advice);
+
 /**
  * Retrieve the DAOS open handle of a DFS file object. User should not close
  * this handle. This is used in cases like MPI-IO where 1 rank creates the file
@@ -756,6 +1000,41 @@ dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name,
 int
 dfs_ostat(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf);
 
+/**
+ * Same as dfs_ostat but can be run asynchronously.  The entry fetch and, for
+ * files, the size query are issued concurrently.  \a stbuf must remain valid
+ * until the event completes.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Open object (File, dir or syml) to stat.
+ * \param[out]	stbuf	Stat struct with the members above filled.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_ostatx(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, daos_event_t *ev);
+
+/**
+ * Stat several entries of the same directory.  The entries are fetched
+ * concurrently, and then the sizes of all the regular files among them are
+ * queried concurrently, rather than one entry at a time.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	nr	Number of entries in \a names.
+ * \param[in]	names	Link names of the entries to stat.
+ * \param[out]	stbufs	Array of \a nr stat structs filled for each entry.
+ * \param[out]	rcs	Array of \a nr errno codes, one per entry.
+ *
+ * \return		0 if every entry was found, otherwise the first error
+ *			seen, with the per entry results in \a rcs.
+ */
+int
+dfs_stat_many(dfs_t *dfs, dfs_obj_t *parent, uint32_t nr, const char *names[],
+	      struct stat stbufs[], int rcs[]);
+
 /** Option to set the mode_t on an entry */
 #define DFS_SET_ATTR_MODE	(1 << 0)
 /** Option to set the access time on an entry */
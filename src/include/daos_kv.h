@@ -28,6 +28,32 @@ extern "C" {
 /* Conditional Op: Remove key if it exists, fail otherwise */
 #define DAOS_COND_KEY_REMOVE	DAOS_COND_PUNCH
 
+/** Key-value pair of a batched put/get */
+typedef struct {
+	/** Key, NULL terminated string */
+	const char		*kve_key;
+	/**
+	 * put: size of the value.
+	 * get: [in] size of \a kve_buf, [out] actual size of the value, 0 if
+	 * the key doesn't exist.
+	 */
+	daos_size_t		 kve_size;
+	/** Value buffer, if NULL on get, only the size is returned */
+	void			*kve_buf;
+	/** [out] result of the operation on this key */
+	int			 kve_rc;
+} daos_kv_ent_t;
+
+/** Predicates of a key scan, unset fields match everything */
+typedef struct {
+	/** Only return keys starting with this string */
+	const char		*kf_prefix;
+	/** Only return keys whose value is at least that big */
+	daos_size_t		 kf_size_min;
+	/** Only return keys whose value is at most that big, 0 for no limit */
+	daos_size_t		 kf_size_max;
+} daos_kv_filter_t;
+
 /**
  * Open a KV object. This is a local operation (no RPC involved).
  * The type bits in the oid must set DAOS_OT_KV_*.
@@ -197,6 +223,100 @@ daos_kv_list(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 	     daos_key_desc_t *kds, d_sg_list_t *sgl, daos_anchor_t *anchor,
 	     daos_event_t *ev);
 
+/**
+ * Insert or update a batch of keys. All the updates are issued concurrently
+ * and the call completes once all of them are done. Every key is a distinct
+ * dkey and object RPCs carry a single dkey, so the batch still costs one RPC
+ * per key, not one per target.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	flags	Update flags applied to every key.
+ * \param[in]	nr	Number of entries in \a ents.
+ * \param[in,out]
+ *		ents	[in]: keys and values to store. [out]: per entry result
+ *			in kve_rc.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			Otherwise, the error of one of the failed entries
+ */
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags,
+		  unsigned int nr, daos_kv_ent_t *ents, daos_event_t *ev);
+
+/**
+ * Fetch the values of a batch of keys. All the fetches are issued
+ * concurrently and the call completes once all of them are done. As for
+ * daos_kv_put_multi(), this is one RPC per key.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	flags	Fetch flags applied to every key.
+ * \param[in]	nr	Number of entries in \a ents.
+ * \param[in,out]
+ *		ents	[in]: keys and value buffers. [out]: value sizes and
+ *			per entry result in kve_rc.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_REC2BIG	One of the values does not fit in its
+ *					buffer, kve_size is set to the required
+ *					size for that entry
+ *			Otherwise, the error of one of the failed entries
+ */
+int
+daos_kv_get_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags,
+		  unsigned int nr, daos_kv_ent_t *ents, daos_event_t *ev);
+
+/**
+ * List the keys matching \a filter. Same as daos_kv_list(), except that keys
+ * not matching the predicates are dropped from \a kds and \a sgl. A call can
+ * thus return no key while the anchor is not EOF yet. The predicates are
+ * evaluated by the client library after listing, and a value size predicate
+ * costs one fetch RPC per key passing the prefix.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	filter	Predicates to apply, NULL to return all keys.
+ * \param[in,out]
+ *		nr	[in]: number of key descriptors in \a kds. [out]: number
+ *			of matching key descriptors.
+ * \param[in,out]
+ *		kds	[in]: preallocated array of \a nr key descriptors.
+ *			[out]: size of each individual matching key.
+ * \param[in]	sgl	Scatter/gather list with a single iov to store the
+ *			matching keys, written contiguously.
+ * \param[in,out]
+ *		anchor	Hash anchor for the next call, it should be set to
+ *			zeroes for the first call, it should not be changed
+ *			by caller between calls.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NO_PERM	Permission denied
+ *			-DER_UNREACH	Network is unreachable
+ */
+int
+daos_kv_scan(daos_handle_t oh, daos_handle_t th, const daos_kv_filter_t *filter,
+	     uint32_t *nr, daos_key_desc_t *kds, d_sg_list_t *sgl,
+	     daos_anchor_t *anchor, daos_event_t *ev);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -1069,6 +1069,42 @@ daos_obj_anchor_split(daos_handle_t oh, uint32_t *nr, daos_anchor_t *anchors);
 int
 daos_obj_anchor_set(daos_handle_t oh, uint32_t index, daos_anchor_t *anchor);
 
+/**
+ * Callback of daos_obj_list_dkey_all(), issued once per listed key.
+ *
+ * \param[in]	kd	Key descriptor; the key is kd->kd_key_len bytes long.
+ * \param[in]	key	Key buffer, not NULL terminated.
+ * \param[in]	arg	User data passed to daos_obj_list_dkey_all().
+ *
+ * \return		0 to continue, anything else stops the listing and is
+ *			returned by daos_obj_list_dkey_all().
+ */
+typedef int (*daos_obj_list_cb_t)(daos_key_desc_t *kd, void *key, void *arg);
+
+/**
+ * List all dkeys of an object, enumerating every redundancy group
+ * concurrently. The dkey space is split with daos_obj_anchor_split() and one
+ * listing per group is kept in flight; the results are merged on the calling
+ * thread, which issues \a cb serially. Keys are not returned in any
+ * particular order. This is a blocking call.
+ *
+ * \param[in]	oh	Open object handle.
+ * \param[in]	th	Optional transaction handle. Use DAOS_TX_NONE for an
+ *			independent transaction.
+ * \param[in]	cb	Callback issued on every dkey.
+ * \param[in]	arg	User data passed to \a cb.
+ *
+ * \return		These values will be returned:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NOMEM	Out of memory
+ *			Any other non-zero return of \a cb
+ */
+int
+daos_obj_list_dkey_all(daos_handle_t oh, daos_handle_t th,
+		       daos_obj_list_cb_t cb, void *arg);
+
 /**
  * Open Object Index Table (OIT) of an container
  *
@@ -0,0 +1,176 @@
+/*
+ * (C) Copyright 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * \file
+ *
+ * DAOS Pipeline API
+ *
+ * A pipeline is a conjunction of conditions on the single values stored under
+ * akeys of a dkey, plus a set of aggregations (count/sum/min/max) computed over
+ * the dkeys matching all the conditions. Running a pipeline enumerates the
+ * dkeys of an object and returns only the matching ones, along with the
+ * aggregated values.
+ *
+ * Values are compared and aggregated as native integers or floating points of
+ * up to 8 bytes; a dkey whose referenced akey is missing or holds a value of
+ * another size does not match the conditions on that akey and is ignored by
+ * the aggregations on it.
+ *
+ * The pipeline is currently evaluated by the client library, not pushed down
+ * to the engine: the values of the referenced akeys are fetched for every
+ * enumerated dkey, and the filtering and aggregations run on the client. This
+ * saves the application the per-dkey round trips, not the data transfer. An
+ * engine-side evaluation would need a new object RPC carrying the pipeline,
+ * and can be added later behind the same API.
+ */
+
+#ifndef __DAOS_PIPELINE_H__
+#define __DAOS_PIPELINE_H__
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/** Interpretation of the single value stored under an akey */
+typedef enum {
+	/** unsigned integer of 1, 2, 4 or 8 bytes, native endianness */
+	DAOS_PIPELINE_UINT,
+	/** signed integer of 1, 2, 4 or 8 bytes, native endianness */
+	DAOS_PIPELINE_INT,
+	/** float or double */
+	DAOS_PIPELINE_DOUBLE,
+} daos_pipeline_type_t;
+
+/** Comparison of a value against a constant */
+typedef enum {
+	DAOS_PIPELINE_EQ,
+	DAOS_PIPELINE_NE,
+	DAOS_PIPELINE_LT,
+	DAOS_PIPELINE_LE,
+	DAOS_PIPELINE_GT,
+	DAOS_PIPELINE_GE,
+} daos_pipeline_cmp_t;
+
+/** Aggregation over the matching dkeys */
+typedef enum {
+	/** number of matching dkeys, no akey needed */
+	DAOS_PIPELINE_COUNT,
+	DAOS_PIPELINE_SUM,
+	DAOS_PIPELINE_MIN,
+	DAOS_PIPELINE_MAX,
+} daos_pipeline_agg_op_t;
+
+/** Condition on the value of an akey */
+typedef struct {
+	/** akey holding a single value */
+	daos_key_t		pc_akey;
+	daos_pipeline_type_t	pc_type;
+	daos_pipeline_cmp_t	pc_cmp;
+	/** constant to compare with, member selected by \a pc_type */
+	union {
+		uint64_t	u;
+		int64_t		i;
+		double		d;
+	}			pc_const;
+} daos_pipeline_cond_t;
+
+/** Aggregation of the value of an akey */
+typedef struct {
+	/** akey holding a single value, unused for DAOS_PIPELINE_COUNT */
+	daos_key_t		pa_akey;
+	daos_pipeline_type_t	pa_type;
+	daos_pipeline_agg_op_t	pa_op;
+} daos_pipeline_agg_t;
+
+/** Pipeline description, all conditions must hold for a dkey to match */
+typedef struct {
+	uint32_t		 dp_nr_conds;
+	daos_pipeline_cond_t	*dp_conds;
+	uint32_t		 dp_nr_aggs;
+	daos_pipeline_agg_t	*dp_aggs;
+} daos_pipeline_t;
+
+/** Pipeline results, accumulated over successive daos_pipeline_run() calls */
+typedef struct {
+	/** number of dkeys evaluated */
+	uint64_t		 ps_nr_scanned;
+	/** number of dkeys matching all conditions */
+	uint64_t		 ps_nr_matched;
+	/**
+	 * one value per aggregation of the pipeline, provided by the caller
+	 * and set up by daos_pipeline_stats_init()
+	 */
+	double			*ps_aggs;
+} daos_pipeline_stats_t;
+
+/**
+ * Check that a pipeline is well formed.
+ *
+ * \param[in]	pipeline	Pipeline to check.
+ *
+ * \return			0 if valid, -DER_INVAL otherwise.
+ */
+int
+daos_pipeline_check(const daos_pipeline_t *pipeline);
+
+/**
+ * Reset the results of a pipeline before the first daos_pipeline_run() call.
+ *
+ * \param[in]	pipeline	Pipeline being run.
+ * \param[in,out]
+ *		stats		Results, stats->ps_aggs must have room for
+ *				pipeline->dp_nr_aggs values.
+ */
+void
+daos_pipeline_stats_init(const daos_pipeline_t *pipeline,
+			 daos_pipeline_stats_t *stats);
+
+/**
+ * Run a pipeline over the next batch of dkeys of an object.
+ * The pipeline is evaluated on the client, see the top of this file.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	pipeline
+ *			Conditions and aggregations to evaluate.
+ * \param[in,out]
+ *		anchor	Hash anchor for the next call, it should be set to
+ *			zeroes for the first call, it should not be changed
+ *			by caller between calls.
+ * \param[in,out]
+ *		nr	[in]: number of key descriptors in \a kds. [out]: number
+ *			of matching dkeys. It can be zero while \a anchor is
+ *			not EOF.
+ * \param[in,out]
+ *		kds	[in]: preallocated array of \a nr key descriptors.
+ *			[out]: size of each matching dkey.
+ * \param[in]	sgl	Scatter/gather list with a single iov to store the
+ *			matching dkeys, written contiguously.
+ * \param[in,out]
+ *		stats	Results updated with the evaluated batch, it can be
+ *			NULL if the pipeline has no aggregation.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NO_PERM	Permission denied
+ *			-DER_UNREACH	Network is unreachable
+ */
+int
+daos_pipeline_run(daos_handle_t oh, daos_handle_t th,
+		  const daos_pipeline_t *pipeline, daos_anchor_t *anchor,
+		  uint32_t *nr, daos_key_desc_t *kds, d_sg_list_t *sgl,
+		  daos_pipeline_stats_t *stats, daos_event_t *ev);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __DAOS_PIPELINE_H__ */
@@ -68,12 +68,20 @@ enum daos_pool_props {
 	 */
 	DAOS_PROP_PO_SVC_LIST,
 	DAOS_PROP_PO_EC_CELL_SZ,
+	/**
+	 * Weight of the pool IO against other pools of the same engine when
+	 * the WFQ scheduling policy is enabled. default = 100
+	 */
+	DAOS_PROP_PO_SCHED_WEIGHT,
 	DAOS_PROP_PO_MAX,
 };
 
 #define DAOS_PROP_PO_EC_CELL_SZ_MIN	(1UL << 10)
 #define DAOS_PROP_PO_EC_CELL_SZ_MAX	(1UL << 30)
 
+#define DAOS_PROP_PO_SCHED_WEIGHT_DEF	100
+#define DAOS_PROP_PO_SCHED_WEIGHT_MAX	10000
+
 /**
  * Number of pool property types
  */
@@ -532,6 +532,16 @@ int bio_ioctxt_close(struct bio_io_context *ctxt, bool skip_blob);
  */
 int bio_blob_unmap(struct bio_io_context *ctxt, uint64_t off, uint64_t len);
 
+/*
+ * Drop the extent being freed from the DRAM read cache.
+ *
+ * \param[IN] ctxt	I/O context
+ * \param[IN] off	Offset in bytes
+ * \param[IN] len	Length in bytes
+ */
+void bio_rcache_invalidate(struct bio_io_context *ctxt, uint64_t off,
+			   uint64_t len);
+
 /**
  * Write to per VOS instance blob.
  *
@@ -43,6 +43,10 @@ int ds_cont_tgt_close(uuid_t hdl_uuid);
 int ds_cont_tgt_open(uuid_t pool_uuid, uuid_t cont_hdl_uuid,
 		     uuid_t cont_uuid, uint64_t flags, uint64_t sec_capas,
 		     uint32_t status_pm_ver);
+
+/* Number of snapshot deletions remembered for aggregation restart */
+#define CONT_SNAP_DEL_LOG_NR	8
+
 /*
  * Per-thread container (memory) object
  *
@@ -83,6 +87,13 @@ struct ds_cont_child {
 	 * aggregation needs to be restart from 0.
 	 */
 	uint64_t		sc_snapshot_delete_hlc;
+	/*
+	 * Lowest deleted epoch of the latest snapshot deletions, indexed by
+	 * sc_snapshot_delete_nr % CONT_SNAP_DEL_LOG_NR, so that aggregation
+	 * only restarts from the first interval merged by a deletion.
+	 */
+	uint64_t		sc_snapshot_delete_ephs[CONT_SNAP_DEL_LOG_NR];
+	uint64_t		sc_snapshot_delete_nr;
 
 	/* Upper bound of aggregation epoch, it can be:
 	 *
@@ -129,6 +140,8 @@ struct agg_param {
 	void			*ap_data;
 	struct ds_cont_child	*ap_cont;
 	daos_epoch_t		ap_full_scan_hlc;
+	/* sc_snapshot_delete_nr as of ap_full_scan_hlc */
+	uint64_t		ap_snapshot_delete_nr;
 	struct sched_request	*ap_req;
 	agg_param_get_eph_t	ap_max_eph_get;
 	agg_param_get_eph_t	ap_start_eph_get;
@@ -236,4 +249,7 @@ void ds_cont_tgt_ec_eph_query_ult(void *data);
 int ds_cont_ec_eph_insert(struct ds_pool *pool, uuid_t cont_uuid, int tgt_idx,
 			  uint64_t **epoch_p);
 int ds_cont_ec_eph_delete(struct ds_pool *pool, uuid_t cont_uuid, int tgt_idx);
+
+/* Epoch below which all transactions are either committed or aborted */
+daos_epoch_t ds_cont_stable_epoch(void);
 #endif /* ___DAOS_SRV_CONTAINER_H_ */
@@ -345,6 +345,59 @@ uint64_t sched_cur_seq(void);
  */
 int sched_exec_time(uint64_t *msecs, const char *ult_name);
 
+/**
+ * Set the WFQ weight of a pool on the caller xstream, IO requests of pools
+ * are kicked in proportion to their weights when the WFQ scheduling policy
+ * is enabled. Caller should set it on all target xstreams collectively, the
+ * pool module does so from the DAOS_PROP_PO_SCHED_WEIGHT pool property.
+ *
+ * \param[in]	pool_id		pool UUID
+ * \param[in]	weight		weight, [1, 10000], default weight is 100
+ *
+ * \retval			0 on success, negative value on error.
+ */
+int sched_set_pool_weight(uuid_t pool_id, unsigned int weight);
+
+/**
+ * DRAM cache taking part in the engine memory budget (DAOS_MEM_BUDGET). The
+ * usage of all registered caches is sampled periodically, when the engine
+ * goes over budget, caches are asked to shrink in priority order.
+ */
+struct dss_mem_cache {
+	/** Cache name, used for the telemetry path */
+	const char		 *mc_name;
+	/** Caches with a lower priority are shrunk first */
+	int			  mc_prio;
+	/** Return the bytes currently used by the cache */
+	uint64_t		(*mc_usage)(void *arg);
+	/** Try to release \a size bytes, return the bytes released */
+	uint64_t		(*mc_shrink)(void *arg, uint64_t size);
+	void			 *mc_arg;
+	/** Internal, link on the xstream cache list */
+	d_list_t		  mc_link;
+	/** Internal, usage telemetry */
+	struct d_tm_node_t	 *mc_tm_usage;
+};
+
+/**
+ * Register a DRAM cache owned by an xstream, it must be called on that
+ * xstream (typically from a module TLS init), the callbacks are only called
+ * there too. \a cache must stay valid until it's unregistered. Nothing is
+ * registered if the xstream doesn't exist (yet), \a cache::mc_link should be
+ * initialized by the caller so that unregistering stays safe then.
+ *
+ * \param[in]	xs_id		owner xstream ID
+ * \param[in]	cache		cache to register
+ */
+void dss_mem_cache_register(int xs_id, struct dss_mem_cache *cache);
+
+/**
+ * Unregister a DRAM cache, it must be called on the owner xstream.
+ *
+ * \param[in]	cache		cache to unregister
+ */
+void dss_mem_cache_unregister(struct dss_mem_cache *cache);
+
 /**
  * Create an ULT on the caller xstream and return the associated sched_request.
  * Caller is responsible for freeing the sched_request by sched_req_put().
@@ -16,6 +16,10 @@
 
 #define DTX_REFRESH_MAX 4
 
+/* Times and interval an I/O waits on the engine for a prepared DTX it conflicts with. */
+#define DTX_INPROGRESS_WAIT_MAX	8
+#define DTX_INPROGRESS_WAIT_MS	1
+
 struct dtx_share_peer {
 	d_list_t		dsp_link;
 	struct dtx_id		dsp_xid;
@@ -240,6 +244,8 @@ int dtx_abort(struct ds_cont_child *cont, struct dtx_entry *dte, daos_epoch_t ep
 
 int dtx_refresh(struct dtx_handle *dth, struct ds_cont_child *cont);
 
+int dtx_inprogress_wait(struct dtx_handle *dth, int *waits);
+
 /**
  * Check whether the given DTX is resent one or not.
  *
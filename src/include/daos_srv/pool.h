@@ -36,6 +36,8 @@ struct ds_pool {
 	uint32_t		sp_map_version;	/* temporary */
 	uint32_t		sp_ec_cell_sz;
 	uint64_t		sp_reclaim;
+	/* WFQ weight applied to the schedulers of all targets */
+	uint32_t		sp_sched_weight;
 	crt_group_t	       *sp_group;
 	ABT_mutex		sp_mutex;
 	ABT_cond		sp_fetch_hdls_cond;
@@ -123,6 +123,25 @@ struct vea_stat {
 	uint64_t	vs_frags_aging;	/* Aging frags */
 };
 
+#define VEA_FRAG_BKT_MAX	24
+
+/* Free space fragmentation statistics */
+struct vea_frag_stat {
+	uint64_t	vfs_free_blks;	/* Free blocks available for allocation */
+	uint64_t	vfs_frags;	/* Free extents available for allocation */
+	uint32_t	vfs_largest;	/* Largest free extent in blocks */
+	/*
+	 * Fragmentation index in percent, 0 means all free blocks are in
+	 * one extent, it approaches 100 as free space is cut into pieces.
+	 */
+	uint32_t	vfs_frag_pct;
+	/*
+	 * Number of free extents by size, bucket i counts the extents of
+	 * [2^i, 2^(i+1)) blocks, the last bucket counts all larger extents.
+	 */
+	uint64_t	vfs_bkts[VEA_FRAG_BKT_MAX];
+};
+
 struct vea_space_info;
 
 /* Callback to initialize block device header */
@@ -298,6 +317,17 @@ int vea_get_ext_vector(struct vea_space_info *vsi, uint64_t blk_off,
 int vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 	      struct vea_stat *stat);
 
+/**
+ * Query fragmentation statistics of the free space available for allocation.
+ *
+ * \param vsi       [IN]	In-memory compound index
+ * \param stat      [OUT]	Fragmentation statistics
+ *
+ * \return			Zero on success; Appropriated negative value
+ *				on error
+ */
+int vea_query_frag(struct vea_space_info *vsi, struct vea_frag_stat *stat);
+
 /**
  * Flushing the free frags in aging buffer
  *
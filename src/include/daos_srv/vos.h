@@ -330,6 +330,22 @@ vos_pool_query(daos_handle_t poh, vos_pool_info_t *pinfo);
 int
 vos_pool_query_space(uuid_t pool_id, struct vos_pool_space *vps);
 
+/**
+ * Query pool space by pool UUID from the space counters maintained by VOS,
+ * which are cheap to read and reconciled with the allocators periodically.
+ * The returned free space can be lower than the actual one, and the VEA
+ * attributes and stats aren't filled.
+ *
+ * \param pool_id [IN]	Pool UUID
+ * \param vps     [OUT]	Returned pool space info
+ *
+ * \return		Zero		: success
+ *			-DER_NONEXIST	: pool isn't opened
+ *			-ve		: error
+ */
+int
+vos_pool_query_space_cached(uuid_t pool_id, struct vos_pool_space *vps);
+
 /**
  * Set aside additional "system reserved" space in pool SCM and NVMe
  * (additive to any existing reserved space by vos)
@@ -407,8 +423,21 @@ vos_cont_query(daos_handle_t coh, vos_cont_info_t *cinfo);
 enum {
 	VOS_AGG_FL_FORCE_SCAN	= (1UL << 0),	/* Scan all obj/dkey/akeys */
 	VOS_AGG_FL_FORCE_MERGE	= (1UL << 1),	/* Merge all coalesce-able EV records */
+	VOS_AGG_FL_HOT_ONLY	= (1UL << 2),	/* Only aggregate hot objects */
 };
 
+/**
+ * Check if any object in the container is worth being aggregated before the
+ * next regular aggregation, i.e. the estimated space reclaimed per record
+ * aggregated is high. See VOS_AGG_FL_HOT_ONLY.
+ *
+ * \param coh	[IN]	Container open handle
+ *
+ * \return		True if there are hot objects
+ */
+bool
+vos_aggregate_hot(daos_handle_t coh);
+
 /**
  * Aggregates all epochs within the epoch range \a epr.
  * Data in all these epochs will be aggregated to the last epoch
@@ -421,12 +450,49 @@ enum {
  * \param yield_arg  [IN]	Argument of yield function
  * \param flags      [IN]	Aggregation flags
  *
+ * When \a flags has VOS_AGG_FL_HOT_ONLY, only the hottest objects of the
+ * cost model are aggregated and the 'Highest Aggregated Epoch' isn't updated.
+ *
  * \return			Zero on success, negative value if error
  */
 int
 vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	      bool (*yield_func)(void *arg), void *yield_arg, uint32_t flags);
 
+/**
+ * Aggregate one partition of the objects in the container, the objects are
+ * distributed to \a part_nr partitions by hash of object ID.
+ *
+ * All \a part_nr partitions of the same \a epr can run concurrently in
+ * different ULTs, each one with its own merge window. Unless \a part_nr is
+ * 1, the 'Highest Aggregated Epoch' isn't updated, caller should call
+ * vos_aggregate_hae_update() when all partitions succeeded.
+ *
+ * \param coh	  [IN]		Container open handle
+ * \param epr	  [IN]		The epoch range of aggregation
+ * \param part	  [IN]		Partition to aggregate, less than \a part_nr
+ * \param part_nr	  [IN]		Number of partitions
+ * \param yield_func [IN]	Pointer to customized yield function
+ * \param yield_arg  [IN]	Argument of yield function
+ * \param flags      [IN]	Aggregation flags
+ *
+ * \return			Zero on success, negative value if error
+ */
+int
+vos_aggregate_part(daos_handle_t coh, daos_epoch_range_t *epr, uint32_t part,
+		   uint32_t part_nr, bool (*yield_func)(void *arg),
+		   void *yield_arg, uint32_t flags);
+
+/**
+ * Bump the 'Highest Aggregated Epoch' of the container to \a epoch, if
+ * it's lower than \a epoch.
+ *
+ * \param coh	  [IN]		Container open handle
+ * \param epoch	  [IN]		Epoch aggregated by all partitions
+ */
+void
+vos_aggregate_hae_update(daos_handle_t coh, daos_epoch_t epoch);
+
 /**
  * Discards changes in all epochs with the epoch range \a epr
  *
@@ -1098,6 +1164,22 @@ vos_container_get_msize(void);
 int
 vos_pool_get_scm_cutoff(void);
 
+/** Return the DRAM size of an object in the object cache, including its open
+ *  dkey tree handle but not the optional key Bloom filter
+ */
+int
+vos_obj_get_dram_size(void);
+
+/** Return the DRAM size of an open container, excluding its active DTX
+ *  entries
+ */
+int
+vos_container_get_dram_size(void);
+
+/** Return the number of objects the per-target object cache can hold */
+int
+vos_obj_cache_get_nr(void);
+
 enum vos_pool_opc {
 	/** Reset pool GC statistics */
 	VOS_PO_CTL_RESET_GC,
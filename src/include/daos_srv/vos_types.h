@@ -20,6 +20,8 @@
 struct dtx_rsrvd_uint {
 	void			*dru_scm;
 	d_list_t		dru_nvme;
+	/* Block allocator hint the dru_nvme extents are reserved from */
+	void			*dru_hint;
 };
 
 enum dtx_cos_flags {
@@ -133,6 +135,8 @@ typedef struct {
 	struct vos_pool_space	pif_space;
 	/** garbage collector statistics */
 	struct vos_gc_stat	pif_gc_stat;
+	/** ranges added to PMDK transactions by the calling xstream */
+	struct umem_tx_stats	pif_tx_stats;
 	/** TODO */
 } vos_pool_info_t;
 
@@ -255,6 +259,10 @@ enum {
 	VOS_OF_SKIP_FETCH		= (1 << 18),
 	/** Operation on EC object (currently only applies to update) */
 	VOS_OF_EC			= (1 << 19),
+	/** Fetch at an epoch below which all transactions are committed or
+	 *  aborted, do not record read timestamps
+	 */
+	VOS_OF_SKIP_TS			= (1 << 20),
 };
 
 /** Mask for any conditionals passed to to the fetch */
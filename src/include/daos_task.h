@@ -17,6 +17,7 @@ extern "C" {
 #include <daos_types.h>
 #include <daos_obj.h>
 #include <daos_kv.h>
+#include <daos_pipeline.h>
 #include <daos_array.h>
 #include <daos_errno.h>
 #include <daos_prop.h>
@@ -116,6 +117,12 @@ typedef enum {
 	DAOS_OPC_KV_PUT,
 	DAOS_OPC_KV_REMOVE,
 	DAOS_OPC_KV_LIST,
+	DAOS_OPC_KV_PUT_MULTI,
+	DAOS_OPC_KV_GET_MULTI,
+	DAOS_OPC_KV_SCAN,
+
+	/** Pipeline APIs */
+	DAOS_OPC_PIPELINE_RUN,
 
 	DAOS_OPC_MAX
 } daos_opc_t;
@@ -963,6 +970,64 @@ typedef struct {
 	daos_anchor_t		*anchor;
 } daos_kv_list_t;
 
+/** KV batched put/get args */
+typedef struct {
+	/** KV open handle. */
+	daos_handle_t		oh;
+	/** Transaction open handle. */
+	daos_handle_t		th;
+	/** Operation flags. */
+	uint64_t		flags;
+	/** Number of entries. */
+	unsigned int		nr;
+	/** Key-value entries. */
+	daos_kv_ent_t		*ents;
+} daos_kv_multi_t;
+
+/** KV scan args */
+typedef struct {
+	/** KV open handle. */
+	daos_handle_t		oh;
+	/** Transaction open handle. */
+	daos_handle_t		th;
+	/** Predicates, NULL for none. */
+	const daos_kv_filter_t	*filter;
+	/*
+	 * [in]: number of key descriptors in \a kds.
+	 * [out]: number of returned key descriptors.
+	 */
+	uint32_t		*nr;
+	/** key descriptors. */
+	daos_key_desc_t		*kds;
+	/** memory descriptors. */
+	d_sg_list_t		*sgl;
+	/** Hash anchor for the next call. */
+	daos_anchor_t		*anchor;
+} daos_kv_scan_t;
+
+/** Pipeline run args */
+typedef struct {
+	/** Object open handle. */
+	daos_handle_t		oh;
+	/** Transaction open handle. */
+	daos_handle_t		th;
+	/** Conditions and aggregations. */
+	const daos_pipeline_t	*pipeline;
+	/** Hash anchor for the next call. */
+	daos_anchor_t		*anchor;
+	/*
+	 * [in]: number of key descriptors in \a kds.
+	 * [out]: number of matching dkeys.
+	 */
+	uint32_t		*nr;
+	/** key descriptors. */
+	daos_key_desc_t		*kds;
+	/** memory descriptors. */
+	d_sg_list_t		*sgl;
+	/** Accumulated results. */
+	daos_pipeline_stats_t	*stats;
+} daos_pipeline_run_t;
+
 /**
  * Create an asynchronous task and associate it with a daos client operation.
  * For synchronous operations please use the specific API for that operation.
@@ -198,6 +198,20 @@ enum d_hash_feats {
 	 */
 	D_HASH_FT_LRU		= (1 << 4),
 
+	/**
+	 * If the RESIZE bit is set:
+	 * The number of buckets doubles once the average chain length exceeds
+	 * D_HASH_RESIZE_LOAD. Records are moved to the new buckets
+	 * incrementally, one lock stripe at a time, by the insert/find calls
+	 * following the growth, so no single call pays for the whole rehash.
+	 * The number of bucket locks is fixed at creation, each lock protects
+	 * a stripe of buckets.
+	 *
+	 * hop_rec_hash() is mandatory, and hop_key_hash()/hop_rec_hash() must
+	 * return the full hash value rather than a bucket index.
+	 */
+	D_HASH_FT_RESIZE	= (1 << 5),
+
 	/**
 	 * Use Global Table Lock instead of per bucket locking.
 	 * TODO: should be removed when all will use per bucket locking.
@@ -218,6 +232,11 @@ struct d_hash_bucket {
 #endif
 };
 
+/** D_HASH_FT_RESIZE: average chain length triggering a growth */
+#define D_HASH_RESIZE_LOAD	4
+/** D_HASH_FT_RESIZE: the table doesn't grow beyond power2(bits) buckets */
+#define D_HASH_RESIZE_BITS_MAX	24
+
 struct d_hash_table {
 	/** different type of locks based on ht_feats */
 	union d_hash_lock	 ht_lock;
@@ -225,6 +244,20 @@ struct d_hash_table {
 	uint32_t		 ht_bits;
 	/** feature bits */
 	uint32_t		 ht_feats;
+	/** bits to generate number of bucket locks, fixed at creation */
+	uint32_t		 ht_lock_bits;
+	/** D_HASH_FT_RESIZE: number of hash records */
+	uint32_t		 ht_nr_recs;
+	/** D_HASH_FT_RESIZE: number of times the table has grown */
+	uint32_t		 ht_resizes;
+	/** D_HASH_FT_RESIZE: a growth is in progress */
+	uint32_t		 ht_rs_busy;
+	/** D_HASH_FT_RESIZE: bits of ht_rs_buckets */
+	uint32_t		 ht_rs_bits;
+	/** D_HASH_FT_RESIZE: next lock stripe to move to ht_rs_buckets */
+	uint32_t		 ht_rs_next;
+	/** D_HASH_FT_RESIZE: number of lock stripes moved to ht_rs_buckets */
+	uint32_t		 ht_rs_moved;
 #if D_HASH_DEBUG
 	/** maximum search depth ever */
 	unsigned int		 ht_dep_max;
@@ -241,6 +274,27 @@ struct d_hash_table {
 	struct d_hash_bucket	*ht_buckets;
 	/** different type of locks based on ht_feats */
 	union d_hash_lock	*ht_locks;
+	/** D_HASH_FT_RESIZE: buckets being populated by the ongoing growth */
+	struct d_hash_bucket	*ht_rs_buckets;
+	/**
+	 * D_HASH_FT_RESIZE: per lock stripe, records of the stripe have been
+	 * moved to ht_rs_buckets
+	 */
+	bool			*ht_rs_done;
+};
+
+/** Bucket statistics of a hash table, see d_hash_table_stats() */
+struct d_hash_stats {
+	/** number of hash records */
+	uint32_t		hs_nr;
+	/** number of buckets */
+	uint32_t		hs_buckets;
+	/** number of non-empty buckets */
+	uint32_t		hs_used;
+	/** length of the longest chain */
+	uint32_t		hs_chain_max;
+	/** number of times the table has grown, D_HASH_FT_RESIZE only */
+	uint32_t		hs_resizes;
 };
 
 /**
@@ -508,6 +562,17 @@ d_list_t *d_hash_rec_first(struct d_hash_table *htable);
  */
 void d_hash_table_debug(struct d_hash_table *htable);
 
+/**
+ * Collect bucket statistics of a hash table, e.g. to export chain lengths
+ * via telemetry. Buckets are scanned one lock stripe at a time, so the result
+ * is not an atomic snapshot of a table being modified concurrently.
+ *
+ * \param[in] htable		Pointer to the hash table
+ * \param[out] stats		Returned statistics
+ */
+void d_hash_table_stats(struct d_hash_table *htable,
+			struct d_hash_stats *stats);
+
 /******************************************************************************
  * DAOS Handle Hash Table Wrapper
  *
@@ -10,6 +10,7 @@
 #include <pthread.h>
 #include <stdbool.h>
 #include <gurt/list.h>
+#include <gurt/atomic.h>
 
 /* A data structure used to describe and register a type */
 struct d_slab_reg {
@@ -33,6 +34,8 @@ struct d_slab_reg {
 	int	sr_max_desc;
 	/* Maximum number of descriptors to exist on the free_list */
 	int	sr_max_free_desc;
+	/* Number of descriptors cached per thread, see d_slab_type */
+	int	sr_mag_size;
 };
 
 /* If max_desc is non-zero then at most max_desc descriptors can exist
@@ -41,6 +44,17 @@ struct d_slab_reg {
  * however once max_desc is reached no more descriptors will be created.
  */
 
+/* If mag_size is non-zero then each thread caches up to mag_size free and
+ * mag_size released descriptors in a magazine.  Acquire and release use the
+ * magazine of the calling thread without taking the type lock, which is only
+ * taken to exchange a batch of mag_size descriptors with the shared lists.
+ * Descriptors released by a thread are reset and reused by the same thread
+ * first, so they stay local to the NUMA node that allocated them.  The free
+ * descriptors cached by magazines count against max_free_desc.  All types
+ * share a single thread key, so there is no limit on the number of types
+ * using magazines.
+ */
+
 #define POOL_TYPE_INIT(itype, imember) .sr_size = sizeof(struct itype),	\
 		.sr_offset = offsetof(struct itype, imember),		\
 		.sr_name = #itype,
@@ -72,6 +86,13 @@ struct d_slab_type {
 	/* Number of sequental calls to acquire() without a call to restock() */
 	int			st_no_restock; /* Current count */
 	int			st_no_restock_hwm; /* High water mark */
+
+	/* Per-thread magazines, only used if sr_mag_size is set */
+	int			st_mag_id; /* Index in the thread magazines */
+	ATOMIC int		st_mag_free_count; /* Free in magazines */
+	d_list_t		st_mag_list;
+	int			st_mag_fill; /* Batches moved to a magazine */
+	int			st_mag_flush; /* Batches moved from a magazine */
 };
 
 struct d_slab {
@@ -28,6 +28,8 @@ int d_tm_get_num_buckets(struct d_tm_context *ctx,
 int d_tm_get_bucket_range(struct d_tm_context *ctx,
 			  struct d_tm_bucket_t *bucket, int bucket_id,
 			  struct d_tm_node_t *node);
+int d_tm_get_quantile(struct d_tm_context *ctx, uint64_t *val,
+		      double quantile, struct d_tm_node_t *node);
 
 /* Developer facing client API to discover topology and manage results */
 struct d_tm_context *d_tm_open(int id);
@@ -481,64 +481,161 @@ tgt_vos_create_one(void *varg)
 	return rc;
 }
 
-static int
-tgt_vos_preallocate(uuid_t uuid, daos_size_t scm_size, int tgt_nr)
+struct tgt_prealloc_arg {
+	unsigned char		*tpa_uuid;
+	struct dss_xstream	*tpa_dx;
+	daos_size_t		 tpa_scm_size;
+	pthread_t		 tpa_thread;
+	int			 tpa_tgt_id;
+	int			 tpa_fd;
+	char			*tpa_path;
+	int			 tpa_rc;
+	bool			 tpa_started;
+};
+
+static void
+tgt_vos_preallocate_cleanup(void *arg)
 {
-	char			*path = NULL;
+	struct tgt_prealloc_arg	*tpa = arg;
+
+	if (tpa->tpa_fd != -1)
+		(void)close(tpa->tpa_fd);
+	tpa->tpa_fd = -1;
+	D_FREE(tpa->tpa_path);
+}
+
+static void *
+tgt_vos_preallocate_one(void *arg)
+{
+	struct tgt_prealloc_arg	*tpa = arg;
+	unsigned char		*uuid = tpa->tpa_uuid;
+	char			*path;
+	int			 rc;
+
+	/**
+	 * Run on the target's own core so that the backing pages are
+	 * allocated on its NUMA node.
+	 */
+	if (tpa->tpa_dx != NULL)
+		(void)dss_xstream_set_affinity(tpa->tpa_dx);
+
+	pthread_cleanup_push(tgt_vos_preallocate_cleanup, tpa);
+
+	rc = path_gen(uuid, newborns_path, VOS_FILE, &tpa->tpa_tgt_id,
+		      &tpa->tpa_path);
+	if (rc)
+		goto out;
+	path = tpa->tpa_path;
+
+	D_DEBUG(DB_MGMT, DF_UUID": creating vos file %s\n",
+		DP_UUID(uuid), path);
+
+	tpa->tpa_fd = open(path, O_CREAT|O_RDWR, 0600);
+	if (tpa->tpa_fd < 0) {
+		rc = daos_errno2der(errno);
+		D_ERROR(DF_UUID": failed to create vos file %s: "
+			DF_RC"\n", DP_UUID(uuid), path, DP_RC(rc));
+		goto out;
+	}
+
+	/**
+	 * Pre-allocate blocks for vos files in order to provide
+	 * consistent performance and avoid entering into the backend
+	 * filesystem allocator through page faults.
+	 * Use fallocate(2) instead of posix_fallocate(3) since the
+	 * latter is bogus with tmpfs.
+	 */
+	rc = fallocate(tpa->tpa_fd, 0, 0, tpa->tpa_scm_size);
+	if (rc) {
+		rc = daos_errno2der(errno);
+		D_ERROR(DF_UUID": failed to allocate vos file %s with "
+			"size: "DF_U64": "DF_RC"\n",
+			DP_UUID(uuid), path, tpa->tpa_scm_size, DP_RC(rc));
+		goto out;
+	}
+
+	rc = fsync(tpa->tpa_fd);
+	if (rc) {
+		rc = daos_errno2der(errno);
+		D_ERROR(DF_UUID": failed to sync vos pool %s: "
+			DF_RC"\n", DP_UUID(uuid), path, DP_RC(rc));
+		goto out;
+	}
+	D_DEBUG(DB_MGMT, DF_UUID": vos file %s allocated\n",
+		DP_UUID(uuid), path);
+out:
+	tpa->tpa_rc = rc;
+	pthread_cleanup_pop(1);
+	return NULL;
+}
+
+static void
+tgt_vos_preallocate_join(void *arg)
+{
+	struct tgt_prealloc_arg	*tpas = arg;
 	int			 i;
-	int			 fd = -1;
-	int			 rc = 0;
 
-	for (i = 0; i < tgt_nr; i++) {
-		rc = path_gen(uuid, newborns_path, VOS_FILE, &i, &path);
-		if (rc)
-			break;
+	/** tpa_tgt_id of a slot not used by this pool creation is -1 */
+	for (i = 0; i < dss_tgt_nr && tpas[i].tpa_tgt_id >= 0; i++) {
+		if (!tpas[i].tpa_started)
+			continue;
+		(void)pthread_cancel(tpas[i].tpa_thread);
+		(void)pthread_join(tpas[i].tpa_thread, NULL);
+		tpas[i].tpa_started = false;
+	}
+	D_FREE(tpas);
+}
 
-		D_DEBUG(DB_MGMT, DF_UUID": creating vos file %s\n",
-			DP_UUID(uuid), path);
+/**
+ * Allocate the VOS files of all targets concurrently, one thread per file,
+ * since fallocate(2) on tmpfs zeroes every page and is mostly CPU bound.
+ * If the calling thread get canceled, the allocating threads are canceled
+ * and joined before it exits.
+ */
+static int
+tgt_vos_preallocate(uuid_t uuid, daos_size_t scm_size, int tgt_nr,
+		    struct dss_xstream **dxs)
+{
+	struct tgt_prealloc_arg	*tpas;
+	int			 i;
+	int			 rc = 0;
 
-		fd = open(path, O_CREAT|O_RDWR, 0600);
-		if (fd < 0) {
-			rc = daos_errno2der(errno);
-			D_ERROR(DF_UUID": failed to create vos file %s: "
-				DF_RC"\n", DP_UUID(uuid), path, DP_RC(rc));
-			break;
-		}
+	D_ASSERT(tgt_nr <= dss_tgt_nr);
+	D_ALLOC_ARRAY(tpas, dss_tgt_nr);
+	if (tpas == NULL)
+		return -DER_NOMEM;
 
-		/** Align to 4K or locking the region based on the size will fail */
-		scm_size = D_ALIGNUP(scm_size, 1ULL << 12);
-		/**
-		 * Pre-allocate blocks for vos files in order to provide
-		 * consistent performance and avoid entering into the backend
-		 * filesystem allocator through page faults.
-		 * Use fallocate(2) instead of posix_fallocate(3) since the
-		 * latter is bogus with tmpfs.
-		 */
-		rc = fallocate(fd, 0, 0, scm_size);
-		if (rc) {
-			rc = daos_errno2der(errno);
-			D_ERROR(DF_UUID": failed to allocate vos file %s with "
-				"size: "DF_U64": "DF_RC"\n",
-				DP_UUID(uuid), path, scm_size, DP_RC(rc));
-			break;
-		}
+	/** Align to 4K or locking the region based on the size will fail */
+	scm_size = D_ALIGNUP(scm_size, 1ULL << 12);
+	for (i = 0; i < dss_tgt_nr; i++) {
+		tpas[i].tpa_uuid = uuid;
+		tpas[i].tpa_dx = dxs != NULL ? dxs[i] : NULL;
+		tpas[i].tpa_scm_size = scm_size;
+		tpas[i].tpa_tgt_id = i < tgt_nr ? i : -1;
+		tpas[i].tpa_fd = -1;
+	}
 
-		rc = fsync(fd);
-		(void)close(fd);
-		fd = -1;
+	pthread_cleanup_push(tgt_vos_preallocate_join, tpas);
+	for (i = 0; i < tgt_nr; i++) {
+		rc = pthread_create(&tpas[i].tpa_thread, NULL,
+				    tgt_vos_preallocate_one, &tpas[i]);
 		if (rc) {
-			rc = daos_errno2der(errno);
-			D_ERROR(DF_UUID": failed to sync vos pool %s: "
-				DF_RC"\n", DP_UUID(uuid), path, DP_RC(rc));
+			rc = daos_errno2der(rc);
+			D_ERROR(DF_UUID": failed to create thread for vos file "
+				"%d: "DF_RC"\n", DP_UUID(uuid), i, DP_RC(rc));
 			break;
 		}
-		D_FREE(path);
+		tpas[i].tpa_started = true;
 	}
 
-	if (fd != -1)
-		close(fd);
-
-	D_FREE(path);
+	for (i = 0; i < tgt_nr && tpas[i].tpa_started; i++) {
+		(void)pthread_join(tpas[i].tpa_thread, NULL);
+		tpas[i].tpa_started = false;
+		if (rc == 0)
+			rc = tpas[i].tpa_rc;
+	}
+	/** join any thread left and release the arguments */
+	pthread_cleanup_pop(1);
 	return rc;
 }
 
@@ -605,11 +702,22 @@ struct tgt_create_args {
 	char			*tca_path;
 	struct ds_pooltgts_rec	*tca_ptrec;
 	struct dss_xstream	*tca_dx;
+	/** xstream of each target, indexed by target ID */
+	struct dss_xstream	**tca_dxs;
 	daos_size_t		 tca_scm_size;
 	daos_size_t		 tca_nvme_size;
 	int			 tca_rc;
 };
 
+static int
+tgt_xstream_get(void *arg)
+{
+	struct dss_xstream	**dxs = arg;
+
+	dxs[dss_get_module_info()->dmi_tgt_id] = dss_current_xstream();
+	return 0;
+}
+
 static void *
 tgt_create_preallocate(void *arg)
 {
@@ -660,7 +768,7 @@ tgt_create_preallocate(void *arg)
 		D_ASSERT(dss_tgt_nr > 0);
 		rc = tgt_vos_preallocate(tca->tca_ptrec->dptr_uuid,
 					 max(tca->tca_scm_size / dss_tgt_nr,
-					     1 << 24), dss_tgt_nr);
+					     1 << 24), dss_tgt_nr, tca->tca_dxs);
 		if (rc)
 			goto out;
 	} else {
@@ -725,6 +833,15 @@ ds_mgmt_hdlr_tgt_create(crt_rpc_t *tc_req)
 	tca.tca_scm_size  = tc_in->tc_scm_size;
 	tca.tca_nvme_size = tc_in->tc_nvme_size;
 	tca.tca_dx = dss_current_xstream();
+	D_ALLOC_ARRAY(tca.tca_dxs, dss_tgt_nr);
+	if (tca.tca_dxs == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	rc = dss_thread_collective(tgt_xstream_get, tca.tca_dxs, 0);
+	if (rc) {
+		D_ERROR(DF_UUID": failed to collect target xstreams: "DF_RC"\n",
+			DP_UUID(tc_in->tc_pool_uuid), DP_RC(rc));
+		goto out;
+	}
 	rc = pthread_create(&thread, NULL, tgt_create_preallocate, &tca);
 	if (rc) {
 		rc = daos_errno2der(errno);
@@ -823,6 +940,7 @@ out:
 	}
 	D_FREE(tca.tca_newborn);
 	D_FREE(tca.tca_path);
+	D_FREE(tca.tca_dxs);
 	ABT_mutex_lock(pooltgts->dpt_mutex);
 	d_hash_rec_delete_at(&pooltgts->dpt_creates_ht,
 			     &tca.tca_ptrec->dptr_hlink);
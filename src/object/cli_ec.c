@@ -82,8 +82,9 @@ obj_ec_pbufs_init(struct obj_ec_recx_array *recxs, uint64_t cell_bytes)
 	if (recxs->oer_stripe_total == 0)
 		return 0;
 
+	/* no need to zero it, the encoding overwrites all of the parity */
 	parity_len = roundup(recxs->oer_stripe_total * cell_bytes, 8);
-	D_ALLOC(pbuf, parity_len * recxs->oer_p);
+	D_ALLOC_NZ(pbuf, parity_len * recxs->oer_p);
 	if (pbuf == NULL)
 		return -DER_NOMEM;
 
@@ -463,29 +464,32 @@ out:
 	return rc;
 }
 
-/** Encode one full stripe, the result parity buffer will be filled. */
+/**
+ * Encode one full stripe, the result parity buffer will be filled.
+ * The cells not contiguous in the sgl are copied into \a c_buf, the copy
+ * buffer of k cells shared by all the stripes of the recx array; it is
+ * allocated on first use and freed by the caller.
+ */
 static int
 obj_ec_stripe_encode(daos_iod_t *iod, d_sg_list_t *sgl, uint32_t iov_idx,
 		     size_t iov_off, struct obj_ec_codec *codec,
 		     struct daos_oclass_attr *oca, uint64_t cell_bytes,
-		     unsigned char *parity_bufs[])
+		     unsigned char *parity_bufs[], unsigned char **c_buf)
 {
 	uint64_t			 len = cell_bytes;
 	unsigned int			 k = oca->u.ec.e_k;
 	unsigned int			 p = oca->u.ec.e_p;
 	unsigned char			*data[k];
-	unsigned char			*c_data[k]; /* copied data */
+	unsigned char			*c_data; /* copied data */
 	unsigned char			*from;
 	struct obj_ec_singv_local	 loc = {0};
 	bool				 with_padding = false;
 	int				 i, c_idx = 0;
-	int				 rc = 0;
 
 	if (iod->iod_type == DAOS_IOD_SINGLE)
 		obj_ec_singv_local_sz(iod->iod_size, oca, k - 1, &loc, true);
 
 	for (i = 0; i < k; i++) {
-		c_data[i] = NULL;
 		/* for singv the last data target may need padding of zero */
 		if (i == k - 1) {
 			len = cell_bytes - loc.esl_bytes_pad;
@@ -500,9 +504,14 @@ obj_ec_stripe_encode(daos_iod_t *iod, d_sg_list_t *sgl, uint32_t iov_idx,
 		} else {
 			uint64_t copied = 0;
 
-			D_ALLOC(c_data[c_idx], cell_bytes);
-			if (c_data[c_idx] == NULL)
-				D_GOTO(out, rc = -DER_NOMEM);
+			if (*c_buf == NULL) {
+				D_ALLOC_NZ(*c_buf, cell_bytes * k);
+				if (*c_buf == NULL)
+					return -DER_NOMEM;
+			}
+			c_data = *c_buf + c_idx * cell_bytes;
+			if (with_padding)
+				memset(&c_data[len], 0, cell_bytes - len);
 			while (copied < len) {
 				uint64_t left;
 				uint64_t cp_len;
@@ -515,25 +524,22 @@ obj_ec_stripe_encode(daos_iod_t *iod, d_sg_list_t *sgl, uint32_t iov_idx,
 					daos_sgl_next_iov(iov_idx, iov_off);
 				} else {
 					from = sgl->sg_iovs[iov_idx].iov_buf;
-					memcpy(&c_data[c_idx][copied],
+					memcpy(&c_data[copied],
 					       &from[iov_off], cp_len);
 					daos_sgl_move(sgl, iov_idx, iov_off,
 						      cp_len);
 					copied += cp_len;
 				}
 				if (copied < len && iov_idx >= sgl->sg_nr)
-					D_GOTO(out, rc = -DER_REC2BIG);
+					return -DER_REC2BIG;
 			}
-			data[i] = c_data[c_idx++];
+			data[i] = c_data;
+			c_idx++;
 		}
 	}
 
 	ec_encode_data(cell_bytes, k, p, codec->ec_gftbls, data, parity_bufs);
-
-out:
-	for (i = 0; i < c_idx; i++)
-		D_FREE(c_data[i]);
-	return rc;
+	return 0;
 }
 
 static struct obj_ec_codec *
@@ -562,6 +568,7 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 	struct obj_ec_recx	*ec_recx;
 	unsigned int		 p = oca->u.ec.e_p;
 	unsigned char		*parity_buf[p];
+	unsigned char		*c_buf = NULL;
 	uint64_t		 cell_bytes, stripe_bytes;
 	uint32_t		 iov_idx = 0;
 	uint64_t		 iov_off = 0, last_off = 0;
@@ -607,7 +614,7 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 #endif
 			rc = obj_ec_stripe_encode(iod, sgl, iov_idx, iov_off,
 						  codec, oca, cell_bytes,
-						  parity_buf);
+						  parity_buf, &c_buf);
 			if (rc) {
 				D_ERROR("stripe encoding failed rc %d.\n", rc);
 				goto out;
@@ -621,6 +628,7 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 	}
 
 out:
+	D_FREE(c_buf);
 	return rc;
 }
 
@@ -2019,6 +2027,70 @@ obj_ec_err_match(uint32_t nerrs, uint32_t *err_list1, uint32_t *err_list2)
 	return true;
 }
 
+/** protects obj_ec_codec::ec_recov of all the codecs */
+static pthread_mutex_t ec_recov_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void
+obj_ec_recov_codec_copy(struct obj_ec_recov_codec *dst,
+			struct obj_ec_recov_codec *src, uint32_t k, uint32_t p)
+{
+	memcpy(dst->er_gftbls, src->er_gftbls, k * src->er_nerrs * 32);
+	memcpy(dst->er_dec_idx, src->er_dec_idx, sizeof(uint32_t) * k);
+	memcpy(dst->er_err_list, src->er_err_list,
+	       sizeof(uint32_t) * src->er_nerrs);
+	memcpy(dst->er_in_err, src->er_in_err, sizeof(bool) * (k + p));
+	dst->er_nerrs = src->er_nerrs;
+	dst->er_data_nerrs = src->er_data_nerrs;
+}
+
+/**
+ * Degraded fetches of a class mostly hit the same single failed target, so the
+ * decode tables of single target failures are computed once and cached in the
+ * codec, the matrix inversion is skipped for following fetches.
+ */
+static bool
+obj_ec_recov_cache_get(struct obj_ec_codec *codec, uint32_t tgt,
+		       struct obj_ec_recov_codec *recov, uint32_t k, uint32_t p)
+{
+	struct obj_ec_recov_codec	*cached = NULL;
+
+	D_MUTEX_LOCK(&ec_recov_cache_lock);
+	if (codec->ec_recov != NULL)
+		cached = codec->ec_recov[tgt];
+	if (cached != NULL)
+		obj_ec_recov_codec_copy(recov, cached, k, p);
+	D_MUTEX_UNLOCK(&ec_recov_cache_lock);
+
+	return cached != NULL;
+}
+
+static void
+obj_ec_recov_cache_put(struct obj_ec_codec *codec,
+		       struct daos_oclass_attr *oca,
+		       struct obj_ec_recov_codec *recov, uint32_t k, uint32_t p)
+{
+	struct obj_ec_recov_codec	*cached;
+	uint32_t			 tgt = recov->er_err_list[0];
+
+	D_MUTEX_LOCK(&ec_recov_cache_lock);
+	if (codec->ec_recov == NULL) {
+		D_ALLOC_ARRAY(codec->ec_recov, OBJ_EC_MAX_M);
+		if (codec->ec_recov == NULL)
+			goto out;
+	}
+	if (codec->ec_recov[tgt] != NULL)
+		goto out;
+
+	/* failing to cache is fine, the tables are computed again next time */
+	cached = obj_ec_recov_codec_alloc(oca);
+	if (cached == NULL)
+		goto out;
+	obj_ec_recov_codec_copy(cached, recov, k, p);
+	codec->ec_recov[tgt] = cached;
+out:
+	D_MUTEX_UNLOCK(&ec_recov_cache_lock);
+}
+
 static int
 obj_ec_recov_codec_init(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 			uint32_t nerrs, uint32_t *err_list)
@@ -2051,6 +2123,10 @@ obj_ec_recov_codec_init(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 	if (codec == NULL)
 		return -DER_INVAL;
 
+	if (nerrs == 1 &&
+	    obj_ec_recov_cache_get(codec, err_list[0], recov, k, p))
+		return 0;
+
 	/* init the err status */
 	recov->er_nerrs = nerrs;
 	recov->er_data_nerrs = 0;
@@ -2105,6 +2181,10 @@ obj_ec_recov_codec_init(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 
 	ec_init_tables(k, recov->er_nerrs, recov->er_de_matrix,
 		       recov->er_gftbls);
+	/* p was reused as loop index above */
+	if (nerrs == 1)
+		obj_ec_recov_cache_put(codec, oca, recov, k,
+				       obj_ec_parity_tgt_nr(oca));
 
 	return 0;
 }
@@ -16,6 +16,45 @@
 #include "obj_internal.h"
 
 unsigned int	srv_io_mode = DIM_DTX_FULL_ENABLED;
+unsigned int	obj_bulk_limit = DAOS_BULK_LIMIT;
+struct dc_obj_metrics	dc_obj_metrics;
+
+/* Nothing is registered (-DER_UNINIT) unless client telemetry is enabled */
+static void
+dc_obj_metrics_init(void)
+{
+	struct dc_obj_metrics	*om = &dc_obj_metrics;
+	int			 opc;
+	int			 rc;
+
+	for (opc = 0; opc < OBJ_PROTO_CLI_COUNT; opc++) {
+		rc = d_tm_add_metric(&om->dom_op_cnt[opc], D_TM_COUNTER,
+				     "number of completed object operations", "ops",
+				     "client/obj/%s/ops", obj_opc_to_str(opc));
+		if (rc == -DER_UNINIT)
+			return;
+		if (rc)
+			D_WARN("Failed to create ops counter: "DF_RC"\n", DP_RC(rc));
+	}
+
+	rc = d_tm_add_metric(&om->dom_retries, D_TM_COUNTER,
+			     "number of retried object I/Os", "ops",
+			     "client/obj/retries");
+	if (rc)
+		D_WARN("Failed to create retries sensor: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&om->dom_map_refresh, D_TM_COUNTER,
+			     "number of pool map refreshes triggered by object I/Os",
+			     "refreshes", "client/obj/map_refresh");
+	if (rc)
+		D_WARN("Failed to create map refresh sensor: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&om->dom_bulk_reg, D_TM_STATS_GAUGE,
+			     "bulk handles registration time", "us",
+			     "client/obj/bulk_reg");
+	if (rc)
+		D_WARN("Failed to create bulk reg sensor: "DF_RC"\n", DP_RC(rc));
+}
 
 /**
  * Initialize object interface
@@ -35,6 +74,18 @@ dc_obj_init(void)
 		D_DEBUG(DB_IO, "Full dtx mode by default\n");
 	}
 
+	/*
+	 * Data under this size is packed in the update/fetch RPC itself, it
+	 * can be lowered for fabrics where RDMA wins earlier, but not raised
+	 * beyond what fits in an RPC.
+	 */
+	d_getenv_int("DAOS_OBJ_BULK_LIMIT", &obj_bulk_limit);
+	if (obj_bulk_limit == 0 || obj_bulk_limit > DAOS_BULK_LIMIT)
+		obj_bulk_limit = DAOS_BULK_LIMIT;
+	D_DEBUG(DB_IO, "inline update/fetch up to %u bytes\n", obj_bulk_limit);
+
+	dc_obj_metrics_init();
+
 	rc = obj_utils_init();
 	if (rc)
 		D_GOTO(out, rc);
@@ -533,6 +533,7 @@ obj_grp_valid_shard_get(struct dc_object *obj, int grp_idx,
 	int grp_start;
 	int idx;
 	int grp_size;
+	int cand = -1;
 	int i = 0;
 
 	grp_size = obj_get_grp_size(obj);
@@ -580,19 +581,31 @@ obj_grp_valid_shard_get(struct dc_object *obj, int grp_idx,
 			continue;
 
 		/* Skip the invalid shards and targets */
-		if (obj->cob_shards->do_shards[index].do_target_id != -1 ||
-		    obj->cob_shards->do_shards[index].do_shard != -1) {
-			idx = index;
-			break;
+		if (obj->cob_shards->do_shards[index].do_target_id == -1 &&
+		    obj->cob_shards->do_shards[index].do_shard == -1)
+			continue;
+
+		/*
+		 * Of the first two valid shards from the random offset, take
+		 * the one whose target has fewer of our RPCs in flight, so that
+		 * hot objects are read from the least busy replicas.
+		 */
+		if (cand < 0) {
+			cand = index;
+			continue;
 		}
+		if (obj_tgt_load(tgt_id) <
+		    obj_tgt_load(obj->cob_shards->do_shards[cand].do_target_id))
+			cand = index;
+		break;
 	}
 
 	D_RWLOCK_UNLOCK(&obj->cob_lock);
 
-	if (i == grp_size)
+	if (cand < 0)
 		return -DER_NONEXIST;
 
-	return idx;
+	return cand;
 }
 
 static int
@@ -1628,12 +1641,26 @@ obj_retry_cb(tse_task_t *task, struct dc_object *obj,
 	bool		  keep_result = false;
 
 	if (pmap_stale) {
-		rc = obj_pool_query_task(sched, obj, 0, &pool_task);
+		unsigned int	map_ver = 0;
+
+		/*
+		 * Every reply carries the engine's pool map version, so a
+		 * version bump reaches us on the next RPC even when it
+		 * succeeded. Hand the advertised version to the refresh:
+		 * once the map is cached at that version, the I/Os that
+		 * raced on the same bump complete without querying the
+		 * pool service again.
+		 */
+		if (obj_auxi->map_ver_reply > obj_auxi->map_ver_req)
+			map_ver = obj_auxi->map_ver_reply;
+		rc = obj_pool_query_task(sched, obj, map_ver, &pool_task);
 		if (rc != 0)
 			D_GOTO(err, rc);
+		d_tm_inc_counter(dc_obj_metrics.dom_map_refresh, 1);
 	}
 
 	if (obj_auxi->io_retry) {
+		d_tm_inc_counter(dc_obj_metrics.dom_retries, 1);
 		if (pool_task != NULL) {
 			rc = dc_task_depend(task, 1, &pool_task);
 			if (rc != 0) {
@@ -1815,6 +1842,7 @@ obj_bulk_prep(d_sg_list_t *sgls, unsigned int nr, bool bulk_bind,
 	      crt_bulk_t **p_bulks)
 {
 	crt_bulk_t	*bulks;
+	uint64_t	 start = 0;
 	int		 i = 0;
 	int		 rc = 0;
 
@@ -1823,6 +1851,9 @@ obj_bulk_prep(d_sg_list_t *sgls, unsigned int nr, bool bulk_bind,
 	if (bulks == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
+	if (dc_obj_metrics.dom_bulk_reg != NULL)
+		start = daos_get_ntime();
+
 	/* create bulk handles for sgls */
 	for (; sgls != NULL && i < nr; i++) {
 		if (sgls[i].sg_iovs != NULL &&
@@ -1841,6 +1872,9 @@ obj_bulk_prep(d_sg_list_t *sgls, unsigned int nr, bool bulk_bind,
 
 out:
 	if (rc == 0) {
+		if (start != 0)
+			d_tm_set_gauge(dc_obj_metrics.dom_bulk_reg,
+				       (daos_get_ntime() - start) / NSEC_PER_USEC);
 		*p_bulks = bulks;
 	} else {
 		int j;
@@ -1892,7 +1926,7 @@ obj_rw_bulk_prep(struct dc_object *obj, daos_iod_t *iods, d_sg_list_t *sgls,
 	 * if need bulk transferring.
 	 */
 	sgls_size = daos_sgls_packed_size(sgls, nr, NULL);
-	if (sgls_size >= DAOS_BULK_LIMIT || obj_auxi->reasb_req.orr_tgt_nr > 1) {
+	if (sgls_size >= obj_bulk_limit || obj_auxi->reasb_req.orr_tgt_nr > 1) {
 		bulk_perm = update ? CRT_BULK_RO : CRT_BULK_RW;
 		rc = obj_bulk_prep(sgls, nr, bulk_bind, bulk_perm, task,
 				   &obj_auxi->bulks);
@@ -4192,6 +4226,9 @@ obj_comp_cb(tse_task_t *task, void *data)
 		}
 	}
 
+	if (!io_task_reinited)
+		d_tm_inc_counter(dc_obj_metrics.dom_op_cnt[obj_auxi->opc], 1);
+
 	obj_decref(obj);
 	return 0;
 }
@@ -104,8 +104,12 @@ struct rw_cb_args {
 	daos_iom_t		*maps;
 	crt_endpoint_t		tgt_ep;
 	struct shard_rw_args	*shard_args;
+	/** target accounted in obj_tgt_inflight */
+	uint32_t		tgt_id;
 };
 
+ATOMIC uint32_t obj_tgt_inflight[OBJ_TGT_LOAD_SLOTS];
+
 static struct dcs_layout *
 dc_rw_cb_singv_lo_get(daos_iod_t *iods, d_sg_list_t *sgls, uint32_t iod_nr,
 		      struct obj_reasb_req *reasb_req)
@@ -854,6 +858,7 @@ dc_rw_cb(tse_task_t *task, void *arg)
 	int			 i;
 	int			 rc = 0;
 
+	obj_tgt_load_sub(rw_args->tgt_id);
 	opc = opc_get(rw_args->rpc->cr_opc);
 	D_DEBUG(DB_IO, "rpc %p opc:%d completed, dt_result %d.\n",
 		rw_args->rpc, opc, ret);
@@ -1333,10 +1338,13 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	if (DAOS_FAIL_CHECK(DAOS_SHARD_OBJ_RW_CRT_ERROR))
 		D_GOTO(out_args, rc = -DER_HG);
 
+	rw_args.tgt_id = shard->do_target_id;
 	rc = tse_task_register_comp_cb(task, dc_rw_cb, &rw_args,
 				       sizeof(rw_args));
 	if (rc != 0)
 		D_GOTO(out_args, rc);
+	/* dropped by dc_rw_cb, which runs however the RPC completes */
+	obj_tgt_load_add(rw_args.tgt_id);
 
 	if (daos_io_bypass & IOBP_CLI_RPC) {
 		rc = daos_rpc_complete(req, task);
@@ -2230,8 +2238,11 @@ obj_shard_query_key_cb(tse_task_t *task, void *data)
 	if (check && flags & DAOS_GET_RECX) {
 		bool get_max = (okqi->okqi_api_flags & DAOS_GET_MAX);
 
-		/** if first cb, set recx */
-		if (!first && !changed)
+		/**
+		 * if first cb, set recx. A specified dkey is only queried on
+		 * one replica, or on the data shards of an EC object.
+		 */
+		if ((flags & DAOS_GET_DKEY) && !first && !changed)
 			D_ASSERT(is_ec_obj);
 
 		obj_shard_query_recx_post(cb_args, okqi->okqi_oid.id_shard,
@@ -352,7 +352,7 @@ obj_ec_codec_fini(void)
 	struct obj_ec_codec	*ec_codec;
 	struct daos_obj_class	*oc;
 	int			 ocnr = 0;
-	int			 i;
+	int			 i, j;
 
 	if (ecc_array) {
 		D_FREE(ecc_array);
@@ -376,6 +376,11 @@ obj_ec_codec_fini(void)
 			D_FREE(ec_codec->ec_en_matrix);
 		if (ec_codec->ec_gftbls != NULL)
 			D_FREE(ec_codec->ec_gftbls);
+		if (ec_codec->ec_recov != NULL) {
+			for (j = 0; j < OBJ_EC_MAX_M; j++)
+				D_FREE(ec_codec->ec_recov[j]);
+			D_FREE(ec_codec->ec_recov);
+		}
 	}
 
 	D_FREE(oc_ec_codecs);
@@ -38,6 +38,11 @@ struct obj_ec_codec {
 	 * from coding coefficients. Needed for both encoding and decoding.
 	 */
 	unsigned char		*ec_gftbls;
+	/**
+	 * Recovery codecs of single target failures, OBJ_EC_MAX_M entries
+	 * indexed by the failed target, built on first use by degraded fetch.
+	 */
+	struct obj_ec_recov_codec	**ec_recov;
 };
 
 /** Shard IO descriptor */
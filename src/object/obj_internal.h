@@ -24,6 +24,7 @@
 #include <daos/object.h>
 #include <daos_srv/daos_engine.h>
 #include <daos_srv/dtx_srv.h>
+#include <gurt/atomic.h>
 #include <gurt/telemetry_common.h>
 #include <gurt/telemetry_producer.h>
 
@@ -45,6 +46,22 @@ struct obj_io_context;
 extern bool	cli_bypass_rpc;
 /** Switch of server-side IO dispatch */
 extern unsigned int	srv_io_mode;
+/** Threshold of bulk transfer for update/fetch, see DAOS_BULK_LIMIT */
+extern unsigned int	obj_bulk_limit;
+
+/** Client object metrics, only set up if client telemetry is enabled */
+struct dc_obj_metrics {
+	/** Per-opcode number of completed operations (type = counter) */
+	struct d_tm_node_t	*dom_op_cnt[OBJ_PROTO_CLI_COUNT];
+	/** Number of retried I/Os (type = counter) */
+	struct d_tm_node_t	*dom_retries;
+	/** Number of pool map refreshes triggered by I/Os (type = counter) */
+	struct d_tm_node_t	*dom_map_refresh;
+	/** Bulk handles registration time in us (type = gauge) */
+	struct d_tm_node_t	*dom_bulk_reg;
+};
+
+extern struct dc_obj_metrics	dc_obj_metrics;
 
 /** client object shard */
 struct dc_obj_shard {
@@ -261,6 +278,11 @@ struct migrate_pool_tls {
 	uint64_t		mpt_inflight_max_size;
 	ABT_cond		mpt_inflight_cond;
 	ABT_mutex		mpt_inflight_mutex;
+	/* Smoothed and lowest observed migration latency (us per MiB),
+	 * used to adapt mpt_inflight_max_size to the load of the target.
+	 */
+	uint64_t		mpt_lat_ewma;
+	uint64_t		mpt_lat_base;
 	int			mpt_inflight_max_ult;
 	uint32_t		mpt_opc;
 	/* migrate leader ULT */
@@ -295,6 +317,22 @@ struct obj_pool_metrics {
 	struct d_tm_node_t	*opm_update_resent;
 	/** Total number of retry update operations (type = counter) */
 	struct d_tm_node_t	*opm_update_retry;
+
+	/** EC aggregated stripes, per kind of processing (type = counter) */
+	struct d_tm_node_t	*opm_ec_agg_full;
+	struct d_tm_node_t	*opm_ec_agg_partial;
+	struct d_tm_node_t	*opm_ec_agg_holes;
+	struct d_tm_node_t	*opm_ec_agg_replica_rm;
+	/** EC aggregated epoch lag behind current time in ms (type = gauge) */
+	struct d_tm_node_t	*opm_ec_agg_lag;
+};
+
+/** Opcode classes of the object RPC latency histograms */
+enum obj_lat_class {
+	OBJ_LAT_CLASS_UPDATE,
+	OBJ_LAT_CLASS_FETCH,
+	OBJ_LAT_CLASS_OTHER,
+	OBJ_LAT_CLASS_NR,
 };
 
 struct obj_tls {
@@ -309,6 +347,11 @@ struct obj_tls {
 	/** Measure update/fetch latency based on I/O size (type = gauge) */
 	struct d_tm_node_t	*ot_update_lat[NR_LATENCY_BUCKETS];
 	struct d_tm_node_t	*ot_fetch_lat[NR_LATENCY_BUCKETS];
+
+	/** Latency histogram per opcode class, only with DAOS_OBJ_LAT_HIST
+	 * (type = gauge)
+	 */
+	struct d_tm_node_t	*ot_lat_hist[OBJ_LAT_CLASS_NR];
 };
 
 struct obj_ec_parity {
@@ -625,6 +668,24 @@ int obj_get_grp_size(struct dc_object *obj);
 struct dc_object *obj_hdl2ptr(daos_handle_t oh);
 
 /* handles, pointers for handling I/O */
+/**
+ * Stages of a traced object I/O (see CRT_TRACE_SAMPLE), in execution order.
+ * The end time of each reached stage is recorded by obj_trace_stage().
+ */
+enum obj_trace_stage {
+	/** VOS I/O begin: index lookup, space reservation */
+	OBJ_TRACE_VOS_BEGIN,
+	/** bio_iod_prep: buffer mapping, DMA buffer reservation */
+	OBJ_TRACE_BIO_PREP,
+	/** bulk transfer or inline copy */
+	OBJ_TRACE_XFER,
+	/** bio_iod_post: NVMe write/read completion */
+	OBJ_TRACE_BIO_POST,
+	/** VOS I/O end: index update and publish */
+	OBJ_TRACE_VOS_END,
+	OBJ_TRACE_NR,
+};
+
 struct obj_io_context {
 	struct ds_cont_hdl	*ioc_coh;
 	struct ds_cont_child	*ioc_coc;
@@ -634,12 +695,24 @@ struct obj_io_context {
 	uint32_t		 ioc_opc;
 	uint64_t		 ioc_start_time;
 	uint64_t		 ioc_io_size;
+	/** trace ID of a sampled RPC, 0 if not traced */
+	uint64_t		 ioc_trace_id;
+	/** RPC arrival time (us) and stage end times (ns) of a traced RPC */
+	uint64_t		 ioc_trace_arrival;
+	uint64_t		 ioc_trace_ts[OBJ_TRACE_NR];
 	uint32_t		 ioc_began:1,
 				 ioc_free_sgls:1,
 				 ioc_lost_reply:1,
 				 ioc_fetch_snap:1;
 };
 
+static inline void
+obj_trace_stage(struct obj_io_context *ioc, enum obj_trace_stage stage)
+{
+	if (unlikely(ioc->ioc_trace_id != 0))
+		ioc->ioc_trace_ts[stage] = daos_get_ntime();
+}
+
 struct ds_obj_exec_arg {
 	crt_rpc_t		*rpc;
 	struct obj_io_context	*ioc;
@@ -839,6 +912,32 @@ daos_iom_dump(daos_iom_t *iom)
 	D_PRINT("\n");
 }
 
+/*
+ * Shard I/O RPCs in flight from this process per target, hashed on the target
+ * ID. It is only a hint to spread reads across replicas, collisions are fine.
+ */
+#define OBJ_TGT_LOAD_SLOTS	4096
+
+extern ATOMIC uint32_t obj_tgt_inflight[OBJ_TGT_LOAD_SLOTS];
+
+static inline uint32_t
+obj_tgt_load(uint32_t tgt_id)
+{
+	return atomic_load_relaxed(&obj_tgt_inflight[tgt_id % OBJ_TGT_LOAD_SLOTS]);
+}
+
+static inline void
+obj_tgt_load_add(uint32_t tgt_id)
+{
+	atomic_fetch_add_relaxed(&obj_tgt_inflight[tgt_id % OBJ_TGT_LOAD_SLOTS], 1);
+}
+
+static inline void
+obj_tgt_load_sub(uint32_t tgt_id)
+{
+	atomic_fetch_sub_relaxed(&obj_tgt_inflight[tgt_id % OBJ_TGT_LOAD_SLOTS], 1);
+}
+
 static inline bool
 obj_dtx_need_refresh(struct dtx_handle *dth, int rc)
 {
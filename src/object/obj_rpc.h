@@ -197,10 +197,10 @@ enum obj_rpc_flags {
 	((int32_t)		(orw_ret)		CRT_VAR) \
 	((uint32_t)		(orw_map_version)	CRT_VAR) \
 	((uint64_t)		(orw_epoch)		CRT_VAR) \
-	((daos_size_t)		(orw_iod_sizes)		CRT_ARRAY) \
-	((daos_size_t)		(orw_data_sizes)	CRT_ARRAY) \
+	((daos_size_t)		(orw_iod_sizes)		CRT_RAW_ARRAY) \
+	((daos_size_t)		(orw_data_sizes)	CRT_RAW_ARRAY) \
 	((d_sg_list_t)		(orw_sgls)		CRT_ARRAY) \
-	((uint32_t)		(orw_nrs)		CRT_ARRAY) \
+	((uint32_t)		(orw_nrs)		CRT_RAW_ARRAY) \
 	((struct dcs_iod_csums)	(orw_iod_csums)		CRT_ARRAY) \
 	((struct daos_recx_ep_list)	(orw_rels)	CRT_ARRAY) \
 	((daos_iom_t)		(orw_maps)		CRT_ARRAY)
@@ -241,8 +241,8 @@ CRT_RPC_DECLARE(obj_rw,		DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW)
 	((daos_key_desc_t)	(oeo_kds)		CRT_ARRAY) \
 	((d_sg_list_t)		(oeo_sgl)		CRT_VAR) \
 	((d_iov_t)		(oeo_csum_iov)		CRT_VAR) \
-	((daos_recx_t)		(oeo_recxs)		CRT_ARRAY) \
-	((daos_epoch_range_t)	(oeo_eprs)		CRT_ARRAY)
+	((daos_recx_t)		(oeo_recxs)		CRT_RAW_ARRAY) \
+	((daos_epoch_range_t)	(oeo_eprs)		CRT_RAW_ARRAY)
 
 CRT_RPC_DECLARE(obj_key_enum, DAOS_ISEQ_OBJ_KEY_ENUM, DAOS_OSEQ_OBJ_KEY_ENUM)
 
@@ -323,10 +323,10 @@ CRT_RPC_DECLARE(obj_sync, DAOS_ISEQ_OBJ_SYNC, DAOS_OSEQ_OBJ_SYNC)
 	((uint64_t)		(om_max_eph)		CRT_VAR)	\
 	((uint32_t)		(om_version)		CRT_VAR)	\
 	((uint32_t)		(om_tgt_idx)		CRT_VAR)	\
-	((daos_unit_oid_t)	(om_oids)		CRT_ARRAY)	\
-	((uint64_t)		(om_ephs)		CRT_ARRAY)	\
-	((uint64_t)		(om_punched_ephs)	CRT_ARRAY)	\
-	((uint32_t)		(om_shards)		CRT_ARRAY)	\
+	((daos_unit_oid_t)	(om_oids)		CRT_RAW_ARRAY)	\
+	((uint64_t)		(om_ephs)		CRT_RAW_ARRAY)	\
+	((uint64_t)		(om_punched_ephs)	CRT_RAW_ARRAY)	\
+	((uint32_t)		(om_shards)		CRT_RAW_ARRAY)	\
 	((uint32_t)		(om_opc)		CRT_VAR)
 
 #define DAOS_OSEQ_OBJ_MIGRATE	/* output fields */		 \
@@ -1366,6 +1366,7 @@ dc_tx_same_rdg(struct dtx_redundancy_group *grp1,
 	       struct dtx_redundancy_group *grp2)
 {
 	int	i;
+	int	j;
 
 	if (grp1->drg_tgt_cnt != grp2->drg_tgt_cnt)
 		return false;
@@ -1373,86 +1374,86 @@ dc_tx_same_rdg(struct dtx_redundancy_group *grp1,
 	if (grp1->drg_redundancy != grp2->drg_redundancy)
 		return false;
 
-	/* FIXME: The comparison between two ID arrays are unsorted.
-	 *	  So for the case of ID1 = {1,2,3} and ID2 = {3,1,2}
-	 *	  will get 'false' result. It will cause some space
-	 *	  overhead, but not fatal.
+	/* The IDs in a group are unique but unsorted, so ID1 = {1,2,3} and
+	 * ID2 = {3,1,2} are the same group. The groups are small, a nested
+	 * scan is cheaper than sorting them.
 	 */
 	for (i = 0; i < grp1->drg_tgt_cnt; i++) {
-		if (grp1->drg_ids[i] != grp2->drg_ids[i])
+		if (grp1->drg_ids[i] == grp2->drg_ids[i])
+			continue;
+
+		for (j = 0; j < grp2->drg_tgt_cnt; j++) {
+			if (grp1->drg_ids[i] == grp2->drg_ids[j])
+				break;
+		}
+
+		if (j == grp2->drg_tgt_cnt)
 			return false;
 	}
 
 	return true;
 }
 
+/* Drop the dtrs in @dtr_list that are the same as @dtr, the kept one is
+ * returned, it is a modification one if any of the same dtrs modifies.
+ */
+static struct dc_tx_rdg *
+dc_tx_merge_rdg(d_list_t *dtr_list, struct dc_tx_rdg *dtr)
+{
+	struct dc_tx_rdg	*tmp;
+	struct dc_tx_rdg	*next;
+
+	d_list_for_each_entry_safe(tmp, next, dtr_list, dtr_link) {
+		if (!dc_tx_same_rdg(&dtr->dtr_group, &tmp->dtr_group))
+			continue;
+
+		d_list_del(&tmp->dtr_link);
+		if (dtr->dtr_group.drg_flags & DGF_RDONLY) {
+			D_FREE(dtr);
+			dtr = tmp;
+		} else {
+			D_FREE(tmp);
+		}
+	}
+
+	return dtr;
+}
+
 static size_t
 dc_tx_reduce_rdgs(d_list_t *dtr_list, uint32_t *grp_cnt, uint32_t *mod_cnt)
 {
 	struct dc_tx_rdg	*dtr;
-	struct dc_tx_rdg	*tmp;
-	struct dc_tx_rdg	*next;
 	struct dc_tx_rdg	*leader;
+	d_list_t		 merged;
 	size_t			 size = 0;
 
 	*grp_cnt = 0;
-	leader = d_list_pop_entry(dtr_list, struct dc_tx_rdg, dtr_link);
+	D_INIT_LIST_HEAD(&merged);
 
 	/* Filter the dtrs that are the same as @leader. */
-	d_list_for_each_entry_safe(dtr, next, dtr_list, dtr_link) {
-		if (dc_tx_same_rdg(&leader->dtr_group, &dtr->dtr_group)) {
-			d_list_del(&dtr->dtr_link);
-			if (leader->dtr_group.drg_flags & DGF_RDONLY) {
-				D_FREE(leader);
-				leader = dtr;
-			} else {
-				D_FREE(dtr);
-			}
-		}
-	}
-
-	if (d_list_empty(dtr_list))
-		goto out;
-
-	tmp = d_list_pop_entry(dtr_list, struct dc_tx_rdg, dtr_link);
+	leader = d_list_pop_entry(dtr_list, struct dc_tx_rdg, dtr_link);
+	leader = dc_tx_merge_rdg(dtr_list, leader);
 
-	/* XXX: Try to merge the other non-leaders if possible.
-	 *	Consider efficiency, just one cycle scan. We do
-	 *	NOT guarantee all mergeable ones will be merged.
+	/* Merge all the other non-leaders that are the same, each merged
+	 * group is one less to be handled by the DTX leader.
 	 */
-	d_list_for_each_entry_safe(dtr, next, dtr_list, dtr_link) {
-		if (dc_tx_same_rdg(&tmp->dtr_group, &dtr->dtr_group)) {
-			d_list_del(&dtr->dtr_link);
-			if (tmp->dtr_group.drg_flags & DGF_RDONLY) {
-				D_FREE(tmp);
-				tmp = dtr;
-			} else {
-				D_FREE(dtr);
-			}
-		} else {
-			size += sizeof(struct dtx_redundancy_group) +
-				sizeof(uint32_t) * dtr->dtr_group.drg_tgt_cnt;
-			(*grp_cnt)++;
-			if (!(dtr->dtr_group.drg_flags & DGF_RDONLY))
-				(*mod_cnt)++;
-		}
+	while (!d_list_empty(dtr_list)) {
+		dtr = d_list_pop_entry(dtr_list, struct dc_tx_rdg, dtr_link);
+		dtr = dc_tx_merge_rdg(dtr_list, dtr);
+		d_list_add_tail(&dtr->dtr_link, &merged);
 	}
+	d_list_splice_init(&merged, dtr_list);
 
-	d_list_add(&tmp->dtr_link, dtr_list);
-	size += sizeof(struct dtx_redundancy_group) +
-		sizeof(uint32_t) * tmp->dtr_group.drg_tgt_cnt;
-	(*grp_cnt)++;
-	if (!(tmp->dtr_group.drg_flags & DGF_RDONLY))
-		(*mod_cnt)++;
-
-out:
 	/* Insert the leader dtr at the head position. */
 	d_list_add(&leader->dtr_link, dtr_list);
-	size += sizeof(struct dtx_redundancy_group) +
-		sizeof(uint32_t) * leader->dtr_group.drg_tgt_cnt;
-	(*grp_cnt)++;
-	if (!(leader->dtr_group.drg_flags & DGF_RDONLY))
-		(*mod_cnt)++;
+
+	d_list_for_each_entry(dtr, dtr_list, dtr_link) {
+		size += sizeof(struct dtx_redundancy_group) +
+			sizeof(uint32_t) * dtr->dtr_group.drg_tgt_cnt;
+		(*grp_cnt)++;
+		if (!(dtr->dtr_group.drg_flags & DGF_RDONLY))
+			(*mod_cnt)++;
+	}
 
 	return size;
 }
@@ -121,6 +121,7 @@ struct ec_agg_param {
 	daos_epoch_range_t	 ap_epr;	 /* hi/lo extent threshold    */
 	struct dtx_handle	*ap_dth;	 /* handle for DTX refresh    */
 	daos_handle_t		 ap_cont_handle; /* VOS container handle */
+	struct obj_pool_metrics	*ap_metrics;	 /* pool target metrics       */
 	bool			(*ap_yield_func)(void *arg); /* yield function*/
 	void			*ap_yield_arg;   /* yield argument            */
 	uint32_t		 ap_credits_max; /* # of tight loops to yield */
@@ -712,7 +713,11 @@ agg_encode_local_parity(struct ec_agg_entry *entry)
 	rc = agg_fetch_data_stripe(entry);
 	if (rc)
 		goto out;
-	agg_encode_full_stripe(entry);
+	rc = agg_encode_full_stripe(entry);
+	if (rc)
+		D_ERROR(DF_UOID" encode stripe %lu failed: "DF_RC"\n",
+			DP_UOID(entry->ae_oid),
+			entry->ae_cur_stripe.as_stripenum, DP_RC(rc));
 out:
 	return rc;
 }
@@ -1792,6 +1797,7 @@ agg_process_stripe(struct ec_agg_param *agg_param, struct ec_agg_entry *entry)
 	bool			update_vos = true;
 	bool			write_parity = true;
 	bool			process_holes = false;
+	struct d_tm_node_t	*stat = NULL;
 	int			rc = 0;
 
 	if (DAOS_FAIL_CHECK(DAOS_FORCE_EC_AGG_FAIL))
@@ -1825,6 +1831,7 @@ agg_process_stripe(struct ec_agg_param *agg_param, struct ec_agg_entry *entry)
 	if (ec_age_with_parity(entry) && ec_age_parity_higher(entry)) {
 		update_vos = true;
 		write_parity = false;
+		stat = agg_param->ap_metrics->opm_ec_agg_replica_rm;
 		D_DEBUG(DB_EPC, "delete replica for stripe: %lu,"
 			DF_U64"/"DF_U64" eph "DF_X64" >= "DF_X64"\n",
 			entry->ae_cur_stripe.as_stripenum,
@@ -1840,6 +1847,7 @@ agg_process_stripe(struct ec_agg_param *agg_param, struct ec_agg_entry *entry)
 	 */
 	if (ec_age_stripe_full(entry, ec_age_with_parity(entry))) {
 		rc = agg_encode_local_parity(entry);
+		stat = agg_param->ap_metrics->opm_ec_agg_full;
 		goto out;
 	}
 
@@ -1850,10 +1858,13 @@ agg_process_stripe(struct ec_agg_param *agg_param, struct ec_agg_entry *entry)
 	}
 
 	/* With parity and some newer partial replicas, possibly holes */
-	if (ec_age_with_hole(entry))
+	if (ec_age_with_hole(entry)) {
 		process_holes = true;
-	else
+		stat = agg_param->ap_metrics->opm_ec_agg_holes;
+	} else {
 		rc = agg_process_partial_stripe(entry);
+		stat = agg_param->ap_metrics->opm_ec_agg_partial;
+	}
 
 out:
 	if (process_holes && rc == 0) {
@@ -1875,6 +1886,8 @@ out:
 		}
 	}
 
+	if (rc == 0 && stat != NULL)
+		d_tm_inc_counter(stat, 1);
 	agg_clear_extents(entry);
 	return rc;
 }
@@ -2441,6 +2454,8 @@ ec_agg_param_init(struct ds_cont_child *cont, struct agg_param *param)
 	info->api_pool = cont->sc_pool->spc_pool;
 
 	agg_param->ap_cont_handle	= cont->sc_hdl;
+	agg_param->ap_metrics		=
+		cont->sc_pool->spc_metrics[DAOS_OBJ_MODULE];
 	agg_param->ap_yield_func	= agg_rate_ctl;
 	agg_param->ap_yield_arg		= param;
 	agg_param->ap_credits_max	= EC_AGG_ITERATION_MAX;
@@ -2573,6 +2588,15 @@ again:
 			*cont->sc_ec_query_agg_eph = cont->sc_ec_agg_eph;
 	}
 
+	/* how far EC aggregation of this container is behind ingest */
+	if (cont->sc_ec_agg_eph != 0) {
+		uint64_t now = crt_hlc_get();
+
+		if (now > cont->sc_ec_agg_eph)
+			d_tm_set_gauge(ec_agg_param->ap_metrics->opm_ec_agg_lag,
+				       crt_hlc2msec(now - cont->sc_ec_agg_eph));
+	}
+
 	return rc;
 }
 
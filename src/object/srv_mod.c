@@ -15,6 +15,9 @@
 #include "obj_rpc.h"
 #include "obj_internal.h"
 
+/* Add the per-class latency histograms, see obj_lat_hist_init() */
+static bool obj_lat_hist;
+
 /**
  * Switch of enable DTX or not, enabled by default.
  */
@@ -37,6 +40,8 @@ obj_mod_init(void)
 		goto out_class;
 	}
 
+	d_getenv_bool("DAOS_OBJ_LAT_HIST", &obj_lat_hist);
+
 	return 0;
 
 out_class:
@@ -73,10 +78,52 @@ static struct daos_rpc_handler obj_handlers[] = {
 
 #undef X
 
+/**
+ * Latency histograms per opcode class, enabled by DAOS_OBJ_LAT_HIST: the
+ * first bucket covers [0, 16us) and each following bucket is 4 times wider,
+ * so that tail quantiles (p99/p999) can be derived by the telemetry
+ * consumers through d_tm_get_quantile() without keeping individual samples.
+ * They are opt-in to bound the telemetry nodes added per target.
+ */
+#define OBJ_LAT_HIST_BUCKETS	8
+#define OBJ_LAT_HIST_WIDTH	16
+#define OBJ_LAT_HIST_MULT	4
+
+static const char *obj_lat_class_str[OBJ_LAT_CLASS_NR] = {
+	[OBJ_LAT_CLASS_UPDATE]	= "update",
+	[OBJ_LAT_CLASS_FETCH]	= "fetch",
+	[OBJ_LAT_CLASS_OTHER]	= "other",
+};
+
+static void
+obj_lat_hist_init(struct obj_tls *tls, int tgt_id)
+{
+	char	path[D_TM_MAX_NAME_LEN];
+	int	i;
+	int	rc;
+
+	for (i = 0; i < OBJ_LAT_CLASS_NR; i++) {
+		snprintf(path, sizeof(path), "io/latency/%s/hist/tgt_%u",
+			 obj_lat_class_str[i], tgt_id);
+		rc = d_tm_add_metric(&tls->ot_lat_hist[i], D_TM_STATS_GAUGE,
+				     "object RPC processing time histogram", "us",
+				     path);
+		if (rc == 0)
+			rc = d_tm_init_histogram(tls->ot_lat_hist[i], path,
+						 OBJ_LAT_HIST_BUCKETS,
+						 OBJ_LAT_HIST_WIDTH,
+						 OBJ_LAT_HIST_MULT);
+		if (rc)
+			D_WARN("Failed to create latency histogram %s: "DF_RC"\n",
+			       path, DP_RC(rc));
+	}
+}
+
 static void *
 obj_tls_init(int xs_id, int tgt_id)
 {
 	struct obj_tls	*tls;
+	char		 lat_path[D_TM_MAX_NAME_LEN];
 	uint32_t	opc;
 	int		rc;
 
@@ -108,10 +155,11 @@ obj_tls_init(int xs_id, int tgt_id)
 			continue;
 
 		/** And finally the per-opcode latency, of type gauge */
+		snprintf(lat_path, sizeof(lat_path), "io/ops/%s/latency/tgt_%u",
+			 obj_opc_to_str(opc), tgt_id);
 		rc = d_tm_add_metric(&tls->ot_op_lat[opc], D_TM_STATS_GAUGE,
 				     "object RPC processing time", "us",
-				     "io/ops/%s/latency/tgt_%u",
-				     obj_opc_to_str(opc), tgt_id);
+				     lat_path);
 		if (rc)
 			D_WARN("Failed to create latency sensor: "DF_RC"\n",
 			       DP_RC(rc));
@@ -158,6 +206,9 @@ obj_tls_init(int xs_id, int tgt_id)
 		}
 	}
 
+	if (obj_lat_hist)
+		obj_lat_hist_init(tls, tgt_id);
+
 	return tls;
 }
 
@@ -278,6 +329,45 @@ obj_metrics_alloc(const char *path, int tgt_id)
 		D_WARN("Failed to create bytes update sensor: "DF_RC"\n",
 		       DP_RC(rc));
 
+	/** EC aggregation */
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_full, D_TM_COUNTER,
+			     "total number of stripes EC aggregated from a full "
+			     "stripe of replicas", "stripes",
+			     "%s/ec_agg/full_stripe/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg full sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_partial, D_TM_COUNTER,
+			     "total number of stripes EC aggregated from "
+			     "partial replicas", "stripes",
+			     "%s/ec_agg/partial_stripe/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg partial sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_holes, D_TM_COUNTER,
+			     "total number of stripes EC aggregated with holes",
+			     "stripes", "%s/ec_agg/holes/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg holes sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_replica_rm, D_TM_COUNTER,
+			     "total number of stripes whose replicas were "
+			     "removed under newer parity", "stripes",
+			     "%s/ec_agg/replica_rm/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg replica sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_lag, D_TM_STATS_GAUGE,
+			     "lag of the EC aggregated epoch of containers",
+			     "ms", "%s/ec_agg/lag/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg lag sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
 	return metrics;
 }
 
@@ -131,6 +131,7 @@ obj_rw_complete(crt_rpc_t *rpc, struct obj_io_context *ioc,
 		} else {
 			rc = vos_fetch_end(ioh, &ioc->ioc_io_size, status);
 		}
+		obj_trace_stage(ioc, OBJ_TRACE_VOS_END);
 
 		if (rc != 0) {
 			D_CDEBUG(rc == -DER_REC2BIG || rc == -DER_INPROGRESS ||
@@ -1290,6 +1291,31 @@ obj_ec_recov_need_try_again(struct obj_rw_in *orw, struct obj_io_context *ioc)
 	return false;
 }
 
+/*
+ * Is \a epoch one of the container snapshots, old enough that no transaction
+ * at or below it can still commit? Reads at such a snapshot see data that can
+ * no longer change, there is no need to record their timestamps to detect
+ * conflicts with later writes. A snapshot epoch is only an HLC value, so a
+ * more recent snapshot still needs the timestamps to be repeatable.
+ */
+static bool
+obj_epoch_is_snapshot(struct ds_cont_child *cont, daos_epoch_t epoch)
+{
+	int	i;
+
+	if (epoch >= ds_cont_stable_epoch())
+		return false;
+
+	for (i = 0; i < cont->sc_snapshots_nr; i++) {
+		if (cont->sc_snapshots[i] == epoch)
+			return true;
+		if (cont->sc_snapshots[i] > epoch)
+			break;
+	}
+
+	return false;
+}
+
 static int
 obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 		      daos_iod_t *split_iods, struct dcs_iod_csums *split_csums,
@@ -1466,6 +1492,10 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 				fetch_flags |= VOS_OF_SKIP_FETCH;
 		}
 
+		if (ioc->ioc_fetch_snap &&
+		    obj_epoch_is_snapshot(ioc->ioc_coc, orw->orw_epoch))
+			fetch_flags |= VOS_OF_SKIP_TS;
+
 		rc = vos_fetch_begin(ioc->ioc_vos_coh, orw->orw_oid,
 				     orw->orw_epoch, dkey, orw->orw_nr, iods,
 				     cond_flags | fetch_flags, shadows, &ioh, dth);
@@ -1546,6 +1576,7 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 		}
 	}
 
+	obj_trace_stage(ioc, OBJ_TRACE_VOS_BEGIN);
 	if (orw->orw_flags & ORF_CHECK_EXISTENCE)
 		goto out;
 
@@ -1557,6 +1588,7 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 			DP_UOID(orw->orw_oid), DP_RC(rc));
 		goto out;
 	}
+	obj_trace_stage(ioc, OBJ_TRACE_BIO_PREP);
 
 	if (obj_rpc_is_fetch(rpc) && !spec_fetch &&
 	    daos_csummer_initialized(ioc->ioc_coc->sc_csummer)) {
@@ -1604,6 +1636,7 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 	} else if (orw->orw_sgls.ca_arrays != NULL) {
 		rc = bio_iod_copy(biod, orw->orw_sgls.ca_arrays, orw->orw_nr);
 	}
+	obj_trace_stage(ioc, OBJ_TRACE_XFER);
 
 	if (rc) {
 		if (rc == -DER_OVERFLOW)
@@ -1652,6 +1685,7 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 		obj_log_csum_err();
 post:
 	rc = bio_iod_post(biod, rc);
+	obj_trace_stage(ioc, OBJ_TRACE_BIO_POST);
 out:
 	/* There is CPU yield after DTX start, and the resent RPC may be handled during that.
 	 * Let's check resent again before further process.
@@ -1688,6 +1722,7 @@ obj_local_rw(crt_rpc_t *rpc, struct obj_io_context *ioc,
 	     daos_iod_t *split_iods, struct dcs_iod_csums *split_csums,
 	     uint64_t *split_offs, struct dtx_handle *dth, bool pin)
 {
+	int	waits = 0;
 	int	rc;
 
 again:
@@ -1716,6 +1751,15 @@ again:
 		rc = dtx_refresh(dth, ioc->ioc_coc);
 		if (rc == -DER_AGAIN)
 			goto again;
+		if (rc == -DER_INPROGRESS)
+			goto wait;
+	} else if (dth != NULL && rc == -DER_INPROGRESS &&
+		   !d_list_empty(&dth->dth_share_act_list)) {
+		/* The conflicting DTX is known to be prepared on its leader. */
+wait:
+		rc = dtx_inprogress_wait(dth, &waits);
+		if (rc == -DER_AGAIN)
+			goto again;
 	}
 
 	return rc;
@@ -1936,6 +1980,7 @@ obj_update_sensors(struct obj_io_context *ioc, int err)
 	struct obj_tls		*tls = obj_tls_get();
 	struct obj_pool_metrics	*opm;
 	struct d_tm_node_t	*lat;
+	struct d_tm_node_t	*hist;
 	uint32_t		opc = ioc->ioc_opc;
 	uint64_t		time;
 
@@ -1959,15 +2004,69 @@ obj_update_sensors(struct obj_io_context *ioc, int err)
 	case DAOS_OBJ_RPC_TGT_UPDATE:
 		d_tm_inc_counter(opm->opm_update_bytes, ioc->ioc_io_size);
 		lat = tls->ot_update_lat[lat_bucket(ioc->ioc_io_size)];
+		hist = tls->ot_lat_hist[OBJ_LAT_CLASS_UPDATE];
 		break;
 	case DAOS_OBJ_RPC_FETCH:
 		d_tm_inc_counter(opm->opm_fetch_bytes, ioc->ioc_io_size);
 		lat = tls->ot_fetch_lat[lat_bucket(ioc->ioc_io_size)];
+		hist = tls->ot_lat_hist[OBJ_LAT_CLASS_FETCH];
 		break;
 	default:
 		lat = tls->ot_op_lat[opc];
+		hist = tls->ot_lat_hist[OBJ_LAT_CLASS_OTHER];
 	}
 	d_tm_set_gauge(lat, time);
+	/* NULL unless DAOS_OBJ_LAT_HIST is set */
+	d_tm_set_gauge(hist, time);
+}
+
+static const char *obj_trace_stage_str[OBJ_TRACE_NR] = {
+	[OBJ_TRACE_VOS_BEGIN]	= "vos_begin",
+	[OBJ_TRACE_BIO_PREP]	= "bio_prep",
+	[OBJ_TRACE_XFER]	= "xfer",
+	[OBJ_TRACE_BIO_POST]	= "bio_post",
+	[OBJ_TRACE_VOS_END]	= "vos_end",
+};
+
+/** Attach the trace context of a sampled RPC to the I/O context */
+static inline void
+obj_ioc_trace(struct obj_io_context *ioc, crt_rpc_t *rpc)
+{
+	crt_req_trace_get(rpc, &ioc->ioc_trace_id, &ioc->ioc_trace_arrival);
+}
+
+/**
+ * Log the spans of a traced RPC, keyed by the trace ID that the client also
+ * reports on completion. Each stage is reported as the time elapsed since the
+ * previous reached stage, "queue" being the time between the RPC arrival and
+ * the start of its handler.
+ */
+static void
+obj_trace_dump(struct obj_io_context *ioc, int err)
+{
+	char		 buf[256];
+	uint64_t	 prev = ioc->ioc_start_time;
+	uint64_t	 now = daos_get_ntime();
+	int		 len = 0;
+	int		 i;
+
+	for (i = 0; i < OBJ_TRACE_NR && len < sizeof(buf); i++) {
+		if (ioc->ioc_trace_ts[i] == 0)
+			continue;
+		len += snprintf(buf + len, sizeof(buf) - len, " %s %lu",
+				obj_trace_stage_str[i],
+				(ioc->ioc_trace_ts[i] - prev) / 1000);
+		prev = ioc->ioc_trace_ts[i];
+	}
+	if (len == 0)
+		buf[0] = '\0';
+
+	D_INFO("trace %#lx: opc %s tgt %d size "DF_U64" queue %ld%s total "
+	       DF_U64" us, "DF_RC"\n", ioc->ioc_trace_id,
+	       obj_opc_to_str(ioc->ioc_opc), dss_get_module_info()->dmi_tgt_id,
+	       ioc->ioc_io_size,
+	       (long)(ioc->ioc_start_time / 1000 - ioc->ioc_trace_arrival), buf,
+	       (now - ioc->ioc_start_time) / 1000, DP_RC(err));
 }
 
 static void
@@ -1979,6 +2078,9 @@ obj_ioc_end(struct obj_io_context *ioc, int err)
 
 		/** Update sensors */
 		obj_update_sensors(ioc, err);
+
+		if (unlikely(ioc->ioc_trace_id != 0))
+			obj_trace_dump(ioc, err);
 	}
 	obj_ioc_fini(ioc);
 }
@@ -2246,6 +2348,7 @@ ds_obj_tgt_update_handler(crt_rpc_t *rpc)
 			   orw->orw_flags, &ioc);
 	if (rc)
 		goto out;
+	obj_ioc_trace(&ioc, rpc);
 
 	if (DAOS_FAIL_CHECK(DAOS_VC_DIFF_DKEY)) {
 		unsigned char	*buf = dkey->iov_buf;
@@ -2510,6 +2613,7 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 		D_ASSERTF(rc < 0, "unexpected error# "DF_RC"\n", DP_RC(rc));
 		goto out;
 	}
+	obj_ioc_trace(&ioc, rpc);
 
 	D_DEBUG(DB_IO,
 		"rpc %p opc %d oid "DF_UOID" dkey "DF_KEY" tag/xs %d/%d epc "
@@ -34,6 +34,17 @@
  * the moment, will adjust it later if needed.
  */
 #define MIGRATE_MAX_SIZE	(1 << 28)
+/*
+ * The inflight size backs off towards MIGRATE_MIN_SIZE when the latency of
+ * migrating a dkey (fetch from the source plus local update, per MiB) rises
+ * well above the lowest latency seen, i.e. when the device or the network is
+ * busy serving other I/O, and grows back by MIGRATE_SIZE_STEP otherwise.
+ * Dkeys smaller than MIGRATE_LAT_MIN_SIZE are dominated by RPC overhead and
+ * not sampled.
+ */
+#define MIGRATE_MIN_SIZE	(1 << 24)
+#define MIGRATE_SIZE_STEP	(1 << 22)
+#define MIGRATE_LAT_MIN_SIZE	(1 << 16)
 /* Max migrate ULT number on the server */
 #define MIGRATE_MAX_ULT		8192
 
@@ -1593,12 +1604,42 @@ migrate_one_destroy(struct migrate_one *mrone)
 	D_FREE(mrone);
 }
 
+static void
+migrate_inflight_adjust(struct migrate_pool_tls *tls, daos_size_t size,
+			uint64_t usecs)
+{
+	uint64_t	lat;
+
+	if (size < MIGRATE_LAT_MIN_SIZE || tls->mpt_inflight_max_size == 0)
+		return;
+
+	lat = usecs * (1ULL << 20) / size;
+	tls->mpt_lat_ewma = tls->mpt_lat_ewma == 0 ? lat :
+			    (tls->mpt_lat_ewma * 7 + lat) / 8;
+	/* let the baseline drift up slowly, the hardware may be shared */
+	if (tls->mpt_lat_base == 0 || tls->mpt_lat_ewma < tls->mpt_lat_base)
+		tls->mpt_lat_base = tls->mpt_lat_ewma;
+	else
+		tls->mpt_lat_base += tls->mpt_lat_base / 256;
+
+	if (tls->mpt_lat_ewma > tls->mpt_lat_base * 2) {
+		tls->mpt_inflight_max_size -= tls->mpt_inflight_max_size / 8;
+		if (tls->mpt_inflight_max_size < MIGRATE_MIN_SIZE)
+			tls->mpt_inflight_max_size = MIGRATE_MIN_SIZE;
+	} else if (tls->mpt_lat_ewma < tls->mpt_lat_base * 3 / 2) {
+		tls->mpt_inflight_max_size += MIGRATE_SIZE_STEP;
+		if (tls->mpt_inflight_max_size > MIGRATE_MAX_SIZE)
+			tls->mpt_inflight_max_size = MIGRATE_MAX_SIZE;
+	}
+}
+
 static void
 migrate_one_ult(void *arg)
 {
 	struct migrate_one	*mrone = arg;
 	struct migrate_pool_tls	*tls;
 	daos_size_t		data_size;
+	uint64_t		start;
 	int			rc = 0;
 
 	if (daos_fail_check(DAOS_REBUILD_TGT_REBUILD_HANG))
@@ -1623,9 +1664,10 @@ migrate_one_ult(void *arg)
 	D_DEBUG(DB_REBUILD, "mrone %p inflight size "DF_U64" max "DF_U64"\n",
 		mrone, tls->mpt_inflight_size, tls->mpt_inflight_max_size);
 
+	/* a dkey bigger than the limit can still go alone */
 	while (tls->mpt_inflight_size + data_size >=
 	       tls->mpt_inflight_max_size && tls->mpt_inflight_max_size != 0
-	       && !tls->mpt_fini) {
+	       && tls->mpt_inflight_size != 0 && !tls->mpt_fini) {
 		D_INFO("mrone %p wait "DF_U64"/"DF_U64"\n", mrone, tls->mpt_inflight_size,
 			tls->mpt_inflight_max_size);
 		ABT_mutex_lock(tls->mpt_inflight_mutex);
@@ -1637,8 +1679,12 @@ migrate_one_ult(void *arg)
 		D_GOTO(out, rc);
 
 	tls->mpt_inflight_size += data_size;
+	start = daos_getutime();
 	rc = migrate_dkey(tls, mrone, data_size);
 	tls->mpt_inflight_size -= data_size;
+	if (rc == 0)
+		migrate_inflight_adjust(tls, data_size,
+					daos_getutime() - start);
 
 	ABT_mutex_lock(tls->mpt_inflight_mutex);
 	ABT_cond_broadcast(tls->mpt_inflight_cond);
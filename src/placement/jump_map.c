@@ -58,6 +58,51 @@ struct pl_jump_map {
 	unsigned int		jmp_target_nr;
 	/* The dom that will contain no colocated shards */
 	pool_comp_type_t	jmp_redundant_dom;
+	/* Select domains and targets by rendezvous hashing, PL_TYPE_RENDEZVOUS */
+	bool			jmp_hrw;
+	/* Protect jmp_diff_cache */
+	pthread_spinlock_t	jmp_diff_lock;
+	/* Shards moved by rebuild/reint/addition, allocated on first use */
+	struct jm_diff_entry	*jmp_diff_cache;
+};
+
+#define JM_DIFF_CACHE_SIZE	4096	/* must be power of 2 */
+#define JM_DIFF_INLINE_NR	4
+
+/**
+ * Cached result of jump_map_obj_find_{rebuild,reint,addition}() for one
+ * object. The placement map is immutable and recreated on each pool map
+ * change, so results keyed by object ID and rebuild version stay valid for
+ * the lifetime of the map. It saves recomputing the layouts when the same
+ * object is scanned by multiple targets of the engine, or rescanned, and
+ * most entries record that the object has nothing to move.
+ */
+struct jm_diff_entry {
+	daos_obj_id_t		jde_oid;
+	uint32_t		jde_omd_ver;
+	uint32_t		jde_ver;
+	uint16_t		jde_op;
+	/* Number of moved shards, UINT16_MAX for empty entry */
+	uint16_t		jde_nr;
+	uint32_t		jde_tgts[JM_DIFF_INLINE_NR];
+	uint32_t		jde_shards[JM_DIFF_INLINE_NR];
+};
+
+/**
+ * Domain state shared by all objects placed in one batch against the same
+ * pool map version, so that root lookup and bitmap allocation are only done
+ * once per batch instead of once per object.
+ */
+struct jm_place_ctx {
+	struct pool_domain	*jpc_root;
+	uint32_t		 jpc_dom_size;
+	uint32_t		 jpc_dom_array_size;
+	uint32_t		 jpc_tgt_array_size;
+	uint8_t			*jpc_dom_used;
+	uint8_t			*jpc_dom_occupied;
+	uint8_t			*jpc_tgts_used;
+	/* Domains are being added to the pool map */
+	bool			 jpc_adding;
 };
 
 /**
@@ -127,6 +172,21 @@ crc(uint64_t data, uint32_t init_val)
 	return crc64_ecma_refl(init_val, (uint8_t *)&data, sizeof(data));
 }
 
+/**
+ * Weight of a component for rendezvous (highest random weight) hashing. The
+ * unused component with the highest weight for the key is selected. Unlike
+ * jump consistent hashing that selects an index, components are identified by
+ * ID, so adding or removing a domain only moves the shards that it wins or
+ * loses, wherever it is in the pool map, and equal weights spread the shards
+ * evenly whatever the number of components.
+ */
+static inline uint64_t
+hrw_weight(uint64_t key, uint32_t id)
+{
+	/* crc() is affine in the key, mix it for independent weights */
+	return d_hash_mix64(crc(key, id));
+}
+
 /**
  * This function gets the replication and size requirements and then
  * stores those requirements into a obj_placement  struct for usage during
@@ -215,6 +275,104 @@ pl_map2jmap(struct pl_map *map)
 	return container_of(map, struct pl_jump_map, jmp_map);
 }
 
+static inline struct jm_diff_entry *
+jm_diff_slot(struct jm_diff_entry *cache, daos_obj_id_t oid, int op,
+	     uint32_t ver)
+{
+	uint64_t hash;
+
+	hash = d_hash_murmur64((unsigned char *)&oid, sizeof(oid), ver + op);
+	return &cache[hash & (JM_DIFF_CACHE_SIZE - 1)];
+}
+
+/**
+ * Look up the cached moved shards of an object.
+ *
+ * \return	>= 0 number of moved shards, -DER_NONEXIST on cache miss,
+ *		-DER_REC2BIG if the output arrays are too small.
+ */
+static int
+jm_diff_cache_lookup(struct pl_jump_map *jmap, int op,
+		     struct daos_obj_md *md, struct daos_obj_shard_md *shard_md,
+		     uint32_t ver, uint32_t *tgt_id, uint32_t *shard_idx,
+		     unsigned int array_size)
+{
+	struct jm_diff_entry	*cache;
+	struct jm_diff_entry	*jde;
+	int			 rc = -DER_NONEXIST;
+	int			 i;
+
+	cache = __atomic_load_n(&jmap->jmp_diff_cache, __ATOMIC_ACQUIRE);
+	if (cache == NULL || shard_md != NULL)
+		return rc;
+
+	jde = jm_diff_slot(cache, md->omd_id, op, ver);
+	D_SPIN_LOCK(&jmap->jmp_diff_lock);
+	if (jde->jde_nr == UINT16_MAX || jde->jde_op != op ||
+	    jde->jde_ver != ver || jde->jde_omd_ver != md->omd_ver ||
+	    daos_oid_cmp(jde->jde_oid, md->omd_id) != 0)
+		goto out;
+
+	if (jde->jde_nr > array_size)
+		D_GOTO(out, rc = -DER_REC2BIG);
+
+	for (i = 0; i < jde->jde_nr; i++) {
+		tgt_id[i] = jde->jde_tgts[i];
+		shard_idx[i] = jde->jde_shards[i];
+	}
+	rc = jde->jde_nr;
+out:
+	D_SPIN_UNLOCK(&jmap->jmp_diff_lock);
+	return rc;
+}
+
+static void
+jm_diff_cache_insert(struct pl_jump_map *jmap, int op,
+		     struct daos_obj_md *md, struct daos_obj_shard_md *shard_md,
+		     uint32_t ver, uint32_t *tgt_id, uint32_t *shard_idx,
+		     int nr)
+{
+	struct jm_diff_entry	*cache;
+	struct jm_diff_entry	*expected = NULL;
+	struct jm_diff_entry	*jde;
+	int			 i;
+
+	if (shard_md != NULL || nr > JM_DIFF_INLINE_NR)
+		return;
+
+	cache = __atomic_load_n(&jmap->jmp_diff_cache, __ATOMIC_ACQUIRE);
+	if (cache == NULL) {
+		D_ALLOC_ARRAY(cache, JM_DIFF_CACHE_SIZE);
+		if (cache == NULL)
+			return;
+
+		for (i = 0; i < JM_DIFF_CACHE_SIZE; i++)
+			cache[i].jde_nr = UINT16_MAX;
+
+		if (!__atomic_compare_exchange_n(&jmap->jmp_diff_cache,
+						 &expected, cache, false,
+						 __ATOMIC_RELEASE,
+						 __ATOMIC_ACQUIRE)) {
+			/* Installed by another thread */
+			D_FREE(cache);
+			cache = expected;
+		}
+	}
+
+	jde = jm_diff_slot(cache, md->omd_id, op, ver);
+	D_SPIN_LOCK(&jmap->jmp_diff_lock);
+	jde->jde_oid = md->omd_id;
+	jde->jde_omd_ver = md->omd_ver;
+	jde->jde_ver = ver;
+	jde->jde_op = op;
+	jde->jde_nr = nr;
+	for (i = 0; i < nr; i++) {
+		jde->jde_tgts[i] = tgt_id[i];
+		jde->jde_shards[i] = shard_idx[i];
+	}
+	D_SPIN_UNLOCK(&jmap->jmp_diff_lock);
+}
+
 static void debug_print_allow_status(uint32_t allow_status)
 {
 	D_DEBUG(DB_PL, "Allow status: [%s%s%s%s%s%s%s ]\n",
@@ -318,7 +476,7 @@ static void
 get_target(struct pool_domain *curr_dom, struct pool_target **target,
 	   uint64_t obj_key, uint8_t *dom_used, uint8_t *dom_occupied,
 	   uint8_t *dom_cur_grp_used, uint8_t *tgts_used, int shard_num,
-	   uint32_t allow_status)
+	   uint32_t allow_status, bool hrw)
 {
 	int                     range_set;
 	uint8_t                 found_target = 0;
@@ -362,16 +520,39 @@ retry:
 			 * not work
 			 */
 			obj_key = crc(obj_key, fail_num++);
-			/* Get target for shard */
-			selected_dom = d_hash_jump(obj_key, num_doms);
-			do {
-				selected_dom = selected_dom % num_doms;
-				/* Retrieve actual target using index */
-				*target = &curr_dom->do_targets[selected_dom];
-				/* Get target id to check if target used */
+			if (hrw) {
+				struct pool_target	*tgt;
+				uint64_t		 weight;
+				uint64_t		 best = 0;
+				uint32_t		 i;
+
+				/* Not all used, checked above */
+				*target = NULL;
+				for (i = 0; i < num_doms; i++) {
+					tgt = &curr_dom->do_targets[i];
+					if (isset(tgts_used, tgt->ta_comp.co_id))
+						continue;
+
+					weight = hrw_weight(obj_key, tgt->ta_comp.co_id);
+					if (*target == NULL || weight > best) {
+						*target = tgt;
+						best = weight;
+					}
+				}
+				D_ASSERT(*target != NULL);
 				dom_id = (*target)->ta_comp.co_id;
-				selected_dom++;
-			} while (isset(tgts_used, dom_id));
+			} else {
+				/* Get target for shard */
+				selected_dom = d_hash_jump(obj_key, num_doms);
+				do {
+					selected_dom = selected_dom % num_doms;
+					/* Retrieve actual target using index */
+					*target = &curr_dom->do_targets[selected_dom];
+					/* Get target id to check if target used */
+					dom_id = (*target)->ta_comp.co_id;
+					selected_dom++;
+				} while (isset(tgts_used, dom_id));
+			}
 
 			setbit(tgts_used, dom_id);
 			setbit(dom_cur_grp_used, curr_dom - root_pos);
@@ -477,14 +658,35 @@ retry:
 				}
 				continue;
 			}
-			/*
-			 * Keep choosing new domains until one that has
-			 * not been used is found
-			 */
-			do {
-				selected_dom = d_hash_jump(key, num_doms);
-				key = crc(key, fail_num++);
-			} while (isset(dom_used, start_dom + selected_dom));
+			if (hrw) {
+				uint64_t	weight;
+				uint64_t	best = 0;
+				uint32_t	i;
+
+				/* Not all used, checked above */
+				selected_dom = num_doms;
+				for (i = 0; i < num_doms; i++) {
+					if (isset(dom_used, start_dom + i))
+						continue;
+
+					weight = hrw_weight(key,
+						curr_dom->do_children[i].do_comp.co_id);
+					if (selected_dom == num_doms || weight > best) {
+						selected_dom = i;
+						best = weight;
+					}
+				}
+				D_ASSERT(selected_dom < num_doms);
+			} else {
+				/*
+				 * Keep choosing new domains until one that has
+				 * not been used is found
+				 */
+				do {
+					selected_dom = d_hash_jump(key, num_doms);
+					key = crc(key, fail_num++);
+				} while (isset(dom_used, start_dom + selected_dom));
+			}
 
 			/* Mark this domain as used */
 			setbit(dom_used, start_dom + selected_dom);
@@ -600,7 +802,7 @@ obj_remap_shards(struct pl_jump_map *jmap, struct daos_obj_md *md,
 			get_target(root, &spare_tgt, crc(key, rebuild_key),
 				   dom_used, dom_occupied,
 				   dgu->dgu_used, tgts_used,
-				   shard_id, allow_status);
+				   shard_id, allow_status, jmap->jmp_hrw);
 			D_ASSERT(spare_tgt != NULL);
 			D_DEBUG(DB_PL, "Trying new target: "DF_TARGET"\n",
 				DP_TARGET(spare_tgt));
@@ -700,6 +902,8 @@ remap_gpu_alloc_one(d_list_t *remap_list, uint8_t *dom_cur_grp_used)
  * \param[out]	is_extending	if there is drain/extending/reintegrating tgts
  *                              exists in this layout, which we might need
  *                              insert extra shards into the layout.
+ * \param[in]	ctx		domain state shared by a placement batch,
+ *				NULL to set it up for this object only.
  *
  * \return                      An error code determining if the function
  *                              succeeded (0) or failed.
@@ -710,7 +914,7 @@ static int
 get_object_layout(struct pl_jump_map *jmap, struct pl_obj_layout *layout,
 		  struct jm_obj_placement *jmop, d_list_t *out_list,
 		  uint32_t allow_status, struct daos_obj_md *md,
-		  bool *is_extending)
+		  bool *is_extending, struct jm_place_ctx *ctx)
 {
 	struct pool_target      *target;
 	struct pool_domain      *root;
@@ -741,6 +945,26 @@ get_object_layout(struct pl_jump_map *jmap, struct pl_obj_layout *layout,
 	D_DEBUG(DB_PL, "Building layout. map version: %d\n", layout->ol_ver);
 	debug_print_allow_status(allow_status);
 
+	D_INIT_LIST_HEAD(&local_list);
+	D_INIT_LIST_HEAD(&dgu_remap_list);
+	if (out_list != NULL)
+		remap_list = out_list;
+	else
+		remap_list = &local_list;
+
+	if (ctx != NULL) {
+		root = ctx->jpc_root;
+		dom_size = ctx->jpc_dom_size;
+		dom_array_size = ctx->jpc_dom_array_size;
+		dom_used = ctx->jpc_dom_used;
+		dom_occupied = ctx->jpc_dom_occupied;
+		tgts_used = ctx->jpc_tgts_used;
+		memset(dom_used, 0, dom_array_size);
+		memset(dom_occupied, 0, dom_array_size);
+		memset(tgts_used, 0, ctx->jpc_tgt_array_size);
+		goto place;
+	}
+
 	rc = pool_map_find_domain(jmap->jmp_map.pl_poolmap, PO_COMP_TP_ROOT,
 				  PO_COMP_ID_ALL, &root);
 	if (rc == 0) {
@@ -749,13 +973,6 @@ get_object_layout(struct pl_jump_map *jmap, struct pl_obj_layout *layout,
 	}
 	rc = 0;
 
-	D_INIT_LIST_HEAD(&local_list);
-	D_INIT_LIST_HEAD(&dgu_remap_list);
-	if (out_list != NULL)
-		remap_list = out_list;
-	else
-		remap_list = &local_list;
-
 	dom_size = (struct pool_domain *)(root->do_targets) - (root) + 1;
 	dom_array_size = dom_size/NBBY + 1;
 	if (dom_array_size > LOCAL_DOM_ARRAY_SIZE) {
@@ -774,6 +991,7 @@ get_object_layout(struct pl_jump_map *jmap, struct pl_obj_layout *layout,
 	if (dom_used == NULL || dom_occupied == NULL || tgts_used == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
+place:
 	oid = md->omd_id;
 	key = oid.hi ^ oid.lo;
 	if (daos_obj_is_srank(oid))
@@ -812,7 +1030,7 @@ get_object_layout(struct pl_jump_map *jmap, struct pl_obj_layout *layout,
 			} else {
 				get_target(root, &target, key, dom_used,
 					   dom_occupied, dom_cur_grp_used,
-					   tgts_used, k, allow_status);
+					   tgts_used, k, allow_status, jmap->jmp_hrw);
 			}
 
 			if (target == NULL) {
@@ -883,6 +1101,10 @@ out:
 			D_FREE(dom_cur_grp_used);
 	}
 
+	/* Bitmaps are owned by the batch context */
+	if (ctx != NULL)
+		return rc;
+
 	if (dom_used && dom_used != dom_used_array)
 		D_FREE(dom_used);
 	if (dom_occupied && dom_occupied != dom_occupied_array)
@@ -893,11 +1115,52 @@ out:
 	return rc;
 }
 
+static void
+jm_place_ctx_fini(struct jm_place_ctx *ctx)
+{
+	D_FREE(ctx->jpc_dom_used);
+	D_FREE(ctx->jpc_dom_occupied);
+	D_FREE(ctx->jpc_tgts_used);
+}
+
+static int
+jm_place_ctx_init(struct pl_jump_map *jmap, struct jm_place_ctx *ctx)
+{
+	struct pool_domain	*root;
+	int			 rc;
+
+	memset(ctx, 0, sizeof(*ctx));
+	rc = pool_map_find_domain(jmap->jmp_map.pl_poolmap, PO_COMP_TP_ROOT,
+				  PO_COMP_ID_ALL, &root);
+	if (rc == 0) {
+		D_ERROR("Could not find root node in pool map.");
+		return -DER_NONEXIST;
+	}
+
+	ctx->jpc_root = root;
+	ctx->jpc_dom_size = (struct pool_domain *)(root->do_targets) - root + 1;
+	ctx->jpc_dom_array_size = ctx->jpc_dom_size / NBBY + 1;
+	ctx->jpc_tgt_array_size = root->do_target_nr / NBBY + 1;
+	ctx->jpc_adding = is_pool_adding(root);
+
+	D_ALLOC_ARRAY(ctx->jpc_dom_used, ctx->jpc_dom_array_size);
+	D_ALLOC_ARRAY(ctx->jpc_dom_occupied, ctx->jpc_dom_array_size);
+	D_ALLOC_ARRAY(ctx->jpc_tgts_used, ctx->jpc_tgt_array_size);
+	if (ctx->jpc_dom_used == NULL || ctx->jpc_dom_occupied == NULL ||
+	    ctx->jpc_tgts_used == NULL) {
+		jm_place_ctx_fini(ctx);
+		return -DER_NOMEM;
+	}
+
+	return 0;
+}
+
 static int
 obj_layout_alloc_and_get(struct pl_jump_map *jmap,
 			 struct jm_obj_placement *jmop, struct daos_obj_md *md,
 			 uint32_t allow_status, struct pl_obj_layout **layout_p,
-			 d_list_t *remap_list, bool *is_extending)
+			 d_list_t *remap_list, bool *is_extending,
+			 struct jm_place_ctx *ctx)
 {
 	int rc;
 
@@ -913,7 +1176,7 @@ obj_layout_alloc_and_get(struct pl_jump_map *jmap,
 	}
 
 	rc = get_object_layout(jmap, *layout_p, jmop, remap_list, allow_status,
-			       md, is_extending);
+			       md, is_extending, ctx);
 	if (rc) {
 		D_ERROR("get object layout failed, rc "DF_RC"\n",
 			DP_RC(rc));
@@ -944,6 +1207,8 @@ jump_map_destroy(struct pl_map *map)
 	if (jmap->jmp_map.pl_poolmap)
 		pool_map_decref(jmap->jmp_map.pl_poolmap);
 
+	D_FREE(jmap->jmp_diff_cache);
+	D_SPIN_DESTROY(&jmap->jmp_diff_lock);
 	D_FREE(jmap);
 }
 
@@ -972,6 +1237,12 @@ jump_map_create(struct pool_map *poolmap, struct pl_map_init_attr *mia,
 	if (jmap == NULL)
 		return -DER_NOMEM;
 
+	rc = D_SPIN_INIT(&jmap->jmp_diff_lock, PTHREAD_PROCESS_PRIVATE);
+	if (rc != 0) {
+		D_FREE(jmap);
+		return rc;
+	}
+
 	pool_map_addref(poolmap);
 	jmap->jmp_map.pl_poolmap = poolmap;
 
@@ -984,6 +1255,7 @@ jump_map_create(struct pool_map *poolmap, struct pl_map_init_attr *mia,
 	}
 
 	jmap->jmp_redundant_dom = mia->ia_jump_map.domain;
+	jmap->jmp_hrw = (mia->ia_type == PL_TYPE_RENDEZVOUS);
 	rc = pool_map_find_domain(poolmap, mia->ia_jump_map.domain,
 				  PO_COMP_ID_ALL, &doms);
 	if (rc <= 0) {
@@ -1015,7 +1287,7 @@ jump_map_query(struct pl_map *map, struct pl_map_attr *attr)
 {
 	struct pl_jump_map   *jmap = pl_map2jmap(map);
 
-	attr->pa_type	   = PL_TYPE_JUMP_MAP;
+	attr->pa_type	   = jmap->jmp_hrw ? PL_TYPE_RENDEZVOUS : PL_TYPE_JUMP_MAP;
 	attr->pa_target_nr = jmap->jmp_target_nr;
 	attr->pa_domain_nr = jmap->jmp_domain_nr;
 	attr->pa_domain    = jmap->jmp_redundant_dom;
@@ -1039,11 +1311,10 @@ jump_map_query(struct pl_map *map, struct pl_map_attr *attr)
  *                              successfully.
  */
 static int
-jump_map_obj_place(struct pl_map *map, struct daos_obj_md *md,
-		   struct daos_obj_shard_md *shard_md,
-		   struct pl_obj_layout **layout_pp)
+jm_obj_place(struct pl_jump_map *jmap, struct daos_obj_md *md,
+	     struct daos_obj_shard_md *shard_md, struct jm_place_ctx *ctx,
+	     struct pl_obj_layout **layout_pp)
 {
-	struct pl_jump_map	*jmap;
 	struct pl_obj_layout	*layout = NULL;
 	struct pl_obj_layout	*extend_layout = NULL;
 	struct jm_obj_placement	jmop;
@@ -1055,7 +1326,6 @@ jump_map_obj_place(struct pl_map *map, struct daos_obj_md *md,
 	uint32_t		allow_status;
 	int			rc;
 
-	jmap = pl_map2jmap(map);
 	oid = md->omd_id;
 	D_DEBUG(DB_PL, "Determining location for object: "DF_OID", ver: %d\n",
 		DP_OID(oid), md->omd_ver);
@@ -1069,7 +1339,7 @@ jump_map_obj_place(struct pl_map *map, struct daos_obj_md *md,
 	D_INIT_LIST_HEAD(&extend_list);
 	allow_status = PO_COMP_ST_UPIN | PO_COMP_ST_DRAIN;
 	rc = obj_layout_alloc_and_get(jmap, &jmop, md, allow_status, &layout,
-				      NULL, &is_extending);
+				      NULL, &is_extending, ctx);
 	if (rc != 0) {
 		D_ERROR("get_layout_alloc failed, rc "DF_RC"\n", DP_RC(rc));
 		D_GOTO(out, rc);
@@ -1077,13 +1347,17 @@ jump_map_obj_place(struct pl_map *map, struct daos_obj_md *md,
 
 	obj_layout_dump(oid, layout);
 
-	rc = pool_map_find_domain(jmap->jmp_map.pl_poolmap,
-				  PO_COMP_TP_ROOT, PO_COMP_ID_ALL,
-				  &root);
-	D_ASSERT(rc == 1);
-	rc = 0;
-	if (is_pool_adding(root))
-		is_adding_new = true;
+	if (ctx != NULL) {
+		is_adding_new = ctx->jpc_adding;
+	} else {
+		rc = pool_map_find_domain(jmap->jmp_map.pl_poolmap,
+					  PO_COMP_TP_ROOT, PO_COMP_ID_ALL,
+					  &root);
+		D_ASSERT(rc == 1);
+		rc = 0;
+		if (is_pool_adding(root))
+			is_adding_new = true;
+	}
 
 	/* If the layout might being extended, i.e. so extra shards needs
 	 * to be added to the layout.
@@ -1106,7 +1380,7 @@ jump_map_obj_place(struct pl_map *map, struct daos_obj_md *md,
 		 */
 		allow_status |= PO_COMP_ST_DOWN;
 		rc = obj_layout_alloc_and_get(jmap, &jmop, md, allow_status,
-					      &extend_layout, NULL, NULL);
+					      &extend_layout, NULL, NULL, ctx);
 		if (rc)
 			D_GOTO(out, rc);
 
@@ -1137,6 +1411,56 @@ out:
 	return rc;
 }
 
+static int
+jump_map_obj_place(struct pl_map *map, struct daos_obj_md *md,
+		   struct daos_obj_shard_md *shard_md,
+		   struct pl_obj_layout **layout_pp)
+{
+	return jm_obj_place(pl_map2jmap(map), md, shard_md, NULL, layout_pp);
+}
+
+/**
+ * Determines the layouts of a batch of objects against the same pool map
+ * version, the domain state is set up once and shared by all objects.
+ *
+ * \param[in]   map             The placement map used to place the objects.
+ * \param[in]   mds             Metadata of the objects being placed.
+ * \param[in]   nr              Number of objects.
+ * \param[out]  layouts         The layouts generated for the objects.
+ *
+ * \return                      0 on success, or the error code of the first
+ *                              failed object. No layout is returned on error.
+ */
+static int
+jump_map_obj_place_batch(struct pl_map *map, struct daos_obj_md *mds,
+			 unsigned int nr, struct pl_obj_layout **layouts)
+{
+	struct pl_jump_map	*jmap = pl_map2jmap(map);
+	struct jm_place_ctx	 ctx;
+	unsigned int		 i;
+	int			 rc;
+
+	rc = jm_place_ctx_init(jmap, &ctx);
+	if (rc != 0)
+		return rc;
+
+	for (i = 0; i < nr; i++) {
+		rc = jm_obj_place(jmap, &mds[i], NULL, &ctx, &layouts[i]);
+		if (rc != 0)
+			break;
+	}
+
+	if (rc != 0) {
+		while (i-- > 0) {
+			pl_obj_layout_free(layouts[i]);
+			layouts[i] = NULL;
+		}
+	}
+
+	jm_place_ctx_fini(&ctx);
+	return rc;
+}
+
 /**
  *
  * \param[in]   map             The placement map to be used to generate the
@@ -1183,6 +1507,11 @@ jump_map_obj_find_rebuild(struct pl_map *map, struct daos_obj_md *md,
 	jmap = pl_map2jmap(map);
 	oid = md->omd_id;
 
+	rc = jm_diff_cache_lookup(jmap, PL_REBUILD, md, shard_md, rebuild_ver,
+				  tgt_id, shard_idx, array_size);
+	if (rc != -DER_NONEXIST)
+		return rc;
+
 	rc = jm_obj_placement_get(jmap, md, shard_md, &jmop);
 	if (rc) {
 		D_ERROR("jm_obj_placement_get failed, rc "DF_RC"\n", DP_RC(rc));
@@ -1191,14 +1520,16 @@ jump_map_obj_find_rebuild(struct pl_map *map, struct daos_obj_md *md,
 
 	D_INIT_LIST_HEAD(&remap_list);
 	rc = obj_layout_alloc_and_get(jmap, &jmop, md, PO_COMP_ST_UPIN, &layout,
-				      &remap_list, NULL);
+				      &remap_list, NULL, NULL);
 	if (rc < 0)
 		D_GOTO(out, rc);
 
 	obj_layout_dump(oid, layout);
 	rc = remap_list_fill(map, md, shard_md, rebuild_ver, tgt_id, shard_idx,
 			     array_size, &idx, layout, &remap_list, false);
-
+	if (rc == 0)
+		jm_diff_cache_insert(jmap, PL_REBUILD, md, shard_md,
+				     rebuild_ver, tgt_id, shard_idx, idx);
 out:
 	remap_list_free_all(&remap_list);
 	if (layout != NULL)
@@ -1232,6 +1563,11 @@ jump_map_obj_find_reint(struct pl_map *map, struct daos_obj_md *md,
 	}
 
 	jmap = pl_map2jmap(map);
+	rc = jm_diff_cache_lookup(jmap, PL_REINT, md, shard_md, reint_ver,
+				  tgt_rank, shard_id, array_size);
+	if (rc != -DER_NONEXIST)
+		return rc;
+
 	rc = jm_obj_placement_get(jmap, md, shard_md, &jop);
 	if (rc) {
 		D_ERROR("jm_obj_placement_get failed, rc %d.\n", rc);
@@ -1244,13 +1580,13 @@ jump_map_obj_find_reint(struct pl_map *map, struct daos_obj_md *md,
 	allow_status = PO_COMP_ST_UPIN | PO_COMP_ST_DOWN | PO_COMP_ST_DRAIN;
 	D_INIT_LIST_HEAD(&reint_list);
 	rc = obj_layout_alloc_and_get(jmap, &jop, md, allow_status, &layout,
-				      NULL, NULL);
+				      NULL, NULL, NULL);
 	if (rc < 0)
 		D_GOTO(out, rc);
 
 	allow_status |= PO_COMP_ST_UP;
 	rc = obj_layout_alloc_and_get(jmap, &jop, md, allow_status,
-				      &reint_layout, NULL, NULL);
+				      &reint_layout, NULL, NULL, NULL);
 	if (rc < 0)
 		D_GOTO(out, rc);
 
@@ -1259,6 +1595,9 @@ jump_map_obj_find_reint(struct pl_map *map, struct daos_obj_md *md,
 	rc = remap_list_fill(map, md, shard_md, reint_ver, tgt_rank, shard_id,
 			     array_size, &idx, reint_layout, &reint_list,
 			     false);
+	if (rc == 0)
+		jm_diff_cache_insert(jmap, PL_REINT, md, shard_md, reint_ver,
+				     tgt_rank, shard_id, idx);
 out:
 	remap_list_free_all(&reint_list);
 	if (layout != NULL)
@@ -1295,6 +1634,11 @@ jump_map_obj_find_addition(struct pl_map *map, struct daos_obj_md *md,
 
 	jmap = pl_map2jmap(map);
 
+	rc = jm_diff_cache_lookup(jmap, PL_ADD, md, shard_md, reint_ver,
+				  tgt_rank, shard_id, array_size);
+	if (rc != -DER_NONEXIST)
+		return rc;
+
 	rc = jm_obj_placement_get(jmap, md, shard_md, &jop);
 	if (rc) {
 		D_ERROR("jm_obj_placement_get failed, rc %d.\n", rc);
@@ -1304,19 +1648,22 @@ jump_map_obj_find_addition(struct pl_map *map, struct daos_obj_md *md,
 	allow_status = PO_COMP_ST_UPIN;
 	D_INIT_LIST_HEAD(&add_list);
 	rc = obj_layout_alloc_and_get(jmap, &jop, md, allow_status,
-				      &layout, NULL, NULL);
+				      &layout, NULL, NULL, NULL);
 	if (rc)
 		D_GOTO(out, rc);
 
 	allow_status |= PO_COMP_ST_NEW;
 	rc = obj_layout_alloc_and_get(jmap, &jop, md, allow_status,
-				      &add_layout, NULL, NULL);
+				      &add_layout, NULL, NULL, NULL);
 	if (rc)
 		D_GOTO(out, rc);
 
 	layout_find_diff(jmap, layout, add_layout, &add_list);
 	rc = remap_list_fill(map, md, shard_md, reint_ver, tgt_rank, shard_id,
 			     array_size, &idx, add_layout, &add_list, true);
+	if (rc == 0)
+		jm_diff_cache_insert(jmap, PL_ADD, md, shard_md, reint_ver,
+				     tgt_rank, shard_id, idx);
 out:
 	remap_list_free_all(&add_list);
 
@@ -1335,6 +1682,7 @@ struct pl_map_ops       jump_map_ops = {
 	.o_query		= jump_map_query,
 	.o_print                = jump_map_print,
 	.o_obj_place            = jump_map_obj_place,
+	.o_obj_place_batch      = jump_map_obj_place_batch,
 	.o_obj_find_rebuild     = jump_map_obj_find_rebuild,
 	.o_obj_find_reint       = jump_map_obj_find_reint,
 	.o_obj_find_addition      = jump_map_obj_find_addition,
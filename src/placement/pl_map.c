@@ -38,6 +38,11 @@ static struct pl_map_dict pl_maps[] = {
 		.pd_ops     = &jump_map_ops,
 		.pd_name    = "jump",
 	},
+	{
+		.pd_type    = PL_TYPE_RENDEZVOUS,
+		.pd_ops     = &jump_map_ops,
+		.pd_name    = "rendezvous",
+	},
 	{
 		.pd_type        = PL_TYPE_UNKNOWN,
 		.pd_ops         = NULL,
@@ -45,6 +50,151 @@ static struct pl_map_dict pl_maps[] = {
 	},
 };
 
+/**
+ * Number of slots of the per-map layout cache. A placement map is immutable
+ * and replaced on each pool map version change, so a layout computed against
+ * it stays valid for as long as the map itself. The cache is direct-mapped by
+ * object ID so its footprint is bounded, a colliding object simply evicts the
+ * previous slot owner.
+ */
+#define PL_LAYOUT_CACHE_SIZE	256
+
+struct pl_layout_slot {
+	struct daos_obj_md	 ls_md;
+	struct pl_obj_layout	*ls_layout;
+};
+
+static inline struct pl_layout_slot *
+pl_layout_slot_get(struct pl_map *map, struct daos_obj_md *md)
+{
+	uint64_t	key;
+
+	key = md->omd_id.lo ^ (md->omd_id.hi * 0x9e3779b97f4a7c15ULL);
+	key ^= key >> 32;
+	return &map->pl_layouts[key % PL_LAYOUT_CACHE_SIZE];
+}
+
+static inline bool
+pl_layout_md_equal(struct daos_obj_md *a, struct daos_obj_md *b)
+{
+	return daos_oid_cmp(a->omd_id, b->omd_id) == 0 &&
+	       a->omd_ver == b->omd_ver && a->omd_loff == b->omd_loff;
+}
+
+static void
+pl_obj_layout_copy(struct pl_obj_layout *src, struct pl_obj_layout *dst)
+{
+	D_ASSERT(dst->ol_nr == src->ol_nr);
+	dst->ol_ver = src->ol_ver;
+	memcpy(dst->ol_shards, src->ol_shards,
+	       sizeof(*dst->ol_shards) * src->ol_nr);
+}
+
+static int
+pl_obj_layout_dup(struct pl_obj_layout *src, struct pl_obj_layout **dst_pp)
+{
+	struct pl_obj_layout	*dst;
+	int			 rc;
+
+	rc = pl_obj_layout_alloc(src->ol_grp_size, src->ol_grp_nr, &dst);
+	if (rc != 0)
+		return rc;
+
+	pl_obj_layout_copy(src, dst);
+	*dst_pp = dst;
+	return 0;
+}
+
+static void
+pl_layout_cache_fini(struct pl_map *map)
+{
+	int	i;
+
+	if (map->pl_layouts == NULL)
+		return;
+
+	for (i = 0; i < PL_LAYOUT_CACHE_SIZE; i++) {
+		if (map->pl_layouts[i].ls_layout != NULL)
+			pl_obj_layout_free(map->pl_layouts[i].ls_layout);
+	}
+	D_FREE(map->pl_layouts);
+}
+
+/**
+ * Return a private copy of the cached layout of @md, if there is one. The copy
+ * is allocated outside of pl_lock, so the slot is checked again once it is
+ * taken back and a slot evicted meanwhile is treated as a miss.
+ */
+static int
+pl_layout_cache_lookup(struct pl_map *map, struct daos_obj_md *md,
+		       struct pl_obj_layout **layout_pp)
+{
+	struct pl_layout_slot	*slot;
+	struct pl_obj_layout	*layout;
+	unsigned int		 grp_size = 0;
+	unsigned int		 grp_nr = 0;
+	int			 rc = -DER_NONEXIST;
+
+	if (map->pl_layouts == NULL)
+		return rc;
+
+	slot = pl_layout_slot_get(map, md);
+	D_SPIN_LOCK(&map->pl_lock);
+	if (slot->ls_layout != NULL && pl_layout_md_equal(&slot->ls_md, md)) {
+		grp_size = slot->ls_layout->ol_grp_size;
+		grp_nr = slot->ls_layout->ol_grp_nr;
+	}
+	D_SPIN_UNLOCK(&map->pl_lock);
+
+	if (grp_nr == 0)
+		return rc;
+
+	rc = pl_obj_layout_alloc(grp_size, grp_nr, &layout);
+	if (rc != 0)
+		return rc;
+
+	rc = -DER_NONEXIST;
+	D_SPIN_LOCK(&map->pl_lock);
+	if (slot->ls_layout != NULL && pl_layout_md_equal(&slot->ls_md, md) &&
+	    slot->ls_layout->ol_grp_size == grp_size &&
+	    slot->ls_layout->ol_grp_nr == grp_nr) {
+		pl_obj_layout_copy(slot->ls_layout, layout);
+		rc = 0;
+	}
+	D_SPIN_UNLOCK(&map->pl_lock);
+
+	if (rc == 0)
+		*layout_pp = layout;
+	else
+		pl_obj_layout_free(layout);
+	return rc;
+}
+
+static void
+pl_layout_cache_insert(struct pl_map *map, struct daos_obj_md *md,
+		       struct pl_obj_layout *layout)
+{
+	struct pl_layout_slot	*slot;
+	struct pl_obj_layout	*copy;
+	struct pl_obj_layout	*old;
+
+	if (map->pl_layouts == NULL)
+		return;
+
+	/* failing to cache is harmless, the next open will recompute */
+	if (pl_obj_layout_dup(layout, &copy) != 0)
+		return;
+
+	slot = pl_layout_slot_get(map, md);
+	D_SPIN_LOCK(&map->pl_lock);
+	old = slot->ls_layout;
+	slot->ls_md = *md;
+	slot->ls_layout = copy;
+	D_SPIN_UNLOCK(&map->pl_lock);
+
+	if (old != NULL)
+		pl_obj_layout_free(old);
+}
 
 static int
 pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
@@ -82,6 +232,8 @@ pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 	map->pl_type = mia->ia_type;
 	map->pl_ops  = dict->pd_ops;
 	D_INIT_LIST_HEAD(&map->pl_link);
+	/* the layout cache is optional, placement works without it */
+	D_ALLOC_ARRAY(map->pl_layouts, PL_LAYOUT_CACHE_SIZE);
 
 	*pl_mapp = map;
 	return 0;
@@ -97,6 +249,7 @@ pl_map_destroy(struct pl_map *map)
 	D_ASSERT(map->pl_ops != NULL);
 	D_ASSERT(map->pl_ops->o_destroy != NULL);
 
+	pl_layout_cache_fini(map);
 	D_SPIN_DESTROY(&map->pl_lock);
 	map->pl_ops->o_destroy(map);
 }
@@ -114,16 +267,64 @@ void pl_map_print(struct pl_map *map)
  * Compute layout for the input object metadata @md. It only generates the
  * layout of the redundancy group that @shard_md belongs to if @shard_md
  * is not NULL.
+ *
+ * Full layouts are cached on the map, so opening the same object again
+ * against the same map version returns a copy instead of recomputing it.
  */
 int
 pl_obj_place(struct pl_map *map, struct daos_obj_md *md,
 	     struct daos_obj_shard_md *shard_md,
 	     struct pl_obj_layout **layout_pp)
 {
+	int	rc;
+
+	D_ASSERT(map->pl_ops != NULL);
+	D_ASSERT(map->pl_ops->o_obj_place != NULL);
+
+	if (shard_md != NULL)
+		return map->pl_ops->o_obj_place(map, md, shard_md, layout_pp);
+
+	rc = pl_layout_cache_lookup(map, md, layout_pp);
+	if (rc != -DER_NONEXIST)
+		return rc;
+
+	rc = map->pl_ops->o_obj_place(map, md, NULL, layout_pp);
+	if (rc == 0)
+		pl_layout_cache_insert(map, md, *layout_pp);
+
+	return rc;
+}
+
+/**
+ * Compute layouts for a batch of objects @mds against the same version of
+ * the placement map, all layouts of the objects are generated. Either all
+ * the layouts are returned in @layouts, or none of them on error.
+ */
+int
+pl_obj_place_batch(struct pl_map *map, struct daos_obj_md *mds,
+		   unsigned int nr, struct pl_obj_layout **layouts)
+{
+	unsigned int	i;
+	int		rc = 0;
+
 	D_ASSERT(map->pl_ops != NULL);
+	if (map->pl_ops->o_obj_place_batch != NULL)
+		return map->pl_ops->o_obj_place_batch(map, mds, nr, layouts);
+
 	D_ASSERT(map->pl_ops->o_obj_place != NULL);
+	for (i = 0; i < nr; i++) {
+		rc = map->pl_ops->o_obj_place(map, &mds[i], NULL, &layouts[i]);
+		if (rc != 0)
+			break;
+	}
 
-	return map->pl_ops->o_obj_place(map, md, shard_md, layout_pp);
+	if (rc != 0) {
+		while (i-- > 0) {
+			pl_obj_layout_free(layouts[i]);
+			layouts[i] = NULL;
+		}
+	}
+	return rc;
 }
 
 /**
@@ -361,7 +562,8 @@ pl_map_attr_init(struct pool_map *po_map, pl_map_type_t type,
 		mia->ia_ring.ring_nr = 1;
 		break;
 	case PL_TYPE_JUMP_MAP:
-		mia->ia_type            = PL_TYPE_JUMP_MAP;
+	case PL_TYPE_RENDEZVOUS:
+		mia->ia_type            = type;
 		mia->ia_jump_map.domain = PL_DEFAULT_DOMAIN;
 	}
 }
@@ -479,7 +681,7 @@ pl_map_update(uuid_t uuid, struct pool_map *pool_map, bool connect,
 			D_GOTO(out, rc = 0);
 		}
 
-		pl_map_attr_init(pool_map, PL_TYPE_JUMP_MAP, &mia);
+		pl_map_attr_init(pool_map, tmp->pl_type, &mia);
 		rc = pl_map_create_inited(pool_map, &mia, &map);
 		if (rc != 0) {
 			d_hash_rec_decref(&pl_htable, link);
@@ -1885,6 +1885,127 @@ large_shards_over_limited_targets(void **state)
 	jtc_fini(&ctx);
 }
 
+#define BATCH_OBJ_NR	64
+
+/* Layouts of a placement batch are the same as placing objects one by one */
+static void
+jtc_assert_batch_same_as_single(struct jm_test_ctx *ctx)
+{
+	struct daos_obj_md	 mds[BATCH_OBJ_NR];
+	struct pl_obj_layout	*layouts[BATCH_OBJ_NR];
+	struct pl_obj_layout	*layout;
+	int			 i;
+	int			 j;
+
+	memset(mds, 0, sizeof(mds));
+	for (i = 0; i < BATCH_OBJ_NR; i++) {
+		gen_oid(&mds[i].omd_id, i, 0, ctx->object_class);
+		mds[i].omd_ver = pool_map_get_version(ctx->po_map);
+	}
+	assert_success(pl_obj_place_batch(ctx->pl_map, mds, BATCH_OBJ_NR,
+					  layouts));
+
+	for (i = 0; i < BATCH_OBJ_NR; i++) {
+		assert_success(pl_obj_place(ctx->pl_map, &mds[i], NULL,
+					    &layout));
+		assert_int_equal(layout->ol_nr, layouts[i]->ol_nr);
+		for (j = 0; j < layout->ol_nr; j++) {
+			assert_int_equal(layout->ol_shards[j].po_target,
+					 layouts[i]->ol_shards[j].po_target);
+			assert_int_equal(layout->ol_shards[j].po_rebuilding,
+					 layouts[i]->ol_shards[j].po_rebuilding);
+		}
+		pl_obj_layout_free(layout);
+		pl_obj_layout_free(layouts[i]);
+	}
+}
+
+static void
+repeated_scan_gets_same_result(void **state)
+{
+	struct jm_test_ctx	 ctx;
+	uint32_t		 tgt;
+	uint32_t		 id;
+
+	jtc_init_with_layout(&ctx, 4, 1, 8, OC_RP_4G1, g_verbose);
+	jtc_set_status_on_shard_target(&ctx, DOWN, 0);
+	assert_success(jtc_create_layout(&ctx));
+
+	/* the second scan is answered by the placement map's diff cache */
+	jtc_scan(&ctx);
+	assert_int_equal(ctx.rebuild.out_nr, 1);
+	tgt = ctx.rebuild.tgt_ranks[0];
+	id = ctx.rebuild.ids[0];
+
+	jtc_scan(&ctx);
+	assert_int_equal(ctx.rebuild.out_nr, 1);
+	assert_int_equal(ctx.rebuild.tgt_ranks[0], tgt);
+	assert_int_equal(ctx.rebuild.ids[0], id);
+	assert_int_equal(ctx.reint.out_nr, 0);
+	assert_int_equal(ctx.new.out_nr, 0);
+
+	jtc_fini(&ctx);
+}
+
+static void
+batch_place_same_as_single(void **state)
+{
+	struct jm_test_ctx	ctx;
+
+	jtc_init_with_layout(&ctx, 8, 2, 4, OC_RP_3G2, g_verbose);
+	jtc_assert_batch_same_as_single(&ctx);
+
+	/* With failed and reintegrating targets */
+	jtc_set_status_on_target(&ctx, DOWN, 3);
+	jtc_set_status_on_target(&ctx, DOWNOUT, 9);
+	jtc_set_status_on_target(&ctx, DOWN, 17);
+	jtc_set_status_on_target(&ctx, DOWNOUT, 17);
+	jtc_set_status_on_target(&ctx, UP, 17);
+	jtc_assert_batch_same_as_single(&ctx);
+	jtc_fini(&ctx);
+
+	jtc_init_with_layout(&ctx, 18, 1, 4, OC_EC_16P2G1, g_verbose);
+	jtc_assert_batch_same_as_single(&ctx);
+	jtc_fini(&ctx);
+}
+
+static void
+rendezvous_map_place_obj(void **state)
+{
+	struct pool_map		*po_map;
+	struct pl_map		*pl_map;
+	struct pl_obj_layout	*lo_1;
+	struct pl_obj_layout	*lo_2;
+	daos_oclass_id_t	 cids[] = {OC_S1, OC_S4, OC_RP_2G2, OC_RP_3G2,
+					   OC_EC_4P2G1};
+	daos_obj_id_t		 oid;
+	int			 i;
+	int			 j;
+
+	gen_pool_and_placement_map(8, 2, 4, PL_TYPE_RENDEZVOUS,
+				   &po_map, &pl_map);
+	assert_non_null(po_map);
+	assert_non_null(pl_map);
+
+	for (i = 0; i < ARRAY_SIZE(cids); i++) {
+		for (j = 0; j < 64; j++) {
+			gen_oid(&oid, j, i, cids[i]);
+			assert_success(plt_obj_place(oid, &lo_1, pl_map,
+						     false));
+			plt_obj_layout_check(lo_1, 64, 0);
+
+			/* Placement is deterministic */
+			assert_success(plt_obj_place(oid, &lo_2, pl_map,
+						     false));
+			assert_true(plt_obj_layout_match(lo_1, lo_2));
+			pl_obj_layout_free(lo_1);
+			pl_obj_layout_free(lo_2);
+		}
+	}
+
+	free_pool_and_placement_map(po_map, pl_map);
+}
+
 /*
  * ------------------------------------------------
  * End Test Cases
@@ -1969,6 +2090,13 @@ static const struct CMUnitTest tests[] = {
 	  same_group_shards_not_in_same_domain),
 	T("large shards over limited targets",
 	  large_shards_over_limited_targets),
+	/* Batch */
+	T("Batched placement gives the same layouts as single placement",
+	  batch_place_same_as_single),
+	T("Repeated rebuild scan of an object gets the same result",
+	  repeated_scan_gets_same_result),
+	T("Rendezvous map gives valid and stable layouts",
+	  rendezvous_map_place_obj),
 };
 
 int
@@ -6,6 +6,7 @@
 #define D_LOGFAC        DD_FAC(tests)
 
 #include <getopt.h>
+#include <math.h>
 
 #include <daos/common.h>
 #include <daos/placement.h>
@@ -35,6 +36,12 @@ extern void obj_class_fini(void);
 #define DEFAULT_ADDITION_NUM_TO_ADD 32
 #define DEFAULT_ADDITION_TEST_ENTRIES 100000
 
+#define DEFAULT_REBUILD_NUM_TO_FAIL 8
+#define DEFAULT_REBUILD_NUM_TO_ADD 1
+#define DEFAULT_REBUILD_TEST_ENTRIES 100000
+/* Max shards of an OC_RP_4G2 object returned by the find functions */
+#define REBUILD_ARRAY_SIZE 8
+
 static void
 print_usage(const char *prog_name, const char *const ops[], uint32_t num_ops)
 {
@@ -132,11 +139,16 @@ benchmark_placement_usage()
 		"      Possible values:\n"
 		"          PL_TYPE_RING\n"
 		"          PL_TYPE_JUMP_MAP\n"
+		"          PL_TYPE_RENDEZVOUS\n"
 		"\n"
 		"Optional Arguments\n"
 		"  --vtune-loop\n"
 		"      Short version: -t\n"
-		"      If specified, runs a tight loop on placement for analysis with VTune\n");
+		"      If specified, runs a tight loop on placement for analysis with VTune\n"
+		"\n"
+		"  --batch-size <num>\n"
+		"      Short version: -b\n"
+		"      If specified, also benchmarks batched placement of <num> objects per call\n");
 }
 
 static void
@@ -151,16 +163,18 @@ benchmark_placement(int argc, char **argv, uint32_t num_domains,
 
 	pl_map_type_t map_type = PL_TYPE_UNKNOWN;
 	int vtune_loop = 0;
+	uint32_t batch_size = 0;
 
 	while (1) {
 		static struct option long_options[] = {
 			{"map-type", required_argument, 0, 'm'},
 			{"vtune-loop", no_argument, 0, 't'},
+			{"batch-size", required_argument, 0, 'b'},
 			{0, 0, 0, 0}
 		};
 		int c;
 
-		c = getopt_long(argc, argv, "m:t", long_options, NULL);
+		c = getopt_long(argc, argv, "m:tb:", long_options, NULL);
 		if (c == -1)
 			break;
 
@@ -171,6 +185,8 @@ benchmark_placement(int argc, char **argv, uint32_t num_domains,
 			} else if (strncmp(optarg, "PL_TYPE_JUMP_MAP", 15)
 				   == 0) {
 				map_type = PL_TYPE_JUMP_MAP;
+			} else if (strcmp(optarg, "PL_TYPE_RENDEZVOUS") == 0) {
+				map_type = PL_TYPE_RENDEZVOUS;
 			} else {
 				D_PRINT("ERROR: Unknown map-type '%s'\n",
 					optarg);
@@ -181,6 +197,15 @@ benchmark_placement(int argc, char **argv, uint32_t num_domains,
 		case 't':
 			vtune_loop = 1;
 			break;
+		case 'b':
+			if (sscanf(optarg, "%u", &batch_size) != 1 ||
+			    batch_size == 0 || batch_size > BENCHMARK_COUNT) {
+				D_PRINT("ERROR: Invalid batch-size '%s'\n",
+					optarg);
+				benchmark_placement_usage();
+				return;
+			}
+			break;
 		case '?':
 		default:
 			D_PRINT("ERROR: Unrecognized argument '%s'\n", optarg);
@@ -260,6 +285,54 @@ benchmark_placement(int argc, char **argv, uint32_t num_domains,
 		benchmark_free(bench_hdl);
 	}
 
+	/* Batched layout calculation benchmark */
+	if (batch_size != 0) {
+		struct benchmark_handle *bench_hdl;
+		struct pl_obj_layout	**batch_table;
+		uint32_t		 nr;
+		uint32_t		 j;
+		int			 rc;
+
+		D_ALLOC_ARRAY(batch_table, BENCHMARK_COUNT);
+		D_ASSERT(batch_table != NULL);
+
+		bench_hdl = benchmark_alloc();
+		D_ASSERT(bench_hdl != NULL);
+
+		benchmark_start(bench_hdl);
+		for (i = 0; i < BENCHMARK_COUNT; i += nr) {
+			nr = min(batch_size, BENCHMARK_COUNT - i);
+			rc = pl_obj_place_batch(pl_map, &obj_table[i], nr,
+						&batch_table[i]);
+			D_ASSERT(rc == 0);
+		}
+		benchmark_stop(bench_hdl);
+
+		/* Batched layouts must be identical to the single ones */
+		for (i = 0; i < BENCHMARK_COUNT; i++) {
+			D_ASSERT(batch_table[i]->ol_nr ==
+				 layout_table[i]->ol_nr);
+			for (j = 0; j < batch_table[i]->ol_nr; j++)
+				D_ASSERT(batch_table[i]->ol_shards[j].po_target
+					 == layout_table[i]->ol_shards[j].po_target);
+			pl_obj_layout_free(batch_table[i]);
+		}
+		D_FREE(batch_table);
+
+		D_PRINT("\nBatched placement benchmark results (batch size %u):\n",
+			batch_size);
+		D_PRINT(
+			"# Iterations, Wallclock time (ns), thread time (ns), Wallclock placements per second\n"
+		);
+		D_PRINT("%d,%lld,%lld,%lld\n", BENCHMARK_COUNT,
+			bench_hdl->wallclock_delta_ns,
+			bench_hdl->thread_delta_ns,
+			NANOSECONDS_PER_SECOND * BENCHMARK_COUNT /
+			bench_hdl->wallclock_delta_ns);
+
+		benchmark_free(bench_hdl);
+	}
+
 	free_pool_and_placement_map(pool_map, pl_map);
 }
 
@@ -276,6 +349,7 @@ benchmark_add_data_movement_usage()
 		"      Possible values:\n"
 		"          PL_TYPE_RING\n"
 		"          PL_TYPE_JUMP_MAP\n"
+		"          PL_TYPE_RENDEZVOUS\n"
 		"\n"
 		"Optional Arguments\n"
 		"  --num-domains-to-add <num>\n"
@@ -420,6 +494,11 @@ benchmark_add_data_movement(int argc, char **argv, uint32_t num_domains,
 						PL_TYPE_JUMP_MAP;
 					map_keys[num_map_types] =
 						"PL_TYPE_JUMP_MAP";
+				} else if (strcmp(token, "PL_TYPE_RENDEZVOUS") == 0) {
+					map_types[num_map_types] =
+						PL_TYPE_RENDEZVOUS;
+					map_keys[num_map_types] =
+						"PL_TYPE_RENDEZVOUS";
 				} else {
 					D_PRINT("ERROR: Unknown map-type: %s\n",
 						token);
@@ -571,6 +650,371 @@ out:
 }
 
 
+static void
+benchmark_rebuild_usage()
+{
+	D_PRINT(
+		"Rebuild/reintegration/addition benchmark usage: -- [optional arguments]\n"
+		"\n"
+		"Uses the jump map. For 10K+ targets, use a large enough pool, e.g.\n"
+		"  -d 32 -n 40 -v 8 (32 racks of 40 nodes with 8 targets each)\n"
+		"\n"
+		"Optional Arguments\n"
+		"  --num-to-fail <num>\n"
+		"      Short version: -f\n"
+		"      Number of targets to fail, spread over all the domains\n"
+		"      Default: %d\n"
+		"\n"
+		"  --num-domains-to-add <num>\n"
+		"      Short version: -a\n"
+		"      Number of top-level domains to extend the pool with\n"
+		"      Default: %d\n"
+		"\n"
+		"  --num-test-entries <num>\n"
+		"      Short version: -t\n"
+		"      Number of objects to place\n"
+		"      Default: %d\n",
+		DEFAULT_REBUILD_NUM_TO_FAIL, DEFAULT_REBUILD_NUM_TO_ADD,
+		DEFAULT_REBUILD_TEST_ENTRIES);
+}
+
+static struct pl_map *
+bench_pl_map_create(struct pool_map *pool_map)
+{
+	struct pl_map_init_attr	 mia = { 0 };
+	struct pl_map		*pl_map;
+	int			 rc;
+
+	mia.ia_type = PL_TYPE_JUMP_MAP;
+	rc = pl_map_create(pool_map, &mia, &pl_map);
+	D_ASSERT(rc == 0);
+	return pl_map;
+}
+
+/* Print min/max/average/stddev of the shards placed on each target */
+static void
+print_balance(struct pl_obj_layout **layout_table, int test_entries,
+	      uint32_t total_targets)
+{
+	uint32_t	*counts;
+	uint32_t	 min_cnt = UINT32_MAX;
+	uint32_t	 max_cnt = 0;
+	double		 avg = 0;
+	double		 dev = 0;
+	uint32_t	 nr = 0;
+	uint32_t	 i;
+	int		 j;
+
+	D_ALLOC_ARRAY(counts, total_targets);
+	D_ASSERT(counts != NULL);
+
+	for (j = 0; j < test_entries; j++)
+		for (i = 0; i < layout_table[j]->ol_nr; i++) {
+			if (layout_table[j]->ol_shards[i].po_target >=
+			    total_targets)
+				continue;
+			counts[layout_table[j]->ol_shards[i].po_target]++;
+			nr++;
+		}
+
+	avg = (double)nr / total_targets;
+	for (i = 0; i < total_targets; i++) {
+		min_cnt = min(min_cnt, counts[i]);
+		max_cnt = max(max_cnt, counts[i]);
+		dev += (counts[i] - avg) * (counts[i] - avg);
+	}
+	dev = sqrt(dev / total_targets);
+
+	D_PRINT("Shards per target: min %u, max %u, average %.2f, stddev %.2f, "
+		"max/average %.3f\n", min_cnt, max_cnt, avg, dev,
+		avg > 0 ? max_cnt / avg : 0);
+	D_FREE(counts);
+}
+
+/*
+ * Time one of the pl_obj_find_* functions over all the objects and report how
+ * many shards move, compared with the ideal fraction, and how evenly the
+ * moved shards are spread over the receiving targets.
+ */
+static void
+bench_find(const char *name, struct pl_map *pl_map,
+	   struct daos_obj_md *obj_table, int test_entries, uint32_t ver, uint32_t total_targets,
+	   uint32_t shards_per_obj, double ideal,
+	   int (*find_fn)(struct pl_map *, struct daos_obj_md *,
+			  struct daos_obj_shard_md *, uint32_t, uint32_t *,
+			  uint32_t *, unsigned int))
+{
+	struct benchmark_handle	*bench_hdl;
+	uint32_t		 tgt_ranks[REBUILD_ARRAY_SIZE];
+	uint32_t		 shard_ids[REBUILD_ARRAY_SIZE];
+	uint32_t		*received;
+	uint64_t		 moved = 0;
+	uint32_t		 receivers = 0;
+	uint32_t		 max_received = 0;
+	int			 obj_idx;
+	int			 rc;
+	int			 i;
+
+	D_ALLOC_ARRAY(received, total_targets);
+	D_ASSERT(received != NULL);
+
+	bench_hdl = benchmark_alloc();
+	D_ASSERT(bench_hdl != NULL);
+
+	benchmark_start(bench_hdl);
+	for (obj_idx = 0; obj_idx < test_entries; obj_idx++) {
+		obj_table[obj_idx].omd_ver = ver;
+		rc = find_fn(pl_map, &obj_table[obj_idx], NULL, ver, tgt_ranks,
+			     shard_ids, REBUILD_ARRAY_SIZE);
+		D_ASSERT(rc >= 0);
+
+		moved += rc;
+		for (i = 0; i < rc; i++)
+			if (tgt_ranks[i] < total_targets)
+				received[tgt_ranks[i]]++;
+	}
+	benchmark_stop(bench_hdl);
+
+	for (i = 0; i < total_targets; i++) {
+		if (received[i] == 0)
+			continue;
+		receivers++;
+		max_received = max(max_received, received[i]);
+	}
+
+	D_PRINT("\n%s benchmark results:\n", name);
+	D_PRINT("# Iterations, Wallclock time (ns), thread time (ns), "
+		"Wallclock lookups per second\n");
+	D_PRINT("%d,%lld,%lld,%lld\n", test_entries,
+		bench_hdl->wallclock_delta_ns, bench_hdl->thread_delta_ns,
+		NANOSECONDS_PER_SECOND * test_entries /
+		max(bench_hdl->wallclock_delta_ns, 1LL));
+	D_PRINT("Shards moved: "DF_U64" (%.4f%%, ideal %.4f%%)\n", moved,
+		100.0 * moved / ((double)test_entries * shards_per_obj),
+		100.0 * ideal);
+	D_PRINT("Receiving targets: %u, shards per receiver: max %u, "
+		"average %.2f\n", receivers, max_received,
+		receivers > 0 ? (double)moved / receivers : 0);
+
+	benchmark_free(bench_hdl);
+	D_FREE(received);
+}
+
+/* Extend the pool map with @domains_to_add domains like the existing ones */
+static void
+bench_pool_map_extend(struct pool_map *pool_map, uint32_t domains_to_add,
+		      uint32_t first_rank, uint32_t nodes_per_domain,
+		      uint32_t vos_per_target, uint32_t *ver)
+{
+	d_rank_list_t	 rank_list;
+	uint32_t	*domain_tree;
+	uint32_t	 tree_len;
+	uint32_t	 nodes = domains_to_add * nodes_per_domain;
+	bool		 updated;
+	uint32_t	 i;
+	int		 rc;
+
+	/* Same tuple layout as jtc_pool_map_extend(): root, domains, ranks */
+	tree_len = (domains_to_add + 1) * 3 + nodes;
+	D_ALLOC_ARRAY(domain_tree, tree_len);
+	D_ASSERT(domain_tree != NULL);
+	domain_tree[0] = 255;
+	domain_tree[1] = 0;
+	domain_tree[2] = domains_to_add;
+	for (i = 0; i < domains_to_add; i++) {
+		domain_tree[(i + 1) * 3] = 1;
+		domain_tree[(i + 1) * 3 + 1] = first_rank + i;
+		domain_tree[(i + 1) * 3 + 2] = nodes_per_domain;
+	}
+
+	rank_list.rl_nr = nodes;
+	D_ALLOC_ARRAY(rank_list.rl_ranks, nodes);
+	D_ASSERT(rank_list.rl_ranks != NULL);
+	for (i = 0; i < nodes; i++) {
+		rank_list.rl_ranks[i] = first_rank + i;
+		domain_tree[(domains_to_add + 1) * 3 + i] = first_rank + i;
+	}
+
+	rc = extend_test_pool_map(pool_map, nodes, &rank_list, tree_len,
+				  domain_tree, &updated, ver, vos_per_target);
+	D_ASSERT(rc == 0);
+	*ver = pool_map_get_version(pool_map);
+
+	D_FREE(rank_list.rl_ranks);
+	D_FREE(domain_tree);
+}
+
+static void
+benchmark_rebuild(int argc, char **argv, uint32_t num_domains,
+		  uint32_t nodes_per_domain, uint32_t vos_per_target)
+{
+	struct benchmark_handle	 *bench_hdl;
+	struct pool_map		 *pool_map;
+	struct pl_map		 *pl_map;
+	struct daos_obj_md	 *obj_table = NULL;
+	struct pl_obj_layout	**layout_table = NULL;
+	uint32_t		 *failed = NULL;
+	uint32_t		  total_targets;
+	uint32_t		  shards_per_obj;
+	uint32_t		  ver = 1;
+	int			  num_to_fail = DEFAULT_REBUILD_NUM_TO_FAIL;
+	int			  domains_to_add = DEFAULT_REBUILD_NUM_TO_ADD;
+	int			  test_entries = DEFAULT_REBUILD_TEST_ENTRIES;
+	int			  obj_idx;
+	int			  i;
+
+	while (1) {
+		static struct option long_options[] = {
+			{"num-to-fail", required_argument, 0, 'f'},
+			{"num-domains-to-add", required_argument, 0, 'a'},
+			{"num-test-entries", required_argument, 0, 't'},
+			{0, 0, 0, 0}
+		};
+		int c;
+		int ret;
+
+		c = getopt_long(argc, argv, "f:a:t:", long_options, NULL);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'f':
+			ret = sscanf(optarg, "%d", &num_to_fail);
+			if (ret != 1 || num_to_fail <= 0) {
+				D_PRINT("ERROR: Invalid num-to-fail\n");
+				benchmark_rebuild_usage();
+				return;
+			}
+			break;
+		case 'a':
+			ret = sscanf(optarg, "%d", &domains_to_add);
+			if (ret != 1 || domains_to_add <= 0) {
+				D_PRINT("ERROR: Invalid num-domains-to-add\n");
+				benchmark_rebuild_usage();
+				return;
+			}
+			break;
+		case 't':
+			ret = sscanf(optarg, "%d", &test_entries);
+			if (ret != 1 || test_entries <= 0) {
+				D_PRINT("ERROR: Invalid num-test-entries\n");
+				benchmark_rebuild_usage();
+				return;
+			}
+			break;
+		case '?':
+		default:
+			D_PRINT("ERROR: Unrecognized argument '%s'\n", optarg);
+			benchmark_rebuild_usage();
+			return;
+		}
+	}
+
+	total_targets = num_domains * nodes_per_domain * vos_per_target;
+	if (num_to_fail >= total_targets) {
+		D_PRINT("ERROR: num-to-fail must be less than %u targets\n",
+			total_targets);
+		return;
+	}
+
+	D_PRINT("\nRebuild benchmark: %u domains, %u nodes, %u targets, "
+		"%d objects\n", num_domains, num_domains * nodes_per_domain,
+		total_targets, test_entries);
+
+	gen_pool_and_placement_map(num_domains, nodes_per_domain,
+				   vos_per_target, PL_TYPE_JUMP_MAP,
+				   &pool_map, &pl_map);
+	D_ASSERT(pool_map != NULL);
+	D_ASSERT(pl_map != NULL);
+
+	D_ALLOC_ARRAY(obj_table, test_entries);
+	D_ASSERT(obj_table != NULL);
+	D_ALLOC_ARRAY(layout_table, test_entries);
+	D_ASSERT(layout_table != NULL);
+	D_ALLOC_ARRAY(failed, num_to_fail);
+	D_ASSERT(failed != NULL);
+
+	for (obj_idx = 0; obj_idx < test_entries; obj_idx++) {
+		int rc;
+
+		obj_table[obj_idx].omd_id.lo = rand();
+		obj_table[obj_idx].omd_id.hi = 5;
+		rc = daos_obj_set_oid_by_class(&obj_table[obj_idx].omd_id, 0,
+					       OC_RP_4G2, 0);
+		D_ASSERT(rc == 0);
+		obj_table[obj_idx].omd_ver = ver;
+	}
+
+	/* Initial placement */
+	bench_hdl = benchmark_alloc();
+	D_ASSERT(bench_hdl != NULL);
+	benchmark_start(bench_hdl);
+	for (obj_idx = 0; obj_idx < test_entries; obj_idx++)
+		pl_obj_place(pl_map, &obj_table[obj_idx], NULL,
+			     &layout_table[obj_idx]);
+	benchmark_stop(bench_hdl);
+
+	shards_per_obj = layout_table[0]->ol_nr;
+	D_PRINT("\nInitial placement: %lld ns for %d objects\n",
+		bench_hdl->wallclock_delta_ns, test_entries);
+	benchmark_free(bench_hdl);
+	print_balance(layout_table, test_entries, total_targets);
+	for (obj_idx = 0; obj_idx < test_entries; obj_idx++)
+		pl_obj_layout_free(layout_table[obj_idx]);
+	pl_map_decref(pl_map);
+
+	/* Rebuild, failed targets evenly spread over the whole pool */
+	for (i = 0; i < num_to_fail; i++) {
+		failed[i] = (uint64_t)i * total_targets / num_to_fail;
+		plt_fail_tgt(failed[i], &ver, pool_map, false);
+	}
+	pl_map = bench_pl_map_create(pool_map);
+	bench_find("Rebuild", pl_map, obj_table, test_entries, ver,
+		   total_targets, shards_per_obj,
+		   (double)num_to_fail / total_targets, pl_obj_find_rebuild);
+	pl_map_decref(pl_map);
+
+	/* Reintegration of the same targets */
+	for (i = 0; i < num_to_fail; i++)
+		plt_reint_tgt(failed[i], &ver, pool_map, false);
+	pl_map = bench_pl_map_create(pool_map);
+	bench_find("Reintegration", pl_map, obj_table, test_entries, ver,
+		   total_targets, shards_per_obj,
+		   (double)num_to_fail / total_targets, pl_obj_find_reint);
+	pl_map_decref(pl_map);
+	for (i = 0; i < num_to_fail; i++)
+		plt_reint_tgt_up(failed[i], &ver, pool_map, false);
+
+	/* Addition of whole domains */
+	bench_pool_map_extend(pool_map, domains_to_add,
+			      num_domains * nodes_per_domain, nodes_per_domain,
+			      vos_per_target, &ver);
+	pl_map = bench_pl_map_create(pool_map);
+	bench_find("Addition", pl_map, obj_table, test_entries, ver,
+		   total_targets + domains_to_add * nodes_per_domain *
+		   vos_per_target, shards_per_obj,
+		   (double)domains_to_add / (num_domains + domains_to_add),
+		   pl_obj_find_addition);
+
+	/* Balance once the new domains are fully in */
+	for (obj_idx = 0; obj_idx < test_entries; obj_idx++) {
+		obj_table[obj_idx].omd_ver = ver;
+		pl_obj_place(pl_map, &obj_table[obj_idx], NULL,
+			     &layout_table[obj_idx]);
+	}
+	D_PRINT("\nAfter addition, ");
+	print_balance(layout_table, test_entries, total_targets +
+		      domains_to_add * nodes_per_domain * vos_per_target);
+	for (obj_idx = 0; obj_idx < test_entries; obj_idx++)
+		pl_obj_layout_free(layout_table[obj_idx]);
+
+	free_pool_and_placement_map(pool_map, pl_map);
+	D_FREE(failed);
+	D_FREE(layout_table);
+	D_FREE(obj_table);
+}
+
+
 int
 main(int argc, char **argv)
 {
@@ -586,10 +1030,12 @@ main(int argc, char **argv)
 	test_op_t op_fn[] = {
 		benchmark_placement,
 		benchmark_add_data_movement,
+		benchmark_rebuild,
 	};
 	const char *const op_names[] = {
 		"benchmark-placement",
 		"benchmark-add",
+		"benchmark-rebuild",
 	};
 	D_ASSERT(ARRAY_SIZE(op_fn) == ARRAY_SIZE(op_names));
 
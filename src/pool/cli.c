@@ -30,6 +30,16 @@ struct rsvc_client_state {
 	struct dc_mgmt_sys *scs_sys;
 };
 
+/**
+ * When DAOS_POOL_CONNECT_SHARE is set, repeated connects from the same process
+ * to the same pool with the same flags and system share one pool handle
+ * instead of each sending a POOL_CONNECT RPC. The pool service only sees the
+ * first connect and the last disconnect.
+ */
+static bool		pool_connect_share;
+static D_LIST_HEAD(pool_share_list);
+static pthread_mutex_t	pool_share_lock = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * Initialize pool interface
  */
@@ -38,6 +48,9 @@ dc_pool_init(void)
 {
 	int rc;
 
+	pool_connect_share = false;
+	d_getenv_bool("DAOS_POOL_CONNECT_SHARE", &pool_connect_share);
+
 	rc = daos_rpc_register(&pool_proto_fmt, POOL_PROTO_CLI_COUNT,
 				NULL, DAOS_POOL_MODULE);
 	if (rc != 0)
@@ -66,6 +79,7 @@ pool_free(struct d_hlink *hlink)
 
 	pool = container_of(hlink, struct dc_pool, dp_hlink);
 	D_ASSERT(daos_hhash_link_empty(&pool->dp_hlink));
+	D_ASSERT(d_list_empty(&pool->dp_share_link));
 	D_RWLOCK_DESTROY(&pool->dp_map_lock);
 	D_MUTEX_DESTROY(&pool->dp_client_lock);
 	D_RWLOCK_DESTROY(&pool->dp_co_list_lock);
@@ -121,6 +135,75 @@ dc_pool_hdl_unlink(struct dc_pool *pool)
 	daos_hhash_link_delete(&pool->dp_hlink);
 }
 
+/**
+ * Look for an established connection to the pool identified by @label or
+ * @uuid that was made with the same @capas and system @grp. On success, take
+ * a share of it and return a handle to it in @poh.
+ */
+static bool
+pool_share_get(const char *label, uuid_t uuid, uint64_t capas,
+	       const char *grp, daos_handle_t *poh)
+{
+	struct dc_pool	*pool;
+	bool		 found = false;
+
+	if (grp == NULL)
+		grp = DAOS_DEFAULT_SYS_NAME;
+
+	D_MUTEX_LOCK(&pool_share_lock);
+	d_list_for_each_entry(pool, &pool_share_list, dp_share_link) {
+		if (pool->dp_capas != capas || pool->dp_disconnecting ||
+		    strcmp(pool->dp_sys->sy_name, grp) != 0)
+			continue;
+		if (label != NULL ? strcmp(pool->dp_label, label) != 0 :
+		    uuid_compare(pool->dp_pool, uuid) != 0)
+			continue;
+
+		pool->dp_share_nr++;
+		dc_pool2hdl(pool, poh);
+		found = true;
+		D_DEBUG(DF_DSMC, DF_UUID": connected: cookie="DF_X64" hdl="
+			DF_UUID" shared %u\n", DP_UUID(pool->dp_pool),
+			poh->cookie, DP_UUID(pool->dp_pool_hdl),
+			pool->dp_share_nr);
+		break;
+	}
+	D_MUTEX_UNLOCK(&pool_share_lock);
+
+	return found;
+}
+
+static void
+pool_share_add(struct dc_pool *pool)
+{
+	D_MUTEX_LOCK(&pool_share_lock);
+	pool->dp_share_nr = 1;
+	d_list_add(&pool->dp_share_link, &pool_share_list);
+	D_MUTEX_UNLOCK(&pool_share_lock);
+}
+
+/**
+ * Drop one share of the connection. Returns true if other connects still
+ * share it, in which case the caller must not disconnect from the pool.
+ */
+static bool
+pool_share_put(struct dc_pool *pool)
+{
+	bool	shared = false;
+
+	D_MUTEX_LOCK(&pool_share_lock);
+	if (!d_list_empty(&pool->dp_share_link)) {
+		D_ASSERT(pool->dp_share_nr > 0);
+		if (--pool->dp_share_nr > 0)
+			shared = true;
+		else
+			d_list_del_init(&pool->dp_share_link);
+	}
+	D_MUTEX_UNLOCK(&pool_share_lock);
+
+	return shared;
+}
+
 static inline int
 flags_are_valid(unsigned int flags)
 {
@@ -147,6 +230,7 @@ dc_pool_alloc(unsigned int nr)
 
 	daos_hhash_hlink_init(&pool->dp_hlink, &pool_h_ops);
 	D_INIT_LIST_HEAD(&pool->dp_co_list);
+	D_INIT_LIST_HEAD(&pool->dp_share_link);
 	rc = D_RWLOCK_INIT(&pool->dp_co_list_lock, NULL);
 	if (rc != 0)
 		goto failed;
@@ -425,6 +509,8 @@ pool_connect_cp(tse_task_t *task, void *data)
 	/* add pool to hhash */
 	dc_pool_hdl_link(pool); /* +1 ref */
 	dc_pool2hdl(pool, arg->hdlp); /* +1 ref */
+	if (pool_connect_share)
+		pool_share_add(pool);
 
 	D_DEBUG(DF_DSMC, DF_UUID": connected: cookie="DF_X64" hdl="DF_UUID
 		" master\n", DP_UUID(pool->dp_pool), arg->hdlp->cookie,
@@ -453,10 +539,12 @@ init_pool(const char *label, uuid_t uuid, uint64_t capas, const char *grp,
 	if (pool == NULL)
 		return -DER_NOMEM;
 
-	if (label)
+	if (label) {
 		uuid_clear(pool->dp_pool);
-	else
+		strncpy(pool->dp_label, label, DAOS_PROP_LABEL_MAX_LEN);
+	} else {
 		uuid_copy(pool->dp_pool, uuid);
+	}
 	uuid_generate(pool->dp_pool_hdl);
 	pool->dp_capas = capas;
 
@@ -599,6 +687,12 @@ dc_pool_connect(tse_task_t *task)
 		if (!flags_are_valid(args->flags) || args->poh == NULL)
 			D_GOTO(out_task, rc = -DER_INVAL);
 
+		/** pool info needs a query RPC, don't share if it's asked */
+		if (pool_connect_share && args->info == NULL &&
+		    pool_share_get(label, uuid, args->flags, args->grp,
+				   args->poh))
+			D_GOTO(out_task, rc = 0);
+
 		/** allocate and fill in pool connection */
 		rc = init_pool(label, uuid, args->flags, args->grp, &pool);
 		if (rc)
@@ -706,6 +800,13 @@ dc_pool_disconnect(tse_task_t *task)
 		"\n", DP_UUID(pool->dp_pool), DP_UUID(pool->dp_pool_hdl),
 		args->poh.cookie);
 
+	/* other connects still use the handle, containers may be open */
+	if (pool_share_put(pool)) {
+		dc_pool_put(pool); /* the ref taken by pool_share_get() */
+		args->poh.cookie = 0;
+		D_GOTO(out_pool, rc = 0);
+	}
+
 	D_RWLOCK_RDLOCK(&pool->dp_co_list_lock);
 	if (!d_list_empty(&pool->dp_co_list)) {
 		D_RWLOCK_UNLOCK(&pool->dp_co_list_lock);
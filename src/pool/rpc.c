@@ -182,6 +182,9 @@ pool_query_bits(daos_pool_info_t *po_info, daos_prop_t *prop)
 		case DAOS_PROP_PO_EC_CELL_SZ:
 			bits |= DAOS_PO_QUERY_PROP_EC_CELL_SZ;
 			break;
+		case DAOS_PROP_PO_SCHED_WEIGHT:
+			bits |= DAOS_PO_QUERY_PROP_SCHED_WEIGHT;
+			break;
 		case DAOS_PROP_PO_ACL:
 			bits |= DAOS_PO_QUERY_PROP_ACL;
 			break;
@@ -28,6 +28,7 @@ RDB_STRING_KEY(ds_pool_prop_, connectable);
 RDB_STRING_KEY(ds_pool_prop_, nhandles);
 RDB_STRING_KEY(ds_pool_prop_, handles);
 RDB_STRING_KEY(ds_pool_prop_, ec_cell_sz);
+RDB_STRING_KEY(ds_pool_prop_, sched_weight);
 RDB_STRING_KEY(ds_pool_attr_, user);
 
 /** default properties, should cover all optional pool properties */
@@ -60,6 +61,9 @@ struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
 	}, {
 		.dpe_type	= DAOS_PROP_PO_EC_CELL_SZ,
 		.dpe_val	= DAOS_EC_CELL_DEF,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_SCHED_WEIGHT,
+		.dpe_val	= DAOS_PROP_PO_SCHED_WEIGHT_DEF,
 	}
 };
 
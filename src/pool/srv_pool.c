@@ -232,6 +232,7 @@ pool_prop_default_copy(daos_prop_t *prop_def, daos_prop_t *prop)
 		case DAOS_PROP_PO_SELF_HEAL:
 		case DAOS_PROP_PO_RECLAIM:
 		case DAOS_PROP_PO_EC_CELL_SZ:
+		case DAOS_PROP_PO_SCHED_WEIGHT:
 			entry_def->dpe_val = entry->dpe_val;
 			break;
 		case DAOS_PROP_PO_ACL:
@@ -344,6 +345,12 @@ pool_prop_write(struct rdb_tx *tx, const rdb_path_t *kvs, daos_prop_t *prop,
 			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_ec_cell_sz,
 					   &value);
 			break;
+		case DAOS_PROP_PO_SCHED_WEIGHT:
+			d_iov_set(&value, &entry->dpe_val,
+				     sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_sched_weight,
+					   &value);
+			break;
 		case DAOS_PROP_PO_SVC_LIST:
 			break;
 		default:
@@ -1647,6 +1654,8 @@ pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 		nr++;
 	if (bits & DAOS_PO_QUERY_PROP_EC_CELL_SZ)
 		nr++;
+	if (bits & DAOS_PO_QUERY_PROP_SCHED_WEIGHT)
+		nr++;
 	if (nr == 0)
 		return 0;
 
@@ -1717,6 +1726,20 @@ pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 		prop->dpp_entries[idx].dpe_val = val;
 		idx++;
 	}
+	if (bits & DAOS_PO_QUERY_PROP_SCHED_WEIGHT) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_sched_weight,
+				   &value);
+		/* Pools created before the property have the default weight */
+		if (rc == -DER_NONEXIST)
+			val = DAOS_PROP_PO_SCHED_WEIGHT_DEF;
+		else if (rc != 0)
+			return rc;
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_SCHED_WEIGHT;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
 	if (bits & DAOS_PO_QUERY_PROP_ACL) {
 		d_iov_set(&value, NULL, 0);
 		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_acl,
@@ -2802,6 +2825,7 @@ ds_pool_query_handler(crt_rpc_t *rpc)
 			case DAOS_PROP_PO_SELF_HEAL:
 			case DAOS_PROP_PO_RECLAIM:
 			case DAOS_PROP_PO_EC_CELL_SZ:
+			case DAOS_PROP_PO_SCHED_WEIGHT:
 				if (entry->dpe_val != iv_entry->dpe_val) {
 					D_ERROR("type %d mismatch "DF_U64" - "
 						DF_U64".\n", entry->dpe_type,
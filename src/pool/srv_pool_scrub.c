@@ -14,6 +14,8 @@
 
 /** Hardcoded target interval for scrubber to complete */
 #define MSEC_IN_SEC 1000
+/** Minimum pause between checksum calculations while serving I/O */
+#define SCRUB_BUSY_PAUSE_MSEC	50
 
 struct scrub_ctx {
 	/**
@@ -71,6 +73,30 @@ between_scrub_sec()
 	return sec != NULL ? atoll(sec) : 24 * 60 * 60;
 }
 
+/**
+ * Pause after each checksum calculation. While the target is idle, the
+ * scrubber only yields and gets ahead of schedule; while it's serving I/O,
+ * the scrubber backs off to the paced interval, and at least
+ * SCRUB_BUSY_PAUSE_MSEC, so it doesn't compete with foreground requests.
+ */
+static void
+scrub_pause(struct scrub_ctx *ctx)
+{
+	daos_size_t	msec = ctx->msec_between_calcs;
+
+	if (!dss_xstream_is_busy()) {
+		C_TRACE("Yield after data scrub (idle)\n");
+		dss_ult_yield(ctx->req);
+		return;
+	}
+
+	if (msec < SCRUB_BUSY_PAUSE_MSEC)
+		msec = SCRUB_BUSY_PAUSE_MSEC;
+
+	C_TRACE("Sleeping after data scrub for "DF_U64" msec\n", msec);
+	sched_req_sleep(ctx->req, msec);
+}
+
 /** vos_iter_cb_t */
 static int
 obj_iter_scrub_cb(daos_handle_t ih, vos_iter_entry_t *entry,
@@ -97,15 +123,7 @@ obj_iter_scrub_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 	 * checksum.
 	 */
 	ctx->pool_csums_scrubbed++;
-
-	if (ctx->msec_between_calcs == 0) {
-		C_TRACE("Yield after data scrub\n");
-		dss_ult_yield(ctx->req);
-	} else {
-		C_TRACE("Sleeping after data scrub for "DF_U64" msec\n",
-			ctx->msec_between_calcs);
-		sched_req_sleep(ctx->req, ctx->msec_between_calcs);
-	}
+	scrub_pause(ctx);
 
 	return 0;
 }
@@ -356,6 +356,7 @@ pool_alloc_ref(void *key, unsigned int ksize, void *varg,
 	uuid_copy(pool->sp_uuid, key);
 	pool->sp_map_version = arg->pca_map_version;
 	pool->sp_reclaim = DAOS_RECLAIM_LAZY; /* default reclaim strategy */
+	pool->sp_sched_weight = DAOS_PROP_PO_SCHED_WEIGHT_DEF;
 
 	/** set up ds_pool metrics */
 	rc = ds_pool_metrics_start(pool);
@@ -1361,13 +1362,39 @@ ds_pool_tgt_query_aggregator(crt_rpc_t *source, crt_rpc_t *result, void *priv)
 	return 0;
 }
 
+/* Called via dss_collective() to set the WFQ weight of the pool */
+static int
+pool_sched_weight_one(void *arg)
+{
+	struct ds_pool *pool = arg;
+
+	return sched_set_pool_weight(pool->sp_uuid, pool->sp_sched_weight);
+}
+
 int
 ds_pool_tgt_prop_update(struct ds_pool *pool, struct pool_iv_prop *iv_prop)
 {
+	uint32_t	weight;
+	int		rc;
+
 	D_ASSERT(dss_get_module_info()->dmi_xs_id == 0);
 	pool->sp_ec_cell_sz = iv_prop->pip_ec_cell_sz;
 	pool->sp_reclaim = iv_prop->pip_reclaim;
-	return 0;
+
+	if (iv_prop->pip_sched_weight == 0 ||
+	    iv_prop->pip_sched_weight == pool->sp_sched_weight)
+		return 0;
+
+	weight = pool->sp_sched_weight;
+	pool->sp_sched_weight = iv_prop->pip_sched_weight;
+	rc = dss_task_collective(pool_sched_weight_one, pool, 0);
+	if (rc) {
+		D_ERROR(DF_UUID": failed to set sched weight %u: "DF_RC"\n",
+			DP_UUID(pool->sp_uuid), pool->sp_sched_weight, DP_RC(rc));
+		/* Retry on the next update */
+		pool->sp_sched_weight = weight;
+	}
+	return rc;
 }
 
 /**
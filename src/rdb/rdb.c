@@ -269,7 +269,7 @@ rdb_start_internal(daos_handle_t pool, daos_handle_t mc, const uuid_t uuid,
 		goto err_raft_mutex;
 	}
 
-	rc = rdb_kvs_cache_create(&db->d_kvss);
+	rc = rdb_kvs_cache_create(db);
 	if (rc != 0)
 		goto err_ref_cv;
 
@@ -52,6 +52,10 @@ struct rdb {
 	struct rdb_cbs	       *d_cbs;		/* callers' callbacks */
 	void		       *d_arg;		/* for d_cbs callbacks */
 	struct daos_lru_cache  *d_kvss;		/* rdb_kvs cache */
+	uint64_t		d_kvs_gen;	/* of KVS creations */
+	struct d_tm_node_t     *d_kvs_hit;	/* rdb_kvs cache hits */
+	struct d_tm_node_t     *d_kvs_miss;	/* rdb_kvs cache misses */
+	struct d_tm_node_t     *d_kvs_neg_hit;	/* negative entry hits */
 	daos_handle_t		d_pool;		/* VOS pool */
 	daos_handle_t		d_mc;		/* metadata container */
 
@@ -66,6 +70,10 @@ struct rdb {
 	uint64_t		d_applied;	/* last applied index */
 	uint64_t		d_debut;	/* first entry in a term */
 	ABT_cond		d_applied_cv;	/* for d_applied updates */
+	uint64_t		d_verify_gen;	/* last leadership check begun */
+	uint64_t		d_verify_done;	/* last leadership check done */
+	int			d_verify_rc;	/* of d_verify_done */
+	bool			d_verifying;	/* a leadership check inflight */
 	struct d_hash_table	d_results;	/* rdb_raft_result hash */
 	d_list_t		d_requests;	/* RPCs waiting for replies */
 	d_list_t		d_replies;	/* RPCs received replies */
@@ -270,10 +278,12 @@ struct rdb_kvs {
 	struct daos_llink	de_entry;	/* in LRU */
 	rdb_path_t		de_path;
 	rdb_oid_t		de_object;
+	uint64_t		de_gen;		/* d_kvs_gen if de_nonexist */
+	bool			de_nonexist;	/* negative entry */
 	uint8_t			de_buf[];	/* for de_path */
 };
 
-int rdb_kvs_cache_create(struct daos_lru_cache **cache);
+int rdb_kvs_cache_create(struct rdb *db);
 void rdb_kvs_cache_destroy(struct daos_lru_cache *cache);
 void rdb_kvs_cache_evict(struct daos_lru_cache *cache);
 int rdb_kvs_lookup(struct rdb *db, const rdb_path_t *path, uint64_t index,
@@ -9,11 +9,18 @@
  * This file implements an LRU cache of rdb_kvs objects, each of which maps a
  * KVS path to the matching VOS object. The cache provides better KVS path
  * lookup performance.
+ *
+ * A lookup that finds no KVS at a path (with alloc == true) leaves a negative
+ * entry behind, so that repeated queries for a nonexistent KVS do not walk the
+ * path in VOS again. A negative entry remains valid only until the next KVS
+ * creation, as tracked by rdb.d_kvs_gen.
  */
 
 #define D_LOGFAC	DD_FAC(rdb)
 
 #include <daos_srv/rdb.h>
+#include <gurt/telemetry_common.h>
+#include <gurt/telemetry_producer.h>
 
 #include "rdb_internal.h"
 #include "rdb_layout.h"
@@ -92,7 +99,9 @@ rdb_kvs_obj(struct daos_llink *entry)
 struct rdb_kvs_alloc_arg {
 	struct rdb     *dea_db;
 	uint64_t	dea_index;
+	uint64_t	dea_gen;
 	bool		dea_alloc;
+	bool		dea_created;
 };
 
 static int
@@ -121,11 +130,17 @@ rdb_kvs_alloc_ref(void *key, unsigned int ksize, void *varg,
 	/* kvs->de_object */
 	rc = rdb_kvs_open_path(arg->dea_db, arg->dea_index, &kvs->de_path,
 			       &kvs->de_object);
-	if (rc != 0)
+	if (rc == -DER_NONEXIST) {
+		kvs->de_nonexist = true;
+		kvs->de_gen = arg->dea_gen;
+	} else if (rc != 0) {
 		goto err_kvs;
+	}
 
-	D_DEBUG(DB_TRACE, DF_DB": created %p len %u\n", DP_DB(arg->dea_db), kvs,
-		ksize);
+	D_DEBUG(DB_TRACE, DF_DB": created %p len %u nonexist %d\n",
+		DP_DB(arg->dea_db), kvs, ksize, kvs->de_nonexist);
+	d_tm_inc_counter(arg->dea_db->d_kvs_miss, 1);
+	arg->dea_created = true;
 	*link = &kvs->de_entry;
 	return 0;
 
@@ -172,11 +187,58 @@ static struct daos_llink_ops rdb_kvs_cache_ops = {
 	.lop_rec_hash	= rdb_kvs_rec_hash,
 };
 
+static int
+rdb_kvs_cache_bits(void)
+{
+	char	       *name = "RDB_KVS_CACHE_BITS";
+	unsigned int	default_value = 5;
+	unsigned int	value = default_value;
+
+	d_getenv_int(name, &value);
+	if (value > 16) {
+		D_WARN("%s not in [0, 16] (defaulting to %u)\n", name, default_value);
+		value = default_value;
+	}
+	return value;
+}
+
+static void
+rdb_kvs_metrics_init(struct rdb *db)
+{
+	int rc;
+
+	rc = d_tm_add_metric(&db->d_kvs_hit, D_TM_COUNTER, "KVS cache hits", NULL,
+			     "rdb/"DF_UUIDF"/kvs_cache/hit", DP_UUID(db->d_uuid));
+	if (rc != 0)
+		D_WARN(DF_DB": failed to create KVS cache hit counter: "DF_RC"\n",
+		       DP_DB(db), DP_RC(rc));
+
+	rc = d_tm_add_metric(&db->d_kvs_miss, D_TM_COUNTER, "KVS cache misses", NULL,
+			     "rdb/"DF_UUIDF"/kvs_cache/miss", DP_UUID(db->d_uuid));
+	if (rc != 0)
+		D_WARN(DF_DB": failed to create KVS cache miss counter: "DF_RC"\n",
+		       DP_DB(db), DP_RC(rc));
+
+	rc = d_tm_add_metric(&db->d_kvs_neg_hit, D_TM_COUNTER,
+			     "KVS cache hits on nonexistent KVSs", NULL,
+			     "rdb/"DF_UUIDF"/kvs_cache/neg_hit", DP_UUID(db->d_uuid));
+	if (rc != 0)
+		D_WARN(DF_DB": failed to create KVS cache negative hit counter: "
+		       DF_RC"\n", DP_DB(db), DP_RC(rc));
+}
+
 int
-rdb_kvs_cache_create(struct daos_lru_cache **cache)
+rdb_kvs_cache_create(struct rdb *db)
 {
-	return daos_lru_cache_create(5 /* bits */, D_HASH_FT_NOLOCK /* feats */,
-				     &rdb_kvs_cache_ops, cache);
+	int rc;
+
+	rc = daos_lru_cache_create(rdb_kvs_cache_bits(), D_HASH_FT_NOLOCK /* feats */,
+				   &rdb_kvs_cache_ops, &db->d_kvss);
+	if (rc != 0)
+		return rc;
+
+	rdb_kvs_metrics_init(db);
+	return 0;
 }
 
 void
@@ -205,11 +267,30 @@ rdb_kvs_lookup(struct rdb *db, const rdb_path_t *path, uint64_t index,
 	arg.dea_db = db;
 	arg.dea_index = index;
 	arg.dea_alloc = alloc;
+retry:
+	arg.dea_gen = db->d_kvs_gen;
+	arg.dea_created = false;
 	rc = daos_lru_ref_hold(db->d_kvss, path->iov_buf, path->iov_len, &arg,
 			       &entry);
 	if (rc != 0)
 		return rc;
 
+	if (rdb_kvs_obj(entry)->de_nonexist) {
+		bool stale = (rdb_kvs_obj(entry)->de_gen != db->d_kvs_gen);
+
+		/* A KVS may have been created at path since; look again. */
+		if (stale)
+			daos_lru_ref_evict(db->d_kvss, entry);
+		else if (!arg.dea_created)
+			d_tm_inc_counter(db->d_kvs_neg_hit, 1);
+		daos_lru_ref_release(db->d_kvss, entry);
+		if (stale)
+			goto retry;
+		return -DER_NONEXIST;
+	}
+
+	if (!arg.dea_created)
+		d_tm_inc_counter(db->d_kvs_hit, 1);
 	*kvs = rdb_kvs_obj(entry);
 	return 0;
 }
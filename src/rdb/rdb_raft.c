@@ -375,6 +375,16 @@ rdb_raft_unload_snapshot(struct rdb *db)
 	rdb_raft_unload_replicas(db);
 }
 
+/*
+ * Sizes of the key descriptor and data buffers of an INSTALLSNAPSHOT chunk.
+ * Each chunk costs a round trip, and a service DB mostly holds small KVs,
+ * each taking up to four descriptors (object, dkey, akey and value). When
+ * the descriptor buffer only held 256 of them, chunks were nearly empty and
+ * catching up a replica of a big service took thousands of round trips.
+ */
+#define RDB_IS_KDS_SIZE		(64 * 1024)
+#define RDB_IS_DATA_SIZE	(4 * 1024 * 1024)
+
 static int
 rdb_raft_pack_chunk(daos_handle_t lc, struct rdb_raft_is *is, d_iov_t *kds,
 		    d_iov_t *data, struct rdb_anchor *anchor)
@@ -463,14 +473,14 @@ rdb_raft_cb_send_installsnapshot(raft_server_t *raft, void *arg,
 	 * Allocate the data buffers. The sizes mustn't change during the term
 	 * of the leadership.
 	 */
-	kds.iov_buf_len = 4 * 1024;
+	kds.iov_buf_len = RDB_IS_KDS_SIZE;
 	kds.iov_len = 0;
 	D_ALLOC(kds.iov_buf, kds.iov_buf_len);
 	if (kds.iov_buf == NULL)
 		goto err_rpc;
-	data.iov_buf_len = 1 * 1024 * 1024;
+	data.iov_buf_len = RDB_IS_DATA_SIZE;
 	data.iov_len = 0;
-	D_ALLOC(data.iov_buf, data.iov_buf_len);
+	D_ALLOC_NZ(data.iov_buf, data.iov_buf_len);
 	if (data.iov_buf == NULL)
 		goto err_kds;
 
@@ -1965,16 +1975,48 @@ rdb_raft_append_apply(struct rdb *db, void *entry, size_t size, void *result)
 	return rdb_raft_append_apply_internal(db, &mentry, result);
 }
 
-/* Verify the leadership with a quorum. */
+/*
+ * Verify the leadership with a quorum. Caller must hold d_raft_mutex.
+ *
+ * Any empty entry appended after this call begins and applied in the current
+ * term proves the leadership, so concurrent callers share the checks: while
+ * one is inflight, later callers wait for it and then for the next one, which
+ * is begun by the first of them to wake up. A burst of queries thus costs two
+ * log round trips instead of one each.
+ */
 int
 rdb_raft_verify_leadership(struct rdb *db)
 {
-	/*
-	 * raft does not provide this functionality yet; append an empty entry
-	 * as a (slower) workaround.
-	 */
-	return rdb_raft_append_apply(db, NULL /* entry */, 0 /* size */,
-				     NULL /* result */);
+	uint64_t	gen = db->d_verify_gen + 1;
+	int		rc;
+
+	while (db->d_verify_done < gen) {
+		if (db->d_stop)
+			return -DER_CANCELED;
+
+		if (!db->d_verifying) {
+			db->d_verifying = true;
+			db->d_verify_gen++;
+			D_ASSERT(db->d_verify_gen >= gen);
+			/*
+			 * raft does not provide this functionality yet; append
+			 * an empty entry as a (slower) workaround.
+			 */
+			rc = rdb_raft_append_apply(db, NULL /* entry */,
+						   0 /* size */,
+						   NULL /* result */);
+			db->d_verify_rc = rc;
+			db->d_verify_done = db->d_verify_gen;
+			db->d_verifying = false;
+			/* the waiters below sleep on d_applied_cv */
+			ABT_cond_broadcast(db->d_applied_cv);
+			return rc;
+		}
+
+		ABT_cond_wait(db->d_applied_cv, db->d_raft_mutex);
+	}
+
+	return db->d_verify_rc;
 }
 
 /* Generate a random double in [0.0, 1.0]. */
@@ -749,6 +749,10 @@ rdb_tx_apply_op(struct rdb *db, uint64_t index, struct rdb_tx_op *op, bool crit)
 			goto out_victim_path;
 	}
 
+	/* Invalidate all negative rdb_kvs entries. */
+	if (op->dto_opc == RDB_TX_CREATE_ROOT || op->dto_opc == RDB_TX_CREATE)
+		db->d_kvs_gen++;
+
 	switch (op->dto_opc) {
 	case RDB_TX_CREATE_ROOT:
 		rc = rdb_tx_apply_create(db, index, RDB_LC_ATTRS, &rdb_lc_root,
@@ -19,6 +19,8 @@
 #include <daos/pool_map.h>
 #include <daos_srv/daos_engine.h>
 #include <daos_srv/rebuild.h>
+#include <gurt/telemetry_common.h>
+#include <gurt/telemetry_producer.h>
 
 /* Track the pool rebuild status on each target, which exists on
  * all server targets. Then each target will report its rebuild
@@ -193,13 +195,28 @@ struct rebuild_task {
 	uint32_t			dst_map_ver;
 };
 
+/* Per pool per target rebuild metrics */
+struct rebuild_pool_metrics {
+	/** Total number of objects scanned (type = counter) */
+	struct d_tm_node_t	*rpm_obj_scanned;
+	/** Total number of object shards found to rebuild (type = counter) */
+	struct d_tm_node_t	*rpm_obj_found;
+	/** Objects scanned per second of the last scan (type = gauge) */
+	struct d_tm_node_t	*rpm_scan_rate;
+	/** Objects sent per migrate RPC (type = stats gauge) */
+	struct d_tm_node_t	*rpm_send_batch;
+};
+
 /* Per pool structure in TLS to check pool rebuild status
  * per xstream.
  */
 struct rebuild_pool_tls {
 	uuid_t		rebuild_pool_uuid;
 	daos_handle_t	rebuild_tree_hdl; /*hold objects being rebuilt */
+	/* objects without any redundancy left, sent before the others */
+	daos_handle_t	rebuild_urgent_tree_hdl;
 	d_list_t	rebuild_pool_list;
+	struct rebuild_pool_metrics *rebuild_pool_metrics;
 	uint64_t	rebuild_pool_obj_count;
 	uint64_t	rebuild_pool_reclaim_obj_count;
 	unsigned int	rebuild_pool_ver;
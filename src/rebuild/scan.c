@@ -28,13 +28,22 @@
 #include "rebuild_internal.h"
 
 #define REBUILD_SEND_LIMIT	4096
+/**
+ * While the scan is still running, the sender holds objects back until at
+ * least REBUILD_SEND_MIN of them are pending or REBUILD_SEND_WAIT seconds
+ * have passed, so the scan doesn't turn into a stream of tiny migrate RPCs.
+ */
+#define REBUILD_SEND_MIN	256
+#define REBUILD_SEND_WAIT	1
 struct rebuild_send_arg {
 	struct rebuild_tgt_pool_tracker *rpt;
+	struct rebuild_pool_metrics	*rpm;
 	daos_unit_oid_t			*oids;
 	daos_epoch_t			*ephs;
 	daos_epoch_t			*punched_ephs;
 	uuid_t				cont_uuid;
 	unsigned int			*shards;
+	uint64_t			sent;
 	int				count;
 	int				tgt_id;
 };
@@ -136,6 +145,12 @@ rebuild_obj_send_cb(struct tree_cache_root *root, struct rebuild_send_arg *arg)
 			DP_UUID(rpt->rt_pool_uuid), arg->tgt_id);
 		ABT_thread_yield();
 	}
+
+	if (rc == 0) {
+		arg->sent += arg->count;
+		if (arg->rpm != NULL)
+			d_tm_set_gauge(arg->rpm->rpm_send_batch, arg->count);
+	}
 out:
 	return rc;
 }
@@ -198,6 +213,7 @@ rebuild_objects_send_ult(void *data)
 	daos_epoch_t			*ephs = NULL;
 	daos_epoch_t			*punched_ephs = NULL;
 	unsigned int			*shards = NULL;
+	uint64_t			 last_send;
 	int				rc = 0;
 
 	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid, rpt->rt_rebuild_ver);
@@ -216,7 +232,7 @@ rebuild_objects_send_ult(void *data)
 		D_GOTO(out, rc = -DER_NOMEM);
 
 	D_ALLOC_ARRAY(punched_ephs, REBUILD_SEND_LIMIT);
-	if (ephs == NULL)
+	if (punched_ephs == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
 	arg.count = 0;
@@ -225,12 +241,41 @@ rebuild_objects_send_ult(void *data)
 	arg.ephs = ephs;
 	arg.punched_ephs = punched_ephs;
 	arg.rpt = rpt;
-	while (!tls->rebuild_pool_scan_done || !dbtree_is_empty(tls->rebuild_tree_hdl)) {
+	arg.rpm = tls->rebuild_pool_metrics;
+	last_send = daos_gettime_coarse();
+	while (!tls->rebuild_pool_scan_done || !dbtree_is_empty(tls->rebuild_tree_hdl) ||
+	       !dbtree_is_empty(tls->rebuild_urgent_tree_hdl)) {
+		bool	urgent;
+
 		if (rpt->rt_stable_epoch == 0) {
 			ABT_thread_yield();
 			continue;
 		}
 
+		/* objects without redundancy left don't wait for a batch */
+		urgent = !dbtree_is_empty(tls->rebuild_urgent_tree_hdl);
+		if (urgent) {
+			rc = dbtree_iterate(tls->rebuild_urgent_tree_hdl,
+					    DAOS_INTENT_MIGRATION, false,
+					    rebuild_cont_send_cb, &arg);
+			if (rc < 0) {
+				D_ERROR("dbtree iterate failed: "DF_RC"\n",
+					DP_RC(rc));
+				break;
+			}
+			ABT_thread_yield();
+			continue;
+		}
+
+		/* wait for a fuller batch while the scan is still feeding */
+		if (!tls->rebuild_pool_scan_done &&
+		    tls->rebuild_pool_obj_count - arg.sent < REBUILD_SEND_MIN &&
+		    daos_gettime_coarse() - last_send < REBUILD_SEND_WAIT) {
+			ABT_thread_yield();
+			continue;
+		}
+		last_send = daos_gettime_coarse();
+
 		/* walk through the rebuild tree and send the rebuild objects */
 		rc = dbtree_iterate(tls->rebuild_tree_hdl, DAOS_INTENT_MIGRATION,
 				    false, rebuild_cont_send_cb, &arg);
@@ -278,16 +323,19 @@ rebuild_scan_done(void *data)
 static int
 rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt,
 		      unsigned int tgt_id, unsigned int shard, uuid_t co_uuid,
-		      daos_unit_oid_t oid, daos_epoch_t epoch, daos_epoch_t punched_epoch)
+		      daos_unit_oid_t oid, daos_epoch_t epoch, daos_epoch_t punched_epoch,
+		      bool urgent)
 {
 	struct rebuild_pool_tls *tls;
 	struct rebuild_obj_val	val;
 	d_iov_t			val_iov;
+	daos_handle_t		toh;
 	int			rc;
 
 	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid, rpt->rt_rebuild_ver);
 	D_ASSERT(tls != NULL);
-	D_ASSERT(daos_handle_is_valid(tls->rebuild_tree_hdl));
+	toh = urgent ? tls->rebuild_urgent_tree_hdl : tls->rebuild_tree_hdl;
+	D_ASSERT(daos_handle_is_valid(toh));
 
 	tls->rebuild_pool_obj_count++;
 	val.eph = epoch;
@@ -296,7 +344,7 @@ rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt,
 	val.tgt_id = tgt_id;
 	d_iov_set(&val_iov, &val, sizeof(struct rebuild_obj_val));
 	oid.id_shard = shard; /* Convert the OID to rebuilt one */
-	rc = obj_tree_insert(tls->rebuild_tree_hdl, co_uuid, oid, &val_iov);
+	rc = obj_tree_insert(toh, co_uuid, oid, &val_iov);
 	if (rc == -DER_EXIST) {
 		/* If there is reintegrate being restarted due to the failure, then
 		 * it might put multiple shards into the same VOS target, because
@@ -316,12 +364,44 @@ rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt,
 	return rc;
 }
 
+/**
+ * Whether the redundancy group of @oid has lost all its redundancy. Such
+ * objects are one more failure away from data loss, so they are rebuilt
+ * ahead of the others.
+ */
+static bool
+rebuild_obj_is_urgent(struct rebuild_tgt_pool_tracker *rpt,
+		      struct daos_oclass_attr *oc_attr, daos_unit_oid_t oid,
+		      uint32_t grp_size, unsigned int *shards, int shard_nr)
+{
+	unsigned int	tolerance;
+	int		lost = 0;
+	int		i;
+
+	if (rpt->rt_rebuild_op != RB_OP_FAIL)
+		return false;
+
+	tolerance = daos_oclass_is_ec(oc_attr) ? oc_attr->u.ec.e_p :
+						 grp_size - 1;
+	if (tolerance == 0)
+		return false;
+
+	for (i = 0; i < shard_nr; i++) {
+		if (shards[i] / grp_size == oid.id_shard / grp_size)
+			lost++;
+	}
+
+	return lost >= tolerance;
+}
+
 #define LOCAL_ARRAY_SIZE	128
 #define NUM_SHARDS_STEP_INCREASE	10
 /* The structure for scan per xstream */
 struct rebuild_scan_arg {
 	struct rebuild_tgt_pool_tracker *rpt;
+	struct rebuild_pool_metrics	*rpm;
 	uuid_t				co_uuid;
+	uint64_t			obj_scanned;
 	int				snapshot_cnt;
 	uint32_t			yield_freq;
 };
@@ -485,6 +565,7 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 	struct daos_oclass_attr		*oc_attr;
 	uint32_t			grp_size;
 	int				rebuild_nr = 0;
+	bool				urgent;
 	d_rank_t			myrank;
 	int				i;
 	int				rc = 0;
@@ -501,6 +582,10 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 		return 0;
 	}
 
+	arg->obj_scanned++;
+	if (arg->rpm != NULL)
+		d_tm_inc_counter(arg->rpm->rpm_obj_scanned, 1);
+
 	/* If the OID is invisible, then snapshots must be created on the object. */
 	D_ASSERTF(!(ent->ie_vis_flags & VOS_VIS_FLAG_COVERED) || arg->snapshot_cnt > 0,
 		  "flags %x snapshot_cnt %d\n", ent->ie_vis_flags, arg->snapshot_cnt);
@@ -614,6 +699,12 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 	if (rebuild_nr <= 0) /* No need rebuild */
 		D_GOTO(out, rc = rebuild_nr);
 
+	if (arg->rpm != NULL)
+		d_tm_inc_counter(arg->rpm->rpm_obj_found, rebuild_nr);
+
+	urgent = rebuild_obj_is_urgent(rpt, oc_attr, oid, grp_size, shards,
+				       rebuild_nr);
+
 	for (i = 0; i < rebuild_nr; i++) {
 		struct pool_target *target;
 
@@ -633,11 +724,11 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 		if (ent->ie_vis_flags & VOS_VIS_FLAG_COVERED) {
 			rc = rebuild_object_insert(rpt, tgts[i], shards[i],
 						   arg->co_uuid, oid, 0,
-						   ent->ie_epoch);
+						   ent->ie_epoch, urgent);
 		} else {
 			rc = rebuild_object_insert(rpt, tgts[i], shards[i],
 						   arg->co_uuid, oid, ent->ie_epoch,
-						   0);
+						   0, urgent);
 		}
 
 		if (rc)
@@ -730,12 +821,13 @@ rebuild_scanner(void *data)
 {
 	struct rebuild_scan_arg		arg = { 0 };
 	struct rebuild_tgt_pool_tracker *rpt = data;
-	struct ds_pool_child		*child;
+	struct ds_pool_child		*child = NULL;
 	struct rebuild_pool_tls		*tls;
 	vos_iter_param_t		param = { 0 };
 	struct vos_iter_anchors		anchor = { 0 };
 	ABT_thread			ult_send = ABT_THREAD_NULL;
 	struct umem_attr		uma;
+	uint64_t			start;
 	int				rc = 0;
 
 	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid, rpt->rt_rebuild_ver);
@@ -753,7 +845,15 @@ rebuild_scanner(void *data)
 		D_DEBUG(DB_REBUILD, "sleep 2 seconds then retry\n");
 		dss_sleep(2 * 1000);
 	}
+	child = ds_pool_child_lookup(rpt->rt_pool_uuid);
+	if (child == NULL)
+		D_GOTO(out, rc = -DER_NONEXIST);
+
+	/* the sender uses the metrics as well, hold the child until it's done */
+	tls->rebuild_pool_metrics = child->spc_metrics[DAOS_REBUILD_MODULE];
+
 	D_ASSERT(daos_handle_is_inval(tls->rebuild_tree_hdl));
+	D_ASSERT(daos_handle_is_inval(tls->rebuild_urgent_tree_hdl));
 	/* Create object tree root */
 	memset(&uma, 0, sizeof(uma));
 	uma.uma_id = UMEM_CLASS_VMEM;
@@ -764,6 +864,13 @@ rebuild_scanner(void *data)
 		D_GOTO(out, rc);
 	}
 
+	rc = dbtree_create(DBTREE_CLASS_UV, 0, 4, &uma, NULL,
+			   &tls->rebuild_urgent_tree_hdl);
+	if (rc != 0) {
+		D_ERROR("failed to create rebuild tree: "DF_RC"\n", DP_RC(rc));
+		D_GOTO(out, rc);
+	}
+
 	rpt_get(rpt);
 	rc = dss_ult_create(rebuild_objects_send_ult, rpt, DSS_XS_SELF,
 			    0, 0, &ult_send);
@@ -772,26 +879,33 @@ rebuild_scanner(void *data)
 		D_GOTO(out, rc);
 	}
 
-	child = ds_pool_child_lookup(rpt->rt_pool_uuid);
-	if (child == NULL)
-		D_GOTO(out, rc = -DER_NONEXIST);
-
 	param.ip_hdl = child->spc_hdl;
 	param.ip_flags = VOS_IT_FOR_MIGRATION;
 	arg.rpt = rpt;
+	arg.rpm = tls->rebuild_pool_metrics;
 	arg.yield_freq = DEFAULT_YIELD_FREQ;
+	start = daos_gettime_coarse();
 	if (!rebuild_status_match(rpt, PO_COMP_ST_UP)) {
 		rc = vos_iterate(&param, VOS_ITER_COUUID, false, &anchor,
 				 rebuild_container_scan_cb, NULL, &arg, NULL);
 	}
 
-	ds_pool_child_put(child);
+	if (arg.rpm != NULL)
+		d_tm_set_gauge(arg.rpm->rpm_scan_rate, arg.obj_scanned /
+			       max(daos_gettime_coarse() - start, 1));
+	D_DEBUG(DB_REBUILD, DF_UUID" scanned "DF_U64" objects in "DF_U64
+		"s\n", DP_UUID(rpt->rt_pool_uuid), arg.obj_scanned,
+		daos_gettime_coarse() - start);
 
 out:
 	tls->rebuild_pool_scan_done = 1;
 	if (ult_send != ABT_THREAD_NULL)
 		ABT_thread_free(&ult_send);
 
+	tls->rebuild_pool_metrics = NULL;
+	if (child != NULL)
+		ds_pool_child_put(child);
+
 	if (tls->rebuild_pool_status == 0 && rc != 0)
 		tls->rebuild_pool_status = rc;
 
@@ -88,6 +88,7 @@ rebuild_pool_tls_create(uuid_t pool_uuid, uuid_t poh_uuid, uuid_t coh_uuid,
 	rebuild_pool_tls->rebuild_pool_obj_count = 0;
 	rebuild_pool_tls->rebuild_pool_reclaim_obj_count = 0;
 	rebuild_pool_tls->rebuild_tree_hdl = DAOS_HDL_INVAL;
+	rebuild_pool_tls->rebuild_urgent_tree_hdl = DAOS_HDL_INVAL;
 	/* Only 1 thread will access the list, no need lock */
 	d_list_add(&rebuild_pool_tls->rebuild_pool_list,
 		   &tls->rebuild_pool_list);
@@ -104,6 +105,8 @@ rebuild_pool_tls_destroy(struct rebuild_pool_tls *tls)
 		DP_UUID(tls->rebuild_pool_uuid), tls->rebuild_pool_ver);
 	if (daos_handle_is_valid(tls->rebuild_tree_hdl))
 		obj_tree_destroy(tls->rebuild_tree_hdl);
+	if (daos_handle_is_valid(tls->rebuild_urgent_tree_hdl))
+		obj_tree_destroy(tls->rebuild_urgent_tree_hdl);
 	d_list_del(&tls->rebuild_pool_list);
 	D_FREE(tls);
 }
@@ -2239,6 +2242,71 @@ rebuild_cleanup(void)
 	return 0;
 }
 
+static void *
+rebuild_metrics_alloc(const char *path, int tgt_id)
+{
+	struct rebuild_pool_metrics	*metrics;
+	int				 rc;
+
+	D_ASSERT(tgt_id >= 0);
+
+	D_ALLOC_PTR(metrics);
+	if (metrics == NULL)
+		return NULL;
+
+	rc = d_tm_add_metric(&metrics->rpm_obj_scanned, D_TM_COUNTER,
+			     "total number of objects scanned by rebuild",
+			     "objs", "%s/rebuild/scanned/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create rebuild scanned sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->rpm_obj_found, D_TM_COUNTER,
+			     "total number of object shards to be rebuilt",
+			     "shards", "%s/rebuild/found/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create rebuild found sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->rpm_scan_rate, D_TM_GAUGE,
+			     "objects scanned per second by the last rebuild",
+			     "objs/s", "%s/rebuild/scan_rate/tgt_%u", path,
+			     tgt_id);
+	if (rc)
+		D_WARN("Failed to create rebuild scan rate sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->rpm_send_batch, D_TM_STATS_GAUGE,
+			     "number of objects sent per rebuild migrate RPC",
+			     "objs", "%s/rebuild/send_batch/tgt_%u", path,
+			     tgt_id);
+	if (rc)
+		D_WARN("Failed to create rebuild batch sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	return metrics;
+}
+
+static void
+rebuild_metrics_free(void *data)
+{
+	D_FREE(data);
+}
+
+static int
+rebuild_metrics_count(void)
+{
+	return (sizeof(struct rebuild_pool_metrics) /
+		sizeof(struct d_tm_node_t *));
+}
+
+struct dss_module_metrics rebuild_metrics = {
+	.dmm_tags = DAOS_TGT_TAG,
+	.dmm_init = rebuild_metrics_alloc,
+	.dmm_fini = rebuild_metrics_free,
+	.dmm_nr_metrics = rebuild_metrics_count,
+};
+
 struct dss_module rebuild_module = {
 	.sm_name	= "rebuild",
 	.sm_mod_id	= DAOS_REBUILD_MODULE,
@@ -2250,4 +2318,5 @@ struct dss_module rebuild_module = {
 	.sm_cli_count	= 0,
 	.sm_handlers	= rebuild_handlers,
 	.sm_key		= &rebuild_module_key,
+	.sm_metrics	= &rebuild_metrics,
 };
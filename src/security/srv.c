@@ -22,19 +22,30 @@ char *ds_sec_server_socket_path;
 static int
 init(void)
 {
-	int rc;
+	unsigned int	ttl = DS_SEC_CRED_CACHE_TTL;
+	int		rc;
 
 	rc = asprintf(&ds_sec_server_socket_path, "%s/%s",
 			dss_socket_dir, "daos_server.sock");
 	if (rc < 0) {
 		return rc;
 	}
+
+	/* Lifetime of validated credentials in the cache, 0 disables it */
+	d_getenv_int("DAOS_SEC_CRED_CACHE_TTL", &ttl);
+	rc = ds_sec_cred_cache_init(ttl);
+	if (rc != 0) {
+		free(ds_sec_server_socket_path);
+		ds_sec_server_socket_path = NULL;
+		return rc;
+	}
 	return 0;
 }
 
 static int
 fini(void)
 {
+	ds_sec_cred_cache_fini();
 	free(ds_sec_server_socket_path);
 	ds_sec_server_socket_path = NULL;
 	return 0;
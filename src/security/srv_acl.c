@@ -237,6 +237,148 @@ validate_credentials_via_drpc(Drpc__Response **response, d_iov_t *creds)
 	return rc;
 }
 
+/**
+ * Cache of validated credentials, so that a job connecting the same
+ * credential from many processes asks daos_server to validate it only once
+ * per TTL. Entries are keyed by the packed credential, which includes the
+ * verifier of the agent, and hold the packed token daos_server returned.
+ * Only successful validations are cached.
+ */
+#define CRED_CACHE_SIZE		(256)
+
+struct cred_cache_entry {
+	uint64_t	 cce_hash;
+	/** expiration time, in seconds of the coarse monotonic clock */
+	uint64_t	 cce_expire;
+	d_iov_t		 cce_cred;
+	d_iov_t		 cce_token;
+};
+
+static struct {
+	pthread_mutex_t		 cc_lock;
+	struct cred_cache_entry	*cc_entries;
+	unsigned int		 cc_ttl;
+} cred_cache;
+
+static void
+cred_cache_entry_reset(struct cred_cache_entry *entry)
+{
+	daos_iov_free(&entry->cce_cred);
+	daos_iov_free(&entry->cce_token);
+	entry->cce_hash = 0;
+	entry->cce_expire = 0;
+}
+
+int
+ds_sec_cred_cache_init(unsigned int ttl)
+{
+	int rc;
+
+	if (ttl == 0)
+		return 0;
+
+	rc = D_MUTEX_INIT(&cred_cache.cc_lock, NULL);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_ARRAY(cred_cache.cc_entries, CRED_CACHE_SIZE);
+	if (cred_cache.cc_entries == NULL) {
+		D_MUTEX_DESTROY(&cred_cache.cc_lock);
+		return -DER_NOMEM;
+	}
+	cred_cache.cc_ttl = ttl;
+	D_DEBUG(DB_MGMT, "credential cache enabled, TTL %us\n", ttl);
+	return 0;
+}
+
+void
+ds_sec_cred_cache_fini(void)
+{
+	int i;
+
+	if (cred_cache.cc_entries == NULL)
+		return;
+
+	for (i = 0; i < CRED_CACHE_SIZE; i++)
+		cred_cache_entry_reset(&cred_cache.cc_entries[i]);
+	D_FREE(cred_cache.cc_entries);
+	D_MUTEX_DESTROY(&cred_cache.cc_lock);
+	cred_cache.cc_ttl = 0;
+}
+
+static inline struct cred_cache_entry *
+cred_cache_slot(uint64_t hash)
+{
+	return &cred_cache.cc_entries[hash % CRED_CACHE_SIZE];
+}
+
+/** Return 0 and the cached token if \a creds was validated recently */
+static int
+cred_cache_lookup(d_iov_t *creds, uint64_t hash, Auth__Token **token)
+{
+	struct drpc_alloc	 alloc = PROTO_ALLOCATOR_INIT(alloc);
+	struct cred_cache_entry	*entry;
+	int			 rc = -DER_NONEXIST;
+
+	D_MUTEX_LOCK(&cred_cache.cc_lock);
+	entry = cred_cache_slot(hash);
+	if (entry->cce_hash != hash ||
+	    entry->cce_cred.iov_len != creds->iov_buf_len ||
+	    memcmp(entry->cce_cred.iov_buf, creds->iov_buf,
+		   creds->iov_buf_len) != 0)
+		goto out;
+
+	if (entry->cce_expire <= daos_gettime_coarse()) {
+		cred_cache_entry_reset(entry);
+		goto out;
+	}
+
+	*token = auth__token__unpack(&alloc.alloc, entry->cce_token.iov_len,
+				     entry->cce_token.iov_buf);
+	if (alloc.oom || *token == NULL)
+		rc = -DER_NOMEM;
+	else
+		rc = 0;
+out:
+	D_MUTEX_UNLOCK(&cred_cache.cc_lock);
+	return rc;
+}
+
+static void
+cred_cache_insert(d_iov_t *creds, uint64_t hash, Auth__Token *token)
+{
+	struct cred_cache_entry	*entry;
+	d_iov_t			 cred_copy = {0};
+	d_iov_t			 token_copy = {0};
+	size_t			 len;
+
+	/* The whole buffer is the packed credential */
+	D_ALLOC(cred_copy.iov_buf, creds->iov_buf_len);
+	if (cred_copy.iov_buf == NULL)
+		return;
+	memcpy(cred_copy.iov_buf, creds->iov_buf, creds->iov_buf_len);
+	cred_copy.iov_buf_len = cred_copy.iov_len = creds->iov_buf_len;
+
+	len = auth__token__get_packed_size(token);
+	D_ALLOC(token_copy.iov_buf, len);
+	if (token_copy.iov_buf == NULL) {
+		daos_iov_free(&cred_copy);
+		return;
+	}
+	auth__token__pack(token, token_copy.iov_buf);
+	token_copy.iov_buf_len = token_copy.iov_len = len;
+
+	/* Replace whatever credential used the slot */
+	D_MUTEX_LOCK(&cred_cache.cc_lock);
+	entry = cred_cache_slot(hash);
+	cred_cache_entry_reset(entry);
+	entry->cce_hash = hash;
+	entry->cce_expire = daos_gettime_coarse() + cred_cache.cc_ttl;
+	entry->cce_cred = cred_copy;
+	entry->cce_token = token_copy;
+	D_MUTEX_UNLOCK(&cred_cache.cc_lock);
+}
+
 static int
 process_validation_response(Drpc__Response *response, Auth__Token **token)
 {
@@ -257,6 +399,7 @@ int
 ds_sec_validate_credentials(d_iov_t *creds, Auth__Token **token)
 {
 	Drpc__Response	*response = NULL;
+	uint64_t	hash = 0;
 	int		rc;
 
 	if (creds == NULL ||
@@ -267,12 +410,21 @@ ds_sec_validate_credentials(d_iov_t *creds, Auth__Token **token)
 		return -DER_INVAL;
 	}
 
+	if (cred_cache.cc_entries != NULL) {
+		hash = d_hash_murmur64(creds->iov_buf, creds->iov_buf_len, 0);
+		rc = cred_cache_lookup(creds, hash, token);
+		if (rc != -DER_NONEXIST)
+			return rc;
+	}
+
 	rc = validate_credentials_via_drpc(&response, creds);
 	if (rc != DER_SUCCESS) {
 		return rc;
 	}
 
 	rc = process_validation_response(response, token);
+	if (rc == 0 && cred_cache.cc_entries != NULL)
+		cred_cache_insert(creds, hash, *token);
 
 	drpc_response_free(response);
 	return rc;
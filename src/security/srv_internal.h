@@ -57,6 +57,11 @@ extern char *ds_sec_server_socket_path;
 				 CONT_CAPA_SET_OWNER |			\
 				 CONT_CAPA_DELETE)
 
+/** Default lifetime in seconds of a validated credential in the cache */
+#define DS_SEC_CRED_CACHE_TTL	(10)
+
 int ds_sec_validate_credentials(d_iov_t *creds, Auth__Token **token);
+int ds_sec_cred_cache_init(unsigned int ttl);
+void ds_sec_cred_cache_fini(void);
 
 #endif /* __SECURITY_SRV_INTERNAL_H__ */
@@ -478,6 +478,70 @@ test_validate_creds_success(void **state)
 	auth__token__free_unpacked(result, NULL);
 }
 
+static void
+test_validate_creds_cached(void **state)
+{
+	d_iov_t			cred;
+	Auth__Token		*result = NULL;
+
+	assert_rc_equal(ds_sec_cred_cache_init(DS_SEC_CRED_CACHE_TTL), 0);
+
+	init_default_cred(&cred);
+	setup_drpc_with_default_token();
+
+	assert_rc_equal(ds_sec_validate_credentials(&cred, &result), 0);
+	assert_non_null(result);
+	assert_ptr_equal(drpc_call_ctx, drpc_connect_return);
+	auth__token__free_unpacked(result, NULL);
+	result = NULL;
+
+	/* Same credential is served from the cache, without any dRPC */
+	srv_acl_resetup(state);
+	assert_rc_equal(ds_sec_validate_credentials(&cred, &result), 0);
+	assert_non_null(result);
+	assert_null(drpc_call_ctx);
+	assert_int_equal(result->flavor, AUTH__FLAVOR__AUTH_SYS);
+	auth__token__free_unpacked(result, NULL);
+	result = NULL;
+
+	/* Cache dropped, the credential is validated by daos_server again */
+	ds_sec_cred_cache_fini();
+	srv_acl_resetup(state);
+	setup_drpc_with_default_token();
+	assert_rc_equal(ds_sec_validate_credentials(&cred, &result), 0);
+	assert_ptr_equal(drpc_call_ctx, drpc_connect_return);
+
+	daos_iov_free(&cred);
+	auth__token__free_unpacked(result, NULL);
+}
+
+static void
+test_validate_creds_failure_not_cached(void **state)
+{
+	d_iov_t			cred;
+	Auth__Token		*result = NULL;
+
+	assert_rc_equal(ds_sec_cred_cache_init(DS_SEC_CRED_CACHE_TTL), 0);
+
+	init_default_cred(&cred);
+	drpc_call_return = -DER_NOMEM;
+
+	assert_rc_equal(ds_sec_validate_credentials(&cred, &result),
+			-DER_NOMEM);
+	assert_null(result);
+
+	/* Failed validation is retried with daos_server */
+	srv_acl_resetup(state);
+	setup_drpc_with_default_token();
+	assert_rc_equal(ds_sec_validate_credentials(&cred, &result), 0);
+	assert_non_null(result);
+	assert_ptr_equal(drpc_call_ctx, drpc_connect_return);
+
+	ds_sec_cred_cache_fini();
+	daos_iov_free(&cred);
+	auth__token__free_unpacked(result, NULL);
+}
+
 /*
  * Default ACL tests
  */
@@ -2173,6 +2237,8 @@ main(void)
 		ACL_UTEST(test_validate_creds_drpc_response_empty_token),
 		ACL_UTEST(test_validate_creds_drpc_response_bad_status),
 		ACL_UTEST(test_validate_creds_success),
+		ACL_UTEST(test_validate_creds_cached),
+		ACL_UTEST(test_validate_creds_failure_not_cached),
 		cmocka_unit_test(test_default_pool_acl),
 		cmocka_unit_test(test_default_cont_acl),
 		ACL_UTEST(test_pool_get_capas_invalid_flags),
@@ -32,21 +32,57 @@ enum {
 int	ts_mode = TS_MODE_DAOS;
 int	ts_class = OC_SX;
 
+/* number of updates committed by each distributed transaction, 0 for no TX */
+static int		ts_tx_size;
+static int		ts_tx_ops;
+static daos_handle_t	ts_tx_th;
+
+static int
+tx_commit(void)
+{
+	int	rc;
+
+	if (ts_tx_ops == 0)
+		return 0;
+
+	rc = daos_tx_commit(ts_tx_th, NULL);
+	if (rc)
+		fprintf(stderr, "TX commit failed: "DF_RC"\n", DP_RC(rc));
+
+	daos_tx_close(ts_tx_th, NULL);
+	ts_tx_th = DAOS_TX_NONE;
+	ts_tx_ops = 0;
+	return rc;
+}
+
 static int
 daos_update_or_fetch(int obj_idx, enum ts_op_type op_type,
 		     struct io_credit *cred, daos_epoch_t epoch,
 		     bool sync, double *duration)
 {
 	daos_event_t *evp = sync ? NULL : cred->tc_evp;
+	daos_handle_t th = DAOS_TX_NONE;
 	uint64_t      start = 0;
 	int	      rc;
 
 	if (!dts_is_async(&ts_ctx))
 		TS_TIME_START(duration, start);
+	if (op_type == TS_DO_UPDATE && ts_tx_size > 0) {
+		if (ts_tx_ops == 0) {
+			rc = daos_tx_open(ts_ctx.tsc_coh, &ts_tx_th, 0, NULL);
+			if (rc)
+				return rc;
+		}
+		th = ts_tx_th;
+	}
+
 	if (op_type == TS_DO_UPDATE) {
-		rc = daos_obj_update(ts_ohs[obj_idx], DAOS_TX_NONE, 0,
+		rc = daos_obj_update(ts_ohs[obj_idx], th, 0,
 				     &cred->tc_dkey, 1, &cred->tc_iod,
 				     &cred->tc_sgl, evp);
+		/* the commit cost is accounted to the update closing the TX */
+		if (rc == 0 && ts_tx_size > 0 && ++ts_tx_ops == ts_tx_size)
+			rc = tx_commit();
 	} else {
 		rc = daos_obj_fetch(ts_ohs[obj_idx], DAOS_TX_NONE, 0,
 				    &cred->tc_dkey, 1, &cred->tc_iod,
@@ -114,6 +150,8 @@ pf_update(struct pf_test *ts, struct pf_param *param)
 		return rc;
 
 	rc = objects_update(param);
+	if (rc == 0)
+		rc = tx_commit();
 	if (rc)
 		return rc;
 
@@ -290,6 +328,9 @@ const char perf_daos_usage[] = "\n"
 "	Object class for DAOS full stack test.\n\n"
 "-g dmg_conf\n"
 "	dmg configuration file.\n\n"
+"-x number\n"
+"	Run updates in distributed transactions of this number of updates,\n"
+"	spanning all the objects. It requires synchronous mode.\n\n"
 "Examples:\n"
 "	$ daos_perf -C 16 -A -R 'U;p F;i=5;p V'\n";
 
@@ -309,10 +350,11 @@ const struct option perf_daos_opts[] = {
 	{ "credits",	required_argument,	NULL,	'C' },
 	{ "class",	required_argument,	NULL,	'c' },
 	{ "dmg_conf",	required_argument,	NULL,	'g' },
+	{ "tx",		required_argument,	NULL,	'x' },
 	{ NULL,		0,			NULL,	0   },
 };
 
-const char perf_daos_optstr[] = "T:C:c:g:";
+const char perf_daos_optstr[] = "T:C:c:g:x:";
 
 int
 main(int argc, char **argv)
@@ -381,9 +423,19 @@ main(int argc, char **argv)
 		case 'g':
 			dmg_conf = optarg;
 			break;
+		case 'x':
+			ts_tx_size = strtoul(optarg, &endp, 0);
+			break;
 		}
 	}
 
+	if (ts_tx_size > 0 && (credits > 0 || ts_mode != TS_MODE_DAOS)) {
+		fprintf(stderr, "TX mode requires synchronous DAOS mode\n");
+		if (ts_ctx.tsc_mpi_rank == 0)
+			ts_print_usage();
+		return -1;
+	}
+
 	if (!cmds) {
 		D_PRINT("Please provide command string\n");
 		ts_print_usage();
@@ -37,6 +37,7 @@ unsigned int	ts_seed;
 bool		ts_single	= true;	/* value type: single or array */
 bool		ts_random;		/* random write (array value only) */
 bool		ts_pause;
+bool		ts_json;		/* machine-readable results */
 
 bool		ts_oid_init;
 
@@ -171,6 +172,48 @@ stride_buf_verify(char *buf, unsigned offset, int size)
 }
 
 
+static void
+pf_lat_record(struct pf_param *param, uint64_t start)
+{
+	uint64_t	lat = (daos_get_ntime() - start) / 1000;
+	int		i = 0;
+
+	if (lat > 1)
+		i = 63 - __builtin_clzl(lat);
+	if (i >= PF_LAT_BUCKETS)
+		i = PF_LAT_BUCKETS - 1;
+	param->pa_lat_hist[i]++;
+}
+
+/**
+ * Hold the target rate of the test: wait until the next I/O is due and return
+ * its scheduled time. The latency is accounted from the scheduled time rather
+ * than from the actual issue, so that a saturated server is not hidden by the
+ * generator slowing down (coordinated omission).
+ */
+static uint64_t
+pf_pace(struct pf_param *param)
+{
+	struct timespec	ts;
+	uint64_t	now = daos_get_ntime();
+	uint64_t	due;
+
+	if (param->pa_rw.rate == 0)
+		return now;
+
+	if (param->pa_rw.next == 0)
+		param->pa_rw.next = now;
+	due = param->pa_rw.next;
+	param->pa_rw.next += NSEC_PER_SEC / param->pa_rw.rate;
+
+	if (now < due) {
+		ts.tv_sec = (due - now) / NSEC_PER_SEC;
+		ts.tv_nsec = (due - now) % NSEC_PER_SEC;
+		nanosleep(&ts, NULL);
+	}
+	return due;
+}
+
 static int
 akey_update_or_fetch(int obj_idx, enum ts_op_type op_type,
 		     daos_key_t *dkey, daos_key_t *akey, daos_epoch_t *epoch,
@@ -180,6 +223,7 @@ akey_update_or_fetch(int obj_idx, enum ts_op_type op_type,
 	daos_iod_t	     *iod;
 	d_sg_list_t	     *sgl;
 	daos_recx_t	     *recx;
+	uint64_t	      start;
 	int		      rc = 0;
 
 	if (param->pa_verbose)
@@ -234,8 +278,12 @@ akey_update_or_fetch(int obj_idx, enum ts_op_type op_type,
 	sgl->sg_nr_out = 0;
 
 	D_ASSERT(ts_update_or_fetch_fn != NULL);
+	start = pf_pace(param);
 	rc = ts_update_or_fetch_fn(obj_idx, op_type, cred, *epoch,
 				   !!param->pa_rw.verify, &param->pa_duration);
+	/* the completion time of asynchronous I/O is not tracked per credit */
+	if (rc == 0 && (!dts_is_async(&ts_ctx) || param->pa_rw.verify))
+		pf_lat_record(param, start);
 	if (rc != 0) {
 		fprintf(stderr, "%s failed. rc=%d, epoch=%"PRIu64"\n",
 			op_type == TS_DO_FETCH ? "Fetch" : "Update",
@@ -450,6 +498,18 @@ pf_parse_rw_cb(char *str, struct pf_param *param, char **strp)
 		param->pa_rw.dkey_flag = true;
 		str++;
 		break;
+	case 'r':
+		str++;
+		if (*str != PARAM_ASSIGN)
+			return -1;
+
+		val = strtol(&str[1], &str, 0);
+		if (val_has_unit(*str)) {
+			val = val_unit(val, *str);
+			str++;
+		}
+		param->pa_rw.rate = val;
+		break;
 	case 'o':
 	case 's':
 		str++;
@@ -633,10 +693,63 @@ run_commands(char *cmds, struct pf_test pf_tests[])
 	}
 }
 
+/* Latency (us) of quantile @q, interpolated within its histogram bucket */
+static double
+pf_lat_quantile(uint64_t *hist, uint64_t total, double q)
+{
+	uint64_t	rank = q * total;
+	uint64_t	seen = 0;
+	double		lo;
+	int		i;
+
+	if (rank < q * total || rank == 0)
+		rank++;
+
+	for (i = 0; i < PF_LAT_BUCKETS; i++) {
+		if (seen + hist[i] >= rank)
+			break;
+		seen += hist[i];
+	}
+	if (i == PF_LAT_BUCKETS)
+		i = PF_LAT_BUCKETS - 1;
+
+	lo = i == 0 ? 0 : (double)(1UL << i);
+	return lo + ((1UL << (i + 1)) - lo) * (rank - seen) / max(hist[i], 1UL);
+}
+
+static void
+show_json(struct pf_param *param, char *test_name, double duration,
+	  double rate, double bandwidth, double latency, uint64_t *hist,
+	  uint64_t lat_total)
+{
+	int	i;
+
+	fprintf(stdout, "{\"test\": \"%s\", \"procs\": %d, \"size\": %d, "
+		"\"target_rate\": %u, \"duration\": %.6f, \"rate\": %.2f, "
+		"\"bandwidth\": %.3f, \"latency\": %.3f",
+		test_name, ts_ctx.tsc_mpi_size, param->pa_rw.size,
+		param->pa_rw.rate, duration, rate, bandwidth, latency);
+
+	if (lat_total != 0) {
+		fprintf(stdout, ", \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, "
+			"\"p999\": %.1f, \"histogram\": [",
+			pf_lat_quantile(hist, lat_total, 0.5),
+			pf_lat_quantile(hist, lat_total, 0.9),
+			pf_lat_quantile(hist, lat_total, 0.99),
+			pf_lat_quantile(hist, lat_total, 0.999));
+		for (i = 0; i < PF_LAT_BUCKETS; i++)
+			fprintf(stdout, "%s"DF_U64, i == 0 ? "" : ", ", hist[i]);
+		fprintf(stdout, "]");
+	}
+	fprintf(stdout, "}\n");
+}
+
 void
 show_result(struct pf_param *param, uint64_t start, uint64_t end,
 	    char *test_name)
 {
+	uint64_t	lat_hist[PF_LAT_BUCKETS];
+	uint64_t	lat_total = 0;
 	double		agg_duration;
 	uint64_t	first_start;
 	uint64_t	last_end;
@@ -669,10 +782,17 @@ show_result(struct pf_param *param, uint64_t start, uint64_t end,
 		duration_sum = param->pa_duration;
 	}
 
+	if (ts_ctx.tsc_mpi_size > 1)
+		MPI_Reduce(param->pa_lat_hist, lat_hist, PF_LAT_BUCKETS,
+			   MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+	else
+		memcpy(lat_hist, param->pa_lat_hist, sizeof(lat_hist));
+
 	if (ts_ctx.tsc_mpi_rank == 0) {
 		unsigned long	total;
 		bool		show_bw = false;
-		double		bandwidth;
+		double		bandwidth = 0;
+		int		i;
 		double		latency;
 		double		rate;
 
@@ -680,7 +800,8 @@ show_result(struct pf_param *param, uint64_t start, uint64_t end,
 			total = ts_ctx.tsc_mpi_size * param->pa_iteration *
 				ts_obj_p_cont;
 		} else if (strcmp(test_name, "AGGREGATE") == 0 ||
-			   strcmp(test_name, "DISCARD") == 0) {
+			   strcmp(test_name, "DISCARD") == 0 ||
+			   strcmp(test_name, "GC") == 0) {
 			total = ts_ctx.tsc_mpi_size * param->pa_iteration;
 		} else if (strcmp(test_name, "PUNCH") == 0) {
 			total = ts_ctx.tsc_mpi_size * param->pa_iteration * ts_obj_p_cont;
@@ -695,16 +816,31 @@ show_result(struct pf_param *param, uint64_t start, uint64_t end,
 
 		rate = total / agg_duration;
 		latency = duration_max / total;
+		if (show_bw)
+			bandwidth = (rate * param->pa_rw.size) / (1024 * 1024);
+
+		for (i = 0; i < PF_LAT_BUCKETS; i++)
+			lat_total += lat_hist[i];
+
+		if (ts_json) {
+			show_json(param, test_name, agg_duration, rate,
+				  bandwidth, latency, lat_hist, lat_total);
+			return;
+		}
 
 		fprintf(stdout, "%s successfully completed:\n"
 			"\tduration : %-10.6f sec\n", test_name, agg_duration);
-		if (show_bw) {
-			bandwidth = (rate * param->pa_rw.size) / (1024 * 1024);
+		if (show_bw)
 			fprintf(stdout, "\tbandwith : %-10.3f MB/sec\n", bandwidth);
-		}
 		fprintf(stdout, "\trate     : %-10.2f IO/sec\n"
 			"\tlatency  : %-10.3f us "
 			"(nonsense if credits > 1)\n", rate, latency);
+		if (lat_total != 0)
+			fprintf(stdout, "\tp50/p90/p99/p99.9 : %.1f/%.1f/%.1f/%.1f us\n",
+				pf_lat_quantile(lat_hist, lat_total, 0.5),
+				pf_lat_quantile(lat_hist, lat_total, 0.9),
+				pf_lat_quantile(lat_hist, lat_total, 0.99),
+				pf_lat_quantile(lat_hist, lat_total, 0.999));
 
 		fprintf(stdout, "Duration across processes:\n");
 		fprintf(stdout, "\tMAX duration : %-10.6f sec\n",
@@ -752,18 +888,25 @@ const char perf_common_usage[] = "\n"
 "	'Q'    : Query test (vos_perf only)\n"
 "	'I'    : VOS iteration test (vos_perf only)\n"
 "	'P'    : Punch test (vos_perf only)\n"
+"	'A'    : Aggregation test (vos_perf only)\n"
+"	'D'    : Discard test (vos_perf only)\n"
+"	'G'    : GC drain test (vos_perf only)\n"
 "	'p'    : Output performance numbers\n"
 "	'i=$N' : Iterate test $N times\n"
 "	'k'    : Don't reset key for each iteration\n"
 "	'o=$N' : Offset for update or fetch\n"
 "	's=$N' : IO size for update or fetch\n"
 "	'd'    : Dkey punch (for Punch test)\n"
+"	'r=$N' : Target rate (IO/sec per process) for update or fetch,\n"
+"	         latency percentiles are accounted from the due time\n"
 "	'v'    : Verbose mode\n\n"
 "	Test commands are in format of: \"C;p=x;q D;a;b\" The upper-case\n"
 "	character is command, e.g. U=update, F=fetch, anything after\n"
 "	semicolon is parameter of the command. Space or tab is the separator\n"
 "	between commands.\n\n"
 "-w	Pause after initialization for attaching debugger or analysis tool\n\n"
+"-j	Output the results of 'p' as one JSON object per test, including\n"
+"	the latency histogram of synchronous update/fetch\n\n"
 "-G seed\n"
 "	Random seed\n\n"
 "-u pool_uuid\n"
@@ -787,9 +930,10 @@ const struct option perf_common_opts[] = {
 	{ "seed",	required_argument,	NULL,	'G' },
 	{ "pool",	required_argument,	NULL,	'u' },
 	{ "cont",	required_argument,	NULL,	'X' },
+	{ "json",	no_argument,		NULL,	'j' },
 };
 
-const char perf_common_optstr[] = "hP:N:o:d:a:n:s:A::R:wG:u:X:";
+const char perf_common_optstr[] = "hP:N:o:d:a:n:s:A::R:wG:u:X:j";
 
 int
 perf_parse_opts(int rc, char **cmds)
@@ -838,6 +982,9 @@ perf_parse_opts(int rc, char **cmds)
 	case 'w':
 		ts_pause = true;
 		break;
+	case 'j':
+		ts_json = true;
+		break;
 	case 'G':
 		ts_seed = atoi(optarg);
 		break;
@@ -16,6 +16,9 @@
 #define PF_DKEY_PREF	"blade"
 #define PF_AKEY_PREF	"apple"
 
+/* latency histogram of update/fetch, bucket N covers [2^N, 2^(N+1)) us */
+#define PF_LAT_BUCKETS	(32)
+
 enum ts_op_type {
 	TS_DO_UPDATE = 0,
 	TS_DO_FETCH
@@ -32,6 +35,8 @@ struct pf_param {
 	int		pa_iteration;
 	/* output parameter */
 	double		pa_duration;
+	/* output parameter, latency histogram of synchronous update/fetch */
+	uint64_t	pa_lat_hist[PF_LAT_BUCKETS];
 	union {
 		/* private parameter for iteration */
 		struct {
@@ -50,6 +55,10 @@ struct pf_param {
 			bool	verify;
 			/* dkey flag */
 			bool	dkey_flag;
+			/* target rate (IO/sec per process), 0 for closed loop */
+			unsigned int	rate;
+			/* time (ns) the next paced I/O is due */
+			uint64_t	next;
 		} pa_rw;
 	};
 };
@@ -84,6 +93,7 @@ extern unsigned int	ts_seed;
 extern bool		ts_single;
 extern bool		ts_random;
 extern bool		ts_pause;
+extern bool		ts_json;
 
 extern bool		ts_oid_init;
 
@@ -1080,6 +1080,144 @@ truncate_array(void **state)
 	MPI_Barrier(MPI_COMM_WORLD);
 } /* End str_mem_str_arr_io */
 
+/** I/O spanning many more dkeys than kept in flight by a streamed array I/O */
+#define STREAM_CHUNK	16
+#define STREAM_LEN	(STREAM_CHUNK * 4096)
+
+static void
+streamed_array_io(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	daos_handle_t	oh;
+	daos_array_iod_t iod = {};
+	daos_range_t	rg = {};
+	d_iov_t		iov[2];
+	d_sg_list_t	sgl = {};
+	char		*wbuf;
+	char		*rbuf;
+	daos_size_t	i;
+	int		rc;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	oid = daos_test_oid_gen(arg->coh, OC_SX, typeb, 0, arg->myrank);
+
+	rc = daos_array_create(arg->coh, oid, DAOS_TX_NONE, 1, STREAM_CHUNK,
+			       &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	D_ALLOC(wbuf, STREAM_LEN);
+	assert_non_null(wbuf);
+	D_ALLOC(rbuf, STREAM_LEN + STREAM_CHUNK);
+	assert_non_null(rbuf);
+	for (i = 0; i < STREAM_LEN; i++)
+		wbuf[i] = i % 251;
+
+	/** unaligned memory segments, so every dkey gets its own sgl */
+	iod.arr_nr = 1;
+	iod.arr_rgs = &rg;
+	rg.rg_idx = 0;
+	rg.rg_len = STREAM_LEN;
+	sgl.sg_nr = 2;
+	sgl.sg_iovs = iov;
+	d_iov_set(&iov[0], wbuf, 7);
+	d_iov_set(&iov[1], wbuf + 7, STREAM_LEN - 7);
+
+	rc = daos_array_write(oh, DAOS_TX_NONE, &iod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+
+	/** read back past EOF */
+	rg.rg_len = STREAM_LEN + STREAM_CHUNK;
+	d_iov_set(&iov[0], rbuf, 7);
+	d_iov_set(&iov[1], rbuf + 7, STREAM_LEN + STREAM_CHUNK - 7);
+
+	rc = daos_array_read(oh, DAOS_TX_NONE, &iod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(iod.arr_nr_read, STREAM_LEN);
+	assert_int_equal(iod.arr_nr_short_read, STREAM_CHUNK);
+	assert_memory_equal(wbuf, rbuf, STREAM_LEN);
+
+	rc = daos_array_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_array_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+	D_FREE(rbuf);
+	D_FREE(wbuf);
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void
+tracked_size(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	daos_handle_t	oh;
+	daos_array_iod_t iod = {};
+	daos_range_t	rg[2] = {};
+	d_iov_t		iov = {};
+	d_sg_list_t	sgl = {};
+	char		buf[16] = {};
+	daos_size_t	size;
+	int		rc;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	oid = daos_test_oid_gen(arg->coh, OC_SX, typeb, 0, arg->myrank);
+
+	rc = daos_array_create(arg->coh, oid, DAOS_TX_NONE, 1, 1024, &oh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_array_track_size(oh);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_array_get_size(oh, DAOS_TX_NONE, &size, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(size, 0);
+
+	/** two ranges on different dkeys, the second one lower */
+	iod.arr_nr = 2;
+	iod.arr_rgs = rg;
+	rg[0].rg_idx = 10 * 1024;
+	rg[0].rg_len = 8;
+	rg[1].rg_idx = 100;
+	rg[1].rg_len = 8;
+	sgl.sg_nr = 1;
+	sgl.sg_iovs = &iov;
+	d_iov_set(&iov, buf, sizeof(buf));
+
+	rc = daos_array_write(oh, DAOS_TX_NONE, &iod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_array_get_size(oh, DAOS_TX_NONE, &size, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(size, 10 * 1024 + 8);
+
+	/** a lower write does not shrink it */
+	iod.arr_nr = 1;
+	rg[0].rg_idx = 0;
+	d_iov_set(&iov, buf, 8);
+	rc = daos_array_write(oh, DAOS_TX_NONE, &iod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_array_get_size(oh, DAOS_TX_NONE, &size, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(size, 10 * 1024 + 8);
+
+	rc = daos_array_set_size(oh, DAOS_TX_NONE, 50, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_array_get_size(oh, DAOS_TX_NONE, &size, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(size, 50);
+
+	rc = daos_array_set_size(oh, DAOS_TX_NONE, 0, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_array_get_size(oh, DAOS_TX_NONE, &size, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(size, 0);
+
+	rc = daos_array_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_array_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
 static const struct CMUnitTest array_api_tests[] = {
 	{"Array API: create/open/close (blocking)",
 	 simple_array_mgmt, async_disable, NULL},
@@ -1103,6 +1241,10 @@ static const struct CMUnitTest array_api_tests[] = {
 	 strided_array, async_disable, NULL},
 	{"Array API: write after truncate",
 	 truncate_array, async_disable, NULL},
+	{"Array API: streamed I/O across many dkeys",
+	 streamed_array_io, async_disable, NULL},
+	{"Array API: tracked array size",
+	 tracked_size, async_disable, NULL},
 };
 
 static int
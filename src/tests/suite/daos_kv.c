@@ -318,6 +318,120 @@ kv_cond_ops(void **state)
 	print_message("all good\n");
 } /* End simple_put_get */
 
+#define MULTI_KEYS	100
+
+static int
+scan_keys(daos_handle_t oh, const daos_kv_filter_t *filter, const char *prefix)
+{
+	char		*buf;
+	daos_key_desc_t kds[ENUM_DESC_NR];
+	daos_anchor_t	anchor = {0};
+	int		key_nr = 0;
+	d_sg_list_t	sgl;
+	d_iov_t		sg_iov;
+
+	D_ALLOC(buf, ENUM_DESC_BUF);
+	assert_non_null(buf);
+	d_iov_set(&sg_iov, buf, ENUM_DESC_BUF);
+	sgl.sg_nr		= 1;
+	sgl.sg_nr_out		= 0;
+	sgl.sg_iovs		= &sg_iov;
+
+	while (!daos_anchor_is_eof(&anchor)) {
+		uint32_t	nr = ENUM_DESC_NR;
+		uint32_t	i;
+		char		*ptr;
+		int		rc;
+
+		rc = daos_kv_scan(oh, DAOS_TX_NONE, filter, &nr, kds, &sgl,
+				  &anchor, NULL);
+		assert_rc_equal(rc, 0);
+
+		for (ptr = buf, i = 0; i < nr; i++) {
+			assert_true(kds[i].kd_key_len >= strlen(prefix));
+			assert_memory_equal(ptr, prefix, strlen(prefix));
+			ptr += kds[i].kd_key_len;
+		}
+		key_nr += nr;
+	}
+	D_FREE(buf);
+
+	return key_nr;
+}
+
+static void
+kv_multi_scan(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_obj_id_t		 oid;
+	daos_handle_t		 oh;
+	daos_kv_ent_t		 ents[2 * MULTI_KEYS + 1];
+	char			 keys[2 * MULTI_KEYS + 1][32];
+	char			 vals[2 * MULTI_KEYS][64];
+	char			 out[2 * MULTI_KEYS + 1][64];
+	daos_kv_filter_t	 filter = {0};
+	int			 i;
+	int			 rc;
+
+	oid = daos_test_oid_gen(arg->coh, OC_SX, type, 0, arg->myrank);
+	rc = daos_kv_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	/** half of the keys under each prefix, odd keys with small values */
+	for (i = 0; i < 2 * MULTI_KEYS; i++) {
+		sprintf(keys[i], "%s_%d", i < MULTI_KEYS ? "cat" : "dog", i);
+		memset(vals[i], 'a' + i % 26, sizeof(vals[i]));
+		ents[i].kve_key = keys[i];
+		ents[i].kve_buf = vals[i];
+		ents[i].kve_size = (i % 2) ? 8 : sizeof(vals[i]);
+	}
+
+	print_message("Batched PUT of %d keys\n", 2 * MULTI_KEYS);
+	rc = daos_kv_put_multi(oh, DAOS_TX_NONE, 0, 2 * MULTI_KEYS, ents,
+			       NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < 2 * MULTI_KEYS; i++)
+		assert_rc_equal(ents[i].kve_rc, 0);
+
+	print_message("Batched GET, including a missing key\n");
+	sprintf(keys[2 * MULTI_KEYS], "missing");
+	for (i = 0; i < 2 * MULTI_KEYS + 1; i++) {
+		ents[i].kve_key = keys[i];
+		ents[i].kve_buf = out[i];
+		ents[i].kve_size = sizeof(out[i]);
+	}
+	rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 0, 2 * MULTI_KEYS + 1, ents,
+			       NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < 2 * MULTI_KEYS; i++) {
+		assert_rc_equal(ents[i].kve_rc, 0);
+		assert_int_equal(ents[i].kve_size, (i % 2) ? 8 : 64);
+		assert_memory_equal(out[i], vals[i], ents[i].kve_size);
+	}
+	assert_int_equal(ents[2 * MULTI_KEYS].kve_size, 0);
+
+	print_message("Scan with prefix filter\n");
+	filter.kf_prefix = "cat_";
+	assert_int_equal(scan_keys(oh, &filter, "cat_"), MULTI_KEYS);
+
+	print_message("Scan with prefix and value size filters\n");
+	filter.kf_size_min = 64;
+	assert_int_equal(scan_keys(oh, &filter, "cat_"), MULTI_KEYS / 2);
+	filter.kf_size_min = 0;
+	filter.kf_size_max = 8;
+	assert_int_equal(scan_keys(oh, &filter, "cat_"), MULTI_KEYS / 2);
+
+	print_message("Scan without filter\n");
+	assert_int_equal(scan_keys(oh, NULL, ""), 2 * MULTI_KEYS);
+
+	rc = daos_kv_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_kv_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("all good\n");
+}
+
 static const struct CMUnitTest kv_tests[] = {
 	{"KV: Object Put/GET (blocking)",
 	 simple_put_get, async_disable, NULL},
@@ -325,6 +439,8 @@ static const struct CMUnitTest kv_tests[] = {
 	 simple_put_get, async_enable, NULL},
 	{"KV: Object Conditional Ops (blocking)",
 	 kv_cond_ops, async_disable, NULL},
+	{"KV: Batched Put/Get and filtered scan (blocking)",
+	 kv_multi_scan, async_disable, NULL},
 };
 
 int
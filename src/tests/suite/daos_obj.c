@@ -4643,6 +4643,150 @@ enum_recxs_with_aggregation(void **state)
 	enum_recxs_with_aggregation_internal(state, false);
 }
 
+static int
+list_dkey_all_cb(daos_key_desc_t *kd, void *key, void *arg)
+{
+	int *count = arg;
+
+	(*count)++;
+	return 0;
+}
+
+static void
+list_dkey_all(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	struct ioreq	req;
+	char		dkey[32];
+	int		count = 0;
+	int		i;
+	int		rc;
+
+	oid = daos_test_oid_gen(arg->coh, OC_SX, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	print_message("Insert 200 dkeys\n");
+	for (i = 0; i < 200; i++) {
+		sprintf(dkey, "dkey_%d", i);
+		insert_single(dkey, "akey", 0, "data", strlen("data") + 1,
+			      DAOS_TX_NONE, &req);
+	}
+
+	print_message("List them across all groups in parallel\n");
+	rc = daos_obj_list_dkey_all(req.oh, DAOS_TX_NONE, list_dkey_all_cb,
+				    &count);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(count, 200);
+
+	ioreq_fini(&req);
+}
+
+static void
+pipeline_filter_aggregate(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_obj_id_t		 oid;
+	struct ioreq		 req;
+	daos_pipeline_cond_t	 conds[2] = {0};
+	daos_pipeline_agg_t	 aggs[4] = {0};
+	daos_pipeline_t		 pipeline;
+	daos_pipeline_stats_t	 stats;
+	double			 res[4];
+	daos_key_desc_t		 kds[16];
+	daos_anchor_t		 anchor = {0};
+	d_sg_list_t		 sgl;
+	d_iov_t			 sg_iov;
+	char			 buf[1024];
+	char			 dkey[32];
+	const char		*big = "value larger than 8 bytes";
+	uint32_t		 age;
+	double			 score;
+	int			 i;
+	int			 rc;
+
+	oid = daos_test_oid_gen(arg->coh, dts_obj_class, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	print_message("Insert 100 dkeys with age/score akeys\n");
+	for (i = 0; i < 100; i++) {
+		sprintf(dkey, "dkey_%d", i);
+		age = i;
+		score = i * 0.5;
+		insert_single(dkey, "age", 0, &age, sizeof(age), DAOS_TX_NONE,
+			      &req);
+		insert_single(dkey, "score", 0, &score, sizeof(score),
+			      DAOS_TX_NONE, &req);
+	}
+	/** neither a match nor aggregated */
+	insert_single("dkey_big", "age", 0, (void *)big, strlen(big) + 1,
+		      DAOS_TX_NONE, &req);
+	insert_single("dkey_noage", "score", 0, &score, sizeof(score),
+		      DAOS_TX_NONE, &req);
+
+	/** 50 <= age < 80 */
+	d_iov_set(&conds[0].pc_akey, "age", strlen("age"));
+	conds[0].pc_type = DAOS_PIPELINE_UINT;
+	conds[0].pc_cmp = DAOS_PIPELINE_GE;
+	conds[0].pc_const.u = 50;
+	conds[1] = conds[0];
+	conds[1].pc_cmp = DAOS_PIPELINE_LT;
+	conds[1].pc_const.u = 80;
+
+	aggs[0].pa_op = DAOS_PIPELINE_COUNT;
+	d_iov_set(&aggs[1].pa_akey, "score", strlen("score"));
+	aggs[1].pa_type = DAOS_PIPELINE_DOUBLE;
+	aggs[1].pa_op = DAOS_PIPELINE_SUM;
+	aggs[2] = aggs[1];
+	aggs[2].pa_op = DAOS_PIPELINE_MIN;
+	d_iov_set(&aggs[3].pa_akey, "age", strlen("age"));
+	aggs[3].pa_type = DAOS_PIPELINE_UINT;
+	aggs[3].pa_op = DAOS_PIPELINE_MAX;
+
+	pipeline.dp_nr_conds = 2;
+	pipeline.dp_conds = conds;
+	pipeline.dp_nr_aggs = 4;
+	pipeline.dp_aggs = aggs;
+	assert_rc_equal(daos_pipeline_check(&pipeline), 0);
+
+	stats.ps_aggs = res;
+	daos_pipeline_stats_init(&pipeline, &stats);
+
+	print_message("Run the pipeline by batches of 16 dkeys\n");
+	d_iov_set(&sg_iov, buf, sizeof(buf));
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &sg_iov;
+	while (!daos_anchor_is_eof(&anchor)) {
+		uint32_t	nr = 16;
+		char		*key = buf;
+		uint32_t	j;
+
+		rc = daos_pipeline_run(req.oh, DAOS_TX_NONE, &pipeline, &anchor,
+				       &nr, kds, &sgl, &stats, NULL);
+		assert_rc_equal(rc, 0);
+
+		for (j = 0; j < nr; j++) {
+			assert_true(kds[j].kd_key_len > strlen("dkey_"));
+			assert_memory_equal(key, "dkey_", strlen("dkey_"));
+			key += kds[j].kd_key_len;
+		}
+	}
+
+	assert_int_equal(stats.ps_nr_scanned, 102);
+	assert_int_equal(stats.ps_nr_matched, 30);
+	assert_true(res[0] == 30);
+	assert_true(res[1] == 967.5);
+	assert_true(res[2] == 25);
+	assert_true(res[3] == 79);
+
+	print_message("Invalid pipeline is rejected\n");
+	conds[1].pc_akey.iov_len = 0;
+	assert_rc_equal(daos_pipeline_check(&pipeline), -DER_INVAL);
+
+	ioreq_fini(&req);
+}
+
 static const struct CMUnitTest io_tests[] = {
 	{ "IO1: simple update/fetch/verify",
 	  io_simple, async_disable, test_case_teardown},
@@ -4736,6 +4880,10 @@ static const struct CMUnitTest io_tests[] = {
 	  int_key_setting, async_disable, test_case_teardown},
 	{ "IO45: enum recxs with aggregation",
 	  enum_recxs_with_aggregation, async_disable, test_case_teardown},
+	{ "IO46: parallel dkey listing of all groups",
+	  list_dkey_all, async_disable, test_case_teardown},
+	{ "IO47: pipeline filter and aggregation",
+	  pipeline_filter_aggregate, async_disable, test_case_teardown},
 };
 
 int
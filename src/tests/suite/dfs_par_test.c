@@ -850,6 +850,69 @@ dfs_test_file_create_atomicity(void **state)
 	}
 }
 
+static int
+coll_bcast_cb(void *buf, size_t size, void *arg)
+{
+	MPI_Comm	*comm = arg;
+	int		rc;
+
+	rc = MPI_Bcast(buf, size, MPI_BYTE, 0, *comm);
+	return rc == MPI_SUCCESS ? 0 : EIO;
+}
+
+static void
+dfs_test_coll(void **state)
+{
+	test_arg_t	*arg = *state;
+	MPI_Comm	comm = MPI_COMM_WORLD;
+	bool		root = (arg->myrank == 0);
+	const char	*filename = "coll_file";
+	dfs_t		*dfs;
+	dfs_obj_t	*file;
+	daos_size_t	size;
+	int		rc;
+
+	if (root) {
+		rc = dfs_open(dfs_mt, NULL, filename, S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &file);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(file);
+		assert_int_equal(rc, 0);
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	if (root)
+		print_message("All ranks mount with a single mount on rank 0\n");
+	rc = dfs_mount_coll(arg->pool.poh, co_hdl, O_RDWR, root, coll_bcast_cb, &comm, &dfs);
+	assert_int_equal(rc, 0);
+
+	if (root)
+		print_message("All ranks open a file looked up on rank 0\n");
+	rc = dfs_lookup_coll(dfs, "/coll_file", O_RDWR, root, coll_bcast_cb, &comm, &file);
+	assert_int_equal(rc, 0);
+	rc = dfs_get_size(dfs, file, &size);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, 0);
+	rc = dfs_release(file);
+	assert_int_equal(rc, 0);
+
+	/** errors on rank 0 are returned everywhere */
+	rc = dfs_lookup_coll(dfs, "/coll_nofile", O_RDWR, root, coll_bcast_cb, &comm, &file);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_lookup_coll(dfs, "/", O_RDWR, root, coll_bcast_cb, &comm, &file);
+	assert_int_equal(rc, EINVAL);
+
+	rc = dfs_umount(dfs);
+	assert_int_equal(rc, 0);
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	if (root) {
+		rc = dfs_remove(dfs_mt, NULL, filename, false, NULL);
+		assert_int_equal(rc, 0);
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
 static const struct CMUnitTest dfs_par_tests[] = {
 	{ "DFS_PAR_TEST1: Conditional OPs",
 	  dfs_test_cond, async_disable, test_case_teardown},
@@ -863,6 +926,8 @@ static const struct CMUnitTest dfs_par_tests[] = {
 	  dfs_test_cont_atomic, async_disable, test_case_teardown},
 	{ "DFS_PAR_TEST6: DFS File create (without O_EXCL) atomicity",
 	  dfs_test_file_create_atomicity, async_disable, test_case_teardown},
+	{ "DFS_PAR_TEST7: DFS collective mount / lookup",
+	  dfs_test_coll, async_disable, test_case_teardown},
 };
 
 static int
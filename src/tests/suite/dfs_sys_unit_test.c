@@ -709,6 +709,64 @@ dfs_sys_test_xattr(void **state)
 	delete_simple_tree(dir1, file1, sym1);
 }
 
+/**
+ * Verify lookups of nested paths resolved through cached parents,
+ * including symlinks and "." components along the path.
+ */
+static void
+dfs_sys_test_nested_paths(void **state)
+{
+	test_arg_t	*arg = *state;
+	const char	*dir1 = "/dir1";
+	const char	*dir2 = "/dir1/dir2";
+	const char	*dir3 = "/dir1/dir2/dir3";
+	const char	*file1 = "/dir1/dir2/dir3/file1";
+	const char	*sym1 = "/dir1/sym1";
+	const char	*paths[] = {
+		"/dir1/dir2/dir3/file1",
+		"/dir1//dir2/dir3//file1",
+		"/dir1/./dir2/dir3/file1",
+		"/dir1/sym1/dir3/file1",
+	};
+	struct stat	stbuf;
+	int		i;
+	int		rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = dfs_sys_mkdir(dfs_sys_mt, dir1, S_IWUSR | S_IRUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_sys_mkdir(dfs_sys_mt, dir2, S_IWUSR | S_IRUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_sys_mkdir(dfs_sys_mt, dir3, S_IWUSR | S_IRUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_sys_mknod(dfs_sys_mt, file1, S_IFREG, 0, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_sys_symlink(dfs_sys_mt, "dir2", sym1);
+	assert_int_equal(rc, 0);
+
+	/** Same file through different paths, twice to hit the cache */
+	for (i = 0; i < ARRAY_SIZE(paths) * 2; i++) {
+		rc = dfs_sys_stat(dfs_sys_mt, paths[i % ARRAY_SIZE(paths)], 0,
+				  &stbuf);
+		assert_int_equal(rc, 0);
+		assert_true(S_ISREG(stbuf.st_mode));
+	}
+
+	/** Missing and non-directory components */
+	rc = dfs_sys_stat(dfs_sys_mt, "/dir1/nodir/dir3/file1", 0, &stbuf);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_sys_stat(dfs_sys_mt, "/dir1/dir2/dir3/file1/file2", 0,
+			  &stbuf);
+	assert_int_equal(rc, ENOTDIR);
+
+	rc = dfs_sys_remove(dfs_sys_mt, sym1, false, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_sys_remove(dfs_sys_mt, dir1, true, NULL);
+	assert_int_equal(rc, 0);
+}
+
 static const struct CMUnitTest dfs_sys_unit_tests[] = {
 	{ "DFS_SYS_UNIT_TEST1:  DFS Sys mount / umount",
 	  dfs_sys_test_mount, async_disable, test_case_teardown},
@@ -730,6 +788,8 @@ static const struct CMUnitTest dfs_sys_unit_tests[] = {
 	  dfs_sys_test_open_readdir, async_disable, test_case_teardown},
 	{ "DFS_SYS_UNIT_TEST10: DFS Sys xattr",
 	  dfs_sys_test_xattr, async_disable, test_case_teardown},
+	{ "DFS_SYS_UNIT_TEST11: DFS Sys nested paths",
+	  dfs_sys_test_nested_paths, async_disable, test_case_teardown},
 };
 
 static int
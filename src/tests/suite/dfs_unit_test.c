@@ -1037,6 +1037,369 @@ dfs_test_compat(void **state)
 	assert_int_equal(rc, EINVAL);
 }
 
+static void
+dfs_test_ostatx(void **state)
+{
+	test_arg_t		*arg = *state;
+	dfs_obj_t		*obj;
+	dfs_obj_t		*dir;
+	struct stat		stbuf;
+	struct stat		stbuf_x;
+	daos_event_t		ev, *evp;
+	char			buf[64];
+	d_sg_list_t		sgl;
+	d_iov_t			iov;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = dfs_open(dfs_mt, NULL, "ostatx_file", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT, OC_S1, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+
+	memset(buf, 'x', sizeof(buf));
+	d_iov_set(&iov, buf, sizeof(buf));
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+	rc = dfs_write(dfs_mt, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_mkdir(dfs_mt, NULL, "ostatx_dir", S_IWUSR | S_IRUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, "ostatx_dir", O_RDONLY, &dir, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_ostat(dfs_mt, obj, &stbuf);
+	assert_int_equal(rc, 0);
+
+	if (arg->async) {
+		rc = daos_event_init(&ev, arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+	}
+	rc = dfs_ostatx(dfs_mt, obj, &stbuf_x, arg->async ? &ev : NULL);
+	assert_int_equal(rc, 0);
+	if (arg->async) {
+		rc = daos_eq_poll(arg->eq, 0, DAOS_EQ_WAIT, 1, &evp);
+		assert_rc_equal(rc, 1);
+		assert_ptr_equal(evp, &ev);
+		assert_int_equal(evp->ev_error, 0);
+		rc = daos_event_fini(&ev);
+		assert_rc_equal(rc, 0);
+	}
+	assert_int_equal(stbuf_x.st_size, sizeof(buf));
+	assert_int_equal(stbuf_x.st_mode, stbuf.st_mode);
+	assert_int_equal(stbuf_x.st_mtim.tv_sec, stbuf.st_mtim.tv_sec);
+
+	if (arg->async) {
+		rc = daos_event_init(&ev, arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+	}
+	rc = dfs_ostatx(dfs_mt, dir, &stbuf_x, arg->async ? &ev : NULL);
+	assert_int_equal(rc, 0);
+	if (arg->async) {
+		rc = daos_eq_poll(arg->eq, 0, DAOS_EQ_WAIT, 1, &evp);
+		assert_rc_equal(rc, 1);
+		assert_int_equal(evp->ev_error, 0);
+		rc = daos_event_fini(&ev);
+		assert_rc_equal(rc, 0);
+	}
+	assert_true(S_ISDIR(stbuf_x.st_mode));
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "ostatx_dir", 0, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "ostatx_file", 0, NULL);
+	assert_int_equal(rc, 0);
+}
+
+#define DFS_TEST_BATCH_NR 16
+
+static void
+dfs_test_batch(void **state)
+{
+	test_arg_t		*arg = *state;
+	char			name_bufs[DFS_TEST_BATCH_NR + 1][16];
+	const char		*names[DFS_TEST_BATCH_NR + 1];
+	struct stat		stbufs[DFS_TEST_BATCH_NR + 1];
+	int			rcs[DFS_TEST_BATCH_NR + 1];
+	dfs_obj_t		*dir;
+	int			i;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = dfs_mkdir(dfs_mt, NULL, "batch_dir", S_IWUSR | S_IRUSR | S_IXUSR,
+		       0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, "batch_dir", O_RDWR, &dir, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i <= DFS_TEST_BATCH_NR; i++) {
+		sprintf(name_bufs[i], "file.%d", i);
+		names[i] = name_bufs[i];
+	}
+
+	print_message("Create %d files in one batch\n", DFS_TEST_BATCH_NR);
+	rc = dfs_create_many(dfs_mt, dir, DFS_TEST_BATCH_NR, names,
+			     S_IWUSR | S_IRUSR, 0, 0, rcs);
+	assert_int_equal(rc, 0);
+
+	print_message("Creating them again should fail per entry\n");
+	rc = dfs_create_many(dfs_mt, dir, DFS_TEST_BATCH_NR, names,
+			     S_IWUSR | S_IRUSR, 0, 0, rcs);
+	assert_int_equal(rc, EEXIST);
+	for (i = 0; i < DFS_TEST_BATCH_NR; i++)
+		assert_int_equal(rcs[i], EEXIST);
+
+	print_message("Stat them, plus one that does not exist\n");
+	rc = dfs_stat_many(dfs_mt, dir, DFS_TEST_BATCH_NR + 1, names, stbufs,
+			   rcs);
+	assert_int_equal(rc, ENOENT);
+	for (i = 0; i < DFS_TEST_BATCH_NR; i++) {
+		assert_int_equal(rcs[i], 0);
+		assert_true(S_ISREG(stbufs[i].st_mode));
+		assert_int_equal(stbufs[i].st_size, 0);
+	}
+	assert_int_equal(rcs[DFS_TEST_BATCH_NR], ENOENT);
+
+	for (i = 0; i < DFS_TEST_BATCH_NR; i++) {
+		rc = dfs_remove(dfs_mt, dir, names[i], false, NULL);
+		assert_int_equal(rc, 0);
+	}
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "batch_dir", false, NULL);
+	assert_int_equal(rc, 0);
+}
+
+static void
+dfs_test_dcache(void **state)
+{
+	test_arg_t		*arg = *state;
+	dfs_obj_t		*dir, *obj;
+	struct stat		stbuf;
+	mode_t			mode;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = dfs_set_dcache(dfs_mt, 60, 60);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_mkdir(dfs_mt, NULL, "dcache_dir", S_IWUSR | S_IRUSR | S_IXUSR,
+		       0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, "dcache_dir", O_RDWR, &dir, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_open(dfs_mt, dir, "file", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	print_message("Lookups populate and then hit the cache\n");
+	rc = dfs_lookup(dfs_mt, "/dcache_dir/file", O_RDWR, &obj, &mode,
+			&stbuf);
+	assert_int_equal(rc, 0);
+	assert_true(S_ISREG(mode));
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup(dfs_mt, "/dcache_dir/file", O_RDWR, &obj, &mode,
+			NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	print_message("Local chmod, rename and remove invalidate entries\n");
+	rc = dfs_chmod(dfs_mt, dir, "file", S_IFREG | S_IRUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_mt, dir, "file", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_mode, S_IFREG | S_IRUSR);
+
+	rc = dfs_move(dfs_mt, dir, "file", dir, "file2", NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup(dfs_mt, "/dcache_dir/file", O_RDWR, &obj, NULL, NULL);
+	assert_int_equal(rc, ENOENT);
+
+	rc = dfs_remove(dfs_mt, dir, "file2", false, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup(dfs_mt, "/dcache_dir/file2", O_RDWR, &obj, NULL, NULL);
+	assert_int_equal(rc, ENOENT);
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "dcache_dir", false, NULL);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_set_dcache(dfs_mt, 0, 0);
+	assert_int_equal(rc, 0);
+}
+
+static int
+count_cb(dfs_t *dfs, dfs_obj_t *obj, const char name[], void *arg)
+{
+	uint32_t *count = arg;
+
+	(*count)++;
+	return 0;
+}
+
+static void
+dfs_test_iterate_shards(void **state)
+{
+	test_arg_t		*arg = *state;
+	char			name_bufs[DFS_TEST_BATCH_NR][16];
+	const char		*names[DFS_TEST_BATCH_NR];
+	int			rcs[DFS_TEST_BATCH_NR];
+	dfs_obj_t		*dir;
+	uint32_t		count = 0;
+	int			i;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = dfs_mkdir(dfs_mt, NULL, "shard_dir", S_IWUSR | S_IRUSR | S_IXUSR,
+		       OC_SX);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, "shard_dir", O_RDWR, &dir, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < DFS_TEST_BATCH_NR; i++) {
+		sprintf(name_bufs[i], "file.%d", i);
+		names[i] = name_bufs[i];
+	}
+	rc = dfs_create_many(dfs_mt, dir, DFS_TEST_BATCH_NR, names,
+			     S_IWUSR | S_IRUSR, 0, 0, rcs);
+	assert_int_equal(rc, 0);
+
+	print_message("Iterate all shards of a sharded directory\n");
+	rc = dfs_iterate_shards(dfs_mt, dir, count_cb, &count);
+	assert_int_equal(rc, 0);
+	assert_int_equal(count, DFS_TEST_BATCH_NR);
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "shard_dir", true, NULL);
+	assert_int_equal(rc, 0);
+}
+
+static void
+dfs_test_suggest_oclass(void **state)
+{
+	test_arg_t		*arg = *state;
+	char			name_bufs[DFS_TEST_BATCH_NR][16];
+	const char		*names[DFS_TEST_BATCH_NR];
+	int			rcs[DFS_TEST_BATCH_NR];
+	dfs_oclass_advice_t	advice = {0};
+	dfs_obj_info_t		info;
+	dfs_obj_t		*dir;
+	int			i;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = dfs_mkdir(dfs_mt, NULL, "advice_dir", S_IWUSR | S_IRUSR | S_IXUSR,
+		       OC_S1);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, "advice_dir", O_RDWR, &dir, NULL,
+			    NULL);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < DFS_TEST_BATCH_NR; i++) {
+		sprintf(name_bufs[i], "file.%d", i);
+		names[i] = name_bufs[i];
+	}
+	rc = dfs_create_many(dfs_mt, dir, DFS_TEST_BATCH_NR, names,
+			     S_IWUSR | S_IRUSR, 0, 0, rcs);
+	assert_int_equal(rc, 0);
+
+	print_message("Small private files keep a single group\n");
+	rc = dfs_obj_suggest_oclass(dfs_mt, dir, 0, &advice);
+	assert_int_equal(rc, 0);
+	assert_int_equal(advice.doa_nr_files, DFS_TEST_BATCH_NR);
+	assert_int_equal(advice.doa_max_size, 0);
+	assert_int_equal(advice.doa_cur_oclass, OC_S1);
+	assert_int_equal(advice.doa_oclass, OC_S1);
+
+	print_message("Widely shared files are striped over all targets\n");
+	advice.doa_sharers = MAX_NUM_GROUPS;
+	rc = dfs_obj_suggest_oclass(dfs_mt, dir, DFS_OCLASS_APPLY, &advice);
+	assert_int_equal(rc, 0);
+	assert_int_equal(advice.doa_oclass, OC_SX);
+	rc = dfs_obj_get_info(dfs_mt, dir, &info);
+	assert_int_equal(rc, 0);
+	assert_int_equal(info.doi_oclass_id, OC_SX);
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "advice_dir", true, NULL);
+	assert_int_equal(rc, 0);
+}
+
+static void
+dfs_test_create_write(void **state)
+{
+	test_arg_t		*arg = *state;
+	dfs_obj_t		*obj;
+	char			buf[4096];
+	char			rbuf[4096];
+	d_sg_list_t		sgl;
+	d_iov_t			iov;
+	daos_size_t		size;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	memset(buf, 'c', sizeof(buf));
+	d_iov_set(&iov, buf, sizeof(buf));
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+
+	print_message("Create a file with its first write\n");
+	rc = dfs_create_write(dfs_mt, NULL, "cw_file", S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR, 0, 0, &sgl, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_get_size(dfs_mt, obj, &size);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, sizeof(buf));
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	print_message("Creating it again should fail\n");
+	rc = dfs_create_write(dfs_mt, NULL, "cw_file", S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR, 0, 0, &sgl, &obj);
+	assert_int_equal(rc, EEXIST);
+
+	rc = dfs_open(dfs_mt, NULL, "cw_file", S_IFREG, O_RDONLY, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	d_iov_set(&iov, rbuf, sizeof(rbuf));
+	rc = dfs_read(dfs_mt, obj, &sgl, 0, &size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, sizeof(rbuf));
+	assert_memory_equal(buf, rbuf, sizeof(buf));
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_remove(dfs_mt, NULL, "cw_file", false, NULL);
+	assert_int_equal(rc, 0);
+}
+
 static const struct CMUnitTest dfs_unit_tests[] = {
 	{ "DFS_UNIT_TEST1: DFS mount / umount",
 	  dfs_test_mount, async_disable, test_case_teardown},
@@ -1062,6 +1425,20 @@ static const struct CMUnitTest dfs_unit_tests[] = {
 	  dfs_test_rename, async_disable, test_case_teardown},
 	{ "DFS_UNIT_TEST12: DFS API compat",
 	  dfs_test_compat, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST13: DFS ostatx sync",
+	  dfs_test_ostatx, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST14: DFS ostatx async",
+	  dfs_test_ostatx, async_enable, test_case_teardown},
+	{ "DFS_UNIT_TEST15: DFS batched create / stat",
+	  dfs_test_batch, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST16: DFS dentry cache",
+	  dfs_test_dcache, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST17: DFS parallel shard iteration",
+	  dfs_test_iterate_shards, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST18: DFS object class advice",
+	  dfs_test_suggest_oclass, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST19: DFS create with first write",
+	  dfs_test_create_write, async_disable, test_case_teardown},
 };
 
 static int
@@ -34,6 +34,7 @@ bool		ts_nest_iterator;
 daos_unit_oid_t	*ts_uoids;	/* object shard IDs */
 
 bool		ts_in_ult;	/* Run tests in ULT mode */
+bool		ts_tx_stats;	/* Report PMDK tx ranges of modifications */
 static ABT_xstream	abt_xstream;
 
 static int
@@ -407,19 +408,64 @@ objects_close(void)
 	return 0;
 }
 
+static int
+pf_tx_stats_begin(vos_pool_info_t *pinfo)
+{
+	if (!ts_tx_stats)
+		return 0;
+
+	return vos_pool_query(ts_ctx.tsc_poh, pinfo);
+}
+
+/* Report the PMEM ranges and bytes added to transactions per @what */
+static int
+pf_tx_stats_end(vos_pool_info_t *pinfo_start, uint64_t total, const char *what)
+{
+	struct umem_tx_stats	*start = &pinfo_start->pif_tx_stats;
+	struct umem_tx_stats	*end;
+	vos_pool_info_t		 pinfo_end;
+	int			 rc;
+
+	if (!ts_tx_stats)
+		return 0;
+
+	rc = vos_pool_query(ts_ctx.tsc_poh, &pinfo_end);
+	if (rc)
+		return rc;
+
+	end = &pinfo_end.pif_tx_stats;
+	if (ts_ctx.tsc_mpi_rank == 0 && total != 0)
+		fprintf(stdout, "\ttx adds  : %-10.2f ranges, %-10.2f bytes per %s"
+			" ("DF_U64" bytes total)\n",
+			(double)(end->uts_add_cnt - start->uts_add_cnt) / total,
+			(double)(end->uts_add_bytes - start->uts_add_bytes) / total,
+			what, end->uts_add_bytes - start->uts_add_bytes);
+	return 0;
+}
+
 static int
 pf_update(struct pf_test *ts, struct pf_param *param)
 {
-	int	rc;
+	vos_pool_info_t	pinfo_start;
+	int		rc;
 
 	rc = objects_open();
 	if (rc)
 		return rc;
 
+	rc = pf_tx_stats_begin(&pinfo_start);
+	if (rc)
+		return rc;
+
 	rc = objects_update(param);
 	if (rc)
 		return rc;
 
+	rc = pf_tx_stats_end(&pinfo_start, (uint64_t)ts_obj_p_cont * ts_dkey_p_obj *
+			     ts_akey_p_dkey * ts_recx_p_akey, "update");
+	if (rc)
+		return rc;
+
 	rc = objects_close();
 	return rc;
 }
@@ -427,16 +473,26 @@ pf_update(struct pf_test *ts, struct pf_param *param)
 static int
 pf_punch(struct pf_test *ts, struct pf_param *param)
 {
-	int	rc;
+	vos_pool_info_t	pinfo_start;
+	int		rc;
 
 	rc = objects_open();
 	if (rc)
 		return rc;
 
+	rc = pf_tx_stats_begin(&pinfo_start);
+	if (rc)
+		return rc;
+
 	rc = objects_punch(param);
 	if (rc)
 		return rc;
 
+	rc = pf_tx_stats_end(&pinfo_start, param->pa_rw.dkey_flag ?
+			     ts_obj_p_cont * ts_dkey_p_obj : ts_obj_p_cont, "punch");
+	if (rc)
+		return rc;
+
 	rc = objects_close();
 	return rc;
 }
@@ -464,17 +520,24 @@ pf_aggregate(struct pf_test *ts, struct pf_param *param)
 {
 	daos_epoch_t epoch = crt_hlc_get();
 	daos_epoch_range_t	epr = {0, ++epoch};
+	vos_pool_info_t		pinfo_start;
 	int			rc = 0;
 	uint64_t		start = 0;
 
+	rc = pf_tx_stats_begin(&pinfo_start);
+	if (rc)
+		return rc;
+
 	TS_TIME_START(&param->pa_duration, start);
 
 	rc = vos_aggregate(ts_ctx.tsc_coh, &epr, NULL, NULL,
 			   VOS_AGG_FL_FORCE_SCAN | VOS_AGG_FL_FORCE_MERGE);
 
 	TS_TIME_END(&param->pa_duration, start);
+	if (rc)
+		return rc;
 
-	return rc;
+	return pf_tx_stats_end(&pinfo_start, 1, "aggregation");
 }
 
 static int
@@ -482,16 +545,67 @@ pf_discard(struct pf_test *ts, struct pf_param *param)
 {
 	daos_epoch_t epoch = crt_hlc_get();
 	daos_epoch_range_t	epr = {0, ++epoch};
+	vos_pool_info_t		pinfo_start;
 	int			rc = 0;
 	uint64_t		start = 0;
 
+	rc = pf_tx_stats_begin(&pinfo_start);
+	if (rc)
+		return rc;
+
 	TS_TIME_START(&param->pa_duration, start);
 
 	rc = vos_discard(ts_ctx.tsc_coh, NULL, &epr, NULL, NULL);
 
 	TS_TIME_END(&param->pa_duration, start);
+	if (rc)
+		return rc;
 
-	return rc;
+	return pf_tx_stats_end(&pinfo_start, 1, "discard");
+}
+
+/* GC credits consumed per vos_gc_pool() call, as the engine GC ULT does */
+#define PF_GC_CREDITS	256
+
+/* Never yield, vos_perf may not run in a ULT */
+static bool
+pf_gc_yield(void *arg)
+{
+	return false;
+}
+
+/* Drain the pool GC, e.g. after the punch and aggregation of previous tests */
+static int
+pf_gc(struct pf_test *ts, struct pf_param *param)
+{
+	vos_pool_info_t	pinfo_start;
+	unsigned int	runs = 0;
+	int		rc = 0;
+	uint64_t	start = 0;
+
+	rc = pf_tx_stats_begin(&pinfo_start);
+	if (rc)
+		return rc;
+
+	TS_TIME_START(&param->pa_duration, start);
+
+	while (!vos_gc_pool_idle(ts_ctx.tsc_poh)) {
+		rc = vos_gc_pool(ts_ctx.tsc_poh, PF_GC_CREDITS, pf_gc_yield, NULL);
+		if (rc < 0)
+			break;
+		runs++;
+		rc = 0;
+	}
+
+	TS_TIME_END(&param->pa_duration, start);
+	if (rc)
+		return rc;
+
+	if (param->pa_verbose)
+		D_PRINT("GC drained in %u runs of %d credits\n", runs,
+			PF_GC_CREDITS);
+
+	return pf_tx_stats_end(&pinfo_start, max(runs, 1U), "GC run");
 }
 
 static int
@@ -654,6 +768,12 @@ struct pf_test pf_tests[] = {
 		.ts_parse	= pf_parse_aggregate,
 		.ts_func	= pf_discard,
 	},
+	{
+		.ts_code	= 'G',
+		.ts_name	= "GC",
+		.ts_parse	= pf_parse_aggregate,
+		.ts_func	= pf_gc,
+	},
 	{
 		.ts_code	= 0,
 	},
@@ -672,8 +792,14 @@ const char perf_vos_usage[] = "\n"
 "-i	Use integer dkeys.  Required if running QUERY test.\n\n"
 "-I	Use constant akey.  Required for QUERY test.\n\n"
 "-x	Run each test in an ABT ULT.\n\n"
+"-T	Report ranges and bytes added to PMDK transactions by update,\n"
+"	punch, aggregate, discard and GC tests. Not supported with -x.\n\n"
 "Examples:\n"
-"	$ vos_perf -s 1024k -A -R 'U U;o=4k;s=4k V'\n";
+"	$ vos_perf -s 1024k -A -R 'U U;o=4k;s=4k V'\n"
+"	Aggregation of partial overwrites, then GC of the aggregated extents:\n"
+"	$ vos_perf -T -A -R 'U;p U;o=16;s=16;p;i=4 A;p G;p'\n"
+"	Punched keys (ilog) and their reclaim:\n"
+"	$ vos_perf -T -R 'U;p P;d;p;i=4 U;p A;p G;p'\n";
 
 static void
 ts_print_usage(void)
@@ -692,10 +818,11 @@ const struct option perf_vos_opts[] = {
 	{ "int_dkey",	no_argument,		NULL,	'i' },
 	{ "const_akey",	no_argument,		NULL,	'I' },
 	{ "abt_ult",	no_argument,		NULL,	'x' },
+	{ "tx_stats",	no_argument,		NULL,	'T' },
 	{ NULL,		0,			NULL,	0   },
 };
 
-const char perf_vos_optstr[] = "f:ziIx";
+const char perf_vos_optstr[] = "f:ziIxT";
 
 int
 main(int argc, char **argv)
@@ -755,6 +882,9 @@ main(int argc, char **argv)
 		case 'x':
 			ts_in_ult = true;
 			break;
+		case 'T':
+			ts_tx_stats = true;
+			break;
 		}
 	}
 	perf_free_opts(ts_opts, ts_optstr);
@@ -802,6 +932,11 @@ main(int argc, char **argv)
 	}
 	ts_ctx.tsc_pmem_file = ts_pmem_file;
 
+	if (ts_in_ult && ts_tx_stats) {
+		fprintf(stderr, "-T is not supported with -x\n");
+		return -1;
+	}
+
 	if (ts_in_ult) {
 		rc = ts_abt_init();
 		if (rc)
@@ -199,3 +199,59 @@ out_umount:
 		fprintf(ap->errstream, "failed to umount DFS container\n");
 	return rc;
 }
+
+int
+fs_dfs_suggest_oclass_hdlr(struct cmd_args_s *ap, int flags,
+			   dfs_oclass_advice_t *advice)
+{
+	const char	*path;
+	int		 oflags;
+	int		 rc;
+	int		 rc2;
+	dfs_t		*dfs;
+	dfs_obj_t	*obj;
+
+	D_ASSERT(ap != NULL);
+	D_ASSERT(advice != NULL);
+
+	path = ap->dfs_path ? ap->dfs_path : "/";
+
+	oflags = (flags & DFS_OCLASS_APPLY) ? O_RDWR : O_RDONLY;
+
+	rc = dfs_mount(ap->pool, ap->cont, oflags, &dfs);
+	if (rc) {
+		fprintf(ap->errstream, "failed to mount container %s: %s (%d)\n",
+			ap->cont_str, strerror(rc), rc);
+		return rc;
+	}
+
+	if (ap->dfs_prefix) {
+		rc = dfs_set_prefix(dfs, ap->dfs_prefix);
+		if (rc)
+			D_GOTO(out_umount, rc);
+	}
+
+	rc = dfs_lookup(dfs, path, oflags, &obj, NULL, NULL);
+	if (rc) {
+		fprintf(ap->errstream, "failed to lookup %s (%s)\n", path,
+			strerror(rc));
+		D_GOTO(out_umount, rc);
+	}
+
+	rc = dfs_obj_suggest_oclass(dfs, obj, flags, advice);
+	if (rc) {
+		fprintf(ap->errstream, "failed to suggest object class (%s)\n",
+			strerror(rc));
+		D_GOTO(out_release, rc);
+	}
+
+out_release:
+	rc2 = dfs_release(obj);
+	if (rc2 != 0)
+		fprintf(ap->errstream, "failed to release dfs obj\n");
+out_umount:
+	rc2 = dfs_umount(dfs);
+	if (rc2 != 0)
+		fprintf(ap->errstream, "failed to umount DFS container\n");
+	return rc;
+}
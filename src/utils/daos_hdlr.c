@@ -30,6 +30,7 @@
 #include <daos/rpc.h>
 #include <daos/debug.h>
 #include <daos/object.h>
+#include <gurt/atomic.h>
 
 #include "daos_types.h"
 #include "daos_api.h"
@@ -42,10 +43,14 @@
 
 #define OID_ARR_SIZE 8
 
+/** Max number of concurrent streams copying a single file */
+#define FS_COPY_STREAMS		8
+/** Size of the range copied by a stream, rounded up to the chunk size */
+#define FS_COPY_RANGE_SIZE	(8 * 1024 * 1024)
+
 struct file_dfs {
 	enum {POSIX, DAOS} type;
 	int fd;
-	daos_off_t offset;
 	dfs_obj_t *obj;
 	dfs_sys_t *dfs_sys;
 };
@@ -1306,7 +1311,7 @@ out:
 
 static int
 file_write(struct cmd_args_s *ap, struct file_dfs *file_dfs,
-	   const char *file, void *buf, ssize_t *size)
+	   const char *file, void *buf, ssize_t *size, daos_off_t offset)
 {
 	int rc = 0;
 	/* posix write returns -1 on error so wrapper uses ssize_t, but
@@ -1315,16 +1320,13 @@ file_write(struct cmd_args_s *ap, struct file_dfs *file_dfs,
 	daos_size_t tmp_size = *size;
 
 	if (file_dfs->type == POSIX) {
-		*size = write(file_dfs->fd, buf, *size);
+		*size = pwrite(file_dfs->fd, buf, *size, offset);
 		if (*size < 0)
 			rc = errno;
 	} else if (file_dfs->type == DAOS) {
-		rc = dfs_sys_write(file_dfs->dfs_sys, file_dfs->obj, buf, file_dfs->offset,
+		rc = dfs_sys_write(file_dfs->dfs_sys, file_dfs->obj, buf, offset,
 				   &tmp_size, NULL);
 		*size = tmp_size;
-		if (rc == 0)
-			/* update file pointer with number of bytes written */
-			file_dfs->offset += *size;
 	} else {
 		rc = EINVAL;
 		DH_PERROR_SYS(ap, rc, "File type not known '%s' type=%d", file, file_dfs->type);
@@ -1469,7 +1471,7 @@ file_lstat(struct cmd_args_s *ap, struct file_dfs *file_dfs,
 
 static int
 file_read(struct cmd_args_s *ap, struct file_dfs *file_dfs,
-	  const char *file, void *buf, ssize_t *size)
+	  const char *file, void *buf, ssize_t *size, daos_off_t offset)
 {
 	int rc = 0;
 	/* posix read returns -1 on error so wrapper uses ssize_t, but
@@ -1478,16 +1480,13 @@ file_read(struct cmd_args_s *ap, struct file_dfs *file_dfs,
 	daos_size_t tmp_size = *size;
 
 	if (file_dfs->type == POSIX) {
-		*size = read(file_dfs->fd, buf, *size);
+		*size = pread(file_dfs->fd, buf, *size, offset);
 		if (*size < 0)
 			rc = errno;
 	} else if (file_dfs->type == DAOS) {
-		rc = dfs_sys_read(file_dfs->dfs_sys, file_dfs->obj, buf, file_dfs->offset,
+		rc = dfs_sys_read(file_dfs->dfs_sys, file_dfs->obj, buf, offset,
 				  &tmp_size, NULL);
 		*size = tmp_size;
-		if (rc == 0)
-			/* update file pointer with number of bytes read */
-			file_dfs->offset += (daos_off_t)*size;
 	} else {
 		rc = EINVAL;
 		DH_PERROR_SYS(ap, rc, "File type not known '%s' type=%d", file, file_dfs->type);
@@ -1568,6 +1567,105 @@ file_chmod(struct cmd_args_s *ap, struct file_dfs *file_dfs, const char *path,
 	return rc;
 }
 
+/** State shared by the streams copying a file */
+struct fs_copy_file_args {
+	struct cmd_args_s	*ap;
+	struct file_dfs		*src_file_dfs;
+	struct file_dfs		*dst_file_dfs;
+	const char		*src_path;
+	const char		*dst_path;
+	uint64_t		 file_length;
+	uint64_t		 range_size;
+	/** next range to copy */
+	ATOMIC uint64_t		 next_range;
+	/** error of a stream, stops the others */
+	ATOMIC int		 rc;
+};
+
+/**
+ * Copy ranges of a file until all are claimed or a stream fails.
+ * Each stream reads and writes at the offset of its range, so that
+ * several streams can work on the same open files.
+ */
+static void *
+fs_copy_file_stream(void *arg)
+{
+	struct fs_copy_file_args	*fa = arg;
+	uint64_t			 range;
+	uint64_t			 off;
+	uint64_t			 end;
+	void				*buf = NULL;
+	int				 rc = 0;
+
+	while (atomic_load_relaxed(&fa->rc) == 0) {
+		range = atomic_fetch_add_relaxed(&fa->next_range, 1);
+		off = range * fa->range_size;
+		if (off >= fa->file_length)
+			break;
+		end = min(off + fa->range_size, fa->file_length);
+
+		if (buf == NULL) {
+			D_ALLOC(buf, fa->range_size);
+			if (buf == NULL)
+				D_GOTO(out, rc = -DER_NOMEM);
+		}
+
+		/* read from source file, then write to dest file */
+		while (off < end) {
+			ssize_t left_to_read = end - off;
+			ssize_t bytes_to_write;
+
+			rc = file_read(fa->ap, fa->src_file_dfs, fa->src_path, buf,
+				       &left_to_read, off);
+			if (rc != 0) {
+				rc = daos_errno2der(rc);
+				DH_PERROR_DER(fa->ap, rc, "File read failed");
+				D_GOTO(out, rc);
+			}
+			/* source file was truncated while copying */
+			if (left_to_read == 0)
+				break;
+
+			bytes_to_write = left_to_read;
+			rc = file_write(fa->ap, fa->dst_file_dfs, fa->dst_path, buf,
+					&bytes_to_write, off);
+			if (rc != 0) {
+				rc = daos_errno2der(rc);
+				DH_PERROR_DER(fa->ap, rc, "File write failed");
+				D_GOTO(out, rc);
+			}
+			off += left_to_read;
+		}
+	}
+
+out:
+	D_FREE(buf);
+	/* keep an error of any stream, not necessarily the first one */
+	if (rc != 0 && atomic_load_relaxed(&fa->rc) == 0)
+		atomic_store_relaxed(&fa->rc, rc);
+	return NULL;
+}
+
+/**
+ * Get the size of the ranges copied by each stream, as a multiple of the
+ * chunk size of the DAOS file, the destination one first.
+ */
+static uint64_t
+fs_copy_range_size(struct file_dfs *src_file_dfs, struct file_dfs *dst_file_dfs)
+{
+	daos_size_t	chunk_size = 0;
+	int		rc = EINVAL;
+
+	if (dst_file_dfs->type == DAOS)
+		rc = dfs_get_chunk_size(dst_file_dfs->obj, &chunk_size);
+	if (rc != 0 && src_file_dfs->type == DAOS)
+		rc = dfs_get_chunk_size(src_file_dfs->obj, &chunk_size);
+	if (rc != 0 || chunk_size == 0)
+		return FS_COPY_RANGE_SIZE;
+
+	return D_ALIGNUP(FS_COPY_RANGE_SIZE, chunk_size);
+}
+
 static int
 fs_copy_file(struct cmd_args_s *ap,
 	     struct file_dfs *src_file_dfs,
@@ -1579,11 +1677,12 @@ fs_copy_file(struct cmd_args_s *ap,
 	int src_flags		= O_RDONLY;
 	int dst_flags		= O_CREAT | O_WRONLY;
 	mode_t tmp_mode_file	= S_IRUSR | S_IWUSR;
+	struct fs_copy_file_args fa = {0};
+	pthread_t streams[FS_COPY_STREAMS];
+	uint64_t nr_ranges;
+	int nr_streams;
+	int i;
 	int rc;
-	uint64_t file_length	= src_stat->st_size;
-	uint64_t total_bytes	= 0;
-	uint64_t buf_size	= 64 * 1024 * 1024;
-	void *buf		= NULL;
 
 	/* Open source file */
 	rc = file_open(ap, src_file_dfs, src_path, src_flags);
@@ -1595,53 +1694,51 @@ fs_copy_file(struct cmd_args_s *ap,
 	if (rc != 0)
 		D_GOTO(out_src_file, rc = daos_errno2der(rc));
 
-	/* Allocate read/write buffer */
-	D_ALLOC(buf, buf_size);
-	if (buf == NULL)
-		D_GOTO(out_dst_file, rc = -DER_NOMEM);
-
-	/* read from source file, then write to dest file */
-	while (total_bytes < file_length) {
-		ssize_t left_to_read = buf_size;
-		uint64_t bytes_left = file_length - total_bytes;
-
-		if (bytes_left < buf_size)
-			left_to_read = (size_t)bytes_left;
-		rc = file_read(ap, src_file_dfs, src_path, buf, &left_to_read);
-		if (rc != 0) {
-			rc = daos_errno2der(rc);
-			DH_PERROR_DER(ap, rc, "File read failed");
-			D_GOTO(out_buf, rc);
-		}
-		ssize_t bytes_to_write = left_to_read;
-
-		rc = file_write(ap, dst_file_dfs, dst_path, buf, &bytes_to_write);
+	fa.ap = ap;
+	fa.src_file_dfs = src_file_dfs;
+	fa.dst_file_dfs = dst_file_dfs;
+	fa.src_path = src_path;
+	fa.dst_path = dst_path;
+	fa.file_length = src_stat->st_size;
+	fa.range_size = fs_copy_range_size(src_file_dfs, dst_file_dfs);
+	atomic_store_relaxed(&fa.next_range, 0);
+	atomic_store_relaxed(&fa.rc, 0);
+
+	/* Copy the ranges with up to FS_COPY_STREAMS streams, the calling
+	 * thread being one of them.
+	 */
+	nr_ranges = (fa.file_length + fa.range_size - 1) / fa.range_size;
+	nr_streams = min(nr_ranges, FS_COPY_STREAMS);
+	for (i = 1; i < nr_streams; i++) {
+		rc = pthread_create(&streams[i], NULL, fs_copy_file_stream, &fa);
 		if (rc != 0) {
-			rc = daos_errno2der(rc);
-			DH_PERROR_DER(ap, rc, "File write failed");
-			D_GOTO(out_buf, rc);
+			D_DEBUG(DB_TRACE, "only %d streams for '%s': %d\n", i, src_path, rc);
+			break;
 		}
-		total_bytes += left_to_read;
 	}
+	nr_streams = i;
+
+	fs_copy_file_stream(&fa);
+	for (i = 1; i < nr_streams; i++)
+		pthread_join(streams[i], NULL);
+
+	rc = atomic_load_relaxed(&fa.rc);
+	if (rc != 0)
+		D_GOTO(out_dst_file, rc);
 
 	/* set perms on destination to original source perms */
 	rc = file_chmod(ap, dst_file_dfs, dst_path, src_stat->st_mode);
 	if (rc != 0) {
 		rc = daos_errno2der(rc);
 		DH_PERROR_DER(ap, rc, "updating dst file permissions failed");
-		D_GOTO(out_buf, rc);
+		D_GOTO(out_dst_file, rc);
 	}
 
-out_buf:
-	D_FREE(buf);
 out_dst_file:
 	file_close(ap, dst_file_dfs, dst_path);
 out_src_file:
 	file_close(ap, src_file_dfs, src_path);
 out:
-	/* reset offsets if there is another file to copy */
-	src_file_dfs->offset = 0;
-	dst_file_dfs->offset = 0;
 	return rc;
 }
 
@@ -2567,7 +2664,6 @@ file_set_defaults_dfs(struct file_dfs *file_dfs)
 	/* set defaults for file_dfs struct */
 	file_dfs->type = DAOS;
 	file_dfs->fd = -1;
-	file_dfs->offset = 0;
 	file_dfs->obj = NULL;
 	file_dfs->dfs_sys = NULL;
 }
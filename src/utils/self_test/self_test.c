@@ -62,6 +62,19 @@ static int g_shutdown_flag;
 static bool g_randomize_endpoints;
 static bool g_group_inited;
 
+/* All-to-all matrix mode, see run_matrix_size() */
+static bool g_matrix;
+static double g_outlier_factor = 2.0;
+
+struct st_matrix_cell {
+	/* Bandwidth in bytes/sec */
+	double	 bw;
+	/* Median latency in ns */
+	int64_t	 lat_median;
+	uint32_t num_failed;
+	bool	 tested;
+};
+
 static void *progress_fn(void *arg)
 {
 	int		 ret;
@@ -527,7 +540,8 @@ static int test_msg_size(crt_context_t crt_ctx,
 			 uint32_t num_ms_endpts,
 			 struct crt_st_start_params *test_params,
 			 struct st_latency **latencies,
-			 crt_bulk_t *latencies_bulk_hdl, int output_megabits)
+			 crt_bulk_t *latencies_bulk_hdl, int output_megabits,
+			 bool quiet)
 {
 
 	int				 ret;
@@ -730,6 +744,10 @@ static int test_msg_size(crt_context_t crt_ctx,
 		}
 	} while (complete_count < num_ms_endpts);
 
+	/* Caller processes the latencies itself */
+	if (quiet)
+		return 0;
+
 	/*
 	 * TODO:
 	 * In the future, probably want to return the latencies here
@@ -801,6 +819,274 @@ randomize_endpts(struct st_endpoint *endpts, uint32_t num_endpts)
 	printf("\n");
 }
 
+/* Fill a matrix cell from the latencies of one master -> target run */
+static void
+st_matrix_cell_fill(struct st_matrix_cell *cell, struct st_latency *latencies,
+		    struct crt_st_start_params *test_params,
+		    int64_t test_duration_ns)
+{
+	uint32_t	num_passed;
+	uint32_t	i;
+
+	cell->tested = true;
+	cell->num_failed = 0;
+	for (i = 0; i < test_params->rep_count; i++)
+		if (latencies[i].cci_rc < 0) {
+			cell->num_failed++;
+			latencies[i].val = -1;
+		}
+
+	num_passed = test_params->rep_count - cell->num_failed;
+	if (num_passed == 0 || test_duration_ns <= 0)
+		return;
+
+	qsort(latencies, test_params->rep_count, sizeof(latencies[0]),
+	      st_compare_latencies_by_vals);
+	cell->lat_median = latencies[cell->num_failed + num_passed / 2].val;
+	cell->bw = num_passed * (double)(test_params->send_size +
+					 test_params->reply_size) /
+		   (test_duration_ns / 1000000000.0F);
+}
+
+static int st_compare_doubles(const void *a_in, const void *b_in)
+{
+	const double *a = a_in;
+	const double *b = b_in;
+
+	return (*a > *b) - (*a < *b);
+}
+
+/*
+ * Print the latency and bandwidth matrices of one message size, then the
+ * links whose median latency is more than g_outlier_factor times the median
+ * of all links, whose bandwidth is less than the median divided by
+ * g_outlier_factor or which had failures
+ */
+static void
+print_matrix(struct st_matrix_cell *cells, uint32_t *ranks, uint32_t num_ranks,
+	     int output_megabits)
+{
+	struct st_matrix_cell	*cell;
+	double			*vals;
+	double			 lat_median = 0;
+	double			 bw_median = 0;
+	double			 bw;
+	uint32_t		 num_vals = 0;
+	uint32_t		 num_outliers = 0;
+	uint32_t		 i;
+	uint32_t		 j;
+
+	D_ALLOC_ARRAY(vals, num_ranks * num_ranks);
+	if (vals != NULL) {
+		for (i = 0; i < num_ranks * num_ranks; i++)
+			if (cells[i].tested && cells[i].bw > 0)
+				vals[num_vals++] = cells[i].lat_median;
+		if (num_vals > 0) {
+			qsort(vals, num_vals, sizeof(*vals), st_compare_doubles);
+			lat_median = vals[num_vals / 2];
+		}
+
+		num_vals = 0;
+		for (i = 0; i < num_ranks * num_ranks; i++)
+			if (cells[i].tested && cells[i].bw > 0)
+				vals[num_vals++] = cells[i].bw;
+		if (num_vals > 0) {
+			qsort(vals, num_vals, sizeof(*vals), st_compare_doubles);
+			bw_median = vals[num_vals / 2];
+		}
+		D_FREE(vals);
+	}
+
+	printf("\tMedian latency matrix (us), master rank (row) -> "
+	       "target rank (column):\n\t%8s", "");
+	for (j = 0; j < num_ranks; j++)
+		printf(" %8u", ranks[j]);
+	printf("\n");
+	for (i = 0; i < num_ranks; i++) {
+		printf("\t%8u", ranks[i]);
+		for (j = 0; j < num_ranks; j++) {
+			cell = &cells[i * num_ranks + j];
+			if (!cell->tested)
+				printf(" %8s", "-");
+			else if (cell->bw == 0)
+				printf(" %8s", "FAIL");
+			else
+				printf(" %8ld", cell->lat_median / 1000);
+		}
+		printf("\n");
+	}
+
+	printf("\n\tBandwidth matrix (%s), master rank (row) -> "
+	       "target rank (column):\n\t%8s",
+	       output_megabits ? "Mbits/sec" : "MB/sec", "");
+	for (j = 0; j < num_ranks; j++)
+		printf(" %8u", ranks[j]);
+	printf("\n");
+	for (i = 0; i < num_ranks; i++) {
+		printf("\t%8u", ranks[i]);
+		for (j = 0; j < num_ranks; j++) {
+			cell = &cells[i * num_ranks + j];
+			if (output_megabits)
+				bw = cell->bw * 8.0F / 1000000.0F;
+			else
+				bw = cell->bw / (1024.0F * 1024.0F);
+			if (!cell->tested)
+				printf(" %8s", "-");
+			else if (cell->bw == 0)
+				printf(" %8s", "FAIL");
+			else
+				printf(" %8.2f", bw);
+		}
+		printf("\n");
+	}
+
+	printf("\n\tOutlier links (factor %.2f):\n", g_outlier_factor);
+	for (i = 0; i < num_ranks * num_ranks; i++) {
+		cell = &cells[i];
+		if (!cell->tested)
+			continue;
+		if (cell->num_failed == 0 && cell->bw > 0 &&
+		    cell->lat_median <= lat_median * g_outlier_factor &&
+		    cell->bw * g_outlier_factor >= bw_median)
+			continue;
+
+		printf("\t\t%u -> %u: median latency %ld us, "
+		       "bandwidth %.2f MB/sec, %u failures\n",
+		       ranks[i / num_ranks], ranks[i % num_ranks],
+		       cell->lat_median / 1000,
+		       cell->bw / (1024.0F * 1024.0F), cell->num_failed);
+		num_outliers++;
+	}
+	if (num_outliers == 0)
+		printf("\t\tNone\n");
+	printf("\n");
+}
+
+/*
+ * All-to-all mode: every rank in the (sorted) endpoint list in turn runs a
+ * 1:many session against all the tags of every other rank, one link at a time
+ * so that each cell of the matrix measures a single pair of nodes. Using
+ * several tags per rank exercises concurrent contexts on both sides.
+ */
+static int
+run_matrix_size(crt_context_t crt_ctx, crt_group_t *srv_grp,
+		struct crt_st_start_params *test_params,
+		uint32_t reps_per_endpt, struct st_endpoint *endpts,
+		uint32_t num_endpts, int output_megabits)
+{
+	struct st_matrix_cell	*cells = NULL;
+	struct st_latency	*latencies = NULL;
+	uint32_t		*ranks = NULL;
+	uint32_t		*first = NULL;
+	uint32_t		*count = NULL;
+	uint32_t		 num_ranks = 0;
+	uint32_t		 max_count = 0;
+	uint32_t		 i;
+	uint32_t		 j;
+	int			 ret = 0;
+
+	D_ALLOC_ARRAY(ranks, num_endpts);
+	D_ALLOC_ARRAY(first, num_endpts);
+	D_ALLOC_ARRAY(count, num_endpts);
+	if (ranks == NULL || first == NULL || count == NULL)
+		D_GOTO(out, ret = -DER_NOMEM);
+
+	/* endpts are sorted, group them by rank */
+	for (i = 0; i < num_endpts; i++) {
+		if (num_ranks == 0 || ranks[num_ranks - 1] != endpts[i].rank) {
+			ranks[num_ranks] = endpts[i].rank;
+			first[num_ranks] = i;
+			count[num_ranks] = 0;
+			num_ranks++;
+		}
+		count[num_ranks - 1]++;
+		if (count[num_ranks - 1] > max_count)
+			max_count = count[num_ranks - 1];
+	}
+
+	if (num_ranks < 2) {
+		printf("Matrix mode needs at least two ranks\n");
+		D_GOTO(out, ret = -DER_INVAL);
+	}
+
+	D_ALLOC_ARRAY(cells, num_ranks * num_ranks);
+	D_ALLOC_ARRAY(latencies, reps_per_endpt * max_count);
+	if (cells == NULL || latencies == NULL)
+		D_GOTO(out, ret = -DER_NOMEM);
+
+	for (i = 0; i < num_ranks; i++) {
+		for (j = 0; j < num_ranks; j++) {
+			struct crt_st_start_params	params = *test_params;
+			struct st_master_endpt		ms_endpt = { 0 };
+			crt_bulk_t			bulk_hdl;
+			d_sg_list_t			sgl;
+			d_iov_t				iov;
+
+			if (i == j)
+				continue;
+
+			ms_endpt.endpt.ep_rank = ranks[i];
+			ms_endpt.endpt.ep_tag = 0;
+			ms_endpt.endpt.ep_grp = srv_grp;
+
+			d_iov_set(&params.endpts, &endpts[first[j]],
+				  count[j] * sizeof(*endpts));
+			params.rep_count = reps_per_endpt * count[j];
+			params.max_inflight = min(params.max_inflight,
+						  params.rep_count);
+
+			/* The bulk length has to match rep_count exactly */
+			d_iov_set(&iov, latencies,
+				  params.rep_count * sizeof(*latencies));
+			sgl.sg_iovs = &iov;
+			sgl.sg_nr = 1;
+			ret = crt_bulk_create(crt_ctx, &sgl, CRT_BULK_RW,
+					      &bulk_hdl);
+			if (ret != 0) {
+				D_ERROR("Failed to allocate latencies bulk "
+					"handle; ret = %d\n", ret);
+				D_GOTO(out, ret);
+			}
+
+			ret = test_msg_size(crt_ctx, &ms_endpt, 1, &params,
+					    &latencies, &bulk_hdl,
+					    output_megabits, true);
+			crt_bulk_free(bulk_hdl);
+
+			/* A failing link is reported in the matrix */
+			if (ret != 0 || ms_endpt.test_failed) {
+				cells[i * num_ranks + j].tested = true;
+				cells[i * num_ranks + j].num_failed =
+					params.rep_count;
+				ret = 0;
+				continue;
+			}
+
+			st_matrix_cell_fill(&cells[i * num_ranks + j],
+					    latencies, &params,
+					    ms_endpt.reply.test_duration_ns);
+		}
+	}
+
+	printf("##################################################\n");
+	printf("Matrix results for message size (%d-%s %d-%s)"
+	       " (max_inflight_rpcs = %d):\n\n",
+	       test_params->send_size,
+	       crt_st_msg_type_str[test_params->send_type],
+	       test_params->reply_size,
+	       crt_st_msg_type_str[test_params->reply_type],
+	       test_params->max_inflight);
+	print_matrix(cells, ranks, num_ranks, output_megabits);
+
+out:
+	D_FREE(latencies);
+	D_FREE(cells);
+	D_FREE(count);
+	D_FREE(first);
+	D_FREE(ranks);
+	return ret;
+}
+
 static int run_self_test(struct st_size_params all_params[],
 			 int num_msg_sizes, int rep_count, int max_inflight,
 			 char *dest_name, struct st_endpoint *ms_endpts_in,
@@ -982,9 +1268,11 @@ static int run_self_test(struct st_size_params all_params[],
 		D_ASSERT(latencies_bulk_hdl != CRT_BULK_NULL);
 	}
 
-	if (g_randomize_endpoints) {
+	if (g_matrix)
+		qsort(endpts, num_endpts, sizeof(endpts[0]),
+		      st_compare_endpts);
+	else if (g_randomize_endpoints)
 		randomize_endpts(endpts, num_endpts);
-	}
 
 	for (size_idx = 0; size_idx < num_msg_sizes; size_idx++) {
 		struct crt_st_start_params	 test_params = { 0 };
@@ -1001,9 +1289,18 @@ static int run_self_test(struct st_size_params all_params[],
 		test_params.buf_alignment = buf_alignment;
 		test_params.srv_grp = dest_name;
 
+		if (g_matrix) {
+			ret = run_matrix_size(crt_ctx, srv_grp, &test_params,
+					      rep_count / num_endpts, endpts,
+					      num_endpts, output_megabits);
+			if (ret != 0)
+				D_GOTO(cleanup, ret);
+			continue;
+		}
+
 		ret = test_msg_size(crt_ctx, ms_endpts, num_ms_endpts,
 				    &test_params, latencies, latencies_bulk_hdl,
-				    output_megabits);
+				    output_megabits, false);
 		if (ret != 0) {
 			D_ERROR("Testing message size (%d-%s %d-%s) failed;"
 				" ret = %d\n",
@@ -1242,10 +1539,33 @@ static void print_usage(const char *prog_name, const char *msg_sizes_str,
 	       "         - CRT_PHY_ADDR_STR\n"
 	       "         - CRT_CTX_SHARE_ADDR\n"
 	       "         - OFI_DOMAIN\n"
-	       "         - CRT_TIMEOUT\n",
+	       "         - CRT_TIMEOUT\n"
+	       "\n"
+	       "  --matrix\n"
+	       "      Short version: -x\n"
+	       "      All-to-all mode. Each rank of the --endpoint list in turn acts as the\n"
+	       "        master endpoint and tests every other rank of the list, one link at\n"
+	       "        a time, against all the tags given for that rank (i.e. several\n"
+	       "        concurrent contexts). Median latency and bandwidth are reported as a\n"
+	       "        rank x rank matrix for each message size, followed by the outlier\n"
+	       "        links. --master-endpoint is ignored in this mode\n"
+	       "\n"
+	       "  --outlier-factor <F>\n"
+	       "      Short version: -o\n"
+	       "      In matrix mode, a link is reported as an outlier if its median latency\n"
+	       "        is more than F times the median of all links, its bandwidth is less\n"
+	       "        than the median divided by F, or if any of its RPCs failed\n"
+	       "      Default: 2.0\n"
+	       "\n"
+	       "  --size-sweep <min:max>\n"
+	       "      Short version: -w\n"
+	       "      Replaces --message-sizes by all the powers of two (and 0) between min\n"
+	       "        and max, with the same size sent and replied. The transport is chosen\n"
+	       "        automatically, so the sweep crosses from IOV to bulk at %u bytes\n",
 	       prog_name, UINT32_MAX,
 	       CRT_SELF_TEST_AUTO_BULK_THRESH, msg_sizes_str, rep_count,
-	       max_inflight, CRT_ST_BUF_ALIGN_MIN, CRT_ST_BUF_ALIGN_MIN);
+	       max_inflight, CRT_ST_BUF_ALIGN_MIN, CRT_ST_BUF_ALIGN_MIN,
+	       CRT_SELF_TEST_AUTO_BULK_THRESH);
 }
 
 #define ST_ENDPT_RANK_IDX 0
@@ -1681,6 +2001,43 @@ int parse_message_sizes_string(const char *pch,
 	return 0;
 }
 
+/*
+ * Fill all_params with the sizes of a --size-sweep, returns the number of
+ * sizes or a negative error. all_params is NULL to only count them.
+ */
+static int
+st_sweep_sizes(uint32_t min_size, uint32_t max_size,
+	       struct st_size_params *all_params)
+{
+	char		size_str[16];
+	uint64_t	size;
+	int		num = 0;
+	int		ret;
+
+	if (min_size == 0) {
+		if (all_params != NULL) {
+			ret = parse_message_sizes_string("0", &all_params[num]);
+			if (ret != 0)
+				return ret;
+		}
+		num++;
+		min_size = 1;
+	}
+
+	for (size = min_size; size <= max_size; size *= 2) {
+		if (all_params != NULL) {
+			snprintf(size_str, sizeof(size_str), "%lu", size);
+			ret = parse_message_sizes_string(size_str,
+							 &all_params[num]);
+			if (ret != 0)
+				return ret;
+		}
+		num++;
+	}
+
+	return num;
+}
+
 int main(int argc, char *argv[])
 {
 	/* Default parameters */
@@ -1712,6 +2069,9 @@ int main(int argc, char *argv[])
 		CRT_ST_BUF_ALIGN_DEFAULT;
 	char				*attach_info_path = NULL;
 	bool				 use_daos_agent_vars = false;
+	uint32_t			 sweep_min = 0;
+	uint32_t			 sweep_max = 0;
+	bool				 sweep = false;
 
 	ret = d_log_init();
 	if (ret != 0) {
@@ -1734,10 +2094,13 @@ int main(int argc, char *argv[])
 			{"path", required_argument, 0, 'p'},
 			{"nopmix", no_argument, 0, 'n'},
 			{"use-daos-agent-env", no_argument, 0, 'u'},
+			{"matrix", no_argument, 0, 'x'},
+			{"outlier-factor", required_argument, 0, 'o'},
+			{"size-sweep", required_argument, 0, 'w'},
 			{0, 0, 0, 0}
 		};
 
-		c = getopt_long(argc, argv, "g:m:e:s:r:i:a:btnqp:u",
+		c = getopt_long(argc, argv, "g:m:e:s:r:i:a:btnqp:uxo:w:",
 				long_options, NULL);
 		if (c == -1)
 			break;
@@ -1797,6 +2160,26 @@ int main(int argc, char *argv[])
 		case 'q':
 			g_randomize_endpoints = true;
 			break;
+		case 'x':
+			g_matrix = true;
+			break;
+		case 'o':
+			ret = sscanf(optarg, "%lf", &g_outlier_factor);
+			if (ret != 1 || g_outlier_factor < 1.0) {
+				g_outlier_factor = 2.0;
+				printf("Warning: Invalid outlier-factor\n"
+				       "  Using default value %.2f instead\n",
+				       g_outlier_factor);
+			}
+			break;
+		case 'w':
+			ret = sscanf(optarg, "%u:%u", &sweep_min, &sweep_max);
+			if (ret != 2 || sweep_min > sweep_max) {
+				printf("Invalid size-sweep, expected min:max\n");
+				D_GOTO(cleanup, ret = -DER_INVAL);
+			}
+			sweep = true;
+			break;
 
 		/* 't' and 'n' options are deprecated */
 		case 't':
@@ -1819,6 +2202,17 @@ int main(int argc, char *argv[])
 	/* repeat rep_count for each endpoint */
 	rep_count = rep_count * num_endpts;
 
+	if (sweep) {
+		num_msg_sizes = st_sweep_sizes(sweep_min, sweep_max, NULL);
+		D_ALLOC_ARRAY(all_params, num_msg_sizes);
+		if (all_params == NULL)
+			D_GOTO(cleanup, ret = -DER_NOMEM);
+		ret = st_sweep_sizes(sweep_min, sweep_max, all_params);
+		if (ret < 0)
+			D_GOTO(cleanup, ret = -DER_INVAL);
+		goto validate;
+	}
+
 	/*
 	 * Count the number of tuple tokens (',') in the user-specified string
 	 * This gives an upper limit on the number of arguments the user passed
@@ -1887,14 +2281,20 @@ int main(int argc, char *argv[])
 		all_params = (struct st_size_params *)realloced_mem;
 	}
 
+validate:
 	/******************** Validate arguments ********************/
 	if (dest_name == NULL || crt_validate_grpid(dest_name) != 0) {
 		printf("--group-name argument not specified or is invalid\n");
 		D_GOTO(cleanup, ret = -DER_INVAL);
 	}
-	if (ms_endpts == NULL)
+	if (g_matrix && ms_endpts != NULL) {
+		printf("Warning: --master-endpoint is ignored in matrix mode\n");
+		D_FREE(ms_endpts);
+		num_ms_endpts = 0;
+	} else if (ms_endpts == NULL && !g_matrix) {
 		printf("Warning: No --master-endpoint specified; using this"
 		       " command line application as the master endpoint\n");
+	}
 	if (endpts == NULL || num_endpts == 0) {
 		printf("No endpoints specified\n");
 		D_GOTO(cleanup, ret = -DER_INVAL);
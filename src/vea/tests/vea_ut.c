@@ -956,8 +956,10 @@ ut_free_invalid_space(void **state)
 static void
 print_stats(struct vea_ut_args *args, bool verbose)
 {
-	struct vea_stat	stat;
-	int		rc;
+	struct vea_stat		stat;
+	struct vea_frag_stat	frag;
+	uint64_t		frags = 0;
+	int			rc, i;
 
 	rc = vea_query(args->vua_vsi, NULL, &stat);
 	assert_int_equal(rc, 0);
@@ -969,6 +971,20 @@ print_stats(struct vea_ut_args *args, bool verbose)
 		      stat.vs_frags_large, stat.vs_frags_small, stat.vs_frags_aging,
 		      stat.vs_resrv_hint, stat.vs_resrv_large, stat.vs_resrv_small);
 
+	rc = vea_query_frag(args->vua_vsi, &frag);
+	assert_int_equal(rc, 0);
+	print_message("frags:"DF_U64", largest:%u, frag_pct:%u\n",
+		      frag.vfs_frags, frag.vfs_largest, frag.vfs_frag_pct);
+
+	/* fragmentation stats should agree with the allocation stats */
+	assert_int_equal(frag.vfs_free_blks, stat.vs_free_transient);
+	assert_int_equal(frag.vfs_frags,
+			 stat.vs_frags_large + stat.vs_frags_small);
+	for (i = 0; i < VEA_FRAG_BKT_MAX; i++)
+		frags += frag.vfs_bkts[i];
+	assert_int_equal(frags, frag.vfs_frags);
+	assert_true(frag.vfs_frag_pct <= 100);
+
 	if (verbose)
 		vea_dump(args->vua_vsi, true);
 }
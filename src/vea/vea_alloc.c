@@ -276,6 +276,36 @@ cursor_next(struct vea_free_class *vfc, struct free_ext_cursor *cursor)
 	return cursor->fec_cur;
 }
 
+/*
+ * Find the smallest binned free extent which can satisfy @blk_cnt, prefer
+ * the idle one (at the tail of bin), otherwise take the oldest one.
+ */
+static struct vea_entry *
+bin_find(struct vea_free_class *vfc, uint32_t blk_cnt)
+{
+	struct vea_entry *entry;
+	d_list_t *bin;
+	uint64_t bmap;
+
+	if (blk_cnt > vfc->vfc_bin_cnt)
+		return NULL;
+
+	/* Skip the bins of smaller extents */
+	bmap = vfc->vfc_bin_bmap & ~((1ULL << (blk_cnt - 1)) - 1);
+	if (bmap == 0)
+		return NULL;
+
+	bin = &vfc->vfc_bins[__builtin_ctzll(bmap)];
+	D_ASSERT(!d_list_empty(bin));
+
+	entry = d_list_entry(bin->prev, struct vea_entry, ve_link);
+	if (!ext_is_idle(&entry->ve_ext))
+		entry = d_list_entry(bin->next, struct vea_entry, ve_link);
+
+	D_ASSERT(entry->ve_ext.vfe_blk_cnt >= blk_cnt);
+	return entry;
+}
+
 int
 reserve_small(struct vea_space_info *vsi, uint32_t blk_cnt,
 	      struct vea_resrvd_ext *resrvd)
@@ -289,6 +319,30 @@ reserve_small(struct vea_space_info *vsi, uint32_t blk_cnt,
 	if (blk_cnt > vsi->vsi_class.vfc_large_thresh)
 		return 0;
 
+	/*
+	 * Best fit from the bins for the smallest requests, the extents in
+	 * size classed LRUs are all larger than binned extents, so falling
+	 * back to the cursor will find a fit at first try.
+	 */
+	entry = bin_find(&vsi->vsi_class, blk_cnt);
+	if (entry != NULL) {
+		vfe.vfe_blk_off = entry->ve_ext.vfe_blk_off;
+		vfe.vfe_blk_cnt = blk_cnt;
+
+		rc = compound_alloc(vsi, &vfe, entry);
+		if (rc)
+			return rc;
+
+		resrvd->vre_blk_off = vfe.vfe_blk_off;
+		resrvd->vre_blk_cnt = blk_cnt;
+
+		inc_stats(vsi, STAT_RESRV_SMALL, 1);
+
+		D_DEBUG(DB_IO, "["DF_U64", %u]\n",
+			resrvd->vre_blk_off, resrvd->vre_blk_cnt);
+		return 0;
+	}
+
 	cursor = cursor_prepare(&vsi->vsi_class, blk_cnt);
 	D_ASSERT(cursor != NULL);
 
@@ -282,8 +282,9 @@ error:
  * 2. Reserve from the largest free extent if it isn't non-active (extent age
  *    isn't VEA_EXT_AGE_MAX), otherwise, divide it in half-and-half and resreve
  *    from the latter half. (vfc_heap)
- * 3. Search & reserve from a bunch of extent size classed LRUs in first fit
- *    policy, larger & older free extent has priority. (vfc_lrus)
+ * 3. Search & reserve from the bins of smallest free extents in best fit
+ *    policy, then from a bunch of extent size classed LRUs in first fit
+ *    policy, larger & older free extent has priority. (vfc_bins, vfc_lrus)
  * 4. Repeat the search in 3rd step to reserve an extent vector. (vsi_vec_tree)
  * 5. Fail reserve with ENOMEM if all above attempts fail.
  */
@@ -700,6 +701,53 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 	return 0;
 }
 
+static int
+count_free_frag(daos_handle_t ih, d_iov_t *key, d_iov_t *val, void *arg)
+{
+	struct vea_entry	*ve;
+	struct vea_frag_stat	*stat = arg;
+	uint32_t		 blk_cnt;
+	int			 bkt;
+
+	ve = (struct vea_entry *)val->iov_buf;
+	blk_cnt = ve->ve_ext.vfe_blk_cnt;
+	D_ASSERT(blk_cnt > 0);
+
+	stat->vfs_free_blks += blk_cnt;
+	stat->vfs_frags++;
+	if (blk_cnt > stat->vfs_largest)
+		stat->vfs_largest = blk_cnt;
+
+	bkt = 31 - __builtin_clz(blk_cnt);
+	if (bkt >= VEA_FRAG_BKT_MAX)
+		bkt = VEA_FRAG_BKT_MAX - 1;
+	stat->vfs_bkts[bkt]++;
+
+	return 0;
+}
+
+int
+vea_query_frag(struct vea_space_info *vsi, struct vea_frag_stat *stat)
+{
+	int	rc;
+
+	D_ASSERT(vsi != NULL);
+	if (stat == NULL)
+		return -DER_INVAL;
+
+	memset(stat, 0, sizeof(*stat));
+	rc = dbtree_iterate(vsi->vsi_free_btr, DAOS_INTENT_DEFAULT, false,
+			    count_free_frag, (void *)stat);
+	if (rc != 0)
+		return rc;
+
+	if (stat->vfs_free_blks != 0)
+		stat->vfs_frag_pct = 100 - (stat->vfs_largest * 100ULL) /
+					   stat->vfs_free_blks;
+
+	return 0;
+}
+
 int
 vea_flush(struct vea_space_info *vsi, bool force)
 {
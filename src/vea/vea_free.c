@@ -32,15 +32,21 @@ blkcnt_to_lru(struct vea_free_class *vfc, uint32_t blkcnt)
 	return &vfc->vfc_lrus[idx];
 }
 
+static inline bool
+blkcnt_is_binned(struct vea_free_class *vfc, uint32_t blkcnt)
+{
+	return blkcnt <= vfc->vfc_bin_cnt;
+}
+
 void
 free_class_remove(struct vea_space_info *vsi, struct vea_entry *entry)
 {
 	struct vea_free_class *vfc = &vsi->vsi_class;
+	uint32_t blkcnt = entry->ve_ext.vfe_blk_cnt;
 
 	if (entry->ve_in_heap) {
-		D_ASSERTF(entry->ve_ext.vfe_blk_cnt > vfc->vfc_large_thresh,
-			  "%u <= %u", entry->ve_ext.vfe_blk_cnt,
-			  vfc->vfc_large_thresh);
+		D_ASSERTF(blkcnt > vfc->vfc_large_thresh,
+			  "%u <= %u", blkcnt, vfc->vfc_large_thresh);
 		d_binheap_remove(&vfc->vfc_heap, &entry->ve_node);
 		entry->ve_in_heap = 0;
 		dec_stats(vsi, STAT_FRAGS_LARGE, 1);
@@ -48,19 +54,25 @@ free_class_remove(struct vea_space_info *vsi, struct vea_entry *entry)
 		dec_stats(vsi, STAT_FRAGS_SMALL, 1);
 	}
 	d_list_del_init(&entry->ve_link);
+
+	/* Clear the bit of bin if it becomes empty */
+	if (blkcnt_is_binned(vfc, blkcnt) &&
+	    d_list_empty(&vfc->vfc_bins[blkcnt - 1]))
+		vfc->vfc_bin_bmap &= ~(1ULL << (blkcnt - 1));
 }
 
 int
 free_class_add(struct vea_space_info *vsi, struct vea_entry *entry)
 {
 	struct vea_free_class *vfc = &vsi->vsi_class;
+	uint32_t blkcnt = entry->ve_ext.vfe_blk_cnt;
 	int rc;
 
 	D_ASSERT(entry->ve_in_heap == 0);
 	D_ASSERT(d_list_empty(&entry->ve_link));
 
 	/* Add to heap if it's a large free extent */
-	if (entry->ve_ext.vfe_blk_cnt > vfc->vfc_large_thresh) {
+	if (blkcnt > vfc->vfc_large_thresh) {
 		rc = d_binheap_insert(&vfc->vfc_heap, &entry->ve_node);
 		if (rc != 0) {
 			D_ERROR("Failed to insert heap: %d\n", rc);
@@ -69,11 +81,16 @@ free_class_add(struct vea_space_info *vsi, struct vea_entry *entry)
 
 		entry->ve_in_heap = 1;
 		inc_stats(vsi, STAT_FRAGS_LARGE, 1);
-	} else { /* Otherwise add to one of size categarized LRU */
+	} else { /* Otherwise add to one of size categarized LRU or bin */
 		struct vea_entry *cur;
 		d_list_t *lru_head, *tmp;
 
-		lru_head = blkcnt_to_lru(vfc, entry->ve_ext.vfe_blk_cnt);
+		if (blkcnt_is_binned(vfc, blkcnt)) {
+			lru_head = &vfc->vfc_bins[blkcnt - 1];
+			vfc->vfc_bin_bmap |= 1ULL << (blkcnt - 1);
+		} else {
+			lru_head = blkcnt_to_lru(vfc, blkcnt);
+		}
 
 		/* List is sorted by free extent age */
 		d_list_for_each_prev(tmp, lru_head) {
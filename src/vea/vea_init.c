@@ -26,6 +26,12 @@ destroy_free_class(struct vea_free_class *vfc)
 		D_FREE(vfc->vfc_sizes);
 		vfc->vfc_sizes = NULL;
 	}
+	vfc->vfc_bin_cnt = 0;
+	vfc->vfc_bin_bmap = 0;
+	if (vfc->vfc_bins) {
+		D_FREE(vfc->vfc_bins);
+		vfc->vfc_bins = NULL;
+	}
 	d_binheap_destroy_inplace(&vfc->vfc_heap);
 }
 
@@ -50,7 +56,7 @@ struct d_binheap_ops heap_ops = {
 int
 create_free_class(struct vea_free_class *vfc, struct vea_space_df *md)
 {
-	uint32_t max_blks, min_blks;
+	uint32_t max_blks, min_blks, bin_cnt;
 	int rc, i, lru_cnt, size;
 
 	rc = d_binheap_create_inplace(DBH_FT_NOLOCK, 0, NULL, &heap_ops,
@@ -105,6 +111,27 @@ create_free_class(struct vea_free_class *vfc, struct vea_space_df *md)
 		goto error;
 	}
 
+	/*
+	 * Free extents not larger than VEA_SMALL_EXT_KB are binned by exact
+	 * block count, they must not overlap with the smallest size class.
+	 */
+	bin_cnt = min((VEA_SMALL_EXT_KB << 10) / md->vsd_blk_sz, VEA_BIN_MAX);
+	if (bin_cnt >= min_blks)
+		bin_cnt = 0;
+
+	if (bin_cnt > 0) {
+		D_ASSERT(vfc->vfc_bins == NULL);
+		D_ALLOC_ARRAY(vfc->vfc_bins, bin_cnt);
+		if (vfc->vfc_bins == NULL) {
+			rc = -DER_NOMEM;
+			goto error;
+		}
+		for (i = 0; i < bin_cnt; i++)
+			D_INIT_LIST_HEAD(&vfc->vfc_bins[i]);
+	}
+	vfc->vfc_bin_cnt = bin_cnt;
+	vfc->vfc_bin_bmap = 0;
+
 	return 0;
 error:
 	destroy_free_class(vfc);
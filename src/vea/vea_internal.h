@@ -31,7 +31,7 @@ struct vea_entry {
 	 * of DBTREE_CLASS_IV
 	 */
 	struct vea_free_extent	ve_ext;
-	/* Link to one of vfc_lrus or vsi_agg_lru */
+	/* Link to one of vfc_lrus, vfc_bins or vsi_agg_lru */
 	d_list_t		ve_link;
 	/* Link to vfc_heap */
 	struct d_binheap_node	ve_node;
@@ -39,6 +39,8 @@ struct vea_entry {
 };
 
 #define VEA_LARGE_EXT_MB	64	/* Large extent threshold in MB */
+#define VEA_SMALL_EXT_KB	64	/* Binned small extent threshold in KB */
+#define VEA_BIN_MAX		64	/* Max number of small extent bins */
 #define VEA_HINT_OFF_INVAL	0	/* Invalid hint offset */
 #define VEA_MIGRATE_INTVL	10	/* Seconds */
 
@@ -52,7 +54,9 @@ struct free_ext_cursor {
 /*
  * Large free extents (>=VEA_LARGE_EXT_MB) are tracked in max a heap, small
  * free extents (< VEA_LARGE_EXT_MB) are tracked in size categorized LRUs
- * respectively.
+ * respectively, except the smallest ones (<= VEA_SMALL_EXT_KB), which are
+ * tracked in bins of exact block count, so that a free extent for the most
+ * common small allocations can be found with a single bitmap lookup.
  */
 struct vea_free_class {
 	/* Max heap for tracking the largest free extent */
@@ -75,6 +79,12 @@ struct vea_free_class {
 	 * from small extents.
 	 */
 	struct free_ext_cursor	*vfc_cursor;
+	/* How many bins for the smallest free extents, could be zero */
+	uint32_t		 vfc_bin_cnt;
+	/* Bins sorted by extent age, vfc_bins[i] holds extents of i + 1 blocks */
+	d_list_t		*vfc_bins;
+	/* Bit i is set when vfc_bins[i] isn't empty */
+	uint64_t		 vfc_bin_bmap;
 };
 
 enum {
@@ -71,6 +71,8 @@ struct evt_context {
 	int				 tc_creds_on:1;
 	/** cached number of bytes per entry */
 	uint32_t			 tc_inob;
+	/** evt_find() met uncommitted extents, see struct evt_vis_cache */
+	bool				 tc_vis_dirty;
 	/** cached tree feature bits (reduce PMEM access) */
 	uint64_t			 tc_feats;
 	/** memory instance (PMEM or DRAM) */
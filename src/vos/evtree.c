@@ -96,6 +96,8 @@ enum {
 static struct evt_policy_ops evt_ssof_pol_ops;
 static struct evt_policy_ops evt_sdist_pol_ops;
 static struct evt_policy_ops evt_sdist_even_pol_ops;
+static void evt_vis_cache_inval(void);
+
 /**
  * Tree policy table.
  * - Sorted by Start Offset(SSOF): it is the only policy for now.
@@ -496,6 +498,25 @@ evt_ent_list_cmp_visible(const void *p1, const void *p2)
 	return evt_ent_cmp(&le1->le_ent, &le2->le_ent, vis_cmp_mask);
 }
 
+/**
+ * Entries are collected in tree order, so they are often sorted already, e.g.
+ * for SSOF trees or when a fetch only covers a few extents. Check that with
+ * one linear pass before paying for qsort.
+ */
+static void
+evt_ent_list_sort(struct evt_list_entry *ents, int nr,
+		  int (*compar)(const void *, const void *))
+{
+	int	i;
+
+	for (i = 1; i < nr; i++) {
+		if (compar(&ents[i - 1], &ents[i]) > 0)
+			break;
+	}
+	if (i < nr)
+		qsort(ents, nr, sizeof(ents[0]), compar);
+}
+
 static inline struct evt_list_entry *
 evt_array_link2le(d_list_t *link)
 {
@@ -996,8 +1017,7 @@ evt_ent_array_sort(struct evt_context *tcx, struct evt_entry_array *ent_array,
 		ents = ent_array->ea_ents;
 
 		/* Sort the array first */
-		qsort(ents, ent_array->ea_ent_nr, sizeof(ents[0]),
-		      evt_ent_list_cmp);
+		evt_ent_list_sort(ents, ent_array->ea_ent_nr, evt_ent_list_cmp);
 
 		/* Now separate entries into covered and visible */
 		rc = evt_find_visible(tcx, filter, ent_array, &num_visible,
@@ -1023,7 +1043,7 @@ re_sort:
 	}
 
 	if (ent_array->ea_ent_nr != 1)
-		qsort(ents, ent_array->ea_ent_nr, sizeof(ents[0]), compar);
+		evt_ent_list_sort(ents, ent_array->ea_ent_nr, compar);
 
 	ent_array->ea_ent_nr = total;
 
@@ -2121,6 +2141,7 @@ evt_insert(daos_handle_t toh, const struct evt_entry_in *entry,
 	if (tcx == NULL)
 		return -DER_NO_HDL;
 
+	evt_vis_cache_inval();
 	if (tcx->tc_inob && entry->ei_inob && tcx->tc_inob != entry->ei_inob) {
 		D_ERROR("Variable record size not supported in evtree:"
 			" %d != %d\n", entry->ei_inob, tcx->tc_inob);
@@ -2514,6 +2535,11 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 			desc = evt_node_desc_at(tcx, node, i);
 			rc = evt_desc_log_status(tcx, rtmp.rc_epc, desc,
 						 intent);
+			/* Visibility may change when the DTX is resolved */
+			if (rc != ALB_AVAILABLE_CLEAN ||
+			    desc->dc_dtx != DTX_LID_COMMITTED)
+				tcx->tc_vis_dirty = true;
+
 			/* Skip the unavailable record. */
 			if (rc == ALB_UNAVAILABLE)
 				continue;
@@ -2652,6 +2678,130 @@ struct evt_max_rect {
 	bool			mr_punched;
 };
 
+/** Number of cached evt_find() results per xstream, must be power of 2 */
+#define EVT_VIS_CACHE_SIZE	128
+/** Maximum number of visible extents of a cached result */
+#define EVT_VIS_CACHE_ENT_MAX	8
+
+struct evt_vis_cache_entry {
+	/** tree of the cached result, NULL for empty slot */
+	struct evt_root		*vce_root;
+	/** value of vtl_evt_vis_gen when the result was cached */
+	uint64_t		 vce_gen;
+	struct evt_filter	 vce_filter;
+	uint32_t		 vce_nr;
+	struct evt_entry	 vce_ents[EVT_VIS_CACHE_ENT_MAX];
+};
+
+/**
+ * Per-xstream cache of visible extents returned by evt_find(). Reading the
+ * same range of an akey again skips collecting, sorting and splitting the
+ * overlapped extents.
+ *
+ * Only results that consist of committed extents are cached, so they do not
+ * depend on DTX state or on the reader. Any change to any evtree on the
+ * xstream bumps vos_tls::vtl_evt_vis_gen, which invalidates all cached
+ * results.
+ */
+struct evt_vis_cache {
+	struct evt_vis_cache_entry	vc_ents[EVT_VIS_CACHE_SIZE];
+};
+
+bool evt_vis_cache_enabled = true;
+
+static void
+evt_vis_cache_inval(void)
+{
+	struct vos_tls	*tls = vos_tls_get();
+
+	if (tls != NULL)
+		tls->vtl_evt_vis_gen++;
+}
+
+static struct evt_vis_cache_entry *
+evt_vis_cache_slot(struct evt_vis_cache *cache, struct evt_context *tcx,
+		   const struct evt_filter *filter)
+{
+	uint64_t	key[4];
+	uint64_t	hash;
+
+	key[0] = (uint64_t)tcx->tc_root;
+	key[1] = filter->fr_ex.ex_lo;
+	key[2] = filter->fr_ex.ex_hi;
+	key[3] = filter->fr_epoch;
+	hash = d_hash_murmur64((unsigned char *)key, sizeof(key), 0);
+
+	return &cache->vc_ents[hash & (EVT_VIS_CACHE_SIZE - 1)];
+}
+
+static bool
+evt_filter_equal(const struct evt_filter *f1, const struct evt_filter *f2)
+{
+	return f1->fr_ex.ex_lo == f2->fr_ex.ex_lo &&
+	       f1->fr_ex.ex_hi == f2->fr_ex.ex_hi &&
+	       f1->fr_epr.epr_lo == f2->fr_epr.epr_lo &&
+	       f1->fr_epr.epr_hi == f2->fr_epr.epr_hi &&
+	       f1->fr_epoch == f2->fr_epoch &&
+	       f1->fr_punch_epc == f2->fr_punch_epc &&
+	       f1->fr_punch_minor_epc == f2->fr_punch_minor_epc;
+}
+
+/** Fill \a ent_array from the cache, return true on hit */
+static bool
+evt_vis_cache_lookup(struct evt_context *tcx, const struct evt_filter *filter,
+		     struct evt_entry_array *ent_array)
+{
+	struct vos_tls			*tls = vos_tls_get();
+	struct evt_vis_cache_entry	*vce;
+	int				 i;
+
+	if (tls == NULL || tls->vtl_evt_vis_cache == NULL)
+		return false;
+
+	vce = evt_vis_cache_slot(tls->vtl_evt_vis_cache, tcx, filter);
+	if (vce->vce_root != tcx->tc_root ||
+	    vce->vce_gen != tls->vtl_evt_vis_gen ||
+	    !evt_filter_equal(&vce->vce_filter, filter) ||
+	    vce->vce_nr > ent_array->ea_size)
+		return false;
+
+	D_ASSERT(ent_array->ea_ent_nr == 0);
+	for (i = 0; i < vce->vce_nr; i++) {
+		ent_array->ea_ents[i].le_prev = NULL;
+		ent_array->ea_ents[i].le_ent = vce->vce_ents[i];
+	}
+	ent_array->ea_ent_nr = vce->vce_nr;
+	ent_array->ea_inob = tcx->tc_inob;
+
+	return true;
+}
+
+static void
+evt_vis_cache_insert(struct evt_context *tcx, const struct evt_filter *filter,
+		     struct evt_entry_array *ent_array)
+{
+	struct vos_tls			*tls = vos_tls_get();
+	struct evt_vis_cache_entry	*vce;
+	int				 i;
+
+	if (tls == NULL || ent_array->ea_ent_nr > EVT_VIS_CACHE_ENT_MAX)
+		return;
+
+	if (tls->vtl_evt_vis_cache == NULL) {
+		D_ALLOC_PTR(tls->vtl_evt_vis_cache);
+		if (tls->vtl_evt_vis_cache == NULL)
+			return;
+	}
+
+	vce = evt_vis_cache_slot(tls->vtl_evt_vis_cache, tcx, filter);
+	vce->vce_root = tcx->tc_root;
+	vce->vce_gen = tls->vtl_evt_vis_gen;
+	vce->vce_filter = *filter;
+	vce->vce_nr = ent_array->ea_ent_nr;
+	for (i = 0; i < vce->vce_nr; i++)
+		vce->vce_ents[i] = ent_array->ea_ents[i].le_ent;
+}
+
 /**
  * Find all versioned extents intercepting with the input rectangle \a rect
  * and return their data pointers.
@@ -2673,16 +2823,24 @@ evt_find(daos_handle_t toh, const struct evt_filter *filter,
 	if (tcx == NULL)
 		return -DER_NO_HDL;
 
+	if (evt_vis_cache_enabled &&
+	    evt_vis_cache_lookup(tcx, filter, ent_array))
+		return 0;
+
 	rect.rc_ex = filter->fr_ex;
 	rect.rc_epc = filter->fr_epoch;
 	rect.rc_minor_epc = EVT_MINOR_EPC_MAX;
 
+	tcx->tc_vis_dirty = false;
 	rc = evt_ent_array_fill(tcx, EVT_FIND_ALL, DAOS_INTENT_DEFAULT,
 				filter, &rect, ent_array);
 
 	if (rc == 0)
 		rc = evt_ent_array_sort(tcx, ent_array, filter, EVT_ITER_VISIBLE);
 
+	if (rc == 0 && evt_vis_cache_enabled && !tcx->tc_vis_dirty)
+		evt_vis_cache_insert(tcx, filter, ent_array);
+
 	return rc;
 }
 
@@ -2840,6 +2998,7 @@ evt_create(struct evt_root *root, uint64_t feats, unsigned int order,
 	if (rc != 0)
 		return rc;
 
+	evt_vis_cache_inval();
 	rc = evt_tx_begin(tcx);
 	if (rc != 0)
 		goto err;
@@ -2871,6 +3030,7 @@ evt_destroy(daos_handle_t toh)
 	if (tcx == NULL)
 		return -DER_NO_HDL;
 
+	evt_vis_cache_inval();
 	rc = evt_tx_begin(tcx);
 	if (rc != 0)
 		return rc;
@@ -3567,6 +3727,7 @@ evt_delete_internal(struct evt_context *tcx, const struct evt_rect *rect,
 	struct evt_filter	 filter = {0};
 	int			 rc;
 
+	evt_vis_cache_inval();
 	/* NB: This function presently only supports exact match on extent. */
 	evt_ent_array_init(ent_array, 1);
 
@@ -3639,6 +3800,8 @@ evt_remove_all(daos_handle_t toh, const struct evt_extent *ext,
 	if (tcx == NULL)
 		return -DER_NO_HDL;
 
+	evt_vis_cache_inval();
+
 	rect.rc_epc = filter.fr_epoch = filter.fr_epr.epr_hi = epr->epr_hi;
 	filter.fr_epr.epr_lo = epr->epr_lo;
 	rect.rc_ex = filter.fr_ex = *ext;
@@ -3832,6 +3995,7 @@ evt_drain(daos_handle_t toh, int *credits, bool *destroyed)
 	if (tcx == NULL)
 		return -DER_NO_HDL;
 
+	evt_vis_cache_inval();
 	if (credits) {
 		if (*credits <= 0)
 			return -DER_INVAL;
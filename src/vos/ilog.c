@@ -73,8 +73,8 @@ struct ilog_context {
 	struct ilog_desc_cbs		 ic_cbs;
 	/** umem offset of root pointer */
 	umem_off_t			 ic_root_off;
-	/** umem instance */
-	struct umem_instance		 ic_umm;
+	/** umem instance of the pool, it outlives any open or cached log */
+	struct umem_instance		*ic_umm;
 	/** ref count for iterator */
 	uint32_t			 ic_ref;
 	/** In pmdk transaction marker */
@@ -99,7 +99,7 @@ ilog_is_same_tx(struct ilog_context *lctx, const struct ilog_id *id, bool *same)
 	if (!cbs->dc_is_same_tx_cb)
 		return 0;
 
-	return cbs->dc_is_same_tx_cb(&lctx->ic_umm, id->id_tx_id, id->id_epoch, same,
+	return cbs->dc_is_same_tx_cb(lctx->ic_umm, id->id_tx_id, id->id_epoch, same,
 				     cbs->dc_is_same_tx_args);
 }
 
@@ -115,7 +115,7 @@ ilog_status_get(struct ilog_context *lctx, const struct ilog_id *id, uint32_t in
 	if (!cbs->dc_log_status_cb)
 		return ILOG_COMMITTED;
 
-	rc = cbs->dc_log_status_cb(&lctx->ic_umm, id->id_tx_id, id->id_epoch, intent,
+	rc = cbs->dc_log_status_cb(lctx->ic_umm, id->id_tx_id, id->id_epoch, intent,
 				   cbs->dc_log_status_args);
 
 	if ((intent == DAOS_INTENT_UPDATE || intent == DAOS_INTENT_PUNCH)
@@ -134,7 +134,7 @@ ilog_log_add(struct ilog_context *lctx, struct ilog_id *id)
 	if (!cbs->dc_log_add_cb)
 		return 0;
 
-	rc = cbs->dc_log_add_cb(&lctx->ic_umm, lctx->ic_root_off, &id->id_tx_id,
+	rc = cbs->dc_log_add_cb(lctx->ic_umm, lctx->ic_root_off, &id->id_tx_id,
 				id->id_epoch, cbs->dc_log_add_args);
 	if (rc != 0) {
 		D_ERROR("Failed to register incarnation log entry: "DF_RC"\n",
@@ -158,7 +158,7 @@ ilog_log_del(struct ilog_context *lctx, const struct ilog_id *id,
 	if (!cbs->dc_log_del_cb || !id->id_tx_id)
 		return 0;
 
-	rc = cbs->dc_log_del_cb(&lctx->ic_umm, lctx->ic_root_off, id->id_tx_id,
+	rc = cbs->dc_log_del_cb(lctx->ic_umm, lctx->ic_root_off, id->id_tx_id,
 				id->id_epoch, deregister, cbs->dc_log_del_args);
 	if (rc != 0) {
 		D_ERROR("Failed to deregister incarnation log entry: "DF_RC"\n",
@@ -228,7 +228,7 @@ ilog_tx_begin(struct ilog_context *lctx)
 	if (lctx->ic_in_txn)
 		return 0;
 
-	rc = umem_tx_begin(&lctx->ic_umm, NULL);
+	rc = umem_tx_begin(lctx->ic_umm, NULL);
 	if (rc != 0)
 		return rc;
 
@@ -248,7 +248,7 @@ ilog_tx_end(struct ilog_context *lctx, int rc)
 		goto done;
 
 	if (lctx->ic_ver_inc) {
-		rc = umem_tx_add_ptr(&lctx->ic_umm, &lctx->ic_root->lr_magic,
+		rc = umem_tx_add_ptr(lctx->ic_umm, &lctx->ic_root->lr_magic,
 				     sizeof(lctx->ic_root->lr_magic));
 		if (rc != 0) {
 			D_ERROR("Failed to add to undo log: "DF_RC"\n",
@@ -261,7 +261,7 @@ ilog_tx_end(struct ilog_context *lctx, int rc)
 
 done:
 	lctx->ic_in_txn = false;
-	return umem_tx_end(&lctx->ic_umm, rc);
+	return umem_tx_end(lctx->ic_umm, rc);
 }
 
 static inline bool
@@ -297,7 +297,7 @@ ilog_ctx_create(struct umem_instance *umm, struct ilog_root *root,
 
 	(*lctxp)->ic_root = root;
 	(*lctxp)->ic_root_off = umem_ptr2off(umm, root);
-	(*lctxp)->ic_umm = *umm;
+	(*lctxp)->ic_umm = umm;
 	(*lctxp)->ic_cbs = *cbs;
 	ilog_addref(*lctxp);
 	return 0;
@@ -342,7 +342,7 @@ ilog_ptr_set_full(struct ilog_context *lctx, void *dest, const void *src,
 		goto done;
 	}
 
-	rc = umem_tx_add_ptr(&lctx->ic_umm, dest, len);
+	rc = umem_tx_add_ptr(lctx->ic_umm, dest, len);
 	if (rc != 0) {
 		D_ERROR("Failed to add to undo log\n");
 		goto done;
@@ -362,7 +362,7 @@ ilog_create(struct umem_instance *umm, struct ilog_df *root)
 	struct ilog_context	lctx = {
 		.ic_root = (struct ilog_root *)root,
 		.ic_root_off = umem_ptr2off(umm, root),
-		.ic_umm = *umm,
+		.ic_umm = umm,
 		.ic_ref = 0,
 		.ic_in_txn = 0,
 	};
@@ -432,7 +432,7 @@ ilog_log2cache(struct ilog_context *lctx, struct ilog_array_cache *cache)
 		cache->ac_array = NULL;
 		cache->ac_nr = 0;
 	} else if (!lctx->ic_root->lr_tree.it_embedded) {
-		array = umem_off2ptr(&lctx->ic_umm, lctx->ic_root->lr_tree.it_root);
+		array = umem_off2ptr(lctx->ic_umm, lctx->ic_root->lr_tree.it_root);
 		cache->ac_array = array;
 		cache->ac_entries = &array->ia_id[0];
 		cache->ac_nr = array->ia_len;
@@ -451,7 +451,7 @@ ilog_destroy(struct umem_instance *umm,
 	struct ilog_context	lctx = {
 		.ic_root = (struct ilog_root *)root,
 		.ic_root_off = umem_ptr2off(umm, root),
-		.ic_umm = *umm,
+		.ic_umm = umm,
 		.ic_ref = 1,
 		.ic_cbs = *cbs,
 		.ic_in_txn = 0,
@@ -520,12 +520,12 @@ ilog_root_migrate(struct ilog_context *lctx, const struct ilog_id *id_in)
 		return rc;
 	}
 
-	tree_root = umem_zalloc(&lctx->ic_umm, ILOG_ARRAY_CHUNK_SIZE);
+	tree_root = umem_zalloc(lctx->ic_umm, ILOG_ARRAY_CHUNK_SIZE);
 
 	if (tree_root == UMOFF_NULL)
-		return lctx->ic_umm.umm_nospc_rc;
+		return lctx->ic_umm->umm_nospc_rc;
 
-	array = umem_off2ptr(&lctx->ic_umm, tree_root);
+	array = umem_off2ptr(lctx->ic_umm, tree_root);
 
 	lctx->ic_ver_inc = true;
 
@@ -688,7 +688,7 @@ reset_root(struct ilog_context *lctx, struct ilog_array_cache *cache, int i)
 		return rc;
 
 	if (tree != UMOFF_NULL)
-		return umem_free(&lctx->ic_umm, tree);
+		return umem_free(lctx->ic_umm, tree);
 
 	return 0;
 }
@@ -716,7 +716,7 @@ remove_entry(struct ilog_context *lctx, struct ilog_array_cache *cache, int i)
 	/** Just remove the entry at i */
 	array = cache->ac_array;
 	if (i + 1 != cache->ac_nr) {
-		rc = umem_tx_add_ptr(&lctx->ic_umm, &array->ia_id[i],
+		rc = umem_tx_add_ptr(lctx->ic_umm, &array->ia_id[i],
 				     sizeof(array->ia_id[0]) * (cache->ac_nr - i));
 		if (rc != 0)
 			return rc;
@@ -813,11 +813,11 @@ insert:
 		new_len = (cache.ac_nr + 1) * 2 - 1;
 		new_size = sizeof(*cache.ac_array) + sizeof(cache.ac_entries[0]) * new_len;
 		D_ASSERT((new_size & (ILOG_ARRAY_CHUNK_SIZE - 1)) == 0);
-		new_array = umem_zalloc(&lctx->ic_umm, new_size);
+		new_array = umem_zalloc(lctx->ic_umm, new_size);
 		if (new_array == UMOFF_NULL)
-			return lctx->ic_umm.umm_nospc_rc;
+			return lctx->ic_umm->umm_nospc_rc;
 
-		array = umem_off2ptr(&lctx->ic_umm, new_array);
+		array = umem_off2ptr(lctx->ic_umm, new_array);
 		array->ia_len = cache.ac_nr + 1;
 		array->ia_max_len = new_len;
 		if (i != 0) {
@@ -839,11 +839,11 @@ insert:
 		if (rc != 0)
 			return rc;
 
-		return umem_free(&lctx->ic_umm, umem_ptr2off(&lctx->ic_umm, cache.ac_array));
+		return umem_free(lctx->ic_umm, umem_ptr2off(lctx->ic_umm, cache.ac_array));
 	}
 
 	array = cache.ac_array;
-	rc = umem_tx_add_ptr(&lctx->ic_umm, &array->ia_id[i],
+	rc = umem_tx_add_ptr(lctx->ic_umm, &array->ia_id[i],
 			     sizeof(array->ia_id[0]) * (cache.ac_nr - i + 1));
 	if (rc != 0)
 		return rc;
@@ -1098,6 +1098,9 @@ ilog_status_refresh(struct ilog_context *lctx, uint32_t intent,
 	priv->ip_intent = intent;
 	priv->ip_rc = 0;
 	ilog_foreach_entry(entries, &entry) {
+		/** Persistent entries are committed under any intent */
+		if (entry.ie_id.id_tx_id == UMOFF_NULL)
+			continue;
 		if (same_intent &&
 		    (entry.ie_status == ILOG_COMMITTED ||
 		     entry.ie_status == ILOG_REMOVED))
@@ -1138,7 +1141,7 @@ ilog_fetch_cached(struct umem_instance *umm, struct ilog_root *root,
 reset:
 	lctx->ic_root = root;
 	lctx->ic_root_off = umem_ptr2off(umm, root);
-	lctx->ic_umm = *umm;
+	lctx->ic_umm = umm;
 	lctx->ic_cbs = *cbs;
 	lctx->ic_ref = 0;
 	lctx->ic_in_txn = false;
@@ -1469,7 +1472,7 @@ collapse_tree(struct ilog_context *lctx, struct ilog_array_cache *cache, struct
 		D_ASSERT(0);
 	}
 
-	rc = umem_tx_add_ptr(&lctx->ic_umm, array,
+	rc = umem_tx_add_ptr(lctx->ic_umm, array,
 			     sizeof(*array) + sizeof(array->ia_id[0]) * (cache->ac_nr - removed));
 	if (rc != 0)
 		return rc;
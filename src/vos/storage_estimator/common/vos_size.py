@@ -328,3 +328,31 @@ class MetaOverhead():
             self.calc_tree(stats, self.pools[pool])
 
         stats.pretty_print()
+        self.print_dram()
+
+    def print_dram(self):
+        """Estimate the DRAM needed by the busiest target to cache its
+        objects and open containers"""
+        if "obj_dram" not in self.meta:
+            return
+        obj_dram = int(self.meta.get("obj_dram"))
+        cont_dram = int(self.meta.get("cont_dram", 0))
+        cache_nr = int(self.meta.get("obj_cache_nr", 0))
+        obj_total = 0
+        cont_total = 0
+        for pool in self.pools:
+            num_objs = 0
+            for cont in pool["trees"]:
+                num_objs += cont["count"] * cont["dup"]
+            obj_size = min(num_objs, cache_nr) * obj_dram
+            cont_size = pool["count"] * cont_dram
+            if obj_size + cont_size > obj_total + cont_total:
+                obj_total = obj_size
+                cont_total = cont_size
+        total = obj_total + cont_total
+        if total == 0:
+            return
+        print("DRAM estimation per target:")
+        print_total("object cache", obj_total, total)
+        print_total("container", cont_total, total)
+        print("Total DRAM required per target: {0}".format(convert(total)))
@@ -0,0 +1,653 @@
+/**
+ * (C) Copyright 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Microbenchmark of the dbtree classes and of evtree.
+ *
+ * Each tree runs the same sequence of keys through insert, lookup and delete
+ * and reports per operation latency, hardware cache misses when perf events
+ * are available, and how full the tree nodes end up.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <math.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include <daos/common.h>
+#include <daos/btree.h>
+#include <daos/btree_class.h>
+#include <daos_srv/evtree.h>
+#include <daos/tests_lib.h>
+#include <utest_common.h>
+
+#define TP_KEYS_DEF	(1 << 20)
+#define TP_ORDER_DEF	16
+#define TP_THETA_DEF	0.99
+/* latency histogram, bucket N covers [2^N, 2^(N+1)) ns */
+#define TP_LAT_BUCKETS	40
+
+enum tp_tree {
+	TP_TREE_INT,
+	TP_TREE_DIRECT,
+	TP_TREE_HASH,
+	TP_TREE_EVT,
+	TP_TREE_NR,
+};
+
+static const char *tp_tree_names[TP_TREE_NR] = {
+	[TP_TREE_INT]		= "int",
+	[TP_TREE_DIRECT]	= "direct",
+	[TP_TREE_HASH]		= "hash",
+	[TP_TREE_EVT]		= "evt",
+};
+
+enum tp_dist {
+	TP_DIST_SEQ,
+	TP_DIST_UNIFORM,
+	TP_DIST_ZIPF,
+};
+
+static const char *tp_dist_names[] = {
+	[TP_DIST_SEQ]		= "seq",
+	[TP_DIST_UNIFORM]	= "uniform",
+	[TP_DIST_ZIPF]		= "zipf",
+};
+
+enum tp_op {
+	TP_OP_INSERT,
+	TP_OP_LOOKUP,
+	TP_OP_DELETE,
+	TP_OP_NR,
+};
+
+static const char *tp_op_names[TP_OP_NR] = {
+	[TP_OP_INSERT]		= "insert",
+	[TP_OP_LOOKUP]		= "lookup",
+	[TP_OP_DELETE]		= "delete",
+};
+
+struct tp_stats {
+	uint64_t	ts_hist[TP_LAT_BUCKETS];
+	uint64_t	ts_ops;
+	uint64_t	ts_miss;	/* key not found */
+	uint64_t	ts_lat_sum;	/* ns */
+	uint64_t	ts_cache_miss;
+};
+
+static unsigned int	 tp_keys = TP_KEYS_DEF;
+static unsigned int	 tp_order = TP_ORDER_DEF;
+static double		 tp_theta = TP_THETA_DEF;
+static enum tp_dist	 tp_dist = TP_DIST_UNIFORM;
+static char		*tp_pmem_file;
+static int		 tp_perf_fd = -1;
+
+static uint64_t		*tp_ins_keys;	/* keys of insert and delete */
+static uint64_t		*tp_look_keys;	/* keys of lookup */
+
+static inline uint64_t
+tp_now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/* Count hardware cache misses of this thread, if the PMU is accessible */
+static void
+tp_perf_init(void)
+{
+	struct perf_event_attr	attr = { 0 };
+
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	tp_perf_fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+	if (tp_perf_fd < 0)
+		D_PRINT("Cache miss counter unavailable: %s\n",
+			strerror(errno));
+}
+
+static void
+tp_perf_start(void)
+{
+	if (tp_perf_fd < 0)
+		return;
+	ioctl(tp_perf_fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(tp_perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static uint64_t
+tp_perf_stop(void)
+{
+	uint64_t	count = 0;
+
+	if (tp_perf_fd < 0)
+		return 0;
+	ioctl(tp_perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+	if (read(tp_perf_fd, &count, sizeof(count)) != sizeof(count))
+		return 0;
+	return count;
+}
+
+/* Spread the ranks of the zipfian distribution over the key space */
+static inline uint64_t
+tp_scramble(uint64_t rank)
+{
+	return d_hash_murmur64((unsigned char *)&rank, sizeof(rank), 0) %
+	       tp_keys;
+}
+
+/*
+ * Zipfian generator of "Quickly Generating Billion-Record Synthetic
+ * Databases" (Gray et al.), as used by YCSB.
+ */
+struct tp_zipf {
+	double	zf_alpha;
+	double	zf_zetan;
+	double	zf_eta;
+};
+
+static void
+tp_zipf_init(struct tp_zipf *zf, uint64_t n, double theta)
+{
+	double		zeta2 = 1.0 + pow(0.5, theta);
+	uint64_t	i;
+
+	zf->zf_zetan = 0;
+	for (i = 1; i <= n; i++)
+		zf->zf_zetan += 1.0 / pow((double)i, theta);
+
+	zf->zf_alpha = 1.0 / (1.0 - theta);
+	zf->zf_eta = (1.0 - pow(2.0 / n, 1.0 - theta)) /
+		     (1.0 - zeta2 / zf->zf_zetan);
+}
+
+static uint64_t
+tp_zipf_next(struct tp_zipf *zf, uint64_t n, double theta)
+{
+	double	u = (double)rand() / RAND_MAX;
+	double	uz = u * zf->zf_zetan;
+
+	if (uz < 1.0)
+		return 0;
+	if (uz < 1.0 + pow(0.5, theta))
+		return 1;
+	return (uint64_t)(n * pow(zf->zf_eta * u - zf->zf_eta + 1.0,
+				  zf->zf_alpha)) % n;
+}
+
+static void
+tp_gen_keys(uint64_t *keys, struct tp_zipf *zf)
+{
+	uint64_t	tmp;
+	unsigned int	i;
+	unsigned int	j;
+
+	for (i = 0; i < tp_keys; i++) {
+		switch (tp_dist) {
+		case TP_DIST_SEQ:
+			keys[i] = i;
+			break;
+		case TP_DIST_UNIFORM:
+			keys[i] = i;
+			/* Fisher-Yates shuffle, every key exactly once */
+			j = rand() % (i + 1);
+			tmp = keys[j];
+			keys[j] = keys[i];
+			keys[i] = tmp;
+			break;
+		case TP_DIST_ZIPF:
+			keys[i] = tp_scramble(tp_zipf_next(zf, tp_keys,
+							   tp_theta));
+			break;
+		}
+	}
+}
+
+static void
+tp_stats_record(struct tp_stats *ts, uint64_t start)
+{
+	uint64_t	lat = tp_now_ns() - start;
+	int		i = 0;
+
+	if (lat > 1)
+		i = 63 - __builtin_clzl(lat);
+	if (i >= TP_LAT_BUCKETS)
+		i = TP_LAT_BUCKETS - 1;
+
+	ts->ts_hist[i]++;
+	ts->ts_ops++;
+	ts->ts_lat_sum += lat;
+}
+
+static double
+tp_stats_quantile(struct tp_stats *ts, double q)
+{
+	uint64_t	rank = q * ts->ts_ops;
+	uint64_t	seen = 0;
+	double		lo;
+	int		i;
+
+	if (rank == 0)
+		rank = 1;
+
+	for (i = 0; i < TP_LAT_BUCKETS - 1; i++) {
+		if (seen + ts->ts_hist[i] >= rank)
+			break;
+		seen += ts->ts_hist[i];
+	}
+
+	lo = i == 0 ? 0 : (double)(1UL << i);
+	return lo + ((1UL << (i + 1)) - lo) * (rank - seen) /
+	       max(ts->ts_hist[i], 1UL);
+}
+
+static void
+tp_stats_print(enum tp_tree tree, enum tp_op op, struct tp_stats *ts)
+{
+	D_PRINT("%-6s %-6s ops %-9"PRIu64" miss %-9"PRIu64" avg %8.1f ns "
+		"p50 %8.1f p99 %8.1f ns", tp_tree_names[tree], tp_op_names[op],
+		ts->ts_ops, ts->ts_miss,
+		ts->ts_ops ? (double)ts->ts_lat_sum / ts->ts_ops : 0,
+		tp_stats_quantile(ts, 0.5), tp_stats_quantile(ts, 0.99));
+	if (tp_perf_fd >= 0)
+		D_PRINT(" cache-miss/op %.2f",
+			ts->ts_ops ? (double)ts->ts_cache_miss / ts->ts_ops :
+			0);
+	D_PRINT("\n");
+}
+
+static int
+tp_btr_run(enum tp_tree tree, struct utest_context *utx)
+{
+	struct tp_stats		 stats[TP_OP_NR] = { 0 };
+	struct btr_root		*root = utest_utx2root(utx);
+	struct btr_attr		 attr;
+	struct btr_stat		 stat;
+	daos_handle_t		 toh;
+	unsigned int		 class;
+	uint64_t		 feats;
+	uint64_t		 key;
+	uint64_t		 start;
+	d_iov_t			 key_iov;
+	d_iov_t			 val_iov;
+	unsigned int		 i;
+	int			 rc;
+
+	switch (tree) {
+	case TP_TREE_INT:
+		class = DBTREE_CLASS_IV;
+		feats = BTR_FEAT_UINT_KEY;
+		break;
+	case TP_TREE_DIRECT:
+		class = DBTREE_CLASS_IV;
+		feats = BTR_FEAT_DIRECT_KEY;
+		break;
+	default:
+		class = DBTREE_CLASS_KV;
+		feats = 0;
+		break;
+	}
+
+	rc = dbtree_create_inplace(class, feats, tp_order, utest_utx2uma(utx),
+				   root, &toh);
+	if (rc != 0) {
+		D_PRINT("Failed to create %s tree: "DF_RC"\n",
+			tp_tree_names[tree], DP_RC(rc));
+		return rc;
+	}
+
+	/* The value of DBTREE_CLASS_IV starts with the integer key */
+	d_iov_set(&key_iov, &key, sizeof(key));
+
+	tp_perf_start();
+	for (i = 0; i < tp_keys; i++) {
+		key = tp_ins_keys[i];
+		d_iov_set(&val_iov, &key, sizeof(key));
+		start = tp_now_ns();
+		rc = dbtree_update(toh, &key_iov, &val_iov);
+		if (rc != 0) {
+			D_PRINT("Insert failed: "DF_RC"\n", DP_RC(rc));
+			goto out;
+		}
+		tp_stats_record(&stats[TP_OP_INSERT], start);
+	}
+	stats[TP_OP_INSERT].ts_cache_miss = tp_perf_stop();
+
+	rc = dbtree_query(toh, &attr, &stat);
+	if (rc != 0)
+		goto out;
+
+	tp_perf_start();
+	for (i = 0; i < tp_keys; i++) {
+		key = tp_look_keys[i];
+		d_iov_set(&val_iov, NULL, 0);
+		start = tp_now_ns();
+		rc = dbtree_lookup(toh, &key_iov, &val_iov);
+		if (rc == -DER_NONEXIST)
+			stats[TP_OP_LOOKUP].ts_miss++;
+		else if (rc != 0)
+			goto out;
+		tp_stats_record(&stats[TP_OP_LOOKUP], start);
+	}
+	stats[TP_OP_LOOKUP].ts_cache_miss = tp_perf_stop();
+
+	tp_perf_start();
+	for (i = 0; i < tp_keys; i++) {
+		key = tp_ins_keys[i];
+		start = tp_now_ns();
+		rc = dbtree_delete(toh, BTR_PROBE_EQ, &key_iov, NULL);
+		/* duplicated keys of the sequence were deleted already */
+		if (rc == -DER_NONEXIST)
+			stats[TP_OP_DELETE].ts_miss++;
+		else if (rc != 0)
+			goto out;
+		tp_stats_record(&stats[TP_OP_DELETE], start);
+	}
+	stats[TP_OP_DELETE].ts_cache_miss = tp_perf_stop();
+	rc = 0;
+
+	for (i = 0; i < TP_OP_NR; i++)
+		tp_stats_print(tree, i, &stats[i]);
+	/* Records over the capacity of all the nodes, internal ones included */
+	D_PRINT("%-6s depth %u, nodes "DF_U64", records "DF_U64
+		", fill factor %.3f\n", tp_tree_names[tree], attr.ba_depth,
+		stat.bs_node_nr, stat.bs_rec_nr, stat.bs_node_nr == 0 ? 0 :
+		(double)stat.bs_rec_nr / (stat.bs_node_nr * attr.ba_order));
+out:
+	if (rc != 0)
+		D_PRINT("%s tree failed: "DF_RC"\n", tp_tree_names[tree],
+			DP_RC(rc));
+	dbtree_destroy(toh, NULL);
+	return rc;
+}
+
+static int
+tp_evt_bio_nofree(struct umem_instance *umm, struct evt_desc *desc,
+		  daos_size_t nob, void *args)
+{
+	/* records point to a fake address */
+	return 0;
+}
+
+static struct evt_desc_cbs	tp_evt_cbs = {
+	.dc_bio_free_cb		= tp_evt_bio_nofree,
+};
+
+static int
+tp_evt_run(struct utest_context *utx)
+{
+	struct tp_stats		 stats[TP_OP_NR] = { 0 };
+	struct evt_root		*root = utest_utx2root(utx);
+	struct evt_entry_in	 entry = { 0 };
+	struct evt_filter	 filter = { 0 };
+	struct evt_entry	 ent;
+	struct evt_rect		 rect;
+	daos_size_t		 used_before = 0;
+	daos_size_t		 used_after = 0;
+	daos_handle_t		 toh;
+	uint64_t		 start;
+	unsigned int		 depth;
+	unsigned int		 i;
+	int			 rc;
+
+	rc = evt_create(root, EVT_FEAT_DEFAULT, tp_order, utest_utx2uma(utx),
+			&tp_evt_cbs, &toh);
+	if (rc != 0) {
+		D_PRINT("Failed to create evtree: "DF_RC"\n", DP_RC(rc));
+		return rc;
+	}
+	utest_get_scm_used_space(utx, &used_before);
+
+	/*
+	 * One record per key, each update of the sequence at its own epoch so
+	 * that duplicated keys add versions as overwrites do.
+	 */
+	entry.ei_inob = 1;
+	bio_addr_set(&entry.ei_addr, DAOS_MEDIA_SCM, 0);
+	BIO_ADDR_SET_NOT_HOLE(&entry.ei_addr);
+
+	tp_perf_start();
+	for (i = 0; i < tp_keys; i++) {
+		entry.ei_rect.rc_ex.ex_lo = tp_ins_keys[i];
+		entry.ei_rect.rc_ex.ex_hi = tp_ins_keys[i];
+		entry.ei_rect.rc_epc = i + 1;
+		entry.ei_bound = i + 1;
+		start = tp_now_ns();
+		rc = evt_insert(toh, &entry, NULL);
+		if (rc != 0) {
+			D_PRINT("Insert failed: "DF_RC"\n", DP_RC(rc));
+			goto out;
+		}
+		tp_stats_record(&stats[TP_OP_INSERT], start);
+	}
+	stats[TP_OP_INSERT].ts_cache_miss = tp_perf_stop();
+	utest_get_scm_used_space(utx, &used_after);
+	depth = root->tr_depth;
+
+	filter.fr_epr.epr_hi = DAOS_EPOCH_MAX;
+	filter.fr_epoch = DAOS_EPOCH_MAX;
+	tp_perf_start();
+	for (i = 0; i < tp_keys; i++) {
+		EVT_ENT_ARRAY_SM_PTR(ent_array);
+
+		filter.fr_ex.ex_lo = tp_look_keys[i];
+		filter.fr_ex.ex_hi = tp_look_keys[i];
+		evt_ent_array_init(ent_array, 0);
+		start = tp_now_ns();
+		rc = evt_find(toh, &filter, ent_array);
+		if (rc == 0 && ent_array->ea_ent_nr == 0)
+			stats[TP_OP_LOOKUP].ts_miss++;
+		tp_stats_record(&stats[TP_OP_LOOKUP], start);
+		evt_ent_array_fini(ent_array);
+		if (rc != 0)
+			goto out;
+	}
+	stats[TP_OP_LOOKUP].ts_cache_miss = tp_perf_stop();
+
+	tp_perf_start();
+	for (i = 0; i < tp_keys; i++) {
+		rect.rc_ex.ex_lo = tp_ins_keys[i];
+		rect.rc_ex.ex_hi = tp_ins_keys[i];
+		rect.rc_epc = i + 1;
+		rect.rc_minor_epc = 0;
+		start = tp_now_ns();
+		rc = evt_delete(toh, &rect, &ent);
+		if (rc == -DER_ENOENT)
+			stats[TP_OP_DELETE].ts_miss++;
+		else if (rc != 0)
+			goto out;
+		tp_stats_record(&stats[TP_OP_DELETE], start);
+	}
+	stats[TP_OP_DELETE].ts_cache_miss = tp_perf_stop();
+	rc = 0;
+
+	for (i = 0; i < TP_OP_NR; i++)
+		tp_stats_print(TP_TREE_EVT, i, &stats[i]);
+	/* evtree has no node statistics, report the space per record */
+	D_PRINT("%-6s depth %u, "DF_U64" bytes per record\n",
+		tp_tree_names[TP_TREE_EVT], depth,
+		(used_after - used_before) / tp_keys);
+out:
+	if (rc != 0)
+		D_PRINT("evtree failed: "DF_RC"\n", DP_RC(rc));
+	evt_destroy(toh);
+	return rc;
+}
+
+static int
+tp_run(enum tp_tree tree)
+{
+	struct utest_context	*utx;
+	size_t			 root_size;
+	int			 rc;
+
+	root_size = max(sizeof(struct btr_root), sizeof(struct evt_root));
+	if (tp_pmem_file != NULL) {
+		unlink(tp_pmem_file);
+		rc = utest_pmem_create(tp_pmem_file,
+				       max(1ULL << 30, 1024ULL * tp_keys),
+				       root_size, &utx);
+	} else {
+		rc = utest_vmem_create(root_size, &utx);
+	}
+	if (rc != 0) {
+		D_PRINT("Failed to create memory pool: "DF_RC"\n", DP_RC(rc));
+		return rc;
+	}
+
+	if (tree == TP_TREE_EVT)
+		rc = tp_evt_run(utx);
+	else
+		rc = tp_btr_run(tree, utx);
+
+	utest_utx_destroy(utx);
+	return rc;
+}
+
+static void
+tp_usage(void)
+{
+	D_PRINT("tree_perf -- dbtree and evtree microbenchmark\n\n"
+		"-t tree  int, direct, hash, evt or all (default)\n"
+		"         int/direct: DBTREE_CLASS_IV with uint/direct keys\n"
+		"         hash: DBTREE_CLASS_KV with hashed keys\n"
+		"-d dist  Key distribution: seq, uniform (default) or zipf\n"
+		"-z theta Zipfian skew (default %.2f)\n"
+		"-n keys  Number of operations of each phase (default %u)\n"
+		"-o order Tree order (default %u)\n"
+		"-p file  Use a pmem pool file instead of volatile memory\n",
+		TP_THETA_DEF, TP_KEYS_DEF, TP_ORDER_DEF);
+}
+
+static struct option tp_ops[] = {
+	{ "tree",	required_argument,	NULL,	't'	},
+	{ "dist",	required_argument,	NULL,	'd'	},
+	{ "theta",	required_argument,	NULL,	'z'	},
+	{ "keys",	required_argument,	NULL,	'n'	},
+	{ "order",	required_argument,	NULL,	'o'	},
+	{ "pmem",	required_argument,	NULL,	'p'	},
+	{ "help",	no_argument,		NULL,	'h'	},
+	{ NULL,		0,			NULL,	0	},
+};
+
+int
+main(int argc, char **argv)
+{
+	struct tp_zipf	zf;
+	int		tree = -1;
+	int		i;
+	int		opt;
+	int		rc;
+
+	while ((opt = getopt_long(argc, argv, "t:d:z:n:o:p:h", tp_ops,
+				  NULL)) != -1) {
+		switch (opt) {
+		case 't':
+			for (tree = 0; tree < TP_TREE_NR; tree++)
+				if (strcmp(optarg, tp_tree_names[tree]) == 0)
+					break;
+			if (tree == TP_TREE_NR) {
+				if (strcmp(optarg, "all") != 0) {
+					tp_usage();
+					return -DER_INVAL;
+				}
+				tree = -1;
+			}
+			break;
+		case 'd':
+			for (i = 0; i < ARRAY_SIZE(tp_dist_names); i++)
+				if (strcmp(optarg, tp_dist_names[i]) == 0)
+					break;
+			if (i == ARRAY_SIZE(tp_dist_names)) {
+				tp_usage();
+				return -DER_INVAL;
+			}
+			tp_dist = i;
+			break;
+		case 'z':
+			tp_theta = atof(optarg);
+			break;
+		case 'n':
+			tp_keys = strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			tp_order = strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			tp_pmem_file = optarg;
+			break;
+		case 'h':
+			tp_usage();
+			return 0;
+		default:
+			tp_usage();
+			return -DER_INVAL;
+		}
+	}
+
+	if (tp_keys == 0 || tp_order < 3 ||
+	    (tp_dist == TP_DIST_ZIPF && (tp_theta <= 0 || tp_theta >= 1))) {
+		tp_usage();
+		return -DER_INVAL;
+	}
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc != 0)
+		return rc;
+
+	rc = dbtree_class_register(DBTREE_CLASS_IV,
+				   BTR_FEAT_UINT_KEY | BTR_FEAT_DIRECT_KEY,
+				   &dbtree_iv_ops);
+	if (rc != 0 && rc != -DER_EXIST)
+		goto out_debug;
+	rc = dbtree_class_register(DBTREE_CLASS_KV, 0, &dbtree_kv_ops);
+	if (rc != 0 && rc != -DER_EXIST)
+		goto out_debug;
+
+	D_ALLOC_ARRAY(tp_ins_keys, tp_keys);
+	D_ALLOC_ARRAY(tp_look_keys, tp_keys);
+	if (tp_ins_keys == NULL || tp_look_keys == NULL)
+		D_GOTO(out_keys, rc = -DER_NOMEM);
+
+	srand(time(NULL));
+	if (tp_dist == TP_DIST_ZIPF)
+		tp_zipf_init(&zf, tp_keys, tp_theta);
+	tp_gen_keys(tp_ins_keys, &zf);
+	tp_gen_keys(tp_look_keys, &zf);
+
+	tp_perf_init();
+	D_PRINT("Tree benchmark: %u keys, order %u, %s distribution\n",
+		tp_keys, tp_order, tp_dist_names[tp_dist]);
+
+	for (i = 0; i < TP_TREE_NR; i++) {
+		if (tree >= 0 && tree != i)
+			continue;
+		rc = tp_run(i);
+		if (rc != 0)
+			break;
+	}
+
+	if (tp_perf_fd >= 0)
+		close(tp_perf_fd);
+out_keys:
+	D_FREE(tp_look_keys);
+	D_FREE(tp_ins_keys);
+out_debug:
+	daos_debug_fini();
+	return rc;
+}
@@ -2761,6 +2761,37 @@ aggregate_34(void **state)
 	cleanup();
 }
 
+/*
+ * 'Hot only' aggregation merges overwritten large SV, and skips the cold
+ * object which has only few small overwrites.
+ */
+static void
+aggregate_35(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct agg_tst_dataset	 ds = { 0 };
+
+	ds.td_type = DAOS_IOD_SINGLE;
+	ds.td_recx_nr = 0;
+	ds.td_upd_epr.epr_lo = 1;
+	ds.td_upd_epr.epr_hi = 10;
+	ds.td_agg_epr.epr_lo = 0;
+	ds.td_agg_epr.epr_hi = 11;
+	ds.td_discard = false;
+
+	VERBOSE_MSG("Hot only aggregation on cold object\n");
+	ds.td_iod_size = AT_SV_IOD_SIZE_SMALL;
+	ds.td_expected_recs = 10;
+	aggregate_basic_lb(arg, &ds, 0, NULL, NULL, VOS_AGG_FL_HOT_ONLY);
+
+	VERBOSE_MSG("Hot only aggregation on hot object\n");
+	ds.td_iod_size = AT_SV_IOD_SIZE_LARGE;
+	ds.td_expected_recs = 1;
+	aggregate_basic_lb(arg, &ds, 0, NULL, NULL, VOS_AGG_FL_HOT_ONLY);
+
+	cleanup();
+}
+
 static int
 agg_tst_teardown(void **state)
 {
@@ -2829,6 +2860,8 @@ static const struct CMUnitTest aggregate_tests[] = {
 	  aggregate_33, NULL, agg_tst_teardown },
 	{ "VOS434: Selectively merging NVMe records",
 	  aggregate_34, NULL, agg_tst_teardown },
+	{ "VOS435: Hot only aggregation",
+	  aggregate_35, NULL, agg_tst_teardown },
 	{ "VOS401: Aggregate SV with confined epr",
 	  aggregate_1, NULL, agg_tst_teardown },
 	{ "VOS402: Aggregate SV with punch records",
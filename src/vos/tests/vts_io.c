@@ -1963,6 +1963,85 @@ io_fetch_hole(void **state)
 	assert_memory_equal(ground_truth, fetch_buf, 3 * 1024);
 }
 
+/*
+ * Fetch the same extents repeatedly, the repeated fetches can be served by
+ * the evtree visible extent cache, which must be invalidated by new updates.
+ */
+static void
+io_fetch_repeated(void **state)
+{
+	struct io_test_args	*arg = *state;
+	int			 rc = 0;
+	int			 i;
+	d_iov_t			 val_iov;
+	daos_key_t		 dkey;
+	daos_key_t		 akey;
+	daos_recx_t		 rex;
+	daos_iod_t		 iod;
+	d_sg_list_t		 sgl;
+	char			 dkey_buf[UPDATE_DKEY_SIZE];
+	char			 akey_buf[UPDATE_AKEY_SIZE];
+	char			 old_buf[1024];
+	char			 new_buf[1024];
+	char			 fetch_buf[1024];
+
+	memset(&iod, 0, sizeof(iod));
+	memset(&sgl, 0, sizeof(sgl));
+
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	vts_key_gen(&akey_buf[0], arg->akey_size, false, arg);
+	set_iov(&dkey, &dkey_buf[0], arg->ofeat & DAOS_OF_DKEY_UINT64);
+	set_iov(&akey, &akey_buf[0], arg->ofeat & DAOS_OF_AKEY_UINT64);
+
+	rex.rx_idx = 0;
+	rex.rx_nr = sizeof(old_buf);
+	iod.iod_type = DAOS_IOD_ARRAY;
+	iod.iod_size = 1;
+	iod.iod_name = akey;
+	iod.iod_recxs = &rex;
+	iod.iod_nr = 1;
+	sgl.sg_iovs = &val_iov;
+	sgl.sg_nr = 1;
+
+	dts_buf_render(&old_buf[0], sizeof(old_buf));
+	d_iov_set(&val_iov, &old_buf[0], sizeof(old_buf));
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, 1, 0, 0, &dkey, 1,
+			    &iod, NULL, &sgl);
+	assert_rc_equal(rc, 0);
+	inc_cntr(arg->ta_flags);
+
+	for (i = 0; i < 3; i++) {
+		memset(fetch_buf, 0, sizeof(fetch_buf));
+		d_iov_set(&val_iov, &fetch_buf[0], sizeof(fetch_buf));
+		rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, 1, 0, &dkey, 1,
+				   &iod, &sgl);
+		assert_rc_equal(rc, 0);
+		assert_memory_equal(old_buf, fetch_buf, sizeof(fetch_buf));
+	}
+
+	/* Overwrite the extent at epoch 3, the fetch at epoch 3 must see it */
+	memset(new_buf, 'n', sizeof(new_buf));
+	d_iov_set(&val_iov, &new_buf[0], sizeof(new_buf));
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, 3, 0, 0, &dkey, 1,
+			    &iod, NULL, &sgl);
+	assert_rc_equal(rc, 0);
+
+	memset(fetch_buf, 0, sizeof(fetch_buf));
+	d_iov_set(&val_iov, &fetch_buf[0], sizeof(fetch_buf));
+	rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, 3, 0, &dkey, 1, &iod,
+			   &sgl);
+	assert_rc_equal(rc, 0);
+	assert_memory_equal(new_buf, fetch_buf, sizeof(fetch_buf));
+
+	/* The old version is still visible at epoch 1 */
+	memset(fetch_buf, 0, sizeof(fetch_buf));
+	d_iov_set(&val_iov, &fetch_buf[0], sizeof(fetch_buf));
+	rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, 1, 0, &dkey, 1, &iod,
+			   &sgl);
+	assert_rc_equal(rc, 0);
+	assert_memory_equal(old_buf, fetch_buf, sizeof(fetch_buf));
+}
+
 static void
 io_pool_overflow_test(void **state)
 {
@@ -2494,6 +2573,8 @@ static const struct CMUnitTest io_tests[] = {
 		io_sgl_fetch, NULL, NULL},
 	{ "VOS208: Extent hole test",
 		io_fetch_hole, NULL, NULL},
+	{ "VOS209: Repeated fetch of the same extent test",
+		io_fetch_repeated, NULL, NULL},
 	{ "VOS220: 100K update/fetch/verify test",
 		io_multiple_dkey, NULL, NULL},
 	{ "VOS222: overwrite test",
@@ -16,6 +16,7 @@
 #include "evt_priv.h"
 
 unsigned int vos_agg_nvme_thresh = VOS_MW_NVME_THRESH;
+unsigned int vos_agg_tier_pct = VOS_AGG_TIER_PCT;
 
 /*
  * EV tree sorted iterator returns logical entry in extent start order, and
@@ -143,6 +144,13 @@ struct agg_merge_window {
 	uint16_t			 mw_csum_type;
 };
 
+/* Max number of objects aggregated by a VOS_AGG_FL_HOT_ONLY aggregation */
+#define VOS_AGG_HOT_MAX		8
+/* Min estimated reclaimed bytes per aggregated record of a hot object */
+#define VOS_AGG_HOT_SCORE	512
+/* Metadata overhead of an updated record, in bytes */
+#define VOS_AGG_REC_OVERHEAD	64
+
 struct vos_agg_param {
 	uint32_t		ap_credits_max; /* # of tight loops to yield */
 	uint32_t		ap_credits;	/* # of tight loops */
@@ -165,6 +173,15 @@ struct vos_agg_param {
 	bool			 ap_skip_akey;
 	bool			 ap_skip_dkey;
 	bool			 ap_skip_obj;
+	/* Only aggregate objects of partition ap_part among ap_part_nr */
+	uint32_t		 ap_part;
+	uint32_t		 ap_part_nr;
+	/* Records and visible records scanned in current object */
+	uint32_t		 ap_obj_recs;
+	uint32_t		 ap_obj_vis;
+	/* Hot objects to be aggregated for VOS_AGG_FL_HOT_ONLY */
+	daos_unit_oid_t		 ap_hot_oids[VOS_AGG_HOT_MAX];
+	uint32_t		 ap_hot_nr;
 };
 
 static int
@@ -239,16 +256,198 @@ need_aggregate(struct vos_agg_param *agg_param, vos_iter_entry_t *entry)
 	return entry->ie_last_update >= cont->vc_cont_df->cd_hae;
 }
 
+static inline bool
+vos_agg_obj_in_part(struct vos_agg_param *agg_param, daos_unit_oid_t *oid)
+{
+	uint64_t	hash;
+
+	if (agg_param->ap_part_nr <= 1)
+		return true;
+
+	hash = d_hash_murmur64((unsigned char *)&oid->id_pub,
+			       sizeof(oid->id_pub), 0);
+	return hash % agg_param->ap_part_nr == agg_param->ap_part;
+}
+
+static inline struct vos_agg_cost *
+vos_agg_cost_slot(struct vos_container *cont, daos_unit_oid_t *oid)
+{
+	uint64_t	hash;
+
+	hash = d_hash_murmur64((unsigned char *)&oid->id_pub,
+			       sizeof(oid->id_pub), oid->id_shard);
+	return &cont->vc_agg_cost[hash & (VOS_AGG_COST_NR - 1)];
+}
+
+void
+vos_agg_cost_update(struct vos_container *cont, daos_unit_oid_t oid,
+		    daos_size_t size)
+{
+	struct vos_agg_cost	*ac;
+	uint64_t		 bytes = size + VOS_AGG_REC_OVERHEAD;
+
+	if (cont->vc_agg_cost == NULL) {
+		/* Cost model is best effort, ignore allocation failure */
+		D_ALLOC_ARRAY(cont->vc_agg_cost, VOS_AGG_COST_NR);
+		if (cont->vc_agg_cost == NULL)
+			return;
+	}
+
+	ac = vos_agg_cost_slot(cont, &oid);
+	if (daos_unit_oid_compare(ac->ac_oid, oid) != 0) {
+		/* Age the resident object, replace it when it's colder */
+		if (ac->ac_upd_bytes > bytes) {
+			ac->ac_upd_bytes >>= 1;
+			return;
+		}
+		memset(ac, 0, sizeof(*ac));
+		ac->ac_oid = oid;
+	}
+
+	ac->ac_upd_bytes += bytes;
+	ac->ac_upd_cnt++;
+}
+
+/*
+ * Estimated bytes reclaimed per record visited by aggregating the object:
+ * the updated bytes times the reclaimable ratio found by last aggregation
+ * (1/2 if never aggregated), divided by the records to be scanned, which
+ * are the visible records left by last aggregation plus the new updates.
+ */
+static uint64_t
+vos_agg_cost_score(struct vos_agg_cost *ac)
+{
+	uint64_t	reclaim, io;
+
+	if (ac->ac_upd_cnt == 0)
+		return 0;
+
+	D_ASSERT(ac->ac_agg_recs >= ac->ac_agg_vis);
+	reclaim = ac->ac_agg_recs - ac->ac_agg_vis + 1;
+	io = ac->ac_agg_vis + ac->ac_upd_cnt;
+
+	return ac->ac_upd_bytes / io * reclaim / (ac->ac_agg_recs + 2);
+}
+
+/* Record what the aggregation found in the object, reset update stats */
+static void
+vos_agg_cost_done(struct vos_container *cont, struct vos_agg_param *agg_param)
+{
+	struct vos_agg_cost	*ac;
+
+	if (cont->vc_agg_cost == NULL || agg_param->ap_obj_recs == 0)
+		return;
+
+	ac = vos_agg_cost_slot(cont, &agg_param->ap_oid);
+	if (daos_unit_oid_compare(ac->ac_oid, agg_param->ap_oid) != 0) {
+		/* Don't evict an object with pending updates */
+		if (ac->ac_upd_cnt != 0)
+			return;
+		memset(ac, 0, sizeof(*ac));
+		ac->ac_oid = agg_param->ap_oid;
+	}
+
+	ac->ac_agg_recs = agg_param->ap_obj_recs;
+	ac->ac_agg_vis = min(agg_param->ap_obj_vis, agg_param->ap_obj_recs);
+	ac->ac_upd_bytes = 0;
+	ac->ac_upd_cnt = 0;
+
+	agg_param->ap_obj_recs = 0;
+	agg_param->ap_obj_vis = 0;
+}
+
+/* Select the hottest objects, in descending order of score */
+static uint32_t
+vos_agg_hot_select(struct vos_container *cont, daos_unit_oid_t *oids,
+		   uint32_t max)
+{
+	uint64_t	 scores[VOS_AGG_HOT_MAX];
+	uint64_t	 score;
+	uint32_t	 nr = 0;
+	int		 i, j;
+
+	D_ASSERT(max <= VOS_AGG_HOT_MAX);
+	if (cont->vc_agg_cost == NULL)
+		return 0;
+
+	for (i = 0; i < VOS_AGG_COST_NR; i++) {
+		score = vos_agg_cost_score(&cont->vc_agg_cost[i]);
+		if (score < VOS_AGG_HOT_SCORE)
+			continue;
+		if (nr == max && score <= scores[nr - 1])
+			continue;
+
+		j = nr < max ? nr++ : nr - 1;
+		for (; j > 0 && scores[j - 1] < score; j--) {
+			scores[j] = scores[j - 1];
+			oids[j] = oids[j - 1];
+		}
+		scores[j] = score;
+		oids[j] = cont->vc_agg_cost[i].ac_oid;
+	}
+
+	return nr;
+}
+
+bool
+vos_aggregate_hot(daos_handle_t coh)
+{
+	struct vos_container	*cont = vos_hdl2cont(coh);
+	int			 i;
+
+	if (cont->vc_agg_cost == NULL)
+		return false;
+
+	for (i = 0; i < VOS_AGG_COST_NR; i++) {
+		if (vos_agg_cost_score(&cont->vc_agg_cost[i]) >=
+		    VOS_AGG_HOT_SCORE)
+			return true;
+	}
+
+	return false;
+}
+
+static inline bool
+vos_agg_obj_is_hot(struct vos_agg_param *agg_param, daos_unit_oid_t *oid)
+{
+	uint32_t	i;
+
+	if (!(agg_param->ap_flags & VOS_AGG_FL_HOT_ONLY))
+		return true;
+
+	for (i = 0; i < agg_param->ap_hot_nr; i++) {
+		if (daos_unit_oid_compare(agg_param->ap_hot_oids[i], *oid) == 0)
+			return true;
+	}
+
+	return false;
+}
+
 static int
 vos_agg_obj(daos_handle_t ih, vos_iter_entry_t *entry,
 	    struct vos_agg_param *agg_param, unsigned int *acts)
 {
 	D_ASSERT(agg_param != NULL);
+	if (!vos_agg_obj_is_hot(agg_param, &entry->ie_oid)) {
+		*acts |= VOS_ITER_CB_SKIP;
+		agg_param->ap_skip_obj = true;
+		return 0;
+	}
+
+	if (!vos_agg_obj_in_part(agg_param, &entry->ie_oid)) {
+		/* Aggregated by another partition, don't touch its ilog */
+		*acts |= VOS_ITER_CB_SKIP;
+		agg_param->ap_skip_obj = true;
+		return 0;
+	}
+
 	if (daos_unit_oid_compare(agg_param->ap_oid, entry->ie_oid)) {
 		if (need_aggregate(agg_param, entry)) {
 			D_DEBUG(DB_EPC, "oid:"DF_UOID" vos agg starting\n",
 				DP_UOID(entry->ie_oid));
 			agg_param->ap_oid = entry->ie_oid;
+			agg_param->ap_obj_recs = 0;
+			agg_param->ap_obj_vis = 0;
 			reset_agg_pos(VOS_ITER_DKEY, agg_param);
 			reset_agg_pos(VOS_ITER_AKEY, agg_param);
 		} else {
@@ -868,6 +1067,26 @@ process_physical:
 }
 
 #define NOSPC_ERROR_INTVL	60	/* seconds */
+
+/* Block allocator hint for the aggregation I/O stream */
+static inline struct vea_hint_context *
+agg_hint(struct vos_object *obj)
+{
+	return obj->obj_cont->vc_hint_ctxt[VOS_IOS_AGGREGATION];
+}
+
+static inline uint16_t
+agg_media_select(struct vos_object *obj, daos_size_t size)
+{
+	struct vos_pool	*pool = vos_obj2pool(obj);
+
+	if (obj->obj_cont->vc_agg_scm_tier && pool->vp_vea_info != NULL &&
+	    size >= VOS_BLK_SZ / 2)
+		return DAOS_MEDIA_NVME;
+
+	return vos_media_select(pool, DAOS_IOD_ARRAY, size);
+}
+
 static int
 reserve_segment(struct vos_object *obj, struct agg_io_context *io,
 		daos_size_t size, bio_addr_t *addr)
@@ -877,7 +1096,7 @@ reserve_segment(struct vos_object *obj, struct agg_io_context *io,
 	int		rc;
 
 	memset(addr, 0, sizeof(*addr));
-	media = vos_media_select(vos_obj2pool(obj), DAOS_IOD_ARRAY, size);
+	media = agg_media_select(obj, size);
 
 	if (media == DAOS_MEDIA_SCM) {
 		off = vos_reserve_scm(obj->obj_cont, io->ic_rsrvd_scm, size);
@@ -895,7 +1114,7 @@ reserve_segment(struct vos_object *obj, struct agg_io_context *io,
 
 	D_ASSERT(media == DAOS_MEDIA_NVME);
 	rc = vos_reserve_blocks(obj->obj_cont, &io->ic_nvme_exts, size,
-				VOS_IOS_AGGREGATION, &off);
+				agg_hint(obj), &off);
 	if (rc == -DER_NOSPACE) {
 		now = daos_gettime_coarse();
 		if (now - obj->obj_cont->vc_agg_nospc_ts > NOSPC_ERROR_INTVL) {
@@ -973,6 +1192,9 @@ verify_and_recalc(struct bio_sglist *bsgl, struct evt_entry_in *ent_in,
 	args.cra_recalcs	= recalcs;
 	args.cra_seg_cnt	= recalc_seg_cnt;
 
+	if (vos_csum_recalc_copy(&args))
+		return 0;
+
 	vos_offload_exec(vos_csum_recalc_fn, &args);
 	if (args.cra_rc == -DER_CSUM)
 		bio_log_csum_err(vos_xsctxt_get());
@@ -1375,7 +1597,7 @@ insert_segments(daos_handle_t ih, struct agg_merge_window *mw,
 
 	/* Publish NVMe reservations */
 	rc = vos_publish_blocks(obj->obj_cont, &io->ic_nvme_exts, true,
-				VOS_IOS_AGGREGATION);
+				agg_hint(obj));
 	if (rc) {
 		D_ERROR("Publish NVMe extents error: "DF_RC"\n", DP_RC(rc));
 		goto abort;
@@ -1402,7 +1624,7 @@ cleanup_segments(daos_handle_t ih, struct agg_merge_window *mw, int rc)
 
 		if (!d_list_empty(&io->ic_nvme_exts))
 			vos_publish_blocks(obj->obj_cont, &io->ic_nvme_exts,
-					   false, VOS_IOS_AGGREGATION);
+					   false, agg_hint(obj));
 	}
 
 	/* Reset io context */
@@ -1447,7 +1669,8 @@ free_removal_records(struct agg_merge_window *mw, d_list_t *head, bool top)
 }
 
 static inline bool
-need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_size)
+need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_size,
+	   bool hole)
 {
 	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
 	struct vos_object	*obj = oiter->it_obj;
@@ -1455,10 +1678,12 @@ need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_si
 	uint16_t		 tgt_media;
 
 	D_ASSERT(lgc_cnt > 0 && seg_size > 0);
+	tgt_media = agg_media_select(obj, seg_size);
+	/* A single cold SCM extent is relocated to NVMe when SCM is low */
 	if (lgc_cnt == 1)
-		return false;
+		return !hole && src_media == DAOS_MEDIA_SCM &&
+		       tgt_media == DAOS_MEDIA_NVME;
 
-	tgt_media = vos_media_select(vos_obj2pool(obj), DAOS_IOD_ARRAY, seg_size);
 	/* Some data can be migrated from SCM to NVMe to alleviate SCM pressure */
 	if (src_media != tgt_media)
 		return true;
@@ -1534,7 +1759,8 @@ need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
 			return true;
 
 		if (i == 0 || (hole != bio_addr_is_hole(&phy_ent->pe_addr))) {
-			if (i && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize))
+			if (i && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize,
+					    hole))
 				return true;
 
 			src_media = phy_ent->pe_addr.ba_type;
@@ -1558,7 +1784,7 @@ need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
 		hole = bio_addr_is_hole(&phy_ent->pe_addr);
 	}
 
-	if (lgc_cnt && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize))
+	if (lgc_cnt && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize, hole))
 		return true;
 
 	clear_merge_window(mw);
@@ -2109,6 +2335,9 @@ vos_aggregate_pre_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 		rc = vos_agg_akey(ih, entry, agg_param, acts);
 		break;
 	case VOS_ITER_RECX:
+		agg_param->ap_obj_recs++;
+		if (entry->ie_vis_flags & VOS_VIS_FLAG_VISIBLE)
+			agg_param->ap_obj_vis++;
 		rc = vos_agg_ev(ih, entry, agg_param, acts);
 		if (rc == -DER_TX_RESTART) {
 			D_DEBUG(DB_EPC, "Restarting evtree aggregation\n");
@@ -2118,8 +2347,13 @@ vos_aggregate_pre_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 		}
 		/* fall through to check for abort */
 	case VOS_ITER_SINGLE:
-		if (type == VOS_ITER_SINGLE)
+		if (type == VOS_ITER_SINGLE) {
+			agg_param->ap_obj_recs++;
 			rc = vos_agg_sv(ih, entry, agg_param, acts);
+			/* The SV is kept if it isn't deleted */
+			if (rc == 0 && !(*acts & VOS_ITER_CB_DELETE))
+				agg_param->ap_obj_vis++;
+		}
 		if (rc == -DER_CSUM || rc == -DER_TX_BUSY || rc == -DER_NOSPACE) {
 			D_DEBUG(DB_EPC, "Abort value aggregation "DF_RC"\n",
 				DP_RC(rc));
@@ -2202,6 +2436,8 @@ vos_aggregate_post_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 			agg_param->ap_skip_obj = false;
 			break;
 		}
+		if (!agg_param->ap_discard)
+			vos_agg_cost_done(cont, agg_param);
 		rc = oi_iter_aggregate(ih, agg_param->ap_discard_obj);
 		break;
 	case VOS_ITER_DKEY:
@@ -2267,7 +2503,8 @@ enum {
 };
 
 static int
-aggregate_enter(struct vos_container *cont, int agg_mode, daos_epoch_range_t *epr)
+aggregate_enter(struct vos_container *cont, int agg_mode, daos_epoch_range_t *epr,
+		uint32_t part_nr)
 {
 	switch (agg_mode) {
 	default:
@@ -2302,6 +2539,15 @@ aggregate_enter(struct vos_container *cont, int agg_mode, daos_epoch_range_t *ep
 		cont->vc_epr_discard = *epr;
 		break;
 	case AGG_MODE_AGGREGATE:
+		/* Partitions of the same aggregation can run concurrently */
+		if (cont->vc_in_aggregation && part_nr > 1 &&
+		    cont->vc_agg_part_nr == part_nr &&
+		    cont->vc_epr_aggregation.epr_lo == epr->epr_lo &&
+		    cont->vc_epr_aggregation.epr_hi == epr->epr_hi) {
+			cont->vc_agg_part_cnt++;
+			break;
+		}
+
 		if (cont->vc_in_aggregation) {
 			D_ERROR(DF_CONT": Already in aggregation epr["DF_U64", "DF_U64"]\n",
 				DP_CONT(cont->vc_pool->vp_id, cont->vc_id),
@@ -2329,6 +2575,8 @@ aggregate_enter(struct vos_container *cont, int agg_mode, daos_epoch_range_t *ep
 
 		cont->vc_in_aggregation = 1;
 		cont->vc_epr_aggregation = *epr;
+		cont->vc_agg_part_cnt = 1;
+		cont->vc_agg_part_nr = part_nr;
 		break;
 	case AGG_MODE_OBJ_DISCARD:
 		if (cont->vc_in_discard) {
@@ -2368,6 +2616,11 @@ aggregate_exit(struct vos_container *cont, int agg_mode)
 		break;
 	case AGG_MODE_AGGREGATE:
 		D_ASSERT(cont->vc_in_aggregation);
+		D_ASSERT(cont->vc_agg_part_cnt > 0);
+		if (--cont->vc_agg_part_cnt != 0)
+			break;
+
+		cont->vc_agg_part_nr = 0;
 		cont->vc_in_aggregation = 0;
 		cont->vc_epr_aggregation.epr_lo = 0;
 		cont->vc_epr_aggregation.epr_hi = 0;
@@ -2397,14 +2650,40 @@ struct agg_data {
 	struct vos_iter_anchors	ad_anchors;
 };
 
+/*
+ * Extents covered by the aggregation epoch range are stable and not likely
+ * to be overwritten soon, relocate them from SCM to NVMe when SCM is low.
+ */
+static void
+agg_scm_tier_update(struct vos_container *cont)
+{
+	struct vos_pool		*pool = cont->vc_pool;
+	struct vos_pool_space	 vps;
+	bool			 tier = false;
+	int			 rc;
+
+	if (vos_agg_tier_pct != 0 && pool->vp_vea_info != NULL) {
+		rc = vos_space_query_cached(pool, &vps);
+		if (rc == 0)
+			tier = SCM_FREE(&vps) * 100 < SCM_TOTAL(&vps) * vos_agg_tier_pct;
+	}
+
+	if (tier != cont->vc_agg_scm_tier)
+		D_DEBUG(DB_EPC, DF_CONT": SCM tiering %s\n",
+			DP_CONT(pool->vp_id, cont->vc_id), tier ? "on" : "off");
+	cont->vc_agg_scm_tier = tier;
+}
+
 int
-vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
-	      bool (*yield_func)(void *arg), void *yield_arg, uint32_t flags)
+vos_aggregate_part(daos_handle_t coh, daos_epoch_range_t *epr, uint32_t part,
+		   uint32_t part_nr, bool (*yield_func)(void *arg),
+		   void *yield_arg, uint32_t flags)
 {
 	struct vos_container	*cont = vos_hdl2cont(coh);
 	struct agg_data		*ad;
 	int			 rc;
 
+	D_ASSERT(part_nr > 0 && part < part_nr);
 	D_ASSERT(epr != NULL);
 	D_ASSERTF(epr->epr_lo < epr->epr_hi && epr->epr_hi != DAOS_EPOCH_MAX,
 		  "epr_lo:"DF_U64", epr_hi:"DF_U64"\n",
@@ -2414,10 +2693,12 @@ vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	if (ad == NULL)
 		return -DER_NOMEM;
 
-	rc = aggregate_enter(cont, AGG_MODE_AGGREGATE, epr);
+	rc = aggregate_enter(cont, AGG_MODE_AGGREGATE, epr, part_nr);
 	if (rc)
 		goto free_agg_data;
 
+	agg_scm_tier_update(cont);
+
 	/* Set iteration parameters */
 	ad->ad_iter_param.ip_hdl = coh;
 	ad->ad_iter_param.ip_epr = *epr;
@@ -2440,6 +2721,18 @@ vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	ad->ad_agg_param.ap_yield_arg = yield_arg;
 	merge_window_init(&ad->ad_agg_param.ap_window);
 	ad->ad_agg_param.ap_flags = flags;
+	ad->ad_agg_param.ap_part = part;
+	ad->ad_agg_param.ap_part_nr = part_nr;
+	if (flags & VOS_AGG_FL_HOT_ONLY) {
+		ad->ad_agg_param.ap_hot_nr =
+			vos_agg_hot_select(cont, ad->ad_agg_param.ap_hot_oids,
+					   VOS_AGG_HOT_MAX);
+		D_DEBUG(DB_EPC, DF_CONT": Aggregate %u hot objects\n",
+			DP_CONT(cont->vc_pool->vp_id, cont->vc_id),
+			ad->ad_agg_param.ap_hot_nr);
+		if (ad->ad_agg_param.ap_hot_nr == 0)
+			goto exit;
+	}
 
 	ad->ad_iter_param.ip_flags |= VOS_IT_FOR_PURGE;
 	rc = vos_iterate(&ad->ad_iter_param, VOS_ITER_OBJ, true, &ad->ad_anchors,
@@ -2455,11 +2748,11 @@ vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	}
 
 	/*
-	 * Update HAE, when aggregating for snapshot deletion, the
-	 * @epr->epr_hi could be smaller than the HAE
+	 * A partition only covers part of the objects, HAE is updated by the
+	 * caller after all partitions are done, see vos_aggregate_hae_update.
 	 */
-	if (cont->vc_cont_df->cd_hae < epr->epr_hi)
-		cont->vc_cont_df->cd_hae = epr->epr_hi;
+	if (part_nr == 1 && !(flags & VOS_AGG_FL_HOT_ONLY))
+		vos_aggregate_hae_update(coh, epr->epr_hi);
 exit:
 	aggregate_exit(cont, AGG_MODE_AGGREGATE);
 
@@ -2472,6 +2765,27 @@ free_agg_data:
 	return rc;
 }
 
+int
+vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
+	      bool (*yield_func)(void *arg), void *yield_arg, uint32_t flags)
+{
+	return vos_aggregate_part(coh, epr, 0, 1, yield_func, yield_arg,
+				  flags);
+}
+
+void
+vos_aggregate_hae_update(daos_handle_t coh, daos_epoch_t epoch)
+{
+	struct vos_container	*cont = vos_hdl2cont(coh);
+
+	/*
+	 * Update HAE, when aggregating for snapshot deletion, the
+	 * @epr->epr_hi could be smaller than the HAE
+	 */
+	if (cont->vc_cont_df->cd_hae < epoch)
+		cont->vc_cont_df->cd_hae = epoch;
+}
+
 int
 vos_discard(daos_handle_t coh, daos_unit_oid_t *oidp, daos_epoch_range_t *epr,
 	    bool (*yield_func)(void *arg), void *yield_arg)
@@ -2504,7 +2818,7 @@ vos_discard(daos_handle_t coh, daos_unit_oid_t *oidp, daos_epoch_range_t *epr,
 		D_ASSERT(obj->obj_discard);
 	}
 
-	rc = aggregate_enter(cont, mode, epr);
+	rc = aggregate_enter(cont, mode, epr, 1);
 	if (rc != 0)
 		goto release_obj;
 
@@ -163,6 +163,7 @@ vos_bio_addr_free(struct vos_pool *pool, bio_addr_t *addr, daos_size_t nob)
 		blk_off = vos_byte2blkoff(addr->ba_off);
 		blk_cnt = vos_byte2blkcnt(nob);
 
+		bio_rcache_invalidate(pool->vp_io_ctxt, addr->ba_off, nob);
 		rc = vea_free(pool->vp_vea_info, blk_off, blk_cnt);
 		if (rc)
 			D_ERROR("Error on block ["DF_U64", %u] free. "DF_RC"\n",
@@ -204,7 +205,7 @@ vos_tx_publish(struct dtx_handle *dth, bool publish)
 
 		/** Function checks if list is empty */
 		rc = vos_publish_blocks(cont, &dru->dru_nvme,
-					publish, VOS_IOS_GENERIC);
+					publish, dru->dru_hint);
 		if (rc && publish)
 			return rc;
 	}
@@ -218,14 +219,77 @@ vos_tx_publish(struct dtx_handle *dth, bool publish)
 			return rc;
 	}
 
-	/** Handle the deferred NVMe cancellations */
+	/**
+	 * Handle the deferred NVMe cancellations, they could be reserved from
+	 * different hints, so leave the hints alone.
+	 */
 	if (!publish)
 		vos_publish_blocks(cont, &dth->dth_deferred_nvme,
-				   false, VOS_IOS_GENERIC);
+				   false, NULL);
 
 	return 0;
 }
 
+/*
+ * Report the ranges this xstream added to transactions since the previous
+ * VOS transaction commit, which may include GC or aggregation transactions.
+ */
+static void
+vos_tx_metrics_update(struct vos_pool *pool)
+{
+	struct vos_pool_metrics	*vpm = pool->vp_metrics;
+	struct umem_tx_stats	*reported;
+	struct umem_tx_stats	 stats;
+	uint64_t		 bytes;
+
+	if (vpm == NULL)
+		return;
+
+	reported = &vos_tls_get()->vtl_tx_reported;
+	umem_tx_stats_get(&stats);
+	bytes = stats.uts_add_bytes - reported->uts_add_bytes;
+	d_tm_inc_counter(vpm->vp_tx_metrics.vtm_commits, 1);
+	d_tm_inc_counter(vpm->vp_tx_metrics.vtm_adds,
+			 stats.uts_add_cnt - reported->uts_add_cnt);
+	d_tm_inc_counter(vpm->vp_tx_metrics.vtm_add_bytes, bytes);
+	d_tm_set_gauge(vpm->vp_tx_metrics.vtm_add_bytes_last, bytes);
+	*reported = stats;
+}
+
+static void
+vos_tx_metrics_init(struct vos_tx_metrics *vtm, const char *path, int tgt_id)
+{
+	int	rc;
+
+	rc = d_tm_add_metric(&vtm->vtm_commits, D_TM_COUNTER,
+			     "number of committed transactions", "tx",
+			     "%s/vos_tx/commits/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'commits' telemetry: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_adds, D_TM_COUNTER,
+			     "number of ranges added to transactions", "ranges",
+			     "%s/vos_tx/adds/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'adds' telemetry: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_add_bytes, D_TM_COUNTER,
+			     "bytes of ranges added to transactions", "bytes",
+			     "%s/vos_tx/add_bytes/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'add_bytes' telemetry: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_add_bytes_last, D_TM_GAUGE,
+			     "bytes added by the last transaction", "bytes",
+			     "%s/vos_tx/add_bytes_last/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'add_bytes_last' telemetry: "DF_RC
+		       "\n", DP_RC(rc));
+}
+
 int
 vos_tx_begin(struct dtx_handle *dth, struct umem_instance *umm)
 {
@@ -247,7 +311,7 @@ vos_tx_begin(struct dtx_handle *dth, struct umem_instance *umm)
 int
 vos_tx_end(struct vos_container *cont, struct dtx_handle *dth_in,
 	   struct vos_rsrvd_scm **rsrvd_scmp, d_list_t *nvme_exts,
-	   bool started, int err)
+	   struct vea_hint_context *hint, bool started, int err)
 {
 	struct dtx_handle	*dth = dth_in;
 	struct dtx_rsrvd_uint	*dru;
@@ -268,6 +332,7 @@ vos_tx_end(struct vos_container *cont, struct dtx_handle *dth_in,
 		D_ASSERT(nvme_exts != NULL);
 		dru = &dth->dth_rsrvds[dth->dth_rsrvd_cnt++];
 		dru->dru_scm = *rsrvd_scmp;
+		dru->dru_hint = hint;
 		*rsrvd_scmp = NULL;
 
 		D_INIT_LIST_HEAD(&dru->dru_nvme);
@@ -290,6 +355,8 @@ vos_tx_end(struct vos_container *cont, struct dtx_handle *dth_in,
 		err = vos_tx_publish(dth, true);
 
 	err = umem_tx_end(vos_cont2umm(cont), err);
+	if (err == 0)
+		vos_tx_metrics_update(cont->vc_pool);
 
 cancel:
 	if (err != 0) {
@@ -346,6 +413,10 @@ vos_tls_fini(void *data)
 		gc_del_pool(pool);
 	}
 
+#ifndef VOS_STANDALONE
+	if (!d_list_empty(&tls->vtl_ocache_mem.mc_link))
+		dss_mem_cache_unregister(&tls->vtl_ocache_mem);
+#endif
 	if (tls->vtl_ocache)
 		vos_obj_cache_destroy(tls->vtl_ocache);
 
@@ -356,11 +427,32 @@ vos_tls_fini(void *data)
 		d_uhash_destroy(tls->vtl_cont_hhash);
 
 	umem_fini_txd(&tls->vtl_txd);
+	D_FREE(tls->vtl_evt_vis_cache);
 	if (tls->vtl_ts_table)
 		vos_ts_table_free(&tls->vtl_ts_table);
 	D_FREE(tls);
 }
 
+static uint64_t
+vos_ocache_mem_usage(void *arg)
+{
+	struct daos_lru_cache	*occ = arg;
+
+	return (uint64_t)occ->dlc_count * vos_obj_get_dram_size();
+}
+
+static uint64_t
+vos_ocache_mem_shrink(void *arg, uint64_t size)
+{
+	struct daos_lru_cache	*occ = arg;
+	uint64_t		 obj_size = vos_obj_get_dram_size();
+	uint32_t		 nr;
+
+	nr = min((size + obj_size - 1) / obj_size, occ->dlc_count);
+	nr = daos_lru_cache_shrink(occ, nr);
+	return (uint64_t)nr * obj_size;
+}
+
 static void *
 vos_tls_init(int xs_id, int tgt_id)
 {
@@ -372,7 +464,8 @@ vos_tls_init(int xs_id, int tgt_id)
 		return NULL;
 
 	D_INIT_LIST_HEAD(&tls->vtl_gc_pools);
-	rc = vos_obj_cache_create(LRU_CACHE_BITS, &tls->vtl_ocache);
+	D_INIT_LIST_HEAD(&tls->vtl_ocache_mem.mc_link);
+	rc = vos_obj_cache_create(vos_obj_cache_bits(), &tls->vtl_ocache);
 	if (rc) {
 		D_ERROR("Error in creating object cache\n");
 		goto failed;
@@ -407,9 +500,24 @@ vos_tls_init(int xs_id, int tgt_id)
 	}
 
 	if (tgt_id < 0)
-		/** skip sensor setup on standalone vos & sys xstream */
+		/**
+		 * skip sensor and DRAM cache setup on standalone vos, sys
+		 * xstreams and the main thread, which has no xstream
+		 */
 		return tls;
 
+	vos_ts_table_metrics_init(tls->vtl_ts_table, tgt_id);
+
+#ifndef VOS_STANDALONE
+	/* idle objects can always be reloaded, give them up first */
+	tls->vtl_ocache_mem.mc_name = "vos_obj_cache";
+	tls->vtl_ocache_mem.mc_prio = 0;
+	tls->vtl_ocache_mem.mc_usage = vos_ocache_mem_usage;
+	tls->vtl_ocache_mem.mc_shrink = vos_ocache_mem_shrink;
+	tls->vtl_ocache_mem.mc_arg = tls->vtl_ocache;
+	dss_mem_cache_register(xs_id, &tls->vtl_ocache_mem);
+#endif
+
 	rc = d_tm_add_metric(&tls->vtl_committed, D_TM_STATS_GAUGE,
 			     "Number of committed entries kept around for reply"
 			     " reconstruction", "entries",
@@ -418,6 +526,29 @@ vos_tls_init(int xs_id, int tgt_id)
 		D_WARN("Failed to create committed cnt sensor: "DF_RC"\n",
 		       DP_RC(rc));
 
+	rc = d_tm_add_metric(&tls->vtl_ocache_hit, D_TM_COUNTER,
+			     "Number of object lookups found in the object cache",
+			     "lookups", "vos/obj_cache/hit/tgt_%u", tgt_id);
+	if (rc)
+		D_WARN("Failed to create obj cache hit sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->vtl_ocache_miss, D_TM_COUNTER,
+			     "Number of object lookups not found in the object "
+			     "cache", "lookups", "vos/obj_cache/miss/tgt_%u",
+			     tgt_id);
+	if (rc)
+		D_WARN("Failed to create obj cache miss sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->vtl_ocache_evict, D_TM_COUNTER,
+			     "Number of objects evicted from the object cache "
+			     "to make room", "objects",
+			     "vos/obj_cache/evict/tgt_%u", tgt_id);
+	if (rc)
+		D_WARN("Failed to create obj cache evict sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
 	return tls;
 failed:
 	vos_tls_fini(tls);
@@ -489,6 +620,20 @@ vos_mod_init(void)
 	D_INFO("Set aggregate NVMe record threshold to %u blocks (blk_sz:%lu).\n",
 	       vos_agg_nvme_thresh, VOS_BLK_SZ);
 
+	d_getenv_int("DAOS_VOS_AGG_TIER", &vos_agg_tier_pct);
+	if (vos_agg_tier_pct > 50)
+		vos_agg_tier_pct = VOS_AGG_TIER_PCT;
+	D_INFO("Set aggregate SCM tiering threshold to %u%% free SCM.\n",
+	       vos_agg_tier_pct);
+
+	d_getenv_bool("DAOS_EVT_VIS_CACHE", &evt_vis_cache_enabled);
+	D_INFO("evtree visible extent cache is %s\n",
+	       evt_vis_cache_enabled ? "enabled" : "disabled");
+
+	d_getenv_bool("DAOS_VOS_BLOOM", &vos_obj_bloom_enabled);
+	D_INFO("Object key Bloom filter is %s\n",
+	       vos_obj_bloom_enabled ? "enabled" : "disabled");
+
 	return rc;
 }
 
@@ -501,7 +646,9 @@ vos_mod_fini(void)
 static inline int
 vos_metrics_count(void)
 {
-	return vea_metrics_count();
+	return vea_metrics_count() +
+	       sizeof(struct vos_gc_metrics) / sizeof(struct d_tm_node_t *) +
+	       sizeof(struct vos_tx_metrics) / sizeof(struct d_tm_node_t *);
 }
 
 static void
@@ -531,6 +678,9 @@ vos_metrics_alloc(const char *path, int tgt_id)
 		return NULL;
 	}
 
+	gc_metrics_init(&vp_metrics->vp_gc_metrics, path, tgt_id);
+	vos_tx_metrics_init(&vp_metrics->vp_tx_metrics, path, tgt_id);
+
 	return vp_metrics;
 }
 
@@ -92,6 +92,14 @@ cont_df_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 	cont_df = umem_off2ptr(&tins->ti_umm, offset);
 	uuid_copy(cont_df->cd_id, ukey->uuid);
 
+	if (vos_pool_has_obj_hints(pool)) {
+		cont_df->cd_obj_hints = umem_zalloc(&tins->ti_umm,
+						    sizeof(struct vea_hint_df) *
+						    VOS_OBJ_HINT_CNT);
+		if (UMOFF_IS_NULL(cont_df->cd_obj_hints))
+			D_GOTO(failed, rc = -DER_NOSPACE);
+	}
+
 	rc = dbtree_create_inplace_ex(VOS_BTR_OBJ_TABLE, 0, VOS_OBJ_ORDER,
 				      &pool->vp_uma, &cont_df->cd_obj_root,
 				      DAOS_HDL_INVAL, pool, &hdl);
@@ -107,6 +115,8 @@ cont_df_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 	return 0;
 failed:
 	/* Ignore umem_free failure. */
+	if (!UMOFF_IS_NULL(cont_df->cd_obj_hints))
+		umem_free(&tins->ti_umm, cont_df->cd_obj_hints);
 	umem_free(&tins->ti_umm, offset);
 	return rc;
 }
@@ -197,6 +207,12 @@ cont_free_internal(struct vos_container *cont)
 			vea_hint_unload(cont->vc_hint_ctxt[i]);
 	}
 
+	for (i = 0; i < VOS_OBJ_HINT_CNT; i++) {
+		if (cont->vc_obj_hint_ctxt[i])
+			vea_hint_unload(cont->vc_obj_hint_ctxt[i]);
+	}
+
+	D_FREE(cont->vc_agg_cost);
 	D_FREE(cont);
 }
 
@@ -310,6 +326,28 @@ exit:
 	return rc;
 }
 
+/* Load the object hints, containers created before them have none */
+static int
+cont_obj_hints_load(struct vos_container *cont)
+{
+	struct vea_hint_df	*hints;
+	int			 i;
+	int			 rc;
+
+	if (!vos_pool_has_obj_hints(cont->vc_pool) ||
+	    UMOFF_IS_NULL(cont->vc_cont_df->cd_obj_hints))
+		return 0;
+
+	hints = umem_off2ptr(vos_cont2umm(cont), cont->vc_cont_df->cd_obj_hints);
+	for (i = 0; i < VOS_OBJ_HINT_CNT; i++) {
+		rc = vea_hint_load(&hints[i], &cont->vc_obj_hint_ctxt[i]);
+		if (rc)
+			return rc;
+	}
+
+	return 0;
+}
+
 /**
  * Open a container within a VOSP
  */
@@ -429,6 +467,13 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 				goto exit;
 			}
 		}
+
+		rc = cont_obj_hints_load(cont);
+		if (rc) {
+			D_ERROR("Error loading allocator object hints "
+				DF_UUID": %d\n", DP_UUID(co_uuid), rc);
+			goto exit;
+		}
 	}
 
 	rc = vos_dtx_act_reindex(cont);
@@ -214,3 +214,78 @@ out:
 	args->cra_rc = rc;
 	return rc;
 }
+
+/*
+ * Fast path of the recalculation: when every input segment covers whole
+ * checksum chunks of its physical extent, and these are also whole chunks of
+ * the output segment, the output checksums are the input ones in order.
+ * Returns true if they were copied to the output entry, false if the full
+ * verification and recalculation is needed.
+ *
+ * The payload is still copied by aggregation but neither verified nor hashed
+ * again here. A corrupted input keeps its original checksum, so it is still
+ * detected on fetch and by the scrubber.
+ */
+bool
+vos_csum_recalc_copy(struct csum_recalc_args *args)
+{
+	struct evt_entry_in	*ent_in = args->cra_ent_in;
+	struct dcs_csum_info	*out = &ent_in->ei_csum;
+	unsigned int		 rec_size = ent_in->ei_inob;
+	unsigned int		 chunksize = out->cs_chunksize;
+	unsigned int		 first[args->cra_seg_cnt];
+	unsigned int		 nr[args->cra_seg_cnt];
+	unsigned int		 out_nr = 0;
+	int			 i;
+
+	if (chunksize == 0 || rec_size == 0 || out->cs_len == 0)
+		return false;
+
+	for (i = 0; i < args->cra_seg_cnt; i++) {
+		struct csum_recalc	*recalc = &args->cra_recalcs[i];
+		struct dcs_csum_info	*in = recalc->cr_phy_csum;
+		struct bio_iov		*biov = &args->cra_bsgl->bs_iovs[i];
+		daos_off_t		 lo = recalc->cr_log_ext.ex_lo;
+		daos_off_t		 hi = recalc->cr_log_ext.ex_hi;
+
+		/*
+		 * Checksums of an extent truncated by the previous window live
+		 * in the buffer being filled, and a widened segment only
+		 * covers part of a chunk.
+		 */
+		if (recalc->cr_phy_off != 0 || biov->bi_prefix_len != 0 ||
+		    biov->bi_suffix_len != 0)
+			return false;
+		if (in->cs_type != out->cs_type || in->cs_len != out->cs_len ||
+		    in->cs_chunksize != chunksize)
+			return false;
+
+		/* Inner segment boundaries must be output chunk boundaries. */
+		if (i > 0 && (lo * rec_size) % chunksize != 0)
+			return false;
+		if (i < args->cra_seg_cnt - 1 &&
+		    ((hi + 1) * rec_size) % chunksize != 0)
+			return false;
+
+		first[i] = lo * rec_size / chunksize -
+			   recalc->cr_phy_ext->ex_lo * rec_size / chunksize;
+		nr[i] = csum_chunk_count(chunksize, lo, hi, rec_size);
+		if (first[i] + nr[i] > in->cs_nr)
+			return false;
+		out_nr += nr[i];
+	}
+
+	if (out_nr != out->cs_nr)
+		return false;
+
+	for (out_nr = 0, i = 0; i < args->cra_seg_cnt; i++) {
+		struct dcs_csum_info *in = args->cra_recalcs[i].cr_phy_csum;
+
+		memcpy(&out->cs_csum[out_nr * out->cs_len],
+		       &in->cs_csum[first[i] * in->cs_len], nr[i] * in->cs_len);
+		out_nr += nr[i];
+	}
+	C_TRACE("Copied %u checksums of %u segments\n", out_nr, args->cra_seg_cnt);
+
+	return true;
+}
@@ -19,8 +19,15 @@ enum {
 	GC_CREDS_MIN	= 1,	/**< minimum credits for vos_gc_run/pool() */
 	GC_CREDS_PRIV	= 32,	/**< credits for internal usage */
 	GC_CREDS_MAX	= 4096,	/**< maximum credits for vos_gc_run/pool() */
+	GC_CREDS_BATCH	= 1024,	/**< maximum credits of a GC transaction */
 };
 
+/**
+ * If the GC ULT yielded longer than this (in microseconds), other ULTs are
+ * busy, shrink the GC transaction to give foreground I/O more chance to run.
+ */
+#define GC_YIELD_BUSY_US	1000
+
 /**
  * Default garbage bag size consumes <= 4K space
  * - header of vos_gc_bag_df is 64 bytes
@@ -287,12 +294,20 @@ gc_drain_cont(struct vos_gc *gc, struct vos_pool *pool, daos_handle_t coh,
 static int
 gc_free_cont(struct vos_gc *gc, struct vos_pool *pool, umem_off_t addr)
 {
-	int	rc;
+	struct vos_cont_df	*cont = umem_off2ptr(&pool->vp_umm, addr);
+	uuid_t			 co_uuid;
+	int			 rc;
 
-	rc = vos_dtx_table_destroy(&pool->vp_umm,
-				   umem_off2ptr(&pool->vp_umm, addr));
+	uuid_copy(co_uuid, cont->cd_id);
+	rc = vos_dtx_table_destroy(&pool->vp_umm, cont);
+	if (rc == 0 && vos_pool_has_obj_hints(pool) &&
+	    !UMOFF_IS_NULL(cont->cd_obj_hints))
+		rc = umem_free(&pool->vp_umm, cont->cd_obj_hints);
 	if (rc == 0)
 		rc = umem_free(&pool->vp_umm, addr);
+	if (rc == 0)
+		D_INFO("Space of destroyed container "DF_UUID" reclaimed\n",
+		       DP_UUID(co_uuid));
 
 	return rc;
 }
@@ -1071,6 +1086,114 @@ vos_gc_pool_tight(daos_handle_t poh, int *credits)
 	return 0;
 }
 
+static inline uint64_t
+gc_stat_sum(struct vos_gc_stat *stat)
+{
+	return stat->gs_conts + stat->gs_objs + stat->gs_dkeys +
+	       stat->gs_akeys + stat->gs_singvs + stat->gs_recxs;
+}
+
+/* Credits of next GC transaction, i.e. number of items reclaimed by it */
+static inline int
+gc_batch_creds(struct vos_pool *pool)
+{
+	if (pool->vp_gc_creds == 0)
+		pool->vp_gc_creds = GC_CREDS_PRIV;
+	return pool->vp_gc_creds;
+}
+
+/*
+ * Adjust the GC transaction size by how long the GC ULT has been yielding:
+ * other ULTs are busy if the yield takes long, halve the batch; otherwise
+ * there is no foreground load, double the batch to reclaim space faster
+ * with less transactions.
+ */
+static inline void
+gc_batch_adjust(struct vos_pool *pool, uint64_t yield_us)
+{
+	if (yield_us > GC_YIELD_BUSY_US)
+		pool->vp_gc_creds = max(pool->vp_gc_creds / 2, GC_CREDS_MIN);
+	else
+		pool->vp_gc_creds = min(pool->vp_gc_creds * 2, GC_CREDS_BATCH);
+}
+
+static void
+gc_update_metrics(struct vos_pool *pool, uint64_t reclaimed)
+{
+	struct vos_gc_metrics	*vgm;
+	struct vos_container	*cont;
+	struct vos_gc_bin_df	*bin;
+	struct vos_gc_bag_df	*bag;
+	umem_off_t		 off;
+	uint64_t		 bags;
+	uint64_t		 conts = 0;
+	int			 i;
+
+	if (pool->vp_metrics == NULL)
+		return;
+
+	vgm = &pool->vp_metrics->vp_gc_metrics;
+	d_tm_inc_counter(vgm->vgm_reclaimed, reclaimed);
+	d_tm_set_gauge(vgm->vgm_credits, pool->vp_gc_creds);
+
+	for (i = 0; i < GC_MAX; i++) {
+		bags = pool->vp_pool_df->pd_gc_bins[i].bin_bag_nr;
+		if (i < GC_CONT) {
+			d_list_for_each_entry(cont, &pool->vp_gc_cont,
+					      vc_gc_link)
+				bags += cont->vc_cont_df->cd_gc_bins[i].bin_bag_nr;
+		}
+		d_tm_set_gauge(vgm->vgm_bags[i], bags);
+	}
+
+	/* Each item of the pool container bin is a destroyed container */
+	bin = &pool->vp_pool_df->pd_gc_bins[GC_CONT];
+	for (off = bin->bin_bag_first; !UMOFF_IS_NULL(off);
+	     off = bag->bag_next) {
+		bag = umem_off2ptr(&pool->vp_umm, off);
+		conts += bag->bag_item_nr;
+	}
+	d_tm_set_gauge(vgm->vgm_conts, conts);
+}
+
+void
+gc_metrics_init(struct vos_gc_metrics *vgm, const char *path, int tgt_id)
+{
+	int	i, rc;
+
+	for (i = 0; i < GC_MAX; i++) {
+		rc = d_tm_add_metric(&vgm->vgm_bags[i], D_TM_GAUGE,
+				     "number of garbage bags", "bags",
+				     "%s/vos_gc/bags/%s/tgt_%u", path,
+				     gc_type2name(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create 'bags/%s' telemetry: "DF_RC"\n",
+			       gc_type2name(i), DP_RC(rc));
+	}
+
+	rc = d_tm_add_metric(&vgm->vgm_reclaimed, D_TM_COUNTER,
+			     "number of reclaimed items", "items",
+			     "%s/vos_gc/reclaimed/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create reclaimed telemetry: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&vgm->vgm_conts, D_TM_GAUGE,
+			     "number of destroyed containers being reclaimed",
+			     "containers", "%s/vos_gc/conts/tgt_%u", path,
+			     tgt_id);
+	if (rc)
+		D_WARN("Failed to create conts telemetry: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&vgm->vgm_credits, D_TM_GAUGE,
+			     "credits of GC transaction", "credits",
+			     "%s/vos_gc/credits/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create credits telemetry: "DF_RC"\n",
+		       DP_RC(rc));
+}
+
 static inline bool
 vos_gc_yield(bool (*yield_func)(void *arg), void *yield_arg)
 {
@@ -1088,6 +1211,8 @@ vos_gc_pool(daos_handle_t poh, int credits, bool (*yield_func)(void *arg),
 {
 	struct vos_pool	*pool = vos_hdl2pool(poh);
 	struct vos_tls	*tls  = vos_tls_get();
+	uint64_t	 reclaimed;
+	uint64_t	 start;
 	int		 rc = 0, total = 0;
 
 	D_ASSERT(daos_handle_is_valid(poh));
@@ -1099,9 +1224,10 @@ vos_gc_pool(daos_handle_t poh, int credits, bool (*yield_func)(void *arg),
 	}
 
 	tls->vtl_gc_running++;
+	reclaimed = gc_stat_sum(&pool->vp_gc_stat);
 
 	while (1) {
-		int	creds = GC_CREDS_PRIV;
+		int	creds = gc_batch_creds(pool);
 
 		if (credits > 0 && (credits - total) < creds)
 			creds = credits - total;
@@ -1119,12 +1245,16 @@ vos_gc_pool(daos_handle_t poh, int credits, bool (*yield_func)(void *arg),
 		if (credits > 0 && total >= credits)
 			break; /* consumed all credits */
 
+		start = daos_getutime();
 		if (vos_gc_yield(yield_func, yield_arg)) {
 			D_DEBUG(DB_TRACE, "GC pool run aborted\n");
 			break;
 		}
+		gc_batch_adjust(pool, daos_getutime() - start);
 	}
 
+	gc_update_metrics(pool, gc_stat_sum(&pool->vp_gc_stat) - reclaimed);
+
 	if (pool->vp_vea_info != NULL)
 		rc = vea_flush(pool->vp_vea_info, false);
 
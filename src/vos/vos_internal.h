@@ -106,10 +106,20 @@ enum {
  */
 #define VOS_MW_NVME_THRESH	256		/* 256 * VOS_BLK_SZ = 1MB */
 
+/*
+ * When free SCM drops below this percentage of total SCM, aggregation starts
+ * tiering: coalesced segments of at least VOS_BLK_SZ/2 are relocated to NVMe,
+ * including single extents that wouldn't be merged otherwise.
+ */
+#define VOS_AGG_TIER_PCT	10
+
 /* Force aggregation/discard ULT yield on certain amount of tight loops */
 #define VOS_AGG_CREDITS_MAX	32
 
 extern unsigned int vos_agg_nvme_thresh;
+extern unsigned int vos_agg_tier_pct;
+extern bool evt_vis_cache_enabled;
+extern bool vos_obj_bloom_enabled;
 
 static inline uint32_t vos_byte2blkcnt(uint64_t bytes)
 {
@@ -134,8 +144,33 @@ agg_reserve_space(daos_size_t *rsrvd)
 	rsrvd[DAOS_MEDIA_NVME]	+= size;
 }
 
+/* VOS garbage collection telemetry */
+struct vos_gc_metrics {
+	/* Number of garbage bags of each GC type (backlog) */
+	struct d_tm_node_t	*vgm_bags[GC_MAX];
+	/* Number of destroyed containers not fully reclaimed yet */
+	struct d_tm_node_t	*vgm_conts;
+	/* Number of reclaimed items */
+	struct d_tm_node_t	*vgm_reclaimed;
+	/* Credits of a GC transaction */
+	struct d_tm_node_t	*vgm_credits;
+};
+
+struct vos_tx_metrics {
+	/* Number of committed transactions */
+	struct d_tm_node_t	*vtm_commits;
+	/* Number of ranges added to transactions */
+	struct d_tm_node_t	*vtm_adds;
+	/* Bytes of ranges added to transactions */
+	struct d_tm_node_t	*vtm_add_bytes;
+	/* Bytes added since the previous committed transaction */
+	struct d_tm_node_t	*vtm_add_bytes_last;
+};
+
 struct vos_pool_metrics {
-	void	*vp_vea_metrics;
+	void			*vp_vea_metrics;
+	struct vos_gc_metrics	 vp_gc_metrics;
+	struct vos_tx_metrics	 vp_tx_metrics;
 	/* TODO: add more metrics for VOS */
 };
 
@@ -178,13 +213,29 @@ struct vos_pool {
 	daos_size_t		vp_space_sys[DAOS_MEDIA_MAX];
 	/** Held space by inflight updates. In bytes */
 	daos_size_t		vp_space_held[DAOS_MEDIA_MAX];
+	/**
+	 * Free space in bytes as of the last query, lowered by the updates
+	 * since then, see vos_space_query_cached()
+	 */
+	daos_size_t		vp_space_free[DAOS_MEDIA_MAX];
+	/** Time (in ms) of the last space query, 0 if none */
+	uint64_t		vp_space_ts;
 	/** Dedup hash */
 	struct d_hash_table	*vp_dedup_hash;
-	struct vos_metrics	*vp_metrics;
+	struct vos_pool_metrics	*vp_metrics;
+	/* Credits of a GC transaction, adaptive to foreground load */
+	int			 vp_gc_creds;
 	/* The count of committed DTXs for the whole pool. */
 	uint32_t		 vp_dtx_committed_count;
 };
 
+/* Does the durable format of the pool have vos_cont_df::cd_obj_hints */
+static inline bool
+vos_pool_has_obj_hints(struct vos_pool *pool)
+{
+	return pool->vp_pool_df->pd_version >= POOL_DF_VER_2;
+}
+
 /**
  * VOS container (DRAM)
  */
@@ -222,6 +273,8 @@ struct vos_container {
 	 * durable hints in vos_cont_df
 	 */
 	struct vea_hint_context	*vc_hint_ctxt[VOS_IOS_CNT];
+	/** In-memory hints for the durable hints in cd_obj_hints */
+	struct vea_hint_context	*vc_obj_hint_ctxt[VOS_OBJ_HINT_CNT];
 	/* Current ongoing aggregation ERR */
 	daos_epoch_range_t	vc_epr_aggregation;
 	/* Current ongoing discard EPR */
@@ -231,9 +284,37 @@ struct vos_container {
 	/* Various flags */
 	unsigned int		vc_in_aggregation:1,
 				vc_in_discard:1,
-				vc_reindex_cmt_dtx:1;
+				vc_reindex_cmt_dtx:1,
+				/* SCM is low, aggregation moves extents to NVMe */
+				vc_agg_scm_tier:1;
 	unsigned int		vc_obj_discard_count;
 	unsigned int		vc_open_count;
+	/* Running partitions of the ongoing aggregation */
+	unsigned int		vc_agg_part_cnt;
+	/* Number of partitions of the ongoing aggregation */
+	unsigned int		vc_agg_part_nr;
+	/* Aggregation cost model, VOS_AGG_COST_NR entries */
+	struct vos_agg_cost	*vc_agg_cost;
+};
+
+/* Number of cost model entries per container, must be power of 2 */
+#define VOS_AGG_COST_NR		256
+
+/**
+ * Aggregation cost model of an object, it tracks the updates since the last
+ * aggregation of the object and what the last aggregation has found, so the
+ * space could be reclaimed by aggregating the object can be estimated.
+ */
+struct vos_agg_cost {
+	daos_unit_oid_t		ac_oid;
+	/* Bytes updated since the last aggregation */
+	uint64_t		ac_upd_bytes;
+	/* Number of updates since the last aggregation */
+	uint32_t		ac_upd_cnt;
+	/* Records scanned by the last aggregation */
+	uint32_t		ac_agg_recs;
+	/* Visible records found by the last aggregation */
+	uint32_t		ac_agg_vis;
 };
 
 struct vos_dtx_act_ent {
@@ -705,6 +786,27 @@ vos_cont2pool(struct vos_container *cont)
 	return cont->vc_pool;
 }
 
+/**
+ * Get the block allocator hint for I/O stream \a ios. Updates of the generic
+ * stream are spread over the object hints by \a oid when the container has
+ * them, so that each object being written sequentially stays contiguous.
+ */
+static inline struct vea_hint_context *
+vos_cont2hint(struct vos_container *cont, enum vos_io_stream ios,
+	      daos_unit_oid_t *oid)
+{
+	uint64_t	idx;
+
+	if (ios != VOS_IOS_GENERIC || oid == NULL ||
+	    cont->vc_obj_hint_ctxt[0] == NULL)
+		return cont->vc_hint_ctxt[ios];
+
+	/* All shards of an object on this target share the same hint */
+	idx = d_hash_murmur64((unsigned char *)&oid->id_pub,
+			      sizeof(oid->id_pub), 0) % VOS_OBJ_HINT_CNT;
+	return cont->vc_obj_hint_ctxt[idx];
+}
+
 static inline struct vos_pool *
 vos_obj2pool(struct vos_object *obj)
 {
@@ -940,6 +1042,7 @@ tree_rec_bundle2iov(struct vos_rec_bundle *rbund, d_iov_t *iov)
 enum {
 	SUBTR_CREATE	= (1 << 0),	/**< may create the subtree */
 	SUBTR_EVT	= (1 << 1),	/**< subtree is evtree */
+	SUBTR_NONEXIST	= (1 << 2),	/**< key is known absent, skip lookup */
 };
 
 /* vos_common.c */
@@ -976,8 +1079,8 @@ vos_tx_begin(struct dtx_handle *dth, struct umem_instance *umm);
  */
 int
 vos_tx_end(struct vos_container *cont, struct dtx_handle *dth_in,
-	   struct vos_rsrvd_scm **rsrvd_scmp, d_list_t *nvme_exts, bool started,
-	   int err);
+	   struct vos_rsrvd_scm **rsrvd_scmp, d_list_t *nvme_exts,
+	   struct vea_hint_context *hint, bool started, int err);
 
 /* vos_obj.c */
 int
@@ -1027,11 +1130,12 @@ vos_publish_scm(struct vos_container *cont, struct vos_rsrvd_scm *rsrvd_scm,
 		bool publish);
 int
 vos_reserve_blocks(struct vos_container *cont, d_list_t *rsrvd_nvme,
-		   daos_size_t size, enum vos_io_stream ios, uint64_t *off);
+		   daos_size_t size, struct vea_hint_context *hint,
+		   uint64_t *off);
 
 int
 vos_publish_blocks(struct vos_container *cont, d_list_t *blk_list, bool publish,
-		   enum vos_io_stream ios);
+		   struct vea_hint_context *hint);
 
 static inline struct umem_instance *
 vos_pool2umm(struct vos_pool *pool)
@@ -1080,6 +1184,8 @@ int
 vos_gc_pool_tight(daos_handle_t poh, int *credits);
 void
 gc_reserve_space(daos_size_t *rsrvd);
+void
+gc_metrics_init(struct vos_gc_metrics *vgm, const char *path, int tgt_id);
 
 
 /**
@@ -1112,6 +1218,18 @@ oi_iter_aggregate(daos_handle_t ih, bool range_discard);
 int
 vos_obj_iter_aggregate(daos_handle_t ih, bool range_discard);
 
+/**
+ * Account an update of \a size bytes to the object in the aggregation cost
+ * model of the container.
+ *
+ * \param cont[IN]	Container
+ * \param oid[IN]	Object ID
+ * \param size[IN]	Bytes updated
+ */
+void
+vos_agg_cost_update(struct vos_container *cont, daos_unit_oid_t oid,
+		    daos_size_t size);
+
 /** Internal bit for initializing iterator from open tree handle */
 #define VOS_IT_KEY_TREE	(1 << 31)
 /** Ensure there is no overlap with public iterator flags (defined in
@@ -1175,6 +1293,8 @@ vos_space_sys_set(struct vos_pool *pool, daos_size_t *space_sys);
 int
 vos_space_query(struct vos_pool *pool, struct vos_pool_space *vps, bool slow);
 int
+vos_space_query_cached(struct vos_pool *pool, struct vos_pool_space *vps);
+int
 vos_space_hold(struct vos_pool *pool, uint64_t flags, daos_key_t *dkey,
 	       unsigned int iod_nr, daos_iod_t *iods,
 	       struct dcs_iod_csums *iods_csums, daos_size_t *space_hld);
@@ -1304,5 +1424,6 @@ struct csum_recalc_args {
 };
 
 int vos_csum_recalc_fn(void *recalc_args);
+bool vos_csum_recalc_copy(struct csum_recalc_args *args);
 
 #endif /* __VOS_INTERNAL_H__ */
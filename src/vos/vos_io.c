@@ -66,6 +66,8 @@ struct vos_io_context {
 	struct bio_desc		**ic_dedup_bufs;
 	/** the total size of the IO */
 	uint64_t		 ic_io_size;
+	/** dkey hash for the object key Bloom filter */
+	uint64_t		 ic_dkey_bloom;
 	/** flags */
 	unsigned int		 ic_update:1,
 				 ic_size_fetch:1,
@@ -503,6 +505,12 @@ vos_ioc2umm(struct vos_io_context *ioc)
 	return &ioc->ic_cont->vc_pool->vp_umm;
 }
 
+static inline struct vea_hint_context *
+vos_ioc2hint(struct vos_io_context *ioc)
+{
+	return vos_cont2hint(ioc->ic_cont, VOS_IOS_GENERIC, &ioc->ic_oid);
+}
+
 static daos_handle_t
 vos_ioc2ioh(struct vos_io_context *ioc)
 {
@@ -1252,6 +1260,10 @@ akey_fetch(struct vos_io_context *ioc, daos_handle_t ak_toh)
 	if (is_array)
 		flags |= SUBTR_EVT;
 
+	if (!vos_obj_bloom_check(ioc->ic_obj, ioc->ic_dkey_bloom,
+				 &iod->iod_name))
+		flags |= SUBTR_NONEXIST;
+
 	rc = key_tree_prepare(ioc->ic_obj, ak_toh,
 			      VOS_BTR_AKEY, &iod->iod_name, flags,
 			      DAOS_INTENT_DEFAULT, &krec, &toh, ioc->ic_ts_set);
@@ -1378,14 +1390,19 @@ dkey_fetch(struct vos_io_context *ioc, daos_key_t *dkey)
 	struct vos_object	*obj = ioc->ic_obj;
 	struct vos_krec_df	*krec;
 	daos_handle_t		 toh = DAOS_HDL_INVAL;
+	int			 flags = 0;
 	int			 i, rc;
 
 	rc = obj_tree_init(obj);
 	if (rc != 0)
 		return rc;
 
+	ioc->ic_dkey_bloom = vos_obj_bloom_hash(dkey);
+	if (!vos_obj_bloom_check(obj, ioc->ic_dkey_bloom, NULL))
+		flags |= SUBTR_NONEXIST;
+
 	rc = key_tree_prepare(obj, obj->obj_toh, VOS_BTR_DKEY,
-			      dkey, 0, DAOS_INTENT_DEFAULT, &krec,
+			      dkey, flags, DAOS_INTENT_DEFAULT, &krec,
 			      &toh, ioc->ic_ts_set);
 	if (stop_check(ioc, VOS_COND_FETCH_MASK | VOS_OF_COND_PER_AKEY, NULL,
 		       &rc, true)) {
@@ -1698,6 +1715,7 @@ akey_update(struct vos_io_context *ioc, uint32_t pm_ver, daos_handle_t ak_toh,
 	if (is_array)
 		flags |= SUBTR_EVT;
 
+	vos_obj_bloom_add(obj, ioc->ic_dkey_bloom, &iod->iod_name);
 	rc = key_tree_prepare(obj, ak_toh, VOS_BTR_AKEY,
 			      &iod->iod_name, flags, DAOS_INTENT_UPDATE,
 			      &krec, &toh, ioc->ic_ts_set);
@@ -1806,6 +1824,10 @@ dkey_update(struct vos_io_context *ioc, uint32_t pm_ver, daos_key_t *dkey,
 	if (rc != 0)
 		return rc;
 
+	/* Add keys to the Bloom filter before inserting them to the trees */
+	ioc->ic_dkey_bloom = vos_obj_bloom_hash(dkey);
+	vos_obj_bloom_add(obj, ioc->ic_dkey_bloom, NULL);
+
 	rc = key_tree_prepare(obj, obj->obj_toh, VOS_BTR_DKEY, dkey,
 			      SUBTR_CREATE, DAOS_INTENT_UPDATE, &krec, &ak_toh,
 			      ioc->ic_ts_set);
@@ -1916,23 +1938,21 @@ out:
 
 int
 vos_reserve_blocks(struct vos_container *cont, d_list_t *rsrvd_nvme,
-		   daos_size_t size, enum vos_io_stream ios, uint64_t *off)
+		   daos_size_t size, struct vea_hint_context *hint,
+		   uint64_t *off)
 {
 	struct vea_space_info	*vsi;
-	struct vea_hint_context	*hint_ctxt;
 	struct vea_resrvd_ext	*ext;
 	uint32_t		 blk_cnt;
 	int			 rc;
 
 	vsi = vos_cont2pool(cont)->vp_vea_info;
 	D_ASSERT(vsi);
-
-	hint_ctxt = cont->vc_hint_ctxt[ios];
-	D_ASSERT(hint_ctxt);
+	D_ASSERT(hint);
 
 	blk_cnt = vos_byte2blkcnt(size);
 
-	rc = vea_reserve(vsi, blk_cnt, hint_ctxt, rsrvd_nvme);
+	rc = vea_reserve(vsi, blk_cnt, hint, rsrvd_nvme);
 	if (rc)
 		return rc;
 
@@ -1967,7 +1987,7 @@ reserve_space(struct vos_io_context *ioc, uint16_t media, daos_size_t size,
 
 	D_ASSERT(media == DAOS_MEDIA_NVME);
 	rc = vos_reserve_blocks(ioc->ic_cont, &ioc->ic_blk_exts, size,
-				VOS_IOS_GENERIC, off);
+				vos_ioc2hint(ioc), off);
 	if (rc)
 		D_ERROR("Reserve "DF_U64" from NVMe failed. "DF_RC"\n",
 			size, DP_RC(rc));
@@ -2191,10 +2211,9 @@ vos_publish_scm(struct vos_container *cont, struct vos_rsrvd_scm *rsrvd_scm,
 /* Publish or cancel the NVMe block reservations */
 int
 vos_publish_blocks(struct vos_container *cont, d_list_t *blk_list, bool publish,
-		   enum vos_io_stream ios)
+		   struct vea_hint_context *hint)
 {
 	struct vea_space_info	*vsi;
-	struct vea_hint_context	*hint_ctxt;
 	int			 rc;
 
 	if (d_list_empty(blk_list))
@@ -2202,11 +2221,9 @@ vos_publish_blocks(struct vos_container *cont, d_list_t *blk_list, bool publish,
 
 	vsi = cont->vc_pool->vp_vea_info;
 	D_ASSERT(vsi);
-	hint_ctxt = cont->vc_hint_ctxt[ios];
-	D_ASSERT(hint_ctxt);
 
-	rc = publish ? vea_tx_publish(vsi, hint_ctxt, blk_list) :
-		       vea_cancel(vsi, hint_ctxt, blk_list);
+	rc = publish ? vea_tx_publish(vsi, hint, blk_list) :
+		       vea_cancel(vsi, hint, blk_list);
 	if (rc)
 		D_ERROR("Error on %s NVMe reservations. "DF_RC"\n",
 			publish ? "publish" : "cancel", DP_RC(rc));
@@ -2319,8 +2336,9 @@ abort:
 	}
 
 	err = vos_tx_end(ioc->ic_cont, dth, &ioc->ic_rsrvd_scm,
-			 &ioc->ic_blk_exts, tx_started, err);
+			 &ioc->ic_blk_exts, vos_ioc2hint(ioc), tx_started, err);
 	if (err == 0) {
+		vos_agg_cost_update(ioc->ic_cont, ioc->ic_oid, ioc->ic_io_size);
 		vos_ts_set_upgrade(ioc->ic_ts_set);
 		if (daes != NULL) {
 			vos_dtx_post_handle(ioc->ic_cont, daes, dces,
@@ -89,8 +89,10 @@ enum vos_gc_type {
 
 /** Lowest supported durable format version */
 #define POOL_DF_VER_1				23
+/** Version allocating vos_cont_df::cd_obj_hints for new containers */
+#define POOL_DF_VER_2				24
 /** Current durable format version */
-#define POOL_DF_VERSION				POOL_DF_VER_1
+#define POOL_DF_VERSION				POOL_DF_VER_2
 
 /**
  * Durable format for VOS pool
@@ -228,6 +230,14 @@ enum vos_io_stream {
 	VOS_IOS_CNT
 };
 
+/**
+ * Number of extra allocation hints for the generic I/O stream, updates to
+ * different objects are spread over these hints by object ID, so that
+ * concurrent sequential writers to different objects each get contiguous
+ * extents.
+ */
+#define VOS_OBJ_HINT_CNT	8
+
 /* VOS Container Value */
 struct vos_cont_df {
 	uuid_t				cd_id;
@@ -239,8 +249,14 @@ struct vos_cont_df {
 	struct btr_root			cd_obj_root;
 	/** reserved for placement algorithm upgrade */
 	uint64_t			cd_reserv_upgrade;
-	/** reserved for future usage */
-	uint64_t			cd_reserv;
+	/**
+	 * Array of VOS_OBJ_HINT_CNT struct vea_hint_df for object hint
+	 * streams. It replaces a reserved field and is only valid in pools
+	 * of POOL_DF_VER_2 or later, older pools never use it. Software
+	 * predating POOL_DF_VER_2 refuses to open such pools, so the array
+	 * can't be leaked by an older GC.
+	 */
+	umem_off_t			cd_obj_hints;
 	/** The active DTXs blob head. */
 	umem_off_t			cd_dtx_active_head;
 	/** The active DTXs blob tail. */
@@ -244,6 +244,7 @@ key_punch(struct vos_object *obj, daos_epoch_t epoch, daos_epoch_t bound,
 	daos_epoch_range_t	 epr = {0, epoch};
 	d_iov_t			 riov;
 	daos_handle_t		 toh = DAOS_HDL_INVAL;
+	uint64_t		 dkey_hash;
 	int			 i;
 	int			 rc;
 
@@ -269,6 +270,8 @@ key_punch(struct vos_object *obj, daos_epoch_t epoch, daos_epoch_t bound,
 	rbund.rb_csum	= &csum;
 	ci_set_null(&csum);
 
+	dkey_hash = vos_obj_bloom_hash(dkey);
+	vos_obj_bloom_add(obj, dkey_hash, NULL);
 	if (!akeys)
 		goto punch_dkey;
 
@@ -295,6 +298,7 @@ key_punch(struct vos_object *obj, daos_epoch_t epoch, daos_epoch_t bound,
 	rbund.rb_tclass	= VOS_BTR_AKEY;
 	for (i = 0; i < akey_nr; i++) {
 		rbund.rb_iov = &akeys[i];
+		vos_obj_bloom_add(obj, dkey_hash, &akeys[i]);
 		rc = key_tree_punch(obj, toh, epoch, bound, &akeys[i], &riov,
 				    flags, ts_set, &krec->kr_known_akey, &info->ki_dkey,
 				    &info->ki_akey);
@@ -505,7 +509,7 @@ reset:
 			rc = -DER_TX_RESTART;
 	}
 
-	rc = vos_tx_end(cont, dth, NULL, NULL, true, rc);
+	rc = vos_tx_end(cont, dth, NULL, NULL, NULL, true, rc);
 
 	if (rc == 0) {
 		vos_ts_set_upgrade(ts_set);
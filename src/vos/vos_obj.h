@@ -23,6 +23,9 @@
 #include "vos_ts.h"
 
 #define LRU_CACHE_BITS 16
+/** Range of DAOS_VOS_OBJ_CACHE_BITS */
+#define LRU_CACHE_BITS_MIN 10
+#define LRU_CACHE_BITS_MAX 22
 
 /* Internal container handle structure */
 struct vos_container;
@@ -39,8 +42,6 @@ struct vos_object {
 	daos_unit_oid_t			obj_id;
 	/** dkey tree open handle of the object */
 	daos_handle_t			obj_toh;
-	/** btree iterator handle */
-	daos_handle_t			obj_ih;
 	/** The latest sync epoch */
 	daos_epoch_t			obj_sync_epoch;
 	/** Persistent memory address of the object */
@@ -51,6 +52,10 @@ struct vos_object {
 	bool				obj_zombie;
 	/** Object is in discard */
 	bool				obj_discard;
+	/** Bloom filter can't be used, the object has too many keys */
+	bool				obj_bloom_off;
+	/** Bloom filter of keys for negative lookup, built on demand */
+	struct vos_obj_bloom		*obj_bloom;
 };
 
 enum {
@@ -122,6 +127,13 @@ int vos_obj_evict_by_oid(struct daos_lru_cache *occ, struct vos_container *cont,
 int
 vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ_p);
 
+/**
+ * Size of the per-target object cache in bits, LRU_CACHE_BITS unless set by
+ * DAOS_VOS_OBJ_CACHE_BITS.
+ */
+int
+vos_obj_cache_bits(void);
+
 /**
  * Destroy an object cache, and release all cached object references.
  *
@@ -139,6 +151,37 @@ void vos_obj_cache_evict(struct daos_lru_cache *occ,
  */
 struct daos_lru_cache *vos_obj_cache_current(void);
 
+/** Hash of \a dkey for the object key Bloom filter */
+uint64_t
+vos_obj_bloom_hash(daos_key_t *dkey);
+
+/**
+ * Check the key Bloom filter of the object, the filter is built from the
+ * key trees on the first check after the object is loaded.
+ *
+ * \param obj		[IN]	Object, its dkey tree should be opened.
+ * \param dkey_hash	[IN]	Hash of the dkey, see vos_obj_bloom_hash()
+ * \param akey		[IN]	Akey under the dkey, NULL to check dkey
+ *
+ * \return	false		The key surely doesn't exist
+ *		true		The key may exist
+ */
+bool
+vos_obj_bloom_check(struct vos_object *obj, uint64_t dkey_hash,
+		    daos_key_t *akey);
+
+/**
+ * Add a dkey or dkey/akey to the key Bloom filter of the object, it should
+ * be called for every key could be inserted into the key trees.
+ *
+ * \param obj		[IN]	Object
+ * \param dkey_hash	[IN]	Hash of the dkey, see vos_obj_bloom_hash()
+ * \param akey		[IN]	Akey under the dkey, NULL to add dkey only
+ */
+void
+vos_obj_bloom_add(struct vos_object *obj, uint64_t dkey_hash,
+		  daos_key_t *akey);
+
 /**
  * Object Index API and handles
  * For internal use by object cache
@@ -10,10 +10,12 @@
  * index API defined for PMEM are used here by the cache..
  *
  * LRU cache implementation:
- * Simple LRU based object cache for Object index table
- * Uses a hashtable and a doubly linked list to set and get
- * entries. The size of both hashtable and linked list are
- * fixed length.
+ * Segmented LRU based object cache for Object index table
+ * Uses a hashtable and two doubly linked lists to set and get
+ * entries, objects referenced only once are evicted before the
+ * ones referenced repeatedly. The size of the hashtable and the
+ * lists are fixed length. The cache is per xstream so it needs
+ * no locking.
  *
  * Author: Vishwanath Venkatesan <vishwanath.venkatesan@intel.com>
  */
@@ -112,6 +114,7 @@ obj_lop_rec_hash(struct daos_llink *llink)
 static inline void
 clean_object(struct vos_object *obj)
 {
+	D_FREE(obj->obj_bloom);
 	vos_ilog_fetch_finish(&obj->obj_ilog_info);
 	if (obj->obj_cont != NULL)
 		vos_cont_decref(obj->obj_cont);
@@ -150,6 +153,20 @@ static struct daos_llink_ops obj_lru_ops = {
 	.lop_print_key	= obj_lop_print_key,
 };
 
+int
+vos_obj_cache_bits(void)
+{
+	unsigned int	bits = LRU_CACHE_BITS;
+
+	d_getenv_int("DAOS_VOS_OBJ_CACHE_BITS", &bits);
+	if (bits < LRU_CACHE_BITS_MIN || bits > LRU_CACHE_BITS_MAX) {
+		D_WARN("Invalid DAOS_VOS_OBJ_CACHE_BITS %u, using %u\n",
+		       bits, LRU_CACHE_BITS);
+		bits = LRU_CACHE_BITS;
+	}
+	return bits;
+}
+
 int
 vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ)
 {
@@ -200,6 +217,17 @@ vos_obj_cache_current(void)
 
 static __thread struct vos_object	 obj_local = {0};
 
+/** Publish the statistics of the object cache */
+static inline void
+obj_cache_metrics_update(struct daos_lru_cache *occ)
+{
+	struct vos_tls	*tls = vos_tls_get();
+
+	d_tm_set_counter(tls->vtl_ocache_hit, occ->dlc_hits);
+	d_tm_set_counter(tls->vtl_ocache_miss, occ->dlc_misses);
+	d_tm_set_counter(tls->vtl_ocache_evict, occ->dlc_evictions);
+}
+
 void
 vos_obj_release(struct daos_lru_cache *occ, struct vos_object *obj, bool evict)
 {
@@ -207,6 +235,8 @@ vos_obj_release(struct daos_lru_cache *occ, struct vos_object *obj, bool evict)
 	if (obj == &obj_local) {
 		clean_object(obj);
 		memset(obj, 0, sizeof(*obj));
+		if (occ != NULL)
+			obj_cache_metrics_update(occ);
 		return;
 	}
 
@@ -216,6 +246,7 @@ vos_obj_release(struct daos_lru_cache *occ, struct vos_object *obj, bool evict)
 		daos_lru_ref_evict(occ, &obj->obj_llink);
 
 	daos_lru_ref_release(occ, &obj->obj_llink);
+	obj_cache_metrics_update(occ);
 }
 
 int
@@ -277,12 +308,10 @@ cache_object(struct daos_lru_cache *occ, struct vos_object **objp)
 
 	vos_ilog_fetch_move(&obj_new->obj_ilog_info, &obj_local.obj_ilog_info);
 	obj_new->obj_toh = obj_local.obj_toh;
-	obj_new->obj_ih = obj_local.obj_ih;
 	obj_new->obj_sync_epoch = obj_local.obj_sync_epoch;
 	obj_new->obj_df = obj_local.obj_df;
 	obj_new->obj_zombie = obj_local.obj_zombie;
 	obj_local.obj_toh = DAOS_HDL_INVAL;
-	obj_local.obj_ih = DAOS_HDL_INVAL;
 	clean_object(&obj_local);
 	memset(&obj_local, 0, sizeof(obj_local));
 
@@ -528,3 +557,216 @@ vos_obj_evict_by_oid(struct daos_lru_cache *occ, struct vos_container *cont,
 
 	return rc == -DER_NONEXIST ? 0 : rc;
 }
+
+/** Bits of the object key Bloom filter, it consumes 1KB DRAM */
+#define VOS_BLOOM_BITS		8192
+/** Number of hash functions of the Bloom filter */
+#define VOS_BLOOM_HASHES	4
+/** Max keys in the filter, false positive rate is about 2.4% at this point */
+#define VOS_BLOOM_KEYS_MAX	1024
+
+/**
+ * Bloom filter over the dkeys and the dkey/akey pairs of an object, it's
+ * only in DRAM and never has false negative: the key records removed by
+ * aggregation or discard are just left in the filter.
+ */
+struct vos_obj_bloom {
+	uint32_t	ob_keys;
+	uint64_t	ob_bits[VOS_BLOOM_BITS / 64];
+};
+
+/* Disabled by default, enabled by DAOS_VOS_BLOOM */
+bool vos_obj_bloom_enabled;
+
+uint64_t
+vos_obj_bloom_hash(daos_key_t *dkey)
+{
+	return d_hash_murmur64(dkey->iov_buf, dkey->iov_len, 0);
+}
+
+static inline uint64_t
+bloom_key_hash(uint64_t dkey_hash, daos_key_t *akey)
+{
+	if (akey == NULL)
+		return dkey_hash;
+
+	return d_hash_murmur64(akey->iov_buf, akey->iov_len, dkey_hash);
+}
+
+/* Double hashing, i-th bit is h1 + i * h2 */
+static inline uint32_t
+bloom_bit(uint64_t hash, int i)
+{
+	uint32_t	h1 = hash;
+	uint32_t	h2 = (hash >> 32) | 1;
+
+	return (h1 + i * h2) % VOS_BLOOM_BITS;
+}
+
+static void
+bloom_set(struct vos_obj_bloom *bloom, uint64_t hash)
+{
+	uint32_t	bit;
+	int		i;
+
+	for (i = 0; i < VOS_BLOOM_HASHES; i++) {
+		bit = bloom_bit(hash, i);
+		bloom->ob_bits[bit / 64] |= 1ULL << (bit % 64);
+	}
+	bloom->ob_keys++;
+}
+
+static bool
+bloom_test(struct vos_obj_bloom *bloom, uint64_t hash)
+{
+	uint32_t	bit;
+	int		i;
+
+	for (i = 0; i < VOS_BLOOM_HASHES; i++) {
+		bit = bloom_bit(hash, i);
+		if (!(bloom->ob_bits[bit / 64] & (1ULL << (bit % 64))))
+			return false;
+	}
+	return true;
+}
+
+static void
+bloom_disable(struct vos_object *obj)
+{
+	D_DEBUG(DB_TRACE, "Too many keys, disable Bloom filter of "DF_UOID"\n",
+		DP_UOID(obj->obj_id));
+	D_FREE(obj->obj_bloom);
+	obj->obj_bloom_off = true;
+}
+
+/*
+ * Add all keys of the key tree @toh to the filter, and akeys of each dkey if
+ * @is_dkey is true. It returns 1 if there are too many keys.
+ */
+static int
+bloom_load_tree(struct vos_object *obj, struct vos_obj_bloom *bloom,
+		daos_handle_t toh, bool is_dkey, uint64_t dkey_hash)
+{
+	struct vos_rec_bundle	 rbund;
+	struct dcs_csum_info	 csum;
+	struct vos_krec_df	*krec;
+	daos_handle_t		 ih;
+	daos_handle_t		 ak_toh;
+	d_iov_t			 kiov;
+	d_iov_t			 riov;
+	d_iov_t			 key;
+	uint64_t		 hash;
+	int			 rc;
+
+	rc = dbtree_iter_prepare(toh, 0, &ih);
+	if (rc != 0)
+		return rc;
+
+	rc = dbtree_iter_probe(ih, BTR_PROBE_FIRST, DAOS_INTENT_DEFAULT, NULL,
+			       NULL);
+	while (rc == 0) {
+		tree_rec_bundle2iov(&rbund, &riov);
+		rbund.rb_iov = &key;
+		rbund.rb_csum = &csum;
+		d_iov_set(&key, NULL, 0); /* no copy */
+		ci_set_null(&csum);
+
+		rc = dbtree_iter_fetch(ih, &kiov, &riov, NULL);
+		if (rc != 0)
+			break;
+
+		if (bloom->ob_keys >= VOS_BLOOM_KEYS_MAX) {
+			rc = 1;
+			break;
+		}
+
+		hash = is_dkey ? vos_obj_bloom_hash(&key) :
+				 bloom_key_hash(dkey_hash, &key);
+		bloom_set(bloom, hash);
+
+		krec = rbund.rb_krec;
+		if (is_dkey && (krec->kr_bmap & KREC_BF_BTR)) {
+			rc = dbtree_open_inplace_ex(&krec->kr_btr,
+						    vos_obj2uma(obj),
+						    vos_cont2hdl(obj->obj_cont),
+						    vos_obj2pool(obj), &ak_toh);
+			if (rc != 0)
+				break;
+
+			rc = bloom_load_tree(obj, bloom, ak_toh, false, hash);
+			dbtree_close(ak_toh);
+			if (rc != 0)
+				break;
+		}
+
+		rc = dbtree_iter_next(ih);
+	}
+	dbtree_iter_finish(ih);
+
+	return rc == -DER_NONEXIST ? 0 : rc;
+}
+
+static int
+bloom_load(struct vos_object *obj)
+{
+	struct vos_obj_bloom	*bloom;
+	int			 rc;
+
+	D_ALLOC_PTR(bloom);
+	if (bloom == NULL)
+		return -DER_NOMEM;
+
+	rc = bloom_load_tree(obj, bloom, obj->obj_toh, true, 0);
+	if (rc != 0) {
+		D_FREE(bloom);
+		return rc;
+	}
+
+	D_DEBUG(DB_TRACE, "Loaded %u keys to Bloom filter of "DF_UOID"\n",
+		bloom->ob_keys, DP_UOID(obj->obj_id));
+	obj->obj_bloom = bloom;
+	return 0;
+}
+
+bool
+vos_obj_bloom_check(struct vos_object *obj, uint64_t dkey_hash,
+		    daos_key_t *akey)
+{
+	int	rc;
+
+	if (!vos_obj_bloom_enabled || obj->obj_bloom_off)
+		return true;
+
+	if (obj->obj_bloom == NULL) {
+		if (daos_handle_is_inval(obj->obj_toh))
+			return true;
+
+		rc = bloom_load(obj);
+		if (rc != 0) {
+			if (rc != 1)
+				D_ERROR("Failed to load Bloom filter of "DF_UOID
+					": "DF_RC"\n", DP_UOID(obj->obj_id),
+					DP_RC(rc));
+			bloom_disable(obj);
+			return true;
+		}
+	}
+
+	return bloom_test(obj->obj_bloom, bloom_key_hash(dkey_hash, akey));
+}
+
+void
+vos_obj_bloom_add(struct vos_object *obj, uint64_t dkey_hash,
+		  daos_key_t *akey)
+{
+	/* Not loaded yet, new keys will be loaded from the key trees */
+	if (obj->obj_bloom == NULL)
+		return;
+
+	if (obj->obj_bloom->ob_keys >= VOS_BLOOM_KEYS_MAX) {
+		bloom_disable(obj);
+		return;
+	}
+
+	bloom_set(obj->obj_bloom, bloom_key_hash(dkey_hash, akey));
+}
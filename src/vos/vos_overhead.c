@@ -23,6 +23,27 @@ vos_pool_get_scm_cutoff(void)
 	return VOS_BLK_SZ;
 }
 
+int
+vos_obj_get_dram_size(void)
+{
+	/* The dkey tree is opened on first access and kept open while cached */
+	return sizeof(struct vos_object) + dbtree_handle_dram_size();
+}
+
+int
+vos_container_get_dram_size(void)
+{
+	/* Object index and the two DTX tables, plus the aggregation costs */
+	return sizeof(struct vos_container) + 3 * dbtree_handle_dram_size() +
+	       VOS_AGG_COST_NR * sizeof(struct vos_agg_cost);
+}
+
+int
+vos_obj_cache_get_nr(void)
+{
+	return 1 << vos_obj_cache_bits();
+}
+
 int
 vos_tree_get_overhead(int alloc_overhead, enum VOS_TREE_CLASS tclass,
 		      uint64_t ofeat, struct daos_tree_overhead *ovhd)
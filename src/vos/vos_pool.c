@@ -719,6 +719,7 @@ pool_open(PMEMobjpool *ph, struct vos_pool_df *pool_df, uuid_t uuid,
 		return rc;
 	}
 
+	pool->vp_metrics = metrics;
 	uma = &pool->vp_uma;
 	uma->uma_id = UMEM_CLASS_PMEM;
 	uma->uma_pool = ph;
@@ -952,6 +953,7 @@ vos_pool_query(daos_handle_t poh, vos_pool_info_t *pinfo)
 	D_ASSERT(pinfo != NULL);
 	pinfo->pif_cont_nr = pool_df->pd_cont_nr;
 	pinfo->pif_gc_stat = pool->vp_gc_stat;
+	umem_tx_stats_get(&pinfo->pif_tx_stats);
 
 	rc = vos_space_query(pool, &pinfo->pif_space, true);
 	if (rc)
@@ -960,8 +962,8 @@ vos_pool_query(daos_handle_t poh, vos_pool_info_t *pinfo)
 	return rc;
 }
 
-int
-vos_pool_query_space(uuid_t pool_id, struct vos_pool_space *vps)
+static int
+pool_query_space(uuid_t pool_id, struct vos_pool_space *vps, bool cached)
 {
 	struct vos_pool	*pool = NULL;
 	struct d_uuid	 ukey;
@@ -977,11 +979,26 @@ vos_pool_query_space(uuid_t pool_id, struct vos_pool_space *vps)
 	}
 
 	D_ASSERT(pool != NULL);
-	rc = vos_space_query(pool, vps, false);
+	if (cached)
+		rc = vos_space_query_cached(pool, vps);
+	else
+		rc = vos_space_query(pool, vps, false);
 	vos_pool_decref(pool);
 	return rc;
 }
 
+int
+vos_pool_query_space(uuid_t pool_id, struct vos_pool_space *vps)
+{
+	return pool_query_space(pool_id, vps, false);
+}
+
+int
+vos_pool_query_space_cached(uuid_t pool_id, struct vos_pool_space *vps)
+{
+	return pool_query_space(pool_id, vps, true);
+}
+
 int
 vos_pool_space_sys_set(daos_handle_t poh, daos_size_t *space_sys)
 {
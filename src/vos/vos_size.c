@@ -160,6 +160,12 @@ get_vos_structure_sizes_yaml(int alloc_overhead, struct d_string_buffer_t *buf)
 			      vos_container_get_msize());
 	d_write_string_buffer(buf, "scm_cutoff: %d\n",
 			      vos_pool_get_scm_cutoff());
+	d_write_string_buffer(buf, "# VOS DRAM overheads per target\n");
+	d_write_string_buffer(buf, "obj_dram: %d\n", vos_obj_get_dram_size());
+	d_write_string_buffer(buf, "cont_dram: %d\n",
+			      vos_container_get_dram_size());
+	d_write_string_buffer(buf, "obj_cache_nr: %d\n",
+			      vos_obj_cache_get_nr());
 
 	FOREACH_TYPE(PRINT_DYNAMIC)
 	d_write_string_buffer(buf, "trees:\n");
@@ -12,6 +12,11 @@
 #define POOL_NVME_SYS(pool)	((pool)->vp_space_sys[DAOS_MEDIA_NVME])
 #define POOL_SCM_HELD(pool)	((pool)->vp_space_held[DAOS_MEDIA_SCM])
 #define POOL_NVME_HELD(pool)	((pool)->vp_space_held[DAOS_MEDIA_NVME])
+#define POOL_SCM_FREE(pool)	((pool)->vp_space_free[DAOS_MEDIA_SCM])
+#define POOL_NVME_FREE(pool)	((pool)->vp_space_free[DAOS_MEDIA_NVME])
+
+/* Cached free space older than this (in ms) is reconciled with PMDK & VEA */
+#define SPACE_CACHE_AGE		1000
 
 static inline daos_size_t
 get_frag_overhead(daos_size_t tot_size, int media, bool small_pool)
@@ -144,7 +149,7 @@ vos_space_query(struct vos_pool *pool, struct vos_pool_space *vps, bool slow)
 		NVME_TOTAL(vps) = 0;
 		NVME_FREE(vps) = 0;
 		NVME_SYS(vps) = 0;
-		return 0;
+		goto cache;
 	}
 
 	/* Query NVMe free space */
@@ -161,9 +166,52 @@ vos_space_query(struct vos_pool *pool, struct vos_pool_space *vps, bool slow)
 	D_ASSERTF(NVME_FREE(vps) <= NVME_TOTAL(vps),
 		  "nvme_free:"DF_U64", nvme_sz:"DF_U64", blk_sz:%u\n",
 		  NVME_FREE(vps), NVME_TOTAL(vps), attr->va_blk_sz);
+cache:
+	POOL_SCM_FREE(pool)	= SCM_FREE(vps);
+	POOL_NVME_FREE(pool)	= NVME_FREE(vps);
+	pool->vp_space_ts	= daos_getmtime_coarse() ? : 1;
+	return 0;
+}
+
+/*
+ * Query the pool space from the counters maintained by vos_space_hold() and
+ * vos_space_unhold(), PMDK and VEA are only queried when the counters are
+ * older than SPACE_CACHE_AGE. The free space is conservative: space consumed
+ * by updates is accounted right away, while space reclaimed by GC and
+ * aggregation only shows up on the next query. The VEA attributes and stats
+ * of @vps aren't filled.
+ */
+int
+vos_space_query_cached(struct vos_pool *pool, struct vos_pool_space *vps)
+{
+	struct vos_pool_df	*df = pool->vp_pool_df;
+
+	if (pool->vp_space_ts == 0 ||
+	    pool->vp_space_ts + SPACE_CACHE_AGE < daos_getmtime_coarse())
+		return vos_space_query(pool, vps, false);
+
+	SCM_TOTAL(vps)	= df->pd_scm_sz;
+	SCM_SYS(vps)	= POOL_SCM_SYS(pool);
+	SCM_FREE(vps)	= POOL_SCM_FREE(pool);
+
+	if (pool->vp_vea_info == NULL) {
+		NVME_TOTAL(vps)	= 0;
+		NVME_SYS(vps)	= 0;
+	} else {
+		NVME_TOTAL(vps)	= df->pd_nvme_sz;
+		NVME_SYS(vps)	= POOL_NVME_SYS(pool);
+	}
+	NVME_FREE(vps)	= POOL_NVME_FREE(pool);
+
 	return 0;
 }
 
+static inline void
+space_free_consume(daos_size_t *free, daos_size_t size)
+{
+	*free = (*free > size) ? *free - size : 0;
+}
+
 static inline daos_size_t
 recx_csum_len(daos_recx_t *recx, struct dcs_csum_info *csum,
 	      daos_size_t rec_size)
@@ -269,6 +317,38 @@ estimate_space(struct vos_pool *pool, daos_key_t *dkey, unsigned int iod_nr,
 	space_est[DAOS_MEDIA_NVME] = nvme * VOS_BLK_SZ;
 }
 
+static bool
+space_check(struct vos_pool *pool, struct vos_pool_space *vps,
+	    daos_size_t *space_est)
+{
+	daos_size_t	scm_left, nvme_left;
+
+	scm_left = SCM_FREE(vps);
+	if (scm_left < SCM_SYS(vps))
+		return false;
+
+	scm_left -= SCM_SYS(vps);
+	if (scm_left < POOL_SCM_HELD(pool))
+		return false;
+
+	scm_left -= POOL_SCM_HELD(pool);
+	if (scm_left < space_est[DAOS_MEDIA_SCM])
+		return false;
+
+	/* If NVMe isn't configured or this update doesn't use NVMe space */
+	if (pool->vp_vea_info == NULL || space_est[DAOS_MEDIA_NVME] == 0)
+		return true;
+
+	nvme_left = NVME_FREE(vps);
+	if (nvme_left < NVME_SYS(vps))
+		return false;
+
+	nvme_left -= NVME_SYS(vps);
+	/* 'NVMe held' has already been excluded from 'NVMe free' */
+
+	return nvme_left >= space_est[DAOS_MEDIA_NVME];
+}
+
 int
 vos_space_hold(struct vos_pool *pool, uint64_t flags, daos_key_t *dkey,
 	       unsigned int iod_nr, daos_iod_t *iods,
@@ -276,10 +356,9 @@ vos_space_hold(struct vos_pool *pool, uint64_t flags, daos_key_t *dkey,
 {
 	struct vos_pool_space	vps = { 0 };
 	daos_size_t		space_est[DAOS_MEDIA_MAX] = { 0, 0 };
-	daos_size_t		scm_left, nvme_left;
 	int			rc;
 
-	rc = vos_space_query(pool, &vps, false);
+	rc = vos_space_query_cached(pool, &vps);
 	if (rc) {
 		D_ERROR("Query pool:"DF_UUID" space failed. "DF_RC"\n",
 			DP_UUID(pool->vp_id), DP_RC(rc));
@@ -292,30 +371,18 @@ vos_space_hold(struct vos_pool *pool, uint64_t flags, daos_key_t *dkey,
 	if (flags & VOS_OF_CRIT)
 		goto success;
 
-	scm_left = SCM_FREE(&vps);
-	if (scm_left < SCM_SYS(&vps))
-		goto error;
-
-	scm_left -= SCM_SYS(&vps);
-	if (scm_left < POOL_SCM_HELD(pool))
-		goto error;
-
-	scm_left -= POOL_SCM_HELD(pool);
-	if (scm_left < space_est[DAOS_MEDIA_SCM])
-		goto error;
-
-	/* If NVMe isn't configured or this update doesn't use NVMe space */
-	if (pool->vp_vea_info == NULL || space_est[DAOS_MEDIA_NVME] == 0)
+	if (space_check(pool, &vps, &space_est[0]))
 		goto success;
 
-	nvme_left = NVME_FREE(&vps);
-	if (nvme_left < NVME_SYS(&vps))
-		goto error;
-
-	nvme_left -= NVME_SYS(&vps);
-	/* 'NVMe held' has already been excluded from 'NVMe free' */
+	/* The cached free space is conservative, reconcile it before failing */
+	rc = vos_space_query(pool, &vps, false);
+	if (rc) {
+		D_ERROR("Query pool:"DF_UUID" space failed. "DF_RC"\n",
+			DP_UUID(pool->vp_id), DP_RC(rc));
+		return rc;
+	}
 
-	if (nvme_left < space_est[DAOS_MEDIA_NVME])
+	if (!space_check(pool, &vps, &space_est[0]))
 		goto error;
 
 success:
@@ -323,6 +390,8 @@ success:
 	space_hld[DAOS_MEDIA_NVME]	= space_est[DAOS_MEDIA_NVME];
 	POOL_SCM_HELD(pool)		+= space_hld[DAOS_MEDIA_SCM];
 	POOL_NVME_HELD(pool)		+= space_hld[DAOS_MEDIA_NVME];
+	/* NVMe space is reserved from VEA right after, unlike SCM */
+	space_free_consume(&POOL_NVME_FREE(pool), space_hld[DAOS_MEDIA_NVME]);
 
 	return 0;
 error:
@@ -349,4 +418,9 @@ vos_space_unhold(struct vos_pool *pool, daos_size_t *space_hld)
 
 	POOL_SCM_HELD(pool)	-= space_hld[DAOS_MEDIA_SCM];
 	POOL_NVME_HELD(pool)	-= space_hld[DAOS_MEDIA_NVME];
+	/*
+	 * The held SCM space is allocated now if the update was published,
+	 * assume it was until the next query.
+	 */
+	space_free_consume(&POOL_SCM_FREE(pool), space_hld[DAOS_MEDIA_SCM]);
 }
@@ -25,6 +25,7 @@
 /* Forward declarations */
 struct vos_ts_table;
 struct dtx_handle;
+struct evt_vis_cache;
 
 /** VOS thread local storage structure */
 struct vos_tls {
@@ -49,10 +50,14 @@ struct vos_tls {
 	struct dtx_handle		*vtl_dth;
 	/** Timestamp table for xstream */
 	struct vos_ts_table		*vtl_ts_table;
+	/** umem_tx_stats of this xstream already reported to vos_tx metrics */
+	struct umem_tx_stats		 vtl_tx_reported;
 	/** profile for standalone vos test */
 	struct daos_profile		*vtl_dp;
 	/** In-memory object cache for the PMEM object table */
 	struct daos_lru_cache		*vtl_ocache;
+	/** Object cache registration in the engine DRAM budget */
+	struct dss_mem_cache		 vtl_ocache_mem;
 	/** pool open handle hash table */
 	struct d_hash_table		*vtl_pool_hhash;
 	/** container open handle hash table */
@@ -63,6 +68,14 @@ struct vos_tls {
 		bool			 vtl_hash_set;
 	};
 	struct d_tm_node_t		 *vtl_committed;
+	/** object cache hits, misses and evictions */
+	struct d_tm_node_t		 *vtl_ocache_hit;
+	struct d_tm_node_t		 *vtl_ocache_miss;
+	struct d_tm_node_t		 *vtl_ocache_evict;
+	/** Cache of visible extents found by evt_find() */
+	struct evt_vis_cache		 *vtl_evt_vis_cache;
+	/** Bumped on each evtree change, invalidates vtl_evt_vis_cache */
+	uint64_t			  vtl_evt_vis_gen;
 };
 
 struct bio_xs_context *vos_xsctxt_get(void);
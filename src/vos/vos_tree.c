@@ -1027,8 +1027,14 @@ key_tree_prepare(struct vos_object *obj, daos_handle_t toh,
 	 *   create the root for the subtree, or just return it if it's already
 	 *   there.
 	 */
-	rc = dbtree_fetch(toh, BTR_PROBE_EQ, intent, key,
-			  NULL, &riov);
+	if (flags & SUBTR_NONEXIST) {
+		/* Negative result from the key Bloom filter of the object */
+		D_ASSERT(!(flags & SUBTR_CREATE));
+		rc = -DER_NONEXIST;
+	} else {
+		rc = dbtree_fetch(toh, BTR_PROBE_EQ, intent, key,
+				  NULL, &riov);
+	}
 	switch (rc) {
 	default:
 		D_ERROR("fetch failed: "DF_RC"\n", DP_RC(rc));
@@ -25,6 +25,19 @@ static const uint32_t type_counts[] = {
 	D_FOREACH_TS_TYPE(DEFINE_TS_COUNT)
 };
 
+/** Environment variables to override the number of entries of each type */
+static const char * const type_envs[] = {
+	"DAOS_VOS_TS_CONT",
+	"DAOS_VOS_TS_OBJ",
+	"DAOS_VOS_TS_DKEY",
+	"DAOS_VOS_TS_AKEY",
+};
+D_CASSERT(ARRAY_SIZE(type_envs) == VOS_TS_TYPE_COUNT);
+
+/** Configured size can't exceed the default size by more than this factor */
+#define TS_COUNT_MAX_FACTOR	16
+#define TS_COUNT_MIN		64
+
 #define OBJ_MISS_SIZE (1 << 16)
 #define DKEY_MISS_SIZE (1 << 16)
 #define AKEY_MISS_SIZE (1 << 16)
@@ -88,6 +101,11 @@ static void evict_entry(void *payload, uint32_t idx, void *arg)
 	if (ts_update_on_evict(info->ti_table, entry)) {
 		TS_TRACE("Evicted", entry, idx, info->ti_type);
 		entry->te_record_ptr = NULL;
+		/** Later access of the record will inherit the (higher)
+		 *  timestamps of the negative entry, count it.
+		 */
+		if (info->ti_allocating)
+			d_tm_inc_counter(info->ti_evict_tm, 1);
 	}
 }
 
@@ -104,6 +122,31 @@ static const struct lru_callbacks lru_cbs = {
 	.lru_on_init = init_entry,
 };
 
+/** Number of entries of the type, it can be tuned for the workload by
+ *  environment variable and is rounded up to a power of two.
+ */
+static uint32_t
+ts_type_count(uint32_t type)
+{
+	unsigned int	count = type_counts[type];
+	uint32_t	size;
+
+	d_getenv_int(type_envs[type], &count);
+	if (count == type_counts[type])
+		return count;
+
+	if (count < TS_COUNT_MIN)
+		count = TS_COUNT_MIN;
+	if (count > type_counts[type] * TS_COUNT_MAX_FACTOR)
+		count = type_counts[type] * TS_COUNT_MAX_FACTOR;
+
+	for (size = TS_COUNT_MIN; size < count; size <<= 1)
+		;
+
+	D_INFO("Using %u timestamp entries for %s\n", size, type_strs[type]);
+	return size;
+}
+
 int
 vos_ts_table_alloc(struct vos_ts_table **ts_tablep)
 {
@@ -138,7 +181,7 @@ vos_ts_table_alloc(struct vos_ts_table **ts_tablep)
 		info = &ts_table->tt_type_info[i];
 
 		info->ti_type = i;
-		info->ti_count = type_counts[i];
+		info->ti_count = ts_type_count(i);
 		info->ti_table = ts_table;
 		switch (i) {
 		case VOS_TS_TYPE_OBJ:
@@ -199,6 +242,48 @@ free_table:
 	return rc;
 }
 
+void
+vos_ts_table_metrics_init(struct vos_ts_table *ts_table, int tgt_id)
+{
+	struct vos_ts_info	*info;
+	int			 rc;
+	int			 i;
+
+	for (i = 0; i < VOS_TS_TYPE_COUNT; i++) {
+		info = &ts_table->tt_type_info[i];
+
+		rc = d_tm_add_metric(&info->ti_miss_tm, D_TM_COUNTER,
+				     "Number of timestamp cache misses", "lookups",
+				     "vos/ts_cache/%s/miss/tgt_%u", type_strs[i],
+				     tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts miss sensor: "DF_RC"\n",
+			       DP_RC(rc));
+
+		rc = d_tm_add_metric(&info->ti_evict_tm, D_TM_COUNTER,
+				     "Number of timestamp entries evicted to make "
+				     "room", "entries",
+				     "vos/ts_cache/%s/evict/tgt_%u", type_strs[i],
+				     tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts evict sensor: "DF_RC"\n",
+			       DP_RC(rc));
+
+		if (info->ti_misses == NULL)
+			continue;
+
+		rc = d_tm_add_metric(&info->ti_conflict_tm, D_TM_COUNTER,
+				     "Number of read conflicts on negative "
+				     "timestamp entries, these cause "
+				     "transaction restarts", "conflicts",
+				     "vos/ts_cache/%s/conflict/tgt_%u",
+				     type_strs[i], tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts conflict sensor: "DF_RC
+			       "\n", DP_RC(rc));
+	}
+}
+
 void
 vos_ts_table_free(struct vos_ts_table **ts_tablep)
 {
@@ -223,7 +308,10 @@ vos_ts_evict_lru(struct vos_ts_table *ts_table, struct vos_ts_entry **entryp,
 	struct vos_ts_info	*info = &ts_table->tt_type_info[type];
 	int			 rc;
 
+	d_tm_inc_counter(info->ti_miss_tm, 1);
+	info->ti_allocating = true;
 	rc = lrua_alloc(ts_table->tt_type_info[type].ti_array, idx, &entry);
+	info->ti_allocating = false;
 	D_ASSERT(rc == 0); /** autoeviction and no allocation */
 
 	if (info->ti_cache_mask)
@@ -274,12 +362,12 @@ vos_ts_set_allocate(struct vos_ts_set **ts_set, uint64_t flags,
 	vos_kh_clear();
 
 	*ts_set = NULL;
-	if (!dtx_is_valid_handle(dth)) {
+	if (!dtx_is_valid_handle(dth) || (flags & VOS_OF_SKIP_TS)) {
 		if ((flags & cond_mask) == 0)
 			return 0;
-	} else {
-		tx_id = &dth->dth_xid;
 	}
+	if (dtx_is_valid_handle(dth))
+		tx_id = &dth->dth_xid;
 
 	size = VOS_TS_TYPE_AKEY + akey_nr;
 	array_size = size * sizeof((*ts_set)->ts_entries[0]);
@@ -358,6 +446,7 @@ vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
 	struct vos_ts_set_entry	*se;
 	struct vos_ts_entry	*entry;
 	int			 write_level;
+	bool			 conflict;
 
 	D_ASSERT(ts_set != NULL);
 
@@ -374,13 +463,22 @@ vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
 
 	if (se->se_etype < write_level) {
 		/* check the low time */
-		return vos_ts_check_conflict(entry->te_ts.tp_ts_rl,
-					     &entry->te_ts.tp_tx_rl,
-					     write_time, &ts_set->ts_tx_id);
+		conflict = vos_ts_check_conflict(entry->te_ts.tp_ts_rl,
+						 &entry->te_ts.tp_tx_rl,
+						 write_time, &ts_set->ts_tx_id);
+	} else {
+		/* check the high time */
+		conflict = vos_ts_check_conflict(entry->te_ts.tp_ts_rh,
+						 &entry->te_ts.tp_tx_rh,
+						 write_time, &ts_set->ts_tx_id);
 	}
 
-	/* check the high time */
-	return vos_ts_check_conflict(entry->te_ts.tp_ts_rh,
-				     &entry->te_ts.tp_tx_rh,
-				     write_time, &ts_set->ts_tx_id);
+	/** The negative entry is shared and carries the timestamps of the
+	 *  evicted entries, so the conflict may be a false one.
+	 */
+	if (conflict && entry->te_negative == NULL &&
+	    entry->te_info->ti_misses != NULL)
+		d_tm_inc_counter(entry->te_info->ti_conflict_tm, 1);
+
+	return conflict;
 }
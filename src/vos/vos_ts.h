@@ -33,6 +33,14 @@ struct vos_ts_info {
 	uint32_t		ti_cache_mask;
 	/** Number of entries in cache for type (for testing) */
 	uint32_t		ti_count;
+	/** Entry is being allocated, eviction is for capacity */
+	bool			ti_allocating;
+	/** Lookups missed the cache */
+	struct d_tm_node_t	*ti_miss_tm;
+	/** Entries evicted to make room */
+	struct d_tm_node_t	*ti_evict_tm;
+	/** Read conflicts found on negative entries */
+	struct d_tm_node_t	*ti_conflict_tm;
 };
 
 struct vos_ts_pair {
@@ -606,6 +614,14 @@ vos_ts_peek_entry(uint32_t *idx, uint32_t type, struct vos_ts_entry **entryp)
 int
 vos_ts_table_alloc(struct vos_ts_table **ts_table);
 
+/** Register telemetry sensors of the thread local timestamp cache
+ *
+ * \param[in]	ts_table	Thread local table
+ * \param[in]	tgt_id		Target id of the xstream
+ */
+void
+vos_ts_table_metrics_init(struct vos_ts_table *ts_table, int tgt_id);
+
 
 /** Free the thread local timestamp cache and reset pointer to NULL
  *